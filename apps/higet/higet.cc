@@ -16,12 +16,31 @@
 #include <hicn/apps/utils/logger.h>
 #include <hicn/transport/http/client_connection.h>
 #include <hicn/transport/utils/chrono_typedefs.h>
+#include <hicn/transport/utils/event_thread.h>
+
+#include <fcntl.h>
 
 #include <algorithm>
 #include <asio.hpp>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <condition_variable>
+#include <cstring>
 #include <fstream>
 #include <functional>
 #include <map>
+#include <mutex>
+#include <vector>
+
+#ifdef _WIN32
+#include <io.h>
+#else
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
 
 #ifndef ASIO_STANDALONE
 #define ASIO_STANDALONE
@@ -35,8 +54,119 @@ typedef struct {
   bool print_headers;
   std::string producer_certificate;
   std::string ipv6_first_word;
+  unsigned ranges;
 } Configuration;
 
+bool exists_file(const std::string &name) {
+  std::ifstream f(name.c_str());
+  return f.good();
+}
+
+/**
+ * Parse a decimal number in [1, max], without sign or trailing characters.
+ */
+bool parsePositive(const std::string &str, unsigned long max,
+                   unsigned long &value) {
+  if (str.empty() || !std::isdigit((unsigned char)str[0])) {
+    return false;
+  }
+
+  char *end = nullptr;
+  errno = 0;
+  value = std::strtoul(str.c_str(), &end, 10);
+  return errno == 0 && *end == '\0' && value > 0 && value <= max;
+}
+
+// Rename the temporary file, without overwriting an existing file
+void renameFile(const std::string &temp_file_name,
+                const std::string &file_name) {
+  std::size_t found = file_name.find_last_of(".");
+  std::string name = file_name.substr(0, found);
+  std::string extension = file_name.substr(found + 1);
+  if (!exists_file(file_name)) {
+    std::rename(temp_file_name.c_str(), file_name.c_str());
+  } else {
+    int i = 1;
+    std::ostringstream sstream;
+    sstream << name << "(" << i << ")." << extension;
+    std::string final_name = sstream.str();
+    while (exists_file(final_name)) {
+      i++;
+      sstream.str("");
+      sstream << name << "(" << i << ")." << extension;
+      final_name = sstream.str();
+    }
+    std::rename(temp_file_name.c_str(), final_name.c_str());
+  }
+}
+
+void print_bar(long value, long max_value, bool last) {
+  float progress = (float)value / max_value;
+#ifdef _WIN32
+  CONSOLE_SCREEN_BUFFER_INFO csbi;
+  GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
+  int barWidth = csbi.srWindow.Right - csbi.srWindow.Left + 7;
+#else
+  struct winsize size;
+  ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
+  int barWidth = size.ws_col - 8;
+#endif
+
+  std::cout << "[";
+  int pos = barWidth * (int)progress;
+  for (int i = 0; i < barWidth; ++i) {
+    if (i < pos) {
+      std::cout << "=";
+    } else if (i == pos) {
+      std::cout << ">";
+    } else {
+      std::cout << " ";
+    }
+  }
+  if (last) {
+    std::cout << "] " << int(progress * 100.0) << " %";
+  } else {
+    std::cout << "] " << int(progress * 100.0) << " %\r";
+    std::cout.flush();
+  }
+}
+
+#ifndef _WIN32
+/**
+ * Write the whole iovec array, which is modified in case of partial writes.
+ * With a negative offset the data is written at the current file position.
+ */
+bool writeIov(int fd, std::vector<struct iovec> &iov, off_t offset) {
+  std::size_t i = 0;
+  while (i < iov.size()) {
+    auto count = std::min<std::size_t>(iov.size() - i, IOV_MAX);
+    auto written = offset < 0 ? ::writev(fd, &iov[i], (int)count)
+                              : ::pwritev(fd, &iov[i], (int)count, offset);
+    if (written < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      return false;
+    }
+
+    if (offset >= 0) {
+      offset += written;
+    }
+
+    // Skip what has been written, the write may be partial
+    for (; i < iov.size() && (std::size_t)written >= iov[i].iov_len; i++) {
+      written -= iov[i].iov_len;
+    }
+    if (i < iov.size()) {
+      iov[i].iov_base = (uint8_t *)iov[i].iov_base + written;
+      iov[i].iov_len -= written;
+    }
+  }
+
+  return true;
+}
+#endif
+
 class ReadBytesCallbackImplementation
     : public transport::http::HTTPClientConnection::ReadBytesCallback {
   static std::string chunk_separator;
@@ -49,23 +179,34 @@ class ReadBytesCallbackImplementation
         yet_downloaded_(yet_downloaded),
         byte_downloaded_(yet_downloaded),
         work_(std::make_unique<asio::io_service::work>(io_service_)) {
-    std::streambuf *buf;
     if (file_name_ != "-") {
-      of_.open(temp_file_name_, std::ofstream::binary | std::ofstream::app);
-      buf = of_.rdbuf();
+#ifdef _WIN32
+      fd_ = ::open(temp_file_name_.c_str(),
+                   O_WRONLY | O_CREAT | O_APPEND | O_BINARY, 0644);
+#else
+      fd_ = ::open(temp_file_name_.c_str(), O_WRONLY | O_CREAT | O_APPEND,
+                   0644);
+#endif
+      if (fd_ < 0) {
+        LoggerErr() << "Error opening " << temp_file_name_ << ": "
+                    << std::strerror(errno);
+      }
     } else {
-      buf = std::cout.rdbuf();
+      fd_ = STDOUT_FILENO;
     }
-
-    out_ = new std::ostream(buf);
   }
 
+  // The payload is received in the packet buffers and written with writev
+  bool isBufferChainable() { return true; }
+
   void onBytesReceived(std::unique_ptr<utils::MemBuf> &&buffer) {
     auto buffer_ptr = buffer.release();
     io_service_.post([this, buffer_ptr]() {
       auto buffer = std::unique_ptr<utils::MemBuf>(buffer_ptr);
       std::unique_ptr<utils::MemBuf> payload;
       if (!first_chunk_read_) {
+        // The headers may span several packets
+        buffer->gather(buffer->computeChainDataLength());
         transport::http::HTTPResponse http_response(std::move(buffer));
         payload = http_response.getPayload();
         auto header = http_response.getHeaders();
@@ -86,8 +227,11 @@ class ReadBytesCallbackImplementation
       }
 
       if (chunked_) {
+        // The chunk sizes may span several packets
+        payload->gather(payload->computeChainDataLength());
+
         if (chunk_size_ > 0) {
-          out_->write((char *)payload->writableData(), chunk_size_);
+          write(payload->data(), chunk_size_);
           payload->trimStart(chunk_size_);
 
           if (payload->length() >= chunk_separator.size()) {
@@ -115,7 +259,7 @@ class ReadBytesCallbackImplementation
               chunk_size_ -= payload->length();
             }
 
-            out_->write((char *)payload->writableData(), to_write);
+            write(payload->data(), to_write);
             byte_downloaded_ += (long)to_write;
             payload->trimStart(to_write);
 
@@ -125,8 +269,8 @@ class ReadBytesCallbackImplementation
           }
         }
       } else {
-        out_->write((char *)payload->writableData(), payload->length());
-        byte_downloaded_ += (long)payload->length();
+        write(*payload);
+        byte_downloaded_ += (long)payload->computeChainDataLength();
       }
 
       if (file_name_ != "-") {
@@ -138,26 +282,8 @@ class ReadBytesCallbackImplementation
   void onSuccess(std::size_t bytes) {
     io_service_.post([this, bytes]() {
       if (file_name_ != "-") {
-        of_.close();
-        delete out_;
-        std::size_t found = file_name_.find_last_of(".");
-        std::string name = file_name_.substr(0, found);
-        std::string extension = file_name_.substr(found + 1);
-        if (!exists_file(file_name_)) {
-          std::rename(temp_file_name_.c_str(), file_name_.c_str());
-        } else {
-          int i = 1;
-          std::ostringstream sstream;
-          sstream << name << "(" << i << ")." << extension;
-          std::string final_name = sstream.str();
-          while (exists_file(final_name)) {
-            i++;
-            sstream.str("");
-            sstream << name << "(" << i << ")." << extension;
-            final_name = sstream.str();
-          }
-          std::rename(temp_file_name_.c_str(), final_name.c_str());
-        }
+        ::close(fd_);
+        renameFile(temp_file_name_, file_name_);
 
         print_bar(100, 100, true);
         LoggerInfo() << "\nDownloaded " << bytes << " bytes";
@@ -168,53 +294,49 @@ class ReadBytesCallbackImplementation
 
   void onError(const std::error_code &ec) {
     io_service_.post([this]() {
-      of_.close();
-      delete out_;
+      if (file_name_ != "-") {
+        ::close(fd_);
+      }
       work_.reset();
     });
   }
 
  private:
-  bool exists_file(const std::string &name) {
-    std::ifstream f(name.c_str());
-    return f.good();
+  void write(const uint8_t *data, std::size_t length) {
+    while (length > 0) {
+      auto written = ::write(fd_, data, (unsigned)length);
+      if (written < 0) {
+        if (errno == EINTR) {
+          continue;
+        }
+        LoggerErr() << "Error writing " << file_name_ << ": "
+                    << std::strerror(errno);
+        return;
+      }
+      data += written;
+      length -= written;
+    }
   }
 
-  void print_bar(long value, long max_value, bool last) {
-    float progress = (float)value / max_value;
+  void write(const utils::MemBuf &payload) {
 #ifdef _WIN32
-    CONSOLE_SCREEN_BUFFER_INFO csbi;
-    GetConsoleScreenBufferInfo(GetStdHandle(STD_OUTPUT_HANDLE), &csbi);
-    int barWidth = csbi.srWindow.Right - csbi.srWindow.Left + 7;
+    const utils::MemBuf *current = &payload;
+    do {
+      write(current->data(), current->length());
+      current = current->next();
+    } while (current != &payload);
 #else
-    struct winsize size;
-    ioctl(STDOUT_FILENO, TIOCGWINSZ, &size);
-    int barWidth = size.ws_col - 8;
-#endif
-
-    std::cout << "[";
-    int pos = barWidth * (int)progress;
-    for (int i = 0; i < barWidth; ++i) {
-      if (i < pos) {
-        std::cout << "=";
-      } else if (i == pos) {
-        std::cout << ">";
-      } else {
-        std::cout << " ";
-      }
-    }
-    if (last) {
-      std::cout << "] " << int(progress * 100.0) << " %";
-    } else {
-      std::cout << "] " << int(progress * 100.0) << " %\r";
-      std::cout.flush();
+    auto iov = payload.getIov();
+    if (!writeIov(fd_, iov, -1)) {
+      LoggerErr() << "Error writing " << file_name_ << ": "
+                  << std::strerror(errno);
     }
+#endif
   }
 
   std::string file_name_;
   std::string temp_file_name_;
-  std::ostream *out_;
-  std::ofstream of_;
+  int fd_;
   long yet_downloaded_;
   long content_size_;
   bool first_chunk_read_ = false;
@@ -234,6 +356,268 @@ long checkFileStatus(const std::string &file_name) {
   return rc == 0 ? stat_buf.st_size : -1;
 }
 
+#ifndef _WIN32
+/**
+ * Download of a byte range of the content, written at its offset in the file
+ * shared with the other ranges.
+ */
+class RangeCallbackImplementation
+    : public transport::http::HTTPClientConnection::ReadBytesCallback {
+ public:
+  RangeCallbackImplementation(int fd, long offset, long length)
+      : fd_(fd),
+        offset_(offset),
+        length_(length),
+        byte_downloaded_(0),
+        error_(false) {}
+
+  // The payload is received in the packet buffers and written with pwritev
+  bool isBufferChainable() { return true; }
+
+  // Ranges are written at disjoint offsets, so the payload is written directly
+  // from the thread of the consumer, releasing the packets as soon as possible
+  void onBytesReceived(std::unique_ptr<utils::MemBuf> &&buffer) {
+    if (error_) {
+      return;
+    }
+
+    std::unique_ptr<utils::MemBuf> payload;
+    if (!first_chunk_read_) {
+      // The headers may span several packets
+      buffer->gather(buffer->computeChainDataLength());
+      transport::http::HTTPResponse http_response(std::move(buffer));
+      if (http_response.getStatusCode() != "206") {
+        LoggerErr() << "Range " << offset_ << "-" << offset_ + length_ - 1
+                    << " not served, status " << http_response.getStatusCode();
+        error_ = true;
+        return;
+      }
+      payload = http_response.getPayload();
+      first_chunk_read_ = true;
+    } else {
+      payload = std::move(buffer);
+    }
+
+    auto iov = payload->getIov();
+    if (!writeIov(fd_, iov, offset_ + byte_downloaded_)) {
+      LoggerErr() << "Error writing range " << offset_ << "-"
+                  << offset_ + length_ - 1 << ": " << std::strerror(errno);
+      error_ = true;
+      return;
+    }
+
+    byte_downloaded_ += (long)payload->computeChainDataLength();
+  }
+
+  void onSuccess(std::size_t bytes) {}
+
+  void onError(const std::error_code &ec) { error_ = true; }
+
+  long getDownloaded() const { return byte_downloaded_; }
+
+  bool failed() const { return error_ || byte_downloaded_ != length_; }
+
+ private:
+  int fd_;
+  long offset_;
+  long length_;
+  bool first_chunk_read_ = false;
+  // Read by the main thread for printing the progress
+  std::atomic<long> byte_downloaded_;
+  bool error_;
+};
+
+std::unique_ptr<transport::http::HTTPClientConnection> makeConnection(
+    const Configuration &conf) {
+  auto connection = std::make_unique<transport::http::HTTPClientConnection>();
+
+  if (!conf.producer_certificate.empty()) {
+    std::shared_ptr<transport::auth::Verifier> verifier =
+        std::make_shared<transport::auth::AsymmetricVerifier>(
+            conf.producer_certificate);
+    connection->setVerifier(verifier);
+  }
+
+  return connection;
+}
+
+/**
+ * Get the size of the content from the Content-Range of the response to a
+ * range request. Returns -1 if the range is not served or the size is unknown.
+ */
+long parseContentSize(transport::http::HTTPResponse &response) {
+  // Header names are lower case
+  auto headers = response.getHeaders();
+  auto it = headers.find("content-range");
+  if (response.getStatusCode() != "206" || it == headers.end()) {
+    return -1;
+  }
+
+  // bytes <first>-<last>/<size>, where the size may be unknown (*)
+  auto separator = it->second.find('/');
+  if (separator == std::string::npos) {
+    return -1;
+  }
+
+  unsigned long content_size;
+  if (!parsePositive(it->second.substr(separator + 1), LONG_MAX,
+                     content_size)) {
+    return -1;
+  }
+
+  return (long)content_size;
+}
+
+/**
+ * Get the size of the content with a request for its first byte. Returns -1
+ * if the server does not serve ranges.
+ */
+long getContentSize(const Configuration &conf, const std::string &name,
+                    std::map<std::string, std::string> headers) {
+  headers["Range"] = "bytes=0-0";
+
+  auto connection = makeConnection(conf);
+  auto response = std::make_shared<transport::http::HTTPResponse>();
+  if (connection->get(name, headers, {}, response, nullptr,
+                      conf.ipv6_first_word) !=
+      transport::http::HTTPClientConnection::RC::DOWNLOAD_SUCCESS) {
+    return -1;
+  }
+
+  return parseContentSize(*response);
+}
+
+/**
+ * Split the content in byte ranges, as (offset, length) pairs. There are no
+ * more ranges than bytes, and the last range also takes the remainder.
+ */
+std::vector<std::pair<long, long>> splitRanges(long content_size,
+                                               unsigned ranges) {
+  std::vector<std::pair<long, long>> ret;
+  long count = std::min<long>(ranges, content_size);
+  if (count <= 0) {
+    return ret;
+  }
+
+  long range_size = content_size / count;
+  for (long i = 0; i < count; i++) {
+    long offset = i * range_size;
+    ret.emplace_back(offset,
+                     i == count - 1 ? content_size - offset : range_size);
+  }
+
+  return ret;
+}
+
+/**
+ * Split the content in byte ranges, downloaded in parallel by consumers
+ * running on their own event thread and written in place in a preallocated
+ * file.
+ */
+int parallelDownload(const Configuration &conf, const std::string &name,
+                     const std::map<std::string, std::string> &headers,
+                     long content_size) {
+  std::string temp_file_name = conf.file_name + ".parallel.temp";
+  int fd = ::open(temp_file_name.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    LoggerErr() << "Error opening " << temp_file_name << ": "
+                << std::strerror(errno);
+    return EXIT_FAILURE;
+  }
+
+#ifdef __linux__
+  int ret = posix_fallocate(fd, 0, content_size);
+#else
+  int ret = ::ftruncate(fd, content_size) < 0 ? errno : 0;
+#endif
+  if (ret != 0) {
+    LoggerErr() << "Error allocating " << content_size << " bytes for "
+                << temp_file_name << ": " << std::strerror(ret);
+    ::close(fd);
+    return EXIT_FAILURE;
+  }
+
+  auto ranges = splitRanges(content_size, conf.ranges);
+
+  std::vector<std::unique_ptr<RangeCallbackImplementation>> callbacks;
+  std::vector<std::unique_ptr<transport::http::HTTPClientConnection>>
+      connections;
+  std::vector<std::unique_ptr<utils::EventThread>> threads;
+
+  std::mutex mtx;
+  std::condition_variable cv;
+  std::size_t done = 0;
+  bool success = true;
+
+  auto start = utils::SteadyTime::Clock::now();
+
+  for (auto &range : ranges) {
+    long offset = range.first;
+    long length = range.second;
+
+    auto range_headers = headers;
+    range_headers["Range"] = "bytes=" + std::to_string(offset) + "-" +
+                             std::to_string(offset + length - 1);
+
+    callbacks.emplace_back(
+        std::make_unique<RangeCallbackImplementation>(fd, offset, length));
+    connections.emplace_back(makeConnection(conf));
+    threads.emplace_back(std::make_unique<utils::EventThread>());
+
+    // The download is synchronous, and keeps the event thread busy until the
+    // range is retrieved
+    auto connection = connections.back().get();
+    auto callback = callbacks.back().get();
+    threads.back()->add([&, connection, callback, range_headers]() {
+      auto rc = connection->get(name, range_headers, {}, nullptr, callback,
+                                conf.ipv6_first_word);
+
+      std::lock_guard<std::mutex> lock(mtx);
+      success = success &&
+                rc == transport::http::HTTPClientConnection::RC::
+                          DOWNLOAD_SUCCESS &&
+                !callback->failed();
+      done++;
+      cv.notify_one();
+    });
+  }
+
+  {
+    std::unique_lock<std::mutex> lock(mtx);
+    while (!cv.wait_for(lock, std::chrono::seconds(1),
+                        [&]() { return done == ranges.size(); })) {
+      long downloaded = 0;
+      for (auto &callback : callbacks) {
+        downloaded += callback->getDownloaded();
+      }
+      print_bar(downloaded, content_size, false);
+    }
+  }
+
+  auto elapsed =
+      utils::SteadyTime::getDurationUs(start, utils::SteadyTime::Clock::now());
+
+  threads.clear();
+  ::close(fd);
+
+  if (!success) {
+    LoggerErr() << "\nDownload of " << name << " failed";
+    std::remove(temp_file_name.c_str());
+    return EXIT_FAILURE;
+  }
+
+  renameFile(temp_file_name, conf.file_name);
+
+  // Aggregate throughput of all the ranges
+  double throughput = double(content_size) * 8 / double(elapsed.count());
+  print_bar(100, 100, true);
+  LoggerInfo() << "\nDownloaded " << content_size << " bytes in "
+               << ranges.size() << " ranges, " << throughput << " Mbps";
+
+  return EXIT_SUCCESS;
+}
+#endif
+
 void usage(const char *program_name) {
   LoggerInfo() << "usage:";
   LoggerInfo() << program_name << " [option]... [url]...";
@@ -244,6 +628,8 @@ void usage(const char *program_name) {
   LoggerInfo()
       << "-P                          = first word of the ipv6 name of "
          "the response";
+  LoggerInfo() << "-n <ranges>                 = download <ranges> byte ranges "
+                  "in parallel";
   LoggerInfo() << "example:";
   LoggerInfo() << "\t" << program_name << " -O - http://origin/index.html";
 }
@@ -259,11 +645,12 @@ int http_main(int argc, char **argv) {
   conf.print_headers = false;
   conf.producer_certificate = "";
   conf.ipv6_first_word = "b001";
+  conf.ranges = 1;
 
   std::string name("http://webserver/sintel/mpd");
 
   int opt;
-  while ((opt = getopt(argc, argv, "O:Sc:P:")) != -1) {
+  while ((opt = getopt(argc, argv, "O:Sc:P:n:")) != -1) {
     switch (opt) {
       case 'O':
         conf.file_name = optarg;
@@ -277,6 +664,16 @@ int http_main(int argc, char **argv) {
       case 'P':
         conf.ipv6_first_word = optarg;
         break;
+      case 'n': {
+        unsigned long ranges;
+        if (!parsePositive(optarg, UINT_MAX, ranges)) {
+          LoggerErr() << "Invalid number of ranges: " << optarg;
+          usage(argv[0]);
+          exit(EXIT_FAILURE);
+        }
+        conf.ranges = (unsigned)ranges;
+        break;
+      }
       default:
         usage(argv[0]);
         exit(EXIT_FAILURE);
@@ -314,6 +711,19 @@ int http_main(int argc, char **argv) {
                {"Range", range}};
   }
 
+#ifndef _WIN32
+  // Resuming a previous download is done over a single connection
+  if (conf.ranges > 1 && conf.file_name != "-" && yetDownloaded == -1) {
+    long content_size = getContentSize(conf, name, headers);
+    if (content_size > 0) {
+      return parallelDownload(conf, name, headers, content_size);
+    }
+
+    LoggerWarn() << "Byte ranges not served for " << name
+                 << ", downloading over a single connection";
+  }
+#endif
+
   transport::http::HTTPClientConnection connection;
 
   if (!conf.producer_certificate.empty()) {
@@ -205,6 +205,7 @@ class HIperfClient::Impl {
       uint64_t old_sent_int_value_{0};
       uint64_t old_received_nacks_value_{0};
       uint32_t old_fec_pkt_{0};
+      std::map<uint32_t, uint64_t> old_path_bytes_;
       // IMPORTANT: to be used only for performance testing, when consumer and
       // producer are synchronized. Used for rtc only at the moment
       double avg_data_delay_{0};
@@ -449,6 +450,42 @@ class HIperfClient::Impl {
         getOutputStream() << std::right << std::setw(width) << window.str();
         getOutputStream() << std::right << std::setw(width) << avg_rtt.str()
                           << std::endl;
+
+        // Multipath: one more line per path, identified by its label
+        for (const auto &[path_label, path] : stats.getPathStatistics()) {
+          uint64_t &old_bytes = saved_stats_.old_path_bytes_[path_label];
+
+          std::stringstream path_name;
+          path_name << "path " << std::hex << path_label;
+
+          std::stringstream path_bytes;
+          path_bytes << std::fixed << std::setprecision(3)
+                     << double(path.bytes_received - old_bytes) / 1000000.0;
+
+          std::stringstream path_bandwidth;
+          path_bandwidth << (double(path.bytes_received - old_bytes) * 8) /
+                                (exact_duration.count()) / 1000.0;
+
+          std::stringstream path_window;
+          path_window << path.window;
+
+          std::stringstream path_rtt;
+          path_rtt << std::setprecision(3) << std::fixed << path.average_rtt;
+
+          getOutputStream() << std::right << std::setw(width)
+                            << path_name.str();
+          getOutputStream() << std::right << std::setw(width)
+                            << path_bytes.str();
+          getOutputStream() << std::right << std::setw(width)
+                            << path_bandwidth.str();
+          getOutputStream() << std::right << std::setw(width) << "-";
+          getOutputStream() << std::right << std::setw(width)
+                            << path_window.str();
+          getOutputStream() << std::right << std::setw(width)
+                            << path_rtt.str() << std::endl;
+
+          old_bytes = path.bytes_received;
+        }
       }
 
       saved_stats_.total_duration_milliseconds_ +=
@@ -607,6 +644,14 @@ class HIperfClient::Impl {
       consumer_socket_ =
           std::make_unique<ConsumerSocket>(configuration_.transport_protocol_);
 
+      if (configuration_.multipath_) {
+        ret = consumer_socket_->setSocketOption(
+            RaaqmTransportOptions::MULTIPATH, true);
+        if (ret == SOCKET_OPTION_NOT_SET) {
+          return ERROR_SETUP;
+        }
+      }
+
       if (configuration_.beta_ != -1.f) {
         ret = consumer_socket_->setSocketOption(
             RaaqmTransportOptions::BETA_VALUE, configuration_.beta_);
@@ -626,6 +671,15 @@ class HIperfClient::Impl {
       return ERROR_SUCCESS;
     }
 
+    int setupBBRSocket() {
+      configuration_.transport_protocol_ = transport::interface::BBR;
+
+      consumer_socket_ =
+          std::make_unique<ConsumerSocket>(configuration_.transport_protocol_);
+
+      return ERROR_SUCCESS;
+    }
+
     int setupCBRSocket() {
       configuration_.transport_protocol_ = transport::interface::CBR;
 
@@ -643,6 +697,8 @@ class HIperfClient::Impl {
 
       if (configuration_.rtc_) {
         ret = setupRTCSocket();
+      } else if (configuration_.bbr_) {
+        ret = setupBBRSocket();
       } else if (configuration_.window_ < 0) {
         ret = setupRAAQMSocket();
       } else {
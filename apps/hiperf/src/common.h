@@ -37,6 +37,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include <map>
 #include <sstream>
 #include <string>
 #include <unordered_set>
@@ -244,6 +245,8 @@ struct ClientConfiguration : Configuration {
   double beta_{-1.f};
   double drop_factor_{-1.f};
   double window_{-1.f};
+  bool bbr_{false};
+  bool multipath_{false};
   std::string producer_certificate_;
   std::size_t receive_buffer_size_{128 * 1024};
   std::uint32_t report_interval_milliseconds_{1000};
@@ -138,6 +138,12 @@ void usage() {
   LoggerInfo() << "-W\t<window_size>\t\t\t"
                << "Use a fixed congestion window "
                   "for retrieving the data.";
+  LoggerInfo() << "-Q\t\t\t\t\t"
+               << "Use the BBR congestion control (paced, model-based) "
+                  "instead of RAAQM for retrieving the data.";
+  LoggerInfo() << "-Y\t\t\t\t\t"
+               << "Multipath RAAQM: one window per path label, and per-path "
+                  "statistics in the report.";
   LoggerInfo() << "-i\t<stats_interval>\t\t"
                << "Show the statistics every <stats_interval> milliseconds.";
   LoggerInfo()
@@ -222,8 +228,8 @@ int hiperf_main(int argc, char *argv[]) {
   // Please keep in alphabetical order.
   while (
       (opt = getopt(argc, argv,
-                    "A:B:CDE:F:G:HIJ:K:L:M:NP:RST:U:W:X:ab:c:d:e:f:g:hi:j:k:lm:"
-                    "n:op:qrs:tu:vw:xy:z:")) != -1) {
+                    "A:B:CDE:F:G:HIJ:K:L:M:NP:QRST:U:W:X:Yab:c:d:e:f:g:hi:j:k:"
+                    "lm:n:op:qrs:tu:vw:xy:z:")) != -1) {
     switch (opt) {
       // Common
       case 'D': {
@@ -258,8 +264,8 @@ int hiperf_main(int argc, char *argv[]) {
 #else
   // Please keep in alphabetical order.
   while ((opt = getopt(argc, argv,
-                       "A:B:CE:F:HK:L:M:P:RSU:W:X:ab:c:d:e:f:hi:j:k:lm:n:op:rs:"
-                       "tu:vwxy:z:")) != -1) {
+                       "A:B:CE:F:HK:L:M:P:QRSU:W:X:Yab:c:d:e:f:hi:j:k:lm:n:op:"
+                       "rs:tu:vwxy:z:")) != -1) {
     switch (opt) {
 #endif
       case 'E': {
@@ -345,6 +351,16 @@ int hiperf_main(int argc, char *argv[]) {
         options = 1;
         break;
       }
+      case 'Q': {
+        client_configuration.bbr_ = true;
+        options = 1;
+        break;
+      }
+      case 'Y': {
+        client_configuration.multipath_ = true;
+        options = 1;
+        break;
+      }
       case 'M': {
         client_configuration.receive_buffer_size_ = std::stoull(optarg);
         options = 1;
@@ -219,6 +219,13 @@ int hc_execute(hc_sock_t *s, hc_action_t action, hc_object_type_t object_type,
 int hc_execute_async(hc_sock_t *s, hc_action_t action,
                      hc_object_type_t object_type, hc_object_t *object,
                      hc_result_callback_t callback, void *callback_data);
+/*
+ * Executes the same action on an array of objects, in as few messages as the
+ * module allows. Returns an error if the action fails for any of them.
+ */
+int hc_execute_batch(hc_sock_t *s, hc_action_t action,
+                     hc_object_type_t object_type, hc_object_t *objects,
+                     size_t num_objects);
 
 int hc_object_create(hc_sock_t *s, hc_object_type_t object_type,
                      hc_object_t *object);
@@ -263,6 +270,8 @@ int hc_connection_set_tags(hc_sock_t *s, const char *conn_id_or_name,
                            policy_tags_t tags);
 
 int hc_route_create(hc_sock_t *s, hc_route_t *route);
+/* Creates routes in batches, which are expected to reference existing faces */
+int hc_route_create_batch(hc_sock_t *s, hc_route_t *routes, size_t n);
 // hc_result_t *hc_route_create_conf(hc_sock_t *s, hc_route_t *route);
 int hc_route_delete(hc_sock_t *s, hc_route_t *route);
 int hc_route_list(hc_sock_t *s, hc_data_t **pdata);
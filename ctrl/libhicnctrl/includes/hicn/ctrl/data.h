@@ -117,6 +117,8 @@ void hc_data_set_size(hc_data_t *data, int size);
 #endif
 
 void hc_data_set_complete(hc_data_t *data);
+/* Data can be extended by further replies (eg. paginated lists) */
+void hc_data_set_incomplete(hc_data_t *data);
 bool hc_data_is_complete(const hc_data_t *data);
 
 void hc_data_set_error(hc_data_t *data);
@@ -92,7 +92,8 @@ typedef enum {
   _(subscription_add, SUBSCRIPTION_ADD)                   \
   _(subscription_remove, SUBSCRIPTION_REMOVE)             \
   _(stats_list, STATS_LIST)                               \
-  _(face_stats_list, FACE_STATS_LIST)
+  _(face_stats_list, FACE_STATS_LIST)                     \
+  _(cache_set_policy, CACHE_SET_POLICY)
 
 typedef enum {
   COMMAND_TYPE_UNDEFINED,
@@ -124,6 +125,35 @@ typedef struct {
   cmd_header_t header;
 } msg_header_t;
 
+/*
+ * Commands are received by the forwarder in a single buffer of this size,
+ * which bounds the number of items of a request.
+ */
+#define COMMAND_MAX_SIZE 1500
+
+/*
+ * Paginated lists
+ *
+ * A list request carrying this payload (header length = 1) is answered with at
+ * most max_items items following the cursor: the prefix of the last item
+ * received for routes and policies, or its id for connections. The list is
+ * complete when an empty page is received. A request without payload (header
+ * length = 0) returns all items at once.
+ */
+#define LIST_PAGE_MAX_ITEMS 256
+
+typedef struct {
+  hicn_ip_address_t address;
+  uint32_t id;
+  uint16_t max_items;
+  uint8_t family;
+  uint8_t len;
+  uint8_t has_cursor;
+  uint8_t __pad[7];
+} cmd_list_page_t;
+
+static_assert(sizeof(cmd_list_page_t) == 32, "");
+
 /* Listener */
 
 typedef struct {
@@ -164,9 +194,7 @@ typedef struct {
   char symbolic_or_connid[SYMBOLIC_NAME_LEN];
 } cmd_connection_remove_t;
 
-typedef struct {
-  void *_;
-} cmd_connection_list_t;
+typedef cmd_list_page_t cmd_connection_list_t;
 
 typedef struct {
   char symbolic_or_connid[SYMBOLIC_NAME_LEN];
@@ -201,6 +229,10 @@ typedef struct {
   uint8_t len;
 } cmd_route_add_t;
 
+/* Routes can be added in batches: the header length is the number of routes */
+#define ROUTE_ADD_BATCH_MAX \
+  ((COMMAND_MAX_SIZE - sizeof(cmd_header_t)) / sizeof(cmd_route_add_t))
+
 typedef struct {
   char symbolic_or_connid[SYMBOLIC_NAME_LEN];
   hicn_ip_address_t address;
@@ -208,9 +240,7 @@ typedef struct {
   uint8_t len;
 } cmd_route_remove_t;
 
-typedef struct {
-  void *_;
-} cmd_route_list_t;
+typedef cmd_list_page_t cmd_route_list_t;
 
 /* Cache */
 
@@ -230,9 +260,14 @@ typedef struct {
   void *_;
 } cmd_cache_list_t;
 
+typedef struct {
+  uint8_t policy;
+} cmd_cache_set_policy_t;
+
 typedef struct {
   uint8_t store_in_cs;
   uint8_t serve_from_cs;
+  uint8_t policy;
   uint32_t cs_size;
   uint32_t num_stale_entries;
 } cmd_cache_list_reply_t;
@@ -242,6 +277,11 @@ typedef struct {
   cmd_cache_list_reply_t payload;
 } msg_cache_list_reply_t;
 
+/* dummy */
+typedef struct {
+  void *_;
+} cmd_cache_list_item_t;
+
 /* WLDR */
 
 typedef struct {
@@ -328,9 +368,7 @@ typedef struct {
   uint8_t len;
 } cmd_policy_remove_t;
 
-typedef struct {
-  void *_;
-} cmd_policy_list_t;
+typedef cmd_list_page_t cmd_policy_list_t;
 
 /* Subscription */
 
@@ -21,14 +21,36 @@
 #ifndef HICNCTRL_OBJECTS_CACHE_H
 #define HICNCTRL_OBJECTS_CACHE_H
 
+/* Eviction and admission policies of the forwarder content store */
+typedef enum {
+  CACHE_POLICY_UNDEFINED,
+  CACHE_POLICY_LRU,
+  CACHE_POLICY_TINYLFU,
+  CACHE_POLICY_S3FIFO,
+  CACHE_POLICY_N,
+} cache_policy_t;
+
+static inline cache_policy_t cache_policy_from_str(const char *policy_str) {
+  if (strcasecmp(policy_str, "lru") == 0)
+    return CACHE_POLICY_LRU;
+  else if (strcasecmp(policy_str, "tinylfu") == 0)
+    return CACHE_POLICY_TINYLFU;
+  else if (strcasecmp(policy_str, "s3fifo") == 0)
+    return CACHE_POLICY_S3FIFO;
+  else
+    return CACHE_POLICY_UNDEFINED;
+}
+
 typedef struct {
   uint8_t serve;  // 1 = on, 0 = off
   uint8_t store;  // 1 = on, 0 = off
+  cache_policy_t policy;
 } hc_cache_t;
 
 typedef struct {
   bool store;
   bool serve;
+  cache_policy_t policy;
   size_t cs_size;
   size_t num_stale_entries;
 } hc_cache_info_t;
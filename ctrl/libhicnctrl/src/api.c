@@ -168,9 +168,10 @@ int hc_sock_receive_all(hc_sock_t *s, hc_data_t **pdata) {
  * If the caller provider a non-NULL hc_data_t pointer to receive results
  * back, it is responsible for freeing it.
  */
-int _hc_execute(hc_sock_t *s, hc_action_t action, hc_object_type_t object_type,
-                hc_object_t *object, hc_result_callback_t callback,
-                void *callback_data, hc_data_t **pdata) {
+static int _hc_execute_n(hc_sock_t *s, hc_action_t action,
+                         hc_object_type_t object_type, hc_object_t *object,
+                         size_t num_objects, hc_result_callback_t callback,
+                         void *callback_data, hc_data_t **pdata) {
   assert(!(hc_sock_is_async(s) && pdata));
 
   if (hc_sock_is_async(s) && !s->ops.get_fd) {
@@ -193,10 +194,14 @@ int _hc_execute(hc_sock_t *s, hc_action_t action, hc_object_type_t object_type,
     goto ERR_REQUEST;
   }
 
+  hc_request_set_num_objects(request, num_objects);
+
   if (hc_request_requires_object(request)) {
-    if (hc_object_is_empty(object) ||
-        hc_object_validate(object_type, object, true) < 0) {
-      goto ERR_VALIDATE;
+    for (size_t i = 0; i < num_objects; i++) {
+      if (hc_object_is_empty(&object[i]) ||
+          hc_object_validate(object_type, &object[i], true) < 0) {
+        goto ERR_VALIDATE;
+      }
     }
   } else {
     if (object && !hc_object_is_empty(object)) {
@@ -240,6 +245,13 @@ ERR_VALIDATE:
   return -1;
 }
 
+int _hc_execute(hc_sock_t *s, hc_action_t action, hc_object_type_t object_type,
+                hc_object_t *object, hc_result_callback_t callback,
+                void *callback_data, hc_data_t **pdata) {
+  return _hc_execute_n(s, action, object_type, object, 1, callback,
+                       callback_data, pdata);
+}
+
 int hc_execute(hc_sock_t *s, hc_action_t action, hc_object_type_t object_type,
                hc_object_t *object, hc_data_t **pdata) {
   return _hc_execute(s, action, object_type, object, NULL, NULL, pdata);
@@ -252,6 +264,27 @@ int hc_execute_async(hc_sock_t *s, hc_action_t action,
                      NULL);
 }
 
+int hc_execute_batch(hc_sock_t *s, hc_action_t action,
+                     hc_object_type_t object_type, hc_object_t *objects,
+                     size_t num_objects) {
+  if (num_objects == 0) return 0;
+
+  /* Modules without message-based requests execute objects one by one */
+  if (!s->ops.send) {
+    for (size_t i = 0; i < num_objects; i++)
+      if (hc_execute(s, action, object_type, &objects[i], NULL) < 0) return -1;
+    return 0;
+  }
+
+  hc_data_t *data = NULL;
+  if (_hc_execute_n(s, action, object_type, objects, num_objects, NULL, NULL,
+                    &data) < 0)
+    return -1;
+  int rc = (data && hc_data_get_result(data)) ? 0 : -1;
+  if (data) hc_data_free(data);
+  return rc;
+}
+
 /*----------------------------------------------------------------------------*
  * VFT
  *----------------------------------------------------------------------------*/
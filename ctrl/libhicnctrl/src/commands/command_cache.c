@@ -41,6 +41,15 @@
     .type = TYPE_ON_OFF, .offset = offsetof(hc_cache_t, store),               \
   }
 
+#define policy                                                          \
+  {                                                                     \
+    .name = "policy",                                                   \
+    .help =                                                             \
+        "Eviction policy of the local content store [lru | tinylfu | "  \
+        "s3fifo]. Changing the policy clears the content store",        \
+    .type = TYPE_ENUM(cache_policy), .offset = offsetof(hc_cache_t, policy), \
+  }
+
 /* Commands */
 
 static const command_parser_t command_cache_set_serve = {
@@ -59,6 +68,14 @@ static const command_parser_t command_cache_set_store = {
 };
 COMMAND_REGISTER(command_cache_set_store);
 
+static const command_parser_t command_cache_set_policy = {
+    .action = ACTION_SET,
+    .object_type = OBJECT_TYPE_CACHE,
+    .nparams = 1,
+    .parameters = {policy},
+};
+COMMAND_REGISTER(command_cache_set_policy);
+
 static const command_parser_t command_cache_clear = {
     .action = ACTION_CLEAR,
     .object_type = OBJECT_TYPE_CACHE,
@@ -177,6 +177,8 @@ int hc_data_set_callback(hc_data_t *data, data_callback_t cb, void *cb_data) {
 
 void hc_data_set_complete(hc_data_t *data) { data->complete = true; }
 
+void hc_data_set_incomplete(hc_data_t *data) { data->complete = false; }
+
 bool hc_data_is_complete(const hc_data_t *data) { return data->complete; }
 
 void hc_data_set_error(hc_data_t *data) {
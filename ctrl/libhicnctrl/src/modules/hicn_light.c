@@ -47,6 +47,7 @@
 #include "hicn_light.h"
 
 #include "hicn_light/base.h"
+#include "hicn_light/cache.h"
 #include "hicn_light/connection.h"
 #include "hicn_light/face.h"
 #include "hicn_light/listener.h"
@@ -236,8 +237,8 @@ static int hicnlight_process_header(hc_sock_t *sock) {
         return 0;
       }
 
-      /* Allocate buffer for response */
-      if (hc_data_allocate(data, s->remaining) < 0) {
+      /* Allocate buffer for response (following previous pages if any) */
+      if (hc_data_ensure_available(data, s->remaining) < 0) {
         ERROR("[hc_sock_light_process] Cannot allocate result buffer");
         return -99;
       }
@@ -522,12 +523,14 @@ NEXT:
         case FACE_TYPE_HICN:
         case FACE_TYPE_TCP:
         case FACE_TYPE_UDP:
+        case FACE_TYPE_MEMIF:
           hc_request_set_state(current_request,
                                REQUEST_STATE_FACE_CREATE_CONNECTION_CREATE);
           goto NEXT;
         case FACE_TYPE_HICN_LISTENER:
         case FACE_TYPE_TCP_LISTENER:
         case FACE_TYPE_UDP_LISTENER:
+        case FACE_TYPE_MEMIF_LISTENER:
           hc_request_set_state(current_request,
                                REQUEST_STATE_FACE_CREATE_LISTENER_CREATE);
           goto NEXT;
@@ -643,12 +646,14 @@ NEXT:
         case FACE_TYPE_HICN:
         case FACE_TYPE_TCP:
         case FACE_TYPE_UDP:
+        case FACE_TYPE_MEMIF:
           hc_request_set_state(current_request,
                                REQUEST_STATE_FACE_DELETE_CONNECTION_DELETE);
           goto NEXT;
         case FACE_TYPE_HICN_LISTENER:
         case FACE_TYPE_TCP_LISTENER:
         case FACE_TYPE_UDP_LISTENER:
+        case FACE_TYPE_MEMIF_LISTENER:
         case FACE_TYPE_UNDEFINED:
         case FACE_TYPE_N:
           return -99;  // Not implemented
@@ -1087,6 +1092,131 @@ NEXT:
   return 0;
 }
 
+/*
+ * Routes referencing existing faces are sent by batches, each one
+ * acknowledged before sending the next one. The request fails at the first
+ * batch that is not acknowledged.
+ */
+static ssize_t hicnlight_prepare_route_create_batch(hc_sock_t *sock,
+                                                    hc_request_t *request,
+                                                    uint8_t **buffer) {
+  hc_request_t *current_request = hc_request_get_current(request);
+  hc_object_t *objects = hc_request_get_object(current_request);
+  size_t num_objects = hc_request_get_num_objects(current_request);
+  hc_data_t *data = hc_request_get_data(current_request);
+  hc_sock_light_data_t *s = (hc_sock_light_data_t *)sock->data;
+
+  hc_request_state_t state = hc_request_get_state(current_request);
+  DEBUG("hicnlight_prepare_route_create_batch > %s",
+        hc_request_state_str(state));
+
+  switch (state) {
+    case REQUEST_STATE_INIT:
+      for (size_t i = 0; i < num_objects; i++) {
+        if (hc_route_has_face(&objects[i].route)) {
+          ERROR(
+              "[hicnlight_prepare_route_create_batch] Routes in a batch "
+              "cannot create faces");
+          return -1;
+        }
+      }
+      hc_request_set_state_count(current_request, 0);
+      hc_request_set_state(current_request, REQUEST_STATE_ROUTE_CREATE_BATCH);
+      break;
+
+    case REQUEST_STATE_ROUTE_CREATE_BATCH:
+      _ASSERT(data);
+      if (!hc_data_get_result(data)) return 0;
+      break;
+
+    default:
+      return -1;
+  }
+
+  size_t pos = hc_request_get_state_count(current_request);
+  if (pos == num_objects) return 0;
+
+  size_t count = num_objects - pos;
+  if (count > ROUTE_ADD_BATCH_MAX) count = ROUTE_ADD_BATCH_MAX;
+  hc_request_set_state_count(current_request, (unsigned)(pos + count));
+
+  hc_request_reset_data(current_request);
+  data = hc_data_create(OBJECT_TYPE_ROUTE);
+  if (!data) {
+    ERROR("[hicnlight_prepare_route_create_batch] Could not create data");
+    return -1;
+  }
+  hc_request_set_data(current_request, data);
+
+  int msg_len =
+      hicnlight_route_serialize_create_batch(&objects[pos], count, s->batch);
+  if (msg_len < 0) return INPUT_ERROR;
+  ((hc_msg_t *)s->batch)->header.seq_num = hc_request_get_seq(current_request);
+
+  *buffer = s->batch;
+  return msg_len;
+}
+
+/* Serialization of list requests for objects that are retrieved by pages */
+static const hc_serialize_t hicnlight_list_page_serialize[OBJECT_TYPE_N] = {
+    [OBJECT_TYPE_CONNECTION] = hicnlight_connection_serialize_list_page,
+    [OBJECT_TYPE_ROUTE] = hicnlight_route_serialize_list_page,
+};
+
+/*
+ * Lists are retrieved by pages, each request carrying the last item received
+ * so far as a cursor, until an empty page is received. Pages are accumulated
+ * in the data of the request.
+ */
+static ssize_t hicnlight_prepare_list(hc_sock_t *sock, hc_request_t *request,
+                                      uint8_t **buffer) {
+  hc_request_t *current_request = hc_request_get_current(request);
+  hc_object_type_t object_type = hc_request_get_object_type(current_request);
+  hc_data_t *data = hc_request_get_data(current_request);
+  hc_sock_light_data_t *s = (hc_sock_light_data_t *)sock->data;
+  const hc_object_t *cursor = NULL;
+  ssize_t size;
+
+  hc_request_state_t state = hc_request_get_state(current_request);
+  DEBUG("hicnlight_prepare_list > %s", hc_request_state_str(state));
+
+  switch (state) {
+    case REQUEST_STATE_INIT:
+      _ASSERT(!data);
+      data = hc_data_create(object_type);
+      if (!data) {
+        ERROR("[hicnlight_prepare_list] Could not create data storage");
+        return -1;
+      }
+      hc_request_set_data(current_request, data);
+      hc_request_set_state_count(current_request, 0);
+      hc_request_set_state(current_request, REQUEST_STATE_LIST_PAGE);
+      break;
+
+    case REQUEST_STATE_LIST_PAGE:
+      _ASSERT(data);
+      /* Stop on error, or once an empty page has been received */
+      if (!hc_data_get_result(data)) return 0;
+      size = hc_data_get_size(data);
+      if (size == hc_request_get_state_count(current_request)) return 0;
+
+      hc_request_set_state_count(current_request, (unsigned)size);
+      cursor = hc_data_get_object(data, size - 1);
+      hc_data_set_incomplete(data);
+      break;
+
+    default:
+      return -1;
+  }
+
+  size = hicnlight_list_page_serialize[object_type](cursor, (uint8_t *)&s->msg);
+  if (size < 0) return INPUT_ERROR;
+  s->msg.header.seq_num = hc_request_get_seq(current_request);
+
+  *buffer = (uint8_t *)&s->msg;
+  return size;
+}
+
 static ssize_t hicnlight_prepare_connection_delete(hc_sock_t *sock,
                                                    hc_request_t *request,
                                                    uint8_t **buffer) {
@@ -1269,6 +1399,8 @@ static ssize_t hicnlight_prepare(hc_sock_t *sock, hc_request_t *request,
     case ACTION_CREATE:
       switch (object_type) {
         case OBJECT_TYPE_ROUTE:
+          if (hc_request_get_num_objects(current_request) > 1)
+            return hicnlight_prepare_route_create_batch(sock, request, buffer);
           /* Route might require face creation */
           return hicnlight_prepare_route_create(sock, request, buffer);
         case OBJECT_TYPE_CONNECTION:
@@ -1283,6 +1415,11 @@ static ssize_t hicnlight_prepare(hc_sock_t *sock, hc_request_t *request,
     case ACTION_GET:
       return hicnlight_prepare_get(sock, request, buffer);
 
+    case ACTION_LIST:
+      if (hicnlight_list_page_serialize[object_type])
+        return hicnlight_prepare_list(sock, request, buffer);
+      break;
+
     case ACTION_SUBSCRIBE:
       /* Transform subscription queries */
       memset(&object_subscribe, 0, sizeof(hc_object_t));
@@ -1417,7 +1554,7 @@ int hc_sock_initialize_module(hc_sock_t *s) {
       hicnlight_connection_module_ops;
   hc_sock_light.object_vft[OBJECT_TYPE_FACE] = HC_MODULE_OBJECT_OPS_EMPTY;
   hc_sock_light.object_vft[OBJECT_TYPE_PUNTING] = HC_MODULE_OBJECT_OPS_EMPTY;
-  hc_sock_light.object_vft[OBJECT_TYPE_CACHE] = HC_MODULE_OBJECT_OPS_EMPTY;
+  hc_sock_light.object_vft[OBJECT_TYPE_CACHE] = hicnlight_cache_module_ops;
   hc_sock_light.object_vft[OBJECT_TYPE_MAPME] = hicnlight_mapme_module_ops;
   hc_sock_light.object_vft[OBJECT_TYPE_WLDR] = HC_MODULE_OBJECT_OPS_EMPTY;
   hc_sock_light.object_vft[OBJECT_TYPE_POLICY] = HC_MODULE_OBJECT_OPS_EMPTY;
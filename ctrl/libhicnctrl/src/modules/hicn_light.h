@@ -29,6 +29,8 @@ typedef struct {
 
   /* Send buffer */
   hc_msg_t msg;
+  /* Send buffer for batches of objects */
+  u8 batch[COMMAND_MAX_SIZE];
 
   /* Partial receive buffer */
   u8 buf[RECV_BUFLEN];
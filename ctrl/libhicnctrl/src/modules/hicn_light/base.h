@@ -24,6 +24,7 @@
   _(cache_set_serve)           \
   _(cache_clear)               \
   _(cache_list)                \
+  _(cache_set_policy)          \
   _(strategy_set)              \
   _(strategy_add_local_prefix) \
   _(wldr_set)                  \
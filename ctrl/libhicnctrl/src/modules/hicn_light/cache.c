@@ -1,178 +1,65 @@
+/*
+ * Copyright (c) 2021-2023 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file modules/hicn_light/cache.c
+ * \brief Implementation of cache object VFT for hicn_light.
+ */
+
+#include <hicn/ctrl/hicn-light.h>
 #include "cache.h"
 
-/* CACHE SET STORE */
-
-static int _hcng_cache_set_store_internal(hc_sock_t *socket, hc_cache_t *cache,
-                                          bool async) {
-#if 0
-  msg_cache_set_store_t msg = {
-      .header =
-          {
-              .message_type = REQUEST_LIGHT,
-              .command_id = COMMAND_TYPE_CACHE_SET_STORE,
-              .length = 1,
-              .seq_num = 0,
-          },
-      .payload = {
-          .activate = cache->store,
-      }};
+static int hicnlight_cache_parse(const uint8_t *buffer, size_t size,
+                                 hc_cache_t *cache) {
+  return -1;
+}
 
-  hc_command_params_t params = {
-      .cmd = ACTION_STORE,
-      .cmd_id = COMMAND_TYPE_CACHE_SET_STORE,
-      .size_in = sizeof(cmd_cache_set_store_t),
-      .size_out = 0,
-      .parse = NULL,
-  };
+int _hicnlight_cache_parse(const uint8_t *buffer, size_t size,
+                           hc_object_t *object) {
+  return hicnlight_cache_parse(buffer, size, &object->cache);
+}
 
-  return _hcng_execute_command(socket, (hc_msg_t *)&msg, sizeof(msg), &params,
-                               NULL, async);
-#endif
-  return 0;  // XXX added
+int hicnlight_cache_serialize_create(const hc_object_t *object,
+                                     uint8_t *packet) {
+  return -1;
 }
 
-static int _hcng_cache_set_store(hc_sock_t *s, hc_cache_t *cache) {
-  return _hcng_cache_set_store_internal(s, cache, false);
+int hicnlight_cache_serialize_delete(const hc_object_t *object,
+                                     uint8_t *packet) {
+  return -1;
 }
 
-static int _hcng_cache_set_store_async(hc_sock_t *s, hc_cache_t *cache) {
-  return _hcng_cache_set_store_internal(s, cache, true);
+int hicnlight_cache_serialize_list(const hc_object_t *object, uint8_t *packet) {
+  return -1;
 }
 
-/* CACHE SET SERVE */
+int hicnlight_cache_serialize_set(const hc_object_t *object, uint8_t *packet) {
+  const hc_cache_t *cache = &object->cache;
 
-static int _hcng_cache_set_serve_internal(hc_sock_t *socket, hc_cache_t *cache,
-                                          bool async) {
-#if 0
-  msg_cache_set_serve_t msg = {
+  msg_cache_set_policy_t *msg = (msg_cache_set_policy_t *)packet;
+  *msg = (msg_cache_set_policy_t){
       .header =
           {
               .message_type = REQUEST_LIGHT,
-              .command_id = COMMAND_TYPE_CACHE_SET_SERVE,
+              .command_id = COMMAND_TYPE_CACHE_SET_POLICY,
               .length = 1,
               .seq_num = 0,
           },
-      .payload = {
-          .activate = cache->serve,
-      }};
-
-  hc_command_params_t params = {
-      .cmd = ACTION_SERVE,
-      .cmd_id = COMMAND_TYPE_CACHE_SET_SERVE,
-      .size_in = sizeof(cmd_cache_set_serve_t),
-      .size_out = 0,
-      .parse = NULL,
-  };
-
-  return _hcng_execute_command(socket, (hc_msg_t *)&msg, sizeof(msg), &params,
-                               NULL, async);
-#endif
-  return 0;  /// added
-}
-
-static int _hcng_cache_set_serve(hc_sock_t *s, hc_cache_t *cache) {
-  return _hcng_cache_set_serve_internal(s, cache, false);
-}
-
-static int _hcng_cache_set_serve_async(hc_sock_t *s, hc_cache_t *cache) {
-  return _hcng_cache_set_serve_internal(s, cache, true);
-}
-
-/* CACHE CLEAR */
-
-static int _hcng_cache_clear_internal(hc_sock_t *socket, hc_cache_t *cache,
-                                      bool async) {
-#if 0
-  msg_cache_clear_t msg = {.header = {
-                               .message_type = REQUEST_LIGHT,
-                               .command_id = COMMAND_TYPE_CACHE_CLEAR,
-                               .length = 1,
-                               .seq_num = 0,
-                           }};
-
-  hc_command_params_t params = {
-      .cmd = ACTION_CLEAR,
-      .cmd_id = COMMAND_TYPE_CACHE_CLEAR,
-      .size_in = sizeof(cmd_cache_clear_t),
-      .size_out = 0,
-      .parse = NULL,
-  };
+      .payload = {.policy = cache->policy}};
 
-  return _hcng_execute_command(socket, (hc_msg_t *)&msg, sizeof(msg), &params,
-                               NULL, async);
-#endif
-  return 0;  // XXX added
+  return sizeof(msg_cache_set_policy_t);
 }
 
-static int _hcng_cache_clear(hc_sock_t *s, hc_cache_t *cache) {
-  return _hcng_cache_clear_internal(s, cache, false);
-}
-
-/* CACHE PARSE */
-
-static int hc_cache_parse(void *in, hc_cache_info_t *cache_info) {
-  cmd_cache_list_reply_t *item = (cmd_cache_list_reply_t *)in;
-  *cache_info = (hc_cache_info_t){.store = item->store_in_cs,
-                                  .serve = item->serve_from_cs,
-                                  .cs_size = item->cs_size,
-                                  .num_stale_entries = item->num_stale_entries};
-
-  return 0;
-}
-
-/* CACHE LIST */
-
-static hc_result_t *_hcng_cache_list_serialize(hc_sock_t *socket,
-                                               hc_data_t **pdata, bool async) {
-  hc_result_t *res = malloc(sizeof(*res));
-  DEBUG("[hc_cache_list] async=%s", BOOLSTR(async));
-
-  msg_cache_list_t msg = {.header = {
-                              .message_type = REQUEST_LIGHT,
-                              .command_id = COMMAND_TYPE_CACHE_LIST,
-                              .length = 0,
-                              .seq_num = 0,
-                          }};
-
-  hc_command_params_t params = {
-      .cmd = ACTION_LIST,
-      .cmd_id = COMMAND_TYPE_CACHE_LIST,
-      .size_in = sizeof(cmd_cache_list_reply_t),
-      .size_out = sizeof(hc_cache_info_t),
-      .parse = (HC_PARSE)hc_cache_parse,
-  };
-
-  *res = (hc_result_t){
-      .msg =
-          (hc_msg_t){
-              .header = msg.header,
-              .payload.cache_list = msg.payload,
-          },
-      .params = params,
-      .async = async,
-      .success = true,
-  };
-  return res;
-}
-
-static int _hcng_cache_list_internal(hc_sock_t *socket, hc_data_t **pdata,
-                                     bool async) {
-#if 0
-  hc_result_t *result = _hcng_cache_list_serialize(socket, pdata, async);
-
-  int ret = INPUT_ERROR;
-  if (result->success) {
-    ret = _hcng_execute_command(socket, (hc_msg_t *)&result->msg,
-                                sizeof(result->msg), &result->params, pdata,
-                                result->async);
-  }
-
-  hc_result_free(result);
-  return ret;
-#endif
-  return 0;  // XXX added
-}
-
-static int _hcng_cache_list(hc_sock_t *s, hc_data_t **pdata) {
-  return _hcng_cache_list_internal(s, pdata, false);
-}
+DECLARE_MODULE_OBJECT_OPS(hicnlight, cache);
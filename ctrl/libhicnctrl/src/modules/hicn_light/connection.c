@@ -34,6 +34,9 @@ int hc_connection_to_local_listener(const hc_connection_t *connection,
     case FACE_TYPE_TCP:
       listener_type = FACE_TYPE_TCP_LISTENER;
       break;
+    case FACE_TYPE_MEMIF:
+      listener_type = FACE_TYPE_MEMIF_LISTENER;
+      break;
     default:
       return -1;
   }
@@ -495,6 +498,30 @@ int hicnlight_connection_serialize_list(const hc_object_t *object,
   return sizeof(msg_header_t);  // Do not use msg_connection_list_t
 }
 
+int hicnlight_connection_serialize_list_page(const hc_object_t *cursor,
+                                             uint8_t *packet) {
+  msg_connection_list_t *msg = (msg_connection_list_t *)packet;
+  *msg = (msg_connection_list_t){
+      .header =
+          {
+              .message_type = REQUEST_LIGHT,
+              .command_id = COMMAND_TYPE_CONNECTION_LIST,
+              .length = 1,
+              .seq_num = 0,
+          },
+      .payload = {
+          .max_items = LIST_PAGE_MAX_ITEMS,
+      }};
+
+  /* Connections are listed from the id following the one of the cursor */
+  if (cursor) {
+    msg->payload.id = cursor->connection.id;
+    msg->payload.has_cursor = 1;
+  }
+
+  return sizeof(msg_connection_list_t);
+}
+
 int hicnlight_connection_serialize_set(const hc_object_t *object,
                                        uint8_t *packet) {
   return -1;
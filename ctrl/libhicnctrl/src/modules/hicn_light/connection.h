@@ -8,4 +8,8 @@ int hc_connection_to_local_listener(const hc_connection_t *connection,
 
 DECLARE_MODULE_OBJECT_OPS_H(hicnlight, connection);
 
+/* Serializes the request for the page of connections following the cursor */
+int hicnlight_connection_serialize_list_page(const hc_object_t *cursor,
+                                             uint8_t *packet);
+
 #endif /* HICNCTRL_MODULE_HICNLIGHT_CONNECTION_H */
@@ -24,9 +24,10 @@ int hc_face_from_connection(const hc_connection_t *connection,
       };
       break;
     case FACE_TYPE_UDP:
+    case FACE_TYPE_MEMIF:
       *face = (hc_face_t){
           .id = connection->id,
-          .type = FACE_TYPE_UDP,
+          .type = connection->type,
           .family = connection->family,
           .local_addr = connection->local_addr,
           .local_port = connection->local_port,
@@ -145,6 +146,31 @@ int hc_face_to_connection(const hc_face_t *face, hc_connection_t *connection,
       snprintf(connection->interface_name, INTERFACE_LEN, "%s",
                face->netdevice.name);
       break;
+    case FACE_TYPE_MEMIF:
+      /* The remote port holds the memif interface id */
+      *connection = (hc_connection_t){
+          .type = FACE_TYPE_MEMIF,
+          .family = face->family,
+          .local_addr = face->local_addr,
+          .local_port = face->local_port,
+          .remote_addr = face->remote_addr,
+          .remote_port = face->remote_port,
+          .admin_state = face->admin_state,
+          .state = face->state,
+          .priority = face->priority,
+          .tags = face->tags,
+      };
+      if (generate_name) {
+        rc = snprintf(connection->name, SYMBOLIC_NAME_LEN, "memif%u",
+                      face->remote_port);
+        if (rc >= SYMBOLIC_NAME_LEN)
+          WARN(
+              "[hc_face_to_connection] Unexpected truncation of "
+              "symbolic name string");
+      } else {
+        memset(connection->name, 0, SYMBOLIC_NAME_LEN);
+      }
+      break;
     default:
       return -1;
   }
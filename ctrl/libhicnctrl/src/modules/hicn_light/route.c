@@ -75,41 +75,56 @@ int _hicnlight_route_parse(const uint8_t *buffer, size_t size,
 
 /* ROUTE CREATE */
 
-int hicnlight_route_serialize_create(const hc_object_t *object,
-                                     uint8_t *packet) {
-  const hc_route_t *route = &object->route;
+static int hicnlight_route_serialize_add(const hc_route_t *route,
+                                         cmd_route_add_t *cmd) {
   int rc;
 
-  msg_route_add_t *msg = (msg_route_add_t *)packet;
-  *msg = (msg_route_add_t){.header =
-                               {
-                                   .message_type = REQUEST_LIGHT,
-                                   .command_id = COMMAND_TYPE_ROUTE_ADD,
-                                   .length = 1,
-                                   .seq_num = 0,
-                               },
-                           .payload = {
-                               .address = route->remote_addr,
-                               .cost = route->cost,
-                               .family = route->family,
-                               .len = route->len,
-                           }};
+  *cmd = (cmd_route_add_t){
+      .address = route->remote_addr,
+      .cost = route->cost,
+      .family = route->family,
+      .len = route->len,
+  };
 
   /*
    * The route commands expects the ID or name as part of the
    * symbolic_or_connid attribute.
    */
   if (route->face_name[0] != '\0') {
-    rc = snprintf(msg->payload.symbolic_or_connid, SYMBOLIC_NAME_LEN, "%s",
+    rc = snprintf(cmd->symbolic_or_connid, SYMBOLIC_NAME_LEN, "%s",
                   route->face_name);
   } else {
-    rc = snprintf(msg->payload.symbolic_or_connid, SYMBOLIC_NAME_LEN, "%d",
+    rc = snprintf(cmd->symbolic_or_connid, SYMBOLIC_NAME_LEN, "%d",
                   route->face_id);
   }
 
   if ((rc < 0) || (rc >= SYMBOLIC_NAME_LEN)) return -1;
+  return 0;
+}
 
-  return sizeof(msg_route_add_t);
+int hicnlight_route_serialize_create(const hc_object_t *object,
+                                     uint8_t *packet) {
+  return hicnlight_route_serialize_create_batch(object, 1, packet);
+}
+
+int hicnlight_route_serialize_create_batch(const hc_object_t *objects,
+                                           size_t count, uint8_t *packet) {
+  if ((count == 0) || (count > ROUTE_ADD_BATCH_MAX)) return -1;
+
+  msg_route_add_t *msg = (msg_route_add_t *)packet;
+  msg->header = (cmd_header_t){
+      .message_type = REQUEST_LIGHT,
+      .command_id = COMMAND_TYPE_ROUTE_ADD,
+      .length = (uint16_t)count,
+      .seq_num = 0,
+  };
+
+  cmd_route_add_t *payload = &msg->payload;
+  for (size_t i = 0; i < count; i++)
+    if (hicnlight_route_serialize_add(&objects[i].route, payload + i) < 0)
+      return -1;
+
+  return sizeof(msg_header_t) + count * sizeof(cmd_route_add_t);
 }
 
 /* ROUTE DELETE */
@@ -170,6 +185,31 @@ int hicnlight_route_serialize_list(const hc_object_t *object, uint8_t *packet) {
   return sizeof(msg_header_t);  // Do not use msg_route_list_t
 }
 
+int hicnlight_route_serialize_list_page(const hc_object_t *cursor,
+                                        uint8_t *packet) {
+  msg_route_list_t *msg = (msg_route_list_t *)packet;
+  *msg = (msg_route_list_t){.header =
+                                {
+                                    .message_type = REQUEST_LIGHT,
+                                    .command_id = COMMAND_TYPE_ROUTE_LIST,
+                                    .length = 1,
+                                    .seq_num = 0,
+                                },
+                            .payload = {
+                                .max_items = LIST_PAGE_MAX_ITEMS,
+                            }};
+
+  /* Routes are listed from the prefix following the one of the cursor */
+  if (cursor) {
+    msg->payload.address = cursor->route.remote_addr;
+    msg->payload.family = (uint8_t)cursor->route.family;
+    msg->payload.len = cursor->route.len;
+    msg->payload.has_cursor = 1;
+  }
+
+  return sizeof(msg_route_list_t);
+}
+
 int hicnlight_route_serialize_set(const hc_object_t *object, uint8_t *packet) {
   return -1;
 }
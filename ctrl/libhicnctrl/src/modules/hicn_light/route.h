@@ -25,4 +25,12 @@
 
 DECLARE_MODULE_OBJECT_OPS_H(hicnlight, route);
 
+/* Serializes up to ROUTE_ADD_BATCH_MAX route creations in a single message */
+int hicnlight_route_serialize_create_batch(const hc_object_t *objects,
+                                           size_t count, uint8_t *packet);
+
+/* Serializes the request for the page of routes following the cursor */
+int hicnlight_route_serialize_list_page(const hc_object_t *cursor,
+                                        uint8_t *packet);
+
 #endif /* HICNCTRL_MODULE_HICNLIGHT_ROUTE_H */
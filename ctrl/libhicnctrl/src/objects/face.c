@@ -108,6 +108,8 @@ int hc_face_snprintf(char *s, size_t size, const hc_face_t *face) {
     case FACE_TYPE_UDP:
     case FACE_TYPE_TCP_LISTENER:
     case FACE_TYPE_UDP_LISTENER:
+    case FACE_TYPE_MEMIF:
+    case FACE_TYPE_MEMIF_LISTENER:
       rc = url_snprintf(local, MAXSZ_URL, &face->local_addr, face->local_port);
       if (rc >= MAXSZ_URL)
         WARN("[hc_face_snprintf] Unexpected truncation of URL string");
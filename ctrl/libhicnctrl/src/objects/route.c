@@ -148,6 +148,15 @@ int hc_route_create(hc_sock_t *s, hc_route_t *route) {
   return hc_execute(s, ACTION_CREATE, OBJECT_TYPE_ROUTE, &object, NULL);
 }
 
+int hc_route_create_batch(hc_sock_t *s, hc_route_t *routes, size_t n) {
+  hc_object_t *objects = calloc(n, sizeof(hc_object_t));
+  if (!objects) return -1;
+  for (size_t i = 0; i < n; i++) objects[i].route = routes[i];
+  int rc = hc_execute_batch(s, ACTION_CREATE, OBJECT_TYPE_ROUTE, objects, n);
+  free(objects);
+  return rc;
+}
+
 int hc_route_get(hc_sock_t *s, hc_route_t *route, hc_data_t **pdata) {
   hc_object_t object;
   memset(&object, 0, sizeof(hc_object_t));
@@ -18,6 +18,8 @@
  * \brief Implementation of stats.
  */
 
+#include <inttypes.h>
+
 #include <hicn/ctrl/api.h>
 #include <hicn/util/log.h>
 
@@ -40,6 +42,11 @@ int _hc_stats_snprintf(char *s, size_t size, const hc_object_t *object) {
 }
 
 int hc_stats_snprintf(char *s, size_t size, const hc_stats_t *stats) {
+  double suffixes_per_second =
+      stats->forwarder.usecsManifest
+          ? stats->forwarder.countManifestSuffixes * 1e6 /
+                stats->forwarder.usecsManifest
+          : 0;
   return snprintf(
       s, size,
       "*** STATS ***\nreceived = %u (interest = %u, data = %u)\ndropped = %u "
@@ -48,8 +55,14 @@ int hc_stats_snprintf(char *s, size_t size, const hc_stats_t *stats) {
       "send_failure = %u, no_route_in_fib = %u }\ninterest processing = { "
       "aggregated = %u, retransmitted = %u, satisfied_from_cs = %u, "
       "expired_interests = %u, expired_data = %u }\ndata processing = { "
-      "no_reverse_path = %u }\npacket cache = {PIT size = %u, CS size = %u, "
-      "eviction = %u}",
+      "no_reverse_path = %u }\nbatch processing = { batches = %u, packets = "
+      "%u, cycles = { analyze = %" PRIu64 ", prefetch = %" PRIu64
+      ", process = %" PRIu64 ", flush = %" PRIu64
+      " } }\ninterest manifests = { manifests = %u, suffixes = %u, splits = "
+      "%u, suffixes_per_second = %.0f }\npacket cache = {PIT size = %u, CS size = %u, "
+      "eviction = %u, stale PIT = %u, stale CS = %u, expired PIT = %u, "
+      "expired CS = %u}\ndisk cache = {size = %u, hits = %u, misses = %u, "
+      "promotions = %u, demotions = %u}",
       stats->forwarder.countReceived, stats->forwarder.countInterestsReceived,
       stats->forwarder.countObjectsReceived, stats->forwarder.countDropped,
       stats->forwarder.countInterestsDropped,
@@ -63,8 +76,18 @@ int hc_stats_snprintf(char *s, size_t size, const hc_stats_t *stats) {
       stats->forwarder.countInterestsSatisfiedFromStore,
       stats->forwarder.countInterestsExpired, stats->forwarder.countDataExpired,
       stats->forwarder.countDroppedNoReversePath,
+      stats->forwarder.countBatches, stats->forwarder.countBatchPackets,
+      stats->forwarder.cyclesAnalyze, stats->forwarder.cyclesPrefetch,
+      stats->forwarder.cyclesProcess, stats->forwarder.cyclesFlush,
+      stats->forwarder.countManifests, stats->forwarder.countManifestSuffixes,
+      stats->forwarder.countManifestSplits, suffixes_per_second,
       stats->pkt_cache.n_pit_entries, stats->pkt_cache.n_cs_entries,
-      stats->pkt_cache.n_lru_evictions);
+      stats->pkt_cache.n_lru_evictions, stats->pkt_cache.n_pit_stale_entries,
+      stats->pkt_cache.n_cs_stale_entries, stats->pkt_cache.n_pit_expired,
+      stats->pkt_cache.n_cs_expired, stats->pkt_cache.n_cs_disk_entries,
+      stats->pkt_cache.n_cs_disk_hits, stats->pkt_cache.n_cs_disk_misses,
+      stats->pkt_cache.n_cs_disk_promotions,
+      stats->pkt_cache.n_cs_disk_demotions);
 }
 
 int hc_stats_list(hc_sock_t *s, hc_data_t **pdata) {
@@ -95,10 +118,21 @@ int hc_face_stats_snprintf(char *s, size_t size, const hc_face_stats_t *stats) {
       "conn #%u:\tinterests =\t{ rx packets = %u, rx bytes = %u,  "
       "tx packets = %u,  tx bytes = %u }\n\t\tdata =\t\t{ rx packets "
       "= %u, rx bytes = %u,  "
-      "tx packets = %u,  tx bytes = %u }",
+      "tx packets = %u,  tx bytes = %u }\n\t\tio =\t\t{ rx calls = %u, rx "
+      "segments = %u (%.1f/call),  tx calls = %u,  tx segments = %u "
+      "(%.1f/call) }\n\t\trtt =\t\t{ srtt = %u us, rttvar = %u us,  min = "
+      "%u us,  samples = %u }",
       stats->conn_id, stats->interests.rx_pkts, stats->interests.rx_bytes,
       stats->interests.tx_pkts, stats->interests.tx_bytes, stats->data.rx_pkts,
-      stats->data.rx_bytes, stats->data.tx_pkts, stats->data.tx_bytes);
+      stats->data.rx_bytes, stats->data.tx_pkts, stats->data.tx_bytes,
+      stats->io.rx_calls, stats->io.rx_segments,
+      stats->io.rx_calls ? (double)stats->io.rx_segments / stats->io.rx_calls
+                         : 0.0,
+      stats->io.tx_calls, stats->io.tx_segments,
+      stats->io.tx_calls ? (double)stats->io.tx_segments / stats->io.tx_calls
+                         : 0.0,
+      stats->rtt.srtt, stats->rtt.rttvar, stats->rtt.min,
+      stats->rtt.n_samples);
 }
 
 int hc_face_stats_list(hc_sock_t *s, hc_data_t **pdata) {
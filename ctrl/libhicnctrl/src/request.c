@@ -36,6 +36,7 @@ struct hc_request_s {
   hc_action_t action;
   hc_object_type_t object_type;
   hc_object_t *object;
+  size_t num_objects;
 
 #if 0
   int (*parse)(const uint8_t *src, uint8_t *dst);
@@ -76,6 +77,7 @@ hc_request_t *hc_request_create(int seq, hc_action_t action,
   request->action = action;
   request->object_type = object_type;
   request->object = object;
+  request->num_objects = 1;
 
   request->callback = callback;
   request->callback_data = callback_data;
@@ -145,6 +147,14 @@ hc_object_t *hc_request_get_object(const hc_request_t *request) {
   return request->object;
 }
 
+size_t hc_request_get_num_objects(const hc_request_t *request) {
+  return request->num_objects;
+}
+
+void hc_request_set_num_objects(hc_request_t *request, size_t num_objects) {
+  request->num_objects = num_objects;
+}
+
 hc_data_t *hc_request_get_data(const hc_request_t *request) {
   return request->data;
 }
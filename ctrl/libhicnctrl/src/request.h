@@ -57,6 +57,8 @@ typedef int (*HC_PARSE)(const uint8_t *, uint8_t *);
   _(ROUTE_CREATE_FACE_CREATE)           \
   _(ROUTE_CREATE_FACE_CHECK)            \
   _(ROUTE_CREATE)                       \
+  _(ROUTE_CREATE_BATCH)                 \
+  _(LIST_PAGE)                          \
   _(GET_LIST)                           \
   _(COMPLETE)                           \
   _(N)
@@ -100,6 +102,9 @@ void hc_request_set_state_count(hc_request_t *request, unsigned count);
 hc_action_t hc_request_get_action(const hc_request_t *request);
 hc_object_type_t hc_request_get_object_type(const hc_request_t *request);
 hc_object_t *hc_request_get_object(const hc_request_t *request);
+/* Requests might apply to an array of objects (batches) */
+size_t hc_request_get_num_objects(const hc_request_t *request);
+void hc_request_set_num_objects(hc_request_t *request, size_t num_objects);
 hc_data_t *hc_request_get_data(const hc_request_t *request);
 void hc_request_set_data(hc_request_t *request, hc_data_t *data);
 void hc_request_reset_data(hc_request_t *request);
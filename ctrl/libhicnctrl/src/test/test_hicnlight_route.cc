@@ -18,6 +18,7 @@
 
 extern "C" {
 #include <hicn/ctrl/object.h>
+#include <hicn/ctrl/hicn-light.h>
 #include "../modules/hicn_light/route.h"
 }
 
@@ -84,6 +85,31 @@ const std::vector<uint8_t> valid_route_delete_payload = {
 const std::vector<uint8_t> valid_route_list_payload = {0xc0, 0x0a, 0x00, 0x00,
                                                        0x00, 0x00, 0x00, 0x00};
 
+const std::vector<uint8_t> valid_route_list_page_payload = {
+    /* uint8_t message_type = REQUEST_LIGHT */
+    0xc0,
+    /* uint8_t command_id = COMMAND_TYPE_ROUTE_LIST */
+    0x0a,
+    /* uint16_t length = 1 */
+    0x01, 0x00,
+    /* uint32_t seq_num = 0 */
+    0x00, 0x00, 0x00, 0x00,
+    /* hicn_ip_address_t address = {0, 0, 0, 127.0.0.1} */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x7f, 0x00, 0x00, 0x01,
+    /* uint32_t id = 0 */
+    0x00, 0x00, 0x00, 0x00,
+    /* uint16_t max_items = LIST_PAGE_MAX_ITEMS (256) */
+    0x00, 0x01,
+    /* uint8_t family = AF_INET (2) */
+    0x02,
+    /* uint8_t len = 16 */
+    0x10,
+    /* uint8_t has_cursor = 1 */
+    0x01,
+    /* 7-byte padding */
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00};
+
 TEST_F(TestHicnLightSerialize, TestHicnLightSerializeRouteCreate) {
   uint8_t buf[BUFSIZE];
 
@@ -130,4 +156,53 @@ TEST_F(TestHicnLightSerialize, TestHicnLightSerializeRouteList) {
   EXPECT_PAYLOAD_EQ(buf, n, valid_route_list_payload);
 }
 
+TEST_F(TestHicnLightSerialize, TestHicnLightSerializeRouteListPage) {
+  uint8_t buf[BUFSIZE];
+  memset(buf, 0, sizeof(buf));
+
+  hc_object_t obj;
+  memset(&obj, 0, sizeof(hc_object_t));
+  memcpy(&obj.route, &valid_route, sizeof(hc_route_t));
+
+  /* The route is used as the cursor */
+  size_t n = hicnlight_route_serialize_list_page(&obj, buf);
+
+  EXPECT_EQ(n, valid_route_list_page_payload.size());
+  EXPECT_PAYLOAD_EQ(buf, n, valid_route_list_page_payload);
+
+  /* First page */
+  n = hicnlight_route_serialize_list_page(NULL, buf);
+  EXPECT_EQ(n, valid_route_list_page_payload.size());
+  EXPECT_EQ(((cmd_list_page_t *)(buf + sizeof(msg_header_t)))->has_cursor, 0);
+}
+
+TEST_F(TestHicnLightSerialize, TestHicnLightSerializeRouteCreateBatch) {
+  uint8_t buf[BUFSIZE];
+
+  std::vector<hc_object_t> objs(3);
+  for (auto &obj : objs) {
+    memset(&obj, 0, sizeof(hc_object_t));
+    memcpy(&obj.route, &valid_route, sizeof(hc_route_t));
+  }
+
+  size_t n = hicnlight_route_serialize_create_batch(objs.data(), objs.size(),
+                                                    buf);
+  EXPECT_EQ(n, sizeof(msg_header_t) + objs.size() * sizeof(cmd_route_add_t));
+  EXPECT_EQ(((msg_header_t *)buf)->header.length, objs.size());
+
+  /* Each route is serialized as in a single route creation */
+  size_t item_size = sizeof(cmd_route_add_t);
+  for (size_t i = 0; i < objs.size(); i++)
+    EXPECT_EQ(memcmp(buf + sizeof(msg_header_t) + i * item_size,
+                     &valid_route_create_payload[sizeof(msg_header_t)],
+                     item_size),
+              0);
+
+  /* Batches are bounded by the size of forwarder commands */
+  std::vector<hc_object_t> many(ROUTE_ADD_BATCH_MAX + 1, objs[0]);
+  EXPECT_LT(hicnlight_route_serialize_create_batch(many.data(), many.size(),
+                                                   buf),
+            0);
+}
+
 }  // namespace
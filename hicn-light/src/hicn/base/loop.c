@@ -32,7 +32,7 @@
 
 #include "loop.h"
 
-loop_t *MAIN_LOOP = NULL;
+__thread loop_t *MAIN_LOOP = NULL;
 
 /**
  * \brief Holds all callback parameters
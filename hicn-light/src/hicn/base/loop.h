@@ -38,7 +38,8 @@ typedef struct {
 typedef struct loop_s loop_t;
 typedef struct event_s event_t;
 
-extern loop_t *MAIN_LOOP;
+/* One loop per thread, each forwarding worker running its own (see worker.h) */
+extern __thread loop_t *MAIN_LOOP;
 
 /**
  * \brief Creates a main loop
@@ -30,6 +30,7 @@
 
 #include "logo.h"
 #include "../core/forwarder.h"
+#include "../core/worker.h"
 #include "../config/configuration.h"  // XXX needed ?
 #include "../config/configuration_file.h"
 
@@ -39,8 +40,9 @@ static void usage(const char *prog) {
 #ifndef _WIN32
       " [--daemon]"
 #endif
-      " [--capacity objectStoreSize] [--log level]"
-      "[--log-file filename] [--config file]\n",
+      " [--capacity objectStoreSize] [--cs-disk file [--cs-disk-size MB]]"
+      " [--log level]"
+      "[--log-file filename] [--config file] [--workers n]\n",
       prog);
   printf("\n");
   printf(
@@ -79,6 +81,14 @@ static void usage(const char *prog) {
       "cache objectStoreSize must be 0.\n",
       "--capacity <objectStoreSize>");
   printf("%-30s   Default vaule for objectStoreSize is  100000\n", "");
+  printf(
+      "%-30s = move objects evicted from the cache to a file on local "
+      "storage, and serve them from there\n",
+      "--cs-disk <file>");
+  printf(
+      "%-30s = size of the cache file, per forwarding thread. Default is "
+      "1024\n",
+      "--cs-disk-size <MB>");
   printf(
       "%-30s = sets the log level. Available levels: trace, debug, info, warn, "
       "error, fatal\n",
@@ -86,6 +96,28 @@ static void usage(const char *prog) {
   printf("%-30s = file to write log messages to  (required in daemon mode)\n",
          "--log-file <output_logfile>");
   printf("%-30s = configuration filename\n", "--config <config_path>");
+  printf(
+      "%-30s = number of forwarding threads, packets being sharded across "
+      "them by name prefix. Default is 1\n",
+      "--workers <n>");
+  printf(
+      "%-30s = send packets queued on UDP connections as segmented "
+      "super-datagrams (UDP GSO)\n",
+      "--udp-gso");
+  printf(
+      "%-30s = let the kernel coalesce datagrams received on UDP listeners "
+      "(UDP GRO). Ignored with --io-uring\n",
+      "--udp-gro");
+  printf("%-30s = read and write UDP sockets through io_uring\n",
+         "--io-uring");
+  printf(
+      "%-30s = same as --io-uring, with a kernel thread polling for "
+      "submissions\n",
+      "--io-uring-sqpoll");
+  printf(
+      "%-30s = UNIX socket on which local applications connect memif faces. "
+      "Default is /run/hicn-light/memif.sock\n",
+      "--memif-socket <path>");
   printf("\n");
 }
 
@@ -218,6 +250,48 @@ configuration_t *parse_commandline(int argc, const char *argv[]) {
         int capacity = atoi(argv[i + 1]);
         configuration_set_cs_size(configuration, capacity);
         i++;
+      } else if (strcmp(argv[i], "--cs-disk") == 0) {
+        if (configuration_set_cs_disk(configuration, argv[i + 1], 0) < 0) {
+          fprintf(stderr, "Invalid disk content store path\n");
+          usage(argv[0]);
+          exit(EXIT_FAILURE);
+        }
+        i++;
+      } else if (strcmp(argv[i], "--cs-disk-size") == 0) {
+        int size_mb = atoi(argv[i + 1]);
+        if (size_mb < 1) {
+          fprintf(stderr, "Invalid disk content store size\n");
+          usage(argv[0]);
+          exit(EXIT_FAILURE);
+        }
+        configuration_set_cs_disk(configuration,
+                                  configuration_get_cs_disk_path(configuration),
+                                  (size_t)size_mb * 1024 * 1024);
+        i++;
+      } else if (strcmp(argv[i], "--workers") == 0) {
+        int n_workers = atoi(argv[i + 1]);
+        if (n_workers < 1) {
+          fprintf(stderr, "Invalid number of workers\n");
+          usage(argv[0]);
+          exit(EXIT_FAILURE);
+        }
+        configuration_set_n_workers(configuration, n_workers);
+        i++;
+      } else if (strcmp(argv[i], "--udp-gso") == 0) {
+        configuration_set_udp_gso(configuration, true);
+      } else if (strcmp(argv[i], "--udp-gro") == 0) {
+        configuration_set_udp_gro(configuration, true);
+      } else if (strcmp(argv[i], "--io-uring") == 0) {
+        configuration_set_io_uring(configuration, true, false);
+      } else if (strcmp(argv[i], "--io-uring-sqpoll") == 0) {
+        configuration_set_io_uring(configuration, true, true);
+      } else if (strcmp(argv[i], "--memif-socket") == 0) {
+        if (configuration_set_memif_socket(configuration, argv[i + 1]) < 0) {
+          fprintf(stderr, "Invalid memif socket path\n");
+          usage(argv[0]);
+          exit(EXIT_FAILURE);
+        }
+        i++;
       } else if (strcmp(argv[i], "--log") == 0) {
         int loglevel = loglevel_from_str(argv[i + 1]);
         configuration_set_loglevel(configuration, loglevel);
@@ -291,6 +365,17 @@ int main(int argc, const char *argv[]) {
        configuration_get_port(configuration),
        configuration_get_configuration_port(configuration));
 
+  /* Additional forwarding workers, the main thread acting as worker 0 */
+  workers_t *workers = NULL;
+  unsigned n_workers = configuration_get_n_workers(configuration);
+  if (n_workers > 1) {
+    workers = workers_create(forwarder, n_workers);
+    if (!workers) {
+      ERROR("Failed to start %u forwarding workers", n_workers);
+      return EXIT_FAILURE;
+    }
+  }
+
   /* Main loop */
   if (loop_dispatch(MAIN_LOOP) < 0) {
     ERROR("Failed to run main loop");
@@ -298,6 +383,7 @@ int main(int argc, const char *argv[]) {
   }
 
   INFO("loop stopped");
+  if (workers) workers_free(workers);
   forwarder_free(forwarder);
   loop_free(MAIN_LOOP);
   MAIN_LOOP = NULL;
@@ -77,6 +77,32 @@
     (msg)->header.seq_num = (seq_number);                                \
   } while (0);
 
+/*
+ * Paginated lists: returns the page requested by a list command, or NULL if
+ * all items are requested at once (no payload).
+ */
+static inline const cmd_list_page_t *get_list_page(const uint8_t *packet) {
+  const msg_header_t *msg = (const msg_header_t *)packet;
+  if (msg->header.length == 0) return NULL;
+  return (const cmd_list_page_t *)(packet + sizeof(msg_header_t));
+}
+
+static inline size_t get_list_page_max_items(const cmd_list_page_t *page,
+                                             size_t min_items) {
+  size_t max_items = page->max_items;
+  if ((max_items == 0) || (max_items > LIST_PAGE_MAX_ITEMS))
+    max_items = LIST_PAGE_MAX_ITEMS;
+  if (max_items < min_items) max_items = min_items;
+  return max_items;
+}
+
+static inline int get_list_page_prefix(const cmd_list_page_t *page,
+                                       hicn_prefix_t *prefix) {
+  hicn_ip_prefix_t ip_prefix = {
+      .family = page->family, .address = page->address, .len = page->len};
+  return hicn_prefix_create_from_ip_prefix(&ip_prefix, prefix);
+}
+
 // conn_id = UINT_MAX when symbolic_name is not found
 static inline unsigned _symbolic_to_conn_id(forwarder_t *forwarder,
                                             const char *symbolic_or_connid,
@@ -132,7 +158,7 @@ connection_t *getConnectionBySymbolicOrId(forwarder_t *forwarder,
 /* Listener */
 
 uint8_t *configuration_on_listener_add(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id,
+                                       size_t size, unsigned ingress_id,
                                        size_t *reply_size) {
   INFO("CMD: listener add (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -146,10 +172,12 @@ uint8_t *configuration_on_listener_add(forwarder_t *forwarder, uint8_t *packet,
     case FACE_TYPE_UDP_LISTENER:
     case FACE_TYPE_TCP_LISTENER:
     case FACE_TYPE_HICN_LISTENER:
+    case FACE_TYPE_MEMIF_LISTENER:
       break;
     case FACE_TYPE_UDP:
     case FACE_TYPE_TCP:
     case FACE_TYPE_HICN:
+    case FACE_TYPE_MEMIF:
       ERROR("Wrong listener type");
       goto NACK;
   }
@@ -235,7 +263,8 @@ unsigned symbolic_to_listener_id(forwarder_t *forwarder,
 }
 
 uint8_t *configuration_on_listener_remove(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size) {
   INFO("CMD: listener remove (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -341,7 +370,7 @@ static inline void fill_listener_command(const listener_t *listener,
 }
 
 uint8_t *configuration_on_listener_list(forwarder_t *forwarder, uint8_t *packet,
-                                        unsigned ingress_id,
+                                        size_t size, unsigned ingress_id,
                                         size_t *reply_size) {
   INFO("CMD: listener list (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -376,7 +405,8 @@ NACK:
 /* Connection */
 
 uint8_t *configuration_on_connection_add(forwarder_t *forwarder,
-                                         uint8_t *packet, unsigned ingress_id,
+                                         uint8_t *packet, size_t size,
+                                         unsigned ingress_id,
                                          size_t *reply_size) {
   INFO("CMD: connection add (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -390,10 +420,12 @@ uint8_t *configuration_on_connection_add(forwarder_t *forwarder,
     case FACE_TYPE_UDP:
     case FACE_TYPE_TCP:
     case FACE_TYPE_HICN:
+    case FACE_TYPE_MEMIF:
       break;
     case FACE_TYPE_UDP_LISTENER:
     case FACE_TYPE_TCP_LISTENER:
     case FACE_TYPE_HICN_LISTENER:
+    case FACE_TYPE_MEMIF_LISTENER:
     case FACE_TYPE_UNDEFINED:
     case FACE_TYPE_N:
       goto NACK;
@@ -449,7 +481,7 @@ NACK:
  */
 
 uint8_t *configuration_on_connection_remove(forwarder_t *forwarder,
-                                            uint8_t *packet,
+                                            uint8_t *packet, size_t size,
                                             unsigned ingress_id,
                                             size_t *reply_size) {
   INFO("CMD: connection remove (ingress=%d)", ingress_id);
@@ -557,7 +589,8 @@ static inline void fill_connections_command(const connection_t *connection,
 }
 
 uint8_t *configuration_on_connection_list(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size) {
   INFO("CMD: connection list (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -572,18 +605,27 @@ uint8_t *configuration_on_connection_list(forwarder_t *forwarder,
   uint8_t command_id = msg_received->header.command_id;
   uint32_t seq_num = msg_received->header.seq_num;
 
+  /* Connections following the cursor id, by increasing id */
+  const cmd_list_page_t *page = get_list_page(packet);
+  if (page) n = get_list_page_max_items(page, 1);
+
   msg_connection_list_reply_t *msg = NULL;
   msg_malloc_list(msg, command_id, n, seq_num);
   if (!msg) goto NACK;
 
   cmd_connection_list_item_t *payload = &msg->payload;
+  size_t pos = 0;
   connection_table_foreach_new(table, connection, {
     if (connection->id == ingress_id) continue;
-    fill_connections_command(connection, payload);
-    payload++;
+    if (page && page->has_cursor && connection->id <= page->id) continue;
+    if (pos == n) goto END;
+    fill_connections_command(connection, payload + pos);
+    pos++;
   });
 
-  *reply_size = sizeof(msg->header) + n * sizeof(msg->payload);
+END:
+  msg->header.length = (uint16_t)pos;
+  *reply_size = sizeof(msg->header) + pos * sizeof(msg->payload);
   return (uint8_t *)msg;
 
 NACK:
@@ -595,6 +637,7 @@ NACK:
 #if 0
 uint8_t *configuration_on_connection_set_admin_state(forwarder_t *forwarder,
                                                      uint8_t *packet,
+                                                     size_t size,
                                                      unsigned ingress_id,
                                                      size_t *reply_size) {
   assert(forwarder);
@@ -630,7 +673,7 @@ NACK:
 
 #endif
 uint8_t *configuration_on_connection_update(forwarder_t *forwarder,
-                                            uint8_t *packet,
+                                            uint8_t *packet, size_t size,
                                             unsigned ingress_id,
                                             size_t *reply_size) {
   assert(forwarder);
@@ -660,7 +703,7 @@ NACK:
 #if 0
 
 uint8_t *configuration_on_connection_set_priority(forwarder_t *forwarder,
-                                                  uint8_t *packet,
+                                                  uint8_t *packet, size_t size,
                                                   unsigned ingress_id,
                                                   size_t *reply_size) {
   assert(forwarder);
@@ -690,7 +733,7 @@ NACK:
 }
 
 uint8_t *configuration_on_connection_set_tags(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size) {
   assert(forwarder);
@@ -723,28 +766,45 @@ NACK:
 /* Route */
 
 uint8_t *configuration_on_route_add(forwarder_t *forwarder, uint8_t *packet,
-                                    unsigned ingress_id, size_t *reply_size) {
+                                    size_t size, unsigned ingress_id,
+                                    size_t *reply_size) {
   INFO("CMD: route add (ingress=%d)", ingress_id);
   assert(forwarder);
   assert(packet);
 
   *reply_size = sizeof(msg_header_t);
   msg_route_add_t *msg = (msg_route_add_t *)packet;
-  cmd_route_add_t *control = &msg->payload;
 
-  unsigned conn_id = symbolic_to_conn_id_self(
-      forwarder, control->symbolic_or_connid, ingress_id);
+  /*
+   * The header length is the number of routes in the message. All routes are
+   * added, and the command is acknowledged only if they all succeed.
+   */
+  size_t n = msg->header.length;
+  if ((n == 0) || (n > ROUTE_ADD_BATCH_MAX)) goto NACK;
+  if (size < sizeof(msg_header_t) + n * sizeof(cmd_route_add_t)) {
+    ERROR("Route add message too short for %zu routes", n);
+    goto NACK;
+  }
+
+  bool success = true;
+  cmd_route_add_t *control = &msg->payload;
+  for (size_t i = 0; i < n; i++, control++) {
+    unsigned conn_id = symbolic_to_conn_id_self(
+        forwarder, control->symbolic_or_connid, ingress_id);
 
-  /* We accept routes without conn_id */
+    /* We accept routes without conn_id */
 #if 0
-  if (!connection_id_is_valid(conn_id)) goto NACK;
+    if (!connection_id_is_valid(conn_id)) goto NACK;
 #endif
 
-  hicn_ip_prefix_t prefix = {.family = control->family,
-                             .address = control->address,
-                             .len = control->len};
+    hicn_ip_prefix_t prefix = {.family = control->family,
+                               .address = control->address,
+                               .len = control->len};
 
-  if (!forwarder_add_or_update_route(forwarder, &prefix, conn_id)) goto NACK;
+    if (!forwarder_add_or_update_route(forwarder, &prefix, conn_id))
+      success = false;
+  }
+  if (!success) goto NACK;
 
   make_ack(msg);
   return (uint8_t *)msg;
@@ -755,7 +815,7 @@ NACK:
 }
 
 uint8_t *configuration_on_route_remove(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id,
+                                       size_t size, unsigned ingress_id,
                                        size_t *reply_size) {
   INFO("CMD: route remove (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -809,8 +869,57 @@ static inline off_t fill_route_command(const fib_entry_t *entry,
   return pos;
 }
 
+/*
+ * A page holds the next hops of the FIB entries following the cursor prefix.
+ * Entries are never split across pages, and those without next hops are
+ * skipped, so that an empty page is only returned at the end of the FIB.
+ */
+static uint8_t *configuration_on_route_list_page(const fib_t *fib,
+                                                 const cmd_list_page_t *page,
+                                                 uint8_t command_id,
+                                                 uint32_t seq_num,
+                                                 size_t *reply_size) {
+  msg_route_list_reply_t *msg = NULL;
+  hicn_prefix_t prefix;
+  const hicn_prefix_t *cursor = NULL;
+  if (page->has_cursor) {
+    if (get_list_page_prefix(page, &prefix) < 0) goto NACK;
+    cursor = &prefix;
+  }
+
+  size_t max_items = get_list_page_max_items(page, MAX_NEXTHOPS);
+  msg_malloc_list(msg, command_id, max_items, seq_num);
+  if (!msg) goto NACK;
+
+  fib_entry_t *entries[LIST_PAGE_MAX_ITEMS];
+  size_t n = 0;
+  for (;;) {
+    size_t max_entries = max_items - n;
+    size_t n_entries =
+        fib_get_entries_after(fib, cursor, entries, max_entries);
+    for (size_t i = 0; i < n_entries; i++) {
+      const nexthops_t *nexthops = fib_entry_get_nexthops(entries[i]);
+      if (n + nexthops_get_len(nexthops) > max_items) goto END;
+      n += fill_route_command(entries[i], &msg->payload + n);
+    }
+    if ((n_entries < max_entries) || (n == max_items)) break;
+    cursor = fib_entry_get_prefix(entries[n_entries - 1]);
+  }
+
+END:
+  msg->header.length = (uint16_t)n;
+  *reply_size = sizeof(msg->header) + n * sizeof(msg->payload);
+  return (uint8_t *)msg;
+
+NACK:
+  *reply_size = sizeof(msg_header_t);
+  make_nack(msg);
+  return (uint8_t *)msg;
+}
+
 uint8_t *configuration_on_route_list(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size) {
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size) {
   INFO("CMD: route list (ingress=%d)", ingress_id);
   assert(forwarder);
   assert(packet);
@@ -820,6 +929,11 @@ uint8_t *configuration_on_route_list(forwarder_t *forwarder, uint8_t *packet,
   uint32_t seq_num = msg_received->header.seq_num;
   const fib_t *fib = forwarder_get_fib(forwarder);
 
+  const cmd_list_page_t *page = get_list_page(packet);
+  if (page)
+    return configuration_on_route_list_page(fib, page, command_id, seq_num,
+                                            reply_size);
+
   /*
    * Two step approach to precompute the number of entries to allocate
    *
@@ -853,7 +967,8 @@ NACK:
 /* Cache */
 
 uint8_t *configuration_on_cache_set_store(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size) {
   INFO("CMD: cache set store (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -878,7 +993,8 @@ NACK:
 }
 
 uint8_t *configuration_on_cache_set_serve(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size) {
   INFO("CMD: cache set serve (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -902,8 +1018,60 @@ NACK:
   return (uint8_t *)msg;
 }
 
+static cs_type_t cs_type_from_cache_policy(cache_policy_t policy) {
+  switch (policy) {
+    case CACHE_POLICY_LRU:
+      return CS_TYPE_LRU;
+    case CACHE_POLICY_TINYLFU:
+      return CS_TYPE_TINYLFU;
+    case CACHE_POLICY_S3FIFO:
+      return CS_TYPE_S3FIFO;
+    default:
+      return CS_TYPE_UNDEFINED;
+  }
+}
+
+static cache_policy_t cache_policy_from_cs_type(cs_type_t type) {
+  switch (type) {
+    case CS_TYPE_LRU:
+      return CACHE_POLICY_LRU;
+    case CS_TYPE_TINYLFU:
+      return CACHE_POLICY_TINYLFU;
+    case CS_TYPE_S3FIFO:
+      return CACHE_POLICY_S3FIFO;
+    default:
+      return CACHE_POLICY_UNDEFINED;
+  }
+}
+
+uint8_t *configuration_on_cache_set_policy(forwarder_t *forwarder,
+                                           uint8_t *packet, size_t size,
+                                           unsigned ingress_id,
+                                           size_t *reply_size) {
+  INFO("CMD: cache set policy (ingress=%d)", ingress_id);
+  assert(forwarder);
+  assert(packet);
+
+  *reply_size = sizeof(msg_header_t);
+  msg_cache_set_policy_t *msg = (msg_cache_set_policy_t *)packet;
+  cmd_cache_set_policy_t *control = &msg->payload;
+
+  cs_type_t type = cs_type_from_cache_policy(control->policy);
+  if (!CS_TYPE_VALID(type)) goto NACK;
+
+  if (forwarder_cs_set_policy(forwarder, type) < 0) goto NACK;
+
+  make_ack(msg);
+  return (uint8_t *)msg;
+
+NACK:
+  make_nack(msg);
+  return (uint8_t *)msg;
+}
+
 uint8_t *configuration_on_cache_clear(forwarder_t *forwarder, uint8_t *packet,
-                                      unsigned ingress_id, size_t *reply_size) {
+                                      size_t size, unsigned ingress_id,
+                                      size_t *reply_size) {
   INFO("CMD: cache clear (ingress=%d)", ingress_id);
   assert(forwarder);
   assert(packet);
@@ -918,7 +1086,8 @@ uint8_t *configuration_on_cache_clear(forwarder_t *forwarder, uint8_t *packet,
 }
 
 uint8_t *configuration_on_cache_list(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size) {
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size) {
   INFO("CMD: cache list (ingress=%d)", ingress_id);
   assert(forwarder);
   assert(packet);
@@ -934,6 +1103,8 @@ uint8_t *configuration_on_cache_list(forwarder_t *forwarder, uint8_t *packet,
       .payload = {
           .store_in_cs = forwarder_cs_get_store(forwarder),
           .serve_from_cs = forwarder_cs_get_serve(forwarder),
+          .policy = cache_policy_from_cs_type(
+              forwarder_cs_get_policy(forwarder)),
           .cs_size = (unsigned int)forwarder_cs_get_size(forwarder),
           .num_stale_entries =
               (unsigned int)forwarder_cs_get_num_stale_entries(forwarder)}};
@@ -945,7 +1116,7 @@ uint8_t *configuration_on_cache_list(forwarder_t *forwarder, uint8_t *packet,
 /* Strategy */
 
 uint8_t *configuration_on_strategy_set(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id,
+                                       size_t size, unsigned ingress_id,
                                        size_t *reply_size) {
   INFO("CMD: strategy set (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -1002,6 +1173,7 @@ NACK:
 
 uint8_t *configuration_on_strategy_add_local_prefix(forwarder_t *forwarder,
                                                     uint8_t *packet,
+                                                    size_t size,
                                                     unsigned ingress_id,
                                                     size_t *reply_size) {
   INFO("CMD: strategy add local prefix (ingress=%d)", ingress_id);
@@ -1069,7 +1241,8 @@ NACK:
 /* Statistics */
 
 uint8_t *configuration_on_stats_list(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size) {
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size) {
   assert(forwarder && packet);
   INFO("CMD: stats list (ingress=%d)", ingress_id);
 
@@ -1097,7 +1270,8 @@ NACK:
 }
 
 uint8_t *configuration_on_face_stats_list(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size) {
   assert(forwarder && packet);
   INFO("CMD: face stats list (ingress=%d)", ingress_id);
@@ -1134,7 +1308,8 @@ NACK:
 /* WLDR */
 
 uint8_t *configuration_on_wldr_set(forwarder_t *forwarder, uint8_t *packet,
-                                   unsigned ingress_id, size_t *reply_size) {
+                                   size_t size, unsigned ingress_id,
+                                   size_t *reply_size) {
   assert(forwarder);
   assert(packet);
 
@@ -1164,7 +1339,8 @@ NACK:
 /* Punting */
 
 uint8_t *configuration_on_punting_add(forwarder_t *forwarder, uint8_t *packet,
-                                      unsigned ingress_id, size_t *reply_size) {
+                                      size_t size, unsigned ingress_id,
+                                      size_t *reply_size) {
   // #if !defined(__APPLE__) && !defined(_WIN32) && defined(PUNTING)
   msg_punting_add_t *msg = (msg_punting_add_t *)packet;
 
@@ -1218,7 +1394,7 @@ NACK:
 
 #ifdef WITH_MAPME
 uint8_t *configuration_on_mapme_enable(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id,
+                                       size_t size, unsigned ingress_id,
                                        size_t *reply_size) {
   INFO("CMD: mapme enable (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -1245,7 +1421,7 @@ NACK:
 }
 
 uint8_t *configuration_on_mapme_set_discovery(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size) {
   INFO("CMD: mapme discovery (ingress=%d)", ingress_id);
@@ -1273,7 +1449,7 @@ NACK:
 }
 
 uint8_t *configuration_on_mapme_set_timescale(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size) {
   INFO("CMD: mapme timescale (ingress=%d)", ingress_id);
@@ -1298,7 +1474,8 @@ NACK:
 }
 
 uint8_t *configuration_on_mapme_set_retx(forwarder_t *forwarder,
-                                         uint8_t *packet, unsigned ingress_id,
+                                         uint8_t *packet, size_t size,
+                                         unsigned ingress_id,
                                          size_t *reply_size) {
   INFO("CMD: mapme retransmission (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -1322,7 +1499,8 @@ NACK:
 }
 
 uint8_t *configuration_on_mapme_add(forwarder_t *forwarder, uint8_t *packet,
-                                    unsigned ingress_id, size_t *reply_size) {
+                                    size_t size, unsigned ingress_id,
+                                    size_t *reply_size) {
   assert(forwarder);
   assert(packet);
 
@@ -1416,7 +1594,8 @@ NACK:
 /* Policy */
 
 uint8_t *configuration_on_policy_add(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size) {
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size) {
   assert(forwarder);
   assert(packet);
 
@@ -1441,7 +1620,7 @@ NACK:
 }
 
 uint8_t *configuration_on_policy_remove(forwarder_t *forwarder, uint8_t *packet,
-                                        unsigned ingress_id,
+                                        size_t size, unsigned ingress_id,
                                         size_t *reply_size) {
   assert(forwarder);
   assert(packet);
@@ -1499,7 +1678,8 @@ static inline void fill_policy_command(const fib_entry_t *entry,
 }
 
 uint8_t *configuration_on_policy_list(forwarder_t *forwarder, uint8_t *packet,
-                                      unsigned ingress_id, size_t *reply_size) {
+                                      size_t size, unsigned ingress_id,
+                                      size_t *reply_size) {
   assert(forwarder);
   assert(packet);
 
@@ -1513,16 +1693,42 @@ uint8_t *configuration_on_policy_list(forwarder_t *forwarder, uint8_t *packet,
   uint32_t seq_num = msg_received->header.seq_num;
 
   msg_policy_list_reply_t *msg = NULL;
+  cmd_policy_list_item_t *payload;
+
+  /* Policies of the FIB entries following the cursor prefix */
+  const cmd_list_page_t *page = get_list_page(packet);
+  if (page) {
+    hicn_prefix_t prefix;
+    const hicn_prefix_t *cursor = NULL;
+    if (page->has_cursor) {
+      if (get_list_page_prefix(page, &prefix) < 0) goto NACK;
+      cursor = &prefix;
+    }
+
+    fib_entry_t *entries[LIST_PAGE_MAX_ITEMS];
+    n = fib_get_entries_after(fib, cursor, entries,
+                              get_list_page_max_items(page, 1));
+    msg_malloc_list(msg, command_id, n, seq_num);
+    if (!msg) goto NACK;
+
+    payload = &msg->payload;
+    for (size_t i = 0; i < n; i++) fill_policy_command(entries[i], payload++);
+
+    *reply_size = sizeof(msg->header) + n * sizeof(msg->payload);
+    return (uint8_t *)msg;
+  }
+
   msg_malloc_list(msg, command_id, n, seq_num);
   if (!msg) goto NACK;
 
-  cmd_policy_list_item_t *payload = &msg->payload;
+  payload = &msg->payload;
 
   fib_foreach_entry(fib, entry, {
     fill_policy_command(entry, payload);
     payload++;
   });
 
+  *reply_size = sizeof(msg->header) + n * sizeof(msg->payload);
   return (uint8_t *)msg;
 #endif /* WITH_POLICY */
 
@@ -1534,7 +1740,8 @@ NACK:
 /* Subscription */
 
 uint8_t *configuration_on_subscription_add(forwarder_t *forwarder,
-                                           uint8_t *packet, unsigned ingress_id,
+                                           uint8_t *packet, size_t size,
+                                           unsigned ingress_id,
                                            size_t *reply_size) {
   INFO("CMD: subscription add (ingress=%d)", ingress_id);
   assert(forwarder);
@@ -1563,7 +1770,7 @@ NACK:
 }
 
 uint8_t *configuration_on_subscription_remove(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size) {
   INFO("CMD: subscription remove (ingress=%d)", ingress_id);
@@ -1587,7 +1794,7 @@ uint8_t *configuration_on_subscription_remove(forwarder_t *forwarder,
 }
 
 uint8_t *configuration_on_active_interface_update(forwarder_t *forwarder,
-                                                  uint8_t *packet,
+                                                  uint8_t *packet, size_t size,
                                                   unsigned ingress_id,
                                                   size_t *reply_size) {
   msg_active_interface_update_t *msg = (msg_active_interface_update_t *)packet;
@@ -1595,10 +1802,19 @@ uint8_t *configuration_on_active_interface_update(forwarder_t *forwarder,
   return (uint8_t *)msg;
 }
 
-uint8_t *command_process(forwarder_t *forwarder, uint8_t *packet,
+uint8_t *command_process(forwarder_t *forwarder, uint8_t *packet, size_t size,
                          unsigned ingress_id, size_t *reply_size) {
   uint8_t *reply = NULL;
 
+  /* The header is needed to dispatch the command */
+  if (size < sizeof(msg_header_t)) {
+    ERROR("Truncated command");
+    reply = packet;
+    make_nack(reply);
+    if (reply_size) *reply_size = sizeof(msg_header_t);
+    return reply;
+  }
+
   /*
    * For most commands, the packet will simply be transformed into an ack.
    * For list commands, a new message will be allocated, and the return value
@@ -1609,10 +1825,11 @@ uint8_t *command_process(forwarder_t *forwarder, uint8_t *packet,
    */
   command_type_t command_type = ((msg_header_t *)packet)->header.command_id;
   switch (command_type) {
-#define _(l, u)                                                              \
-  case COMMAND_TYPE_##u:                                                     \
-    reply = configuration_on_##l(forwarder, packet, ingress_id, reply_size); \
-    assert(reply);                                                           \
+#define _(l, u)                                                       \
+  case COMMAND_TYPE_##u:                                              \
+    reply = configuration_on_##l(forwarder, packet, size, ingress_id, \
+                                 reply_size);                         \
+    assert(reply);                                                    \
     break;
     foreach_command_type
 #undef _
@@ -1637,7 +1854,8 @@ ssize_t command_process_msgbuf(forwarder_t *forwarder, msgbuf_t *msgbuf) {
   uint8_t *reply = NULL;
   size_t reply_size = 0;
 
-  reply = command_process(forwarder, packet, ingress_id, &reply_size);
+  reply = command_process(forwarder, packet, msgbuf_get_len(msgbuf), ingress_id,
+                          &reply_size);
   if (connection_id_is_valid(msgbuf->connection_id)) {
     connection_table_t *table = forwarder_get_connection_table(forwarder);
     const connection_t *connection = connection_table_at(table, ingress_id);
@@ -31,125 +31,150 @@
 #include <hicn/ctrl/api.h>
 #include <hicn/ctrl/hicn-light.h>
 
-uint8_t *command_process(forwarder_t *forwarder, uint8_t *packet,
+uint8_t *command_process(forwarder_t *forwarder, uint8_t *packet, size_t size,
                          unsigned ingress_id, size_t *reply_size);
 
 ssize_t command_process_msgbuf(forwarder_t *forwarder, msgbuf_t *msgbuf);
 
 uint8_t *configuration_on_listener_add(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id, size_t *reply_size);
+                                       size_t size, unsigned ingress_id,
+                                       size_t *reply_size);
 
 uint8_t *configuration_on_listener_remove(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size);
 
 uint8_t *configuration_on_listener_list(forwarder_t *forwarder, uint8_t *packet,
-                                        unsigned ingress_id,
+                                        size_t size, unsigned ingress_id,
                                         size_t *reply_size);
 
 uint8_t *configuration_on_connection_add(forwarder_t *forwarder,
-                                         uint8_t *packet, unsigned ingress_id,
+                                         uint8_t *packet, size_t size,
+                                         unsigned ingress_id,
                                          size_t *reply_size);
 
 uint8_t *configuration_on_connection_remove(forwarder_t *forwarder,
-                                            uint8_t *packet,
+                                            uint8_t *packet, size_t size,
                                             unsigned ingress_id,
                                             size_t *reply_size);
 
 uint8_t *configuration_on_connection_list(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size);
 
 uint8_t *configuration_on_connection_set_admin_state(forwarder_t *forwarder,
                                                      uint8_t *packet,
+                                                     size_t size,
                                                      unsigned ingress_id,
                                                      size_t *reply_size);
 
 uint8_t *configuration_on_connection_update(forwarder_t *forwarder,
-                                            uint8_t *packet,
+                                            uint8_t *packet, size_t size,
                                             unsigned ingress_id,
                                             size_t *reply_size);
 
 uint8_t *configuration_on_connection_set_priority(forwarder_t *forwarder,
-                                                  uint8_t *packet,
+                                                  uint8_t *packet, size_t size,
                                                   unsigned ingress_id,
                                                   size_t *reply_size);
 
 uint8_t *configuration_on_connection_set_tags(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size);
 
 uint8_t *configuration_on_route_add(forwarder_t *forwarder, uint8_t *packet,
-                                    unsigned ingress_id, size_t *reply_size);
+                                    size_t size, unsigned ingress_id,
+                                    size_t *reply_size);
 
 uint8_t *configuration_on_route_remove(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id, size_t *reply_size);
+                                       size_t size, unsigned ingress_id,
+                                       size_t *reply_size);
 
 uint8_t *configuration_on_route_list(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size);
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size);
 
 uint8_t *configuration_on_cache_set_store(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size);
 
 uint8_t *configuration_on_cache_set_serve(forwarder_t *forwarder,
-                                          uint8_t *packet, unsigned ingress_id,
+                                          uint8_t *packet, size_t size,
+                                          unsigned ingress_id,
                                           size_t *reply_size);
 
 uint8_t *configuration_on_cache_clear(forwarder_t *forwarder, uint8_t *packet,
-                                      unsigned ingress_id, size_t *reply_size);
+                                      size_t size, unsigned ingress_id,
+                                      size_t *reply_size);
+
+uint8_t *configuration_on_cache_set_policy(forwarder_t *forwarder,
+                                           uint8_t *packet, size_t size,
+                                           unsigned ingress_id,
+                                           size_t *reply_size);
 
 uint8_t *configuration_on_strategy_set(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id, size_t *reply_size);
+                                       size_t size, unsigned ingress_id,
+                                       size_t *reply_size);
 
 uint8_t *configuration_on_strategy_add_local_prefix(forwarder_t *forwarder,
                                                     uint8_t *packet,
+                                                    size_t size,
                                                     unsigned ingress_id,
                                                     size_t *reply_size);
 
 uint8_t *configuration_on_wldr_set(forwarder_t *forwarder, uint8_t *packet,
-                                   unsigned ingress_id, size_t *reply_size);
+                                   size_t size, unsigned ingress_id,
+                                   size_t *reply_size);
 
 uint8_t *configuration_on_punting_add(forwarder_t *forwarder, uint8_t *packet,
-                                      unsigned ingress_id, size_t *reply_size);
+                                      size_t size, unsigned ingress_id,
+                                      size_t *reply_size);
 
 #ifdef WITH_MAPME
 uint8_t *configuration_on_mapme_enable(forwarder_t *forwarder, uint8_t *packet,
-                                       unsigned ingress_id, size_t *reply_size);
+                                       size_t size, unsigned ingress_id,
+                                       size_t *reply_size);
 
 uint8_t *configuration_on_mapme_set_discovery(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size);
 
 uint8_t *configuration_on_mapme_set_timescale(forwarder_t *forwarder,
-                                              uint8_t *packet,
+                                              uint8_t *packet, size_t size,
                                               unsigned ingress_id,
                                               size_t *reply_size);
 
 uint8_t *configuration_on_mapme_set_retx(forwarder_t *forwarder,
-                                         uint8_t *packet, unsigned ingress_id,
+                                         uint8_t *packet, size_t size,
+                                         unsigned ingress_id,
                                          size_t *reply_size);
 
 uint8_t *configuration_on_mapme_send_update(forwarder_t *forwarder,
-                                            uint8_t *packet,
+                                            uint8_t *packet, size_t size,
                                             unsigned ingress_id,
                                             size_t *reply_size);
 #endif /* WITH_MAPME */
 
 uint8_t *configuration_on_policy_add(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size);
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size);
 
 uint8_t *configuration_on_policy_remove(forwarder_t *forwarder, uint8_t *packet,
-                                        unsigned ingress_id,
+                                        size_t size, unsigned ingress_id,
                                         size_t *reply_size);
 
 uint8_t *configuration_on_policy_list(forwarder_t *forwarder, uint8_t *packet,
-                                      unsigned ingress_id, size_t *reply_size);
+                                      size_t size, unsigned ingress_id,
+                                      size_t *reply_size);
 
 uint8_t *configuration_on_stats_list(forwarder_t *forwarder, uint8_t *packet,
-                                     unsigned ingress_id, size_t *reply_size);
+                                     size_t size, unsigned ingress_id,
+                                     size_t *reply_size);
 
 void commands_notify_connection(const forwarder_t *forwarder,
                                 connection_event_t event,
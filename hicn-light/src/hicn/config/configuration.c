@@ -27,6 +27,7 @@
 #endif
 #include <ctype.h>
 #include <hicn/hicn-light/config.h>
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -56,6 +57,9 @@
 #define DEFAULT_PORT 1234
 #define DEFAULT_LOGLEVEL "info"
 #define DEFAULT_CS_CAPACITY 100000
+#define DEFAULT_CS_DISK_SIZE (1024 * 1024 * 1024)
+#define DEFAULT_N_WORKERS 1
+#define DEFAULT_MEMIF_SOCKET "/run/hicn-light/memif.sock"
 
 #define msg_malloc_list(msg, N, seq_number)                           \
   do {                                                                \
@@ -74,6 +78,8 @@ struct configuration_s {
   uint16_t port;
   uint16_t configuration_port;
   size_t cs_capacity;
+  char cs_disk_path[PATH_MAX];
+  size_t cs_disk_size;
   int loglevel;
   const char *logfile;
   int logfile_fd;
@@ -84,6 +90,16 @@ struct configuration_s {
 
   size_t n_suffixes_per_split;
   int_manifest_split_strategy_t split_strategy;
+
+  unsigned n_workers;
+
+  bool udp_gso;
+  bool udp_gro;
+
+  bool io_uring;
+  bool io_uring_sqpoll;
+
+  char memif_socket[PATH_MAX];
 };
 
 configuration_t *configuration_create() {
@@ -94,6 +110,8 @@ configuration_t *configuration_create() {
   config->port = PORT_NUMBER;
   config->configuration_port = 2001;  // TODO(eloparco): What is this?
   config->cs_capacity = DEFAULT_CS_CAPACITY;
+  config->cs_disk_path[0] = '\0';
+  config->cs_disk_size = DEFAULT_CS_DISK_SIZE;
   config->logfile = NULL;
   config->logfile_fd = -1;
 #ifndef _WIN32
@@ -107,10 +125,50 @@ configuration_t *configuration_create() {
   config->prefix_keys = slab_create(prefix_key_t, SLAB_INIT_SIZE);
   config->n_suffixes_per_split = DEFAULT_N_SUFFIXES_PER_SPLIT;
   config->split_strategy = DEFAULT_DISAGGREGATION_STRATEGY;
+  config->n_workers = DEFAULT_N_WORKERS;
+  config->udp_gso = false;
+  config->udp_gro = false;
+  config->io_uring = false;
+  config->io_uring_sqpoll = false;
+  configuration_set_memif_socket(config, DEFAULT_MEMIF_SOCKET);
 
   return config;
 }
 
+configuration_t *configuration_copy(const configuration_t *config) {
+  assert(config);
+
+  configuration_t *copy = configuration_create();
+  if (!copy) return NULL;
+
+  copy->fn_config = config->fn_config;
+  copy->port = config->port;
+  copy->configuration_port = config->configuration_port;
+  copy->cs_capacity = config->cs_capacity;
+  configuration_set_cs_disk(copy, configuration_get_cs_disk_path(config),
+                            config->cs_disk_size);
+  /* Log settings are global: the copy shares them without reopening files */
+  copy->loglevel = config->loglevel;
+  copy->logfile = config->logfile;
+  copy->logfile_fd = config->logfile_fd;
+  copy->daemon = config->daemon;
+  copy->n_suffixes_per_split = config->n_suffixes_per_split;
+  copy->split_strategy = config->split_strategy;
+  copy->n_workers = config->n_workers;
+  copy->udp_gso = config->udp_gso;
+  copy->udp_gro = config->udp_gro;
+  copy->io_uring = config->io_uring;
+  copy->io_uring_sqpoll = config->io_uring_sqpoll;
+  configuration_set_memif_socket(copy, configuration_get_memif_socket(config));
+
+  const char *prefix;
+  strategy_type_t strategy_type;
+  kh_foreach(config->strategy_map, prefix, strategy_type,
+             { configuration_set_strategy(copy, prefix, strategy_type); });
+
+  return copy;
+}
+
 void configuration_free(configuration_t *config) {
   assert(config);
 
@@ -128,6 +186,46 @@ void configuration_set_cs_size(configuration_t *config, size_t size) {
   config->cs_capacity = size;
 }
 
+int configuration_set_cs_disk(configuration_t *config, const char *path,
+                              size_t size) {
+  if (!path) {
+    config->cs_disk_path[0] = '\0';
+  } else if (path != config->cs_disk_path) {
+    int rc = snprintf(config->cs_disk_path, PATH_MAX, "%s", path);
+    if (rc < 0 || rc >= PATH_MAX) {
+      config->cs_disk_path[0] = '\0';
+      return -1;
+    }
+  }
+  if (size != 0) config->cs_disk_size = size;
+  return 0;
+}
+
+const char *configuration_get_cs_disk_path(const configuration_t *config) {
+  return config->cs_disk_path[0] != '\0' ? config->cs_disk_path : NULL;
+}
+
+size_t configuration_get_cs_disk_size(const configuration_t *config) {
+  return config->cs_disk_size;
+}
+
+int configuration_set_memif_socket(configuration_t *config, const char *path) {
+  if (!path) {
+    config->memif_socket[0] = '\0';
+    return 0;
+  }
+  int rc = snprintf(config->memif_socket, PATH_MAX, "%s", path);
+  if (rc < 0 || rc >= PATH_MAX) {
+    config->memif_socket[0] = '\0';
+    return -1;
+  }
+  return 0;
+}
+
+const char *configuration_get_memif_socket(const configuration_t *config) {
+  return config->memif_socket[0] != '\0' ? config->memif_socket : NULL;
+}
+
 const char *configuration_get_fn_config(const configuration_t *config) {
   return config->fn_config;
 }
@@ -156,6 +254,44 @@ int_manifest_split_strategy_t configuration_get_split_strategy(
   return config->split_strategy;
 }
 
+void configuration_set_n_workers(configuration_t *config, unsigned n_workers) {
+  config->n_workers = n_workers;
+}
+
+unsigned configuration_get_n_workers(const configuration_t *config) {
+  return config->n_workers;
+}
+
+void configuration_set_udp_gso(configuration_t *config, bool enabled) {
+  config->udp_gso = enabled;
+}
+
+bool configuration_get_udp_gso(const configuration_t *config) {
+  return config->udp_gso;
+}
+
+void configuration_set_udp_gro(configuration_t *config, bool enabled) {
+  config->udp_gro = enabled;
+}
+
+bool configuration_get_udp_gro(const configuration_t *config) {
+  return config->udp_gro;
+}
+
+void configuration_set_io_uring(configuration_t *config, bool enabled,
+                                bool sqpoll) {
+  config->io_uring = enabled;
+  config->io_uring_sqpoll = enabled && sqpoll;
+}
+
+bool configuration_get_io_uring(const configuration_t *config) {
+  return config->io_uring;
+}
+
+bool configuration_get_io_uring_sqpoll(const configuration_t *config) {
+  return config->io_uring_sqpoll;
+}
+
 void configuration_set_port(configuration_t *config, uint16_t port) {
   config->port = port;
 }
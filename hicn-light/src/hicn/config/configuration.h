@@ -69,6 +69,19 @@ configuration_t *configuration_create();
  */
 void configuration_free(configuration_t *config);
 
+/**
+ * @brief Create a deep copy of a configuration.
+ *
+ * This is used to give each forwarding worker its own configuration
+ * instance, since a forwarder takes ownership of (and frees) the
+ * configuration it is created with. Log settings are process-wide and are
+ * shared rather than reopened.
+ *
+ * @param [in] config - Configuration to copy
+ * @return A newly allocated configuration, or NULL in case of error
+ */
+configuration_t *configuration_copy(const configuration_t *config);
+
 /**
  * Returns the configured size of the content store
  *
@@ -99,6 +112,36 @@ size_t configuration_get_cs_size(const configuration_t *config);
  */
 void configuration_set_cs_size(configuration_t *config, size_t size);
 
+/**
+ * @brief Enable the second-tier (disk) content store (see
+ * content_store/disk.h), where packets evicted from the in-memory content
+ * store are moved to.
+ *
+ * @param[in] path File backing the disk tier, NULL to disable it. Each
+ * forwarding worker besides the first one uses its own file, suffixed with
+ * the worker index.
+ * @param[in] size Size of the file in bytes, for each worker (0 = use the
+ * current value, 1 GB by default)
+ *
+ * @return int 0 if successful, -1 if the path is too long
+ */
+int configuration_set_cs_disk(configuration_t *config, const char *path,
+                              size_t size);
+
+const char *configuration_get_cs_disk_path(const configuration_t *config);
+
+size_t configuration_get_cs_disk_size(const configuration_t *config);
+
+/**
+ * @brief Set the path of the UNIX socket on which memif listeners accept
+ * local applications (/run/hicn-light/memif.sock by default).
+ *
+ * @return int 0 if successful, -1 if the path is too long
+ */
+int configuration_set_memif_socket(configuration_t *config, const char *path);
+
+const char *configuration_get_memif_socket(const configuration_t *config);
+
 const char *configuration_get_fn_config(const configuration_t *config);
 
 void configuration_set_fn_config(configuration_t *config,
@@ -116,6 +159,53 @@ void configuration_set_split_strategy(
 int_manifest_split_strategy_t configuration_get_split_strategy(
     const configuration_t *config);
 
+/**
+ * @brief Set the number of forwarding workers (threads) to run.
+ *
+ * Each worker owns its own packet cache, message buffer pool and listener
+ * sockets; packets are sharded across workers by name-prefix hash (see
+ * core/worker.h). A value of 1 keeps the historical single-threaded
+ * behaviour.
+ */
+void configuration_set_n_workers(configuration_t *config, unsigned n_workers);
+
+unsigned configuration_get_n_workers(const configuration_t *config);
+
+/**
+ * @brief Enable UDP generic segmentation offload on UDP connections.
+ *
+ * Consecutive packets of the same size queued on a connection are handed
+ * over to the kernel as a single super-datagram (UDP_SEGMENT), which is
+ * split either by the NIC or late in the stack. Connections fall back to
+ * one datagram per packet if the kernel or device rejects it.
+ */
+void configuration_set_udp_gso(configuration_t *config, bool enabled);
+
+bool configuration_get_udp_gso(const configuration_t *config);
+
+/**
+ * @brief Enable UDP generic receive offload on UDP listeners.
+ *
+ * The kernel may then coalesce several datagrams from the same flow into a
+ * single read, which is split back into individual packets by the listener.
+ */
+void configuration_set_udp_gro(configuration_t *config, bool enabled);
+
+bool configuration_get_udp_gro(const configuration_t *config);
+
+/**
+ * @brief Use io_uring instead of the event loop for UDP sockets (see
+ * io/uring.h), optionally with a kernel thread polling for submissions
+ * (SQPOLL). The forwarder falls back to the event loop if io_uring is not
+ * available.
+ */
+void configuration_set_io_uring(configuration_t *config, bool enabled,
+                                bool sqpoll);
+
+bool configuration_get_io_uring(const configuration_t *config);
+
+bool configuration_get_io_uring_sqpoll(const configuration_t *config);
+
 void configuration_set_port(configuration_t *config, uint16_t port);
 
 uint16_t configuration_get_port(const configuration_t *config);
@@ -108,7 +108,7 @@ bool configuration_file_process(forwarder_t *forwarder, const char *filename) {
     }
 
     size_t _unused;
-    command_process(forwarder, (uint8_t *)msg, CONNECTION_ID_UNDEFINED,
+    command_process(forwarder, (uint8_t *)msg, msg_len, CONNECTION_ID_UNDEFINED,
                     &_unused);
   }
 
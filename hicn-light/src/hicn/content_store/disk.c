@@ -0,0 +1,296 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file disk.c
+ * \brief Implementation of the second-tier (disk) content store
+ */
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <hicn/util/khash.h>
+#include <hicn/util/log.h>
+#include <hicn/util/pool.h>
+
+#include "disk.h"
+
+#define CS_DISK_ALIGN 8
+#define cs_disk_align(x) (((x) + CS_DISK_ALIGN - 1) & ~(CS_DISK_ALIGN - 1))
+
+/*
+ * A record holds the msgbuf fields needed to serve the packet again, followed
+ * by the packet itself. The header offset in the packet buffer is relative to
+ * the msgbuf, and thus remains valid once copied into another msgbuf.
+ */
+typedef struct {
+  hicn_name_t name;
+  Ticks expire_ts;
+  hicn_packet_buffer_t pkbuf;
+  unsigned connection_id;
+  unsigned path_label;
+  uint16_t len;
+  uint8_t packet[];
+} cs_disk_record_t;
+
+/* Name hash -> offset of the record in the file */
+KHASH_MAP_INIT_INT(cs_disk_index, uint64_t);
+
+struct cs_disk_s {
+  char *path;
+  int fd;
+  uint8_t *base;
+  size_t segment_size;
+
+  /* Segment being filled, and number of bytes used in each segment */
+  unsigned segment;
+  size_t segment_used[CS_DISK_N_SEGMENTS];
+
+  kh_cs_disk_index_t *index;
+  cs_disk_stats_t stats;
+};
+
+#define cs_disk_record_at(disk, offset) \
+  ((cs_disk_record_t *)((disk)->base + (offset)))
+
+#define cs_disk_record_size(len) \
+  cs_disk_align(sizeof(cs_disk_record_t) + (len))
+
+#ifndef _WIN32
+
+cs_disk_t *cs_disk_create(const char *path, size_t max_size) {
+  assert(path);
+
+  if (max_size < CS_DISK_MIN_SIZE) {
+    ERROR("[cs_disk_create] Disk content store size must be at least %u bytes",
+          CS_DISK_MIN_SIZE);
+    return NULL;
+  }
+
+  cs_disk_t *disk = malloc(sizeof(cs_disk_t));
+  if (!disk) return NULL;
+
+  disk->path = strdup(path);
+  if (!disk->path) goto ERR_PATH;
+
+  disk->segment_size =
+      (max_size / CS_DISK_N_SEGMENTS) & ~((size_t)CS_DISK_ALIGN - 1);
+  size_t size = disk->segment_size * CS_DISK_N_SEGMENTS;
+
+  disk->fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0600);
+  if (disk->fd < 0) {
+    ERROR("[cs_disk_create] Could not open %s: %s", path, strerror(errno));
+    goto ERR_OPEN;
+  }
+
+  if (ftruncate(disk->fd, size) < 0) {
+    ERROR("[cs_disk_create] Could not resize %s: %s", path, strerror(errno));
+    goto ERR_MMAP;
+  }
+
+  disk->base =
+      mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, disk->fd, 0);
+  if (disk->base == MAP_FAILED) {
+    ERROR("[cs_disk_create] Could not map %s: %s", path, strerror(errno));
+    goto ERR_MMAP;
+  }
+
+  /* Lookups jump around the file, do not read ahead */
+  madvise(disk->base, size, MADV_RANDOM);
+
+  disk->segment = 0;
+  memset(disk->segment_used, 0, sizeof(disk->segment_used));
+  disk->index = kh_init_cs_disk_index();
+  disk->stats = (cs_disk_stats_t){0};
+
+  INFO("Disk content store: %zu bytes in %s", size, path);
+  return disk;
+
+ERR_MMAP:
+  close(disk->fd);
+  unlink(path);
+ERR_OPEN:
+  free(disk->path);
+ERR_PATH:
+  free(disk);
+  return NULL;
+}
+
+void cs_disk_free(cs_disk_t *disk) {
+  assert(disk);
+
+  kh_destroy_cs_disk_index(disk->index);
+  munmap(disk->base, disk->segment_size * CS_DISK_N_SEGMENTS);
+  close(disk->fd);
+  unlink(disk->path);
+  free(disk->path);
+  free(disk);
+}
+
+#else
+
+cs_disk_t *cs_disk_create(const char *path, size_t max_size) {
+  ERROR("[cs_disk_create] Disk content store not supported on this platform");
+  return NULL;
+}
+
+void cs_disk_free(cs_disk_t *disk) {}
+
+#endif /* _WIN32 */
+
+void cs_disk_clear(cs_disk_t *disk) {
+  assert(disk);
+
+  kh_clear_cs_disk_index(disk->index);
+  disk->segment = 0;
+  memset(disk->segment_used, 0, sizeof(disk->segment_used));
+}
+
+/**
+ * Drop from the index the packets stored in a segment, before it is reused.
+ * Records overridden by a more recent one with the same name hash are
+ * skipped.
+ */
+static void cs_disk_recycle_segment(cs_disk_t *disk, unsigned segment) {
+  uint64_t offset = (uint64_t)segment * disk->segment_size;
+  uint64_t end = offset + disk->segment_used[segment];
+
+  while (offset < end) {
+    cs_disk_record_t *record = cs_disk_record_at(disk, offset);
+
+    khiter_t k =
+        kh_get_cs_disk_index(disk->index, hicn_name_get_hash(&record->name));
+    if (k != kh_end(disk->index) && kh_val(disk->index, k) == offset) {
+      kh_del_cs_disk_index(disk->index, k);
+      disk->stats.countDrops++;
+    }
+
+    offset += cs_disk_record_size(record->len);
+  }
+
+  disk->segment_used[segment] = 0;
+}
+
+int cs_disk_store(cs_disk_t *disk, const msgbuf_t *msgbuf, Ticks expire_ts) {
+  assert(disk);
+  assert(msgbuf);
+  assert(msgbuf_get_type(msgbuf) == HICN_PACKET_TYPE_DATA);
+
+  size_t len = msgbuf_get_len(msgbuf);
+  size_t record_size = cs_disk_record_size(len);
+  if (record_size > disk->segment_size) return -1;
+
+  /* Move to the next segment if the current one is full */
+  if (disk->segment_used[disk->segment] + record_size > disk->segment_size) {
+    disk->segment = (disk->segment + 1) % CS_DISK_N_SEGMENTS;
+    cs_disk_recycle_segment(disk, disk->segment);
+  }
+
+  uint64_t offset = (uint64_t)disk->segment * disk->segment_size +
+                    disk->segment_used[disk->segment];
+  cs_disk_record_t *record = cs_disk_record_at(disk, offset);
+  record->name = *msgbuf_get_name(msgbuf);
+  record->expire_ts = expire_ts;
+  record->pkbuf = *msgbuf_get_pkbuf(msgbuf);
+  record->connection_id = msgbuf_get_connection_id(msgbuf);
+  record->path_label = msgbuf->path_label;
+  record->len = (uint16_t)len;
+  memcpy(record->packet, msgbuf->packet, len);
+  disk->segment_used[disk->segment] += record_size;
+
+  /* A previous record with the same name hash is no longer reachable */
+  int ret;
+  khiter_t k = kh_put_cs_disk_index(
+      disk->index, hicn_name_get_hash(&record->name), &ret);
+  kh_val(disk->index, k) = offset;
+
+  disk->stats.countDemotions++;
+  return 0;
+}
+
+off_t cs_disk_load(cs_disk_t *disk, const hicn_name_t *name,
+                   msgbuf_pool_t *msgbuf_pool, Ticks *expire_ts) {
+  assert(disk);
+  assert(name);
+
+  u32 name_hash = hicn_name_get_hash(name);
+  khiter_t k = kh_get_cs_disk_index(disk->index, name_hash);
+  if (k == kh_end(disk->index)) goto MISS;
+
+  cs_disk_record_t *record = cs_disk_record_at(disk, kh_val(disk->index, k));
+  if (!hicn_name_equals(&record->name, name)) goto MISS;
+
+  if (ticks_now() >= record->expire_ts) {
+    kh_del_cs_disk_index(disk->index, k);
+    goto MISS;
+  }
+
+  /*
+   * Callers hold pointers to msgbufs being processed: never let the reload
+   * trigger a resize of the pool.
+   */
+  if (pool_get_free_indices_size(msgbuf_pool->buffers) == 0) {
+    DEBUG("No free msgbuf to reload packet from disk");
+    return INVALID_MSGBUF_ID;
+  }
+
+  msgbuf_t *msgbuf;
+  off_t msgbuf_id = msgbuf_pool_get(msgbuf_pool, &msgbuf);
+  memcpy(msgbuf->packet, record->packet, record->len);
+  msgbuf->pkbuf = record->pkbuf;
+  hicn_packet_set_buffer(msgbuf_get_pkbuf(msgbuf), msgbuf->packet, MTU,
+                         record->len);
+  msgbuf_set_name(msgbuf, &record->name);
+  msgbuf->connection_id = record->connection_id;
+  msgbuf->path_label = record->path_label;
+  msgbuf->recv_ts = usecs_now();
+  *expire_ts = record->expire_ts;
+
+  disk->stats.countHits++;
+  return msgbuf_id;
+
+MISS:
+  disk->stats.countMisses++;
+  return INVALID_MSGBUF_ID;
+}
+
+void cs_disk_remove(cs_disk_t *disk, const hicn_name_t *name) {
+  assert(disk);
+  assert(name);
+
+  khiter_t k = kh_get_cs_disk_index(disk->index, hicn_name_get_hash(name));
+  if (k == kh_end(disk->index)) return;
+
+  /* The record might have been overwritten since it was loaded */
+  cs_disk_record_t *record = cs_disk_record_at(disk, kh_val(disk->index, k));
+  if (!hicn_name_equals(&record->name, name)) return;
+
+  kh_del_cs_disk_index(disk->index, k);
+  disk->stats.countPromotions++;
+}
+
+size_t cs_disk_get_num_entries(const cs_disk_t *disk) {
+  return kh_size(disk->index);
+}
+
+cs_disk_stats_t cs_disk_get_stats(const cs_disk_t *disk) {
+  return disk->stats;
+}
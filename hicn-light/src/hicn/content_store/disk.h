@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file disk.h
+ * \brief Second-tier (disk) content store
+ *
+ * Data packets evicted from the in-memory content store are demoted to a
+ * memory-mapped file on local storage, and promoted back into a msgbuf when
+ * an interest matches them.
+ *
+ * The file is managed as a log: it is split into a fixed number of segments,
+ * which are filled in order and recycled in FIFO order once the file is full.
+ * The packets of a recycled segment are dropped from the index, which maps
+ * the name hash of each packet to its record in the file. Names are checked
+ * upon lookup, so that a hash collision results in a miss.
+ *
+ * The file content is not meant to survive a restart of the forwarder: it is
+ * truncated upon creation and removed when the disk tier is freed.
+ */
+
+#ifndef HICNLIGHT_CS_DISK_H
+#define HICNLIGHT_CS_DISK_H
+
+#include <hicn/core/msgbuf_pool.h>
+
+#define CS_DISK_N_SEGMENTS 16
+
+/* Smallest allowed file, so that each segment can hold a few packets */
+#define CS_DISK_MIN_SIZE (CS_DISK_N_SEGMENTS * 4 * MTU)
+
+/**
+ * @brief Count the number of:
+ * - packets read back from disk
+ * - lookups not matching any packet on disk
+ * - packets moved from disk back to the in-memory content store
+ * - packets moved from the in-memory content store to disk
+ * - packets dropped from disk when their segment is recycled
+ */
+typedef struct {
+  uint64_t countHits;
+  uint64_t countMisses;
+  uint64_t countPromotions;
+  uint64_t countDemotions;
+  uint64_t countDrops;
+} cs_disk_stats_t;
+
+typedef struct cs_disk_s cs_disk_t;
+
+/**
+ * @brief Create the disk tier of the content store.
+ *
+ * @param[in] path Path of the file to use, which is created or truncated
+ * @param[in] max_size Size of the file, in bytes
+ *
+ * @return cs_disk_t* The newly created disk tier, NULL in case of error
+ */
+cs_disk_t *cs_disk_create(const char *path, size_t max_size);
+
+/**
+ * @brief Free the disk tier and remove its file.
+ *
+ * @param[in] disk Pointer to the disk tier to free
+ */
+void cs_disk_free(cs_disk_t *disk);
+
+/**
+ * @brief Drop all the packets stored on disk.
+ *
+ * @param[in] disk Pointer to the disk tier to clear
+ */
+void cs_disk_clear(cs_disk_t *disk);
+
+/**
+ * @brief Write a data packet to disk (demotion).
+ *
+ * @param[in] disk Pointer to the disk tier to use
+ * @param[in] msgbuf Data packet to store
+ * @param[in] expire_ts Expiry time of the content store entry
+ *
+ * @return int 0 if successful, -1 otherwise
+ */
+int cs_disk_store(cs_disk_t *disk, const msgbuf_t *msgbuf, Ticks expire_ts);
+
+/**
+ * @brief Look up a data packet on disk, and reload it into a msgbuf taken
+ * from the pool. The packet stays on disk until cs_disk_remove() is called,
+ * once it has been accepted by the in-memory content store.
+ *
+ * Expired packets are dropped and reported as a miss.
+ *
+ * @param[in] disk Pointer to the disk tier to use
+ * @param[in] name Name of the data packet
+ * @param[in] msgbuf_pool Pointer to the msgbuf pool data structure to use
+ * @param[out] expire_ts Expiry time of the packet found
+ *
+ * @return off_t ID of the msgbuf holding the packet, or INVALID_MSGBUF_ID
+ */
+off_t cs_disk_load(cs_disk_t *disk, const hicn_name_t *name,
+                   msgbuf_pool_t *msgbuf_pool, Ticks *expire_ts);
+
+/**
+ * @brief Remove a data packet from disk, after it has been moved back to the
+ * in-memory content store (promotion).
+ *
+ * @param[in] disk Pointer to the disk tier to use
+ * @param[in] name Name of the data packet
+ */
+void cs_disk_remove(cs_disk_t *disk, const hicn_name_t *name);
+
+/**
+ * @brief Return the number of packets stored on disk.
+ *
+ * @param[in] disk Pointer to the disk tier to use
+ */
+size_t cs_disk_get_num_entries(const cs_disk_t *disk);
+
+cs_disk_stats_t cs_disk_get_stats(const cs_disk_t *disk);
+
+#endif /* HICNLIGHT_CS_DISK_H */
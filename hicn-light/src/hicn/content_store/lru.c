@@ -25,10 +25,11 @@
 #include <hicn/core/packet_cache.h>
 #include "lru.h"
 
-void cs_lru_initialize(cs_t *cs) {
+int cs_lru_initialize(cs_t *cs) {
   /* We start with an empty double-linked list */
   cs->lru.head = INVALID_ENTRY_ID;
   cs->lru.tail = INVALID_ENTRY_ID;
+  return 0;
 }
 
 void cs_lru_finalize(cs_t *cs) {
@@ -41,38 +42,70 @@ cs_entry_t *_cs_entry_at(pkt_cache_t *pkt_cache, off_t entry_id) {
   return &entry->u.cs_entry;
 }
 
-/**
- * Remove a cs_entry_t from all tables and indices.
- */
-static int cs_lru_remove_entry(pkt_cache_t *pkt_cache,
-                               pkt_cache_entry_t *entry) {
-  assert(pkt_cache);
+void cs_list_push(pkt_cache_t *pkt_cache, cs_lru_state_t *list,
+                  off_t entry_id) {
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
   assert(entry);
 
-  off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
-  cs_t *cs = pkt_cache_get_cs(pkt_cache);
-  cs_entry_t *cs_entry = &entry->u.cs_entry;
+  if (list->head != INVALID_ENTRY_ID) {
+    cs_entry_t *head_entry = _cs_entry_at(pkt_cache, list->head);
+    assert(head_entry->lru.prev == INVALID_ENTRY_ID);
+    head_entry->lru.prev = entry_id;
+
+    entry->lru.next = list->head;
+    entry->lru.prev = INVALID_ENTRY_ID;
+
+    list->head = entry_id;
+  } else { /* The list is empty */
+    assert(list->tail == INVALID_ENTRY_ID);
+
+    entry->lru.next = INVALID_ENTRY_ID;
+    entry->lru.prev = INVALID_ENTRY_ID;
+    list->head = list->tail = entry_id;
+  }
+}
+
+void cs_list_remove(pkt_cache_t *pkt_cache, cs_lru_state_t *list,
+                    off_t entry_id) {
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+  assert(entry);
 
   // If node to be deleted is head node
-  if (cs->lru.head == entry_id) cs->lru.head = cs_entry->lru.next;
+  if (list->head == entry_id) list->head = entry->lru.next;
 
   // If node to be deleted is tail node
-  if (cs->lru.tail == entry_id) cs->lru.tail = cs_entry->lru.prev;
+  if (list->tail == entry_id) list->tail = entry->lru.prev;
 
   // If node to be deleted is not the last node
-  if (cs_entry->lru.next != INVALID_ENTRY_ID) {
-    cs_entry_t *next_cs_entry = _cs_entry_at(pkt_cache, cs_entry->lru.next);
-    assert(next_cs_entry);
-    next_cs_entry->lru.prev = cs_entry->lru.prev;
+  if (entry->lru.next != INVALID_ENTRY_ID) {
+    cs_entry_t *next_entry = _cs_entry_at(pkt_cache, entry->lru.next);
+    assert(next_entry);
+    next_entry->lru.prev = entry->lru.prev;
   }
 
   // If node to be deleted is not the first node
-  if (cs_entry->lru.prev != INVALID_ENTRY_ID) {
-    cs_entry_t *prev_entry = _cs_entry_at(pkt_cache, cs_entry->lru.prev);
+  if (entry->lru.prev != INVALID_ENTRY_ID) {
+    cs_entry_t *prev_entry = _cs_entry_at(pkt_cache, entry->lru.prev);
     assert(prev_entry);
-    prev_entry->lru.next = cs_entry->lru.next;
+    prev_entry->lru.next = entry->lru.next;
   }
 
+  entry->lru.prev = INVALID_ENTRY_ID;
+  entry->lru.next = INVALID_ENTRY_ID;
+}
+
+/**
+ * Remove a cs_entry_t from all tables and indices.
+ */
+static int cs_lru_remove_entry(pkt_cache_t *pkt_cache,
+                               pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_list_remove(pkt_cache, &cs->lru, entry_id);
+
   cs->stats.lru.countLruDeletions++;
   return LRU_SUCCESS;
 }
@@ -94,26 +127,9 @@ int _cs_lru_add_entry(pkt_cache_t *pkt_cache, off_t entry_id, bool is_update) {
   assert(pkt_cache);
 
   cs_t *cs = pkt_cache_get_cs(pkt_cache);
-  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
-  assert(entry);
 
   // Add at the front of the LRU doubly linked list
-  if (cs->lru.head != INVALID_ENTRY_ID) {
-    cs_entry_t *head_entry = _cs_entry_at(pkt_cache, cs->lru.head);
-    assert(head_entry->lru.prev == INVALID_ENTRY_ID);
-    head_entry->lru.prev = entry_id;
-
-    entry->lru.next = cs->lru.head;
-    entry->lru.prev = INVALID_ENTRY_ID;
-
-    cs->lru.head = entry_id;
-  } else { /* The list is empty */
-    assert(cs->lru.tail == INVALID_ENTRY_ID);
-
-    entry->lru.next = INVALID_ENTRY_ID;
-    entry->lru.prev = INVALID_ENTRY_ID;
-    cs->lru.head = cs->lru.tail = entry_id;
-  }
+  cs_list_push(pkt_cache, &cs->lru, entry_id);
   if (!is_update) cs->stats.lru.countAdds++;
 
   // Handle LRU eviction
@@ -122,6 +138,7 @@ int _cs_lru_add_entry(pkt_cache_t *pkt_cache, off_t entry_id, bool is_update) {
     cs->stats.lru.countLruEvictions++;
 
     // Remove from LRU tail
+    cs->evicted = cs->lru.tail;
     pkt_cache_entry_t *tail = pkt_cache_entry_at(pkt_cache, cs->lru.tail);
     cs_lru_remove_entry(pkt_cache, tail);
     return LRU_EVICTION;
@@ -164,4 +181,23 @@ static void cs_lru_update_entry(pkt_cache_t *pkt_cache,
   _cs_lru_add_entry(pkt_cache, entry_id, true);
 }
 
+/**
+ * Move a cs_entry_t serving an interest to the LRU head.
+ */
+static void cs_lru_hit_entry(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
+  if (cs->lru.head == entry_id) return;
+
+  cs_list_remove(pkt_cache, &cs->lru, entry_id);
+  cs_list_push(pkt_cache, &cs->lru, entry_id);
+}
+
+static void cs_lru_miss(pkt_cache_t *pkt_cache, const hicn_name_t *name) {
+  // Nothing to do
+}
+
 DECLARE_CS(lru);
@@ -0,0 +1,215 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file s3fifo.c
+ * \brief Implementation of the S3-FIFO content store policy
+ */
+
+#include <stdlib.h>
+
+#include <hicn/util/log.h>
+
+#include <hicn/core/packet_cache.h>
+#include "s3fifo.h"
+
+#define CS_S3FIFO_MIN_GHOST_SIZE 64
+
+#define cs_s3fifo_small_max_size(cs) \
+  ((cs)->max_size >= 10 ? (cs)->max_size / 10 : 1)
+
+/* 0 marks an empty slot of the ghost table */
+#define cs_s3fifo_ghost_key(hash) ((hash) ? (hash) : 1)
+
+static uint32_t cs_s3fifo_entry_hash(pkt_cache_t *pkt_cache, off_t entry_id) {
+  return hicn_name_get_hash(&pkt_cache_entry_at(pkt_cache, entry_id)->name);
+}
+
+static void cs_s3fifo_ghost_add(cs_s3fifo_state_t *state, uint32_t hash) {
+  uint32_t key = cs_s3fifo_ghost_key(hash);
+  state->ghost[key & state->ghost_mask] = key;
+}
+
+/**
+ * Look up a name hash in the ghost table, and remove it if found.
+ */
+static bool cs_s3fifo_ghost_take(cs_s3fifo_state_t *state, uint32_t hash) {
+  uint32_t key = cs_s3fifo_ghost_key(hash);
+  uint32_t *slot = &state->ghost[key & state->ghost_mask];
+  if (*slot != key) return false;
+
+  *slot = 0;
+  return true;
+}
+
+static void cs_s3fifo_push(pkt_cache_t *pkt_cache, off_t entry_id,
+                           cs_s3fifo_queue_t queue) {
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_s3fifo_state_t *state = &cs->policy.s3fifo;
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+
+  entry->queue = queue;
+  if (queue == CS_S3FIFO_QUEUE_SMALL) {
+    cs_list_push(pkt_cache, &state->small, entry_id);
+    state->small_size++;
+  } else {
+    cs_list_push(pkt_cache, &cs->lru, entry_id);
+    state->main_size++;
+  }
+}
+
+static void cs_s3fifo_unlink(pkt_cache_t *pkt_cache, off_t entry_id) {
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_s3fifo_state_t *state = &cs->policy.s3fifo;
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+
+  if (entry->queue == CS_S3FIFO_QUEUE_SMALL) {
+    cs_list_remove(pkt_cache, &state->small, entry_id);
+    state->small_size--;
+  } else {
+    cs_list_remove(pkt_cache, &cs->lru, entry_id);
+    state->main_size--;
+  }
+}
+
+static int cs_s3fifo_initialize(cs_t *cs) {
+  cs_s3fifo_state_t *state = &cs->policy.s3fifo;
+
+  cs->lru.head = INVALID_ENTRY_ID;
+  cs->lru.tail = INVALID_ENTRY_ID;
+  state->small.head = INVALID_ENTRY_ID;
+  state->small.tail = INVALID_ENTRY_ID;
+  state->small_size = 0;
+  state->main_size = 0;
+
+  /* The ghost table remembers about as many names as the main queue holds */
+  uint32_t ghost_size = CS_S3FIFO_MIN_GHOST_SIZE;
+  while (ghost_size < cs->max_size) ghost_size <<= 1;
+  state->ghost = calloc(ghost_size, sizeof(uint32_t));
+  if (!state->ghost) return -1;
+  state->ghost_mask = ghost_size - 1;
+  return 0;
+}
+
+static void cs_s3fifo_finalize(cs_t *cs) { free(cs->policy.s3fifo.ghost); }
+
+/**
+ * Select and unlink the entry to evict. Entries hit in the small queue move
+ * to the main queue, and entries hit in the main queue are reinserted with a
+ * decremented frequency, so that the loop always terminates.
+ */
+static off_t cs_s3fifo_evict(pkt_cache_t *pkt_cache) {
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_s3fifo_state_t *state = &cs->policy.s3fifo;
+
+  for (;;) {
+    if (state->small_size > 0 &&
+        (state->small_size >= cs_s3fifo_small_max_size(cs) ||
+         state->main_size == 0)) {
+      off_t entry_id = state->small.tail;
+      cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+      cs_s3fifo_unlink(pkt_cache, entry_id);
+
+      if (entry->freq > 0) {
+        entry->freq = 0;
+        cs_s3fifo_push(pkt_cache, entry_id, CS_S3FIFO_QUEUE_MAIN);
+        continue;
+      }
+
+      cs_s3fifo_ghost_add(state, cs_s3fifo_entry_hash(pkt_cache, entry_id));
+      return entry_id;
+    }
+
+    off_t entry_id = cs->lru.tail;
+    cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+    cs_s3fifo_unlink(pkt_cache, entry_id);
+
+    if (entry->freq > 0) {
+      entry->freq--;
+      cs_s3fifo_push(pkt_cache, entry_id, CS_S3FIFO_QUEUE_MAIN);
+      continue;
+    }
+
+    return entry_id;
+  }
+}
+
+/**
+ * @brief Insert a new entry in the small queue, or in the main queue if it
+ * has been recently evicted from the small queue.
+ *
+ * @return int LRU_EVICTION if an entry has been evicted (cs->evicted),
+ * LRU_SUCCESS otherwise
+ */
+static int cs_s3fifo_add_entry(pkt_cache_t *pkt_cache, off_t entry_id) {
+  assert(pkt_cache);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_s3fifo_state_t *state = &cs->policy.s3fifo;
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+
+  entry->freq = 0;
+  if (cs_s3fifo_ghost_take(state, cs_s3fifo_entry_hash(pkt_cache, entry_id)))
+    cs_s3fifo_push(pkt_cache, entry_id, CS_S3FIFO_QUEUE_MAIN);
+  else
+    cs_s3fifo_push(pkt_cache, entry_id, CS_S3FIFO_QUEUE_SMALL);
+  cs->stats.lru.countAdds++;
+
+  if (cs->num_entries <= cs->max_size) return LRU_SUCCESS;
+
+  DEBUG("S3-FIFO eviction");
+  cs->stats.lru.countLruEvictions++;
+  cs->stats.lru.countLruDeletions++;
+  cs->evicted = cs_s3fifo_evict(pkt_cache);
+  return LRU_EVICTION;
+}
+
+/**
+ * Refreshed data keeps the position of the entry in its queue.
+ */
+static void cs_s3fifo_update_entry(pkt_cache_t *pkt_cache,
+                                   pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs->stats.lru.countUpdates++;
+}
+
+static int cs_s3fifo_remove_entry(pkt_cache_t *pkt_cache,
+                                  pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_s3fifo_unlink(pkt_cache, pkt_cache_get_entry_id(pkt_cache, entry));
+
+  cs->stats.lru.countLruDeletions++;
+  return LRU_SUCCESS;
+}
+
+static void cs_s3fifo_hit_entry(pkt_cache_t *pkt_cache,
+                                pkt_cache_entry_t *entry) {
+  assert(entry);
+
+  cs_entry_t *cs_entry = &entry->u.cs_entry;
+  if (cs_entry->freq < CS_S3FIFO_MAX_FREQ) cs_entry->freq++;
+}
+
+static void cs_s3fifo_miss(pkt_cache_t *pkt_cache, const hicn_name_t *name) {
+  // Nothing to do
+}
+
+DECLARE_CS(s3fifo);
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file s3fifo.h
+ * \brief S3-FIFO content store policy
+ *
+ * Entries are inserted in a small FIFO queue (10% of the content store).
+ * Those hit while in the small queue are moved to the main FIFO queue when
+ * they reach its tail, the others are evicted and their name is remembered
+ * in a ghost table. An entry whose name is found in the ghost table goes
+ * directly to the main queue. Entries of the main queue are reinserted at its
+ * head as long as they have been hit since they were last examined.
+ *
+ * Hits only update a 2-bit counter in the entry, and never move it.
+ */
+
+#ifndef HICNLIGHT_CS_S3FIFO_H
+#define HICNLIGHT_CS_S3FIFO_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lru.h"
+
+#define CS_S3FIFO_MAX_FREQ 3
+
+typedef enum {
+  CS_S3FIFO_QUEUE_SMALL,
+  CS_S3FIFO_QUEUE_MAIN,
+} cs_s3fifo_queue_t;
+
+typedef struct {
+  /* Small queue (the main queue is the LRU list of the content store) */
+  cs_lru_state_t small;
+  size_t small_size;
+  size_t main_size;
+
+  /*
+   * Ghost table: name hashes of the entries recently evicted from the small
+   * queue, in a direct-mapped table where a new hash overrides an older one.
+   */
+  uint32_t *ghost;
+  uint32_t ghost_mask;
+} cs_s3fifo_state_t;
+
+#endif /* HICNLIGHT_CS_S3FIFO_H */
@@ -0,0 +1,312 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file tinylfu.c
+ * \brief Implementation of the W-TinyLFU content store policy
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <hicn/util/log.h>
+
+#include <hicn/core/packet_cache.h>
+#include "tinylfu.h"
+
+/* Smallest sketch width, so that tiny content stores still get a history */
+#define CS_TINYLFU_MIN_WIDTH 64
+
+/* The doorkeeper has 4 bits per sketch column */
+#define cs_tinylfu_doorkeeper_bits(state) (4 * (state)->width)
+
+#define cs_tinylfu_window_max_size(cs) \
+  ((cs)->max_size >= 100 ? (cs)->max_size / 100 : 1)
+
+static const uint32_t cs_tinylfu_seeds[CS_TINYLFU_DEPTH] = {
+    0x97cb3127, 0xab7ed4e1, 0x5f3ae2d1, 0x8f14c0e3};
+
+static uint32_t cs_tinylfu_width(size_t max_size) {
+  uint32_t width = CS_TINYLFU_MIN_WIDTH;
+  while (width < max_size) width <<= 1;
+  return width;
+}
+
+/*------------------------------------------------------------------------*/
+/* Frequency sketch */
+
+static inline uint32_t cs_tinylfu_index(const cs_tinylfu_state_t *state,
+                                        uint32_t hash, unsigned row) {
+  uint32_t h = (hash + row) * cs_tinylfu_seeds[row];
+  h ^= h >> 16;
+  return row * state->width + (h & (state->width - 1));
+}
+
+static inline unsigned cs_tinylfu_counter_get(const cs_tinylfu_state_t *state,
+                                              uint32_t index) {
+  return (state->sketch[index / 2] >> ((index & 1) * 4)) & 0xf;
+}
+
+static inline void cs_tinylfu_counter_inc(cs_tinylfu_state_t *state,
+                                          uint32_t index) {
+  state->sketch[index / 2] += 1 << ((index & 1) * 4);
+}
+
+/* Two bits of the doorkeeper (bloom filter) are checked for each hash */
+static inline uint32_t cs_tinylfu_doorkeeper_bit(
+    const cs_tinylfu_state_t *state, uint32_t hash, unsigned i) {
+  uint32_t h = hash * cs_tinylfu_seeds[CS_TINYLFU_DEPTH - 1 - i];
+  h ^= h >> 15;
+  return h & (cs_tinylfu_doorkeeper_bits(state) - 1);
+}
+
+static bool cs_tinylfu_doorkeeper_contains(const cs_tinylfu_state_t *state,
+                                           uint32_t hash) {
+  for (unsigned i = 0; i < 2; i++) {
+    uint32_t bit = cs_tinylfu_doorkeeper_bit(state, hash, i);
+    if (!(state->doorkeeper[bit / 64] & (1ull << (bit % 64)))) return false;
+  }
+  return true;
+}
+
+static void cs_tinylfu_doorkeeper_add(cs_tinylfu_state_t *state,
+                                      uint32_t hash) {
+  for (unsigned i = 0; i < 2; i++) {
+    uint32_t bit = cs_tinylfu_doorkeeper_bit(state, hash, i);
+    state->doorkeeper[bit / 64] |= 1ull << (bit % 64);
+  }
+}
+
+/**
+ * Halve all counters and clear the doorkeeper, so that old requests weigh
+ * less than recent ones.
+ */
+static void cs_tinylfu_age(cs_tinylfu_state_t *state) {
+  size_t sketch_size = CS_TINYLFU_DEPTH * state->width / 2;
+  for (size_t i = 0; i < sketch_size; i++)
+    state->sketch[i] = (state->sketch[i] >> 1) & 0x77;
+
+  memset(state->doorkeeper, 0, cs_tinylfu_doorkeeper_bits(state) / 8);
+  state->n_increments /= 2;
+}
+
+static unsigned cs_tinylfu_estimate(const cs_tinylfu_state_t *state,
+                                    uint32_t hash) {
+  unsigned min = 0xf;
+  for (unsigned row = 0; row < CS_TINYLFU_DEPTH; row++) {
+    unsigned count =
+        cs_tinylfu_counter_get(state, cs_tinylfu_index(state, hash, row));
+    if (count < min) min = count;
+  }
+  return min + (cs_tinylfu_doorkeeper_contains(state, hash) ? 1 : 0);
+}
+
+/**
+ * Record a request: the first one only goes to the doorkeeper, the next ones
+ * increment the smallest counters of the sketch (conservative update).
+ */
+static void cs_tinylfu_record(cs_tinylfu_state_t *state, uint32_t hash) {
+  if (!cs_tinylfu_doorkeeper_contains(state, hash)) {
+    cs_tinylfu_doorkeeper_add(state, hash);
+    return;
+  }
+
+  uint32_t indices[CS_TINYLFU_DEPTH];
+  unsigned min = 0xf;
+  for (unsigned row = 0; row < CS_TINYLFU_DEPTH; row++) {
+    indices[row] = cs_tinylfu_index(state, hash, row);
+    unsigned count = cs_tinylfu_counter_get(state, indices[row]);
+    if (count < min) min = count;
+  }
+  if (min == 0xf) return;
+
+  for (unsigned row = 0; row < CS_TINYLFU_DEPTH; row++)
+    if (cs_tinylfu_counter_get(state, indices[row]) == min)
+      cs_tinylfu_counter_inc(state, indices[row]);
+
+  if (++state->n_increments >= CS_TINYLFU_SAMPLE_FACTOR * state->width)
+    cs_tinylfu_age(state);
+}
+
+static uint32_t cs_tinylfu_entry_hash(pkt_cache_t *pkt_cache,
+                                      off_t entry_id) {
+  return hicn_name_get_hash(&pkt_cache_entry_at(pkt_cache, entry_id)->name);
+}
+
+/*------------------------------------------------------------------------*/
+/* Lists */
+
+static cs_lru_state_t *cs_tinylfu_list(cs_t *cs, const cs_entry_t *entry) {
+  return entry->queue == CS_TINYLFU_QUEUE_WINDOW ? &cs->policy.tinylfu.window
+                                                 : &cs->lru;
+}
+
+static void cs_tinylfu_unlink(pkt_cache_t *pkt_cache, off_t entry_id) {
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+
+  cs_list_remove(pkt_cache, cs_tinylfu_list(cs, entry), entry_id);
+  if (entry->queue == CS_TINYLFU_QUEUE_WINDOW)
+    cs->policy.tinylfu.window_size--;
+}
+
+static int cs_tinylfu_initialize(cs_t *cs) {
+  cs_tinylfu_state_t *state = &cs->policy.tinylfu;
+
+  cs->lru.head = INVALID_ENTRY_ID;
+  cs->lru.tail = INVALID_ENTRY_ID;
+  state->window.head = INVALID_ENTRY_ID;
+  state->window.tail = INVALID_ENTRY_ID;
+  state->window_size = 0;
+
+  state->width = cs_tinylfu_width(cs->max_size);
+  state->sketch = calloc(CS_TINYLFU_DEPTH * state->width / 2, 1);
+  state->doorkeeper = calloc(cs_tinylfu_doorkeeper_bits(state) / 64,
+                             sizeof(uint64_t));
+  if (!state->sketch || !state->doorkeeper) {
+    free(state->sketch);
+    free(state->doorkeeper);
+    return -1;
+  }
+  state->n_increments = 0;
+  return 0;
+}
+
+static void cs_tinylfu_finalize(cs_t *cs) {
+  free(cs->policy.tinylfu.sketch);
+  free(cs->policy.tinylfu.doorkeeper);
+}
+
+/**
+ * @brief Insert a new entry in the admission window. When the window is full,
+ * its LRU entry competes with the LRU entry of the main list, and the one
+ * with the lowest estimated frequency is evicted if the content store is
+ * full.
+ *
+ * @return int LRU_EVICTION if an entry has been evicted (cs->evicted),
+ * LRU_SUCCESS otherwise
+ */
+static int cs_tinylfu_add_entry(pkt_cache_t *pkt_cache, off_t entry_id) {
+  assert(pkt_cache);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_tinylfu_state_t *state = &cs->policy.tinylfu;
+  cs_entry_t *entry = _cs_entry_at(pkt_cache, entry_id);
+
+  entry->queue = CS_TINYLFU_QUEUE_WINDOW;
+  cs_list_push(pkt_cache, &state->window, entry_id);
+  state->window_size++;
+  cs->stats.lru.countAdds++;
+
+  bool is_full = cs->num_entries > cs->max_size;
+  off_t victim_id;
+
+  if (state->window_size <= cs_tinylfu_window_max_size(cs)) {
+    if (!is_full) return LRU_SUCCESS;
+
+    // The window is not full, evict from the main list if possible
+    victim_id =
+        cs->lru.tail != INVALID_ENTRY_ID ? cs->lru.tail : state->window.tail;
+    cs_tinylfu_unlink(pkt_cache, victim_id);
+    goto EVICTION;
+  }
+
+  // Move the candidate out of the window
+  off_t candidate_id = state->window.tail;
+  cs_tinylfu_unlink(pkt_cache, candidate_id);
+  cs_entry_t *candidate = _cs_entry_at(pkt_cache, candidate_id);
+
+  victim_id = cs->lru.tail;
+  if (is_full) {
+    // Ties favor the entry already in the main list
+    if (victim_id == INVALID_ENTRY_ID ||
+        cs_tinylfu_estimate(state,
+                            cs_tinylfu_entry_hash(pkt_cache, candidate_id)) <=
+            cs_tinylfu_estimate(state,
+                                cs_tinylfu_entry_hash(pkt_cache, victim_id))) {
+      victim_id = candidate_id;
+      goto EVICTION;
+    }
+
+    cs_tinylfu_unlink(pkt_cache, victim_id);
+  }
+
+  candidate->queue = CS_TINYLFU_QUEUE_MAIN;
+  cs_list_push(pkt_cache, &cs->lru, candidate_id);
+
+  if (!is_full) return LRU_SUCCESS;
+
+EVICTION:
+  DEBUG("TinyLFU eviction");
+  cs->stats.lru.countLruEvictions++;
+  cs->stats.lru.countLruDeletions++;
+  cs->evicted = victim_id;
+  return LRU_EVICTION;
+}
+
+/**
+ * Move a cs_entry_t to the head of its list.
+ */
+static void cs_tinylfu_update_entry(pkt_cache_t *pkt_cache,
+                                    pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs->stats.lru.countUpdates++;
+
+  off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
+  cs_lru_state_t *list = cs_tinylfu_list(cs, &entry->u.cs_entry);
+  cs_list_remove(pkt_cache, list, entry_id);
+  cs_list_push(pkt_cache, list, entry_id);
+}
+
+static int cs_tinylfu_remove_entry(pkt_cache_t *pkt_cache,
+                                   pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_tinylfu_unlink(pkt_cache, pkt_cache_get_entry_id(pkt_cache, entry));
+
+  cs->stats.lru.countLruDeletions++;
+  return LRU_SUCCESS;
+}
+
+static void cs_tinylfu_hit_entry(pkt_cache_t *pkt_cache,
+                                 pkt_cache_entry_t *entry) {
+  assert(pkt_cache);
+  assert(entry);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_tinylfu_record(&cs->policy.tinylfu, hicn_name_get_hash(&entry->name));
+
+  off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
+  cs_lru_state_t *list = cs_tinylfu_list(cs, &entry->u.cs_entry);
+  if (list->head == entry_id) return;
+
+  cs_list_remove(pkt_cache, list, entry_id);
+  cs_list_push(pkt_cache, list, entry_id);
+}
+
+static void cs_tinylfu_miss(pkt_cache_t *pkt_cache, const hicn_name_t *name) {
+  assert(pkt_cache);
+  assert(name);
+
+  cs_t *cs = pkt_cache_get_cs(pkt_cache);
+  cs_tinylfu_record(&cs->policy.tinylfu, hicn_name_get_hash(name));
+}
+
+DECLARE_CS(tinylfu);
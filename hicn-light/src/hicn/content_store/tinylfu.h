@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file tinylfu.h
+ * \brief W-TinyLFU content store policy
+ *
+ * New entries are inserted in a small LRU admission window (1% of the
+ * content store). Entries leaving the window are only admitted in the main
+ * LRU list if they have been requested more often than the entry they would
+ * replace. Request frequencies are estimated with a count-min sketch of 4-bit
+ * counters, preceded by a doorkeeper bitmap filtering out one-hit wonders, and
+ * halved periodically so that the history ages.
+ *
+ * A sequential scan thus only goes through the window and leaves the popular
+ * content in the main list untouched.
+ */
+
+#ifndef HICNLIGHT_CS_TINYLFU_H
+#define HICNLIGHT_CS_TINYLFU_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "lru.h"
+
+#define CS_TINYLFU_DEPTH 4
+
+/* The frequency history is halved after 10 x width increments */
+#define CS_TINYLFU_SAMPLE_FACTOR 10
+
+typedef enum {
+  CS_TINYLFU_QUEUE_WINDOW,
+  CS_TINYLFU_QUEUE_MAIN,
+} cs_tinylfu_queue_t;
+
+typedef struct {
+  /* Admission window (the main list is the LRU list of the content store) */
+  cs_lru_state_t window;
+  size_t window_size;
+
+  /* Count-min sketch, CS_TINYLFU_DEPTH rows of 'width' 4-bit counters */
+  uint8_t *sketch;
+  uint64_t *doorkeeper;
+  uint32_t width;
+  uint32_t n_increments;
+} cs_tinylfu_state_t;
+
+#endif /* HICNLIGHT_CS_TINYLFU_H */
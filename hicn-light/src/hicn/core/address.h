@@ -46,6 +46,11 @@ typedef union {
 #define address6_ip(address) (address6(address)->sin6_addr)
 #define address6_scope_id(address) (address4_ptr(address)->sin6_scope_id)
 
+#define address_port(address)                               \
+  ntohs(((address)->as_ss.ss_family == AF_INET)             \
+            ? address4(address)->sin_port                   \
+            : address6(address)->sin6_port)
+
 #define address_socklen(address)                                        \
   (((address)->as_ss.ss_family == AF_INET) ? sizeof(struct sockaddr_in) \
                                            : sizeof(struct sockaddr_in6))
@@ -28,6 +28,7 @@
 
 #include "connection.h"
 #include "connection_vft.h"
+#include "../io/uring.h"
 
 // This is called by configuration
 connection_t *connection_create(face_type_t type, const char *name,
@@ -46,11 +47,15 @@ connection_t *connection_create(face_type_t type, const char *name,
     case FACE_TYPE_TCP:
       listener_type = FACE_TYPE_TCP_LISTENER;
       break;
+    case FACE_TYPE_MEMIF:
+      listener_type = FACE_TYPE_MEMIF_LISTENER;
+      break;
     case FACE_TYPE_HICN:
       return NULL; /* Not implemented */
     case FACE_TYPE_HICN_LISTENER:
     case FACE_TYPE_UDP_LISTENER:
     case FACE_TYPE_TCP_LISTENER:
+    case FACE_TYPE_MEMIF_LISTENER:
     case FACE_TYPE_UNDEFINED:
     case FACE_TYPE_N:
       return NULL;
@@ -198,7 +203,10 @@ int connection_initialize(connection_t *connection, face_type_t type,
     goto ERR_VFT;
   }
 
-  if (connection->connected) {
+  /* Out of io_uring receive slots, the socket is read by the event loop */
+  uring_t *uring = listener_get_uring(listener);
+  if (connection->connected &&
+      !(uring && uring_listen(uring, fd, listener, connection->id) == 0)) {
     /*
      * The file descriptor is created by the listener. We assume for now that
      * all connections get their own fd, and we have to register it.
@@ -240,8 +248,12 @@ int connection_finalize(connection_t *connection) {
   assert(connection_has_valid_type(connection));
 
   if (connection->connected) {
-    loop_event_unregister(connection->event_data);
-    loop_event_free(connection->event_data);
+    uring_t *uring = listener_get_uring(connection->listener);
+    if (uring) uring_unlisten(uring, connection->fd);
+    if (connection->event_data) {
+      loop_event_unregister(connection->event_data);
+      loop_event_free(connection->event_data);
+    }
   }
 
   if (connection->fd != 0) {  // Only if connected socket
@@ -294,9 +306,17 @@ bool connection_send(connection_t *connection, off_t msgbuf_id, bool queue) {
 
   const listener_t *listener = connection_get_listener(connection);
   const forwarder_t *forwarder = listener_get_forwarder(listener);
-  const msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
   msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
 
+  /*
+   * Header-only msgbufs are only sent without being copied from the queue of
+   * UDP connections, which uses scatter-gather I/O.
+   */
+  if (msgbuf_is_shared(msgbuf) &&
+      !(queue && connection->type == FACE_TYPE_UDP))
+    msgbuf_pool_linearize(msgbuf_pool, msgbuf);
+
 #if 0
   if (connection->wldr)
     wldr_set_label(connection->wldr, msgbuf);
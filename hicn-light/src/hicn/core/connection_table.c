@@ -18,8 +18,11 @@
  * \brief Implementation of hICN connection table
  */
 
+#include <pthread.h>
+
 #include <hicn/util/log.h>
 #include <hicn/util/sstrncpy.h>
+#include <hicn/util/vector.h>
 
 #include "connection.h"
 #include "connection_table.h"
@@ -32,6 +35,163 @@ typedef struct {
   char name[SYMBOLIC_NAME_LEN];
 } name_key_t;
 
+/*----------------------------------------------------------------------------*
+ * Connection registry
+ *----------------------------------------------------------------------------*/
+
+#define DEFAULT_CONNECTION_REGISTRY_SIZE 64
+
+/*
+ * Entries are indexed by connection id. An entry is in use as long as at least
+ * one table holds the corresponding connection. Lookups are linear, which is
+ * fine as the registry is only accessed upon connection setup and teardown,
+ * never in the forwarding path.
+ */
+typedef struct {
+  address_pair_t pair;
+  char name[SYMBOLIC_NAME_LEN];
+  unsigned refs;  // number of tables holding the connection
+} connection_registry_entry_t;
+
+struct connection_registry_s {
+  pthread_mutex_t lock;
+  connection_registry_entry_t *entries;  // vector
+};
+
+connection_registry_t *connection_registry_create() {
+  connection_registry_t *registry = malloc(sizeof(connection_registry_t));
+  if (!registry) goto ERR_MALLOC;
+  if (vector_init(registry->entries, DEFAULT_CONNECTION_REGISTRY_SIZE, 0) < 0)
+    goto ERR_VECTOR;
+  pthread_mutex_init(&registry->lock, NULL);
+  return registry;
+
+ERR_VECTOR:
+  free(registry);
+ERR_MALLOC:
+  return NULL;
+}
+
+void connection_registry_free(connection_registry_t *registry) {
+  pthread_mutex_destroy(&registry->lock);
+  vector_free(registry->entries);
+  free(registry);
+}
+
+/* Lock must be held by the caller */
+static off_t _connection_registry_find(connection_registry_t *registry,
+                                       const address_pair_t *pair,
+                                       const char *name) {
+  for (off_t id = 0; id < vector_len(registry->entries); id++) {
+    connection_registry_entry_t *entry = &registry->entries[id];
+    if (entry->refs == 0) continue;
+    if (pair && address_pair_equals(&entry->pair, pair)) return id;
+    if (name && strcmp(entry->name, name) == 0) return id;
+  }
+  return -1;
+}
+
+/* Lock must be held by the caller */
+static off_t _connection_registry_set(connection_registry_t *registry,
+                                      off_t id, const address_pair_t *pair,
+                                      const char *name) {
+  int rc = vector_ensure_pos(registry->entries, id);
+  if (rc < 0) return -1;
+  while (vector_len(registry->entries) <= id) {
+    registry->entries[vector_len(registry->entries)].refs = 0;
+    vector_len(registry->entries)++;
+  }
+  connection_registry_entry_t *entry = &registry->entries[id];
+  entry->pair = *pair;
+  strcpy_s(entry->name, SYMBOLIC_NAME_LEN, name);
+  entry->refs = 1;
+  return id;
+}
+
+/**
+ * Returns the id associated to the pair in the registry, registering it under
+ * the given name if needed. The name effectively associated to the pair is
+ * copied into registered_name (of size SYMBOLIC_NAME_LEN).
+ */
+static off_t connection_registry_acquire(connection_registry_t *registry,
+                                         const address_pair_t *pair,
+                                         const char *name,
+                                         char *registered_name) {
+  off_t id;
+  pthread_mutex_lock(&registry->lock);
+
+  id = _connection_registry_find(registry, pair, NULL);
+  if (id >= 0) {
+    connection_registry_entry_t *entry = &registry->entries[id];
+    entry->refs++;
+    goto END;
+  }
+
+  if (_connection_registry_find(registry, NULL, name) >= 0) {
+    ERROR("Connection name %s already in use for another address pair", name);
+    goto ERR;
+  }
+
+  for (id = 0; id < vector_len(registry->entries); id++)
+    if (registry->entries[id].refs == 0) break;
+  if (_connection_registry_set(registry, id, pair, name) < 0) goto ERR;
+
+END:
+  strcpy_s(registered_name, SYMBOLIC_NAME_LEN, registry->entries[id].name);
+  pthread_mutex_unlock(&registry->lock);
+  return id;
+
+ERR:
+  pthread_mutex_unlock(&registry->lock);
+  return -1;
+}
+
+/* Registers an existing connection under its current id */
+static int connection_registry_acquire_at(connection_registry_t *registry,
+                                          off_t id, const address_pair_t *pair,
+                                          const char *name) {
+  int rc = -1;
+  pthread_mutex_lock(&registry->lock);
+
+  if (id < vector_len(registry->entries) && registry->entries[id].refs > 0) {
+    connection_registry_entry_t *entry = &registry->entries[id];
+    if (!address_pair_equals(&entry->pair, pair) ||
+        strcmp(entry->name, name) != 0)
+      goto END;
+    entry->refs++;
+    rc = 0;
+    goto END;
+  }
+  if (_connection_registry_find(registry, pair, name) >= 0) goto END;
+  if (_connection_registry_set(registry, id, pair, name) < 0) goto END;
+  rc = 0;
+
+END:
+  pthread_mutex_unlock(&registry->lock);
+  return rc;
+}
+
+static void connection_registry_release(connection_registry_t *registry,
+                                        off_t id) {
+  pthread_mutex_lock(&registry->lock);
+  assert(id < vector_len(registry->entries));
+  assert(registry->entries[id].refs > 0);
+  registry->entries[id].refs--;
+  pthread_mutex_unlock(&registry->lock);
+}
+
+static bool connection_registry_has_name(connection_registry_t *registry,
+                                         const char *name) {
+  pthread_mutex_lock(&registry->lock);
+  bool found = _connection_registry_find(registry, NULL, name) >= 0;
+  pthread_mutex_unlock(&registry->lock);
+  return found;
+}
+
+/*----------------------------------------------------------------------------*
+ * Connection table
+ *----------------------------------------------------------------------------*/
+
 connection_table_t *_connection_table_create(size_t init_size,
                                              size_t max_size) {
   if (init_size == 0) init_size = DEFAULT_CONNECTION_TABLE_SIZE;
@@ -40,6 +200,7 @@ connection_table_t *_connection_table_create(size_t init_size,
   if (!table) return NULL;
 
   table->max_size = max_size;
+  table->registry = NULL;
 
   /* Initialize indices */
   table->id_by_pair = kh_init_ct_pair();
@@ -64,6 +225,8 @@ void connection_table_free(connection_table_t *table) {
 
     INFO("Removing connection %s [%d]", name, connection->fd);
     connection_finalize(connection);
+    if (table->registry)
+      connection_registry_release(table->registry, (off_t)conn_id);
   });
 
   kh_destroy_ct_pair(table->id_by_pair);
@@ -75,12 +238,11 @@ void connection_table_free(connection_table_t *table) {
   free(table);
 }
 
-connection_t *connection_table_allocate(const connection_table_t *table,
-                                        const address_pair_t *pair,
-                                        const char *name) {
+connection_t *_connection_table_allocate(const connection_table_t *table,
+                                         const address_pair_t *pair,
+                                         const char *name,
+                                         const char **allocated_name) {
   connection_t *conn = NULL;
-  pool_get(table->connections, conn);
-  if (!conn) return NULL;
 
 #ifdef __APPLE__
   // set __uint8_t sin_len to 0
@@ -90,12 +252,29 @@ connection_t *connection_table_allocate(const connection_table_t *table,
   *ptr = 0x0;
 #endif /* __APPLE__ */
 
+  char registered_name[SYMBOLIC_NAME_LEN];
+  if (table->registry) {
+    off_t id = connection_registry_acquire(table->registry, pair, name,
+                                           registered_name);
+    if (id < 0) return NULL;
+    if (pool_get_at(table->connections, id, conn) < 0) {
+      ERROR("Connection id %ld already in use locally", id);
+      connection_registry_release(table->registry, id);
+      return NULL;
+    }
+    name = registered_name;
+  } else {
+    pool_get(table->connections, conn);
+  }
+  if (!conn) return NULL;
+
   off_t id = conn - table->connections;
   int rc;
 
   // Add in name hash table
   name_key_t *name_copy = slab_get(name_key_t, table->name_keys);
   strcpy_s(name_copy->name, sizeof(name_key_t), name);
+  if (allocated_name) *allocated_name = name_copy->name;
 
   khiter_t k = kh_put_ct_name(table->id_by_name, name_copy->name, &rc);
   assert(rc == KH_ADDED || rc == KH_RESET);
@@ -113,6 +292,12 @@ connection_t *connection_table_allocate(const connection_table_t *table,
   return conn;
 }
 
+connection_t *connection_table_allocate(const connection_table_t *table,
+                                        const address_pair_t *pair,
+                                        const char *name) {
+  return _connection_table_allocate(table, pair, name, NULL);
+}
+
 void connection_table_deallocate(const connection_table_t *table,
                                  const connection_t *conn) {
   const char *name = connection_get_name(conn);
@@ -139,6 +324,9 @@ void connection_table_deallocate(const connection_table_t *table,
   slab_put(table->pair_keys, kh_key(table->id_by_pair, k));
 
   assert(kh_size(table->id_by_name) == kh_size(table->id_by_pair));
+  if (table->registry)
+    connection_registry_release(table->registry,
+                                connection_table_get_connection_id(table, conn));
   pool_put(table->connections, conn);
 }
 
@@ -228,7 +416,10 @@ int connection_table_get_random_name(const connection_table_t *table,
 
     // Check if generated connection name is a duplicate
     khiter_t k = kh_get_ct_name(table->id_by_name, name);
-    if (k == kh_end(table->id_by_name)) break;
+    if (k != kh_end(table->id_by_name)) continue;
+    if (table->registry && connection_registry_has_name(table->registry, name))
+      continue;
+    break;
   }
 
   if (i == n_attempts) {
@@ -238,3 +429,40 @@ int connection_table_get_random_name(const connection_table_t *table,
 
   return 0;
 }
+
+int connection_table_set_registry(connection_table_t *table,
+                                  connection_registry_t *registry) {
+  const char *name;
+  unsigned conn_id;
+
+  if (table->registry) {
+    kh_foreach_value(table->id_by_name, conn_id, {
+      connection_registry_release(table->registry, (off_t)conn_id);
+    });
+    table->registry = NULL;
+  }
+  if (!registry) return 0;
+
+  unsigned n_registered = 0;
+  kh_foreach(table->id_by_name, name, conn_id, {
+    connection_t *connection = connection_table_at(table, conn_id);
+    if (connection_registry_acquire_at(registry, (off_t)conn_id,
+                                       connection_get_pair(connection),
+                                       name) < 0) {
+      ERROR("Connection %s [%u] conflicts with registered connections", name,
+            conn_id);
+      goto ERR;
+    }
+    n_registered++;
+  });
+  table->registry = registry;
+  return 0;
+
+ERR:
+  /* Release the connections registered so far (same iteration order) */
+  kh_foreach_value(table->id_by_name, conn_id, {
+    if (n_registered-- == 0) break;
+    connection_registry_release(registry, (off_t)conn_id);
+  });
+  return -1;
+}
@@ -25,6 +25,12 @@
  *
  * For efficient index retrieval, the header will be prepended and the
  * resulting pointer will directly point to the connection pool.
+ *
+ * When several forwarders run in parallel (see worker.h), each of them has its
+ * own connection table, but connection ids and names are attributed by a
+ * connection registry shared by all tables: a given address pair is
+ * associated to the same id and name in every table, so that commands and
+ * routes referring to a connection resolve to the same face in all workers.
  */
 
 #ifndef HICNLIGHT_CONNECTION_TABLE_H
@@ -45,8 +51,11 @@ KHASH_INIT(ct_pair, const address_pair_t *, unsigned, 1, address_pair_hash,
            address_pair_equals);
 KHASH_MAP_INIT_STR(ct_name, unsigned);
 
+typedef struct connection_registry_s connection_registry_t;
+
 typedef struct {
   size_t max_size;
+  connection_registry_t *registry;  // shared id allocation (NULL if none)
 
   kh_ct_pair_t *id_by_pair;
   slab_t *pair_keys;
@@ -74,6 +83,26 @@ typedef struct {
 connection_t *connection_table_allocate(const connection_table_t *table,
                                         const address_pair_t *pair,
                                         const char *name);
+
+/**
+ * @brief Allocate a connection from the connection table, returning the name
+ * effectively associated to it.
+ *
+ * @param[in] table The connection table from which to allocate a connection.
+ * @param[in] pair The address pair associated to the connection.
+ * @param[in] name The requested name for the connection.
+ * @param[out] allocated_name If not NULL, will point to the name under which
+ * the connection has been indexed (valid until the connection is released).
+ *
+ * NOTE:
+ *  - When the table uses a connection registry and the address pair is
+ *  already known from another table, the connection is allocated with the
+ *  same id and name, and the requested name is ignored.
+ */
+connection_t *_connection_table_allocate(const connection_table_t *table,
+                                         const address_pair_t *pair,
+                                         const char *name,
+                                         const char **allocated_name);
 /**
  * @brief Deallocate a connection and return it to the connection table pool.
  *
@@ -254,4 +283,33 @@ void connection_table_print_by_name(const connection_table_t *table);
 int connection_table_get_random_name(const connection_table_t *table,
                                      char *name);
 
+/**
+ * @brief Create a connection registry, used to share connection ids and names
+ * across several connection tables.
+ *
+ * @return connection_registry_t* The newly created registry.
+ */
+connection_registry_t *connection_registry_create();
+
+/**
+ * @brief Free a connection registry.
+ *
+ * All connection tables should have been detached from the registry
+ * beforehand.
+ */
+void connection_registry_free(connection_registry_t *registry);
+
+/**
+ * @brief Attach a connection table to a connection registry (or detach it if
+ * registry is NULL).
+ *
+ * Connections already present in the table are registered under their
+ * current id and name, which must not conflict with existing registrations.
+ * Subsequent allocations in the table take their id from the registry.
+ *
+ * @return int 0 on success, -1 in case of conflict.
+ */
+int connection_table_set_registry(connection_table_t *table,
+                                  connection_registry_t *registry);
+
 #endif /* HICNLIGHT_CONNECTION_TABLE_H */
@@ -26,12 +26,18 @@ extern connection_ops_t connection_hicn;
 
 extern connection_ops_t connection_tcp;
 extern connection_ops_t connection_udp;
+#ifdef WITH_MEMIF
+extern connection_ops_t connection_memif;
+#endif
 
-const connection_ops_t *connection_vft[] = {
+const connection_ops_t *connection_vft[FACE_PROTOCOL_UNKNOWN] = {
 #ifdef __linux
     [FACE_PROTOCOL_HICN] = &connection_hicn,
 #endif
 
     [FACE_PROTOCOL_TCP] = &connection_tcp,
     [FACE_PROTOCOL_UDP] = &connection_udp,
+#ifdef WITH_MEMIF
+    [FACE_PROTOCOL_MEMIF] = &connection_memif,
+#endif
 };
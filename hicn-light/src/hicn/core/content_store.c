@@ -22,9 +22,13 @@
 #include "packet_cache.h"
 
 extern const cs_ops_t cs_lru;
+extern const cs_ops_t cs_tinylfu;
+extern const cs_ops_t cs_s3fifo;
 
 const cs_ops_t *const cs_vft[] = {
     [CS_TYPE_LRU] = &cs_lru,
+    [CS_TYPE_TINYLFU] = &cs_tinylfu,
+    [CS_TYPE_S3FIFO] = &cs_s3fifo,
 };
 
 cs_t *_cs_create(cs_type_t type, size_t max_size) {
@@ -41,7 +45,12 @@ cs_t *_cs_create(cs_type_t type, size_t max_size) {
   cs->type = type;
   cs->num_entries = 0;
   cs->max_size = max_size;
-  cs_vft[type]->initialize(cs);
+  cs->evicted = INVALID_ENTRY_ID;
+  if (cs_vft[type]->initialize(cs) < 0) {
+    ERROR("[cs_create] Could not allocate the content store policy state");
+    free(cs);
+    return NULL;
+  }
   cs->stats.lru = (cs_lru_stats_t){0};
 
   return cs;
@@ -55,12 +64,12 @@ void cs_free(cs_t *cs) {
 }
 
 void _cs_clear(cs_t **cs_ptr) {
-  cs_type_t cs_type = (*cs_ptr)->type;
-  size_t max_size = (*cs_ptr)->max_size;
+  // Recreate the CS, keeping the current one if it cannot be allocated
+  cs_t *cs = _cs_create((*cs_ptr)->type, (*cs_ptr)->max_size);
+  if (!cs) return;
 
-  // Free and recreate the CS
   cs_free(*cs_ptr);
-  *cs_ptr = _cs_create(cs_type, max_size);
+  *cs_ptr = cs;
 }
 
 void cs_hit(cs_t *cs) {
@@ -77,12 +86,17 @@ void cs_miss(cs_t *cs) {
 
 void cs_log(cs_t *cs) {
   DEBUG(
-      "Content store: size = %u, capacity = %u, hits = %u, misses = %u, adds = "
-      "%u, updates = %u, deletions = %u (with evictions = %u)",
-      cs->num_entries, cs->max_size, cs->stats.lru.countHits,
-      cs->stats.lru.countMisses, cs->stats.lru.countAdds,
-      cs->stats.lru.countUpdates, cs->stats.lru.countLruDeletions,
-      cs->stats.lru.countLruEvictions);
+      "Content store (%s): size = %u, capacity = %u, hits = %u, misses = %u, "
+      "adds = %u, updates = %u, deletions = %u (with evictions = %u)",
+      cs_type_str(cs->type), cs->num_entries, cs->max_size,
+      cs->stats.lru.countHits, cs->stats.lru.countMisses,
+      cs->stats.lru.countAdds, cs->stats.lru.countUpdates,
+      cs->stats.lru.countLruDeletions, cs->stats.lru.countLruEvictions);
 }
 
 cs_lru_stats_t cs_get_lru_stats(cs_t *cs) { return cs->stats.lru; }
+
+const char *cs_type_str(cs_type_t type) {
+  if (!CS_TYPE_VALID(type)) return "undefined";
+  return cs_vft[type]->name;
+}
@@ -3,6 +3,8 @@
 
 #include <hicn/util/pool.h>
 #include "../content_store/lru.h"
+#include "../content_store/s3fifo.h"
+#include "../content_store/tinylfu.h"
 #include "msgbuf_pool.h"
 
 #define INVALID_ENTRY_ID ~0ul /* off_t */
@@ -14,6 +16,9 @@ typedef struct {
     off_t prev;
     off_t next;
   } lru;
+  /* Policy-specific state (list holding the entry, access frequency) */
+  uint8_t queue;
+  uint8_t freq;
 } cs_entry_t;
 
 #define cs_entry_get_msgbuf_id(entry) ((entry)->msgbuf_id)
@@ -21,10 +26,13 @@ typedef struct {
 typedef enum {
   CS_TYPE_UNDEFINED,
   CS_TYPE_LRU,
+  CS_TYPE_TINYLFU,
+  CS_TYPE_S3FIFO,
   CS_TYPE_N,
 } cs_type_t;
 
-#define CS_TYPE_VALID(type) (type != CS_TYPE_UNDEFINED) && (type != CS_TYPE_N)
+#define CS_TYPE_VALID(type) \
+  ((type != CS_TYPE_UNDEFINED) && (type != CS_TYPE_N))
 
 typedef struct {
   /* The maximum allowed expiry time (will never be exceeded). */
@@ -35,7 +43,18 @@ typedef struct {
   cs_type_t type;
   int num_entries;
   size_t max_size;
+  /*
+   * Entry removed from the policy state by the last call to add_entry that
+   * returned LRU_EVICTION. It is the new entry itself if the policy did not
+   * admit it.
+   */
+  off_t evicted;
+  /* LRU list, also used as the main list by the other policies */
   cs_lru_state_t lru;
+  union {
+    cs_tinylfu_state_t tinylfu;
+    cs_s3fifo_state_t s3fifo;
+  } policy;
   union {
     cs_lru_stats_t lru;
   } stats;
@@ -103,6 +122,13 @@ void cs_miss(cs_t *cs);
  */
 void cs_log(cs_t *cs);
 
+/**
+ * @brief Return the name of a content store type (e.g. "lru").
+ *
+ * @param[in] type Content store type
+ */
+const char *cs_type_str(cs_type_t type);
+
 cs_lru_stats_t cs_get_lru_stats(cs_t *cs);
 
 #endif /* HICNLIGHT_CS_H */
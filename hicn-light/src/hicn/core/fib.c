@@ -15,8 +15,11 @@
 
 #include <hicn/hicn-light/config.h>
 #include <stdio.h>
+#include <string.h>
 
 #include <hicn/core/fib.h>
+#include <hicn/util/hash.h>
+#include <hicn/util/khash.h>
 
 typedef struct fib_node_s {
   struct fib_node_s *child[2]; /* 0: left, 1: right */
@@ -53,12 +56,146 @@ static void fib_node_free(fib_node_t *node) {
 
 /******************************************************************************/
 
+/*
+ * Longest prefix match index
+ *
+ * The binary trie is the reference structure for FIB management (exact match,
+ * ordered traversal, inner nodes used by MAP-Me), but a lookup through it
+ * costs two dependent memory accesses (node, then entry prefix) per level,
+ * with a depth growing with the number of prefixes.
+ *
+ * The data path instead relies on a flat index of used nodes with one hash
+ * table per prefix length, keyed by the prefix masked to that length. A
+ * lookup probes the tables of prefix lengths in use only, from the longest to
+ * the shortest, so that its cost depends on the (usually very small) number
+ * of distinct prefix lengths rather than on the FIB size. The index is
+ * updated incrementally whenever a node is turned on or off.
+ *
+ * Bit positions and prefix lengths follow the semantics of hicn_prefix_lpm,
+ * so that the index returns the same entry as the trie.
+ */
+
+#define FIB_MAX_PREFIX_LEN 128
+#define FIB_LPM_LENS_WORDS ((FIB_MAX_PREFIX_LEN + 1 + 63) / 64)
+
+#define fib_lpm_hash(key) (hash_struct(&(key)))
+#define fib_lpm_equals(key1, key2)                   \
+  (((key1).v6.as_u64[0] == (key2).v6.as_u64[0]) && \
+   ((key1).v6.as_u64[1] == (key2).v6.as_u64[1]))
+
+KHASH_INIT(fib_lpm, hicn_ip_address_t, fib_node_t *, 1, fib_lpm_hash,
+           fib_lpm_equals);
+
 struct fib_s {
   void *forwarder;
   fib_node_t *root;
   unsigned size;
+
+  /* LPM index: one table per prefix length, allocated on demand */
+  kh_fib_lpm_t *lpm[FIB_MAX_PREFIX_LEN + 1];
+  /* Bitmap of prefix lengths having at least one entry in the index */
+  uint64_t lpm_lens[FIB_LPM_LENS_WORDS];
 };
 
+/* Mask an address to its first len bits (network byte order) */
+static inline hicn_ip_address_t fib_lpm_key(const hicn_ip_address_t *address,
+                                            uint8_t len) {
+  hicn_ip_address_t key;
+  for (unsigned i = 0; i < 2; i++) {
+    int bits = (int)len - 64 * (int)i;
+    uint64_t mask = (bits <= 0)    ? 0
+                    : (bits >= 64) ? ~0ULL
+                                   : hicn_host_to_net_64(~0ULL << (64 - bits));
+    key.v6.as_u64[i] = address->v6.as_u64[i] & mask;
+  }
+  return key;
+}
+
+static void fib_lpm_add(fib_t *fib, fib_node_t *node) {
+  const hicn_prefix_t *prefix = fib_entry_get_prefix(node->entry);
+  uint8_t len = hicn_prefix_get_len(prefix);
+  assert(len <= FIB_MAX_PREFIX_LEN);
+
+  if (!fib->lpm[len]) {
+    fib->lpm[len] = kh_init_fib_lpm();
+    if (!fib->lpm[len]) {
+      ERROR("[fib_lpm_add] Could not allocate LPM index");
+      return;
+    }
+  }
+
+  int res;
+  hicn_ip_address_t key = fib_lpm_key(hicn_prefix_get_ip_address(prefix), len);
+  khiter_t k = kh_put_fib_lpm(fib->lpm[len], key, &res);
+  if (res == -1) {
+    ERROR("[fib_lpm_add] Could not update LPM index");
+    return;
+  }
+  kh_value(fib->lpm[len], k) = node;
+  fib->lpm_lens[len / 64] |= 1ULL << (len % 64);
+}
+
+static void fib_lpm_remove(fib_t *fib, fib_node_t *node) {
+  const hicn_prefix_t *prefix = fib_entry_get_prefix(node->entry);
+  uint8_t len = hicn_prefix_get_len(prefix);
+  assert(len <= FIB_MAX_PREFIX_LEN);
+
+  kh_fib_lpm_t *table = fib->lpm[len];
+  if (!table) return;
+
+  hicn_ip_address_t key = fib_lpm_key(hicn_prefix_get_ip_address(prefix), len);
+  khiter_t k = kh_get_fib_lpm(table, key);
+  if (k == kh_end(table) || kh_value(table, k) != node) return;
+  kh_del_fib_lpm(table, k);
+
+  if (kh_size(table) == 0) fib->lpm_lens[len / 64] &= ~(1ULL << (len % 64));
+}
+
+/*
+ * Helper: toggle the use of a node, keeping the LPM index and the number of
+ * entries in sync.
+ */
+static void fib_node_set_used(fib_t *fib, fib_node_t *node, bool is_used) {
+  if (node->is_used == is_used) return;
+  node->is_used = is_used;
+  if (is_used) {
+    fib_lpm_add(fib, node);
+    fib->size++;
+  } else {
+    fib_lpm_remove(fib, node);
+    fib->size--;
+  }
+}
+
+/*
+ * Helper: returns the longest prefix length in use which is lower or equal to
+ * len, or -1 if none.
+ */
+static inline int fib_lpm_prev_len(const fib_t *fib, int len) {
+  if (len < 0) return -1;
+  for (int w = len / 64; w >= 0; w--) {
+    uint64_t word = fib->lpm_lens[w];
+    /* Only consider lengths up to len in the first word */
+    if (w == len / 64 && (len % 64) != 63) word &= (2ULL << (len % 64)) - 1;
+    if (word) return w * 64 + 63 - __builtin_clzll(word);
+  }
+  return -1;
+}
+
+static fib_node_t *fib_lpm_lookup(const fib_t *fib,
+                                  const hicn_ip_address_t *address,
+                                  uint8_t max_len) {
+  if (max_len > FIB_MAX_PREFIX_LEN) max_len = FIB_MAX_PREFIX_LEN;
+  for (int len = fib_lpm_prev_len(fib, max_len); len >= 0;
+       len = fib_lpm_prev_len(fib, len - 1)) {
+    kh_fib_lpm_t *table = fib->lpm[len];
+    hicn_ip_address_t key = fib_lpm_key(address, (uint8_t)len);
+    khiter_t k = kh_get_fib_lpm(table, key);
+    if (k != kh_end(table)) return kh_value(table, k);
+  }
+  return NULL;
+}
+
 fib_t *fib_create(void *forwarder) {
   fib_t *fib = malloc(sizeof(fib_t));
   if (!fib) return NULL;
@@ -66,6 +203,8 @@ fib_t *fib_create(void *forwarder) {
   fib->forwarder = forwarder;
   fib->root = NULL;
   fib->size = 0;
+  memset(fib->lpm, 0, sizeof(fib->lpm));
+  memset(fib->lpm_lens, 0, sizeof(fib->lpm_lens));
 
   return fib;
 }
@@ -74,6 +213,8 @@ void fib_free(fib_t *fib) {
   assert(fib);
 
   fib_node_free(fib->root);
+  for (unsigned i = 0; i <= FIB_MAX_PREFIX_LEN; i++)
+    if (fib->lpm[i]) kh_destroy_fib_lpm(fib->lpm[i]);
 
   free(fib);
 }
@@ -199,7 +340,10 @@ fib_node_t *_fib_insert(fib_t *fib, fib_entry_t *entry, fib_node_t *parent,
     new_node->child[next_bit] = child;
   }
 
-  if (is_used) fib->size++;
+  if (is_used) {
+    fib_lpm_add(fib, new_node);
+    fib->size++;
+  }
   return new_node;
 }
 
@@ -220,7 +364,12 @@ void _fib_remove(fib_t *fib, fib_node_t *curr, fib_node_t *parent) {
     else
       parent->child[ONE] = child;
   }
-  if (curr->is_used) fib->size--;
+  if (curr->is_used) {
+    fib_lpm_remove(fib, curr);
+    fib->size--;
+  }
+  /* Detach children as they have been re-attached to the parent */
+  curr->child[ZERO] = curr->child[ONE] = NULL;
   fib_node_free(curr);
 }
 
@@ -334,7 +483,7 @@ fib_entry_t *fib_add(fib_t *fib, fib_entry_t *entry) {
                      { fib_entry_nexthops_add(curr->entry, nexthop); });
     fib_entry_free(entry);
     entry = curr->entry;
-    curr->is_used = true;
+    fib_node_set_used(fib, curr, true);
     goto END;
   }
 
@@ -488,7 +637,7 @@ static void fib_node_remove(fib_t *fib, const hicn_prefix_t *prefix) {
 
   switch (N) {
     case 2:
-      curr->is_used = false;
+      fib_node_set_used(fib, curr, false);
       break;
 
     case 1:
@@ -514,13 +663,14 @@ void fib_remove(fib_t *fib, const hicn_prefix_t *prefix, unsigned conn_id) {
   if (fib_entry_nexthops_len(node->entry) == 0)
   /* When using MAP-Me, we keep empty FIB entries but we mark them as unused*/
 #ifdef WITH_MAPME
-    node->is_used = false;
+    fib_node_set_used(fib, node, false);
 #else
-    fib_node_remove(fib, name);
+    fib_node_remove(fib, prefix);
 #endif /* WITH_MAPME */
 }
 
-static size_t fib_node_remove_connection_id(fib_node_t *node, unsigned conn_id,
+static size_t fib_node_remove_connection_id(fib_t *fib, fib_node_t *node,
+                                            unsigned conn_id,
                                             fib_entry_t **array, size_t pos) {
   if (!node) return pos;
   if (node->is_used) {
@@ -529,13 +679,15 @@ static size_t fib_node_remove_connection_id(fib_node_t *node, unsigned conn_id,
     /* When using MAP-Me, we keep empty FIB entries but we mark them as unused*/
     if (fib_entry_nexthops_len(node->entry) == 0)
 #ifdef WITH_MAPME
-      node->is_used = false;
+      fib_node_set_used(fib, node, false);
 #else
       array[pos++] = node->entry;
 #endif /* WITH_MAPME */
   }
-  pos = fib_node_remove_connection_id(node->child[ONE], conn_id, array, pos);
-  pos = fib_node_remove_connection_id(node->child[ZERO], conn_id, array, pos);
+  pos = fib_node_remove_connection_id(fib, node->child[ONE], conn_id, array,
+                                      pos);
+  pos = fib_node_remove_connection_id(fib, node->child[ZERO], conn_id, array,
+                                      pos);
   return pos;
 }
 
@@ -551,7 +703,7 @@ void fib_remove_connection(fib_t *fib, unsigned conn_id,
   fib_entry_t **array = malloc(sizeof(fib_entry_t *) * fib->size);
 
   size_t pos = 0;
-  pos = fib_node_remove_connection_id(fib->root, conn_id, array, pos);
+  pos = fib_node_remove_connection_id(fib, fib->root, conn_id, array, pos);
 
   if (removed_entries) {
     /*
@@ -577,11 +729,22 @@ fib_entry_t *fib_match_msgbuf(const fib_t *fib, const msgbuf_t *msgbuf) {
   return fib_match_name(fib, msgbuf_get_name(msgbuf));
 }
 
+fib_entry_t *fib_match_prefix(const fib_t *fib, const hicn_prefix_t *prefix) {
+  assert(fib);
+  assert(prefix);
+
+  fib_node_t *node = fib_lpm_lookup(fib, hicn_prefix_get_ip_address(prefix),
+                                    hicn_prefix_get_len(prefix));
+  if (!node) return NULL;
+  return node->entry;
+}
+
 /*
  * fib_search returns the longest non-strict subprefix.
  * the LPM is stored in search if it exists
  */
-fib_entry_t *fib_match_prefix(const fib_t *fib, const hicn_prefix_t *prefix) {
+fib_entry_t *fib_match_prefix_trie(const fib_t *fib,
+                                   const hicn_prefix_t *prefix) {
   assert(fib);
   assert(prefix);
 
@@ -620,6 +783,51 @@ size_t fib_get_entry_array(const fib_t *fib, fib_entry_t ***array_p) {
   return pos;
 }
 
+/*
+ * Collects used entries of the subtree strictly after the cursor in prefix
+ * order, up to max entries (helper). A prefix comes before its extensions, and
+ * the ZERO subtree before the ONE subtree.
+ */
+static size_t fib_node_collect_entries_after(const fib_node_t *node,
+                                             const hicn_prefix_t *cursor,
+                                             fib_entry_t **array, size_t pos,
+                                             size_t max) {
+  if (!node || pos == max) return pos;
+
+  if (cursor) {
+    const hicn_prefix_t *prefix = fib_entry_get_prefix(node->entry);
+    uint32_t prefix_len = hicn_prefix_get_len(prefix);
+    uint32_t cursor_len = hicn_prefix_get_len(cursor);
+    uint32_t match_len = hicn_prefix_lpm(prefix, cursor);
+
+    if (match_len == prefix_len) {
+      /* The prefix is the cursor or one of its parents: skip it */
+      if (match_len == cursor_len) cursor = NULL;
+      pos = fib_node_collect_entries_after(node->child[ZERO], cursor, array,
+                                           pos, max);
+      return fib_node_collect_entries_after(node->child[ONE], cursor, array,
+                                            pos, max);
+    }
+
+    /* The whole subtree is either before or after the cursor */
+    if ((match_len < cursor_len) &&
+        (hicn_prefix_get_bit(prefix, match_len) == ZERO))
+      return pos;
+  }
+
+  if (node->is_used) array[pos++] = node->entry;
+
+  pos = fib_node_collect_entries_after(node->child[ZERO], NULL, array, pos,
+                                       max);
+  return fib_node_collect_entries_after(node->child[ONE], NULL, array, pos,
+                                        max);
+}
+
+size_t fib_get_entries_after(const fib_t *fib, const hicn_prefix_t *cursor,
+                             fib_entry_t **array, size_t max) {
+  return fib_node_collect_entries_after(fib->root, cursor, array, 0, max);
+}
+
 bool _fib_is_valid(const fib_node_t *node) {
   if (!node) return true;
 
@@ -54,8 +54,23 @@ fib_entry_t *fib_match_prefix(const fib_t *fib, const hicn_prefix_t *prefix);
 
 fib_entry_t *fib_match_name(const fib_t *fib, const hicn_name_t *name);
 
+/*
+ * Longest prefix match performed by walking the binary trie instead of using
+ * the LPM index. This is kept as a reference for validation and benchmarks.
+ */
+fib_entry_t *fib_match_prefix_trie(const fib_t *fib,
+                                   const hicn_prefix_t *prefix);
+
 size_t fib_get_entry_array(const fib_t *fib, fib_entry_t ***array_p);
 
+/*
+ * Fills the array with at most max entries, following the cursor prefix (or
+ * from the beginning if NULL) in prefix order. This allows walking the FIB by
+ * chunks, passing the prefix of the last returned entry as the next cursor.
+ */
+size_t fib_get_entries_after(const fib_t *fib, const hicn_prefix_t *cursor,
+                             fib_entry_t **array, size_t max);
+
 /*
  * NOTE : do not use return on the loop body to avoid leaking memory
  */
@@ -16,7 +16,10 @@
 #include <stdio.h>
 
 #include <hicn/hicn-light/config.h>
+#include <hicn/core/connection_table.h>
 #include <hicn/core/fib_entry.h>
+#include <hicn/core/forwarder.h>
+#include <hicn/core/rtt.h>
 #include <hicn/core/strategy.h>
 
 #ifdef WITH_MAPME
@@ -599,6 +602,19 @@ void fib_entry_on_data(fib_entry_t *entry, nexthops_t *data_nexthops,
   }
 }
 
+void fib_entry_on_rtt(fib_entry_t *entry, nexthop_t nexthop, Usecs rtt) {
+  assert(entry);
+
+  nexthops_t *nexthops = &entry->nexthops;
+  off_t i = nexthops_find_any(nexthops, nexthop);
+  if (i >= 0 && i < nexthops_get_len(nexthops))
+    rtt_stats_update(&nexthops_state(nexthops, i).rtt, rtt);
+
+  connection_table_t *table = forwarder_get_connection_table(entry->forwarder);
+  connection_t *connection = connection_table_get_by_id(table, nexthop);
+  if (connection) rtt_stats_update(&connection->stats.rtt, rtt);
+}
+
 void fib_entry_on_timeout(fib_entry_t *entry,
                           const nexthops_t *timeout_nexthops) {
   assert(entry);
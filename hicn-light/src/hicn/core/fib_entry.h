@@ -152,6 +152,15 @@ void fib_entry_on_data(fib_entry_t *fib_entry, nexthops_t *nexthops,
                        const msgbuf_t *object_msgbuf, Ticks pit_entry_creation,
                        Ticks data_reception);
 
+/**
+ * @brief Account an RTT sample measured by the PIT for a next hop of the
+ * entry, in the nexthop state and in the statistics of the connection.
+ *
+ * This is called before fib_entry_on_data(), so that strategies see the
+ * updated estimate.
+ */
+void fib_entry_on_rtt(fib_entry_t *fib_entry, nexthop_t nexthop, Usecs rtt);
+
 #ifdef WITH_POLICY
 hicn_policy_t fib_entry_get_policy(const fib_entry_t *fib_entry);
 void fib_entry_reconsider_policy(fib_entry_t *fib_entry);
@@ -64,10 +64,13 @@
 #include "msgbuf.h"
 #include "msgbuf_pool.h"
 #include "packet_cache.h"
+#include "worker.h"
 #include "../config/configuration.h"
 // #include "../config/configuration_file.h"
 #include "../config/commands.h"
 #include "../io/base.h"  // MAX_MSG
+#include "../io/uring.h"
+#include "../base/loop.h"
 
 #ifdef WITH_POLICY_STATS
 #include <hicn/core/policy_stats.h>
@@ -88,6 +91,7 @@ struct forwarder_s {
   configuration_t *config;
 
   pkt_cache_t *pkt_cache;
+  event_t *expiry_timer;
   fib_t *fib;
   msgbuf_pool_t *msgbuf_pool;
 
@@ -113,6 +117,12 @@ struct forwarder_s {
 
   // Used to store the msgbufs that need to be released
   off_t *acquired_msgbuf_ids;
+
+  // Worker running this forwarder, NULL in single-worker mode
+  worker_t *worker;
+
+  // io_uring I/O backend, NULL when using the event loop
+  uring_t *uring;
 };
 
 /**
@@ -144,14 +154,37 @@ static void forwarder_seed(forwarder_t *forwarder) {
 #endif
 }
 
+/**
+ * Reclaim expired PIT and CS entries by bounded slices, yielding to packet
+ * processing between them.
+ */
+static int forwarder_on_expiry_timeout(void *forwarder_arg, int fd,
+                                       unsigned id, void *data) {
+  forwarder_t *forwarder = forwarder_arg;
+  assert(forwarder);
+
+  size_t n_pit_expired, n_cs_expired;
+  bool done = pkt_cache_sweep(forwarder->pkt_cache, forwarder->msgbuf_pool,
+                              ticks_now(), PKT_CACHE_SWEEP_BUDGET,
+                              &n_pit_expired, &n_cs_expired);
+  forwarder->stats.countInterestsExpired += n_pit_expired;
+  forwarder->stats.countDataExpired += n_cs_expired;
+  loop_timer_register(forwarder->expiry_timer,
+                      done ? PKT_CACHE_SWEEP_INTERVAL : 0);
+  return 0;
+}
+
 forwarder_t *forwarder_create(configuration_t *configuration) {
   forwarder_t *forwarder = malloc(sizeof(forwarder_t));
   if (!forwarder) goto ERR_MALLOC;
 
   forwarder_seed(forwarder);
   srand(forwarder->seed[0] ^ forwarder->seed[1] ^ forwarder->seed[2]);
+  usecs_calibrate();
 
   forwarder->config = configuration;
+  forwarder->worker = NULL;
+  forwarder->uring = NULL;
 
   forwarder->listener_table = listener_table_create();
   if (!forwarder->listener_table) goto ERR_LISTENER_TABLE;
@@ -169,6 +202,19 @@ forwarder_t *forwarder_create(configuration_t *configuration) {
   forwarder->pkt_cache = pkt_cache_create(objectStoreSize);
   if (!forwarder->pkt_cache) goto ERR_PKT_CACHE;
 
+  const char *cs_disk_path = configuration_get_cs_disk_path(configuration);
+  if (cs_disk_path && objectStoreSize != 0) {
+    size_t cs_disk_size = configuration_get_cs_disk_size(configuration);
+    if (pkt_cache_set_cs_disk(forwarder->pkt_cache, cs_disk_path,
+                              cs_disk_size) < 0)
+      WARN("Disk content store disabled");
+  }
+
+  loop_timer_create(&forwarder->expiry_timer, MAIN_LOOP, forwarder,
+                    forwarder_on_expiry_timeout, NULL);
+  if (!forwarder->expiry_timer) goto ERR_EXPIRY_TIMER;
+  loop_timer_register(forwarder->expiry_timer, PKT_CACHE_SWEEP_INTERVAL);
+
   forwarder->subscriptions = subscription_table_create();
   if (!forwarder->subscriptions) goto ERR_SUBSCRIPTION;
 
@@ -194,6 +240,15 @@ forwarder_t *forwarder_create(configuration_t *configuration) {
   vector_init(forwarder->pending_conn, MAX_MSG, 0);
   vector_init(forwarder->acquired_msgbuf_ids, MAX_MSG, 0);
 
+  if (configuration_get_io_uring(configuration)) {
+    bool sqpoll = configuration_get_io_uring_sqpoll(configuration);
+    forwarder->uring = uring_create(forwarder, sqpoll);
+    if (!forwarder->uring)
+      WARN("Falling back to the default I/O backend");
+    else if (configuration_get_udp_gro(configuration))
+      WARN("UDP GRO is not supported with io_uring, and will not be used");
+  }
+
   char *n_suffixes_per_split_str = getenv("N_SUFFIXES_PER_SPLIT");
   if (n_suffixes_per_split_str)
     configuration_set_suffixes_per_split(forwarder_get_configuration(forwarder),
@@ -208,6 +263,8 @@ ERR_MAPME:
 
 ERR_SUBSCRIPTION:
   subscription_table_free(forwarder->subscriptions);
+  loop_event_free(forwarder->expiry_timer);
+ERR_EXPIRY_TIMER:
 ERR_PKT_CACHE:
   pkt_cache_free(forwarder->pkt_cache);
 
@@ -233,11 +290,14 @@ void forwarder_free(forwarder_t *forwarder) {
   mapme_free(forwarder->mapme);
 #endif /* WITH_MAPME */
 
+  loop_event_free(forwarder->expiry_timer);
   pkt_cache_free(forwarder->pkt_cache);
   msgbuf_pool_free(forwarder->msgbuf_pool);
   fib_free(forwarder->fib);
   connection_table_free(forwarder->connection_table);
   listener_table_free(forwarder->listener_table);
+  /* After faces, which cancel their pending receive operations */
+  if (forwarder->uring) uring_free(forwarder->uring);
   subscription_table_free(forwarder->subscriptions);
   configuration_free(forwarder->config);
   vector_free(forwarder->pending_conn);
@@ -418,6 +478,24 @@ configuration_t *forwarder_get_configuration(forwarder_t *forwarder) {
   return forwarder->config;
 }
 
+void forwarder_set_worker(forwarder_t *forwarder, worker_t *worker) {
+  assert(forwarder);
+
+  forwarder->worker = worker;
+}
+
+worker_t *forwarder_get_worker(const forwarder_t *forwarder) {
+  assert(forwarder);
+
+  return forwarder->worker;
+}
+
+uring_t *forwarder_get_uring(const forwarder_t *forwarder) {
+  assert(forwarder);
+
+  return forwarder->uring;
+}
+
 subscription_table_t *forwarder_get_subscriptions(
     const forwarder_t *forwarder) {
   return forwarder->subscriptions;
@@ -477,6 +555,21 @@ size_t forwarder_cs_get_size(forwarder_t *forwarder) {
   return pkt_cache_get_cs_size(forwarder->pkt_cache);
 }
 
+int forwarder_cs_set_policy(forwarder_t *forwarder, cs_type_t type) {
+  assert(forwarder);
+
+  if (pkt_cache_set_cs_type(forwarder->pkt_cache, type) < 0) {
+    ERROR("Unable to set the CS policy to %s", cs_type_str(type));
+    return -1;
+  }
+  return 0;
+}
+
+cs_type_t forwarder_cs_get_policy(forwarder_t *forwarder) {
+  assert(forwarder);
+  return pkt_cache_get_cs_type(forwarder->pkt_cache);
+}
+
 size_t forwarder_cs_get_num_stale_entries(forwarder_t *forwarder) {
   assert(forwarder);
   return pkt_cache_get_num_cs_stale_entries(forwarder->pkt_cache);
@@ -558,6 +651,7 @@ static ssize_t forwarder_forward_via_connection(forwarder_t *forwarder,
   if (msgbuf_get_type(msgbuf) == HICN_PACKET_TYPE_DATA)
     msgbuf_update_pathlabel(msgbuf, connection_get_id(conn));
 
+  msgbuf_pool_linearize(forwarder->msgbuf_pool, msgbuf);
   bool success = connection_send_packet(conn, msgbuf_get_packet(msgbuf),
                                         msgbuf_get_len(msgbuf));
 #else
@@ -670,6 +764,7 @@ static bool forwarder_forward_via_fib(forwarder_t *forwarder, off_t msgbuf_id,
   }
 
   pit_entry_set_fib_entry(pit_entry, fib_entry);
+  pit_entry_on_forward(pit_entry, msgbuf->recv_ts);
 
   // this requires some additional checks. It may happen that some of the output
   // faces selected by the forwarding strategy are not usable. So far all the
@@ -845,28 +940,33 @@ int _forwarder_forward_aggregated_interest(
 
     case INT_MANIFEST_SPLIT_STRATEGY_MAX_N_SUFFIXES: {
       // Generate sub-manifests: same as original manifest,
-      // but different suffix in the header and different bitmap
+      // but different bitmap
 
       int total_len = 0;
-      // Suffixes in manifest plus the one in the header
-      int total_suffixes = int_manifest_header->n_suffixes + 1;
+      // Suffixes in manifest, including the one in the header
+      int total_suffixes = int_manifest_header->n_suffixes;
 
-      // Save copy of original bitmap to use as a reference
-      // to generate bitmaps for sub-manifests
-      hicn_uword original_bitmap[BITMAP_SIZE] = {0};
-      memcpy(&original_bitmap, int_manifest_header->request_bitmap,
-             BITMAP_SIZE * sizeof(hicn_uword));
+      /*
+       * Sub-manifests are header-only msgbufs sharing the list of suffixes of
+       * the original one, which is serialized once for all of them. The
+       * original header is saved (in host byte order) as a reference to
+       * generate the header of each sub-manifest.
+       */
+      interest_manifest_header_t original_header = *int_manifest_header;
+      off_t original_id = msgbuf_id;
+      size_t manifest_offset =
+          (uint8_t *)int_manifest_header - msgbuf_get_packet(msgbuf);
+      size_t header_len = manifest_offset + sizeof(interest_manifest_header_t);
+      interest_manifest_serialize_suffixes(int_manifest_header);
 
       size_t suffix_index = 0;  // Position of suffix in initial manifest
-      interest_manifest_header_t *manifest = NULL;
-      size_t payload_size;
       while (suffix_index < total_suffixes) {
-        // If more than one sub-manifest,
-        // clone original interest manifest and update suffix
+        // If more than one sub-manifest, clone the headers of the original
+        // interest manifest
         if (suffix_index > 0) {
           msgbuf_t *clone;
-          off_t clone_id =
-              msgbuf_pool_clone(forwarder->msgbuf_pool, &clone, msgbuf_id);
+          off_t clone_id = msgbuf_pool_clone_header(
+              forwarder->msgbuf_pool, &clone, original_id, header_len);
           msgbuf_pool_acquire(clone);
           forwarder_acquired_msgbuf_ids_push(forwarder, clone_id);
 
@@ -874,20 +974,18 @@ int _forwarder_forward_aggregated_interest(
           msgbuf = clone;
         }
 
-        hicn_uword curr_bitmap[BITMAP_SIZE] = {0};
+        interest_manifest_header_t *manifest =
+            (interest_manifest_header_t *)(msgbuf_get_packet(msgbuf) +
+                                           manifest_offset);
+        *manifest = original_header;
+        memset(manifest->request_bitmap, 0, sizeof(manifest->request_bitmap));
+
         size_t first_suffix_index_in_submanifest = suffix_index;
         suffix_index = interest_manifest_update_bitmap(
-            original_bitmap, curr_bitmap, suffix_index, total_suffixes,
-            n_suffixes_per_split);
+            original_header.request_bitmap, manifest->request_bitmap,
+            suffix_index, total_suffixes, n_suffixes_per_split);
         size_t first_suffix_index_in_next_submanifest = suffix_index;
 
-        // Update manifest bitmap in current msgbuf
-
-        int ret =
-            _forwarder_get_interest_manifest(msgbuf, &manifest, &payload_size);
-        _ASSERT(ret == 0);
-        memcpy(manifest->request_bitmap, curr_bitmap,
-               BITMAP_SIZE * sizeof(hicn_uword));
         WITH_TRACE({
           bitmap_print(manifest->request_bitmap, BITMAP_SIZE);
           printf("\n");
@@ -917,12 +1015,13 @@ int _forwarder_forward_aggregated_interest(
           if (!pit_entry) goto RESTORE;
 
           pit_entry_set_fib_entry(pit_entry, fib_entry);
+          pit_entry_on_forward(pit_entry, msgbuf->recv_ts);
           nexthops_foreach(nexthops, nexthop,
                            { pit_entry_egress_add(pit_entry, nexthop); });
         }
 
-        // Serialize manifest before sending it
-        interest_manifest_serialize(int_manifest_header);
+        // Serialize manifest header before sending it
+        interest_manifest_serialize_header(manifest);
 
         if (forwarder_forward_to_nexthops(forwarder, msgbuf_id, nexthops) <=
             0) {
@@ -930,6 +1029,7 @@ int _forwarder_forward_aggregated_interest(
           continue;
         }
 
+        forwarder->stats.countManifestSplits++;
         total_len += msgbuf_get_len(msgbuf);
       }
 
@@ -984,11 +1084,13 @@ static ssize_t forwarder_process_aggregated_interest(
   // Save PIT entries to avoid re-doing pkt cache lookup in
   // `_forwarder_forward_aggregated_interest()`
   pkt_cache_entry_t *entries[BITMAP_SIZE * WORD_WIDTH];
+  // Names requested by the manifest, and their position in the manifest
+  hicn_name_t names[MAX_SUFFIXES_IN_MANIFEST];
+  unsigned long positions[MAX_SUFFIXES_IN_MANIFEST];
+  size_t n_names = 0;
 
   int n_suffixes_to_fwd = 0;
-
-  hicn_name_t name_copy = HICN_NAME_EMPTY;
-  hicn_name_copy(&name_copy, msgbuf_get_name(msgbuf));
+  Usecs start = usecs_now();
 
   // Suffixes in interest manifest also contains suffix in main name. We can
   // then just iterate the interest manifest and update the suffix in the name
@@ -996,12 +1098,20 @@ static ssize_t forwarder_process_aggregated_interest(
   hicn_name_suffix_t *suffix;
   unsigned long pos;
   interest_manifest_foreach_suffix(int_manifest_header, suffix, pos) {
-    // Update name
-    hicn_name_set_suffix(&name_copy, *suffix);
+    hicn_name_copy(&names[n_names], msgbuf_get_name(msgbuf));
+    hicn_name_set_suffix(&names[n_names], *suffix);
+    positions[n_names++] = pos;
+  }
+
+  // Lookups are done back to back once the index has been prefetched
+  pkt_cache_prefetch_names(forwarder->pkt_cache, names, n_names);
+
+  for (size_t i = 0; i < n_names; i++) {
+    pos = positions[i];
 
     // Update packet cache
     pkt_cache_on_interest(forwarder->pkt_cache, msgbuf_pool, msgbuf_id,
-                          &verdict, &data_msgbuf_id, &entry, &name_copy,
+                          &verdict, &data_msgbuf_id, &entry, &names[i],
                           forwarder->serve_from_cs);
 
     entries[pos] = entry;
@@ -1028,18 +1138,23 @@ static ssize_t forwarder_process_aggregated_interest(
 
     WITH_DEBUG({
       char buf[MAXSZ_HICN_PREFIX];
-      int rc = hicn_name_snprintf(buf, MAXSZ_HICN_NAME, &name_copy);
+      int rc = hicn_name_snprintf(buf, MAXSZ_HICN_NAME, &names[i]);
       if (rc < 0 || rc >= MAXSZ_HICN_PREFIX)
         snprintf(buf, MAXSZ_HICN_PREFIX, "(error)");
       DEBUG("Next in manifest: %s", buf);
     });
   }
 
-  // Return if nothing in the manifest to forward
-  if (n_suffixes_to_fwd == 0) return msgbuf_get_len(msgbuf);
+  ssize_t ret = msgbuf_get_len(msgbuf);
+  // Nothing else to do if nothing in the manifest to forward
+  if (n_suffixes_to_fwd > 0)
+    ret = _forwarder_forward_aggregated_interest(
+        forwarder, int_manifest_header, msgbuf, msgbuf_id, entries);
 
-  return _forwarder_forward_aggregated_interest(forwarder, int_manifest_header,
-                                                msgbuf, msgbuf_id, entries);
+  forwarder->stats.countManifests++;
+  forwarder->stats.countManifestSuffixes += (uint32_t)n_names;
+  forwarder->stats.usecsManifest += usecs_now() - start;
+  return ret;
 }
 
 /**
@@ -1207,6 +1322,7 @@ static ssize_t forwarder_process_data(forwarder_t *forwarder, off_t msgbuf_id) {
 
 void forwarder_flush_connections(forwarder_t *forwarder) {
   // DEBUG("[forwarder_flush_connections]");
+  uint64_t t0 = cycles_now();
   const connection_table_t *table = forwarder_get_connection_table(forwarder);
 
   unsigned num_pending_conn = (unsigned)vector_len(forwarder->pending_conn);
@@ -1219,6 +1335,11 @@ void forwarder_flush_connections(forwarder_t *forwarder) {
     }
   }
   vector_reset(forwarder->pending_conn);
+
+  /* Packets queued by io_uring connections are sent in a single call */
+  if (forwarder->uring) uring_submit(forwarder->uring);
+
+  forwarder->stats.cyclesFlush += cycles_now() - t0;
   // DEBUG("[forwarder_flush_connections] done");
 }
 
@@ -1469,35 +1590,161 @@ static void _forwarder_finalize_connection_if_self(connection_t *conn,
     connection_finalize(conn);
 }
 
-ssize_t forwarder_receive(forwarder_t *forwarder, listener_t *listener,
-                          off_t msgbuf_id, address_pair_t *pair, Ticks now) {
+/**
+ * @brief In multi-worker mode, hand over the packet to the worker owning its
+ * name prefix if this is not the current worker.
+ *
+ * @return true if the packet has been redirected (or dropped in the attempt)
+ * and should not be processed further by this forwarder.
+ */
+static bool _forwarder_redirect_to_owner(forwarder_t *forwarder,
+                                         const listener_t *listener,
+                                         msgbuf_t *msgbuf,
+                                         const hicn_name_t *name,
+                                         const address_pair_t *pair) {
+  worker_t *worker = forwarder->worker;
+  if (!worker || !listener) return false;
+
+  unsigned owner = worker_get_owner(worker, hicn_name_get_prefix_hash(name));
+  if (owner == worker_get_id(worker)) return false;
+
+  if (worker_redirect(worker, owner, msgbuf_get_packet(msgbuf),
+                      msgbuf_get_len(msgbuf), pair,
+                      listener_get_key(listener)) < 0)
+    forwarder->stats.countDropped++;
+  return true;
+}
+
+/**
+ * @brief Returns whether a command modifies the forwarder state, and should
+ * thus be applied by all workers.
+ */
+static bool _command_type_is_published(command_type_t command_type) {
+  switch (command_type) {
+    case COMMAND_TYPE_LISTENER_LIST:
+    case COMMAND_TYPE_CONNECTION_LIST:
+    case COMMAND_TYPE_ROUTE_LIST:
+    case COMMAND_TYPE_CACHE_LIST:
+    case COMMAND_TYPE_POLICY_LIST:
+    case COMMAND_TYPE_STATS_LIST:
+    case COMMAND_TYPE_FACE_STATS_LIST:
+    /* Subscriptions are bound to the connection of the ingress worker */
+    case COMMAND_TYPE_SUBSCRIPTION_ADD:
+    case COMMAND_TYPE_SUBSCRIPTION_REMOVE:
+      return false;
+    default:
+      return true;
+  }
+}
+
+void forwarder_replay_command(forwarder_t *forwarder, listener_t *listener,
+                              uint8_t *packet, size_t size,
+                              address_pair_t *pair) {
   assert(forwarder);
-  /* listener can be NULL */
-  assert(msgbuf_id_is_valid(msgbuf_id));
+  assert(packet);
   assert(pair);
 
-  hicn_name_t name;
-  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
-  msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
-  assert(msgbuf);
+  const connection_table_t *table = forwarder_get_connection_table(forwarder);
 
-  size_t size = msgbuf_get_len(msgbuf);
+  /*
+   * Replay the command on the connection matching the address pair so that
+   * SELF resolves to the same peer as on the originating worker.
+   */
+  connection_t *connection = connection_table_get_by_pair(table, pair);
+  unsigned connection_id =
+      connection
+          ? (unsigned)connection_table_get_connection_id(table, connection)
+          : CONNECTION_ID_UNDEFINED;
+  if (!connection_id_is_valid(connection_id) && listener) {
+    char conn_name[SYMBOLIC_NAME_LEN];
+    if (connection_table_get_random_name(table, conn_name) == 0) {
+      connection_id = listener_create_connection(listener, conn_name, pair);
+      connection = connection_id_is_valid(connection_id)
+                       ? connection_table_get_by_id(table, connection_id)
+                       : NULL;
+    }
+  }
 
-  const connection_table_t *table =
-      forwarder_get_connection_table(listener->forwarder);
+  msg_header_t *msg = (msg_header_t *)packet;
+  command_type_t command_type = msg->header.command_id;
 
-  /* Connection lookup */
-  if (msgbuf_get_connection_id(msgbuf) == CONNECTION_ID_UNDEFINED) {
-    connection_t *connection = connection_table_get_by_pair(table, pair);
-    unsigned conn_id =
-        connection
-            ? (unsigned)connection_table_get_connection_id(table, connection)
-            : CONNECTION_ID_UNDEFINED;
-
-    assert((conn_id != CONNECTION_ID_UNDEFINED) || listener);
-    msgbuf->connection_id = conn_id;
+  /* The reply is only sent back by the worker that received the command */
+  size_t reply_size = 0;
+  uint8_t *reply =
+      command_process(forwarder, packet, size, connection_id, &reply_size);
+  if (reply != packet) free(reply);
+
+  if (command_type == COMMAND_TYPE_CONNECTION_REMOVE && connection) {
+    cmd_connection_remove_t *control =
+        &((msg_connection_remove_t *)packet)->payload;
+    if (strcmp(control->symbolic_or_connid, "SELF") == 0)
+      connection_finalize(connection);
+  }
+}
+
+/**
+ * Look up the connection of a received packet from its address pair, if not
+ * already known (helper).
+ */
+static void _forwarder_lookup_connection(const connection_table_t *table,
+                                         msgbuf_t *msgbuf,
+                                         const address_pair_t *pair) {
+  if (msgbuf_get_connection_id(msgbuf) != CONNECTION_ID_UNDEFINED) return;
+
+  connection_t *connection = connection_table_get_by_pair(table, pair);
+  msgbuf->connection_id =
+      connection
+          ? (unsigned)connection_table_get_connection_id(table, connection)
+          : CONNECTION_ID_UNDEFINED;
+}
+
+/**
+ * Create a connection for a packet received from an unknown peer, and make it
+ * known to other workers if any (helper).
+ */
+static unsigned _forwarder_create_connection(forwarder_t *forwarder,
+                                             listener_t *listener,
+                                             const address_pair_t *pair) {
+  const connection_table_t *table = forwarder_get_connection_table(forwarder);
+
+  char conn_name[SYMBOLIC_NAME_LEN];
+  if (connection_table_get_random_name(table, conn_name) < 0) {
+    ERROR("Could not create name for new connection");
+    return CONNECTION_ID_UNDEFINED;
+  }
+
+  unsigned connection_id =
+      listener_create_connection(listener, conn_name, pair);
+  if (!connection_id_is_valid(connection_id)) {
+    ERROR("Could not create new connection");
+    return CONNECTION_ID_UNDEFINED;
   }
 
+  if (forwarder->worker) {
+    const connection_t *connection = connection_table_at(table, connection_id);
+    worker_publish_connection(forwarder->worker,
+                              connection_get_name(connection), pair,
+                              listener_get_key(listener));
+  }
+  return connection_id;
+}
+
+/**
+ * First stage of the processing of a received packet: connection lookup,
+ * packet analysis and, for interest and data packets, name extraction (which
+ * also computes the name hash).
+ */
+static void _forwarder_receive_analyze(forwarder_t *forwarder,
+                                       const listener_t *listener,
+                                       msgbuf_t *msgbuf,
+                                       const address_pair_t *pair, Usecs now) {
+  hicn_name_t name;
+  const connection_table_t *table = forwarder_get_connection_table(forwarder);
+
+  /* Connection lookup */
+  _forwarder_lookup_connection(table, msgbuf, pair);
+  assert(connection_id_is_valid(msgbuf->connection_id) || listener);
+
   forwarder->stats.countReceived++;
 
   /* Initialize packet buffer stored in msgbuf through libhicn */
@@ -1508,29 +1755,67 @@ ssize_t forwarder_receive(forwarder_t *forwarder, listener_t *listener,
 
   msgbuf->recv_ts = now;
 
-RETRY:
+  switch (msgbuf_get_type(msgbuf)) {
+    case HICN_PACKET_TYPE_INTEREST:
+      hicn_interest_get_name(msgbuf_get_pkbuf(msgbuf), &name);
+      msgbuf_set_name(msgbuf, &name);
+      break;
+
+    case HICN_PACKET_TYPE_DATA:
+      /* This include probes */
+      hicn_data_get_name(msgbuf_get_pkbuf(msgbuf), &name);
+      msgbuf_set_name(msgbuf, &name);
+      break;
+
+    case HICN_PACKET_TYPE_MAPME:
+    case HICN_PACKET_TYPE_COMMAND:
+#ifdef WITH_WLDR
+    case HICN_PACKET_TYPE_WLDR_NOTIFICATION:
+#endif
+      break;
+
+    default:
+      /* Commands are not recognized by the packet parser */
+      if (msgbuf_is_command(msgbuf))
+        msgbuf_set_type(msgbuf, HICN_PACKET_TYPE_COMMAND);
+      break;
+  }
+}
+
+/**
+ * Second stage of the processing of a received packet, once analyzed: packet
+ * cache lookup and forwarding, or processing of control packets.
+ */
+static ssize_t _forwarder_receive_process(forwarder_t *forwarder,
+                                          listener_t *listener,
+                                          off_t msgbuf_id,
+                                          address_pair_t *pair) {
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+  assert(msgbuf);
+
+  size_t size = msgbuf_get_len(msgbuf);
+
+  const connection_table_t *table = forwarder_get_connection_table(forwarder);
+
+  /*
+   * A packet analyzed in the same batch might have created the connection in
+   * the meantime
+   */
+  _forwarder_lookup_connection(table, msgbuf, pair);
 
   switch (msgbuf_get_type(msgbuf)) {
     case HICN_PACKET_TYPE_INTEREST:
+      if (_forwarder_redirect_to_owner(forwarder, listener, msgbuf,
+                                       msgbuf_get_name(msgbuf), pair))
+        return size;
       if (!connection_id_is_valid(msgbuf->connection_id)) {
-        char conn_name[SYMBOLIC_NAME_LEN];
-        int rc = connection_table_get_random_name(table, conn_name);
-        if (rc < 0) {
-          ERROR("Could not create name for new connection");
-          goto DROP;
-        }
-
         unsigned connection_id =
-            listener_create_connection(listener, conn_name, pair);
-        if (connection_id == CONNECTION_ID_UNDEFINED) {
-          ERROR("Could not create new connection");
-          goto DROP;
-        }
+            _forwarder_create_connection(forwarder, listener, pair);
+        if (!connection_id_is_valid(connection_id)) goto DROP;
         msgbuf->connection_id = connection_id;
       }
       msgbuf->path_label = 0;  // not used for interest packets
-      hicn_interest_get_name(msgbuf_get_pkbuf(msgbuf), &name);
-      msgbuf_set_name(msgbuf, &name);
 #ifdef WITH_WLDR
       forwarder_apply_wldr(forwarder, msgbuf, connection);
 #endif /* WITH_WLDR */
@@ -1540,14 +1825,14 @@ RETRY:
       break;
 
     case HICN_PACKET_TYPE_DATA:
-      /* This include probes */
+      if (_forwarder_redirect_to_owner(forwarder, listener, msgbuf,
+                                       msgbuf_get_name(msgbuf), pair))
+        return size;
       if (!connection_id_is_valid(msgbuf->connection_id)) {
         ERROR("Invalid connection for data packet");
         goto DROP;
       }
       msgbuf_init_pathlabel(msgbuf);
-      hicn_data_get_name(msgbuf_get_pkbuf(msgbuf), &name);
-      msgbuf_set_name(msgbuf, &name);
 #ifdef WITH_WLDR
       forwarder_apply_wldr(forwarder, msgbuf, connection);
 #endif /* WITH_WLDR */
@@ -1571,19 +1856,9 @@ RETRY:
     case HICN_PACKET_TYPE_MAPME:
       INFO("Received MAP-Me packet");
       if (!connection_id_is_valid(msgbuf->connection_id)) {
-        char conn_name[SYMBOLIC_NAME_LEN];
-        int rc = connection_table_get_random_name(table, conn_name);
-        if (rc < 0) {
-          ERROR("Could not create name for new connection");
-          goto DROP;
-        }
-
         unsigned connection_id =
-            listener_create_connection(listener, conn_name, pair);
-        if (connection_id == CONNECTION_ID_UNDEFINED) {
-          ERROR("Could not create new connection");
-          goto DROP;
-        }
+            _forwarder_create_connection(forwarder, listener, pair);
+        if (!connection_id_is_valid(connection_id)) goto DROP;
         INFO("Created connection upon MAP-Me packet");
         msgbuf->connection_id = connection_id;
       }
@@ -1593,19 +1868,9 @@ RETRY:
     case HICN_PACKET_TYPE_COMMAND:
       // Create the connection to send the ack back
       if (!connection_id_is_valid(msgbuf->connection_id)) {
-        char conn_name[SYMBOLIC_NAME_LEN];
-        int rc = connection_table_get_random_name(table, conn_name);
-        if (rc < 0) {
-          ERROR("Could not create name for new connection");
-          goto DROP;
-        }
-
         unsigned connection_id =
-            listener_create_connection(listener, conn_name, pair);
-        if (connection_id == CONNECTION_ID_UNDEFINED) {
-          ERROR("Could not create new connection");
-          goto DROP;
-        }
+            _forwarder_create_connection(forwarder, listener, pair);
+        if (!connection_id_is_valid(connection_id)) goto DROP;
         msgbuf->connection_id = connection_id;
       }
 
@@ -1622,17 +1887,20 @@ RETRY:
        */
       connection_t *connection =
           connection_table_get_by_id(table, msgbuf_get_connection_id(msgbuf));
+
+      /* Commands are processed in place, publish them beforehand */
+      if (forwarder->worker && listener &&
+          _command_type_is_published(msgbuf->command.type))
+        worker_publish_command(forwarder->worker, msgbuf_get_packet(msgbuf),
+                               msgbuf_get_len(msgbuf), pair,
+                               listener_get_key(listener));
+
       size = command_process_msgbuf(forwarder, msgbuf);
       if (msgbuf->command.type == COMMAND_TYPE_CONNECTION_REMOVE)
         _forwarder_finalize_connection_if_self(connection, msgbuf);
       return size;
 
     default:
-      /* Commands are not recognized by the packet parser */
-      if (msgbuf_is_command(msgbuf)) {
-        msgbuf_set_type(msgbuf, HICN_PACKET_TYPE_COMMAND);
-        goto RETRY;
-      }
       goto DROP;
   }
 
@@ -1643,6 +1911,80 @@ DROP:
   return 0;
 }
 
+
+ssize_t forwarder_receive(forwarder_t *forwarder, listener_t *listener,
+                          off_t msgbuf_id, address_pair_t *pair, Usecs now) {
+  assert(forwarder);
+  /* listener can be NULL */
+  assert(msgbuf_id_is_valid(msgbuf_id));
+  assert(pair);
+
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+  assert(msgbuf);
+
+  _forwarder_receive_analyze(forwarder, listener, msgbuf, pair, now);
+  return _forwarder_receive_process(forwarder, listener, msgbuf_id, pair);
+}
+
+ssize_t forwarder_receive_batch(forwarder_t *forwarder, listener_t *listener,
+                                const off_t *msgbuf_ids, address_pair_t *pairs,
+                                size_t n, Usecs now) {
+  assert(forwarder);
+  /* listener can be NULL */
+  assert(msgbuf_ids);
+  assert(pairs);
+
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  forwarder_stats_t *stats = &forwarder->stats;
+  off_t lookup_ids[FORWARDER_BATCH_SIZE];
+  size_t total_size = 0;
+  size_t i = 0;
+
+  while (i < n) {
+    size_t start = i;
+    size_t n_lookups = 0;
+    uint64_t t0 = cycles_now();
+
+    /*
+     * Stage 1: analyze packets and hash their names. Control packets end the
+     * vector, as they might change the state (eg. connections) on which the
+     * analysis of the next packets relies.
+     */
+    while (i < n && i - start < FORWARDER_BATCH_SIZE) {
+      assert(msgbuf_id_is_valid(msgbuf_ids[i]));
+      msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_ids[i]);
+      _forwarder_receive_analyze(forwarder, listener, msgbuf, &pairs[i], now);
+      i++;
+
+      hicn_packet_type_t type = msgbuf_get_type(msgbuf);
+      if (type != HICN_PACKET_TYPE_INTEREST && type != HICN_PACKET_TYPE_DATA)
+        break;
+      lookup_ids[n_lookups++] = msgbuf_ids[i - 1];
+    }
+    uint64_t t1 = cycles_now();
+
+    /* Stage 2: prefetch the packet cache index */
+    pkt_cache_prefetch(forwarder->pkt_cache, msgbuf_pool, lookup_ids,
+                       n_lookups);
+    uint64_t t2 = cycles_now();
+
+    /* Stage 3: packet cache lookup and forwarding */
+    for (size_t j = start; j < i; j++)
+      total_size += _forwarder_receive_process(forwarder, listener,
+                                               msgbuf_ids[j], &pairs[j]);
+    uint64_t t3 = cycles_now();
+
+    stats->countBatches++;
+    stats->countBatchPackets += (uint32_t)(i - start);
+    stats->cyclesAnalyze += t1 - t0;
+    stats->cyclesPrefetch += t2 - t1;
+    stats->cyclesProcess += t3 - t2;
+  }
+
+  return total_size;
+}
+
 void forwarder_log(forwarder_t *forwarder) {
   DEBUG(
       "Forwarder: received = %u (interest = %u, data = %u), dropped = %u "
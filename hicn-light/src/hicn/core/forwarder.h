@@ -45,6 +45,9 @@
 #define PORT_NUMBER 9695
 #define PORT_NUMBER_AS_STRING "9695"
 
+/* Maximum number of packets processed together by forwarder_receive_batch */
+#define FORWARDER_BATCH_SIZE 128
+
 //#include <hicn/utils/commands.h>
 
 // ==============================================
@@ -74,6 +77,24 @@ void forwarder_setup_local_listeners(forwarder_t *forwarder, uint16_t port);
 
 configuration_t *forwarder_get_configuration(forwarder_t *forwarder);
 
+typedef struct worker_s worker_t;
+
+/**
+ * @brief Bind the forwarder to a worker (see worker.h). A NULL worker
+ * corresponds to the default single-worker mode.
+ */
+void forwarder_set_worker(forwarder_t *forwarder, worker_t *worker);
+
+worker_t *forwarder_get_worker(const forwarder_t *forwarder);
+
+typedef struct uring_s uring_t;
+
+/**
+ * @brief Returns the io_uring I/O backend of the forwarder, or NULL if
+ * sockets are read through the event loop (default).
+ */
+uring_t *forwarder_get_uring(const forwarder_t *forwarder);
+
 subscription_table_t *forwarder_get_subscriptions(const forwarder_t *forwarder);
 
 /**
@@ -116,6 +137,16 @@ bool forwarder_cs_get_serve(forwarder_t *forwarder);
 void forwarder_cs_set_size(forwarder_t *forwarder, size_t size);
 
 size_t forwarder_cs_get_size(forwarder_t *forwarder);
+
+/**
+ * Sets the eviction and admission policy of the content store
+ *
+ * The content store is cleared if the policy changes.
+ */
+int forwarder_cs_set_policy(forwarder_t *forwarder, cs_type_t type);
+
+cs_type_t forwarder_cs_get_policy(forwarder_t *forwarder);
+
 size_t forwarder_cs_get_num_stale_entries(forwarder_t *forwarder);
 void forwarder_cs_clear(forwarder_t *forwarder);
 
@@ -235,14 +266,53 @@ const policy_stats_mgr_t *forwarder_get_policy_stats_mgr(
 
 void forwarder_flush_connections(forwarder_t *forwarder);
 
+/**
+ * @brief Apply a control command published by another worker.
+ *
+ * The command is processed on the connection corresponding to the given
+ * address pair (created on the given listener if needed), and no reply is
+ * sent back.
+ *
+ * @param forwarder - forwarder instance
+ * @param listener - listener on which the command was originally received
+ * (may be NULL)
+ * @param packet - serialized command, modified in place
+ * @param size - size of the command
+ * @param pair - address pair of the originating connection
+ */
+void forwarder_replay_command(forwarder_t *forwarder, listener_t *listener,
+                              uint8_t *packet, size_t size,
+                              address_pair_t *pair);
+
 /**
  * @brief Handles a newly received packet from a listener.
  *
  * NOTE: the received msgbuf is incomplete and only holds the packet content and
  * size/
+ *
+ * @param now - reception time of the packet (see usecs_now())
  */
 ssize_t forwarder_receive(forwarder_t *forwarder, listener_t *listener,
-                          off_t msgbuf_id, address_pair_t *pair, Ticks now);
+                          off_t msgbuf_id, address_pair_t *pair, Usecs now);
+
+/**
+ * @brief Handles a batch of newly received packets from a listener.
+ *
+ * Packets are processed in stages over vectors of at most FORWARDER_BATCH_SIZE
+ * packets: all packets are analyzed and their names hashed, the packet cache
+ * index is prefetched, and packets are then looked up and forwarded. The
+ * result is the same as calling forwarder_receive() for each packet in turn.
+ * The cycles spent in each stage are reported in the forwarder statistics.
+ *
+ * @param msgbuf_ids - identifiers of the received msgbufs
+ * @param pairs - address pairs of the received packets
+ * @param n - number of packets in the batch
+ * @param now - reception time of the packets (see usecs_now())
+ * @return the number of bytes processed
+ */
+ssize_t forwarder_receive_batch(forwarder_t *forwarder, listener_t *listener,
+                                const off_t *msgbuf_ids, address_pair_t *pairs,
+                                size_t n, Usecs now);
 
 /**
  * @brief Log forwarder statistics, e.g. info about packets processed, packets
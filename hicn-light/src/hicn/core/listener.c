@@ -25,6 +25,7 @@
 #include "forwarder.h"
 #include "listener_vft.h"
 #include "../io/base.h"
+#include "../io/uring.h"
 
 listener_key_t listener_key_factory(address_t address, face_type_t type) {
   listener_key_t key;
@@ -88,6 +89,12 @@ int listener_initialize(listener_t *listener, face_type_t type,
   face_protocol_t face_protocol = get_protocol(listener->type);
   if (face_protocol == FACE_PROTOCOL_UNKNOWN) goto ERR_VFT;
 
+  /* Some listener types are only available on some platforms or builds */
+  if (!listener_vft[face_protocol]) {
+    ERROR("Listener type %s is not supported", face_type_str(type));
+    goto ERR_VFT;
+  }
+
   listener->data = malloc(listener_vft[face_protocol]->data_size);
   if (!listener->data) goto ERR_DATA;
 
@@ -110,6 +117,12 @@ int listener_initialize(listener_t *listener, face_type_t type,
 
   // XXX data should be pre-allocated here
 
+  /* Out of io_uring receive slots, the socket is read by the event loop */
+  uring_t *uring = listener_get_uring(listener);
+  if (uring &&
+      uring_listen(uring, listener->fd, listener, CONNECTION_ID_UNDEFINED) == 0)
+    return 0;
+
   loop_fd_event_create(&listener->event_data, MAIN_LOOP, listener->fd, listener,
                        (fd_callback_t)listener_read_callback,
                        CONNECTION_ID_UNDEFINED, NULL);
@@ -145,6 +158,9 @@ int listener_finalize(listener_t *listener) {
     loop_event_free(listener->event_data);
   }
 
+  uring_t *uring = listener_get_uring(listener);
+  if (uring) uring_unlisten(uring, listener->fd);
+
   if (listener->fd != -1) {
 #ifndef _WIN32
     close(listener->fd);
@@ -153,7 +169,8 @@ int listener_finalize(listener_t *listener) {
 #endif
   }
 
-  listener_vft[get_protocol(listener->type)]->finalize(listener);
+  const listener_ops_t *ops = listener_vft[get_protocol(listener->type)];
+  if (ops) ops->finalize(listener);
 
   if (listener->data) free(listener->data);
   listener->data = NULL;
@@ -165,6 +182,13 @@ int listener_finalize(listener_t *listener) {
   return 0;
 }
 
+uring_t *listener_get_uring(const listener_t *listener) {
+  /* Only datagram sockets are supported */
+  if (!listener->forwarder || get_protocol(listener->type) != FACE_PROTOCOL_UDP)
+    return NULL;
+  return forwarder_get_uring(listener->forwarder);
+}
+
 int listener_get_socket(const listener_t *listener, const address_t *local,
                         const address_t *remote, const char *interface_name) {
   assert(listener);
@@ -199,10 +223,14 @@ unsigned listener_create_connection(listener_t *listener,
     case FACE_TYPE_TCP_LISTENER:
       connection_type = FACE_TYPE_TCP;
       break;
+    case FACE_TYPE_MEMIF_LISTENER:
+      connection_type = FACE_TYPE_MEMIF;
+      break;
     case FACE_TYPE_HICN:
     case FACE_TYPE_HICN_LISTENER:
     case FACE_TYPE_UDP:
     case FACE_TYPE_TCP:
+    case FACE_TYPE_MEMIF:
     case FACE_TYPE_UNDEFINED:
     case FACE_TYPE_N:
       return CONNECTION_ID_UNDEFINED;
@@ -226,8 +254,15 @@ unsigned listener_create_connection(listener_t *listener,
 
   connection_table_t *table =
       forwarder_get_connection_table(listener->forwarder);
+  /* The table might attribute a different name if the pair is already known */
   connection_t *connection =
-      connection_table_allocate(table, pair, connection_name);
+      _connection_table_allocate(table, pair, connection_name, &connection_name);
+  if (!connection) {
+#ifdef USE_CONNECTED_SOCKETS
+    close(fd);
+#endif
+    return CONNECTION_ID_UNDEFINED;
+  }
   unsigned connection_id =
       (unsigned int)connection_table_get_connection_id(table, connection);
 
@@ -297,7 +332,7 @@ ssize_t listener_read_single(listener_t *listener, int fd,
 
   // Process received packet
   size_t processed_bytes = forwarder_receive(listener->forwarder, listener,
-                                             msgbuf_id, &pair, ticks_now());
+                                             msgbuf_id, &pair, usecs_now());
   forwarder_log(listener->forwarder);
   if (processed_bytes <= 0) ERROR("Unable to handle message");
 
@@ -311,6 +346,32 @@ ssize_t listener_read_single(listener_t *listener, int fd,
   return processed_bytes;
 }
 
+/*
+ * Account for a batch read on a listener socket, which might carry packets
+ * from several connections: each connection is counted once per call.
+ */
+static void listener_update_io_stats(forwarder_t *forwarder,
+                                     const off_t *msgbuf_ids, int n) {
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  connection_table_t *table = forwarder_get_connection_table(forwarder);
+  unsigned counted[MAX_MSG];
+  unsigned n_counted = 0;
+
+  for (int i = 0; i < n; i++) {
+    msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_ids[i]);
+    unsigned connection_id = msgbuf_get_connection_id(msgbuf);
+    connection_t *connection = connection_table_get_by_id(table, connection_id);
+    if (!connection) continue;
+    connection->stats.io.rx_segments++;
+
+    unsigned j = 0;
+    while ((j < n_counted) && (counted[j] != connection_id)) j++;
+    if (j < n_counted) continue;
+    counted[n_counted++] = connection_id;
+    connection->stats.io.rx_calls++;
+  }
+}
+
 ssize_t listener_read_batch(listener_t *listener, int fd,
                             unsigned connection_id) {
   assert(listener);
@@ -367,12 +428,25 @@ ssize_t listener_read_batch(listener_t *listener, int fd,
     if (num_msg_received < 0) break;
     TRACE("[listener_read_batch] batch size = %d", num_msg_received);
 
-    for (unsigned i = 0; i < num_msg_received; i++) {
-      size_t processed_bytes = forwarder_receive(
-          forwarder, listener, msgbuf_ids[i], &pair[i], ticks_now());
+    /* Connected sockets are read on behalf of a single connection */
+    if (connection_id_is_valid(connection_id) && num_msg_received > 0) {
+      connection_table_t *table = forwarder_get_connection_table(forwarder);
+      connection_t *connection =
+          connection_table_get_by_id(table, connection_id);
+      if (connection) {
+        connection->stats.io.rx_calls++;
+        connection->stats.io.rx_segments += num_msg_received;
+      }
+    }
+
+    if (num_msg_received > 0) {
+      total_processed_bytes += forwarder_receive_batch(
+          forwarder, listener, msgbuf_ids, pair, num_msg_received, usecs_now());
       forwarder_log(listener->forwarder);
 
-      total_processed_bytes += processed_bytes;
+      /* Connections are only known once the batch has been processed */
+      if (!connection_id_is_valid(connection_id))
+        listener_update_io_stats(forwarder, msgbuf_ids, num_msg_received);
     }
   } while (num_msg_received ==
            MAX_MSG); /* backpressure based on queue size ? */
@@ -422,4 +496,13 @@ void listener_setup_local(forwarder_t *forwarder, uint16_t port) {
   address_t localhost_ipv6_addr = ADDRESS6_LOCALHOST(port);
   listener_create(FACE_TYPE_UDP_LISTENER, &localhost_ipv6_addr, "lo", "lo_udp6",
                   forwarder);
+
+#ifdef WITH_MEMIF
+  /* Workers would all try to bind the same memif socket */
+  configuration_t *config = forwarder_get_configuration(forwarder);
+  if (configuration_get_n_workers(config) == 1 &&
+      configuration_get_memif_socket(config))
+    listener_create(FACE_TYPE_MEMIF_LISTENER, &localhost_ipv4_addr, "lo",
+                    "lo_memif", forwarder);
+#endif /* WITH_MEMIF */
 }
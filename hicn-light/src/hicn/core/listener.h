@@ -107,6 +107,14 @@ int listener_punt(const listener_t *listener, const char *prefix_s);
 int listener_get_socket(const listener_t *listener, const address_t *local,
                         const address_t *remote, const char *interface_name);
 
+typedef struct uring_s uring_t;
+
+/**
+ * @brief Returns the io_uring backend reading the sockets of the listener
+ * (and of its connections), or NULL if they are read through the event loop.
+ */
+uring_t *listener_get_uring(const listener_t *listener);
+
 unsigned listener_create_connection(listener_t *listener, const char *name,
                                     const address_pair_t *pair);
 
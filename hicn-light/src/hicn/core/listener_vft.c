@@ -25,12 +25,19 @@ extern listener_ops_t listener_hicn;
 #endif
 extern listener_ops_t listener_tcp;
 extern listener_ops_t listener_udp;
+#ifdef WITH_MEMIF
+extern listener_ops_t listener_memif;
+#endif
 
-const listener_ops_t* listener_vft[] = {
+/* Unsupported protocols are left NULL */
+const listener_ops_t* listener_vft[FACE_PROTOCOL_UNKNOWN] = {
 #ifdef __linux__
     [FACE_PROTOCOL_HICN] = &listener_hicn,
 #endif
 
     [FACE_PROTOCOL_TCP] = &listener_tcp,
     [FACE_PROTOCOL_UDP] = &listener_udp,
+#ifdef WITH_MEMIF
+    [FACE_PROTOCOL_MEMIF] = &listener_memif,
+#endif
 };
@@ -35,19 +35,28 @@
 typedef struct {
   hicn_packet_buffer_t pkbuf;
   unsigned connection_id;  // ingress
-  Ticks recv_ts;           // timestamp
+  Usecs recv_ts;           // timestamp (us)
   unsigned refs;           // refcount
   unsigned path_label;     // original path label of the received message. used
                            // as a base for the path label computation when the
                            // same data packet needs to be forwarded on multiple
                            // face.
 
+  /*
+   * Header-only copy of another msgbuf, eg. a split interest manifest: only
+   * the first shared_offset bytes of the packet are stored here, the rest of
+   * the packet is read from msgbuf shared_id (on which a reference is held).
+   * This is 0 for a regular msgbuf.
+   */
+  uint16_t shared_offset;
+  off_t shared_id;
+
   // XXX Cache storage
   union {
     /* Interest or data packet */
     struct {
       hicn_name_t name;
-      u32 name_hash;  // XXX should be always populate when name is assigned
+      u32 name_hash;  // Set along with the name
     } id;
     /* Command packet */
     struct {
@@ -81,6 +90,7 @@ static inline const hicn_name_t *msgbuf_get_name(const msgbuf_t *msgbuf) {
 #define msgbuf_get_connection_id(M) ((M)->connection_id)
 #define msgbuf_set_connection_id(M, ID) (M)->connection_id = (ID)
 #define msgbuf_get_packet(M) ((M)->packet)
+#define msgbuf_is_shared(M) ((M)->shared_offset != 0)
 #define msgbuf_get_command_type(M) ((M)->command.type)
 #if WITH_WLDR
 #define msgbuf_has_wldr(M) (messageHandler_HasWldr((M)->packet))
@@ -88,6 +98,7 @@ static inline const hicn_name_t *msgbuf_get_name(const msgbuf_t *msgbuf) {
 
 static inline void msgbuf_set_name(msgbuf_t *msgbuf, const hicn_name_t *name) {
   msgbuf->id.name = *name;
+  msgbuf->id.name_hash = hicn_name_get_hash(name);
 }
 
 static inline size_t msgbuf_get_len(const msgbuf_t *msgbuf) {
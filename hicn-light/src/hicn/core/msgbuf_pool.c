@@ -18,6 +18,8 @@
  * @brief Implementation of hICN packet pool.
  */
 
+#include <stddef.h>
+
 #include <hicn/util/pool.h>
 #include <hicn/util/log.h>
 #include "msgbuf_pool.h"
@@ -40,6 +42,7 @@ void msgbuf_pool_free(msgbuf_pool_t *msgbuf_pool) {
 off_t msgbuf_pool_get(msgbuf_pool_t *msgbuf_pool, msgbuf_t **msgbuf) {
   off_t id = pool_get(msgbuf_pool->buffers, *msgbuf);
   (*msgbuf)->refs = 0;
+  (*msgbuf)->shared_offset = 0;
   return id;
 }
 
@@ -108,8 +111,15 @@ void msgbuf_pool_release(msgbuf_pool_t *msgbuf_pool, msgbuf_t **msgbuf_ptr) {
       }
     })
 
+    off_t shared_id = msgbuf->shared_id;
+    bool is_shared = msgbuf_is_shared(msgbuf);
     msgbuf_pool_put(msgbuf_pool, msgbuf);
     *msgbuf_ptr = NULL;
+
+    if (is_shared) {
+      msgbuf_t *shared = msgbuf_pool_at(msgbuf_pool, shared_id);
+      msgbuf_pool_release(msgbuf_pool, &shared);
+    }
   }
 };
 
@@ -119,5 +129,61 @@ off_t msgbuf_pool_clone(msgbuf_pool_t *msgbuf_pool, msgbuf_t **new_msgbuf,
   off_t offset = pool_get(msgbuf_pool->buffers, *new_msgbuf);
   memcpy(*new_msgbuf, original_msgbuf, sizeof(msgbuf_t));
   (*new_msgbuf)->refs = 0;
+  if (msgbuf_is_shared(*new_msgbuf))
+    msgbuf_pool_acquire(msgbuf_pool_at(msgbuf_pool, (*new_msgbuf)->shared_id));
   return offset;
 }
+
+off_t msgbuf_pool_clone_header(msgbuf_pool_t *msgbuf_pool,
+                               msgbuf_t **new_msgbuf, off_t original_msg_id,
+                               size_t header_len) {
+  off_t offset = pool_get(msgbuf_pool->buffers, *new_msgbuf);
+  /* The pool might have been resized */
+  msgbuf_t *original_msgbuf = msgbuf_pool_at(msgbuf_pool, original_msg_id);
+  assert(!msgbuf_is_shared(original_msgbuf));
+  assert(header_len > 0);
+
+  size_t len = msgbuf_get_len(original_msgbuf);
+  if (header_len >= len) header_len = len;
+  memcpy(*new_msgbuf, original_msgbuf,
+         offsetof(msgbuf_t, packet) + header_len);
+  (*new_msgbuf)->refs = 0;
+
+  if (header_len == len) {
+    (*new_msgbuf)->shared_offset = 0;
+  } else {
+    (*new_msgbuf)->shared_offset = (uint16_t)header_len;
+    (*new_msgbuf)->shared_id = original_msg_id;
+    msgbuf_pool_acquire(original_msgbuf);
+  }
+  return offset;
+}
+
+void msgbuf_pool_linearize(msgbuf_pool_t *msgbuf_pool, msgbuf_t *msgbuf) {
+  if (!msgbuf_is_shared(msgbuf)) return;
+
+  msgbuf_t *shared = msgbuf_pool_at(msgbuf_pool, msgbuf->shared_id);
+  size_t offset = msgbuf->shared_offset;
+  memcpy(msgbuf->packet + offset, shared->packet + offset,
+         msgbuf_get_len(msgbuf) - offset);
+  msgbuf->shared_offset = 0;
+  msgbuf_pool_release(msgbuf_pool, &shared);
+}
+
+#ifndef _WIN32
+unsigned msgbuf_pool_get_iovecs(const msgbuf_pool_t *msgbuf_pool,
+                                msgbuf_t *msgbuf, struct iovec *iov) {
+  size_t len = msgbuf_get_len(msgbuf);
+  iov[0].iov_base = msgbuf_get_packet(msgbuf);
+  if (!msgbuf_is_shared(msgbuf)) {
+    iov[0].iov_len = len;
+    return 1;
+  }
+
+  const msgbuf_t *shared = msgbuf_pool_at(msgbuf_pool, msgbuf->shared_id);
+  iov[0].iov_len = msgbuf->shared_offset;
+  iov[1].iov_base = (uint8_t *)shared->packet + msgbuf->shared_offset;
+  iov[1].iov_len = len - msgbuf->shared_offset;
+  return 2;
+}
+#endif /* _WIN32 */
@@ -38,6 +38,10 @@
 #ifndef HICNLIGHT_MSGBUF_POOL_H
 #define HICNLIGHT_MSGBUF_POOL_H
 
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
+
 #include "msgbuf.h"
 
 #define MTU 1500
@@ -154,4 +158,46 @@ void msgbuf_pool_release(msgbuf_pool_t *msgbuf_pool, msgbuf_t **msgbuf_ptr);
 off_t msgbuf_pool_clone(msgbuf_pool_t *msgbuf_pool, msgbuf_t **new_msgbuf,
                         off_t orginal_msg_id);
 
+/**
+ * @brief Copy the first bytes of the original msgbuf in a new msgbuf taken
+ * from the pool, which shares the rest of the packet with the original one.
+ * The original msgbuf is acquired until the new one is released. The ref count
+ * on new msgbuf is set to 0.
+ *
+ * @param[in] msgbuf_pool Pointer to the msgbuf pool data structure to use
+ * @param[in,out] new_msgbuf Pointer that holds the header-only msgbuf
+ * @param[in] original_msg_id ID of the original msgbuf, which cannot be a
+ * header-only msgbuf itself
+ * @param[in] header_len Number of bytes of the packet to copy
+ * @return off_t ID of the msgbuf requested.
+ */
+off_t msgbuf_pool_clone_header(msgbuf_pool_t *msgbuf_pool,
+                               msgbuf_t **new_msgbuf, off_t original_msg_id,
+                               size_t header_len);
+
+/**
+ * @brief Copy the shared part of the packet of a header-only msgbuf, so that
+ * the whole packet is stored in the msgbuf. This is a no-op for regular
+ * msgbufs.
+ *
+ * @param[in] msgbuf_pool Pointer to the msgbuf pool data structure to use
+ * @param[in] msgbuf Pointer to the msgbuf to linearize
+ */
+void msgbuf_pool_linearize(msgbuf_pool_t *msgbuf_pool, msgbuf_t *msgbuf);
+
+#ifndef _WIN32
+/**
+ * @brief Fill the buffers holding the packet of a msgbuf, for scatter-gather
+ * I/O.
+ *
+ * @param[in] msgbuf_pool Pointer to the msgbuf pool data structure to use
+ * @param[in] msgbuf Pointer to the msgbuf to send
+ * @param[out] iov Array of (at least) two iovecs to fill
+ * @return unsigned Number of iovecs used, 2 for header-only msgbufs and 1
+ * otherwise.
+ */
+unsigned msgbuf_pool_get_iovecs(const msgbuf_pool_t *msgbuf_pool,
+                                msgbuf_t *msgbuf, struct iovec *iov);
+#endif /* _WIN32 */
+
 #endif /* HICNLIGHT_MSGBUF_POOL_H */
@@ -0,0 +1,254 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file name_table.c
+ * \brief Implementation of the flat name table
+ */
+
+#include <assert.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+#include "name_table.h"
+
+#define NAME_TABLE_CTRL_EMPTY ((int8_t)-128)
+#define NAME_TABLE_CTRL_DELETED ((int8_t)-2)
+
+/* At most 7/8 of the slots are used, so that probing always ends */
+#define name_table_max_load(capacity) ((capacity) - (capacity) / 8)
+
+#define name_table_capacity(table) \
+  (((table)->group_mask + 1) * NAME_TABLE_GROUP_WIDTH)
+
+/*------------------------------------------------------------------------*/
+/* Group operations */
+
+/**
+ * Return a bitmask of the slots of the group whose control byte is h2.
+ */
+static inline uint32_t name_table_group_match(const int8_t *ctrl, int8_t h2) {
+#ifdef __SSE2__
+  __m128i group = _mm_loadu_si128((const __m128i *)ctrl);
+  return _mm_movemask_epi8(_mm_cmpeq_epi8(group, _mm_set1_epi8(h2)));
+#else
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < NAME_TABLE_GROUP_WIDTH; i++)
+    if (ctrl[i] == h2) mask |= 1u << i;
+  return mask;
+#endif
+}
+
+/**
+ * Return a bitmask of the slots of the group that are EMPTY or DELETED, ie.
+ * whose control byte has the high bit set.
+ */
+static inline uint32_t name_table_group_match_free(const int8_t *ctrl) {
+#ifdef __SSE2__
+  return _mm_movemask_epi8(_mm_loadu_si128((const __m128i *)ctrl));
+#else
+  uint32_t mask = 0;
+  for (unsigned i = 0; i < NAME_TABLE_GROUP_WIDTH; i++)
+    if (ctrl[i] < 0) mask |= 1u << i;
+  return mask;
+#endif
+}
+
+#define name_table_group_match_empty(ctrl) \
+  name_table_group_match(ctrl, NAME_TABLE_CTRL_EMPTY)
+
+/*
+ * Groups are probed following triangular numbers, which visits all groups
+ * when their number is a power of two.
+ */
+#define name_table_foreach_group(table, hash, group, i)              \
+  for (size_t i = 1, group = name_table_h1(hash) & (table)->group_mask; \
+       ; group = (group + i++) & (table)->group_mask)
+
+/*------------------------------------------------------------------------*/
+/* Allocation */
+
+static void name_table_allocate(name_table_t *table, size_t n_groups) {
+  size_t capacity = n_groups * NAME_TABLE_GROUP_WIDTH;
+
+  table->ctrl = malloc(capacity);
+  memset(table->ctrl, NAME_TABLE_CTRL_EMPTY, capacity);
+  table->slots = malloc(capacity * sizeof(name_table_slot_t));
+  table->group_mask = n_groups - 1;
+  table->size = 0;
+  table->growth_left = name_table_max_load(capacity);
+}
+
+name_table_t *name_table_create(size_t init_size) {
+  name_table_t *table = malloc(sizeof(name_table_t));
+  if (!table) return NULL;
+
+  size_t n_groups = 1;
+  while (name_table_max_load(n_groups * NAME_TABLE_GROUP_WIDTH) < init_size)
+    n_groups <<= 1;
+
+  name_table_allocate(table, n_groups);
+  return table;
+}
+
+void name_table_free(name_table_t *table) {
+  assert(table);
+
+  free(table->ctrl);
+  free(table->slots);
+  free(table);
+}
+
+void name_table_clear(name_table_t *table) {
+  assert(table);
+
+  size_t capacity = name_table_capacity(table);
+  memset(table->ctrl, NAME_TABLE_CTRL_EMPTY, capacity);
+  table->size = 0;
+  table->growth_left = name_table_max_load(capacity);
+}
+
+/**
+ * Return the position of the first free slot in the probe sequence of a
+ * hash (helper).
+ */
+static size_t name_table_find_free(const name_table_t *table, uint32_t hash) {
+  name_table_foreach_group(table, hash, group, i) {
+    const int8_t *ctrl = table->ctrl + group * NAME_TABLE_GROUP_WIDTH;
+    uint32_t mask = name_table_group_match_free(ctrl);
+    if (mask) return group * NAME_TABLE_GROUP_WIDTH + __builtin_ctz(mask);
+  }
+}
+
+/**
+ * Move all names into a new allocation of n_groups groups. This also drops
+ * the DELETED slots (helper).
+ */
+static void name_table_rehash(name_table_t *table, size_t n_groups) {
+  int8_t *old_ctrl = table->ctrl;
+  name_table_slot_t *old_slots = table->slots;
+  size_t old_capacity = name_table_capacity(table);
+  size_t size = table->size;
+
+  name_table_allocate(table, n_groups);
+
+  for (size_t pos = 0; pos < old_capacity; pos++) {
+    if (old_ctrl[pos] < 0) continue;
+
+    uint32_t hash = hicn_name_get_hash(&old_slots[pos].name);
+    size_t new_pos = name_table_find_free(table, hash);
+    table->ctrl[new_pos] = name_table_h2(hash);
+    table->slots[new_pos] = old_slots[pos];
+  }
+  table->size = size;
+  table->growth_left -= size;
+
+  free(old_ctrl);
+  free(old_slots);
+}
+
+/**
+ * Return the position of a name, or -1 if not found. Only the slots whose
+ * control byte matches the hash are compared (helper).
+ */
+static ssize_t name_table_find(const name_table_t *table,
+                               const hicn_name_t *name, uint32_t hash) {
+  int8_t h2 = name_table_h2(hash);
+  name_table_foreach_group(table, hash, group, i) {
+    const int8_t *ctrl = table->ctrl + group * NAME_TABLE_GROUP_WIDTH;
+
+    for (uint32_t mask = name_table_group_match(ctrl, h2); mask;
+         mask &= mask - 1) {
+      size_t pos = group * NAME_TABLE_GROUP_WIDTH + __builtin_ctz(mask);
+      if (hicn_name_equals(&table->slots[pos].name, name)) return pos;
+    }
+
+    // The name would have been inserted in this group
+    if (name_table_group_match_empty(ctrl)) return -1;
+  }
+}
+
+/*------------------------------------------------------------------------*/
+/* Public API */
+
+unsigned name_table_get(const name_table_t *table, const hicn_name_t *name,
+                        uint32_t hash) {
+  assert(table);
+  assert(name);
+
+  ssize_t pos = name_table_find(table, name, hash);
+  return pos < 0 ? NAME_TABLE_INVALID_VALUE : table->slots[pos].value;
+}
+
+void name_table_put(name_table_t *table, const hicn_name_t *name,
+                    uint32_t hash, unsigned value) {
+  assert(table);
+  assert(name);
+  assert(value != NAME_TABLE_INVALID_VALUE);
+
+  ssize_t found = name_table_find(table, name, hash);
+  if (found >= 0) {
+    table->slots[found].value = value;
+    return;
+  }
+
+  size_t pos = name_table_find_free(table, hash);
+  if (table->growth_left == 0 && table->ctrl[pos] == NAME_TABLE_CTRL_EMPTY) {
+    /*
+     * Grow the table, unless most of the used slots are DELETED, in which case
+     * reclaiming them is enough.
+     */
+    size_t n_groups = table->group_mask + 1;
+    if (table->size >= name_table_max_load(name_table_capacity(table)) / 2)
+      n_groups <<= 1;
+    name_table_rehash(table, n_groups);
+    pos = name_table_find_free(table, hash);
+  }
+
+  if (table->ctrl[pos] == NAME_TABLE_CTRL_EMPTY) table->growth_left--;
+  table->ctrl[pos] = name_table_h2(hash);
+  table->slots[pos].name = *name;
+  table->slots[pos].value = value;
+  table->size++;
+}
+
+bool name_table_del(name_table_t *table, const hicn_name_t *name,
+                    uint32_t hash) {
+  assert(table);
+  assert(name);
+
+  ssize_t found = name_table_find(table, name, hash);
+  if (found < 0) return false;
+
+  /*
+   * A slot can be marked EMPTY again only if its group already has an EMPTY
+   * slot, as lookups would otherwise stop before reaching the next groups.
+   */
+  const int8_t *ctrl =
+      table->ctrl + (found & ~(NAME_TABLE_GROUP_WIDTH - 1));
+  if (name_table_group_match_empty(ctrl)) {
+    table->ctrl[found] = NAME_TABLE_CTRL_EMPTY;
+    table->growth_left++;
+  } else {
+    table->ctrl[found] = NAME_TABLE_CTRL_DELETED;
+  }
+  table->size--;
+  return true;
+}
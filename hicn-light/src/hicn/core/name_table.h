@@ -0,0 +1,117 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * \file name_table.h
+ * \brief Flat open-addressing table indexed by full hICN names
+ *
+ * The table maps a full name (prefix and suffix) to an unsigned value in a
+ * single level, following the layout of Swiss tables: slots are organized in
+ * groups of NAME_TABLE_GROUP_WIDTH, and each slot has a control byte which is
+ * either EMPTY, DELETED, or holds the 7 low bits of the name hash (H2). The
+ * remaining bits (H1) select the first group to probe. A lookup compares the
+ * control bytes of a whole group at once (with SSE2 when available), and only
+ * reads the slots whose control byte matches.
+ *
+ * Slots hold a copy of the name, so that a lookup touches the control bytes of
+ * the probed groups and the matching slot, and never the values themselves.
+ *
+ * The hash of a name must be computed with hicn_name_get_hash(). Callers
+ * usually have it at hand (see msgbuf_get_name_hash()), which allows to issue
+ * prefetches for a batch of names before looking them up.
+ */
+
+#ifndef HICNLIGHT_NAME_TABLE_H
+#define HICNLIGHT_NAME_TABLE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <hicn/name.h>
+
+#define NAME_TABLE_GROUP_WIDTH 16
+#define NAME_TABLE_INVALID_VALUE (~0u)
+
+typedef struct {
+  hicn_name_t name;
+  unsigned value;
+} name_table_slot_t;
+
+typedef struct {
+  int8_t *ctrl;
+  name_table_slot_t *slots;
+  size_t group_mask;  // Number of groups - 1, a power of two
+  size_t size;
+  // Number of EMPTY slots that can be used before the table is resized
+  size_t growth_left;
+} name_table_t;
+
+#define name_table_h1(hash) ((hash) >> 7)
+#define name_table_h2(hash) ((int8_t)((hash)&0x7f))
+
+/**
+ * @brief Create a name table able to hold init_size names before the first
+ * resize.
+ */
+name_table_t *name_table_create(size_t init_size);
+
+void name_table_free(name_table_t *table);
+
+/**
+ * @brief Remove all names, keeping the allocated memory.
+ */
+void name_table_clear(name_table_t *table);
+
+/**
+ * @brief Look up a name.
+ *
+ * @return unsigned The value associated to the name, or
+ * NAME_TABLE_INVALID_VALUE if not found
+ */
+unsigned name_table_get(const name_table_t *table, const hicn_name_t *name,
+                        uint32_t hash);
+
+/**
+ * @brief Associate a value to a name, replacing the previous one if the name
+ * is already present.
+ */
+void name_table_put(name_table_t *table, const hicn_name_t *name,
+                    uint32_t hash, unsigned value);
+
+/**
+ * @brief Remove a name.
+ *
+ * @return bool true if the name was present, false otherwise
+ */
+bool name_table_del(name_table_t *table, const hicn_name_t *name,
+                    uint32_t hash);
+
+static inline size_t name_table_size(const name_table_t *table) {
+  return table->size;
+}
+
+/**
+ * @brief Bring in cache the first group probed for a name hash, before the
+ * corresponding lookup.
+ */
+static inline void name_table_prefetch(const name_table_t *table,
+                                       uint32_t hash) {
+  size_t group = name_table_h1(hash) & table->group_mask;
+  __builtin_prefetch(table->ctrl + group * NAME_TABLE_GROUP_WIDTH);
+  __builtin_prefetch(table->slots + group * NAME_TABLE_GROUP_WIDTH);
+}
+
+#endif /* HICNLIGHT_NAME_TABLE_H */
@@ -21,6 +21,7 @@
 #include <hicn/util/hash.h>
 
 #include "nexthops.h"
+#include "rtt.h"
 
 int nexthops_disable(nexthops_t *nexthops, off_t offset) {
   if (offset >= nexthops->num_elts) return -1;
@@ -47,6 +48,7 @@ off_t nexthops_add(nexthops_t *nexthops, nexthop_t nexthop) {
   });
   id = nexthops->num_elts++;
   nexthops->elts[id] = nexthop;
+  nexthops->state[id].rtt = RTT_STATS_EMPTY;
   nexthops_reset(nexthops);
   return id;
 }
@@ -78,6 +80,12 @@ off_t nexthops_find(nexthops_t *nexthops, unsigned nexthop) {
   return INVALID_NEXTHOP;
 }
 
+off_t nexthops_find_any(nexthops_t *nexthops, unsigned nexthop) {
+  for (unsigned i = 0; i < nexthops_get_len(nexthops); i++)
+    if (nexthops->elts[i] == nexthop) return i;
+  return INVALID_NEXTHOP;
+}
+
 unsigned nexthops_get_one(nexthops_t *nexthops) {
   nexthops_foreach(nexthops, n, { return n; });
   return INVALID_NEXTHOP;
@@ -141,6 +141,12 @@ bool nexthops_contains(nexthops_t *nexthops, unsigned nexthop);
 
 off_t nexthops_find(nexthops_t *nexthops, unsigned nexthop);
 
+/*
+ * This finds an element irrespective of the current state of flags, eg. to
+ * update the state of a nexthop not selected by the last lookup.
+ */
+off_t nexthops_find_any(nexthops_t *nexthops, unsigned nexthop);
+
 unsigned nexthops_get_one(nexthops_t *nexthops);
 
 int nexthops_select(nexthops_t *nexthops, off_t i);
@@ -81,6 +81,23 @@ const char *_pkt_cache_verdict_str[] = {
  * Low-level operations on the hash table
  ******************************************************************************/
 
+#ifdef WITH_NAME_TABLE
+
+#define PKT_CACHE_INDEX_INIT_SIZE DEFAULT_PKT_CACHE_SIZE
+
+#define pkt_cache_name_hash(name) hicn_name_get_hash(name)
+
+/* The flat index needs no prefix information */
+void pkt_cache_save_suffixes_for_prefix(pkt_cache_t *pkt_cache,
+                                        const hicn_name_prefix_t *prefix) {}
+
+void pkt_cache_reset_suffixes_for_prefix(pkt_cache_t *pkt_cache) {}
+
+#else
+
+/* The two-level index hashes the prefix and the suffix separately */
+#define pkt_cache_name_hash(name) 0
+
 /**
  * Free the two level packet cache structure (helper)
  */
@@ -226,6 +243,106 @@ void pkt_cache_reset_suffixes_for_prefix(pkt_cache_t *pkt_cache) {
   pkt_cache->cached_suffixes = NULL;
 }
 
+#endif /* WITH_NAME_TABLE */
+
+/******************************************************************************
+ * Expiry timer wheel
+ ******************************************************************************/
+
+#define PKT_CACHE_WHEEL_MASK (PKT_CACHE_WHEEL_SIZE - 1)
+#define pkt_cache_wheel_slot_of(ts) ((ts) / PKT_CACHE_WHEEL_SLOT_TICKS)
+
+static void pkt_cache_wheel_initialize(pkt_cache_wheel_t *wheel) {
+  for (unsigned i = 0; i < PKT_CACHE_WHEEL_SIZE; i++)
+    wheel->slots[i] = INVALID_ENTRY_ID;
+  wheel->cursor = pkt_cache_wheel_slot_of(ticks_now());
+  wheel->n_kept = 0;
+  wheel->n_pit_expired = 0;
+  wheel->n_cs_expired = 0;
+}
+
+/**
+ * Unlink an entry from the timer wheel, before it is released or rescheduled
+ * (helper)
+ */
+static void pkt_cache_wheel_remove(pkt_cache_t *pkt_cache,
+                                   pkt_cache_entry_t *entry) {
+  pkt_cache_wheel_t *wheel = &pkt_cache->wheel;
+  if (entry->wheel_slot == PKT_CACHE_WHEEL_INVALID_SLOT) return;
+
+  if (entry->wheel_prev != INVALID_ENTRY_ID)
+    pkt_cache_entry_at(pkt_cache, entry->wheel_prev)->wheel_next =
+        entry->wheel_next;
+  else
+    wheel->slots[entry->wheel_slot] = entry->wheel_next;
+
+  if (entry->wheel_next != INVALID_ENTRY_ID)
+    pkt_cache_entry_at(pkt_cache, entry->wheel_next)->wheel_prev =
+        entry->wheel_prev;
+
+  entry->wheel_slot = PKT_CACHE_WHEEL_INVALID_SLOT;
+}
+
+/**
+ * Set the expiry time of an entry, and schedule it in the corresponding slot
+ * of the timer wheel (helper)
+ */
+static void pkt_cache_set_expire_ts(pkt_cache_t *pkt_cache,
+                                    pkt_cache_entry_t *entry,
+                                    Ticks expire_ts) {
+  pkt_cache_wheel_t *wheel = &pkt_cache->wheel;
+
+  pkt_cache_wheel_remove(pkt_cache, entry);
+  entry->expire_ts = expire_ts;
+  entry->has_expire_ts = true;
+
+  // Slots before the cursor have already been swept
+  Ticks slot = pkt_cache_wheel_slot_of(expire_ts);
+  if (slot < wheel->cursor) slot = wheel->cursor;
+
+  off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
+  entry->wheel_slot = slot & PKT_CACHE_WHEEL_MASK;
+  entry->wheel_prev = INVALID_ENTRY_ID;
+  entry->wheel_next = wheel->slots[entry->wheel_slot];
+  if (entry->wheel_next != INVALID_ENTRY_ID)
+    pkt_cache_entry_at(pkt_cache, entry->wheel_next)->wheel_prev = entry_id;
+  wheel->slots[entry->wheel_slot] = entry_id;
+}
+
+/**
+ * Count the expired entries not reclaimed yet, which can only be found in the
+ * slots between the cursor and the current time (helper)
+ */
+static void pkt_cache_count_stale_entries(pkt_cache_t *pkt_cache,
+                                          size_t *num_pit_stale_entries,
+                                          size_t *num_cs_stale_entries) {
+  pkt_cache_wheel_t *wheel = &pkt_cache->wheel;
+  Ticks now = ticks_now();
+  Ticks now_slot = pkt_cache_wheel_slot_of(now);
+
+  *num_pit_stale_entries = 0;
+  *num_cs_stale_entries = 0;
+  if (now_slot < wheel->cursor) return;
+
+  Ticks num_slots = now_slot - wheel->cursor + 1;
+  if (num_slots > PKT_CACHE_WHEEL_SIZE) num_slots = PKT_CACHE_WHEEL_SIZE;
+
+  for (Ticks i = 0; i < num_slots; i++) {
+    off_t entry_id =
+        wheel->slots[(wheel->cursor + i) & PKT_CACHE_WHEEL_MASK];
+    while (entry_id != INVALID_ENTRY_ID) {
+      pkt_cache_entry_t *entry = pkt_cache_entry_at(pkt_cache, entry_id);
+      if (now >= entry->expire_ts) {
+        if (entry->entry_type == PKT_CACHE_CS_TYPE)
+          (*num_cs_stale_entries)++;
+        else
+          (*num_pit_stale_entries)++;
+      }
+      entry_id = entry->wheel_next;
+    }
+  }
+}
+
 /******************************************************************************
  * Public API
  ******************************************************************************/
@@ -237,13 +354,21 @@ pkt_cache_t *pkt_cache_create(size_t cs_size) {
   if (!pkt_cache->pit) return NULL;
   pkt_cache->cs = cs_create(cs_size);
   if (!pkt_cache->cs) return NULL;
+  pkt_cache->cs_disk = NULL;
 
+#ifdef WITH_NAME_TABLE
+  pkt_cache->index = name_table_create(PKT_CACHE_INDEX_INIT_SIZE);
+  if (!pkt_cache->index) return NULL;
+#else
   pkt_cache->prefix_to_suffixes = kh_init_pkt_cache_prefix();
   pkt_cache->prefix_keys = slab_create(hicn_name_prefix_t, SLAB_INIT_SIZE);
-  pool_init(pkt_cache->entries, DEFAULT_PKT_CACHE_SIZE, 0);
 
   pkt_cache->cached_prefix = HICN_NAME_PREFIX_EMPTY;
   pkt_cache->cached_suffixes = NULL;
+#endif
+  pool_init(pkt_cache->entries, DEFAULT_PKT_CACHE_SIZE, 0);
+
+  pkt_cache_wheel_initialize(&pkt_cache->wheel);
 
   return pkt_cache;
 }
@@ -251,18 +376,24 @@ pkt_cache_t *pkt_cache_create(size_t cs_size) {
 void pkt_cache_free(pkt_cache_t *pkt_cache) {
   assert(pkt_cache);
 
-  // Free prefix hash table and pool
+  // Free index and pool
+#ifdef WITH_NAME_TABLE
+  name_table_free(pkt_cache->index);
+#else
   _prefix_map_free(pkt_cache->prefix_to_suffixes);
   slab_free(pkt_cache->prefix_keys);
+#endif
   pool_free(pkt_cache->entries);
 
   // Free PIT and CS
   pit_free(pkt_cache->pit);
   cs_free(pkt_cache->cs);
+  if (pkt_cache->cs_disk) cs_disk_free(pkt_cache->cs_disk);
 
   free(pkt_cache);
 }
 
+#ifndef WITH_NAME_TABLE
 kh_pkt_cache_suffix_t *pkt_cache_get_suffixes(const pkt_cache_t *pkt_cache,
                                               const hicn_name_prefix_t *prefix,
                                               bool create,
@@ -270,11 +401,13 @@ kh_pkt_cache_suffix_t *pkt_cache_get_suffixes(const pkt_cache_t *pkt_cache,
   return _get_suffixes(pkt_cache->prefix_to_suffixes, prefix, create,
                        prefix_keys);
 }
+#endif
 
 pkt_cache_entry_t *pkt_cache_allocate(pkt_cache_t *pkt_cache) {
   pkt_cache_entry_t *entry = NULL;
   pool_get(pkt_cache->entries, entry);
   assert(entry);
+  entry->wheel_slot = PKT_CACHE_WHEEL_INVALID_SLOT;
   return entry;
 }
 
@@ -287,6 +420,10 @@ void pkt_cache_add_to_index(const pkt_cache_t *pkt_cache,
    */
   const hicn_name_t *name = &entry->name;
 
+#ifdef WITH_NAME_TABLE
+  name_table_put(pkt_cache->index, name, pkt_cache_name_hash(name),
+                 (unsigned int)id);
+#else
   if (pkt_cache->cached_suffixes) {
     __add_suffix(pkt_cache->cached_suffixes, hicn_name_get_suffix(name),
                  (unsigned int)id);
@@ -295,6 +432,7 @@ void pkt_cache_add_to_index(const pkt_cache_t *pkt_cache,
                 hicn_name_get_suffix(name), (unsigned int)id,
                 pkt_cache->prefix_keys);
   }
+#endif
 }
 
 /**
@@ -302,14 +440,14 @@ void pkt_cache_add_to_index(const pkt_cache_t *pkt_cache,
  */
 void pkt_cache_remove_from_index(const pkt_cache_t *pkt_cache,
                                  const hicn_name_t *name) {
+#ifdef WITH_NAME_TABLE
+  bool found =
+      name_table_del(pkt_cache->index, name, pkt_cache_name_hash(name));
+  assert(found);
+  _unused(found);
+#else
   _remove_suffix(pkt_cache->prefix_to_suffixes, hicn_name_get_prefix(name),
                  hicn_name_get_suffix(name), pkt_cache->prefix_keys);
-
-// TODO
-#if 0
-  khiter_t k = kh_get_pkt_cache_name(pkt_cache->index_by_name, name);
-  assert(k != kh_end(pkt_cache->index_by_name));
-  kh_del(pkt_cache_name, pkt_cache->index_by_name, k);
 #endif
 }
 
@@ -317,12 +455,19 @@ pit_t *pkt_cache_get_pit(pkt_cache_t *pkt_cache) { return pkt_cache->pit; }
 
 cs_t *pkt_cache_get_cs(pkt_cache_t *pkt_cache) { return pkt_cache->cs; }
 
-pkt_cache_entry_t *pkt_cache_lookup(pkt_cache_t *pkt_cache,
-                                    const hicn_name_t *name,
-                                    msgbuf_pool_t *msgbuf_pool,
-                                    pkt_cache_lookup_t *lookup_result,
-                                    off_t *entry_id,
-                                    bool is_serve_from_cs_enabled) {
+/**
+ * Lookup with the hash of the name computed by the caller, eg. taken from the
+ * msgbuf (helper)
+ */
+static pkt_cache_entry_t *_pkt_cache_lookup(pkt_cache_t *pkt_cache,
+                                            const hicn_name_t *name,
+                                            u32 name_hash,
+                                            pkt_cache_lookup_t *lookup_result,
+                                            off_t *entry_id) {
+#ifdef WITH_NAME_TABLE
+  unsigned index = name_table_get(pkt_cache->index, name, name_hash);
+  if (index == NAME_TABLE_INVALID_VALUE) index = HICN_INVALID_SUFFIX;
+#else
   unsigned index = HICN_INVALID_SUFFIX;
   if (pkt_cache->cached_suffixes) {
     index =
@@ -331,6 +476,7 @@ pkt_cache_entry_t *pkt_cache_lookup(pkt_cache_t *pkt_cache,
     index = _get_suffix_from_name(pkt_cache->prefix_to_suffixes, name,
                                   pkt_cache->prefix_keys);
   }
+#endif
 
   if (index == HICN_INVALID_SUFFIX) {
     *lookup_result = PKT_CACHE_LU_NONE;
@@ -360,6 +506,45 @@ pkt_cache_entry_t *pkt_cache_lookup(pkt_cache_t *pkt_cache,
   return entry;
 }
 
+pkt_cache_entry_t *pkt_cache_lookup(pkt_cache_t *pkt_cache,
+                                    const hicn_name_t *name,
+                                    msgbuf_pool_t *msgbuf_pool,
+                                    pkt_cache_lookup_t *lookup_result,
+                                    off_t *entry_id,
+                                    bool is_serve_from_cs_enabled) {
+  return _pkt_cache_lookup(pkt_cache, name, pkt_cache_name_hash(name),
+                           lookup_result, entry_id);
+}
+
+void pkt_cache_prefetch(const pkt_cache_t *pkt_cache,
+                        const msgbuf_pool_t *msgbuf_pool,
+                        const off_t *msgbuf_ids, size_t n) {
+#ifdef WITH_NAME_TABLE
+  for (size_t i = 0; i < n; i++) {
+    const msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_ids[i]);
+    name_table_prefetch(pkt_cache->index, msgbuf_get_name_hash(msgbuf));
+  }
+#endif
+}
+
+void pkt_cache_prefetch_names(const pkt_cache_t *pkt_cache,
+                              const hicn_name_t *names, size_t n) {
+#ifdef WITH_NAME_TABLE
+  for (size_t i = 0; i < n; i++)
+    name_table_prefetch(pkt_cache->index, pkt_cache_name_hash(&names[i]));
+#else
+  /* Suffixes are hashed with the identity function in the second level */
+  const kh_pkt_cache_suffix_t *suffixes = pkt_cache->cached_suffixes;
+  if (!suffixes || suffixes->n_buckets == 0) return;
+  for (size_t i = 0; i < n; i++) {
+    khint_t k = hicn_name_get_suffix(&names[i]) & (suffixes->n_buckets - 1);
+    __builtin_prefetch(&suffixes->flags[k >> 4]);
+    __builtin_prefetch(&suffixes->keys[k]);
+    __builtin_prefetch(&suffixes->vals[k]);
+  }
+#endif
+}
+
 void pkt_cache_cs_remove_entry(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
                                msgbuf_pool_t *msgbuf_pool, bool is_evicted) {
   assert(pkt_cache);
@@ -369,14 +554,12 @@ void pkt_cache_cs_remove_entry(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
   off_t msgbuf_id = entry->u.cs_entry.msgbuf_id;
   msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
 
-  // XXX const hicn_name_t *name = msgbuf_get_name(msgbuf);
-  _remove_suffix(pkt_cache->prefix_to_suffixes,
-                 hicn_name_get_prefix(&entry->name),
-                 hicn_name_get_suffix(&entry->name), pkt_cache->prefix_keys);
+  pkt_cache_remove_from_index(pkt_cache, &entry->name);
 
   // Do not update the LRU cache for evicted entries
   if (!is_evicted) cs_vft[pkt_cache->cs->type]->remove_entry(pkt_cache, entry);
 
+  pkt_cache_wheel_remove(pkt_cache, entry);
   pkt_cache->cs->num_entries--;
   pool_put(pkt_cache->entries, entry);
 
@@ -398,9 +581,9 @@ void pkt_cache_pit_remove_entry(pkt_cache_t *pkt_cache,
   assert(entry->entry_type == PKT_CACHE_PIT_TYPE);
 
   const hicn_name_t *name = &entry->name;
-  _remove_suffix(pkt_cache->prefix_to_suffixes, hicn_name_get_prefix(name),
-                 hicn_name_get_suffix(name), pkt_cache->prefix_keys);
+  pkt_cache_remove_from_index(pkt_cache, name);
 
+  pkt_cache_wheel_remove(pkt_cache, entry);
   pool_put(pkt_cache->entries, entry);
 
   WITH_DEBUG({
@@ -412,7 +595,11 @@ void pkt_cache_pit_remove_entry(pkt_cache_t *pkt_cache,
   })
 }
 
-void _pkt_cache_add_to_cs(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
+/**
+ * Return false if the data packet is not admitted by the content store
+ * policy, in which case the entry is removed from the packet cache.
+ */
+bool _pkt_cache_add_to_cs(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
                           msgbuf_pool_t *msgbuf_pool, msgbuf_t *msgbuf,
                           off_t msgbuf_id, off_t entry_id) {
   entry->u.cs_entry =
@@ -420,23 +607,40 @@ void _pkt_cache_add_to_cs(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
                    .lru = {.prev = INVALID_ENTRY_ID, .next = INVALID_ENTRY_ID}};
   Ticks now = ticks_now();
   entry->create_ts = now;
-  entry->expire_ts = now + msgbuf_get_data_expiry_time(msgbuf);
-  entry->has_expire_ts = true;
+  pkt_cache_set_expire_ts(pkt_cache, entry,
+                          now + msgbuf_get_data_expiry_time(msgbuf));
   entry->entry_type = PKT_CACHE_CS_TYPE;
 
   pkt_cache->cs->num_entries++;
 
-  int tail_id = (int)(pkt_cache->cs->lru.tail);
   int result = cs_vft[pkt_cache->cs->type]->add_entry(pkt_cache, entry_id);
   if (result == LRU_EVICTION) {
-    // Remove tail (already removed from LRU cache)
-    pkt_cache_entry_t *tail = pkt_cache_entry_at(pkt_cache, tail_id);
-    assert(tail->entry_type == PKT_CACHE_CS_TYPE);
-    pkt_cache_cs_remove_entry(pkt_cache, tail, msgbuf_pool, true);
+    // Evicted entry (already removed from the policy state)
+    off_t evicted_id = pkt_cache->cs->evicted;
+    pkt_cache_entry_t *evicted = pkt_cache_entry_at(pkt_cache, evicted_id);
+    assert(evicted->entry_type == PKT_CACHE_CS_TYPE);
+
+    if (evicted_id == entry_id) {
+      // Not admitted, the data packet has not been acquired yet
+      pkt_cache_remove_from_index(pkt_cache, &entry->name);
+      pkt_cache_wheel_remove(pkt_cache, entry);
+      pkt_cache->cs->num_entries--;
+      pool_put(pkt_cache->entries, entry);
+      return false;
+    }
+
+    // Move still valid data to the disk tier
+    if (pkt_cache->cs_disk && now < evicted->expire_ts) {
+      msgbuf_t *evicted_msgbuf =
+          msgbuf_pool_at(msgbuf_pool, evicted->u.cs_entry.msgbuf_id);
+      cs_disk_store(pkt_cache->cs_disk, evicted_msgbuf, evicted->expire_ts);
+    }
+    pkt_cache_cs_remove_entry(pkt_cache, evicted, msgbuf_pool, true);
   }
 
   // Acquired by CS
   msgbuf_pool_acquire(msgbuf);
+  return true;
 }
 
 void pkt_cache_pit_to_cs(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
@@ -460,12 +664,15 @@ void _pkt_cache_add_to_pit(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
       .ingressIdSet = NEXTHOPS_EMPTY,
       .egressIdSet = NEXTHOPS_EMPTY,
       .fib_entry = NULL,
+      .send_ts = 0,
+      .retransmitted = false,
   };
   pit_entry_ingress_add(&entry->u.pit_entry, msgbuf_get_connection_id(msgbuf));
 
   entry->create_ts = ticks_now();
-  entry->expire_ts = ticks_now() + msgbuf_get_interest_lifetime(msgbuf);
-  entry->has_expire_ts = true;
+  pkt_cache_set_expire_ts(pkt_cache, entry,
+                          entry->create_ts +
+                              msgbuf_get_interest_lifetime(msgbuf));
   entry->entry_type = PKT_CACHE_PIT_TYPE;
 }
 
@@ -501,8 +708,9 @@ void pkt_cache_update_cs(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
 
   entry->u.cs_entry.msgbuf_id = msgbuf_id;
   entry->create_ts = ticks_now();
-  entry->expire_ts = ticks_now() + msgbuf_get_data_expiry_time(msgbuf);
-  entry->has_expire_ts = true;
+  pkt_cache_set_expire_ts(pkt_cache, entry,
+                          entry->create_ts +
+                              msgbuf_get_data_expiry_time(msgbuf));
 
   cs_vft[pkt_cache->cs->type]->update_entry(pkt_cache, entry);
 }
@@ -528,9 +736,10 @@ pkt_cache_entry_t *pkt_cache_add_to_cs(pkt_cache_t *pkt_cache,
   const hicn_name_t *name = msgbuf_get_name(msgbuf);
   entry->name = *name;
   off_t entry_id = pkt_cache_get_entry_id(pkt_cache, entry);
-  _pkt_cache_add_to_cs(pkt_cache, entry, msgbuf_pool, msgbuf, msgbuf_id,
-                       entry_id);
   pkt_cache_add_to_index(pkt_cache, entry);
+  if (!_pkt_cache_add_to_cs(pkt_cache, entry, msgbuf_pool, msgbuf, msgbuf_id,
+                            entry_id))
+    return NULL;
   return entry;
 }
 
@@ -560,7 +769,8 @@ bool pkt_cache_try_aggregate_in_pit(pkt_cache_t *pkt_cache,
 
   // Extend entry lifetime
   Ticks expire_ts = ticks_now() + msgbuf_get_interest_lifetime(msgbuf);
-  if (expire_ts > entry->expire_ts) entry->expire_ts = expire_ts;
+  if (expire_ts > entry->expire_ts)
+    pkt_cache_set_expire_ts(pkt_cache, entry, expire_ts);
 
   // Check if the reverse path is already present
   // in the PIT entry (i.e. it is a retransmission)
@@ -643,8 +853,8 @@ nexthops_t *pkt_cache_on_data(pkt_cache_t *pkt_cache,
   off_t entry_id;
   pkt_cache_lookup_t lookup_result;
   pkt_cache_entry_t *entry =
-      pkt_cache_lookup(pkt_cache, msgbuf_get_name(msgbuf), msgbuf_pool,
-                       &lookup_result, &entry_id, true);
+      _pkt_cache_lookup(pkt_cache, msgbuf_get_name(msgbuf),
+                        msgbuf_get_name_hash(msgbuf), &lookup_result, &entry_id);
 
   pit_entry_t *pit_entry;
   fib_entry_t *fib_entry;
@@ -654,9 +864,13 @@ nexthops_t *pkt_cache_on_data(pkt_cache_t *pkt_cache,
     case PKT_CACHE_LU_INTEREST_NOT_EXPIRED:
       pit_entry = &entry->u.pit_entry;
       fib_entry = pit_entry_get_fib_entry(pit_entry);
-      if (fib_entry)
+      if (fib_entry) {
+        Usecs rtt;
+        if (pit_entry_get_rtt(pit_entry, msgbuf, &rtt))
+          fib_entry_on_rtt(fib_entry, msgbuf_get_connection_id(msgbuf), rtt);
         fib_entry_on_data(fib_entry, pit_entry_get_egress(pit_entry), msgbuf,
                           entry->create_ts, ticks_now());
+      }
 
       // Check if the data is coming from the exepected connection
       nexthops_t *egressIdSet = pit_entry_get_egress(pit_entry);
@@ -732,6 +946,34 @@ nexthops_t *pkt_cache_on_data(pkt_cache_t *pkt_cache,
   }
 }
 
+/**
+ * Move a data packet from the disk tier back to the CS (helper)
+ */
+static pkt_cache_entry_t *pkt_cache_promote_from_disk(
+    pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
+    const hicn_name_t *name, off_t *data_msgbuf_id) {
+  Ticks expire_ts;
+  off_t msgbuf_id =
+      cs_disk_load(pkt_cache->cs_disk, name, msgbuf_pool, &expire_ts);
+  if (!msgbuf_id_is_valid(msgbuf_id)) return NULL;
+
+  msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+  pkt_cache_entry_t *entry =
+      pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf, msgbuf_id);
+  if (!entry) {
+    // The packet stays on disk
+    msgbuf_pool_put(msgbuf_pool, msgbuf);
+    return NULL;
+  }
+  cs_disk_remove(pkt_cache->cs_disk, name);
+
+  // Keep the expiry time of the original entry
+  pkt_cache_set_expire_ts(pkt_cache, entry, expire_ts);
+
+  *data_msgbuf_id = msgbuf_id;
+  return entry;
+}
+
 void pkt_cache_on_interest(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
                            off_t msgbuf_id, pkt_cache_verdict_t *verdict,
                            off_t *data_msgbuf_id, pkt_cache_entry_t **entry_ptr,
@@ -745,9 +987,11 @@ void pkt_cache_on_interest(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
 
   off_t entry_id;
   pkt_cache_lookup_t lookup_result;
+  // Interests from a manifest do not carry the name of the msgbuf
+  u32 name_hash = name == msgbuf_get_name(msgbuf) ? msgbuf_get_name_hash(msgbuf)
+                                                  : pkt_cache_name_hash(name);
   pkt_cache_entry_t *entry =
-      pkt_cache_lookup(pkt_cache, name, msgbuf_pool, &lookup_result, &entry_id,
-                       is_serve_from_cs_enabled);
+      _pkt_cache_lookup(pkt_cache, name, name_hash, &lookup_result, &entry_id);
   *entry_ptr = entry;
 
   cs_entry_t *cs_entry = NULL;
@@ -755,6 +999,18 @@ void pkt_cache_on_interest(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
   bool is_aggregated;
   switch (lookup_result) {
     case PKT_CACHE_LU_NONE:
+      if (pkt_cache->cs_disk && is_serve_from_cs_enabled) {
+        entry = pkt_cache_promote_from_disk(pkt_cache, msgbuf_pool, name,
+                                            data_msgbuf_id);
+        if (entry) {
+          *entry_ptr = entry;
+
+          *verdict = PKT_CACHE_VERDICT_FORWARD_DATA;
+          is_cs_miss = false;
+          break;
+        }
+      }
+
       entry = pkt_cache_add_to_pit(pkt_cache, msgbuf, name);
       *entry_ptr = entry;
 
@@ -766,6 +1022,7 @@ void pkt_cache_on_interest(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
 
       cs_entry = &entry->u.cs_entry;
       *data_msgbuf_id = cs_entry->msgbuf_id;
+      cs_vft[pkt_cache->cs->type]->hit_entry(pkt_cache, entry);
 
       *verdict = PKT_CACHE_VERDICT_FORWARD_DATA;
       is_cs_miss = false;
@@ -796,12 +1053,28 @@ void pkt_cache_on_interest(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
     default:
       *verdict = PKT_CACHE_VERDICT_ERROR;
   }
-  is_cs_miss ? cs_miss(pkt_cache->cs) : cs_hit(pkt_cache->cs);
+  if (is_cs_miss) {
+    cs_vft[pkt_cache->cs->type]->miss(pkt_cache, name);
+    cs_miss(pkt_cache->cs);
+  } else {
+    cs_hit(pkt_cache->cs);
+  }
 }
 
 void pkt_cache_cs_clear(pkt_cache_t *pkt_cache) {
   assert(pkt_cache);
 
+#ifdef WITH_NAME_TABLE
+  pkt_cache_entry_t *entry;
+  pool_foreach(pkt_cache->entries, entry, {
+    if (entry->entry_type == PKT_CACHE_CS_TYPE) {
+      // Remove from index, timer wheel and pool
+      pkt_cache_remove_from_index(pkt_cache, &entry->name);
+      pkt_cache_wheel_remove(pkt_cache, entry);
+      pool_put(pkt_cache->entries, entry);
+    }
+  });
+#else
   kh_pkt_cache_suffix_t *v_suffixes;
   u32 k_suffix;
   u32 v_pkt_cache_entry_id;
@@ -814,7 +1087,8 @@ void pkt_cache_cs_clear(pkt_cache_t *pkt_cache) {
         assert(k != kh_end(v_suffixes));
         kh_del_pkt_cache_suffix(v_suffixes, k);
 
-        // Remove from pool
+        // Remove from timer wheel and pool
+        pkt_cache_wheel_remove(pkt_cache, entry);
         pool_put(pkt_cache->entries, entry);
       }
     });
@@ -823,24 +1097,103 @@ void pkt_cache_cs_clear(pkt_cache_t *pkt_cache) {
   // Reset cached prefix
   pkt_cache->cached_prefix = HICN_NAME_PREFIX_EMPTY;
   pkt_cache->cached_suffixes = NULL;
+#endif
 
   // Re-create CS
   cs_clear(pkt_cache->cs);
+  if (pkt_cache->cs_disk) cs_disk_clear(pkt_cache->cs_disk);
 }
 
 size_t pkt_cache_get_num_cs_stale_entries(pkt_cache_t *pkt_cache) {
-  size_t num_stale_entries = 0;
-  Ticks now = ticks_now();
-  pkt_cache_entry_t *entry;
+  size_t num_pit_stale_entries, num_cs_stale_entries;
+  pkt_cache_count_stale_entries(pkt_cache, &num_pit_stale_entries,
+                                &num_cs_stale_entries);
+  return num_cs_stale_entries;
+}
 
-  pool_foreach(pkt_cache->entries, entry, {
-    if (entry->entry_type == PKT_CACHE_CS_TYPE && entry->has_expire_ts &&
-        now >= entry->expire_ts) {
-      num_stale_entries++;
+size_t pkt_cache_get_num_pit_stale_entries(pkt_cache_t *pkt_cache) {
+  size_t num_pit_stale_entries, num_cs_stale_entries;
+  pkt_cache_count_stale_entries(pkt_cache, &num_pit_stale_entries,
+                                &num_cs_stale_entries);
+  return num_pit_stale_entries;
+}
+
+/**
+ * Reclaim an expired entry (helper)
+ */
+static void pkt_cache_expire_entry(pkt_cache_t *pkt_cache,
+                                   msgbuf_pool_t *msgbuf_pool,
+                                   pkt_cache_entry_t *entry,
+                                   size_t *n_pit_expired,
+                                   size_t *n_cs_expired) {
+  if (entry->entry_type == PKT_CACHE_CS_TYPE) {
+    pkt_cache_cs_remove_entry(pkt_cache, entry, msgbuf_pool, false);
+    pkt_cache->wheel.n_cs_expired++;
+    (*n_cs_expired)++;
+    return;
+  }
+
+  pit_entry_t *pit_entry = &entry->u.pit_entry;
+  fib_entry_t *fib_entry = pit_entry_get_fib_entry(pit_entry);
+  if (fib_entry)
+    fib_entry_on_timeout(fib_entry, pit_entry_get_egress(pit_entry));
+
+  pkt_cache_pit_remove_entry(pkt_cache, entry);
+  pkt_cache->wheel.n_pit_expired++;
+  (*n_pit_expired)++;
+}
+
+bool pkt_cache_sweep(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
+                     Ticks now, unsigned budget, size_t *n_pit_expired,
+                     size_t *n_cs_expired) {
+  assert(pkt_cache);
+  assert(n_pit_expired);
+  assert(n_cs_expired);
+
+  pkt_cache_wheel_t *wheel = &pkt_cache->wheel;
+  Ticks now_slot = pkt_cache_wheel_slot_of(now);
+  *n_pit_expired = 0;
+  *n_cs_expired = 0;
+
+  // A single revolution visits all the slots
+  if (now_slot > wheel->cursor + PKT_CACHE_WHEEL_SIZE) {
+    wheel->cursor = now_slot - PKT_CACHE_WHEEL_SIZE;
+    wheel->n_kept = 0;
+  }
+
+  // Only slots in the past are swept, all their entries of the current
+  // revolution are thus expired
+  unsigned visited = 0;
+  while (wheel->cursor < now_slot) {
+    // Entries kept by a previous slice have already been accounted for
+    unsigned n_skipped = 0;
+    off_t entry_id = wheel->slots[wheel->cursor & PKT_CACHE_WHEEL_MASK];
+    while (entry_id != INVALID_ENTRY_ID) {
+      pkt_cache_entry_t *entry = pkt_cache_entry_at(pkt_cache, entry_id);
+      bool is_expired = now >= entry->expire_ts;
+      if (!is_expired && n_skipped < wheel->n_kept) {
+        n_skipped++;
+        entry_id = entry->wheel_next;
+        continue;
+      }
+
+      if (visited == budget) return false;
+      visited++;
+
+      entry_id = entry->wheel_next;
+      if (is_expired) {
+        pkt_cache_expire_entry(pkt_cache, msgbuf_pool, entry, n_pit_expired,
+                               n_cs_expired);
+      } else {
+        wheel->n_kept++;
+      }
     }
-  });
 
-  return num_stale_entries;
+    wheel->n_kept = 0;
+    wheel->cursor++;
+  }
+
+  return true;
 }
 
 int pkt_cache_set_cs_size(pkt_cache_t *pkt_cache, size_t size) {
@@ -850,6 +1203,37 @@ int pkt_cache_set_cs_size(pkt_cache_t *pkt_cache, size_t size) {
   return 0;
 }
 
+int pkt_cache_set_cs_type(pkt_cache_t *pkt_cache, cs_type_t type) {
+  if (!CS_TYPE_VALID(type)) return -1;
+  if (pkt_cache->cs->type == type) return 0;
+
+  // Entries are linked through the state of the previous policy
+  pkt_cache_cs_clear(pkt_cache);
+
+  cs_t *cs = _cs_create(type, pkt_cache->cs->max_size);
+  if (!cs) return -1;
+  cs_free(pkt_cache->cs);
+  pkt_cache->cs = cs;
+  return 0;
+}
+
+cs_type_t pkt_cache_get_cs_type(pkt_cache_t *pkt_cache) {
+  return pkt_cache->cs->type;
+}
+
+int pkt_cache_set_cs_disk(pkt_cache_t *pkt_cache, const char *path,
+                          size_t max_size) {
+  assert(!pkt_cache->cs_disk);
+
+  pkt_cache->cs_disk = cs_disk_create(path, max_size);
+  return pkt_cache->cs_disk ? 0 : -1;
+}
+
+size_t pkt_cache_get_cs_disk_size(pkt_cache_t *pkt_cache) {
+  if (!pkt_cache->cs_disk) return 0;
+  return cs_disk_get_num_entries(pkt_cache->cs_disk);
+}
+
 size_t pkt_cache_get_size(pkt_cache_t *pkt_cache) {
   return pool_len(pkt_cache->entries);
 }
@@ -870,6 +1254,16 @@ void pkt_cache_log(pkt_cache_t *pkt_cache) {
         pkt_cache_get_cs_size(pkt_cache));
 
   cs_log(pkt_cache->cs);
+
+  if (pkt_cache->cs_disk) {
+    cs_disk_stats_t disk_stats = cs_disk_get_stats(pkt_cache->cs_disk);
+    DEBUG(
+        "Disk content store: size = %lu, hits = %lu, misses = %lu, "
+        "promotions = %lu, demotions = %lu, drops = %lu",
+        pkt_cache_get_cs_disk_size(pkt_cache), disk_stats.countHits,
+        disk_stats.countMisses, disk_stats.countPromotions,
+        disk_stats.countDemotions, disk_stats.countDrops);
+  }
 }
 
 pkt_cache_stats_t pkt_cache_get_stats(pkt_cache_t *pkt_cache) {
@@ -878,7 +1272,24 @@ pkt_cache_stats_t pkt_cache_get_stats(pkt_cache_t *pkt_cache) {
       .n_pit_entries = (uint32_t)pkt_cache_get_pit_size(pkt_cache),
       .n_cs_entries = (uint32_t)pkt_cache_get_cs_size(pkt_cache),
       .n_lru_evictions = (uint32_t)lru_stats.countLruEvictions,
+      .n_pit_expired = (uint32_t)pkt_cache->wheel.n_pit_expired,
+      .n_cs_expired = (uint32_t)pkt_cache->wheel.n_cs_expired,
   };
 
+  size_t num_pit_stale_entries, num_cs_stale_entries;
+  pkt_cache_count_stale_entries(pkt_cache, &num_pit_stale_entries,
+                                &num_cs_stale_entries);
+  stats.n_pit_stale_entries = (uint32_t)num_pit_stale_entries;
+  stats.n_cs_stale_entries = (uint32_t)num_cs_stale_entries;
+
+  if (pkt_cache->cs_disk) {
+    cs_disk_stats_t disk_stats = cs_disk_get_stats(pkt_cache->cs_disk);
+    stats.n_cs_disk_entries = (uint32_t)pkt_cache_get_cs_disk_size(pkt_cache);
+    stats.n_cs_disk_hits = (uint32_t)disk_stats.countHits;
+    stats.n_cs_disk_misses = (uint32_t)disk_stats.countMisses;
+    stats.n_cs_disk_promotions = (uint32_t)disk_stats.countPromotions;
+    stats.n_cs_disk_demotions = (uint32_t)disk_stats.countDemotions;
+  }
+
   return stats;
 }
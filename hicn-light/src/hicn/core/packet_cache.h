@@ -35,6 +35,11 @@
  * When an interest/data packet is received, the prefix and the associated
  * suffixes are saved; if the next packet cache operation involves the same
  * prefix, no additional lookups in the prefix hash hashtable are needed.
+ *
+ * When built with WITH_NAME_TABLE, the two-level hash table is replaced by a
+ * single flat table indexed by the full name (see name_table.h), which avoids
+ * the pointer chasing between the two levels and allows to prefetch the index
+ * for a batch of packets. The saved prefix information is then unused.
  */
 
 #ifndef HICNLIGHT_PACKET_CACHE_H
@@ -45,10 +50,26 @@
 #include "content_store.h"
 #include "pit.h"
 #include "msgbuf_pool.h"
+#include "name_table.h"
+#include "../content_store/disk.h"
 #include "../content_store/lru.h"
 
 #define DEFAULT_PKT_CACHE_SIZE 2048
 
+/*
+ * Expired entries are bucketed by expiry time in a timer wheel of
+ * PKT_CACHE_WHEEL_SIZE slots, each covering PKT_CACHE_WHEEL_SLOT_TICKS. Entries
+ * expiring after a full revolution share the slots and are skipped until they
+ * expire.
+ */
+#define PKT_CACHE_WHEEL_SIZE 1024 /* Power of two */
+#define PKT_CACHE_WHEEL_SLOT_TICKS 16 /* ms */
+#define PKT_CACHE_WHEEL_INVALID_SLOT UINT32_MAX
+
+/* Period of the sweep, and maximum number of entries visited per slice */
+#define PKT_CACHE_SWEEP_INTERVAL 100 /* ms */
+#define PKT_CACHE_SWEEP_BUDGET 256
+
 typedef enum { PKT_CACHE_PIT_TYPE, PKT_CACHE_CS_TYPE } pkt_cache_entry_type_t;
 
 #define foreach_kh_verdict             \
@@ -102,16 +123,41 @@ typedef struct {
   // Now it is always set to true
   bool has_expire_ts;
 
+  /* Linkage in the expiry timer wheel */
+  uint32_t wheel_slot;
+  off_t wheel_prev;
+  off_t wheel_next;
+
   union {
     pit_entry_t pit_entry;
     cs_entry_t cs_entry;
   } u;
 } pkt_cache_entry_t;
 
+typedef struct {
+  off_t slots[PKT_CACHE_WHEEL_SIZE];
+
+  /*
+   * All entries expiring before this slot (in slot units) have been
+   * reclaimed. A sweep interrupted in the middle of the slot resumes from its
+   * head, as entries may have been added or removed in the meantime, and
+   * skips the 'n_kept' entries found not to be expired yet.
+   */
+  Ticks cursor;
+  unsigned n_kept;
+
+  uint64_t n_pit_expired;
+  uint64_t n_cs_expired;
+} pkt_cache_wheel_t;
+
 typedef struct {
   pit_t *pit;
   cs_t *cs;
+  cs_disk_t *cs_disk;  // NULL if the disk tier is disabled
   pkt_cache_entry_t *entries;
+#ifdef WITH_NAME_TABLE
+  name_table_t *index;
+#else
   kh_pkt_cache_prefix_t *prefix_to_suffixes;
   slab_t *prefix_keys;
 
@@ -119,6 +165,9 @@ typedef struct {
   // used for both single interest speculation and interest manifest
   hicn_name_prefix_t cached_prefix;
   kh_pkt_cache_suffix_t *cached_suffixes;
+#endif
+
+  pkt_cache_wheel_t wheel;
 } pkt_cache_t;
 
 /**
@@ -180,6 +229,25 @@ pit_t *pkt_cache_get_pit(pkt_cache_t *pkt_cache);
  */
 cs_t *pkt_cache_get_cs(pkt_cache_t *pkt_cache);
 
+/**
+ * @brief Add a disk tier to the content store: entries evicted from the LRU
+ * are moved to disk, and moved back to the CS upon a matching interest.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in] path File backing the disk tier
+ * @param[in] max_size Size of the file, in bytes
+ * @return int 0 if success, -1 otherwise
+ */
+int pkt_cache_set_cs_disk(pkt_cache_t *pkt_cache, const char *path,
+                          size_t max_size);
+
+/**
+ * @brief Return the number of entries in the disk tier of the CS.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ */
+size_t pkt_cache_get_cs_disk_size(pkt_cache_t *pkt_cache);
+
 /**
  * @brief Return the total packet cache size (i.e. PIT + CS).
  *
@@ -194,6 +262,30 @@ size_t pkt_cache_get_size(pkt_cache_t *pkt_cache);
  */
 size_t pkt_cache_get_num_cs_stale_entries(pkt_cache_t *pkt_cache);
 
+/**
+ * @brief Return the number of stale entries (i.e. expired) in the PIT.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ */
+size_t pkt_cache_get_num_pit_stale_entries(pkt_cache_t *pkt_cache);
+
+/**
+ * @brief Reclaim expired PIT and CS entries, in expiry order. Expired PIT
+ * entries are reported as timeouts to the strategy of their FIB entry.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in] msgbuf_pool Pointer to the msgbuf pool data structure to use
+ * @param[in] now Current time
+ * @param[in] budget Maximum number of entries to visit
+ * @param[out] n_pit_expired Number of PIT entries reclaimed
+ * @param[out] n_cs_expired Number of CS entries reclaimed
+ * @return bool true if all expired entries have been reclaimed, false if the
+ * budget has been exhausted before
+ */
+bool pkt_cache_sweep(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
+                     Ticks now, unsigned budget, size_t *n_pit_expired,
+                     size_t *n_cs_expired);
+
 /**
  * @brief Change the maximum capacity of the content store (LRU eviction will
  * be used after reaching the provided size)
@@ -205,6 +297,23 @@ size_t pkt_cache_get_num_cs_stale_entries(pkt_cache_t *pkt_cache);
  */
 int pkt_cache_set_cs_size(pkt_cache_t *pkt_cache, size_t size);
 
+/**
+ * @brief Change the eviction and admission policy of the content store. The
+ * content store is cleared if the policy changes.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in] type Content store type (e.g. CS_TYPE_S3FIFO)
+ * @return int 0 if success, -1 otherwise
+ */
+int pkt_cache_set_cs_type(pkt_cache_t *pkt_cache, cs_type_t type);
+
+/**
+ * @brief Return the eviction and admission policy of the content store.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ */
+cs_type_t pkt_cache_get_cs_type(pkt_cache_t *pkt_cache);
+
 /**
  * @brief Return the content store size.
  *
@@ -303,6 +412,9 @@ void pkt_cache_pit_remove_entry(pkt_cache_t *pkt_cache,
  * the CS entry to insert
  * @param[in] entry_id Entry ID (i.e. ID in the packet cache pool of entries)
  * associated with the PIT entry to replace
+ *
+ * NOTE: the entry is removed from the packet cache if the content store
+ * policy does not admit the data packet.
  */
 void pkt_cache_pit_to_cs(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry,
                          msgbuf_pool_t *msgbuf_pool, msgbuf_t *msgbuf,
@@ -347,7 +459,8 @@ pkt_cache_entry_t *pkt_cache_add_to_pit(pkt_cache_t *pkt_cache,
  * insert
  * @param[in] msgbuf_id Msgbuf ID (i.e. ID in the msgbuf pool) associated with
  * the CS entry to insert
- * @return pkt_cache_entry_t* Pointer to the packet cache (CS) entry created
+ * @return pkt_cache_entry_t* Pointer to the packet cache (CS) entry created,
+ * NULL if the content store policy did not admit the data packet
  */
 pkt_cache_entry_t *pkt_cache_add_to_cs(pkt_cache_t *pkt_cache,
                                        msgbuf_pool_t *msgbuf_pool,
@@ -439,7 +552,9 @@ nexthops_t *pkt_cache_on_data(pkt_cache_t *pkt_cache,
  * @brief Handle interest packet reception.
  * @details Perform packet cache lookup and execute operations based on it.
  * If:
- *      - No match: Do nothing
+ *      - No match: Look up the disk tier of the CS, if any; on a hit, move
+ *                  the data packet back to the CS and get it from there.
+ *                  Otherwise add the interest to the PIT
  *      - DATA not expired: get data message from CS
  *      - INTEREST not expired: Aggregate or retransmit the interest received;
  *      - INTEREST expired: Update the PIT;
@@ -451,8 +566,34 @@ void pkt_cache_on_interest(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
                            const hicn_name_t *name,
                            bool is_serve_from_cs_enabled);
 
+/**
+ * @brief Prefetch the packet cache index for a batch of interest and data
+ * packets, whose names must have been set, ahead of their processing.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in] msgbuf_pool Pointer to the msgbuf pool holding the packets
+ * @param[in] msgbuf_ids Identifiers of the msgbufs of the batch
+ * @param[in] n Number of msgbufs in the batch
+ */
+void pkt_cache_prefetch(const pkt_cache_t *pkt_cache,
+                        const msgbuf_pool_t *msgbuf_pool,
+                        const off_t *msgbuf_ids, size_t n);
+
+/**
+ * @brief Prefetch the packet cache index for a list of names, eg. the names
+ * requested by an interest manifest, ahead of their lookup. With the
+ * two-level index, only the suffixes of the prefix saved with
+ * pkt_cache_save_suffixes_for_prefix() are prefetched.
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in] names Names to be looked up
+ * @param[in] n Number of names
+ */
+void pkt_cache_prefetch_names(const pkt_cache_t *pkt_cache,
+                              const hicn_name_t *names, size_t n);
+
 /********* Low-level operations on the hash table *********/
-#ifdef WITH_TESTS
+#if defined(WITH_TESTS) && !defined(WITH_NAME_TABLE)
 unsigned __get_suffix(kh_pkt_cache_suffix_t *suffixes,
                       hicn_name_suffix_t suffix);
 unsigned _get_suffix(kh_pkt_cache_prefix_t *prefixes,
@@ -476,11 +617,16 @@ kh_pkt_cache_suffix_t *_get_suffixes(kh_pkt_cache_prefix_t *prefix_to_suffixes,
 
 typedef struct {
   const char *name;
-  void (*initialize)(cs_t *cs);
+  /* Return 0 on success, -1 if memory could not be allocated */
+  int (*initialize)(cs_t *cs);
   void (*finalize)(cs_t *cs);
   int (*add_entry)(pkt_cache_t *pkt_cache, off_t entry_id);
   void (*update_entry)(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry);
   int (*remove_entry)(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry);
+  /* An interest has been served by the entry */
+  void (*hit_entry)(pkt_cache_t *pkt_cache, pkt_cache_entry_t *entry);
+  /* An interest for the name could not be served by the content store */
+  void (*miss)(pkt_cache_t *pkt_cache, const hicn_name_t *name);
 } cs_ops_t;
 extern const cs_ops_t *const cs_vft[];
 
@@ -497,6 +643,35 @@ extern const cs_ops_t *const cs_vft[];
       .add_entry = cs_##NAME##_add_entry,       \
       .update_entry = cs_##NAME##_update_entry, \
       .remove_entry = cs_##NAME##_remove_entry, \
+      .hit_entry = cs_##NAME##_hit_entry,       \
+      .miss = cs_##NAME##_miss,                 \
   }
 
+/**
+ * @brief Return the CS entry with the given ID (helper for CS policies).
+ */
+cs_entry_t *_cs_entry_at(pkt_cache_t *pkt_cache, off_t entry_id);
+
+/**
+ * @brief Insert a CS entry at the head of a list linked through the 'lru'
+ * field of the entries (helper for CS policies).
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in, out] list Head and tail of the list
+ * @param[in] entry_id ID of the entry to insert
+ */
+void cs_list_push(pkt_cache_t *pkt_cache, cs_lru_state_t *list,
+                  off_t entry_id);
+
+/**
+ * @brief Unlink a CS entry from a list linked through the 'lru' field of the
+ * entries (helper for CS policies).
+ *
+ * @param[in] pkt_cache Pointer to the packet cache data structure to use
+ * @param[in, out] list Head and tail of the list
+ * @param[in] entry_id ID of the entry to unlink
+ */
+void cs_list_remove(pkt_cache_t *pkt_cache, cs_lru_state_t *list,
+                    off_t entry_id);
+
 #endif /* HICNLIGHT_PACKET_CACHE_H */
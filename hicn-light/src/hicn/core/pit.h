@@ -27,6 +27,14 @@ typedef struct {
   nexthops_t ingressIdSet;
   nexthops_t egressIdSet;
   fib_entry_t* fib_entry;
+
+  /*
+   * Reception time of the interest when it was first forwarded, to measure
+   * next hop RTTs. Once the interest has been forwarded again, it is not known
+   * which transmission the data answers, and no sample is taken (Karn).
+   */
+  Usecs send_ts;
+  bool retransmitted;
 } pit_entry_t;
 
 #define pit_entry_get_ingress(E) (&((E)->ingressIdSet))
@@ -42,6 +50,30 @@ typedef struct {
 
 #define pit_entry_egress_add(E, NH) nexthops_add(pit_entry_get_egress(E), (NH))
 
+static inline void pit_entry_on_forward(pit_entry_t* entry, Usecs now) {
+  if (entry->send_ts != 0)
+    entry->retransmitted = true;
+  else
+    entry->send_ts = now;
+}
+
+/**
+ * @brief Compute the RTT sample given by a data packet satisfying the entry.
+ *
+ * @return bool Whether the sample is valid, ie. the interest was forwarded
+ * only once, towards the connection the data comes from.
+ */
+static inline bool pit_entry_get_rtt(pit_entry_t* entry, const msgbuf_t* data,
+                                     Usecs* rtt) {
+  if (entry->send_ts == 0 || entry->retransmitted) return false;
+  if (data->recv_ts < entry->send_ts) return false;
+  if (!nexthops_contains(pit_entry_get_egress(entry),
+                         msgbuf_get_connection_id(data)))
+    return false;
+  *rtt = data->recv_ts - entry->send_ts;
+  return true;
+}
+
 typedef struct {
   // TODO(eloparco): How to handle PIT size?
   size_t max_size;
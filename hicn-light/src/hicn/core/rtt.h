@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file rtt.h
+ * @brief Round-trip time estimation, as in TCP (RFC 6298).
+ *
+ * Samples are measured by the PIT, from the forwarding of an interest to the
+ * reception of the corresponding data. Estimates are kept both per next hop
+ * of a FIB entry (in the nexthop state) and per connection (in its stats).
+ */
+
+#ifndef HICNLIGHT_RTT_H
+#define HICNLIGHT_RTT_H
+
+#include <stdint.h>
+#include <hicn/base.h>
+
+#include "ticks.h"
+
+/* EWMA gains: alpha = 1/8 for the mean, beta = 1/4 for the variation */
+#define RTT_ALPHA_SHIFT 3
+#define RTT_BETA_SHIFT 2
+
+#define RTT_STATS_EMPTY ((rtt_stats_t){0})
+
+static inline void rtt_stats_update(rtt_stats_t *rtt, Usecs sample) {
+  uint32_t r = sample > UINT32_MAX ? UINT32_MAX : (uint32_t)sample;
+
+  if (rtt->n_samples == 0) {
+    rtt->srtt = r;
+    rtt->rttvar = r / 2;
+    rtt->min = r;
+  } else {
+    uint32_t delta = r > rtt->srtt ? r - rtt->srtt : rtt->srtt - r;
+    rtt->rttvar = rtt->rttvar - (rtt->rttvar >> RTT_BETA_SHIFT) +
+                  (delta >> RTT_BETA_SHIFT);
+    /* Signed update, as r - srtt may be negative */
+    rtt->srtt = (uint32_t)((int64_t)rtt->srtt +
+                           (((int64_t)r - rtt->srtt) >> RTT_ALPHA_SHIFT));
+    if (r < rtt->min) rtt->min = r;
+  }
+  rtt->n_samples++;
+}
+
+#endif /* HICNLIGHT_RTT_H */
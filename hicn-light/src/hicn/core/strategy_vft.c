@@ -33,7 +33,5 @@ const strategy_ops_t *const strategy_vft[] = {
     [STRATEGY_TYPE_REPLICATION] = &strategy_replication,
     [STRATEGY_TYPE_BESTPATH] = &strategy_bestpath,
     [STRATEGY_TYPE_LOCAL_REMOTE] = &strategy_local_remote,
-#if 0
-  [STRATEGY_TYPE_LOW_LATENCY] = &strategy_low_latency,
-#endif
+    [STRATEGY_TYPE_LOW_LATENCY] = &strategy_low_latency,
 };
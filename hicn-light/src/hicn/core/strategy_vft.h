@@ -20,15 +20,19 @@
 #ifndef HICNLIGHT_STRATEGY_VFT_H
 #define HICNLIGHT_STRATEGY_VFT_H
 
+#include <hicn/base.h>
+
 #include "msgbuf.h"
 
 #include "../strategies/best_path.h"
 #include "../strategies/load_balancer.h"
+#include "../strategies/low_latency.h"
 #include "../strategies/random.h"
 #include "../strategies/replication.h"
 
 typedef union {
   strategy_load_balancer_options_t load_balancer;
+  strategy_low_latency_options_t low_latency;
   strategy_random_options_t random;
   strategy_replication_options_t replication;
   strategy_bestpath_options_t bestpath;
@@ -38,23 +42,22 @@ typedef struct {
 #ifdef WITH_POLICY
   int priority;
 #endif /* WITH_POLICY */
+  /* Measured RTT towards the next hop, common to all strategies (see rtt.h) */
+  rtt_stats_t rtt;
   union {
     strategy_load_balancer_nexthop_state_t load_balancer;
+    strategy_low_latency_nexthop_state_t low_latency;
     strategy_random_nexthop_state_t random;
     strategy_replication_nexthop_state_t replication;
     strategy_bestpath_nexthop_state_t bestpath;
   };
 } strategy_nexthop_state_t;
 
-#define STRATEGY_NEXTHOP_STATE_EMPTY \
-  {                                  \
-    0, {                             \
-      { 0 }                          \
-    }                                \
-  }
+#define STRATEGY_NEXTHOP_STATE_EMPTY {0}
 
 typedef union {
   strategy_load_balancer_state_t load_balancer;
+  strategy_low_latency_state_t low_latency;
   strategy_random_state_t random;
   strategy_replication_state_t replication;
   strategy_bestpath_state_t bestpath;
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file ticks.c
+ * @brief Calibration of the cycle counter used as microsecond clock.
+ */
+
+#include "ticks.h"
+
+#ifdef WITH_TSC_CLOCK
+
+#include <pthread.h>
+
+#include <hicn/util/log.h>
+
+/* Duration over which the cycle counter is measured against the clock */
+#define CALIBRATION_USECS 20000
+
+double usecs_per_cycle = 0;
+uint64_t usecs_base_cycles = 0;
+Usecs usecs_base = 0;
+
+static pthread_once_t calibrate_once = PTHREAD_ONCE_INIT;
+
+static void _usecs_calibrate() {
+  Usecs t0 = usecs_now_sys();
+  uint64_t c0 = cycles_now();
+
+  struct timespec ts = {.tv_sec = 0, .tv_nsec = CALIBRATION_USECS * 1000};
+  nanosleep(&ts, NULL);
+
+  Usecs t1 = usecs_now_sys();
+  uint64_t c1 = cycles_now();
+
+  if (t1 <= t0 || c1 <= c0) {
+    WARN("Cycle counter unusable as clock source, using the system clock");
+    return;
+  }
+
+  usecs_base = t1;
+  usecs_base_cycles = c1;
+  usecs_per_cycle = (double)(t1 - t0) / (c1 - c0);
+
+  INFO("Cycle counter clock source: %.0f cycles/us", 1 / usecs_per_cycle);
+}
+
+/* Forwarders and workers all calibrate before reading the clock */
+void usecs_calibrate() { pthread_once(&calibrate_once, _usecs_calibrate); }
+
+#else
+
+void usecs_calibrate() {}
+
+#endif /* WITH_TSC_CLOCK */
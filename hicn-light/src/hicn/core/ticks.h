@@ -29,6 +29,14 @@
 
 #include <sys/param.h>  // HZ
 
+#if defined(__x86_64__) || defined(__i386__)
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+#endif
+
 #ifdef __APPLE__
 #include <mach/clock.h>
 #include <mach/mach.h>
@@ -63,4 +71,65 @@ static inline Ticks ticks_now() {
   return ts.tv_sec * 1000 + ts.tv_nsec / 1e6;
 }
 
+/**
+ * CPU cycle counter, to profile processing stages. It falls back to
+ * nanoseconds on architectures without a readable counter.
+ */
+static inline uint64_t cycles_now() {
+#if defined(__x86_64__) || defined(__i386__)
+  return __rdtsc();
+#elif defined(__aarch64__)
+  uint64_t cycles;
+  __asm__ volatile("mrs %0, cntvct_el0" : "=r"(cycles));
+  return cycles;
+#else
+  struct timespec ts;
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+  return ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+#endif
+}
+
+/**
+ * High resolution timestamps, in microseconds. Ticks only have a millisecond
+ * resolution, which cannot tell apart paths with sub-millisecond round-trip
+ * times. They are used for packet reception times and RTT measurements.
+ *
+ * When built WITH_TSC_CLOCK, they are derived from the CPU cycle counter,
+ * which is cheaper to read than the system clock. This requires a counter
+ * running at a constant rate (constant_tsc on x86), whose frequency is
+ * measured once by usecs_calibrate(). The system clock is used until then.
+ */
+typedef uint64_t Usecs;
+
+#ifdef WITH_TSC_CLOCK
+extern double usecs_per_cycle;
+extern uint64_t usecs_base_cycles;
+extern Usecs usecs_base;
+#endif /* WITH_TSC_CLOCK */
+
+/**
+ * @brief Measure the frequency of the cycle counter. This is a no-op unless
+ * built WITH_TSC_CLOCK, and only the first call has an effect.
+ */
+void usecs_calibrate();
+
+static inline Usecs usecs_now_sys() {
+  struct timespec ts;
+#if _WIN32
+  _clock_gettime(TIME_UTC, &ts);
+#else
+  clock_gettime(CLOCK_MONOTONIC_RAW, &ts);
+#endif
+  return ts.tv_sec * 1000000ULL + ts.tv_nsec / 1000;
+}
+
+static inline Usecs usecs_now() {
+#ifdef WITH_TSC_CLOCK
+  if (usecs_per_cycle > 0)
+    return usecs_base +
+           (Usecs)((cycles_now() - usecs_base_cycles) * usecs_per_cycle);
+#endif /* WITH_TSC_CLOCK */
+  return usecs_now_sys();
+}
+
 #endif  // ticks_h
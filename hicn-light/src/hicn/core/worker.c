@@ -0,0 +1,603 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file worker.c
+ * @brief Implementation of multi-worker forwarding.
+ *
+ * Inter-worker communication relies on a mutex-protected inbox per worker,
+ * together with a pipe registered on the worker loop to wake it up. The
+ * inbox is double-buffered: producers append to the pending vector while
+ * the consumer swaps it with an empty one and processes messages without
+ * holding the lock. The pipe is only written when the pending vector
+ * transitions from empty to non-empty, so that a burst of redirected packets
+ * costs a single wakeup.
+ *
+ * Only redirected packets are subject to the inbox limit: control messages
+ * (commands and connections) must reach every worker for their tables to
+ * remain consistent, and are thus never dropped in favour of data. Stopping
+ * a worker relies on a flag rather than on a message for the same reason.
+ */
+
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <pthread.h>
+#include <signal.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <hicn/util/log.h>
+#include <hicn/util/vector.h>
+
+#include "../base/loop.h"
+#include "../config/configuration.h"
+#include "../config/configuration_file.h"
+#include "connection_table.h"
+#include "forwarder.h"
+#include "listener_table.h"
+#include "msgbuf_pool.h"
+#include "ticks.h"
+#include "worker.h"
+
+/* Maximum number of messages waiting in an inbox before packets are dropped */
+#define WORKER_INBOX_MAX 4096
+#define WORKER_INBOX_INIT_SIZE 128
+
+#define foreach_worker_msg_type \
+  _(UNDEFINED)                  \
+  _(PACKET)                     \
+  _(COMMAND)                    \
+  _(CONNECTION)                 \
+  _(N)
+
+typedef enum {
+#define _(x) WORKER_MSG_TYPE_##x,
+  foreach_worker_msg_type
+#undef _
+} worker_msg_type_t;
+
+typedef struct {
+  worker_msg_type_t type;
+  listener_key_t listener_key;
+  address_pair_t pair;
+  size_t len;
+  uint8_t packet[MTU];
+} worker_msg_t;
+
+struct worker_s {
+  unsigned id;
+  workers_t *workers;
+  pthread_t thread;
+  bool failed;
+
+  loop_t *loop;
+  forwarder_t *forwarder;
+
+  /* Inbox */
+  pthread_mutex_t lock;
+  worker_msg_t *pending;     // filled by other workers (protected by lock)
+  worker_msg_t *processing;  // drained by the worker itself
+  int fd[2];                 // wakeup pipe (read end, write end)
+  event_t *event;
+  bool stopping;  // set by workers_free(), accessed atomically
+
+  worker_stats_t stats;  // updated atomically, see worker_stats_inc()
+};
+
+struct workers_s {
+  unsigned n_workers;
+  worker_t *workers;
+
+  /* Connection ids and names shared by the connection tables of all workers */
+  connection_registry_t *connection_registry;
+
+  /* Startup synchronization */
+  pthread_mutex_t lock;
+  pthread_cond_t cond;
+  unsigned n_ready;
+  bool started;
+};
+
+/*
+ * Statistics are updated by their worker and might be read concurrently from
+ * other threads through worker_get_stats(). Release/acquire ordering makes the
+ * effects of a processed message visible to a thread observing its counter.
+ */
+#define worker_stats_inc(worker, field) \
+  __atomic_fetch_add(&(worker)->stats.field, 1, __ATOMIC_RELEASE)
+
+#define worker_stats_load(worker, field) \
+  __atomic_load_n(&(worker)->stats.field, __ATOMIC_ACQUIRE)
+
+/*----------------------------------------------------------------------------*
+ * Inbox
+ *----------------------------------------------------------------------------*/
+
+static void worker_wakeup(worker_t *worker) {
+  uint8_t byte = 0;
+  /* A full pipe already guarantees a pending wakeup */
+  if (write(worker->fd[1], &byte, sizeof(byte)) < 0 && errno != EAGAIN)
+    WARN("Could not wake up worker %u: %s", worker->id, strerror(errno));
+}
+
+static int worker_inbox_push(worker_t *worker, worker_msg_type_t type,
+                             const uint8_t *packet, size_t size,
+                             const address_pair_t *pair,
+                             const listener_key_t *listener_key) {
+  if (size > MTU) return -1;
+
+  bool wakeup;
+  pthread_mutex_lock(&worker->lock);
+  size_t len = vector_len(worker->pending);
+  if (type == WORKER_MSG_TYPE_PACKET && len >= WORKER_INBOX_MAX) {
+    pthread_mutex_unlock(&worker->lock);
+    return -1;
+  }
+  int rc = vector_ensure_pos(worker->pending, len);
+  if (rc < 0) {
+    pthread_mutex_unlock(&worker->lock);
+    return -1;
+  }
+  worker_msg_t *msg = &worker->pending[len];
+  msg->type = type;
+  if (listener_key) msg->listener_key = *listener_key;
+  if (pair) msg->pair = *pair;
+  msg->len = size;
+  if (size > 0) memcpy(msg->packet, packet, size);
+  vector_len(worker->pending)++;
+  wakeup = (len == 0);
+  pthread_mutex_unlock(&worker->lock);
+
+  if (wakeup) worker_wakeup(worker);
+  return 0;
+}
+
+static void worker_process_packet(worker_t *worker, worker_msg_t *msg) {
+  forwarder_t *forwarder = worker->forwarder;
+  listener_table_t *table = forwarder_get_listener_table(forwarder);
+  listener_t *listener = listener_table_get_by_key(table, &msg->listener_key);
+  if (!listener) {
+    WARN("[worker %u] No matching listener for redirected packet", worker->id);
+    return;
+  }
+
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  msgbuf_t *msgbuf = NULL;
+  off_t msgbuf_id = msgbuf_pool_get(msgbuf_pool, &msgbuf);
+  if (!msgbuf_id_is_valid(msgbuf_id)) return;
+
+  memcpy(msgbuf_get_packet(msgbuf), msg->packet, msg->len);
+  msgbuf_set_len(msgbuf, msg->len);
+  msgbuf_pool_acquire(msgbuf);
+  msgbuf_set_connection_id(msgbuf, CONNECTION_ID_UNDEFINED);
+
+  worker_stats_inc(worker, n_redirected_in);
+  forwarder_receive(forwarder, listener, msgbuf_id, &msg->pair, usecs_now());
+
+  msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+  msgbuf_pool_release(msgbuf_pool, &msgbuf);
+}
+
+static void worker_process_command(worker_t *worker, worker_msg_t *msg) {
+  forwarder_t *forwarder = worker->forwarder;
+  listener_table_t *table = forwarder_get_listener_table(forwarder);
+  listener_t *listener = listener_table_get_by_key(table, &msg->listener_key);
+
+  worker_stats_inc(worker, n_commands_replayed);
+  forwarder_replay_command(forwarder, listener, msg->packet, msg->len,
+                           &msg->pair);
+}
+
+static void worker_process_connection(worker_t *worker, worker_msg_t *msg) {
+  forwarder_t *forwarder = worker->forwarder;
+  connection_table_t *connection_table =
+      forwarder_get_connection_table(forwarder);
+
+  /* The peer might have reached this worker in the meantime */
+  if (connection_table_get_by_pair(connection_table, &msg->pair)) return;
+
+  listener_table_t *table = forwarder_get_listener_table(forwarder);
+  listener_t *listener = listener_table_get_by_key(table, &msg->listener_key);
+  if (!listener) {
+    WARN("[worker %u] No matching listener for published connection",
+         worker->id);
+    return;
+  }
+
+  /* The connection registry attributes the same id as in the publisher */
+  unsigned connection_id = listener_create_connection(
+      listener, (const char *)msg->packet, &msg->pair);
+  if (!connection_id_is_valid(connection_id)) {
+    WARN("[worker %u] Could not create published connection %s", worker->id,
+         (const char *)msg->packet);
+    return;
+  }
+  worker_stats_inc(worker, n_connections_replayed);
+}
+
+static int worker_on_inbox(void *owner, int fd, unsigned id, void *data) {
+  worker_t *worker = (worker_t *)owner;
+  uint8_t buffer[64];
+
+  /* Drain wakeup notifications */
+  while (read(fd, buffer, sizeof(buffer)) > 0)
+    ;
+
+  pthread_mutex_lock(&worker->lock);
+  worker_msg_t *tmp = worker->processing;
+  worker->processing = worker->pending;
+  worker->pending = tmp;
+  pthread_mutex_unlock(&worker->lock);
+
+  bool flush = false;
+  for (unsigned i = 0; i < vector_len(worker->processing); i++) {
+    worker_msg_t *msg = &worker->processing[i];
+    switch (msg->type) {
+      case WORKER_MSG_TYPE_PACKET:
+        worker_process_packet(worker, msg);
+        flush = true;
+        break;
+      case WORKER_MSG_TYPE_COMMAND:
+        worker_process_command(worker, msg);
+        break;
+      case WORKER_MSG_TYPE_CONNECTION:
+        worker_process_connection(worker, msg);
+        break;
+      default:
+        break;
+    }
+  }
+  vector_reset(worker->processing);
+
+  if (flush) forwarder_flush_connections(worker->forwarder);
+  if (__atomic_load_n(&worker->stopping, __ATOMIC_ACQUIRE))
+    loop_break(worker->loop);
+  return 0;
+}
+
+static int worker_inbox_initialize(worker_t *worker) {
+  if (pthread_mutex_init(&worker->lock, NULL) != 0) goto ERR_MUTEX;
+
+  if (vector_init(worker->pending, WORKER_INBOX_INIT_SIZE, 0) < 0)
+    goto ERR_PENDING;
+  if (vector_init(worker->processing, WORKER_INBOX_INIT_SIZE, 0) < 0)
+    goto ERR_PROCESSING;
+
+  if (pipe(worker->fd) < 0) {
+    ERROR("[worker %u] Could not create pipe: %s", worker->id,
+          strerror(errno));
+    goto ERR_PIPE;
+  }
+  fcntl(worker->fd[0], F_SETFL, O_NONBLOCK);
+  fcntl(worker->fd[1], F_SETFL, O_NONBLOCK);
+
+  if (loop_fd_event_create(&worker->event, worker->loop, worker->fd[0],
+                           worker, worker_on_inbox, 0, NULL) < 0)
+    goto ERR_EVENT;
+  if (loop_fd_event_register(worker->event) < 0) goto ERR_REGISTER;
+
+  return 0;
+
+ERR_REGISTER:
+  loop_event_free(worker->event);
+ERR_EVENT:
+  close(worker->fd[0]);
+  close(worker->fd[1]);
+ERR_PIPE:
+  vector_free(worker->processing);
+ERR_PROCESSING:
+  vector_free(worker->pending);
+ERR_PENDING:
+  pthread_mutex_destroy(&worker->lock);
+ERR_MUTEX:
+  return -1;
+}
+
+static void worker_inbox_finalize(worker_t *worker) {
+  loop_event_unregister(worker->event);
+  loop_event_free(worker->event);
+  close(worker->fd[0]);
+  close(worker->fd[1]);
+  vector_free(worker->processing);
+  vector_free(worker->pending);
+  pthread_mutex_destroy(&worker->lock);
+}
+
+/*----------------------------------------------------------------------------*
+ * Worker threads
+ *----------------------------------------------------------------------------*/
+
+static int worker_initialize(worker_t *worker, configuration_t *config) {
+  MAIN_LOOP = loop_create();
+  if (!MAIN_LOOP) goto ERR_LOOP;
+  worker->loop = MAIN_LOOP;
+
+  configuration_t *copy = configuration_copy(config);
+  if (!copy) goto ERR_CONFIG;
+
+  /* Each worker has its own content store, hence its own disk tier file */
+  const char *cs_disk_path = configuration_get_cs_disk_path(copy);
+  if (cs_disk_path) {
+    char path[PATH_MAX];
+    int rc = snprintf(path, PATH_MAX, "%s.%u", cs_disk_path, worker->id);
+    if (rc < 0 || rc >= PATH_MAX ||
+        configuration_set_cs_disk(copy, path, 0) < 0) {
+      WARN("[worker %u] Disk content store path too long", worker->id);
+      configuration_set_cs_disk(copy, NULL, 0);
+    }
+  }
+
+  /* The forwarder takes ownership of the configuration */
+  worker->forwarder = forwarder_create(copy);
+  if (!worker->forwarder) {
+    configuration_free(copy);
+    goto ERR_CONFIG;
+  }
+  forwarder_set_worker(worker->forwarder, worker);
+
+  /* Connections should be attributed the same id as in other workers */
+  connection_table_set_registry(
+      forwarder_get_connection_table(worker->forwarder),
+      worker->workers->connection_registry);
+
+  forwarder_setup_local_listeners(worker->forwarder,
+                                  configuration_get_port(copy));
+
+  const char *fn_config = configuration_get_fn_config(copy);
+  if (fn_config) configuration_file_process(worker->forwarder, fn_config);
+
+  if (worker_inbox_initialize(worker) < 0) goto ERR_INBOX;
+
+  return 0;
+
+ERR_INBOX:
+  forwarder_free(worker->forwarder);
+  worker->forwarder = NULL;
+ERR_CONFIG:
+  loop_free(MAIN_LOOP);
+  MAIN_LOOP = NULL;
+ERR_LOOP:
+  return -1;
+}
+
+static void *worker_thread(void *arg) {
+  worker_t *worker = (worker_t *)arg;
+  workers_t *workers = worker->workers;
+
+  /* Signals are handled by the main thread */
+  sigset_t set;
+  sigfillset(&set);
+  pthread_sigmask(SIG_BLOCK, &set, NULL);
+
+  /*
+   * Initialization is serialized across workers as configuration processing
+   * relies on process-wide state.
+   */
+  pthread_mutex_lock(&workers->lock);
+  forwarder_t *forwarder = workers->workers[0].forwarder;
+  if (worker_initialize(worker, forwarder_get_configuration(forwarder)) < 0) {
+    ERROR("[worker %u] Initialization failed", worker->id);
+    worker->failed = true;
+  }
+  workers->n_ready++;
+  pthread_cond_broadcast(&workers->cond);
+  while (!workers->started) pthread_cond_wait(&workers->cond, &workers->lock);
+  pthread_mutex_unlock(&workers->lock);
+
+  if (worker->failed) return NULL;
+
+  INFO("[worker %u] Started", worker->id);
+  loop_dispatch(worker->loop);
+  INFO("[worker %u] Stopped", worker->id);
+
+  worker_inbox_finalize(worker);
+  forwarder_free(worker->forwarder);
+  worker->forwarder = NULL;
+  loop_free(worker->loop);
+  worker->loop = NULL;
+  MAIN_LOOP = NULL;
+
+  return NULL;
+}
+
+/*----------------------------------------------------------------------------*
+ * Worker group
+ *----------------------------------------------------------------------------*/
+
+workers_t *workers_create(forwarder_t *forwarder, unsigned n_workers) {
+  assert(forwarder);
+  assert(MAIN_LOOP);
+
+  if (n_workers == 0) n_workers = 1;
+
+  workers_t *workers = malloc(sizeof(workers_t));
+  if (!workers) goto ERR_MALLOC;
+  workers->n_workers = n_workers;
+  workers->n_ready = 0;
+  workers->started = false;
+  workers->workers = calloc(n_workers, sizeof(worker_t));
+  if (!workers->workers) goto ERR_WORKERS;
+  workers->connection_registry = connection_registry_create();
+  if (!workers->connection_registry) goto ERR_REGISTRY;
+  pthread_mutex_init(&workers->lock, NULL);
+  pthread_cond_init(&workers->cond, NULL);
+
+  for (unsigned i = 0; i < n_workers; i++) {
+    workers->workers[i].id = i;
+    workers->workers[i].workers = workers;
+  }
+
+  /* Worker 0 runs in the calling thread */
+  worker_t *worker = &workers->workers[0];
+  worker->loop = MAIN_LOOP;
+  worker->forwarder = forwarder;
+  if (connection_table_set_registry(forwarder_get_connection_table(forwarder),
+                                    workers->connection_registry) < 0)
+    goto ERR_SET_REGISTRY;
+  if (worker_inbox_initialize(worker) < 0) goto ERR_INBOX;
+  forwarder_set_worker(forwarder, worker);
+
+  unsigned n_started = 1;
+  for (; n_started < n_workers; n_started++) {
+    worker = &workers->workers[n_started];
+    if (pthread_create(&worker->thread, NULL, worker_thread, worker) != 0) {
+      ERROR("Could not start worker %u", n_started);
+      break;
+    }
+  }
+
+  /* Wait for all workers to be ready before any packet gets redirected */
+  bool failed = (n_started != n_workers);
+  pthread_mutex_lock(&workers->lock);
+  while (workers->n_ready < n_started - 1)
+    pthread_cond_wait(&workers->cond, &workers->lock);
+  for (unsigned i = 1; i < n_started; i++)
+    if (workers->workers[i].failed) failed = true;
+  workers->started = true;
+  pthread_cond_broadcast(&workers->cond);
+  pthread_mutex_unlock(&workers->lock);
+
+  if (failed) {
+    /* Only stop those workers which are effectively running */
+    workers->n_workers = n_started;
+    workers_free(workers);
+    return NULL;
+  }
+
+  INFO("Started %u forwarding workers", n_workers);
+  return workers;
+
+ERR_INBOX:
+  connection_table_set_registry(forwarder_get_connection_table(forwarder),
+                                NULL);
+ERR_SET_REGISTRY:
+  pthread_cond_destroy(&workers->cond);
+  pthread_mutex_destroy(&workers->lock);
+  connection_registry_free(workers->connection_registry);
+ERR_REGISTRY:
+  free(workers->workers);
+ERR_WORKERS:
+  free(workers);
+ERR_MALLOC:
+  return NULL;
+}
+
+void workers_free(workers_t *workers) {
+  assert(workers);
+
+  for (unsigned i = 1; i < workers->n_workers; i++) {
+    worker_t *worker = &workers->workers[i];
+    if (!worker->failed) {
+      /* Messages still in the inbox are processed before the loop exits */
+      __atomic_store_n(&worker->stopping, true, __ATOMIC_RELEASE);
+      worker_wakeup(worker);
+    }
+    pthread_join(worker->thread, NULL);
+  }
+
+  worker_t *worker = &workers->workers[0];
+  forwarder_set_worker(worker->forwarder, NULL);
+  worker_inbox_finalize(worker);
+  connection_table_set_registry(
+      forwarder_get_connection_table(worker->forwarder), NULL);
+
+  pthread_cond_destroy(&workers->cond);
+  pthread_mutex_destroy(&workers->lock);
+  connection_registry_free(workers->connection_registry);
+  free(workers->workers);
+  free(workers);
+}
+
+unsigned workers_get_num(const workers_t *workers) {
+  return workers->n_workers;
+}
+
+worker_t *workers_get(workers_t *workers, unsigned id) {
+  assert(id < workers->n_workers);
+  return &workers->workers[id];
+}
+
+/*----------------------------------------------------------------------------*
+ * Worker
+ *----------------------------------------------------------------------------*/
+
+unsigned worker_get_id(const worker_t *worker) { return worker->id; }
+
+forwarder_t *worker_get_forwarder(const worker_t *worker) {
+  return worker->forwarder;
+}
+
+worker_stats_t worker_get_stats(const worker_t *worker) {
+  return (worker_stats_t){
+      .n_redirected_out = worker_stats_load(worker, n_redirected_out),
+      .n_redirected_in = worker_stats_load(worker, n_redirected_in),
+      .n_redirect_drops = worker_stats_load(worker, n_redirect_drops),
+      .n_commands_published = worker_stats_load(worker, n_commands_published),
+      .n_commands_replayed = worker_stats_load(worker, n_commands_replayed),
+      .n_connections_replayed =
+          worker_stats_load(worker, n_connections_replayed),
+  };
+}
+
+unsigned worker_get_owner(const worker_t *worker, uint32_t prefix_hash) {
+  return prefix_hash % worker->workers->n_workers;
+}
+
+int worker_redirect(worker_t *worker, unsigned owner, const uint8_t *packet,
+                    size_t size, const address_pair_t *pair,
+                    const listener_key_t *listener_key) {
+  assert(owner < worker->workers->n_workers);
+  assert(owner != worker->id);
+
+  worker_t *dst = &worker->workers->workers[owner];
+  if (worker_inbox_push(dst, WORKER_MSG_TYPE_PACKET, packet, size, pair,
+                        listener_key) < 0) {
+    worker_stats_inc(worker, n_redirect_drops);
+    return -1;
+  }
+  worker_stats_inc(worker, n_redirected_out);
+  return 0;
+}
+
+void worker_publish_command(worker_t *worker, const uint8_t *packet,
+                            size_t size, const address_pair_t *pair,
+                            const listener_key_t *listener_key) {
+  workers_t *workers = worker->workers;
+  for (unsigned i = 0; i < workers->n_workers; i++) {
+    if (i == worker->id) continue;
+    if (worker_inbox_push(&workers->workers[i], WORKER_MSG_TYPE_COMMAND,
+                          packet, size, pair, listener_key) < 0) {
+      ERROR("[worker %u] Could not publish command to worker %u", worker->id,
+            i);
+      continue;
+    }
+  }
+  worker_stats_inc(worker, n_commands_published);
+}
+
+void worker_publish_connection(worker_t *worker, const char *name,
+                               const address_pair_t *pair,
+                               const listener_key_t *listener_key) {
+  workers_t *workers = worker->workers;
+  for (unsigned i = 0; i < workers->n_workers; i++) {
+    if (i == worker->id) continue;
+    if (worker_inbox_push(&workers->workers[i], WORKER_MSG_TYPE_CONNECTION,
+                          (const uint8_t *)name, strlen(name) + 1, pair,
+                          listener_key) < 0)
+      ERROR("[worker %u] Could not publish connection %s to worker %u",
+            worker->id, name, i);
+  }
+}
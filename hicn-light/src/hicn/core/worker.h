@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file worker.h
+ * @brief Multi-worker forwarding.
+ *
+ * Each worker is a thread running its own event loop and its own forwarder
+ * instance, hence its own packet cache (PIT/CS), message buffer pool and
+ * listener sockets. Listener sockets are opened with SO_REUSEPORT so that the
+ * kernel spreads incoming flows across workers.
+ *
+ * Since the kernel distributes packets by flow and not by name, every
+ * interest/data packet is assigned an owner worker based on the hash of its
+ * name prefix (RSS-style). A worker receiving a packet it does not own hands
+ * it over to the owner through a per-worker inbox, so that PIT aggregation
+ * and CS hits remain consistent without any locking on the packet cache.
+ *
+ * Control commands modifying the forwarder state (listeners, connections,
+ * routes, strategies, ...) are published to all workers so that their
+ * tables are kept in sync; read-only commands are answered by the worker
+ * receiving them. Connections created on the fly upon reception of a packet
+ * are published as well. Connection ids and names are attributed by a
+ * registry shared by all workers (see connection_table.h), so that a given
+ * peer is known under the same id and name everywhere, and routes or list
+ * commands referring to a connection are consistent across workers. Packet
+ * and cache statistics remain per-worker.
+ *
+ * Worker 0 runs in the thread calling workers_create() and reuses its
+ * forwarder and loop (MAIN_LOOP).
+ */
+
+#ifndef HICNLIGHT_WORKER_H
+#define HICNLIGHT_WORKER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "address_pair.h"
+#include "listener.h"
+
+typedef struct forwarder_s forwarder_t;
+
+typedef struct worker_s worker_t;
+typedef struct workers_s workers_t;
+
+/* Read through worker_get_stats(), which is safe from any thread */
+typedef struct {
+  uint64_t n_redirected_out;  // packets handed over to their owner worker
+  uint64_t n_redirected_in;   // packets received from other workers
+  uint64_t n_redirect_drops;  // packets dropped because the inbox was full
+  uint64_t n_commands_published;
+  uint64_t n_commands_replayed;
+  uint64_t n_connections_replayed;  // connections published by other workers
+} worker_stats_t;
+
+/**
+ * @brief Start the forwarding workers.
+ *
+ * Worker 0 is bound to the given forwarder, which is assumed to have been
+ * created (and configured) in the calling thread. The n_workers - 1
+ * additional workers are started in their own thread, each of them creating
+ * a forwarder from a copy of the configuration, setting up the local
+ * listeners and processing the configuration file if any. The function
+ * returns once all workers are ready to forward packets.
+ *
+ * @param[in] forwarder - Forwarder of the calling thread (worker 0)
+ * @param[in] n_workers - Total number of workers, including worker 0
+ *
+ * @return The worker group, or NULL in case of error
+ */
+workers_t *workers_create(forwarder_t *forwarder, unsigned n_workers);
+
+/**
+ * @brief Stop all workers but worker 0, wait for their termination and
+ * release associated resources.
+ *
+ * The forwarder of worker 0 is left untouched and should be freed by the
+ * caller afterwards.
+ */
+void workers_free(workers_t *workers);
+
+unsigned workers_get_num(const workers_t *workers);
+
+worker_t *workers_get(workers_t *workers, unsigned id);
+
+unsigned worker_get_id(const worker_t *worker);
+
+forwarder_t *worker_get_forwarder(const worker_t *worker);
+
+worker_stats_t worker_get_stats(const worker_t *worker);
+
+/**
+ * @brief Returns the identifier of the worker owning the given name prefix
+ * hash.
+ */
+unsigned worker_get_owner(const worker_t *worker, uint32_t prefix_hash);
+
+/**
+ * @brief Hand over a packet to its owner worker.
+ *
+ * The packet is copied into the inbox of the destination worker which will
+ * process it as if it had been received on the listener identified by
+ * listener_key.
+ *
+ * @return 0 on success, -1 if the packet had to be dropped.
+ */
+int worker_redirect(worker_t *worker, unsigned owner, const uint8_t *packet,
+                    size_t size, const address_pair_t *pair,
+                    const listener_key_t *listener_key);
+
+/**
+ * @brief Publish a control command to all other workers.
+ *
+ * The command is replayed by every other worker on the connection
+ * corresponding to the same address pair (so that SELF is resolved
+ * consistently) without any reply being sent back.
+ */
+void worker_publish_command(worker_t *worker, const uint8_t *packet,
+                            size_t size, const address_pair_t *pair,
+                            const listener_key_t *listener_key);
+
+/**
+ * @brief Publish a connection created on the fly to all other workers.
+ *
+ * Other workers create the same connection (same address pair, id and name)
+ * on the listener identified by listener_key, unless they already know the
+ * address pair.
+ */
+void worker_publish_connection(worker_t *worker, const char *name,
+                               const address_pair_t *pair,
+                               const listener_key_t *listener_key);
+
+#endif /* HICNLIGHT_WORKER_H */
@@ -18,10 +18,20 @@
  * #brief Implementation of base IO functions.
  */
 
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#endif /* __linux__ */
+
+#include <hicn/util/bitmap.h>
 #include <hicn/util/log.h>
 
 #include "base.h"
 
+#ifndef UDP_GRO
+#define UDP_GRO 104 /* linux/udp.h */
+#endif
+
 /**
  * @brief Helper function for listener to read a single packet on a socket
  */
@@ -128,4 +138,207 @@ ssize_t io_read_batch_socket(int fd, msgbuf_t **msgbuf, address_t **address,
 
   return n;
 }
+
+unsigned io_gso_group(const size_t *len, unsigned n, unsigned *n_segments,
+                      uint16_t *segment_size) {
+  unsigned m = 0;
+  size_t gso_size = 0;
+  for (unsigned i = 0; i < n; i++) {
+    if ((m > 0) && (len[i] <= segment_size[m - 1]) &&
+        (len[i - 1] == segment_size[m - 1]) &&
+        (n_segments[m - 1] < UDP_GSO_MAX_SEGMENTS) &&
+        (gso_size + len[i] <= UDP_GSO_MAX_SIZE)) {
+      n_segments[m - 1]++;
+      gso_size += len[i];
+      continue;
+    }
+    n_segments[m] = 1;
+    segment_size[m] = (uint16_t)len[i];
+    gso_size = len[i];
+    m++;
+  }
+  return m;
+}
+
+/* Largest datagram the kernel may build by coalescing segments */
+#define IO_GRO_BUFFER_SIZE 65535
+
+/* Number of coalesced datagrams read in a single system call */
+#define IO_GRO_BATCH 8
+
+typedef struct {
+  bitmap_t *fds; /* sockets for which GRO is enabled */
+  unsigned n_fds;
+
+  /* Coalesced datagrams not yet fully handed over to the caller */
+  int fd;
+  unsigned n;
+  unsigned cur;
+  size_t offset;
+  size_t len[IO_GRO_BATCH];
+  size_t segment_size[IO_GRO_BATCH];
+  struct sockaddr_storage addrs[IO_GRO_BATCH];
+  socklen_t addrlens[IO_GRO_BATCH];
+  uint8_t buffers[IO_GRO_BATCH][IO_GRO_BUFFER_SIZE];
+} io_gro_t;
+
+static __thread io_gro_t *io_gro = NULL;
+
+static bool io_gro_is_enabled(int fd) {
+  if (!io_gro) return false;
+  if (fd / BITMAP_WIDTH(io_gro->fds) >= bitmap_get_alloc_size(io_gro->fds))
+    return false;
+  return bitmap_is_set(io_gro->fds, fd);
+}
+
+int io_gro_enable(int fd) {
+  if (setsockopt(fd, IPPROTO_UDP, UDP_GRO, &(int){1}, sizeof(int)) < 0) {
+    WARN("UDP GRO not supported on fd %d: %s", fd, strerror(errno));
+    return -1;
+  }
+  if (io_gro_is_enabled(fd)) return 0;
+
+  if (!io_gro) {
+    io_gro = malloc(sizeof(io_gro_t));
+    if (!io_gro) return -1;
+    if (bitmap_init(io_gro->fds, 1024, 0) < 0) goto ERR_BITMAP;
+    io_gro->n_fds = 0;
+    io_gro->fd = -1;
+    io_gro->n = 0;
+  }
+
+  if (bitmap_set(io_gro->fds, fd) < 0) return -1;
+  io_gro->n_fds++;
+  return 0;
+
+ERR_BITMAP:
+  free(io_gro);
+  io_gro = NULL;
+  return -1;
+}
+
+void io_gro_disable(int fd) {
+  if (!io_gro_is_enabled(fd)) return;
+
+  bitmap_unset(io_gro->fds, fd);
+  if (io_gro->fd == fd) io_gro->fd = -1;
+
+  if (--io_gro->n_fds > 0) return;
+  bitmap_free(io_gro->fds);
+  free(io_gro);
+  io_gro = NULL;
+}
+
+/*
+ * Split buffered datagrams into segments, as indicated by the kernel, until
+ * either the buffers are exhausted or the batch is full.
+ */
+static size_t io_gro_split(io_gro_t *gro, msgbuf_t **msgbuf,
+                           address_t **address, size_t batch_size) {
+  size_t n = 0;
+  while ((n < batch_size) && (gro->cur < gro->n)) {
+    unsigned i = gro->cur;
+    size_t len = gro->len[i] - gro->offset;
+    if (len > gro->segment_size[i]) len = gro->segment_size[i];
+
+    if (len <= MTU) {
+      memcpy(msgbuf_get_packet(msgbuf[n]), gro->buffers[i] + gro->offset, len);
+      msgbuf_set_len(msgbuf[n], len);
+      memcpy(address[n], &gro->addrs[i], gro->addrlens[i]);
+      n++;
+    } else {
+      WARN("Dropping oversized segment (%zu bytes)", len);
+    }
+
+    gro->offset += len;
+    if (len == 0 || gro->offset >= gro->len[i]) {
+      gro->cur++;
+      gro->offset = 0;
+    }
+  }
+  return n;
+}
+
+ssize_t io_read_batch_socket_gro(int fd, msgbuf_t **msgbuf, address_t **address,
+                                 size_t batch_size) {
+  if (!io_gro_is_enabled(fd))
+    return io_read_batch_socket(fd, msgbuf, address, batch_size);
+
+  io_gro_t *gro = io_gro;
+
+  /*
+   * Leftovers from another socket can only happen if a reader stopped before
+   * draining a batch; they cannot be returned here and are dropped.
+   */
+  if (gro->fd != fd) {
+    gro->fd = fd;
+    gro->n = 0;
+    gro->cur = 0;
+    gro->offset = 0;
+  }
+
+  size_t n = io_gro_split(gro, msgbuf, address, batch_size);
+  if (n == batch_size) return n;
+
+  struct mmsghdr msghdr[IO_GRO_BATCH];
+  struct iovec iovecs[IO_GRO_BATCH];
+  union {
+    char buf[CMSG_SPACE(sizeof(int))];
+    struct cmsghdr align;
+  } control[IO_GRO_BATCH];
+
+  for (unsigned i = 0; i < IO_GRO_BATCH; i++) {
+    iovecs[i] = (struct iovec){
+        .iov_base = gro->buffers[i],
+        .iov_len = IO_GRO_BUFFER_SIZE,
+    };
+    msghdr[i] = (struct mmsghdr){
+        .msg_hdr =
+            {
+                .msg_iov = &iovecs[i],
+                .msg_iovlen = 1,
+                .msg_name = &gro->addrs[i],
+                .msg_namelen = sizeof(struct sockaddr_storage),
+                .msg_control = control[i].buf,
+                .msg_controllen = sizeof(control[i].buf),
+            },
+    };
+  }
+
+  int rc;
+  for (;;) {
+    rc = recvmmsg(fd, msghdr, IO_GRO_BATCH, /* flags */ 0, /* timeout */ NULL);
+    if (rc >= 0) break;
+    if (errno == EINTR) continue;
+    if (n > 0) return n;
+
+    /* ICMP unreachable due to closing the remote end of a connection */
+    if (errno == ECONNREFUSED || errno == EAGAIN) return rc;
+
+    ERROR("read failed %d: (%d) %s", fd, errno, strerror(errno));
+    return rc;
+  }
+
+  gro->n = rc;
+  gro->cur = 0;
+  gro->offset = 0;
+  for (int i = 0; i < rc; i++) {
+    struct msghdr *msg = &msghdr[i].msg_hdr;
+    gro->len[i] = msghdr[i].msg_len;
+    gro->addrlens[i] = msg->msg_namelen;
+
+    /* Without the control message, the datagram was not coalesced */
+    gro->segment_size[i] = gro->len[i];
+    for (struct cmsghdr *cmsg = CMSG_FIRSTHDR(msg); cmsg;
+         cmsg = CMSG_NXTHDR(msg, cmsg)) {
+      if (cmsg->cmsg_level == IPPROTO_UDP && cmsg->cmsg_type == UDP_GRO) {
+        int segment_size;
+        memcpy(&segment_size, CMSG_DATA(cmsg), sizeof(int));
+        if (segment_size > 0) gro->segment_size[i] = segment_size;
+      }
+    }
+  }
+
+  return n + io_gro_split(gro, msgbuf + n, address + n, batch_size - n);
+}
 #endif /* __linux__ */
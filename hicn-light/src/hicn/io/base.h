@@ -34,4 +34,52 @@ ssize_t io_read_single_socket(int fd, msgbuf_t* msgbuf, address_t* address);
 ssize_t io_read_batch_socket(int fd, msgbuf_t** msgbuf, address_t** address,
                              size_t n);
 
+/**
+ * @brief Enable UDP generic receive offload (UDP_GRO) on a socket.
+ *
+ * Coalesced datagrams read on this socket by io_read_batch_socket_gro are
+ * split back into individual packets. The state is kept per thread, and
+ * should be enabled and disabled from the thread reading the socket.
+ *
+ * @return 0 on success, -1 if the option is not supported.
+ */
+int io_gro_enable(int fd);
+
+/**
+ * @brief Release the GRO state associated to a socket before it is closed.
+ */
+void io_gro_disable(int fd);
+
+/**
+ * @brief Same as io_read_batch_socket, splitting coalesced datagrams on
+ * sockets for which io_gro_enable has been called.
+ *
+ * Segments that do not fit in the batch are kept and returned first on the
+ * next call for the same socket.
+ */
+ssize_t io_read_batch_socket_gro(int fd, msgbuf_t** msgbuf, address_t** address,
+                                 size_t n);
+
+/* Kernel limits on UDP GSO super-datagrams (UDP_MAX_SEGMENTS, IP length) */
+#define UDP_GSO_MAX_SEGMENTS 64
+#define UDP_GSO_MAX_SIZE (65535 - 40 - 8) /* IPv6 and UDP headers */
+
+/**
+ * @brief Group consecutive packets into UDP generic segmentation offload
+ * (UDP_GSO) messages.
+ *
+ * Consecutive packets are grouped as long as they have the same size, the last
+ * segment of a group being allowed to be shorter, within the kernel limits on
+ * the number of segments and the total size.
+ *
+ * @param[in] len - Sizes of the n packets to send
+ * @param[in] n - Number of packets
+ * @param[out] n_segments - Number of packets in each message
+ * @param[out] segment_size - Segment size of each message
+ *
+ * @return The number of messages.
+ */
+unsigned io_gso_group(const size_t* len, unsigned n, unsigned* n_segments,
+                      uint16_t* segment_size);
+
 #endif /* HICNLIGHT_IO_BASE */
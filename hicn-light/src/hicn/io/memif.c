@@ -0,0 +1,458 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file memif.c
+ * @brief Implementation of shared memory (memif) faces towards local
+ * applications.
+ *
+ * hicn-light is the memif master: it listens on a UNIX socket (see
+ * configuration_get_memif_socket()) on which applications, acting as slaves,
+ * connect. Each memif connection has a single queue in each direction, whose
+ * rings are read and written without any system call; the interrupt eventfds
+ * only wake up the forwarder once per burst.
+ *
+ * The sockets managed by libmemif are not known in advance, so that listeners
+ * and connections both expose an epoll instance to the event loop:
+ *  - the listener epoll holds the control sockets of all connections;
+ *  - each connection epoll holds the eventfd of its receive queue, which is
+ *    only known once the slave has connected.
+ *
+ * As memif has no addresses, the remote address of a connection is a
+ * localhost address whose port holds the memif interface id.
+ */
+
+#include <errno.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <unistd.h>
+
+#include <libmemif.h>
+
+#include <hicn/util/log.h>
+#include <hicn/util/ring.h>
+
+#include "base.h"
+#include "../config/configuration.h"
+#include "../core/address_pair.h"
+#include "../core/connection.h"
+#include "../core/connection_vft.h"
+#include "../core/forwarder.h"
+#include "../core/listener.h"
+#include "../core/listener_vft.h"
+#include "../core/msgbuf.h"
+
+#define MEMIF_APP_NAME "hicn-light"
+#define MEMIF_BUFFER_SIZE 2048
+#define MEMIF_LOG2_RING_SIZE 10
+#define MEMIF_QUEUE_ID 0
+
+/*
+ * Events of the receive queues are told apart from control events by the low
+ * bit of the epoll data, as both point to aligned structures.
+ */
+#define MEMIF_QUEUE_EVENT 1
+
+/******************************************************************************
+ * Listener
+ ******************************************************************************/
+
+typedef struct {
+  memif_socket_handle_t socket;
+  int epfd;
+} listener_memif_data_t;
+
+/*
+ * Called by libmemif when a control socket has to be watched (or no longer
+ * watched) on behalf of the master socket or of one of its connections.
+ */
+static int listener_memif_on_control_fd_update(memif_fd_event_t fde,
+                                               void *private_ctx) {
+  listener_memif_data_t *data = private_ctx;
+  struct epoll_event event = {.data.ptr = fde.private_ctx};
+
+  if (fde.type & MEMIF_FD_EVENT_DEL)
+    return epoll_ctl(data->epfd, EPOLL_CTL_DEL, fde.fd, NULL);
+
+  if (fde.type & MEMIF_FD_EVENT_READ) event.events |= EPOLLIN;
+  if (fde.type & MEMIF_FD_EVENT_WRITE) event.events |= EPOLLOUT;
+
+  int op = (fde.type & MEMIF_FD_EVENT_MOD) ? EPOLL_CTL_MOD : EPOLL_CTL_ADD;
+  if (epoll_ctl(data->epfd, op, fde.fd, &event) < 0) {
+    ERROR("Cannot watch memif control socket: %s", strerror(errno));
+    return -1;
+  }
+  return 0;
+}
+
+static int listener_memif_initialize(listener_t *listener) {
+  assert(listener);
+  assert(listener->type == FACE_TYPE_MEMIF_LISTENER);
+
+  listener_memif_data_t *data = listener->data;
+  assert(data);
+  *data = (listener_memif_data_t){0};
+
+  configuration_t *config = forwarder_get_configuration(listener->forwarder);
+  const char *path = configuration_get_memif_socket(config);
+  if (!path) {
+    ERROR("No memif socket configured");
+    return -1;
+  }
+
+  data->epfd = epoll_create1(EPOLL_CLOEXEC);
+  if (data->epfd < 0) return -1;
+
+  memif_socket_args_t args = {
+      .on_control_fd_update = listener_memif_on_control_fd_update,
+  };
+  strncpy(args.path, path, sizeof(args.path) - 1);
+  strncpy(args.app_name, MEMIF_APP_NAME, sizeof(args.app_name) - 1);
+
+  int rc = memif_create_socket(&data->socket, &args, data);
+  if (rc != MEMIF_ERR_SUCCESS) {
+    ERROR("Cannot create memif socket %s: %s", path, memif_strerror(rc));
+    close(data->epfd);
+    return -1;
+  }
+
+  return 0;
+}
+
+static void listener_memif_finalize(listener_t *listener) {
+  assert(listener);
+  assert(listener->type == FACE_TYPE_MEMIF_LISTENER);
+
+  listener_memif_data_t *data = listener->data;
+  assert(data);
+
+  /* The listener epoll is closed along with the listener fd */
+  memif_delete_socket(&data->socket);
+}
+
+static int listener_memif_punt(const listener_t *listener,
+                               const char *prefix_s) {
+  return -1;
+}
+
+/*
+ * The listener fd is its epoll instance, while every connection gets its own
+ * epoll instance, to which the queue eventfd is added when the slave connects.
+ */
+static int listener_memif_get_socket(const listener_t *listener,
+                                     const address_t *local,
+                                     const address_t *remote,
+                                     const char *interface_name) {
+  if (!remote) {
+    listener_memif_data_t *data = listener->data;
+    return data->epfd;
+  }
+  return epoll_create1(EPOLL_CLOEXEC);
+}
+
+typedef struct {
+  memif_conn_handle_t handle;
+  bool connected;
+  int epfd;
+  int queue_fd;
+  address_t remote;
+
+  memif_buffer_t rx_bufs[MAX_MSG];
+  memif_buffer_t tx_bufs[MAX_MSG];
+
+  /* Ring buffer */
+  off_t *ring;
+} connection_memif_data_t;
+
+/*
+ * Reads packets out of the receive queue of a connection, or processes the
+ * control events of the listener, in which case no packet is returned.
+ */
+static ssize_t listener_memif_read_batch(int fd, msgbuf_t **msgbuf,
+                                         address_t **address, size_t len) {
+  struct epoll_event events[MAX_MSG];
+  ssize_t n_received = 0;
+
+  int n = epoll_wait(fd, events, MAX_MSG, 0);
+  if (n < 0) return (errno == EINTR) ? 0 : -1;
+
+  for (int e = 0; e < n; e++) {
+    if (!(events[e].data.u64 & MEMIF_QUEUE_EVENT)) {
+      memif_fd_event_type_t type = 0;
+      if (events[e].events & EPOLLIN) type |= MEMIF_FD_EVENT_READ;
+      if (events[e].events & EPOLLOUT) type |= MEMIF_FD_EVENT_WRITE;
+      if (events[e].events & (EPOLLERR | EPOLLHUP))
+        type |= MEMIF_FD_EVENT_ERROR;
+      memif_control_fd_handler(events[e].data.ptr, type);
+      continue;
+    }
+
+    connection_memif_data_t *data =
+        (connection_memif_data_t *)(events[e].data.u64 & ~MEMIF_QUEUE_EVENT);
+    if (!data->connected) continue;
+
+    /* Acknowledge the interrupt, the eventfd is level-triggered */
+    uint64_t n_interrupts;
+    if (read(data->queue_fd, &n_interrupts, sizeof(n_interrupts)) < 0 &&
+        errno != EAGAIN)
+      WARN("Cannot read memif queue eventfd: %s", strerror(errno));
+
+    uint16_t n_bufs = 0;
+    int rc = memif_rx_burst(data->handle, MEMIF_QUEUE_ID, data->rx_bufs,
+                            (uint16_t)(len - n_received), &n_bufs);
+    if (rc != MEMIF_ERR_SUCCESS && rc != MEMIF_ERR_NOBUF) {
+      WARN("memif_rx_burst failed: %s", memif_strerror(rc));
+      continue;
+    }
+
+    /*
+     * The packets are copied out of the ring, as msgbufs outlive the burst
+     * (they are held by the PIT, CS and transmit rings of other faces).
+     */
+    for (uint16_t i = 0; i < n_bufs; i++) {
+      memif_buffer_t *buf = &data->rx_bufs[i];
+      if (buf->len > MTU) {
+        WARN("Dropping memif packet of %u bytes", buf->len);
+        continue;
+      }
+      memcpy(msgbuf_get_packet(msgbuf[n_received]), buf->data, buf->len);
+      msgbuf_set_len(msgbuf[n_received], buf->len);
+      *address[n_received] = data->remote;
+      n_received++;
+    }
+    memif_refill_queue(data->handle, MEMIF_QUEUE_ID, n_bufs, 0);
+
+    /* Packets left in the ring: wake up again, the interrupt was consumed */
+    if (rc == MEMIF_ERR_NOBUF) {
+      uint64_t one = 1;
+      if (write(data->queue_fd, &one, sizeof(one)) < 0)
+        WARN("Cannot re-arm memif queue: %s", strerror(errno));
+    }
+    if (n_received == len) break;
+  }
+
+  return n_received;
+}
+
+#define listener_memif_read_single NULL
+
+DECLARE_LISTENER(memif);
+
+/******************************************************************************
+ * Connection
+ ******************************************************************************/
+
+#define RING_LEN 5 * MAX_MSG
+
+static int connection_memif_on_connect(memif_conn_handle_t handle,
+                                       void *private_ctx) {
+  connection_memif_data_t *data = private_ctx;
+
+  memif_refill_queue(handle, MEMIF_QUEUE_ID, -1, 0);
+
+  int rc = memif_get_queue_efd(handle, MEMIF_QUEUE_ID, &data->queue_fd);
+  if (rc != MEMIF_ERR_SUCCESS) {
+    ERROR("Cannot get memif queue eventfd: %s", memif_strerror(rc));
+    return -1;
+  }
+
+  struct epoll_event event = {
+      .events = EPOLLIN,
+      .data.u64 = (uint64_t)(uintptr_t)data | MEMIF_QUEUE_EVENT,
+  };
+  if (epoll_ctl(data->epfd, EPOLL_CTL_ADD, data->queue_fd, &event) < 0) {
+    ERROR("Cannot watch memif queue: %s", strerror(errno));
+    return -1;
+  }
+
+  data->connected = true;
+  INFO("memif connected");
+  return 0;
+}
+
+static int connection_memif_on_disconnect(memif_conn_handle_t handle,
+                                          void *private_ctx) {
+  connection_memif_data_t *data = private_ctx;
+
+  if (data->queue_fd >= 0)
+    epoll_ctl(data->epfd, EPOLL_CTL_DEL, data->queue_fd, NULL);
+  data->queue_fd = -1;
+  data->connected = false;
+  INFO("memif disconnected");
+  return 0;
+}
+
+static int connection_memif_initialize(connection_t *connection) {
+  assert(connection);
+  assert(connection->type == FACE_TYPE_MEMIF);
+
+  connection_memif_data_t *data = connection->data;
+  assert(data);
+
+  listener_memif_data_t *listener_data = connection->listener->data;
+  const address_t *remote = connection_get_remote(connection);
+
+  *data = (connection_memif_data_t){
+      .connected = false,
+      .epfd = connection->fd,
+      .queue_fd = -1,
+      .remote = *remote,
+  };
+  ring_init(data->ring, RING_LEN);
+
+  memif_conn_args_t args = {
+      .socket = listener_data->socket,
+      .num_s2m_rings = 1,
+      .num_m2s_rings = 1,
+      .buffer_size = MEMIF_BUFFER_SIZE,
+      .log2_ring_size = MEMIF_LOG2_RING_SIZE,
+      .is_master = 1,
+      .interface_id = address_port(remote),
+      .mode = MEMIF_INTERFACE_MODE_IP,
+  };
+  strncpy((char *)args.interface_name, connection->name,
+          sizeof(args.interface_name) - 1);
+
+  int rc = memif_create(&data->handle, &args, connection_memif_on_connect,
+                        connection_memif_on_disconnect, NULL, data);
+  if (rc != MEMIF_ERR_SUCCESS) {
+    ERROR("Cannot create memif interface %u: %s", args.interface_id,
+          memif_strerror(rc));
+    ring_free(data->ring);
+    return -1;
+  }
+
+  return 0;
+}
+
+static void connection_memif_finalize(connection_t *connection) {
+  assert(connection);
+  assert(connection->type == FACE_TYPE_MEMIF);
+
+  connection_memif_data_t *data = connection->data;
+  assert(data);
+
+  memif_delete(&data->handle);
+  ring_free(data->ring);
+}
+
+static bool connection_memif_flush(connection_t *connection) {
+  assert(connection);
+  forwarder_t *forwarder = listener_get_forwarder(connection->listener);
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  connection_memif_data_t *data = connection->data;
+  assert(data);
+
+  while (ring_get_size(data->ring) > 0) {
+    if (!data->connected) {
+      ring_advance(data->ring, ring_get_size(data->ring));
+      return false;
+    }
+
+    uint16_t n_packets = ring_get_size(data->ring);
+    if (n_packets > MAX_MSG) n_packets = MAX_MSG;
+
+    uint16_t n_allocated = 0;
+    int rc = memif_buffer_alloc(data->handle, MEMIF_QUEUE_ID, data->tx_bufs,
+                                n_packets, &n_allocated, MEMIF_BUFFER_SIZE);
+    if (n_allocated == 0) {
+      /* The slave is not keeping up: drop what is left */
+      WARN("memif_buffer_alloc failed: %s", memif_strerror(rc));
+      ring_advance(data->ring, ring_get_size(data->ring));
+      return false;
+    }
+
+    for (uint16_t i = 0; i < n_allocated; i++) {
+      off_t msgbuf_id;
+      ring_get(data->ring, i, &msgbuf_id);
+      msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+
+      if (msgbuf_get_type(msgbuf) == HICN_PACKET_TYPE_DATA) {
+        msgbuf_update_pathlabel(msgbuf, connection_get_id(connection));
+        connection->stats.data.tx_pkts++;
+        connection->stats.data.tx_bytes += msgbuf_get_len(msgbuf);
+      } else {
+        connection->stats.interests.tx_pkts++;
+        connection->stats.interests.tx_bytes += msgbuf_get_len(msgbuf);
+      }
+
+      memcpy(data->tx_bufs[i].data, msgbuf_get_packet(msgbuf),
+             msgbuf_get_len(msgbuf));
+      data->tx_bufs[i].len = msgbuf_get_len(msgbuf);
+    }
+
+    uint16_t n_sent = 0;
+    rc = memif_tx_burst(data->handle, MEMIF_QUEUE_ID, data->tx_bufs,
+                        n_allocated, &n_sent);
+    if (rc != MEMIF_ERR_SUCCESS)
+      WARN("memif_tx_burst failed: %s", memif_strerror(rc));
+    connection->stats.io.tx_calls++;
+    connection->stats.io.tx_segments += n_sent;
+
+    /* Buffers which could not be sent are dropped, as they are not queued */
+    ring_advance(data->ring, n_allocated);
+  }
+
+  return true;
+}
+
+static bool connection_memif_send(connection_t *connection, msgbuf_t *msgbuf,
+                                  bool queue) {
+  assert(connection);
+  assert(msgbuf);
+
+  connection_memif_data_t *data = connection->data;
+  assert(data);
+
+  forwarder_t *forwarder = listener_get_forwarder(connection->listener);
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+
+  if (ring_is_full(data->ring)) connection_memif_flush(connection);
+
+  off_t msgbuf_id = msgbuf_pool_get_id(msgbuf_pool, msgbuf);
+  ring_add(data->ring, &msgbuf_id);
+
+  /* There is no cheaper way than a burst to send a single packet */
+  if (!queue) return connection_memif_flush(connection);
+  return true;
+}
+
+static bool connection_memif_send_packet(const connection_t *connection,
+                                         const uint8_t *packet, size_t size) {
+  assert(connection);
+  assert(packet);
+
+  connection_memif_data_t *data = connection->data;
+  assert(data);
+
+  if (!data->connected || size > MEMIF_BUFFER_SIZE) return false;
+
+  memif_buffer_t buf;
+  uint16_t n = 0;
+  memif_buffer_alloc(data->handle, MEMIF_QUEUE_ID, &buf, 1, &n,
+                     MEMIF_BUFFER_SIZE);
+  if (n == 0) return false;
+
+  memcpy(buf.data, packet, size);
+  buf.len = size;
+  if (memif_tx_burst(data->handle, MEMIF_QUEUE_ID, &buf, 1, &n) !=
+      MEMIF_ERR_SUCCESS)
+    return false;
+  return n == 1;
+}
+
+DECLARE_CONNECTION(memif);
@@ -37,19 +37,21 @@
 #endif
 #include <sys/socket.h>
 
-#ifdef WITH_GSO
-#include <netinet/if_ether.h>  // ETH_DATA_LEN
-#include <linux/ipv6.h>        // struct ipv6hdr
-#include <netinet/udp.h>       // struct udphdr, SOL_UDP
-//#include <linux/udp.h> // UDP_GRO
-#define UDP_GRO 104
-#endif /* WITH_GSO */
+#ifdef __linux__
+#include <netinet/in.h>
+#include <netinet/udp.h>  // SOL_UDP
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103  // linux/udp.h
+#endif
+#endif /* __linux__ */
 
 #include <hicn/util/log.h>
 #include <hicn/util/sstrncpy.h>
 #include <hicn/util/ring.h>
 
 #include "base.h"
+#include "uring.h"
+#include "../config/configuration.h"
 #include "../core/address_pair.h"
 #include "../core/connection.h"
 #include "../core/connection_vft.h"
@@ -122,21 +124,6 @@ int socket_set_options(int fd) {
     return -1;
   }
 
-#ifdef WITH_GSO
-  int gso_size = ETH_DATA_LEN - sizeof(struct ipv6hdr) - sizeof(struct udphdr);
-  if (setsockopt(fd, SOL_UDP, UDP_SEGMENT, &gso_size, sizeof(gso_size)) < 0) {
-    perror("setsockopt");
-    return -1;
-  }
-#endif /* WITH_GSO */
-
-#ifdef WITH_GRO
-  if (setsockopt(fd, IPPROTO_UDP, UDP_GRO, &(int){1}, sizeof(int)) < 0) {
-    perror("setsockopt");
-    return -1;
-  }
-#endif /* WITH_GRO */
-
 #ifdef WITH_ZEROCOPY
   if (setsockopt(fd, SOL_SOCKET, SO_ZEROCOPY, &(int){1}, sizeof(int))) {
     perror("setsockopt");
@@ -194,6 +181,10 @@ static void listener_udp_finalize(listener_t *listener) {
   assert(listener);
   assert(listener->type == FACE_TYPE_UDP_LISTENER);
 
+#ifdef __linux__
+  io_gro_disable(listener->fd);
+#endif /* __linux__ */
+
   return;
 }
 
@@ -232,6 +223,17 @@ static int listener_udp_get_socket(const listener_t *listener,
     }
   }
 
+#ifdef __linux__
+  /*
+   * GRO is best effort: the listener keeps working with regular datagrams if
+   * the kernel does not support it. io_uring receives into MTU-sized buffers,
+   * which coalesced datagrams would not fit in.
+   */
+  configuration_t *config = forwarder_get_configuration(listener->forwarder);
+  if (configuration_get_udp_gro(config) && !listener_get_uring(listener))
+    io_gro_enable(fd);
+#endif /* __linux__ */
+
   return fd;
 
 ERR:
@@ -247,7 +249,7 @@ ERR_SOCKET:
 #define listener_udp_read_single io_read_single_socket
 
 #ifdef __linux__
-#define listener_udp_read_batch io_read_batch_socket
+#define listener_udp_read_batch io_read_batch_socket_gro
 #else
 #define listener_udp_read_batch NULL
 #endif /* __linux__ */
@@ -266,7 +268,19 @@ typedef struct {
   off_t *ring;
 
   struct mmsghdr msghdr[MAX_MSG];
-  struct iovec iovecs[MAX_MSG];
+  /* Packets are made of two buffers when their msgbuf is header-only */
+  struct iovec iovecs[2 * MAX_MSG];
+  /* Number of buffers of each packet */
+  unsigned n_iovecs[MAX_MSG];
+
+  /* Number of packets carried by each message (> 1 with GSO), and their size */
+  unsigned n_segments[MAX_MSG];
+  uint16_t segment_size[MAX_MSG];
+  union {
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+    struct cmsghdr align;
+  } control[MAX_MSG];
+  bool gso;
 #endif /* __linux__ */
 } connection_udp_data_t;
 
@@ -311,6 +325,24 @@ static int connection_udp_initialize(connection_t *connection) {
 #endif
             },
     };
+
+    struct cmsghdr *cmsg = &data->control[i].align;
+    cmsg->cmsg_level = SOL_UDP;
+    cmsg->cmsg_type = UDP_SEGMENT;
+    cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  }
+
+  /*
+   * GSO is only used if requested and supported by the kernel, which we
+   * check by querying the (socket-wide) segment size.
+   */
+  forwarder_t *forwarder = listener_get_forwarder(connection->listener);
+  data->gso = configuration_get_udp_gso(forwarder_get_configuration(forwarder));
+  if (data->gso && (getsockopt(connection->fd, SOL_UDP, UDP_SEGMENT, &(int){0},
+                               &(socklen_t){sizeof(int)}) < 0)) {
+    WARN("UDP GSO not supported on connection %s: %s", connection->name,
+         strerror(errno));
+    data->gso = false;
   }
 #endif /* __linux__ */
 
@@ -325,14 +357,112 @@ static void connection_udp_finalize(connection_t *connection) {
   assert(data);
 
   ring_free(data->ring);
+
+  if (connection->connected) io_gro_disable(connection->fd);
 #endif /* __linux__ */
 }
 
+#ifdef __linux__
+/*
+ * Hand over queued packets to the io_uring backend, which copies them and
+ * sends them all at once at the end of the batch. Packets which cannot be
+ * queued are left in the ring.
+ */
+static void connection_udp_flush_uring(connection_t *connection,
+                                       uring_t *uring) {
+  forwarder_t *forwarder = listener_get_forwarder(connection->listener);
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  connection_udp_data_t *data = connection->data;
+  const address_t *remote =
+      connection->connected ? NULL : connection_get_remote(connection);
+  off_t msgbuf_id = 0;
+  unsigned n = 0;
+  size_t i;
+
+  ring_enumerate_n(data->ring, i, &msgbuf_id, ring_get_size(data->ring), {
+    msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+    /* The packet is copied anyway */
+    msgbuf_pool_linearize(msgbuf_pool, msgbuf);
+    bool is_data = (msgbuf_get_type(msgbuf) == HICN_PACKET_TYPE_DATA);
+    hicn_path_label_t path_label;
+
+    // update path label
+    if (is_data) {
+      msgbuf_get_path_label(msgbuf, &path_label);
+      msgbuf_update_pathlabel(msgbuf, connection_get_id(connection));
+    }
+
+    if (uring_send(uring, connection->fd, remote, msgbuf_get_packet(msgbuf),
+                   msgbuf_get_len(msgbuf)) < 0) {
+      /* The packet will be sent again, with the original label */
+      if (is_data) msgbuf_set_path_label(msgbuf, path_label);
+      break;
+    }
+
+    if (is_data) {
+      connection->stats.data.tx_pkts++;
+      connection->stats.data.tx_bytes += msgbuf_get_len(msgbuf);
+    } else {
+      connection->stats.interests.tx_pkts++;
+      connection->stats.interests.tx_bytes += msgbuf_get_len(msgbuf);
+    }
+    n++;
+  });
+
+  connection->stats.io.tx_segments += n;
+  ring_advance(data->ring, n);
+}
+
+/*
+ * Prepare the messages to send, message m carrying the n_segments[m] next
+ * queued packets as a GSO super-datagram when there is more than one.
+ */
+static void connection_udp_build_messages(connection_udp_data_t *data,
+                                          unsigned n_messages) {
+  struct iovec *iov = data->iovecs;
+  unsigned p = 0;
+  for (unsigned m = 0; m < n_messages; m++) {
+    struct msghdr *hdr = &data->msghdr[m].msg_hdr;
+    hdr->msg_iov = iov;
+    hdr->msg_iovlen = 0;
+    for (unsigned s = 0; s < data->n_segments[m]; s++, p++)
+      hdr->msg_iovlen += data->n_iovecs[p];
+    iov += hdr->msg_iovlen;
+
+    if (data->n_segments[m] == 1) {
+      hdr->msg_control = NULL;
+      hdr->msg_controllen = 0;
+      continue;
+    }
+    memcpy(CMSG_DATA(&data->control[m].align), &data->segment_size[m],
+           sizeof(uint16_t));
+    hdr->msg_control = data->control[m].buf;
+    hdr->msg_controllen = sizeof(data->control[m].buf);
+  }
+}
+
+/*
+ * Send each packet in its own message, for instance after the kernel
+ * rejected segmentation offload.
+ */
+static unsigned connection_udp_unsegment(connection_udp_data_t *data,
+                                         unsigned n_packets) {
+  for (unsigned i = 0; i < n_packets; i++) data->n_segments[i] = 1;
+  connection_udp_build_messages(data, n_packets);
+  return n_packets;
+}
+#endif /* __linux__ */
+
 static bool connection_udp_flush(connection_t *connection) {
 #ifdef __linux__
   int retry = 0;
   off_t msgbuf_id = 0;
   unsigned cpt;
+  unsigned n_packets;
+  unsigned n_iovecs;
+  unsigned n_sent;
+  bool segmented;
+  size_t len[MAX_MSG];
   size_t i;
   int n;
 
@@ -344,6 +474,15 @@ static bool connection_udp_flush(connection_t *connection) {
 
   TRACE("[connection_udp_send] Flushing connection queue");
 
+  uring_t *uring = listener_get_uring(connection->listener);
+  if (uring) {
+    connection_udp_flush_uring(connection, uring);
+    if (ring_get_size(data->ring) == 0) return true;
+
+    /* Out of io_uring resources, remaining packets are sent directly */
+    uring_flush(uring);
+  }
+
   /* Flush operation */
 #ifdef WITH_ZEROCOPY
   int flags = MSG_ZEROCOPY;
@@ -354,29 +493,57 @@ static bool connection_udp_flush(connection_t *connection) {
 SEND:
   /* Consume up to MSG_MSG packets in ring buffer */
   cpt = 0;
+  n_packets = 0;
+  n_iovecs = 0;
+  segmented = false;
 
   ring_enumerate_n(data->ring, i, &msgbuf_id, MAX_MSG, {
     msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+    len[i] = msgbuf_get_len(msgbuf);
 
     // update path label
     if (msgbuf_get_type(msgbuf) == HICN_PACKET_TYPE_DATA) {
       msgbuf_update_pathlabel(msgbuf, connection_get_id(connection));
 
       connection->stats.data.tx_pkts++;
-      connection->stats.data.tx_bytes += msgbuf_get_len(msgbuf);
+      connection->stats.data.tx_bytes += len[i];
     } else {
       connection->stats.interests.tx_pkts++;
-      connection->stats.interests.tx_bytes += msgbuf_get_len(msgbuf);
+      connection->stats.interests.tx_bytes += len[i];
     }
 
-    data->iovecs[i].iov_base = msgbuf_get_packet(msgbuf);
-    data->iovecs[i].iov_len = msgbuf_get_len(msgbuf);
-    cpt++;
+    struct iovec *iov = &data->iovecs[n_iovecs];
+    unsigned iovlen = msgbuf_pool_get_iovecs(msgbuf_pool, msgbuf, iov);
+    data->n_iovecs[i] = iovlen;
+    n_iovecs += iovlen;
+    n_packets++;
   });
 
+  if (data->gso) {
+    cpt = io_gso_group(len, n_packets, data->n_segments, data->segment_size);
+    segmented = (cpt < n_packets);
+    connection_udp_build_messages(data, cpt);
+  } else {
+    cpt = connection_udp_unsegment(data, n_packets);
+  }
+
 SENDMMSG:
   n = sendmmsg(connection->fd, data->msghdr, cpt, flags);
   if (n == -1) {
+    /*
+     * Segmentation offload might be refused by the kernel or the device
+     * (EIO when checksum offload is not available): fall back to regular
+     * datagrams for this connection.
+     */
+    if (segmented && (errno == EIO || errno == EINVAL)) {
+      WARN("UDP GSO failed on connection %s (%s), disabling it",
+           connection->name, strerror(errno));
+      data->gso = false;
+      segmented = false;
+      cpt = connection_udp_unsegment(data, n_packets);
+      goto SENDMMSG;
+    }
+
     /* man(2)sendmmsg / BUGS
      *
      * If an error occurs after at least one message has been sent, the call
@@ -394,10 +561,15 @@ SENDMMSG:
     return false;
   }
 
-  ring_advance(data->ring, n);
+  n_sent = 0;
+  for (int m = 0; m < n; m++) n_sent += data->n_segments[m];
+  connection->stats.io.tx_calls++;
+  connection->stats.io.tx_segments += n_sent;
+
+  ring_advance(data->ring, n_sent);
 
   if (n < cpt) {
-    WARN("Unknown error after sending n=%d packets...", n);
+    WARN("Unknown error after sending n=%d packets...", n_sent);
     if (retry < 1) {
       retry++;
       goto SEND;
@@ -457,6 +629,7 @@ static bool connection_udp_send(connection_t *connection, msgbuf_t *msgbuf,
 
     ssize_t writeLength = write(connection->fd, msgbuf_get_packet(msgbuf),
                                 msgbuf_get_len(msgbuf));
+    connection->stats.io.tx_calls++;
 
     if (writeLength < 0) {
       if (errno == EAGAIN || errno == EWOULDBLOCK) {
@@ -469,6 +642,7 @@ static bool connection_udp_send(connection_t *connection, msgbuf_t *msgbuf,
         return false;
       }
     }
+    connection->stats.io.tx_segments++;
 #ifdef __linux__
   }
 #endif /* __linux__ */
@@ -0,0 +1,753 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file uring.c
+ * @brief Implementation of the io_uring I/O backend.
+ */
+
+#include <errno.h>
+#include <sched.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#ifdef __linux__
+#include <linux/io_uring.h>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#endif /* __linux__ */
+
+#include <hicn/util/log.h>
+
+#include "base.h"
+#include "uring.h"
+#include "../core/connection.h"
+#include "../core/forwarder.h"
+#include "../core/msgbuf_pool.h"
+#include "../core/ticks.h"
+
+#ifdef __linux__
+
+/* Size of the submission queue */
+#define URING_ENTRIES 1024
+
+/* Receive operations armed on each socket */
+#define URING_RX_DEPTH 16
+
+/*
+ * Receive slots are allocated by blocks as sockets get registered, so that
+ * slots in use never move. Sockets registered beyond the last block are left
+ * to the event loop.
+ */
+#define URING_RX_BLOCK_SLOTS 2048
+#define URING_RX_MAX_BLOCKS 4
+#define URING_RX_MAX_SLOTS (URING_RX_BLOCK_SLOTS * URING_RX_MAX_BLOCKS)
+
+/* Packets in flight towards the kernel */
+#define URING_TX_SLOTS 1024
+
+/* All operations in flight, including cancellations, must fit */
+#define URING_CQ_ENTRIES 32768
+
+/* Completions processed before yielding to the event loop */
+#define URING_COMPLETION_BUDGET URING_RX_BLOCK_SLOTS
+
+/* Idle time after which the kernel submission thread goes to sleep */
+#define URING_SQPOLL_IDLE_MS 100
+
+/* Attempts at handing queued entries over to the kernel in uring_flush */
+#define URING_FLUSH_ATTEMPTS 1000
+
+typedef enum {
+  URING_OP_RX = 1,
+  URING_OP_TX,
+  URING_OP_CANCEL,
+} uring_op_t;
+
+#define uring_user_data(op, i) (((uint64_t)(op) << 32) | (uint32_t)(i))
+#define uring_user_data_op(user_data) ((uring_op_t)((user_data) >> 32))
+#define uring_user_data_slot(user_data) ((unsigned)((user_data)&0xffffffff))
+
+typedef struct {
+  int fd; /* -1 when the slot is not in use */
+  bool cancelled;
+
+  /* Receive only */
+  listener_t *listener;
+  unsigned connection_id;
+
+  struct msghdr msg;
+  struct iovec iov;
+  struct sockaddr_storage addr;
+  uint8_t buffer[MTU];
+} uring_slot_t;
+
+struct uring_s {
+  forwarder_t *forwarder;
+  bool sqpoll;
+  int ring_fd;
+  int event_fd;
+  event_t *event;
+
+  /* Submission queue, shared with the kernel */
+  void *sq_ring;
+  size_t sq_ring_size;
+  unsigned *sq_head;
+  unsigned *sq_tail;
+  unsigned *sq_mask;
+  unsigned *sq_flags;
+  unsigned *sq_array;
+  unsigned sq_entries;
+  struct io_uring_sqe *sqes;
+  size_t sqes_size;
+  unsigned n_queued; /* entries not yet submitted */
+
+  /* Completion queue, shared with the kernel */
+  void *cq_ring;
+  size_t cq_ring_size;
+  unsigned *cq_head;
+  unsigned *cq_tail;
+  unsigned *cq_mask;
+  struct io_uring_cqe *cqes;
+
+  /* Buffers accessed by the kernel, which never move */
+  uring_slot_t *rx_blocks[URING_RX_MAX_BLOCKS];
+  unsigned n_rx_blocks;
+  unsigned *rx_free; /* sized for URING_RX_MAX_SLOTS */
+  unsigned n_rx_free;
+  uring_slot_t *tx;
+  unsigned *tx_free;
+  unsigned n_tx_free;
+
+  uring_stats_t stats;
+};
+
+#define uring_rx_slot(uring, i)                     \
+  (&(uring)->rx_blocks[(i) / URING_RX_BLOCK_SLOTS] \
+        [(i) % URING_RX_BLOCK_SLOTS])
+
+#define uring_n_rx_slots(uring) ((uring)->n_rx_blocks * URING_RX_BLOCK_SLOTS)
+
+static int sys_io_uring_setup(unsigned entries, struct io_uring_params *p) {
+  return (int)syscall(__NR_io_uring_setup, entries, p);
+}
+
+static int sys_io_uring_enter(int fd, unsigned to_submit, unsigned min_complete,
+                              unsigned flags) {
+  return (int)syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags,
+                      NULL, 0);
+}
+
+static int sys_io_uring_register(int fd, unsigned opcode, void *arg,
+                                 unsigned nr_args) {
+  return (int)syscall(__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+/******************************************************************************
+ * Submission
+ ******************************************************************************/
+
+void uring_submit(uring_t *uring) {
+  unsigned flags = 0;
+
+  if (uring->n_queued == 0) return;
+
+  if (uring->sqpoll) {
+    uring->n_queued = 0;
+    /* Order the tail update with respect to reading the flags */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (!(__atomic_load_n(uring->sq_flags, __ATOMIC_RELAXED) &
+          IORING_SQ_NEED_WAKEUP))
+      return;
+    flags |= IORING_ENTER_SQ_WAKEUP;
+  }
+
+  int rc = sys_io_uring_enter(uring->ring_fd, uring->n_queued, 0, flags);
+  uring->stats.n_submit_calls++;
+  if (rc < 0) {
+    /* Entries are left in the queue and submitted next time */
+    if (errno != EINTR && errno != EAGAIN && errno != EBUSY) {
+      ERROR("io_uring_enter failed: (%d) %s", errno, strerror(errno));
+      uring->stats.n_errors++;
+    }
+    return;
+  }
+  if (!uring->sqpoll) uring->n_queued -= rc;
+}
+
+void uring_flush(uring_t *uring) {
+  uring_submit(uring);
+
+  for (unsigned i = 0; i < URING_FLUSH_ATTEMPTS; i++) {
+    if (*uring->sq_tail == __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE))
+      return;
+    if (uring->sqpoll) {
+      /* Entries are consumed asynchronously by the submission thread */
+      if (__atomic_load_n(uring->sq_flags, __ATOMIC_RELAXED) &
+          IORING_SQ_NEED_WAKEUP)
+        sys_io_uring_enter(uring->ring_fd, 0, 0, IORING_ENTER_SQ_WAKEUP);
+      sched_yield();
+    } else {
+      uring_submit(uring);
+    }
+  }
+  WARN("io_uring entries still pending, packets might be reordered");
+}
+
+static struct io_uring_sqe *uring_get_sqe(uring_t *uring) {
+  unsigned tail = *uring->sq_tail;
+  unsigned head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+
+  if (tail - head >= uring->sq_entries) {
+    /* Queue full: hand pending entries over to the kernel */
+    uring_submit(uring);
+    head = __atomic_load_n(uring->sq_head, __ATOMIC_ACQUIRE);
+    if (tail - head >= uring->sq_entries) return NULL;
+  }
+
+  unsigned index = tail & *uring->sq_mask;
+  struct io_uring_sqe *sqe = &uring->sqes[index];
+  memset(sqe, 0, sizeof(struct io_uring_sqe));
+  uring->sq_array[index] = index;
+  return sqe;
+}
+
+static void uring_commit_sqe(uring_t *uring) {
+  __atomic_store_n(uring->sq_tail, *uring->sq_tail + 1, __ATOMIC_RELEASE);
+  uring->n_queued++;
+}
+
+static int uring_prep_msg(uring_t *uring, uint8_t opcode, uring_slot_t *slot,
+                          uint64_t user_data) {
+  struct io_uring_sqe *sqe = uring_get_sqe(uring);
+  if (!sqe) return -1;
+
+  sqe->opcode = opcode;
+  sqe->fd = slot->fd;
+  sqe->addr = (uint64_t)(uintptr_t)&slot->msg;
+  sqe->len = 1;
+  sqe->user_data = user_data;
+  uring_commit_sqe(uring);
+  return 0;
+}
+
+static int uring_arm_rx(uring_t *uring, unsigned i) {
+  uring_slot_t *slot = uring_rx_slot(uring, i);
+
+  slot->iov = (struct iovec){
+      .iov_base = slot->buffer,
+      .iov_len = MTU,
+  };
+  slot->msg = (struct msghdr){
+      .msg_name = &slot->addr,
+      .msg_namelen = sizeof(struct sockaddr_storage),
+      .msg_iov = &slot->iov,
+      .msg_iovlen = 1,
+  };
+
+  return uring_prep_msg(uring, IORING_OP_RECVMSG, slot,
+                        uring_user_data(URING_OP_RX, i));
+}
+
+static void uring_cancel(uring_t *uring, uint64_t user_data) {
+  struct io_uring_sqe *sqe = uring_get_sqe(uring);
+  if (!sqe) {
+    WARN("Could not cancel io_uring operation");
+    return;
+  }
+
+  sqe->opcode = IORING_OP_ASYNC_CANCEL;
+  sqe->fd = -1;
+  sqe->addr = user_data;
+  sqe->user_data = uring_user_data(URING_OP_CANCEL, 0);
+  uring_commit_sqe(uring);
+}
+
+static int uring_grow_rx(uring_t *uring) {
+  if (uring->n_rx_blocks == URING_RX_MAX_BLOCKS) return -1;
+
+  uring_slot_t *block = malloc(URING_RX_BLOCK_SLOTS * sizeof(uring_slot_t));
+  if (!block) return -1;
+
+  /* Free lists are used as stacks, hand out low indices first */
+  unsigned first = uring_n_rx_slots(uring);
+  for (unsigned i = 0; i < URING_RX_BLOCK_SLOTS; i++) {
+    block[i].fd = -1;
+    uring->rx_free[uring->n_rx_free++] = first + URING_RX_BLOCK_SLOTS - 1 - i;
+  }
+  uring->rx_blocks[uring->n_rx_blocks++] = block;
+  return 0;
+}
+
+int uring_listen(uring_t *uring, int fd, listener_t *listener,
+                 unsigned connection_id) {
+  assert(uring);
+  assert(listener);
+
+  if (uring->n_rx_free < URING_RX_DEPTH) uring_grow_rx(uring);
+
+  unsigned n_armed = 0;
+  while ((n_armed < URING_RX_DEPTH) && (uring->n_rx_free > 0)) {
+    unsigned i = uring->rx_free[--uring->n_rx_free];
+    uring_slot_t *slot = uring_rx_slot(uring, i);
+    slot->fd = fd;
+    slot->cancelled = false;
+    slot->listener = listener;
+    slot->connection_id = connection_id;
+
+    if (uring_arm_rx(uring, i) < 0) {
+      slot->fd = -1;
+      uring->rx_free[uring->n_rx_free++] = i;
+      break;
+    }
+    n_armed++;
+  }
+
+  if (n_armed == 0)
+    WARN("No receive operation could be armed on fd %d", fd);
+  else if (n_armed < URING_RX_DEPTH)
+    WARN("Only %u receive operations armed on fd %d", n_armed, fd);
+
+  uring_submit(uring);
+  return (n_armed > 0) ? 0 : -1;
+}
+
+void uring_unlisten(uring_t *uring, int fd) {
+  assert(uring);
+
+  for (unsigned i = 0; i < uring_n_rx_slots(uring); i++) {
+    uring_slot_t *slot = uring_rx_slot(uring, i);
+    if (slot->fd != fd || slot->cancelled) continue;
+
+    /* The slot is released once the cancellation completes */
+    slot->cancelled = true;
+    slot->listener = NULL;
+    uring_cancel(uring, uring_user_data(URING_OP_RX, i));
+  }
+  uring_submit(uring);
+}
+
+int uring_send(uring_t *uring, int fd, const address_t *remote,
+               const uint8_t *packet, size_t size) {
+  assert(uring);
+
+  if (size > MTU || uring->n_tx_free == 0) goto ERR;
+
+  unsigned i = uring->tx_free[--uring->n_tx_free];
+  uring_slot_t *slot = &uring->tx[i];
+  slot->fd = fd;
+
+  memcpy(slot->buffer, packet, size);
+  slot->iov = (struct iovec){
+      .iov_base = slot->buffer,
+      .iov_len = size,
+  };
+  slot->msg = (struct msghdr){
+      .msg_iov = &slot->iov,
+      .msg_iovlen = 1,
+  };
+  if (remote) {
+    memcpy(&slot->addr, address_sa(remote), address_socklen(remote));
+    slot->msg.msg_name = &slot->addr;
+    slot->msg.msg_namelen = address_socklen(remote);
+  }
+
+  if (uring_prep_msg(uring, IORING_OP_SENDMSG, slot,
+                     uring_user_data(URING_OP_TX, i)) < 0) {
+    slot->fd = -1;
+    uring->tx_free[uring->n_tx_free++] = i;
+    goto ERR;
+  }
+
+  return 0;
+
+ERR:
+  uring->stats.n_tx_fallbacks++;
+  return -1;
+}
+
+/******************************************************************************
+ * Completion
+ ******************************************************************************/
+
+static void uring_release_rx(uring_t *uring, unsigned i) {
+  uring_slot_t *slot = uring_rx_slot(uring, i);
+  slot->fd = -1;
+  slot->listener = NULL;
+  uring->rx_free[uring->n_rx_free++] = i;
+}
+
+static void uring_release_tx(uring_t *uring, unsigned i) {
+  uring->tx[i].fd = -1;
+  uring->tx_free[uring->n_tx_free++] = i;
+}
+
+static void uring_on_rx(uring_t *uring, unsigned i, int res) {
+  uring_slot_t *slot = uring_rx_slot(uring, i);
+
+  if (slot->cancelled || res == -ECANCELED) {
+    uring_release_rx(uring, i);
+    return;
+  }
+
+  if (res < 0) {
+    /* ICMP unreachable due to closing the remote end of a connection */
+    if (res != -ECONNREFUSED && res != -EINTR && res != -EAGAIN) {
+      ERROR("receive failed on fd %d: (%d) %s", slot->fd, -res,
+            strerror(-res));
+      uring->stats.n_errors++;
+      uring_release_rx(uring, i);
+      return;
+    }
+    goto REARM;
+  }
+
+  if (res == 0 || (slot->msg.msg_flags & MSG_TRUNC)) goto REARM;
+
+  forwarder_t *forwarder = uring->forwarder;
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  listener_t *listener = slot->listener;
+
+  msgbuf_t *msgbuf;
+  off_t msgbuf_id = msgbuf_pool_get(msgbuf_pool, &msgbuf);
+  if (!msgbuf_id_is_valid(msgbuf_id)) {
+    ERROR("Unable to get message buffer");
+    goto REARM;
+  }
+
+  memcpy(msgbuf_get_packet(msgbuf), slot->buffer, res);
+  msgbuf_set_len(msgbuf, (size_t)res);
+  msgbuf_pool_acquire(msgbuf);
+  msgbuf_set_connection_id(msgbuf, slot->connection_id);
+  forwarder_acquired_msgbuf_ids_push(forwarder, msgbuf_id);
+
+  address_pair_t pair;
+  memset(&pair, 0, sizeof(address_pair_t));
+  pair.local = listener->address;
+  memcpy(address_pair_get_remote(&pair), &slot->addr, slot->msg.msg_namelen);
+
+  forwarder_receive(forwarder, listener, msgbuf_id, &pair, usecs_now());
+  uring->stats.n_rx++;
+
+REARM:
+  if (uring_arm_rx(uring, i) < 0) {
+    WARN("Could not re-arm receive operation on fd %d", slot->fd);
+    uring_release_rx(uring, i);
+  }
+}
+
+static void uring_on_tx(uring_t *uring, unsigned i, int res) {
+  if (res < 0) {
+    DEBUG("send failed on fd %d: (%d) %s", uring->tx[i].fd, -res,
+          strerror(-res));
+    uring->stats.n_errors++;
+  } else {
+    uring->stats.n_tx++;
+  }
+  uring_release_tx(uring, i);
+}
+
+/*
+ * Process up to budget completions, the callback being NULL when the ring is
+ * being torn down. Returns the number of completions processed.
+ */
+static unsigned uring_reap(uring_t *uring, unsigned budget,
+                           void (*on_rx)(uring_t *, unsigned, int)) {
+  unsigned head = *uring->cq_head;
+  unsigned n = 0;
+
+  while (n < budget) {
+    if (head == __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE)) break;
+
+    struct io_uring_cqe *cqe = &uring->cqes[head & *uring->cq_mask];
+    uint64_t user_data = cqe->user_data;
+    int res = cqe->res;
+
+    /* Free the entry before processing as it may submit new operations */
+    head++;
+    __atomic_store_n(uring->cq_head, head, __ATOMIC_RELEASE);
+    n++;
+
+    unsigned i = uring_user_data_slot(user_data);
+    switch (uring_user_data_op(user_data)) {
+      case URING_OP_RX:
+        if (on_rx)
+          on_rx(uring, i, res);
+        else
+          uring_release_rx(uring, i);
+        break;
+      case URING_OP_TX:
+        uring_on_tx(uring, i, res);
+        break;
+      case URING_OP_CANCEL:
+        break;
+    }
+  }
+
+  return n;
+}
+
+static bool uring_has_completions(const uring_t *uring) {
+  return *uring->cq_head != __atomic_load_n(uring->cq_tail, __ATOMIC_ACQUIRE);
+}
+
+static int uring_on_event(void *owner, int fd, unsigned id, void *data) {
+  uring_t *uring = (uring_t *)owner;
+  uint64_t value;
+
+  /* The eventfd is non blocking, and only used as a notification */
+  if (read(uring->event_fd, &value, sizeof(value)) < 0 && errno != EAGAIN)
+    WARN("Could not read io_uring eventfd: %s", strerror(errno));
+
+  forwarder_t *forwarder = uring->forwarder;
+  msgbuf_pool_t *msgbuf_pool = forwarder_get_msgbuf_pool(forwarder);
+  forwarder_acquired_msgbuf_ids_reset(forwarder);
+
+  uring_reap(uring, URING_COMPLETION_BUDGET, uring_on_rx);
+
+  /*
+   * Signal to the forwarder that we reached the end of a batch and we need to
+   * flush connections out (which submits both sends and receives re-armed
+   * above).
+   */
+  forwarder_flush_connections(forwarder);
+
+  const off_t *acquired_msgbuf_ids =
+      forwarder_get_acquired_msgbuf_ids(forwarder);
+  for (int i = 0; i < vector_len(acquired_msgbuf_ids); i++) {
+    msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool, acquired_msgbuf_ids[i]);
+    msgbuf_pool_release(msgbuf_pool, &msgbuf);
+  }
+
+  /* Come back for the remaining completions after other events */
+  if (uring_has_completions(uring)) {
+    value = 1;
+    if (write(uring->event_fd, &value, sizeof(value)) < 0)
+      WARN("Could not write io_uring eventfd: %s", strerror(errno));
+  }
+
+  return 0;
+}
+
+/******************************************************************************
+ * Setup
+ ******************************************************************************/
+
+/*
+ * Wait for all operations to complete, so that the kernel no longer accesses
+ * the buffers.
+ */
+static void uring_drain(uring_t *uring) {
+  for (unsigned i = 0; i < uring_n_rx_slots(uring); i++) {
+    uring_slot_t *slot = uring_rx_slot(uring, i);
+    if (slot->fd < 0 || slot->cancelled) continue;
+    slot->cancelled = true;
+    uring_cancel(uring, uring_user_data(URING_OP_RX, i));
+  }
+  uring_submit(uring);
+
+  for (unsigned retries = 0; retries < 100; retries++) {
+    uring_reap(uring, URING_CQ_ENTRIES, NULL);
+    if (uring->n_rx_free == uring_n_rx_slots(uring) &&
+        uring->n_tx_free == URING_TX_SLOTS)
+      return;
+    if (sys_io_uring_enter(uring->ring_fd, uring->sqpoll ? 0 : uring->n_queued,
+                           1, IORING_ENTER_GETEVENTS) >= 0 &&
+        !uring->sqpoll)
+      uring->n_queued = 0;
+  }
+  WARN("Some io_uring operations did not complete");
+}
+
+/* Release resources of a (possibly partially initialized) ring */
+static void uring_release(uring_t *uring) {
+  if (uring->event) {
+    loop_event_unregister(uring->event);
+    loop_event_free(uring->event);
+  }
+  if (uring->rx_free && uring->tx && uring->cqes) uring_drain(uring);
+
+  if (uring->sqes) munmap(uring->sqes, uring->sqes_size);
+  if (uring->cq_ring && uring->cq_ring != uring->sq_ring)
+    munmap(uring->cq_ring, uring->cq_ring_size);
+  if (uring->sq_ring) munmap(uring->sq_ring, uring->sq_ring_size);
+  if (uring->ring_fd >= 0) close(uring->ring_fd);
+  if (uring->event_fd >= 0) close(uring->event_fd);
+
+  for (unsigned i = 0; i < uring->n_rx_blocks; i++) free(uring->rx_blocks[i]);
+  free(uring->rx_free);
+  free(uring->tx);
+  free(uring->tx_free);
+  free(uring);
+}
+
+static int uring_map(uring_t *uring, const struct io_uring_params *params) {
+  uring->sq_ring_size =
+      params->sq_off.array + params->sq_entries * sizeof(unsigned);
+  uring->cq_ring_size =
+      params->cq_off.cqes + params->cq_entries * sizeof(struct io_uring_cqe);
+  bool single_mmap = params->features & IORING_FEAT_SINGLE_MMAP;
+  if (single_mmap) {
+    if (uring->cq_ring_size > uring->sq_ring_size)
+      uring->sq_ring_size = uring->cq_ring_size;
+    uring->cq_ring_size = uring->sq_ring_size;
+  }
+
+  void *ptr =
+      mmap(NULL, uring->sq_ring_size, PROT_READ | PROT_WRITE,
+           MAP_SHARED | MAP_POPULATE, uring->ring_fd, IORING_OFF_SQ_RING);
+  if (ptr == MAP_FAILED) return -1;
+  uring->sq_ring = ptr;
+
+  if (single_mmap) {
+    uring->cq_ring = uring->sq_ring;
+  } else {
+    ptr = mmap(NULL, uring->cq_ring_size, PROT_READ | PROT_WRITE,
+               MAP_SHARED | MAP_POPULATE, uring->ring_fd, IORING_OFF_CQ_RING);
+    if (ptr == MAP_FAILED) return -1;
+    uring->cq_ring = ptr;
+  }
+
+  uring->sqes_size = params->sq_entries * sizeof(struct io_uring_sqe);
+  ptr = mmap(NULL, uring->sqes_size, PROT_READ | PROT_WRITE,
+             MAP_SHARED | MAP_POPULATE, uring->ring_fd, IORING_OFF_SQES);
+  if (ptr == MAP_FAILED) return -1;
+  uring->sqes = ptr;
+
+  uint8_t *sq = uring->sq_ring;
+  uring->sq_head = (unsigned *)(sq + params->sq_off.head);
+  uring->sq_tail = (unsigned *)(sq + params->sq_off.tail);
+  uring->sq_mask = (unsigned *)(sq + params->sq_off.ring_mask);
+  uring->sq_flags = (unsigned *)(sq + params->sq_off.flags);
+  uring->sq_array = (unsigned *)(sq + params->sq_off.array);
+  uring->sq_entries = params->sq_entries;
+
+  uint8_t *cq = uring->cq_ring;
+  uring->cq_head = (unsigned *)(cq + params->cq_off.head);
+  uring->cq_tail = (unsigned *)(cq + params->cq_off.tail);
+  uring->cq_mask = (unsigned *)(cq + params->cq_off.ring_mask);
+  uring->cqes = (struct io_uring_cqe *)(cq + params->cq_off.cqes);
+
+  return 0;
+}
+
+uring_t *uring_create(forwarder_t *forwarder, bool sqpoll) {
+  assert(forwarder);
+
+  uring_t *uring = calloc(1, sizeof(uring_t));
+  if (!uring) return NULL;
+
+  uring->forwarder = forwarder;
+  uring->sqpoll = sqpoll;
+  uring->ring_fd = -1;
+  uring->event_fd = -1;
+
+  struct io_uring_params params;
+  memset(&params, 0, sizeof(struct io_uring_params));
+  params.flags = IORING_SETUP_CQSIZE;
+  params.cq_entries = URING_CQ_ENTRIES;
+  if (sqpoll) {
+    params.flags |= IORING_SETUP_SQPOLL;
+    params.sq_thread_idle = URING_SQPOLL_IDLE_MS;
+  }
+
+  uring->ring_fd = sys_io_uring_setup(URING_ENTRIES, &params);
+  if (uring->ring_fd < 0) {
+    WARN("io_uring_setup failed: %s", strerror(errno));
+    goto ERR;
+  }
+
+  if (uring_map(uring, &params) < 0) {
+    ERROR("Could not map io_uring queues: %s", strerror(errno));
+    goto ERR;
+  }
+
+  uring->rx_free = malloc(URING_RX_MAX_SLOTS * sizeof(unsigned));
+  uring->tx = malloc(URING_TX_SLOTS * sizeof(uring_slot_t));
+  uring->tx_free = malloc(URING_TX_SLOTS * sizeof(unsigned));
+  if (!uring->rx_free || !uring->tx || !uring->tx_free) goto ERR;
+  if (uring_grow_rx(uring) < 0) goto ERR;
+
+  /* Free lists are used as stacks, hand out low indices first */
+  for (unsigned i = 0; i < URING_TX_SLOTS; i++) {
+    uring->tx[i].fd = -1;
+    uring->tx_free[i] = URING_TX_SLOTS - 1 - i;
+  }
+  uring->n_tx_free = URING_TX_SLOTS;
+
+  uring->event_fd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+  if (uring->event_fd < 0) {
+    ERROR("eventfd failed: %s", strerror(errno));
+    goto ERR;
+  }
+  if (sys_io_uring_register(uring->ring_fd, IORING_REGISTER_EVENTFD,
+                            &uring->event_fd, 1) < 0) {
+    ERROR("Could not register io_uring eventfd: %s", strerror(errno));
+    goto ERR;
+  }
+
+  loop_fd_event_create(&uring->event, MAIN_LOOP, uring->event_fd, uring,
+                       uring_on_event, 0, NULL);
+  if (!uring->event) goto ERR;
+  if (loop_fd_event_register(uring->event) < 0) goto ERR;
+
+  INFO("Using io_uring I/O backend%s", sqpoll ? " with SQPOLL" : "");
+  return uring;
+
+ERR:
+  uring_release(uring);
+  return NULL;
+}
+
+void uring_free(uring_t *uring) {
+  assert(uring);
+  uring_release(uring);
+}
+
+uring_stats_t uring_get_stats(const uring_t *uring) { return uring->stats; }
+
+#else
+
+uring_t *uring_create(forwarder_t *forwarder, bool sqpoll) {
+  WARN("io_uring is only available on Linux");
+  return NULL;
+}
+
+void uring_free(uring_t *uring) {}
+
+int uring_listen(uring_t *uring, int fd, listener_t *listener,
+                 unsigned connection_id) {
+  return -1;
+}
+
+void uring_unlisten(uring_t *uring, int fd) {}
+
+int uring_send(uring_t *uring, int fd, const address_t *remote,
+               const uint8_t *packet, size_t size) {
+  return -1;
+}
+
+void uring_submit(uring_t *uring) {}
+
+void uring_flush(uring_t *uring) {}
+
+uring_stats_t uring_get_stats(const uring_t *uring) {
+  return (uring_stats_t){0};
+}
+
+#endif /* __linux__ */
@@ -0,0 +1,124 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * @file uring.h
+ * @brief io_uring based I/O backend for datagram sockets.
+ *
+ * Instead of waiting for sockets to become readable and issuing a recvmmsg
+ * per batch, a fixed number of receive operations is kept armed on each
+ * registered socket. Completions are signalled to the event loop through an
+ * eventfd, and a single callback processes all packets received across
+ * sockets before flushing connections.
+ *
+ * Packets queued on connections are submitted as send operations which are
+ * handed over to the kernel at most once per batch (io_uring_enter), or not
+ * at all when a kernel submission thread is used (SQPOLL).
+ *
+ * The kernel accesses buffers asynchronously, while the msgbuf pool may be
+ * reallocated when it grows: packets are therefore received into and sent
+ * from buffers owned by the ring, which never move.
+ *
+ * The ring is accessed directly through system calls, and does not require
+ * liburing.
+ */
+
+#ifndef HICNLIGHT_IO_URING_H
+#define HICNLIGHT_IO_URING_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include "../core/address.h"
+#include "../core/listener.h"
+
+typedef struct forwarder_s forwarder_t;
+
+typedef struct uring_s uring_t;
+
+typedef struct {
+  uint64_t n_submit_calls;  // io_uring_enter system calls
+  uint64_t n_rx;            // packets received
+  uint64_t n_tx;            // packets sent
+  uint64_t n_tx_fallbacks;  // flushes completed with regular system calls
+  uint64_t n_errors;
+} uring_stats_t;
+
+/**
+ * @brief Create an io_uring instance for the forwarder running in the calling
+ * thread, and register its completion events in MAIN_LOOP.
+ *
+ * @param[in] forwarder - Forwarder processing received packets
+ * @param[in] sqpoll - Whether to use a kernel thread polling for submissions
+ *
+ * @return The ring, or NULL if io_uring is not available.
+ */
+uring_t *uring_create(forwarder_t *forwarder, bool sqpoll);
+
+void uring_free(uring_t *uring);
+
+/**
+ * @brief Keep receive operations armed on a datagram socket.
+ *
+ * Packets are processed as if they had been read by listener_read_batch on
+ * the same socket.
+ *
+ * @param[in] fd - Socket to read from
+ * @param[in] listener - Listener receiving packets
+ * @param[in] connection_id - Connection owning the socket if connected, or
+ * CONNECTION_ID_UNDEFINED
+ *
+ * @return 0 on success, -1 if no receive operation could be armed, in which
+ * case the caller should read the socket through the event loop instead.
+ */
+int uring_listen(uring_t *uring, int fd, listener_t *listener,
+                 unsigned connection_id);
+
+/**
+ * @brief Cancel receive operations pending on a socket, before it is closed.
+ */
+void uring_unlisten(uring_t *uring, int fd);
+
+/**
+ * @brief Queue a packet for transmission.
+ *
+ * The packet is copied, and can be released as soon as the function returns.
+ *
+ * @param[in] remote - Destination address, or NULL for connected sockets
+ *
+ * @return 0 on success, -1 if no more packets can be queued, in which case
+ * the caller should send the packet itself.
+ */
+int uring_send(uring_t *uring, int fd, const address_t *remote,
+               const uint8_t *packet, size_t size);
+
+/**
+ * @brief Submit queued operations to the kernel.
+ */
+void uring_submit(uring_t *uring);
+
+/**
+ * @brief Submit queued operations and wait for the kernel to have issued them.
+ *
+ * This is used before sending packets with regular system calls when
+ * uring_send fails, so that they do not overtake packets still queued in the
+ * ring.
+ */
+void uring_flush(uring_t *uring);
+
+uring_stats_t uring_get_stats(const uring_t *uring);
+
+#endif /* HICNLIGHT_IO_URING_H */
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <hicn/hicn-light/config.h>
+
+#include <hicn/core/nexthops.h>
+#include <hicn/core/strategy.h>
+#include <hicn/core/strategy_vft.h>
+
+#include "low_latency.h"
+
+/* Decay of the exploration probability for each interest */
+#define EXPLORE_DECAY 0.99
+
+/* Gain of the moving average of the loss rate */
+#define LOSS_ALPHA (1.0 / 16)
+#define MAX_LOSS 0.9
+
+/* Next hops with a cost within 10% of the best one are used in parallel */
+#define SIMILAR_COST 0.1
+
+/* Shorthand */
+#define nexthop_state_t strategy_low_latency_nexthop_state_t
+#define strategy_state_t strategy_low_latency_state_t
+#define nexthop_state(nexthops, i) (&nexthops->state[i].low_latency)
+
+static const nexthop_state_t NEXTHOP_STATE_INIT = {
+    .pending = 0,
+    .loss = 0.0,
+};
+
+static inline void reset_all(nexthops_t *nexthops) {
+  for (unsigned i = 0; i < nexthops_get_len(nexthops); i++)
+    nexthops->state[i].low_latency = NEXTHOP_STATE_INIT;
+}
+
+/*
+ * The state of next hops is only reset when they are added, and might have
+ * been left by another strategy otherwise.
+ */
+static inline void check_reset(strategy_entry_t *entry, nexthops_t *nexthops) {
+  strategy_state_t *state = &entry->state.low_latency;
+  if (!state->reset) return;
+  reset_all(nexthops);
+  state->reset = false;
+}
+
+/* A next hop is probed with a single interest before it is compared */
+static inline bool is_unprobed(const nexthops_t *nexthops, unsigned i) {
+  const nexthop_state_t *state = nexthop_state(nexthops, i);
+  return (nexthops->state[i].rtt.n_samples == 0) && (state->pending == 0) &&
+         (state->loss == 0);
+}
+
+/*
+ * Expected latency of a next hop in microseconds: RTT, with a margin for its
+ * variation, scaled by the expected number of transmissions given the loss
+ * rate.
+ */
+static inline double get_cost(const nexthops_t *nexthops, unsigned i) {
+  const rtt_stats_t *rtt = &nexthops->state[i].rtt;
+  if (rtt->n_samples == 0) return INFINITY;
+
+  double loss = nexthop_state(nexthops, i)->loss;
+  if (loss > MAX_LOSS) loss = MAX_LOSS;
+  return ((double)rtt->srtt + rtt->rttvar + 1) / (1 - loss);
+}
+
+static inline void update_loss(nexthop_state_t *state, double sample) {
+  state->loss = state->loss * (1 - LOSS_ALPHA) + sample * LOSS_ALPHA;
+}
+
+static inline void update_pending_dec(nexthop_state_t *state) {
+  if (state->pending > 0) state->pending--;
+}
+
+static int strategy_low_latency_initialize(strategy_entry_t *entry,
+                                           const void *forwarder) {
+  entry->forwarder = forwarder;
+  entry->state.low_latency = (strategy_state_t){
+      .explore = LOW_LATENCY_EXPLORE_MAX,
+      .reset = true,
+  };
+  return 0;
+}
+
+static int strategy_low_latency_finalize(strategy_entry_t *entry) {
+  /* Nothing to do */
+  return 0;
+}
+
+static int strategy_low_latency_add_nexthop(strategy_entry_t *entry,
+                                            nexthops_t *nexthops,
+                                            off_t offset) {
+  check_reset(entry, nexthops);
+  nexthops->state[offset].low_latency = NEXTHOP_STATE_INIT;
+  /* Explore again to position the new next hop */
+  entry->state.low_latency.explore = LOW_LATENCY_EXPLORE_MAX;
+  return 0;
+}
+
+static int strategy_low_latency_remove_nexthop(strategy_entry_t *entry,
+                                               nexthops_t *nexthops,
+                                               off_t offset) {
+  entry->state.low_latency.explore = LOW_LATENCY_EXPLORE_MAX;
+  return 0;
+}
+
+static nexthops_t *strategy_low_latency_lookup_nexthops(
+    strategy_entry_t *entry, nexthops_t *nexthops, const msgbuf_t *msgbuf) {
+  if (nexthops_get_curlen(nexthops) == 0) return nexthops;
+  check_reset(entry, nexthops);
+  strategy_state_t *state = &entry->state.low_latency;
+
+  /*
+   * Find the best next hop among those below the cap on pending interests, or
+   * the least loaded one if they are all above.
+   */
+  off_t selected = INVALID_NEXTHOP;
+  off_t least_pending = INVALID_NEXTHOP;
+  double best_cost = INFINITY;
+  unsigned n_eligible = 0;
+  nexthops_enumerate(nexthops, i, nexthop, {
+    if (is_unprobed(nexthops, i)) {
+      selected = i;
+      goto SELECT;
+    }
+    unsigned pending = nexthop_state(nexthops, i)->pending;
+    if ((least_pending == INVALID_NEXTHOP) ||
+        (pending < nexthop_state(nexthops, least_pending)->pending))
+      least_pending = i;
+    if (pending >= LOW_LATENCY_MAX_PENDING) continue;
+    n_eligible++;
+    double cost = get_cost(nexthops, i);
+    if ((selected == INVALID_NEXTHOP) || (cost < best_cost)) {
+      selected = i;
+      best_cost = cost;
+    }
+  });
+
+  if (n_eligible == 0) {
+    selected = least_pending;
+    goto SELECT;
+  }
+
+  /* Exploration: pick uniformly among other eligible next hops */
+  double draw = (double)rand() / ((double)RAND_MAX + 1);
+  if (state->explore > LOW_LATENCY_EXPLORE_MIN)
+    state->explore *= EXPLORE_DECAY;
+  if ((n_eligible > 1) && (draw < state->explore)) {
+    unsigned target = rand() % (n_eligible - 1);
+    nexthops_enumerate(nexthops, i, nexthop, {
+      if ((i == selected) ||
+          (nexthop_state(nexthops, i)->pending >= LOW_LATENCY_MAX_PENDING))
+        continue;
+      if (target-- == 0) {
+        selected = i;
+        goto SELECT;
+      }
+    });
+  }
+
+  /* Split the load among next hops with a cost similar to the best one */
+  double max_cost = best_cost * (1 + SIMILAR_COST);
+  nexthops_enumerate(nexthops, i, nexthop, {
+    const nexthop_state_t *nh_state = nexthop_state(nexthops, i);
+    if (nh_state->pending >= LOW_LATENCY_MAX_PENDING) continue;
+    if (get_cost(nexthops, i) > max_cost) continue;
+    if (nh_state->pending < nexthop_state(nexthops, selected)->pending)
+      selected = i;
+  });
+
+SELECT:
+  nexthops_select(nexthops, selected);
+  nexthop_state(nexthops, selected)->pending++;
+  return nexthops;
+}
+
+static int strategy_low_latency_on_data(strategy_entry_t *entry,
+                                        nexthops_t *nexthops,
+                                        const nexthops_t *data_nexthops,
+                                        const msgbuf_t *msgbuf,
+                                        Ticks pitEntryCreation,
+                                        Ticks objReception) {
+  check_reset(entry, nexthops);
+
+  /*
+   * The RTT sample has already been recorded in the nexthop state by the FIB
+   * entry. The data is not a loss for the next hop it has been received from,
+   * and other next hops (if any) will not answer anymore.
+   */
+  nexthop_t ingress = msgbuf_get_connection_id(msgbuf);
+  nexthops_foreach(data_nexthops, nexthop, {
+    off_t i = nexthops_find_any(nexthops, nexthop);
+    if (i < 0 || i >= nexthops_get_len(nexthops)) continue;
+    update_pending_dec(nexthop_state(nexthops, i));
+    if (nexthop == ingress) update_loss(nexthop_state(nexthops, i), 0);
+  });
+  return 0;
+}
+
+static int strategy_low_latency_on_timeout(strategy_entry_t *entry,
+                                           nexthops_t *nexthops,
+                                           const nexthops_t *timeout_nexthops) {
+  check_reset(entry, nexthops);
+
+  nexthops_foreach(timeout_nexthops, nexthop, {
+    off_t i = nexthops_find_any(nexthops, nexthop);
+    if (i < 0 || i >= nexthops_get_len(nexthops)) continue;
+    update_pending_dec(nexthop_state(nexthops, i));
+    update_loss(nexthop_state(nexthops, i), 1);
+  });
+  return 0;
+}
+
+#undef nexthop_state_t
+#undef strategy_state_t
+
+DECLARE_STRATEGY(low_latency);
+
+#undef nexthop_state_t
+#undef strategy_state_t
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/**
+ * Forward on the path with the lowest expected latency, as measured by the PIT
+ * (RTT of satisfied interests, and loss rate from timeouts). Paths with
+ * similar latency are used in parallel, and a decaying fraction of interests
+ * is sent on other paths to keep their estimates up to date.
+ */
+
+#ifndef HICNLIGHT_STRATEGY_LOW_LATENCY_H
+#define HICNLIGHT_STRATEGY_LOW_LATENCY_H
+
+#include <stdbool.h>
+
+/* Maximum number of pending interests on a next hop */
+#define LOW_LATENCY_MAX_PENDING 1024
+
+/* Exploration probability, decaying for each interest between these bounds */
+#define LOW_LATENCY_EXPLORE_MAX 0.2
+#define LOW_LATENCY_EXPLORE_MIN 0.01
+
+typedef struct {
+  /* Interests forwarded on this next hop and not yet satisfied or expired */
+  unsigned int pending;
+  /* Loss rate (moving average of timeouts) */
+  double loss;
+} strategy_low_latency_nexthop_state_t;
+
+typedef struct {
+  double explore;
+  /* Next hop states have to be reset before use (eg. strategy change) */
+  bool reset;
+} strategy_low_latency_state_t;
+
+typedef struct {
+  void *_;
+} strategy_low_latency_options_t;
+
+#endif /* HICNLIGHT_STRATEGY_LOW_LATENCY_H */
@@ -298,4 +298,129 @@ TEST_F(ConnectionTableTest, GenerateConnNameExhaustion) {
   }
 
   EXPECT_TRUE(unable_to_allocate);
-}
\ No newline at end of file
+}
+/*
+ * Allocate a connection and initialize the fields used by the table upon
+ * deallocation.
+ */
+static connection_t *allocate_connection(connection_table_t *table,
+                                         const address_pair_t *pair,
+                                         const char *name) {
+  const char *allocated_name = NULL;
+  connection_t *conn =
+      _connection_table_allocate(table, pair, name, &allocated_name);
+  if (!conn) return NULL;
+  memset(conn, 0, sizeof(connection_t));
+  conn->type = FACE_TYPE_TCP;
+  conn->name = strdup(allocated_name);  // released by connection_finalize
+  conn->pair = *pair;
+  return conn;
+}
+
+static void remove_connection(connection_table_t *table, unsigned id) {
+  char *name = connection_get_name(connection_table_at(table, id));
+  connection_table_remove_by_id(table, id);
+  free(name);
+}
+
+TEST_F(ConnectionTableTest, SharedRegistrySameIdAndName) {
+  connection_registry_t *registry = connection_registry_create();
+  connection_table_t *table2 = connection_table_create();
+  ASSERT_EQ(connection_table_set_registry(conn_table_, registry), 0);
+  ASSERT_EQ(connection_table_set_registry(table2, registry), 0);
+
+  address_pair_t pair2 =
+      address_pair_factory(_ADDRESS4_LOCALHOST(1), _ADDRESS4_LOCALHOST(3));
+  address_pair_t pair3 =
+      address_pair_factory(_ADDRESS4_LOCALHOST(1), _ADDRESS4_LOCALHOST(4));
+
+  // Table 1 learns pair_ first, table 2 pair2 first
+  connection_t *c1 = allocate_connection(conn_table_, &pair_, CONNECTION_NAME);
+  connection_t *c2 = allocate_connection(table2, &pair2, CONNECTION_NAME_2);
+  ASSERT_NE(c1, nullptr);
+  ASSERT_NE(c2, nullptr);
+  unsigned id1 = connection_table_get_connection_id(conn_table_, c1);
+  unsigned id2 = connection_table_get_connection_id(table2, c2);
+  EXPECT_NE(id1, id2);
+
+  // The same pairs are attributed the same ids and names in the other table,
+  // whatever the requested name
+  connection_t *c = allocate_connection(table2, &pair_, "other");
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(connection_table_get_connection_id(table2, c), id1);
+  EXPECT_STREQ(connection_get_name(c), CONNECTION_NAME);
+  EXPECT_EQ(connection_table_get_id_by_name(table2, CONNECTION_NAME), id1);
+
+  c = allocate_connection(conn_table_, &pair2, "other");
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(connection_table_get_connection_id(conn_table_, c), id2);
+  EXPECT_STREQ(connection_get_name(c), CONNECTION_NAME_2);
+
+  // A name cannot be reused for another pair
+  EXPECT_EQ(allocate_connection(table2, &pair3, CONNECTION_NAME), nullptr);
+  EXPECT_EQ(connection_table_get_by_pair(table2, &pair3), nullptr);
+
+  connection_table_set_registry(conn_table_, NULL);
+  connection_table_set_registry(table2, NULL);
+  connection_table_free(table2);
+  connection_registry_free(registry);
+}
+
+TEST_F(ConnectionTableTest, SharedRegistryIdReleasedWhenUnused) {
+  connection_registry_t *registry = connection_registry_create();
+  connection_table_t *table2 = connection_table_create();
+  ASSERT_EQ(connection_table_set_registry(conn_table_, registry), 0);
+  ASSERT_EQ(connection_table_set_registry(table2, registry), 0);
+
+  address_pair_t pair2 =
+      address_pair_factory(_ADDRESS4_LOCALHOST(1), _ADDRESS4_LOCALHOST(3));
+  address_pair_t pair3 =
+      address_pair_factory(_ADDRESS4_LOCALHOST(1), _ADDRESS4_LOCALHOST(4));
+
+  connection_t *c1 = allocate_connection(conn_table_, &pair_, CONNECTION_NAME);
+  connection_t *c2 = allocate_connection(table2, &pair_, CONNECTION_NAME);
+  unsigned id = connection_table_get_connection_id(conn_table_, c1);
+  EXPECT_EQ(connection_table_get_connection_id(table2, c2), id);
+
+  // The id remains in use as long as one table holds the connection
+  remove_connection(conn_table_, id);
+  connection_t *c = allocate_connection(conn_table_, &pair2, CONNECTION_NAME_2);
+  ASSERT_NE(c, nullptr);
+  EXPECT_NE(connection_table_get_connection_id(conn_table_, c), id);
+
+  // ... and is reused once released everywhere
+  remove_connection(table2, id);
+  c = allocate_connection(table2, &pair3, "conn_name_3");
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(connection_table_get_connection_id(table2, c), id);
+
+  connection_table_set_registry(conn_table_, NULL);
+  connection_table_set_registry(table2, NULL);
+  connection_table_free(table2);
+  connection_registry_free(registry);
+}
+
+TEST_F(ConnectionTableTest, SharedRegistryKeepsExistingConnections) {
+  // Connections created before attaching the registry keep their id
+  connection_t *c1 = allocate_connection(conn_table_, &pair_, CONNECTION_NAME);
+  unsigned id = connection_table_get_connection_id(conn_table_, c1);
+
+  connection_registry_t *registry = connection_registry_create();
+  connection_table_t *table2 = connection_table_create();
+  ASSERT_EQ(connection_table_set_registry(conn_table_, registry), 0);
+  ASSERT_EQ(connection_table_set_registry(table2, registry), 0);
+
+  address_pair_t pair2 =
+      address_pair_factory(_ADDRESS4_LOCALHOST(1), _ADDRESS4_LOCALHOST(3));
+  connection_t *c2 = allocate_connection(table2, &pair2, CONNECTION_NAME_2);
+  ASSERT_NE(c2, nullptr);
+  EXPECT_NE(connection_table_get_connection_id(table2, c2), id);
+  connection_t *c = allocate_connection(table2, &pair_, "other");
+  ASSERT_NE(c, nullptr);
+  EXPECT_EQ(connection_table_get_connection_id(table2, c), id);
+
+  connection_table_set_registry(conn_table_, NULL);
+  connection_table_set_registry(table2, NULL);
+  connection_table_free(table2);
+  connection_registry_free(registry);
+}
@@ -22,7 +22,10 @@
 #include <sys/un.h>
 #include <unistd.h>
 #include <netinet/in.h>
+#include <algorithm>
+#include <random>
 #include <vector>
+#include <hicn/test/test-utils.h>
 
 extern "C" {
 #define WITH_TESTS
@@ -336,3 +339,182 @@ TEST_F(FibTest, IRIStest) {
     EXPECT_EQ(ret, 0);
   }
 }
+
+/*
+ * Helpers for randomized tests and benchmarks: prefixes are drawn from a
+ * small set of prefix lengths, as typically found in a FIB.
+ */
+static const uint8_t lpm_prefix_lens[] = {32, 48, 64};
+
+static hicn_prefix_t _random_prefix(std::mt19937_64 &gen) {
+  hicn_ip_address_t address = IP_ADDRESS_EMPTY;
+  address.v6.as_u64[0] = gen();
+  address.v6.as_u64[1] = gen();
+  /* Avoid IPv4 addresses (zero padding) */
+  address.v6.as_u8[0] |= 0x20;
+
+  hicn_prefix_t prefix;
+  hicn_prefix_create_from_ip_address_len(
+      &address, lpm_prefix_lens[gen() % ARRAY_SIZE(lpm_prefix_lens)], &prefix);
+  return prefix;
+}
+
+/* Full length prefix matching the given prefix, with random trailing bits */
+static hicn_prefix_t _random_name_in(const hicn_prefix_t *prefix,
+                                     std::mt19937_64 &gen) {
+  hicn_prefix_t name = *prefix;
+  name.name.v6.as_u64[1] ^= gen() & hicn_host_to_net_64(0xffffffffULL);
+  name.len = 128;
+  return name;
+}
+
+TEST_F(FibTest, LpmIndexMatchesTrie) {
+  std::mt19937_64 gen(42);
+  std::vector<hicn_prefix_t> prefixes;
+  std::vector<uint32_t> nexthop = {1};
+
+  for (int i = 0; i < 2000; i++) {
+    prefixes.push_back(_random_prefix(gen));
+    _fib_add_prefix(fib, &prefixes.back(), nexthop);
+  }
+  /* Nested prefixes, sharing the first bits of existing ones */
+  for (int i = 0; i < 500; i++) {
+    hicn_prefix_t nested = prefixes[gen() % prefixes.size()];
+    nested.len = 8 + gen() % (nested.len - 8);
+    prefixes.push_back(nested);
+    _fib_add_prefix(fib, &prefixes.back(), nexthop);
+  }
+  EXPECT_TRUE(fib_is_valid(fib));
+
+  auto check = [&]() {
+    for (int i = 0; i < 5000; i++) {
+      hicn_prefix_t name =
+          (i % 2) ? _random_name_in(&prefixes[gen() % prefixes.size()], gen)
+                  : _random_prefix(gen);
+      EXPECT_EQ(fib_match_prefix(fib, &name),
+                fib_match_prefix_trie(fib, &name));
+    }
+  };
+  check();
+
+  /* Incremental removals must be reflected in the index */
+  for (size_t i = 0; i < prefixes.size(); i += 3)
+    fib_remove(fib, &prefixes[i], nexthop[0]);
+  EXPECT_TRUE(fib_is_valid(fib));
+  check();
+
+  /* ... as well as re-additions */
+  for (size_t i = 0; i < prefixes.size(); i += 6)
+    _fib_add_prefix(fib, &prefixes[i], nexthop);
+  EXPECT_TRUE(fib_is_valid(fib));
+  check();
+}
+
+/* Walk the FIB by chunks, resuming after the last entry of each chunk */
+static std::vector<fib_entry_t *> _fib_walk_by_chunks(fib_t *fib,
+                                                      size_t chunk_size) {
+  std::vector<fib_entry_t *> entries;
+  std::vector<fib_entry_t *> chunk(chunk_size);
+  const hicn_prefix_t *cursor = NULL;
+  for (;;) {
+    size_t n = fib_get_entries_after(fib, cursor, chunk.data(), chunk_size);
+    entries.insert(entries.end(), chunk.begin(), chunk.begin() + n);
+    if (n < chunk_size) break;
+    cursor = fib_entry_get_prefix(chunk[n - 1]);
+  }
+  return entries;
+}
+
+TEST_F(FibTest, EntriesAfterByChunks) {
+  std::mt19937_64 gen(42);
+  std::vector<hicn_prefix_t> prefixes;
+  std::vector<uint32_t> nexthop = {1};
+
+  for (int i = 0; i < 2000; i++) {
+    prefixes.push_back(_random_prefix(gen));
+    _fib_add_prefix(fib, &prefixes.back(), nexthop);
+  }
+  for (int i = 0; i < 500; i++) {
+    hicn_prefix_t nested = prefixes[gen() % prefixes.size()];
+    nested.len = 8 + gen() % (nested.len - 8);
+    prefixes.push_back(nested);
+    _fib_add_prefix(fib, &prefixes.back(), nexthop);
+  }
+
+  fib_entry_t **array;
+  size_t n = fib_get_entry_array(fib, &array);
+  std::vector<fib_entry_t *> all(array, array + n);
+  free(array);
+  std::sort(all.begin(), all.end());
+
+  /* Every entry is returned exactly once, whatever the chunk size */
+  for (size_t chunk_size : {1, 7, 256, 4096}) {
+    std::vector<fib_entry_t *> entries = _fib_walk_by_chunks(fib, chunk_size);
+    EXPECT_EQ(entries.size(), fib_get_size(fib));
+    std::sort(entries.begin(), entries.end());
+    EXPECT_EQ(entries, all);
+  }
+
+  /* Entries following a prefix which is not in the FIB (anymore) */
+  for (int i = 0; i < 100; i++) {
+    hicn_prefix_t cursor = _random_prefix(gen);
+    std::vector<fib_entry_t *> after(fib_get_size(fib));
+    size_t n_after =
+        fib_get_entries_after(fib, &cursor, after.data(), after.size());
+
+    /* Resuming from the first one returns the others */
+    if (n_after == 0) continue;
+    std::vector<fib_entry_t *> next(fib_get_size(fib));
+    size_t n_next = fib_get_entries_after(fib, fib_entry_get_prefix(after[0]),
+                                          next.data(), next.size());
+    EXPECT_EQ(n_next, n_after - 1);
+    EXPECT_TRUE(std::equal(next.begin(), next.begin() + n_next,
+                           after.begin() + 1));
+  }
+}
+
+static void _fib_lookup_benchmark(size_t n_prefixes) {
+  static constexpr int N_LOOKUPS = 10000;
+
+  fib_t *fib = fib_create(NULL);
+  std::mt19937_64 gen(n_prefixes);
+  std::vector<hicn_prefix_t> prefixes;
+  std::vector<uint32_t> nexthop = {1};
+
+  prefixes.reserve(n_prefixes);
+  for (size_t i = 0; i < n_prefixes; i++) {
+    prefixes.push_back(_random_prefix(gen));
+    _fib_add_prefix(fib, &prefixes.back(), nexthop);
+  }
+
+  std::vector<hicn_prefix_t> names;
+  for (int i = 0; i < N_LOOKUPS; i++)
+    names.push_back(_random_name_in(&prefixes[gen() % prefixes.size()], gen));
+
+  volatile fib_entry_t *entry;
+  auto elapsed_time_trie = get_execution_time([&]() {
+    for (int i = 0; i < N_LOOKUPS; i++)
+      entry = fib_match_prefix_trie(fib, &names[i]);
+  });
+  auto elapsed_time_index = get_execution_time([&]() {
+    for (int i = 0; i < N_LOOKUPS; i++)
+      entry = fib_match_prefix(fib, &names[i]);
+  });
+  (void)entry;
+
+  std::cout << "FIB lookup (" << n_prefixes << " prefixes, " << N_LOOKUPS
+            << " lookups): trie " << elapsed_time_trie << " ms, index "
+            << elapsed_time_index << " ms\n";
+
+  fib_free(fib);
+}
+
+TEST_F(FibTest, PerformanceLookup1k) { _fib_lookup_benchmark(1000); }
+
+TEST_F(FibTest, PerformanceLookup100k) { _fib_lookup_benchmark(100000); }
+
+/* Disabled by default for its memory and setup time, run with
+ * --gtest_also_run_disabled_tests */
+TEST_F(FibTest, DISABLED_PerformanceLookup1M) {
+  _fib_lookup_benchmark(1000000);
+}
@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <cstring>
+#include <vector>
+
+#include <sys/socket.h>
+#include <unistd.h>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/base/loop.h>
+#include <hicn/config/configuration.h>
+#include <hicn/core/address.h>
+#include <hicn/core/address_pair.h>
+#include <hicn/core/forwarder.h>
+// After the forwarder, which it does not include
+#include <hicn/config/commands.h>
+#include <hicn/core/listener.h>
+#include <hicn/interest_manifest.h>
+#include <hicn/util/log.h>
+}
+
+#define FORWARDER_TEST_PORT 19795
+#define N_BATCHES 64
+
+class ForwarderTest : public ::testing::Test {
+ protected:
+  ForwarderTest() {
+    log_level_ = log_conf.log_level;
+    conf_ = configuration_create();
+    // Interests without route are logged
+    log_conf.log_level = LOG_WARN;
+
+    MAIN_LOOP = loop_create();
+    fwd_ = forwarder_create(conf_);
+    msgbuf_pool_ = forwarder_get_msgbuf_pool(fwd_);
+
+    listener_addr_ = ADDRESS4_LOCALHOST(FORWARDER_TEST_PORT);
+    listener_ = listener_create(FACE_TYPE_UDP_LISTENER, &listener_addr_, "lo",
+                                "lo_udp4", fwd_);
+  }
+
+  virtual ~ForwarderTest() {
+    forwarder_free(fwd_);
+    loop_free(MAIN_LOOP);
+    MAIN_LOOP = NULL;
+    log_conf.log_level = log_level_;
+  }
+
+  address_pair_t get_pair(uint16_t remote_port) {
+    address_t remote = ADDRESS4_LOCALHOST(remote_port);
+    return address_pair_factory(listener_addr_, remote);
+  }
+
+  /* Craft an interest packet, as received by a listener */
+  off_t interest_create(uint32_t suffix) {
+    hicn_ip_address_t prefix;
+    inet_pton(AF_INET6, "b001::", (struct in6_addr *)&prefix);
+    hicn_name_t name;
+    hicn_name_create_from_ip_address(prefix, suffix, &name);
+
+    msgbuf_t *msgbuf;
+    off_t msgbuf_id = msgbuf_pool_get(msgbuf_pool_, &msgbuf);
+    hicn_packet_buffer_t *pkbuf = msgbuf_get_pkbuf(msgbuf);
+    hicn_packet_set_format(pkbuf, HICN_PACKET_FORMAT_IPV6_TCP);
+    hicn_packet_set_type(pkbuf, HICN_PACKET_TYPE_INTEREST);
+    hicn_packet_set_buffer(pkbuf, msgbuf->packet, MTU, 0);
+    EXPECT_EQ(hicn_packet_init_header(pkbuf, 0), 0);
+    EXPECT_EQ(hicn_interest_set_name(pkbuf, &name), 0);
+    hicn_interest_set_lifetime(pkbuf, 5000);
+
+    msgbuf_pool_acquire(msgbuf);
+    msgbuf_set_connection_id(msgbuf, CONNECTION_ID_UNDEFINED);
+    return msgbuf_id;
+  }
+
+  /*
+   * Interests for n names, each one followed by a retransmission, so that
+   * packets of a batch depend on each other.
+   */
+  std::vector<off_t> interests_create(uint32_t first_suffix, size_t n) {
+    std::vector<off_t> msgbuf_ids;
+    for (size_t i = 0; i < n; i++) {
+      msgbuf_ids.push_back(interest_create(first_suffix + (uint32_t)i));
+      msgbuf_ids.push_back(interest_create(first_suffix + (uint32_t)i));
+    }
+    return msgbuf_ids;
+  }
+
+  /* Craft an interest manifest for the given suffixes */
+  off_t interest_manifest_create(const std::vector<uint32_t> &suffixes) {
+    off_t msgbuf_id = interest_create(suffixes[0]);
+    msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool_, msgbuf_id);
+    hicn_packet_buffer_t *pkbuf = msgbuf_get_pkbuf(msgbuf);
+
+    uint8_t buffer[sizeof(interest_manifest_header_t) +
+                   MAX_SUFFIXES_IN_MANIFEST * sizeof(uint32_t)];
+    auto header = (interest_manifest_header_t *)buffer;
+    interest_manifest_init(header, suffixes[0]);
+    for (size_t i = 1; i < suffixes.size(); i++)
+      interest_manifest_add_suffix(header, suffixes[i]);
+    size_t size = sizeof(interest_manifest_header_t) +
+                  header->n_suffixes * sizeof(uint32_t);
+    interest_manifest_serialize(header);
+
+    EXPECT_EQ(hicn_packet_set_payload_type(pkbuf, HPT_MANIFEST), 0);
+    EXPECT_EQ(hicn_packet_set_payload(pkbuf, buffer, (u16)size), 0);
+    size_t header_len;
+    EXPECT_EQ(hicn_packet_get_header_len(pkbuf, &header_len), 0);
+    msgbuf_set_len(msgbuf, header_len + size);
+    return msgbuf_id;
+  }
+
+  void release(const std::vector<off_t> &msgbuf_ids) {
+    for (off_t msgbuf_id : msgbuf_ids) {
+      msgbuf_t *msgbuf = msgbuf_pool_at(msgbuf_pool_, msgbuf_id);
+      msgbuf_pool_release(msgbuf_pool_, &msgbuf);
+    }
+  }
+
+  int log_level_;
+  configuration_t *conf_;
+  forwarder_t *fwd_;
+  msgbuf_pool_t *msgbuf_pool_;
+  address_t listener_addr_;
+  listener_t *listener_;
+};
+
+TEST_F(ForwarderTest, BatchMatchesScalar) {
+  static constexpr size_t N_NAMES = FORWARDER_BATCH_SIZE / 2;
+  address_pair_t pair = get_pair(FORWARDER_TEST_PORT + 1);
+  std::vector<address_pair_t> pairs(2 * N_NAMES, pair);
+
+  // Scalar path
+  std::vector<off_t> msgbuf_ids = interests_create(0, N_NAMES);
+  for (size_t i = 0; i < msgbuf_ids.size(); i++)
+    forwarder_receive(fwd_, listener_, msgbuf_ids[i], &pairs[i], usecs_now());
+  release(msgbuf_ids);
+  forwarder_stats_t scalar = forwarder_get_stats(fwd_);
+  size_t scalar_pit_size =
+      pkt_cache_get_pit_size(forwarder_get_pkt_cache(fwd_));
+
+  // Batch path, with other names
+  msgbuf_ids = interests_create(N_NAMES, N_NAMES);
+  forwarder_receive_batch(fwd_, listener_, msgbuf_ids.data(), pairs.data(),
+                          msgbuf_ids.size(), usecs_now());
+  release(msgbuf_ids);
+  forwarder_stats_t total = forwarder_get_stats(fwd_);
+
+  EXPECT_EQ(total.countReceived, 2 * scalar.countReceived);
+  EXPECT_EQ(total.countInterestsReceived, 2 * scalar.countInterestsReceived);
+  EXPECT_EQ(total.countInterestsRetransmitted,
+            2 * scalar.countInterestsRetransmitted);
+  EXPECT_EQ(total.countInterestsAggregated,
+            2 * scalar.countInterestsAggregated);
+  EXPECT_EQ(total.countDropped, 2 * scalar.countDropped);
+  EXPECT_EQ(pkt_cache_get_pit_size(forwarder_get_pkt_cache(fwd_)),
+            2 * scalar_pit_size);
+
+  // A single connection has been created for the peer
+  const connection_table_t *table = forwarder_get_connection_table(fwd_);
+  EXPECT_EQ(connection_table_len(table), 1u);
+
+  EXPECT_EQ(scalar.countBatches, 0u);
+  EXPECT_EQ(total.countBatches, 1u);
+  EXPECT_EQ(total.countBatchPackets, 2 * N_NAMES);
+  EXPECT_GT(total.cyclesAnalyze, 0u);
+  EXPECT_GT(total.cyclesProcess, 0u);
+}
+
+TEST_F(ForwarderTest, BatchIsSplitInVectors) {
+  size_t n = FORWARDER_BATCH_SIZE + 2;
+  address_pair_t pair = get_pair(FORWARDER_TEST_PORT + 1);
+  std::vector<address_pair_t> pairs(n, pair);
+  std::vector<off_t> msgbuf_ids;
+  for (size_t i = 0; i < n; i++) msgbuf_ids.push_back(interest_create(i));
+
+  forwarder_receive_batch(fwd_, listener_, msgbuf_ids.data(), pairs.data(), n,
+                          usecs_now());
+  release(msgbuf_ids);
+
+  forwarder_stats_t stats = forwarder_get_stats(fwd_);
+  EXPECT_EQ(stats.countBatches, 2u);
+  EXPECT_EQ(stats.countBatchPackets, n);
+  EXPECT_EQ(stats.countInterestsReceived, n);
+}
+
+TEST_F(ForwarderTest, ManifestSplit) {
+  static constexpr size_t N_SUFFIXES = 10;
+  static constexpr size_t N_PER_SPLIT = 4;
+
+  // Sub-manifests are received on a local socket
+  int fd = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(fd, 0);
+  address_t remote = ADDRESS4_LOCALHOST(FORWARDER_TEST_PORT + 2);
+  ASSERT_EQ(bind(fd, address_sa(&remote), address_socklen(&remote)), 0);
+  struct timeval timeout = {.tv_sec = 0, .tv_usec = 100000};
+  setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+
+  address_pair_t out_pair = get_pair(FORWARDER_TEST_PORT + 2);
+  unsigned conn_id = listener_create_connection(listener_, "out", &out_pair);
+  ASSERT_NE(conn_id, CONNECTION_ID_UNDEFINED);
+  hicn_ip_prefix_t prefix;
+  ASSERT_EQ(hicn_ip_prefix_pton("b001::/64", &prefix), 0);
+  ASSERT_TRUE(forwarder_add_or_update_route(fwd_, &prefix, conn_id));
+  configuration_set_suffixes_per_split(conf_, N_PER_SPLIT);
+
+  std::vector<uint32_t> suffixes;
+  for (uint32_t i = 0; i < N_SUFFIXES; i++) suffixes.push_back(100 + i);
+  off_t msgbuf_id = interest_manifest_create(suffixes);
+  address_pair_t in_pair = get_pair(FORWARDER_TEST_PORT + 1);
+  forwarder_receive(fwd_, listener_, msgbuf_id, &in_pair, usecs_now());
+  forwarder_flush_connections(fwd_);
+
+  // Sub-manifests share the list of suffixes, and split the bitmap
+  size_t n_splits = 0;
+  hicn_uword bitmap[BITMAP_SIZE] = {0};
+  uint8_t packet[MTU];
+  ssize_t len;
+  while ((len = recv(fd, packet, sizeof(packet), 0)) > 0) {
+    n_splits++;
+    hicn_packet_buffer_t pkbuf;
+    hicn_packet_set_buffer(&pkbuf, packet, sizeof(packet), len);
+    ASSERT_EQ(hicn_packet_analyze(&pkbuf), 0);
+    uint8_t *payload;
+    size_t payload_size;
+    ASSERT_EQ(hicn_packet_get_payload(&pkbuf, &payload, &payload_size, false),
+              0);
+    auto header = (interest_manifest_header_t *)payload;
+    interest_manifest_deserialize(header);
+    ASSERT_TRUE(interest_manifest_is_valid(header, payload_size));
+    EXPECT_EQ(header->n_suffixes, N_SUFFIXES);
+
+    size_t n_set = 0;
+    hicn_name_suffix_t *suffix;
+    unsigned long pos;
+    interest_manifest_foreach_suffix(header, suffix, pos) {
+      EXPECT_EQ(*suffix, suffixes[pos]);
+      EXPECT_FALSE(bitmap_is_set_no_check(bitmap, pos));
+      bitmap_set_no_check(bitmap, pos);
+      n_set++;
+    }
+    EXPECT_LE(n_set, N_PER_SPLIT);
+  }
+  close(fd);
+
+  for (size_t i = 0; i < N_SUFFIXES; i++)
+    EXPECT_TRUE(bitmap_is_set_no_check(bitmap, i));
+  EXPECT_EQ(n_splits, (N_SUFFIXES + N_PER_SPLIT - 1) / N_PER_SPLIT);
+
+  forwarder_stats_t stats = forwarder_get_stats(fwd_);
+  EXPECT_EQ(stats.countManifests, 1u);
+  EXPECT_EQ(stats.countManifestSuffixes, N_SUFFIXES);
+  EXPECT_EQ(stats.countManifestSplits, n_splits);
+
+  // Sub-manifests hold a reference on the original msgbuf
+  const off_t *acquired = forwarder_get_acquired_msgbuf_ids(fwd_);
+  EXPECT_EQ(msgbuf_pool_at(msgbuf_pool_, msgbuf_id)->refs,
+            1 + vector_len(acquired));
+  for (size_t i = 0; i < vector_len(acquired); i++) {
+    msgbuf_t *clone = msgbuf_pool_at(msgbuf_pool_, acquired[i]);
+    msgbuf_pool_release(msgbuf_pool_, &clone);
+  }
+  forwarder_acquired_msgbuf_ids_reset(fwd_);
+  release({msgbuf_id});
+}
+
+TEST_F(ForwarderTest, PerformanceBatch) {
+  address_pair_t pair = get_pair(FORWARDER_TEST_PORT + 1);
+  std::vector<address_pair_t> pairs(FORWARDER_BATCH_SIZE, pair);
+  uint32_t suffix = 0;
+
+  std::vector<std::vector<off_t>> batches;
+  for (int b = 0; b < 2 * N_BATCHES; b++) {
+    batches.push_back(interests_create(suffix, FORWARDER_BATCH_SIZE / 2));
+    suffix += FORWARDER_BATCH_SIZE / 2;
+  }
+
+  auto start = std::chrono::high_resolution_clock::now();
+  for (int b = 0; b < N_BATCHES; b++)
+    for (size_t i = 0; i < batches[b].size(); i++)
+      forwarder_receive(fwd_, listener_, batches[b][i], &pairs[i],
+                        usecs_now());
+  auto end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> scalar_ms = end - start;
+
+  start = std::chrono::high_resolution_clock::now();
+  for (int b = N_BATCHES; b < 2 * N_BATCHES; b++)
+    forwarder_receive_batch(fwd_, listener_, batches[b].data(), pairs.data(),
+                            batches[b].size(), usecs_now());
+  end = std::chrono::high_resolution_clock::now();
+  std::chrono::duration<double, std::milli> batch_ms = end - start;
+
+  for (auto &batch : batches) release(batch);
+
+  forwarder_stats_t stats = forwarder_get_stats(fwd_);
+  std::cout << "Receive " << N_BATCHES * FORWARDER_BATCH_SIZE
+            << " packets: scalar " << scalar_ms.count() << " ms, batch "
+            << batch_ms.count() << " ms (cycles/packet: analyze "
+            << stats.cyclesAnalyze / stats.countBatchPackets << ", prefetch "
+            << stats.cyclesPrefetch / stats.countBatchPackets << ", process "
+            << stats.cyclesProcess / stats.countBatchPackets << ")\n";
+}
+
+TEST_F(ForwarderTest, RouteAddBatchLongerThanMessage) {
+  uint8_t packet[sizeof(msg_header_t) + 2 * sizeof(cmd_route_add_t)] = {};
+  msg_route_add_t *msg = (msg_route_add_t *)packet;
+  cmd_route_add_t *routes = &msg->payload;
+  for (int i = 0; i < 2; i++) {
+    inet_pton(AF_INET6, i == 0 ? "b001::" : "b002::",
+              (struct in6_addr *)&routes[i].address);
+    routes[i].family = AF_INET6;
+    routes[i].len = 64;
+  }
+
+  auto route_add = [&](size_t size) {
+    msg->header.message_type = REQUEST_LIGHT;
+    msg->header.command_id = COMMAND_TYPE_ROUTE_ADD;
+    msg->header.length = 2;
+    size_t reply_size = 0;
+    msg_header_t *reply = (msg_header_t *)command_process(fwd_, packet, size,
+                                                          0, &reply_size);
+    EXPECT_EQ(reply_size, sizeof(msg_header_t));
+    return reply->header.message_type;
+  };
+
+  // Only the first route was received
+  EXPECT_EQ(route_add(sizeof(msg_route_add_t)), NACK_LIGHT);
+  EXPECT_EQ(route_add(sizeof(packet)), ACK_LIGHT);
+}
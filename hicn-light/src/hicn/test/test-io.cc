@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <netinet/udp.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/core/msgbuf_pool.h>
+#include <hicn/io/base.h>
+}
+
+#ifdef __linux__
+
+#ifndef UDP_SEGMENT
+#define UDP_SEGMENT 103  // linux/udp.h
+#endif
+
+class IoTest : public ::testing::Test {
+ protected:
+  IoTest() {}
+  virtual ~IoTest() {}
+
+  unsigned group(const std::vector<size_t> &len) {
+    n_segments_.assign(len.size(), 0);
+    segment_size_.assign(len.size(), 0);
+    return io_gso_group(len.data(), (unsigned)len.size(), n_segments_.data(),
+                        segment_size_.data());
+  }
+
+  std::vector<unsigned> n_segments_;
+  std::vector<uint16_t> segment_size_;
+};
+
+TEST_F(IoTest, GsoGroupSameSizeWithShorterLast) {
+  EXPECT_EQ(group({100, 100, 100, 60}), 1u);
+  EXPECT_EQ(n_segments_[0], 4u);
+  EXPECT_EQ(segment_size_[0], 100);
+}
+
+TEST_F(IoTest, GsoGroupEndsAfterShorterSegment) {
+  // A shorter segment terminates the group, a larger one starts a new one
+  ASSERT_EQ(group({100, 100, 60, 100, 100, 200}), 3u);
+  EXPECT_EQ(n_segments_[0], 3u);
+  EXPECT_EQ(segment_size_[0], 100);
+  EXPECT_EQ(n_segments_[1], 2u);
+  EXPECT_EQ(segment_size_[1], 100);
+  EXPECT_EQ(n_segments_[2], 1u);
+  EXPECT_EQ(segment_size_[2], 200);
+}
+
+TEST_F(IoTest, GsoGroupMaxSegments) {
+  std::vector<size_t> len(2 * UDP_GSO_MAX_SEGMENTS + 2, 100);
+  ASSERT_EQ(group(len), 3u);
+  EXPECT_EQ(n_segments_[0], (unsigned)UDP_GSO_MAX_SEGMENTS);
+  EXPECT_EQ(n_segments_[1], (unsigned)UDP_GSO_MAX_SEGMENTS);
+  EXPECT_EQ(n_segments_[2], 2u);
+}
+
+TEST_F(IoTest, GsoGroupMaxSize) {
+  const size_t size = 1400;
+  const unsigned max_per_group = UDP_GSO_MAX_SIZE / size;
+  ASSERT_LT(max_per_group, (unsigned)UDP_GSO_MAX_SEGMENTS);
+
+  std::vector<size_t> len(max_per_group + 3, size);
+  ASSERT_EQ(group(len), 2u);
+  EXPECT_EQ(n_segments_[0], max_per_group);
+  EXPECT_LE(n_segments_[0] * size, (size_t)UDP_GSO_MAX_SIZE);
+  EXPECT_EQ(n_segments_[1], 3u);
+}
+
+TEST_F(IoTest, GroSplitsBySegmentSize) {
+  int rx = socket(AF_INET, SOCK_DGRAM, 0);
+  int tx = socket(AF_INET, SOCK_DGRAM, 0);
+  ASSERT_GE(rx, 0);
+  ASSERT_GE(tx, 0);
+
+  struct sockaddr_in addr = {};
+  addr.sin_family = AF_INET;
+  addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  socklen_t addrlen = sizeof(addr);
+  ASSERT_EQ(bind(rx, (struct sockaddr *)&addr, addrlen), 0);
+  ASSERT_EQ(getsockname(rx, (struct sockaddr *)&addr, &addrlen), 0);
+  ASSERT_EQ(connect(tx, (struct sockaddr *)&addr, addrlen), 0);
+  fcntl(rx, F_SETFL, O_NONBLOCK);
+
+  if (io_gro_enable(rx) < 0) {
+    close(rx);
+    close(tx);
+    GTEST_SKIP() << "UDP GRO not supported";
+  }
+
+  // Send a GSO super-datagram made of 3 segments of 100 bytes and a last one
+  // of 40 bytes, that the receiving socket gets coalesced
+  uint8_t payload[340];
+  for (size_t i = 0; i < sizeof(payload); i++) payload[i] = (uint8_t)(i / 100);
+  struct iovec iov = {payload, sizeof(payload)};
+  union {
+    char buf[CMSG_SPACE(sizeof(uint16_t))];
+    struct cmsghdr align;
+  } control;
+  struct msghdr msg = {};
+  msg.msg_iov = &iov;
+  msg.msg_iovlen = 1;
+  msg.msg_control = control.buf;
+  msg.msg_controllen = sizeof(control.buf);
+  struct cmsghdr *cmsg = CMSG_FIRSTHDR(&msg);
+  cmsg->cmsg_level = SOL_UDP;
+  cmsg->cmsg_type = UDP_SEGMENT;
+  cmsg->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+  uint16_t segment_size = 100;
+  memcpy(CMSG_DATA(cmsg), &segment_size, sizeof(segment_size));
+  if (sendmsg(tx, &msg, 0) < 0) {
+    io_gro_disable(rx);
+    close(rx);
+    close(tx);
+    GTEST_SKIP() << "UDP GSO not supported: " << strerror(errno);
+  }
+
+  msgbuf_pool_t *msgbuf_pool = msgbuf_pool_create();
+  const size_t batch = 2;
+  msgbuf_t *msgbufs[batch];
+  address_t addresses[batch];
+  address_t *address[batch] = {&addresses[0], &addresses[1]};
+  ASSERT_EQ(msgbuf_pool_getn(msgbuf_pool, msgbufs, batch), 0);
+
+  // Segments not fitting in the batch are returned by the next call
+  std::vector<size_t> sizes;
+  for (int call = 0; call < 2; call++) {
+    ssize_t n = io_read_batch_socket_gro(rx, msgbufs, address, batch);
+    ASSERT_EQ(n, (ssize_t)batch);
+    for (ssize_t i = 0; i < n; i++) {
+      size_t len = msgbuf_get_len(msgbufs[i]);
+      uint8_t *packet = msgbuf_get_packet(msgbufs[i]);
+      EXPECT_EQ(packet[0], (uint8_t)sizes.size());
+      EXPECT_EQ(packet[len - 1], (uint8_t)sizes.size());
+      sizes.push_back(len);
+    }
+  }
+  EXPECT_EQ(sizes, std::vector<size_t>({100, 100, 100, 40}));
+
+  // Nothing left
+  EXPECT_LT(io_read_batch_socket_gro(rx, msgbufs, address, batch), 0);
+
+  for (size_t i = 0; i < batch; i++) msgbuf_pool_put(msgbuf_pool, msgbufs[i]);
+  msgbuf_pool_free(msgbuf_pool);
+  io_gro_disable(rx);
+  close(rx);
+  close(tx);
+}
+
+#endif /* __linux__ */
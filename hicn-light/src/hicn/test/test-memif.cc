@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <event2/event.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <string>
+
+#include <libmemif.h>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/base/loop.h>
+#include <hicn/config/configuration.h>
+#include <hicn/core/address.h>
+#include <hicn/core/address_pair.h>
+#include <hicn/core/connection.h>
+#include <hicn/core/connection_table.h>
+#include <hicn/core/forwarder.h>
+#include <hicn/core/listener.h>
+#include <hicn/core/listener_table.h>
+}
+
+#define MEMIF_TEST_PORT 19796
+#define MEMIF_TEST_INTERFACE_ID 7
+#define MEMIF_TEST_BUFFER_SIZE 2048
+
+/*
+ * The forwarder is the memif master, and the test acts as the slave
+ * application, polling its own socket.
+ */
+class MemifTest : public ::testing::Test {
+ protected:
+  MemifTest() {
+    socket_path_ = "/tmp/hicn-light-memif-" + std::to_string(getpid());
+    conf_ = configuration_create();
+    configuration_set_port(conf_, MEMIF_TEST_PORT);
+    configuration_set_memif_socket(conf_, socket_path_.c_str());
+    MAIN_LOOP = loop_create();
+    fwd_ = forwarder_create(conf_);
+    forwarder_setup_local_listeners(fwd_, MEMIF_TEST_PORT);
+  }
+
+  virtual ~MemifTest() {
+    if (slave_) memif_delete(&slave_);
+    if (slave_socket_) memif_delete_socket(&slave_socket_);
+    forwarder_free(fwd_);
+    loop_free(MAIN_LOOP);
+    MAIN_LOOP = NULL;
+    unlink(socket_path_.c_str());
+  }
+
+  static int on_connect(memif_conn_handle_t handle, void *private_ctx) {
+    MemifTest *test = (MemifTest *)private_ctx;
+    memif_refill_queue(handle, 0, -1, 0);
+    test->slave_connected_ = true;
+    return 0;
+  }
+
+  static int on_disconnect(memif_conn_handle_t handle, void *private_ctx) {
+    MemifTest *test = (MemifTest *)private_ctx;
+    test->slave_connected_ = false;
+    return 0;
+  }
+
+  /* Create the memif connection in the forwarder, as the control face does */
+  connection_t *create_connection() {
+    address_t local = ADDRESS4_LOCALHOST(MEMIF_TEST_PORT);
+    listener_key_t key =
+        listener_key_factory(local, FACE_TYPE_MEMIF_LISTENER);
+    listener_t *listener =
+        listener_table_get_by_key(forwarder_get_listener_table(fwd_), &key);
+    if (!listener) return NULL;
+
+    address_pair_t pair = address_pair_factory(
+        local, ADDRESS4_LOCALHOST(MEMIF_TEST_INTERFACE_ID));
+    unsigned connection_id =
+        listener_create_connection(listener, "memif_test", &pair);
+    if (connection_id == (unsigned)CONNECTION_ID_UNDEFINED) return NULL;
+
+    return connection_table_get_by_id(forwarder_get_connection_table(fwd_),
+                                      connection_id);
+  }
+
+  int create_slave() {
+    memif_socket_args_t socket_args = {};
+    strncpy(socket_args.path, socket_path_.c_str(),
+            sizeof(socket_args.path) - 1);
+    strncpy(socket_args.app_name, "hicn-light-test",
+            sizeof(socket_args.app_name) - 1);
+    int rc = memif_create_socket(&slave_socket_, &socket_args, NULL);
+    if (rc != MEMIF_ERR_SUCCESS) return rc;
+
+    memif_conn_args_t args = {};
+    args.socket = slave_socket_;
+    args.num_s2m_rings = 1;
+    args.num_m2s_rings = 1;
+    args.buffer_size = MEMIF_TEST_BUFFER_SIZE;
+    args.log2_ring_size = 10;
+    args.is_master = 0;
+    args.interface_id = MEMIF_TEST_INTERFACE_ID;
+    args.mode = MEMIF_INTERFACE_MODE_IP;
+    return memif_create(&slave_, &args, on_connect, on_disconnect, NULL, this);
+  }
+
+  /* Run both ends until the condition holds (or a timeout) */
+  template <typename F>
+  bool wait_for(F condition) {
+    for (int i = 0; i < 1000; i++) {
+      _loop_dispatch(MAIN_LOOP, EVLOOP_NONBLOCK);
+      if (slave_socket_) memif_poll_event(slave_socket_, 0);
+      if (condition()) return true;
+      usleep(1000);
+    }
+    return false;
+  }
+
+  std::string socket_path_;
+  configuration_t *conf_;
+  forwarder_t *fwd_;
+  memif_socket_handle_t slave_socket_ = NULL;
+  memif_conn_handle_t slave_ = NULL;
+  bool slave_connected_ = false;
+};
+
+TEST_F(MemifTest, Loopback) {
+  // Open
+  connection_t *connection = create_connection();
+  ASSERT_NE(connection, nullptr);
+  ASSERT_EQ(create_slave(), MEMIF_ERR_SUCCESS);
+  ASSERT_TRUE(wait_for([&] { return slave_connected_; }));
+
+  // Forwarder to application
+  const uint8_t packet[] = "forwarder to application";
+  bool sent = false;
+  ASSERT_TRUE(wait_for([&] {
+    if (!sent)
+      sent = connection_send_packet(connection, packet, sizeof(packet));
+    return sent;
+  }));
+
+  memif_buffer_t rx_buf;
+  uint16_t n_received = 0;
+  ASSERT_TRUE(wait_for([&] {
+    memif_rx_burst(slave_, 0, &rx_buf, 1, &n_received);
+    return n_received == 1;
+  }));
+  ASSERT_EQ(rx_buf.len, sizeof(packet));
+  EXPECT_EQ(memcmp(rx_buf.data, packet, sizeof(packet)), 0);
+  memif_refill_queue(slave_, 0, n_received, 0);
+
+  // Application to forwarder: the content is not a valid packet and is
+  // dropped by the forwarder, once counted on the connection
+  memif_buffer_t tx_buf;
+  uint16_t n_allocated = 0;
+  ASSERT_EQ(memif_buffer_alloc(slave_, 0, &tx_buf, 1, &n_allocated,
+                               MEMIF_TEST_BUFFER_SIZE),
+            MEMIF_ERR_SUCCESS);
+  ASSERT_EQ(n_allocated, 1);
+  const uint8_t reply[] = "application to forwarder";
+  memcpy(tx_buf.data, reply, sizeof(reply));
+  tx_buf.len = sizeof(reply);
+  uint16_t n_sent = 0;
+  ASSERT_EQ(memif_tx_burst(slave_, 0, &tx_buf, 1, &n_sent), MEMIF_ERR_SUCCESS);
+  ASSERT_EQ(n_sent, 1);
+
+  EXPECT_TRUE(
+      wait_for([&] { return connection->stats.io.rx_segments == 1; }));
+
+  // Close: the forwarder sees the application leave
+  ASSERT_EQ(memif_delete(&slave_), MEMIF_ERR_SUCCESS);
+  slave_ = NULL;
+  EXPECT_TRUE(wait_for([&] {
+    return !connection_send_packet(connection, packet, sizeof(packet));
+  }));
+}
@@ -189,3 +189,78 @@ TEST_F(MsgbufPoolTest, CloneMsgbuf) {
   EXPECT_NE(new_msgbuf, msgbuf);
   EXPECT_TRUE(memcmp(msgbuf, new_msgbuf, sizeof(msgbuf_t)) == 0);
 }
+
+class MsgbufPoolCloneHeaderTest : public MsgbufPoolTest {
+ protected:
+  static constexpr size_t LEN = 400;
+  static constexpr size_t HEADER_LEN = 100;
+
+  off_t packet_create(msgbuf_t **msgbuf) {
+    off_t msgbuf_id = msgbuf_pool_get(msgbuf_pool, msgbuf);
+    hicn_packet_buffer_t *pkbuf = msgbuf_get_pkbuf(*msgbuf);
+    hicn_packet_set_format(pkbuf, HICN_PACKET_FORMAT_IPV6_TCP);
+    hicn_packet_set_type(pkbuf, HICN_PACKET_TYPE_INTEREST);
+    hicn_packet_set_buffer(pkbuf, (*msgbuf)->packet, MTU, 0);
+    EXPECT_EQ(hicn_packet_init_header(pkbuf, 0), 0);
+    msgbuf_set_len(*msgbuf, LEN);
+    for (size_t i = 0; i < LEN; i++) (*msgbuf)->packet[i] = (uint8_t)i;
+    return msgbuf_id;
+  }
+};
+
+TEST_F(MsgbufPoolCloneHeaderTest, SharesPacket) {
+  msgbuf_t *msgbuf;
+  off_t msgbuf_id = packet_create(&msgbuf);
+  msgbuf_pool_acquire(msgbuf);
+
+  msgbuf_t *clone;
+  off_t clone_id =
+      msgbuf_pool_clone_header(msgbuf_pool, &clone, msgbuf_id, HEADER_LEN);
+  msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+  EXPECT_TRUE(msgbuf_is_shared(clone));
+  EXPECT_FALSE(msgbuf_is_shared(msgbuf));
+  EXPECT_EQ(msgbuf_get_len(clone), LEN);
+  EXPECT_EQ(msgbuf->refs, 2u);
+  EXPECT_EQ(clone->refs, 0u);
+
+  // The header can be modified independently of the original packet
+  clone->packet[0] = 0xff;
+
+  struct iovec iov[2];
+  ASSERT_EQ(msgbuf_pool_get_iovecs(msgbuf_pool, clone, iov), 2u);
+  EXPECT_EQ(iov[0].iov_base, clone->packet);
+  EXPECT_EQ(iov[0].iov_len, HEADER_LEN);
+  EXPECT_EQ(iov[1].iov_base, msgbuf->packet + HEADER_LEN);
+  EXPECT_EQ(iov[1].iov_len, LEN - HEADER_LEN);
+  EXPECT_EQ(msgbuf_pool_get_iovecs(msgbuf_pool, msgbuf, iov), 1u);
+  EXPECT_EQ(iov[0].iov_len, LEN);
+
+  // Releasing the clone releases the original packet
+  msgbuf_pool_acquire(clone);
+  msgbuf_pool_release(msgbuf_pool, &clone);
+  EXPECT_EQ(clone, nullptr);
+  EXPECT_EQ(msgbuf->refs, 1u);
+  EXPECT_NE(clone_id, msgbuf_id);
+}
+
+TEST_F(MsgbufPoolCloneHeaderTest, Linearize) {
+  msgbuf_t *msgbuf;
+  off_t msgbuf_id = packet_create(&msgbuf);
+  msgbuf_pool_acquire(msgbuf);
+
+  msgbuf_t *clone;
+  msgbuf_pool_clone_header(msgbuf_pool, &clone, msgbuf_id, HEADER_LEN);
+  msgbuf = msgbuf_pool_at(msgbuf_pool, msgbuf_id);
+  msgbuf_pool_linearize(msgbuf_pool, clone);
+
+  EXPECT_FALSE(msgbuf_is_shared(clone));
+  EXPECT_EQ(msgbuf->refs, 1u);
+  EXPECT_EQ(memcmp(clone->packet, msgbuf->packet, LEN), 0);
+
+  // The original packet is not needed by the clone anymore
+  msgbuf_pool_release(msgbuf_pool, &msgbuf);
+  EXPECT_EQ(msgbuf, nullptr);
+  msgbuf_pool_acquire(clone);
+  msgbuf_pool_release(msgbuf_pool, &clone);
+  EXPECT_EQ(clone, nullptr);
+}
@@ -15,8 +15,12 @@
 
 #include <gtest/gtest.h>
 
+#include <cmath>
 #include <optional>
 #include <random>
+#include <string>
+#include <unistd.h>
+#include <vector>
 #include <hicn/test/test-utils.h>
 
 extern "C" {
@@ -31,6 +35,7 @@ static constexpr unsigned MSGBUF_ID = 0;
 static constexpr unsigned MSGBUF_ID_2 = 1;
 static constexpr unsigned MSGBUF_ID_3 = 2;
 static constexpr unsigned FIVE_SECONDS = 5000;
+static constexpr unsigned ONE_MINUTE = 60000;
 
 static constexpr int N_OPS = 50000;
 
@@ -75,6 +80,43 @@ class PacketCacheTest : public ::testing::Test {
     return msgbuf;
   }
 
+  msgbuf_t *data_msgbuf_create(msgbuf_pool_t *msgbuf_pool, unsigned conn_id,
+                               hicn_name_t *name,
+                               std::optional<Ticks> lifetime = FIVE_SECONDS) {
+    msgbuf_t *msgbuf = msgbuf_create(msgbuf_pool, conn_id, name, lifetime);
+    hicn_packet_set_type(msgbuf_get_pkbuf(msgbuf), HICN_PACKET_TYPE_DATA);
+    return msgbuf;
+  }
+
+  /*
+   * Request a data packet: it is served from the CS if possible, otherwise it
+   * is fetched and offered to the CS. Return true upon a CS hit.
+   */
+  bool request_data(pkt_cache_t *pkt_cache, msgbuf_pool_t *msgbuf_pool,
+                    off_t interest_msgbuf_id, hicn_name_t *name) {
+    pkt_cache_verdict_t verdict;
+    off_t data_msgbuf_id = INVALID_MSGBUF_ID;
+    pkt_cache_entry_t *entry = nullptr;
+    pkt_cache_on_interest(pkt_cache, msgbuf_pool, interest_msgbuf_id, &verdict,
+                          &data_msgbuf_id, &entry, name, true);
+    if (verdict == PKT_CACHE_VERDICT_FORWARD_DATA) return true;
+
+    msgbuf_t *data_msgbuf =
+        data_msgbuf_create(msgbuf_pool, CONN_ID, name, ONE_MINUTE);
+    data_msgbuf_id = msgbuf_pool_get_id(msgbuf_pool, data_msgbuf);
+    pkt_cache_pit_to_cs(pkt_cache, entry, msgbuf_pool, data_msgbuf,
+                        data_msgbuf_id,
+                        pkt_cache_get_entry_id(pkt_cache, entry));
+
+    // Not admitted in the CS
+    if (data_msgbuf->refs == 0) msgbuf_pool_put(msgbuf_pool, data_msgbuf);
+    return false;
+  }
+
+  std::string get_cs_disk_path() {
+    return "/tmp/hicn-light-cs-disk-" + std::to_string(getpid());
+  }
+
   hicn_name_t get_name_from_prefix(const char *prefix_str) {
     hicn_ip_address_t prefix;
     inet_pton(AF_INET6, prefix_str, (struct in6_addr *)&prefix);
@@ -93,6 +135,7 @@ class PacketCacheTest : public ::testing::Test {
   msgbuf_t *msgbuf;
 };
 
+#ifndef WITH_NAME_TABLE
 TEST_F(PacketCacheTest, LowLevelOperations) {
   kh_pkt_cache_prefix_t *prefix_to_suffixes = kh_init_pkt_cache_prefix();
   const hicn_name_prefix_t *prefix = hicn_name_get_prefix(&name);
@@ -120,6 +163,65 @@ TEST_F(PacketCacheTest, LowLevelOperations) {
 
   _prefix_map_free(prefix_to_suffixes);
 }
+#endif
+
+TEST_F(PacketCacheTest, NameTableOperations) {
+  name_table_t *table = name_table_create(0);
+  hicn_name_t tmp = name;
+
+  hicn_name_set_suffix(&tmp, 1);
+  name_table_put(table, &tmp, hicn_name_get_hash(&tmp), 11);
+  hicn_name_set_suffix(&tmp, 2);
+  name_table_put(table, &tmp, hicn_name_get_hash(&tmp), 22);
+  EXPECT_EQ(name_table_get(table, &tmp, hicn_name_get_hash(&tmp)), 22u);
+
+  hicn_name_set_suffix(&tmp, 5);
+  EXPECT_EQ(name_table_get(table, &tmp, hicn_name_get_hash(&tmp)),
+            NAME_TABLE_INVALID_VALUE);
+
+  // Replace, then remove and re-add
+  hicn_name_set_suffix(&tmp, 1);
+  name_table_put(table, &tmp, hicn_name_get_hash(&tmp), 111);
+  EXPECT_EQ(name_table_get(table, &tmp, hicn_name_get_hash(&tmp)), 111u);
+  EXPECT_TRUE(name_table_del(table, &tmp, hicn_name_get_hash(&tmp)));
+  EXPECT_FALSE(name_table_del(table, &tmp, hicn_name_get_hash(&tmp)));
+  EXPECT_EQ(name_table_get(table, &tmp, hicn_name_get_hash(&tmp)),
+            NAME_TABLE_INVALID_VALUE);
+  name_table_put(table, &tmp, hicn_name_get_hash(&tmp), 1111);
+  EXPECT_EQ(name_table_size(table), 2u);
+
+  // Names sharing the suffix but not the prefix are distinct
+  hicn_name_t other = get_name_from_prefix("b002::0");
+  hicn_name_set_suffix(&other, 1);
+  EXPECT_EQ(name_table_get(table, &other, hicn_name_get_hash(&other)),
+            NAME_TABLE_INVALID_VALUE);
+
+  // Grow the table, and leave DELETED slots behind
+  for (int seq = 0; seq < N_OPS; seq++) {
+    hicn_name_set_suffix(&other, seq);
+    name_table_put(table, &other, hicn_name_get_hash(&other), seq);
+  }
+  for (int seq = 0; seq < N_OPS; seq += 2) {
+    hicn_name_set_suffix(&other, seq);
+    EXPECT_TRUE(name_table_del(table, &other, hicn_name_get_hash(&other)));
+  }
+  EXPECT_EQ(name_table_size(table), 2u + N_OPS / 2);
+
+  for (int seq = 0; seq < N_OPS; seq++) {
+    hicn_name_set_suffix(&other, seq);
+    unsigned expected = seq % 2 ? seq : NAME_TABLE_INVALID_VALUE;
+    EXPECT_EQ(name_table_get(table, &other, hicn_name_get_hash(&other)),
+              expected);
+  }
+  EXPECT_EQ(name_table_get(table, &tmp, hicn_name_get_hash(&tmp)), 1111u);
+
+  name_table_clear(table);
+  EXPECT_EQ(name_table_size(table), 0u);
+  EXPECT_EQ(name_table_get(table, &tmp, hicn_name_get_hash(&tmp)),
+            NAME_TABLE_INVALID_VALUE);
+
+  name_table_free(table);
+}
 
 TEST_F(PacketCacheTest, CreatePacketCache) {
   // Check packet cache allocation
@@ -576,6 +678,7 @@ TEST_F(PacketCacheTest, GetMultipleStaleEntries) {
   EXPECT_EQ(num_stale_entries, (size_t)NUM_STALES);
 }
 
+#ifndef WITH_NAME_TABLE
 TEST_F(PacketCacheTest, PerformanceDoubleLookup) {
   hicn_name_t tmp = get_name_from_prefix("b001::0");
 
@@ -662,6 +765,91 @@ TEST_F(PacketCacheTest, PerformanceCachedLookupRandom) {
   });
   std::cout << "Cached lookup (rand): " << elapsed_time_single_rand << " ms\n";
 }
+#endif
+
+/*
+ * Index operations through the packet cache, so that the two layouts (two-level
+ * hash table or flat name table with WITH_NAME_TABLE) can be compared.
+ */
+TEST_F(PacketCacheTest, PerformanceIndexLookup) {
+  static constexpr int N_PREFIXES = 16;
+  hicn_name_t prefixes[N_PREFIXES];
+  for (int i = 0; i < N_PREFIXES; i++) {
+    std::string prefix_str = "b001::" + std::to_string(i) + ":0";
+    prefixes[i] = get_name_from_prefix(prefix_str.c_str());
+  }
+
+  // Random names spread over the prefixes
+  std::random_device rd;
+  std::mt19937 gen(rd());
+  std::vector<hicn_name_t> names(N_OPS);
+  for (int seq = 0; seq < N_OPS; seq++) {
+    names[seq] = prefixes[seq % N_PREFIXES];
+    hicn_name_set_suffix(&names[seq], seq);
+  }
+  std::shuffle(names.begin(), names.end(), gen);
+
+  for (int seq = 0; seq < N_OPS; seq++) {
+    pkt_cache_entry_t *entry = pkt_cache_allocate(pkt_cache);
+    entry->name = names[seq];
+    entry->entry_type = PKT_CACHE_PIT_TYPE;
+    entry->has_expire_ts = false;
+    pkt_cache_add_to_index(pkt_cache, entry);
+  }
+  std::shuffle(names.begin(), names.end(), gen);
+
+  pkt_cache_lookup_t lookup_result;
+  off_t entry_id;
+  auto elapsed_time = get_execution_time([&]() {
+    for (int seq = 0; seq < N_OPS; seq++) {
+      pkt_cache_lookup(pkt_cache, &names[seq], msgbuf_pool, &lookup_result,
+                       &entry_id, true);
+      EXPECT_EQ(lookup_result, PKT_CACHE_LU_INTEREST_NOT_EXPIRED);
+    }
+  });
+#ifdef WITH_NAME_TABLE
+  std::cout << "Index lookup (flat): " << elapsed_time << " ms\n";
+#else
+  std::cout << "Index lookup (two-level): " << elapsed_time << " ms\n";
+#endif
+}
+
+TEST_F(PacketCacheTest, PrefetchBatch) {
+  static constexpr int BATCH_SIZE = 8;
+  off_t msgbuf_ids[BATCH_SIZE];
+  hicn_name_t names[BATCH_SIZE];
+
+  for (int i = 0; i < BATCH_SIZE; i++) {
+    names[i] = get_name_from_prefix("b001::0");
+    hicn_name_set_suffix(&names[i], i);
+    msgbuf_t *msgbuf = msgbuf_create(msgbuf_pool, CONN_ID, &names[i]);
+    msgbuf_ids[i] = msgbuf_pool_get_id(msgbuf_pool, msgbuf);
+    EXPECT_EQ(msgbuf_get_name_hash(msgbuf), hicn_name_get_hash(&names[i]));
+  }
+
+  // Prefetching has no visible effect on the processing of the batch
+  pkt_cache_prefetch(pkt_cache, msgbuf_pool, msgbuf_ids, BATCH_SIZE);
+  for (int i = 0; i < BATCH_SIZE; i++) {
+    pkt_cache_verdict_t verdict;
+    off_t data_msgbuf_id = INVALID_MSGBUF_ID;
+    pkt_cache_on_interest(pkt_cache, msgbuf_pool, msgbuf_ids[i], &verdict,
+                          &data_msgbuf_id, &entry,
+                          msgbuf_get_name(msgbuf_pool_at(msgbuf_pool,
+                                                         msgbuf_ids[i])),
+                          true);
+    EXPECT_EQ(verdict, PKT_CACHE_VERDICT_FORWARD_INTEREST);
+  }
+  EXPECT_EQ(pkt_cache_get_pit_size(pkt_cache), (size_t)BATCH_SIZE);
+
+  pkt_cache_prefetch(pkt_cache, msgbuf_pool, msgbuf_ids, BATCH_SIZE);
+  for (int i = 0; i < BATCH_SIZE; i++) {
+    pkt_cache_lookup_t lookup_result;
+    off_t entry_id;
+    pkt_cache_lookup(pkt_cache, &names[i], msgbuf_pool, &lookup_result,
+                     &entry_id, true);
+    EXPECT_EQ(lookup_result, PKT_CACHE_LU_INTEREST_NOT_EXPIRED);
+  }
+}
 
 TEST_F(PacketCacheTest, Clear) {
   hicn_name_t tmp_name1, tmp_name2;
@@ -701,3 +889,481 @@ TEST_F(PacketCacheTest, Clear) {
   ASSERT_EQ(cs->num_entries, 0);
   ASSERT_EQ(cs->stats.lru.countAdds, 0u);
 }
+
+TEST_F(PacketCacheTest, SweepExpiredEntries) {
+  hicn_name_t name_1 = get_name_from_prefix("b001::1");
+  hicn_name_t name_2 = get_name_from_prefix("b001::2");
+  hicn_name_t name_3 = get_name_from_prefix("b001::3");
+  hicn_name_t name_4 = get_name_from_prefix("b001::4");
+
+  // Expired PIT and CS entries
+  msgbuf_t *msgbuf_1 = msgbuf_create(msgbuf_pool, CONN_ID, &name_1, 0);
+  pkt_cache_add_to_pit(pkt_cache, msgbuf_1, &name_1);
+  msgbuf_t *msgbuf_2 = data_msgbuf_create(msgbuf_pool, CONN_ID, &name_2, 0);
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf_2,
+                      msgbuf_pool_get_id(msgbuf_pool, msgbuf_2));
+
+  // Valid PIT and CS entries
+  msgbuf_t *msgbuf_3 = msgbuf_create(msgbuf_pool, CONN_ID, &name_3);
+  pkt_cache_add_to_pit(pkt_cache, msgbuf_3, &name_3);
+  msgbuf_t *msgbuf_4 = data_msgbuf_create(msgbuf_pool, CONN_ID, &name_4);
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf_4,
+                      msgbuf_pool_get_id(msgbuf_pool, msgbuf_4));
+
+  pkt_cache_stats_t stats = pkt_cache_get_stats(pkt_cache);
+  EXPECT_EQ(stats.n_pit_stale_entries, 1u);
+  EXPECT_EQ(stats.n_cs_stale_entries, 1u);
+
+  Ticks later = ticks_now() + 2 * PKT_CACHE_WHEEL_SLOT_TICKS;
+  size_t n_pit_expired, n_cs_expired;
+  EXPECT_TRUE(pkt_cache_sweep(pkt_cache, msgbuf_pool, later,
+                              PKT_CACHE_SWEEP_BUDGET, &n_pit_expired,
+                              &n_cs_expired));
+  EXPECT_EQ(n_pit_expired, 1u);
+  EXPECT_EQ(n_cs_expired, 1u);
+
+  EXPECT_EQ(pkt_cache_get_pit_size(pkt_cache), 1u);
+  EXPECT_EQ(pkt_cache_get_cs_size(pkt_cache), 1u);
+  stats = pkt_cache_get_stats(pkt_cache);
+  EXPECT_EQ(stats.n_pit_stale_entries, 0u);
+  EXPECT_EQ(stats.n_cs_stale_entries, 0u);
+  EXPECT_EQ(stats.n_pit_expired, 1u);
+  EXPECT_EQ(stats.n_cs_expired, 1u);
+
+  // The data packet has been released by the CS
+  EXPECT_EQ(msgbuf_2->refs, 0u);
+
+  pkt_cache_lookup_t lookup_result;
+  off_t entry_id;
+  pkt_cache_lookup(pkt_cache, &name_1, msgbuf_pool, &lookup_result, &entry_id,
+                   true);
+  EXPECT_EQ(lookup_result, PKT_CACHE_LU_NONE);
+  pkt_cache_lookup(pkt_cache, &name_2, msgbuf_pool, &lookup_result, &entry_id,
+                   true);
+  EXPECT_EQ(lookup_result, PKT_CACHE_LU_NONE);
+  pkt_cache_lookup(pkt_cache, &name_3, msgbuf_pool, &lookup_result, &entry_id,
+                   true);
+  EXPECT_EQ(lookup_result, PKT_CACHE_LU_INTEREST_NOT_EXPIRED);
+  pkt_cache_lookup(pkt_cache, &name_4, msgbuf_pool, &lookup_result, &entry_id,
+                   true);
+  EXPECT_EQ(lookup_result, PKT_CACHE_LU_DATA_NOT_EXPIRED);
+}
+
+TEST_F(PacketCacheTest, SweepFollowsLifetimeExtension) {
+  // Interest expiring now, then aggregated with a longer lifetime
+  msgbuf_t *msgbuf_1 = msgbuf_create(msgbuf_pool, CONN_ID, &name, 0);
+  pkt_cache_entry_t *entry = pkt_cache_add_to_pit(pkt_cache, msgbuf_1, &name);
+  msgbuf_t *msgbuf_2 = msgbuf_create(msgbuf_pool, CONN_ID_2, &name);
+  pkt_cache_try_aggregate_in_pit(pkt_cache, entry, msgbuf_2, &name);
+
+  Ticks later = ticks_now() + 2 * PKT_CACHE_WHEEL_SLOT_TICKS;
+  size_t n_pit_expired, n_cs_expired;
+  EXPECT_TRUE(pkt_cache_sweep(pkt_cache, msgbuf_pool, later,
+                              PKT_CACHE_SWEEP_BUDGET, &n_pit_expired,
+                              &n_cs_expired));
+  EXPECT_EQ(pkt_cache_get_pit_size(pkt_cache), 1u);
+  EXPECT_EQ(n_pit_expired, 0u);
+
+  later = ticks_now() + FIVE_SECONDS + 2 * PKT_CACHE_WHEEL_SLOT_TICKS;
+  EXPECT_TRUE(pkt_cache_sweep(pkt_cache, msgbuf_pool, later,
+                              PKT_CACHE_SWEEP_BUDGET, &n_pit_expired,
+                              &n_cs_expired));
+  EXPECT_EQ(pkt_cache_get_pit_size(pkt_cache), 0u);
+  EXPECT_EQ(n_pit_expired, 1u);
+}
+
+TEST_F(PacketCacheTest, SweepIsBounded) {
+  static constexpr unsigned N_ENTRIES = 1000;
+  static constexpr unsigned BUDGET = 64;
+
+  // Churn of unique names never satisfied
+  for (unsigned i = 0; i < N_ENTRIES; i++) {
+    hicn_name_t tmp_name;
+    hicn_name_copy(&tmp_name, &name);
+    hicn_name_set_suffix(&tmp_name, i);
+    msgbuf_t *msgbuf = msgbuf_create(msgbuf_pool, CONN_ID, &tmp_name, 0);
+    pkt_cache_add_to_pit(pkt_cache, msgbuf, &tmp_name);
+  }
+  EXPECT_EQ(pkt_cache_get_stats(pkt_cache).n_pit_stale_entries, N_ENTRIES);
+
+  Ticks later = ticks_now() + 2 * PKT_CACHE_WHEEL_SLOT_TICKS;
+  unsigned n_slices = 1;
+  size_t n_pit_expired, n_cs_expired;
+  while (!pkt_cache_sweep(pkt_cache, msgbuf_pool, later, BUDGET,
+                          &n_pit_expired, &n_cs_expired)) {
+    // Each slice reclaims at most its budget
+    EXPECT_EQ(n_pit_expired, BUDGET);
+    EXPECT_GE(pkt_cache_get_pit_size(pkt_cache), N_ENTRIES - n_slices * BUDGET);
+    n_slices++;
+  }
+
+  EXPECT_EQ(n_slices, (N_ENTRIES + BUDGET - 1) / BUDGET);
+  EXPECT_EQ(pkt_cache_get_size(pkt_cache), 0u);
+  EXPECT_EQ(pkt_cache_get_stats(pkt_cache).n_pit_expired, N_ENTRIES);
+}
+
+TEST_F(PacketCacheTest, SweepResumeSeesNewEntries) {
+  static constexpr unsigned N_ENTRIES = 10;
+  static constexpr unsigned N_KEPT = 5;
+  static constexpr unsigned BUDGET = 4;
+  // Entries expiring one revolution later share the slot of the others
+  static constexpr Ticks REVOLUTION =
+      PKT_CACHE_WHEEL_SIZE * PKT_CACHE_WHEEL_SLOT_TICKS;
+
+  hicn_name_t tmp_name;
+  hicn_name_copy(&tmp_name, &name);
+  unsigned suffix = 0;
+  auto add_interest = [&](Ticks lifetime) {
+    hicn_name_set_suffix(&tmp_name, suffix++);
+    msgbuf_t *msgbuf = msgbuf_create(msgbuf_pool, CONN_ID, &tmp_name, lifetime);
+    pkt_cache_add_to_pit(pkt_cache, msgbuf, &tmp_name);
+  };
+
+  for (unsigned i = 0; i < N_ENTRIES; i++) {
+    add_interest(0);
+    if (i < N_KEPT) add_interest(REVOLUTION);
+  }
+
+  Ticks later = ticks_now() + 2 * PKT_CACHE_WHEEL_SLOT_TICKS;
+  size_t n_pit_expired, n_cs_expired;
+  size_t total_expired = 0;
+  EXPECT_FALSE(pkt_cache_sweep(pkt_cache, msgbuf_pool, later, BUDGET,
+                               &n_pit_expired, &n_cs_expired));
+  total_expired += n_pit_expired;
+
+  // An entry added to the slot being swept is found when the sweep resumes
+  add_interest(0);
+
+  unsigned n_slices = 1;
+  while (!pkt_cache_sweep(pkt_cache, msgbuf_pool, later, BUDGET,
+                          &n_pit_expired, &n_cs_expired)) {
+    total_expired += n_pit_expired;
+    ASSERT_LT(++n_slices, N_ENTRIES + N_KEPT);
+  }
+  total_expired += n_pit_expired;
+
+  EXPECT_EQ(total_expired, N_ENTRIES + 1);
+  EXPECT_EQ(n_cs_expired, 0u);
+  EXPECT_EQ(pkt_cache_get_pit_size(pkt_cache), N_KEPT);
+}
+
+TEST_F(PacketCacheTest, DiskTierDemoteAndPromote) {
+  ASSERT_EQ(pkt_cache_set_cs_disk(pkt_cache, get_cs_disk_path().c_str(),
+                                  CS_DISK_MIN_SIZE),
+            0);
+  ASSERT_EQ(pkt_cache_set_cs_size(pkt_cache, 1), 0);
+
+  hicn_name_t name_1 = get_name_from_prefix("b001::1");
+  hicn_name_t name_2 = get_name_from_prefix("b001::2");
+  msgbuf_t *msgbuf_1 = data_msgbuf_create(msgbuf_pool, CONN_ID, &name_1);
+  msgbuf_set_len(msgbuf_1, 100);
+  memset(msgbuf_get_packet(msgbuf_1) + 60, 0xab, 40);
+  off_t msgbuf_id_1 = msgbuf_pool_get_id(msgbuf_pool, msgbuf_1);
+  msgbuf_t *msgbuf_2 = data_msgbuf_create(msgbuf_pool, CONN_ID_2, &name_2);
+  off_t msgbuf_id_2 = msgbuf_pool_get_id(msgbuf_pool, msgbuf_2);
+
+  // The first entry is evicted to disk when the second one is added
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf_1, msgbuf_id_1);
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf_2, msgbuf_id_2);
+  EXPECT_EQ(pkt_cache_get_cs_size(pkt_cache), 1u);
+  EXPECT_EQ(pkt_cache_get_cs_disk_size(pkt_cache), 1u);
+
+  pkt_cache_lookup_t lookup_result;
+  off_t entry_id;
+  pkt_cache_lookup(pkt_cache, &name_1, msgbuf_pool, &lookup_result, &entry_id,
+                   true);
+  EXPECT_EQ(lookup_result, PKT_CACHE_LU_NONE);
+
+  // An interest for the first entry is served from disk, and the entry moved
+  // back to the CS, in place of the second one
+  pkt_cache_verdict_t verdict;
+  off_t data_msgbuf_id = INVALID_MSGBUF_ID;
+  pkt_cache_entry_t *entry = nullptr;
+  pkt_cache_on_interest(pkt_cache, msgbuf_pool, MSGBUF_ID, &verdict,
+                        &data_msgbuf_id, &entry, &name_1, true);
+  EXPECT_EQ(verdict, PKT_CACHE_VERDICT_FORWARD_DATA);
+  ASSERT_TRUE(msgbuf_id_is_valid(data_msgbuf_id));
+  ASSERT_NE(entry, nullptr);
+  EXPECT_EQ(entry->entry_type, PKT_CACHE_CS_TYPE);
+  EXPECT_EQ(entry->u.cs_entry.msgbuf_id, data_msgbuf_id);
+
+  msgbuf_t *data_msgbuf = msgbuf_pool_at(msgbuf_pool, data_msgbuf_id);
+  EXPECT_EQ(msgbuf_get_type(data_msgbuf), HICN_PACKET_TYPE_DATA);
+  EXPECT_TRUE(hicn_name_equals(msgbuf_get_name(data_msgbuf), &name_1));
+  EXPECT_EQ(msgbuf_get_connection_id(data_msgbuf), CONN_ID);
+  ASSERT_EQ(msgbuf_get_len(data_msgbuf), 100u);
+  EXPECT_EQ(msgbuf_get_packet(data_msgbuf)[99], 0xab);
+  EXPECT_EQ(msgbuf_get_data_expiry_time(data_msgbuf), FIVE_SECONDS);
+
+  EXPECT_EQ(pkt_cache_get_cs_size(pkt_cache), 1u);
+  EXPECT_EQ(pkt_cache_get_cs_disk_size(pkt_cache), 1u);
+
+  pkt_cache_stats_t stats = pkt_cache_get_stats(pkt_cache);
+  EXPECT_EQ(stats.n_cs_disk_hits, 1u);
+  EXPECT_EQ(stats.n_cs_disk_misses, 0u);
+  EXPECT_EQ(stats.n_cs_disk_promotions, 1u);
+  EXPECT_EQ(stats.n_cs_disk_demotions, 2u);
+
+  // Nothing on disk for other names: the interest goes to the PIT
+  hicn_name_t name_3 = get_name_from_prefix("b001::3");
+  pkt_cache_on_interest(pkt_cache, msgbuf_pool, MSGBUF_ID, &verdict,
+                        &data_msgbuf_id, &entry, &name_3, true);
+  EXPECT_EQ(verdict, PKT_CACHE_VERDICT_FORWARD_INTEREST);
+  EXPECT_EQ(entry->entry_type, PKT_CACHE_PIT_TYPE);
+  EXPECT_EQ(pkt_cache_get_stats(pkt_cache).n_cs_disk_misses, 1u);
+
+  // Clearing the CS also clears the disk tier
+  pkt_cache_cs_clear(pkt_cache);
+  EXPECT_EQ(pkt_cache_get_cs_disk_size(pkt_cache), 0u);
+}
+
+TEST_F(PacketCacheTest, DiskTierSkipsExpiredData) {
+  ASSERT_EQ(pkt_cache_set_cs_disk(pkt_cache, get_cs_disk_path().c_str(),
+                                  CS_DISK_MIN_SIZE),
+            0);
+  ASSERT_EQ(pkt_cache_set_cs_size(pkt_cache, 1), 0);
+
+  hicn_name_t name_1 = get_name_from_prefix("b001::1");
+  hicn_name_t name_2 = get_name_from_prefix("b001::2");
+  msgbuf_t *msgbuf_1 = data_msgbuf_create(msgbuf_pool, CONN_ID, &name_1, 0);
+  off_t msgbuf_id_1 = msgbuf_pool_get_id(msgbuf_pool, msgbuf_1);
+  msgbuf_t *msgbuf_2 = data_msgbuf_create(msgbuf_pool, CONN_ID, &name_2);
+  off_t msgbuf_id_2 = msgbuf_pool_get_id(msgbuf_pool, msgbuf_2);
+
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf_1, msgbuf_id_1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf_2, msgbuf_id_2);
+
+  EXPECT_EQ(pkt_cache_get_cs_disk_size(pkt_cache), 0u);
+  EXPECT_EQ(pkt_cache_get_stats(pkt_cache).n_cs_disk_demotions, 0u);
+}
+
+TEST_F(PacketCacheTest, DiskTierRecyclesSegments) {
+  cs_disk_t *disk =
+      cs_disk_create(get_cs_disk_path().c_str(), CS_DISK_MIN_SIZE);
+  ASSERT_NE(disk, nullptr);
+
+  // Fill the file several times over
+  hicn_name_t tmp_name;
+  hicn_name_copy(&tmp_name, &name);
+  msgbuf_t *data_msgbuf = data_msgbuf_create(msgbuf_pool, CONN_ID, &tmp_name);
+  msgbuf_set_len(data_msgbuf, MTU);
+
+  const unsigned n_packets = 4 * CS_DISK_MIN_SIZE / MTU;
+  for (unsigned i = 0; i < n_packets; i++) {
+    hicn_name_set_suffix(&tmp_name, i);
+    msgbuf_set_name(data_msgbuf, &tmp_name);
+    ASSERT_EQ(cs_disk_store(disk, data_msgbuf, ticks_now() + FIVE_SECONDS),
+              0);
+  }
+
+  cs_disk_stats_t stats = cs_disk_get_stats(disk);
+  EXPECT_EQ(stats.countDemotions, n_packets);
+  EXPECT_GT(stats.countDrops, 0u);
+  EXPECT_EQ(cs_disk_get_num_entries(disk), n_packets - stats.countDrops);
+  EXPECT_LT(cs_disk_get_num_entries(disk) * MTU, (size_t)CS_DISK_MIN_SIZE);
+
+  // Oldest packets are gone, the most recent ones can be loaded back
+  Ticks expire_ts;
+  hicn_name_set_suffix(&tmp_name, 0);
+  EXPECT_FALSE(msgbuf_id_is_valid(
+      cs_disk_load(disk, &tmp_name, msgbuf_pool, &expire_ts)));
+  hicn_name_set_suffix(&tmp_name, n_packets - 1);
+  EXPECT_TRUE(msgbuf_id_is_valid(
+      cs_disk_load(disk, &tmp_name, msgbuf_pool, &expire_ts)));
+  cs_disk_remove(disk, &tmp_name);
+  EXPECT_EQ(cs_disk_get_num_entries(disk), n_packets - stats.countDrops - 1);
+
+  cs_disk_free(disk);
+}
+
+TEST_F(PacketCacheTest, DiskTierKeepsRecordUntilRemoved) {
+  cs_disk_t *disk =
+      cs_disk_create(get_cs_disk_path().c_str(), CS_DISK_MIN_SIZE);
+  ASSERT_NE(disk, nullptr);
+
+  msgbuf_t *data_msgbuf = data_msgbuf_create(msgbuf_pool, CONN_ID, &name);
+  ASSERT_EQ(cs_disk_store(disk, data_msgbuf, ticks_now() + FIVE_SECONDS), 0);
+
+  // Loading does not remove the record, e.g. if the CS rejects the packet
+  Ticks expire_ts;
+  off_t msgbuf_id = cs_disk_load(disk, &name, msgbuf_pool, &expire_ts);
+  ASSERT_TRUE(msgbuf_id_is_valid(msgbuf_id));
+  msgbuf_pool_put(msgbuf_pool, msgbuf_pool_at(msgbuf_pool, msgbuf_id));
+  EXPECT_EQ(cs_disk_get_num_entries(disk), 1u);
+  EXPECT_EQ(cs_disk_get_stats(disk).countHits, 1u);
+  EXPECT_EQ(cs_disk_get_stats(disk).countPromotions, 0u);
+
+  // No hit is counted when no msgbuf is available to read the record
+  std::vector<off_t> msgbuf_ids;
+  while (pool_get_free_indices_size(msgbuf_pool->buffers) > 0) {
+    msgbuf_t *tmp;
+    msgbuf_ids.push_back(msgbuf_pool_get(msgbuf_pool, &tmp));
+  }
+  EXPECT_FALSE(msgbuf_id_is_valid(
+      cs_disk_load(disk, &name, msgbuf_pool, &expire_ts)));
+  EXPECT_EQ(cs_disk_get_stats(disk).countHits, 1u);
+  for (off_t id : msgbuf_ids)
+    msgbuf_pool_put(msgbuf_pool, msgbuf_pool_at(msgbuf_pool, id));
+
+  msgbuf_id = cs_disk_load(disk, &name, msgbuf_pool, &expire_ts);
+  ASSERT_TRUE(msgbuf_id_is_valid(msgbuf_id));
+  msgbuf_pool_put(msgbuf_pool, msgbuf_pool_at(msgbuf_pool, msgbuf_id));
+  EXPECT_EQ(cs_disk_get_stats(disk).countHits, 2u);
+
+  cs_disk_remove(disk, &name);
+  EXPECT_EQ(cs_disk_get_num_entries(disk), 0u);
+  EXPECT_EQ(cs_disk_get_stats(disk).countPromotions, 1u);
+  EXPECT_FALSE(msgbuf_id_is_valid(
+      cs_disk_load(disk, &name, msgbuf_pool, &expire_ts)));
+
+  cs_disk_free(disk);
+}
+
+TEST_F(PacketCacheTest, SetCsType) {
+  EXPECT_EQ(pkt_cache_get_cs_type(pkt_cache), CS_TYPE_LRU);
+
+  pkt_cache_add_to_cs(pkt_cache, msgbuf_pool, msgbuf, MSGBUF_ID);
+  ASSERT_EQ(pkt_cache_get_cs_size(pkt_cache), 1u);
+
+  // Changing the policy clears the CS, but keeps its capacity
+  ASSERT_EQ(pkt_cache_set_cs_type(pkt_cache, CS_TYPE_S3FIFO), 0);
+  EXPECT_EQ(pkt_cache_get_cs_type(pkt_cache), CS_TYPE_S3FIFO);
+  EXPECT_EQ(pkt_cache_get_cs_size(pkt_cache), 0u);
+  EXPECT_EQ(pkt_cache_get_cs(pkt_cache)->max_size, CS_SIZE);
+  EXPECT_STREQ(cs_type_str(CS_TYPE_S3FIFO), "s3fifo");
+
+  EXPECT_EQ(pkt_cache_set_cs_type(pkt_cache, CS_TYPE_UNDEFINED), -1);
+  EXPECT_EQ(pkt_cache_set_cs_type(pkt_cache, CS_TYPE_N), -1);
+  EXPECT_EQ(pkt_cache_get_cs_type(pkt_cache), CS_TYPE_S3FIFO);
+}
+
+TEST_F(PacketCacheTest, ScanResistance) {
+  static constexpr unsigned SMALL_CS_SIZE = 10;
+  static constexpr unsigned N_HOT = 5;
+  static constexpr unsigned N_SCAN = 100;
+
+  for (cs_type_t type : {CS_TYPE_LRU, CS_TYPE_TINYLFU, CS_TYPE_S3FIFO}) {
+    ASSERT_EQ(pkt_cache_set_cs_type(pkt_cache, type), 0);
+    ASSERT_EQ(pkt_cache_set_cs_size(pkt_cache, SMALL_CS_SIZE), 0);
+
+    // Popular content, requested a few times
+    hicn_name_t tmp_name = get_name_from_prefix("b001::0");
+    for (unsigned i = 0; i < N_HOT; i++) {
+      hicn_name_set_suffix(&tmp_name, i);
+      EXPECT_FALSE(request_data(pkt_cache, msgbuf_pool, MSGBUF_ID, &tmp_name));
+      EXPECT_TRUE(request_data(pkt_cache, msgbuf_pool, MSGBUF_ID, &tmp_name));
+      EXPECT_TRUE(request_data(pkt_cache, msgbuf_pool, MSGBUF_ID, &tmp_name));
+    }
+
+    // Sequential download, ten times larger than the CS
+    hicn_name_t scan_name = get_name_from_prefix("b002::0");
+    for (unsigned i = 0; i < N_SCAN; i++) {
+      hicn_name_set_suffix(&scan_name, i);
+      request_data(pkt_cache, msgbuf_pool, MSGBUF_ID, &scan_name);
+    }
+    EXPECT_EQ(pkt_cache_get_cs_size(pkt_cache), SMALL_CS_SIZE);
+
+    unsigned n_hits = 0;
+    for (unsigned i = 0; i < N_HOT; i++) {
+      hicn_name_set_suffix(&tmp_name, i);
+      n_hits += request_data(pkt_cache, msgbuf_pool, MSGBUF_ID, &tmp_name);
+    }
+
+    // LRU is flushed by the scan, the other policies keep popular content
+    if (type == CS_TYPE_LRU)
+      EXPECT_EQ(n_hits, 0u);
+    else
+      EXPECT_EQ(n_hits, N_HOT) << cs_type_str(type);
+  }
+}
+
+TEST_F(PacketCacheTest, EvictionKeepsIndexConsistent) {
+  static constexpr unsigned SMALL_CS_SIZE = 20;
+
+  std::mt19937 gen(1);
+  std::uniform_int_distribution<uint32_t> dist(0, 4 * SMALL_CS_SIZE);
+
+  for (cs_type_t type : {CS_TYPE_LRU, CS_TYPE_TINYLFU, CS_TYPE_S3FIFO}) {
+    ASSERT_EQ(pkt_cache_set_cs_type(pkt_cache, type), 0);
+    ASSERT_EQ(pkt_cache_set_cs_size(pkt_cache, SMALL_CS_SIZE), 0);
+
+    hicn_name_t tmp_name = get_name_from_prefix("b001::0");
+    for (unsigned i = 0; i < 5000; i++) {
+      hicn_name_set_suffix(&tmp_name, dist(gen));
+      request_data(pkt_cache, msgbuf_pool, MSGBUF_ID, &tmp_name);
+
+      // All packet cache entries are CS entries linked by the policy
+      ASSERT_LE(pkt_cache_get_cs_size(pkt_cache), SMALL_CS_SIZE);
+      ASSERT_EQ(pkt_cache_get_size(pkt_cache),
+                pkt_cache_get_cs_size(pkt_cache));
+    }
+
+    cs_lru_stats_t stats = cs_get_lru_stats(pkt_cache_get_cs(pkt_cache));
+    EXPECT_EQ(stats.countAdds - stats.countLruEvictions,
+              pkt_cache_get_cs_size(pkt_cache))
+        << cs_type_str(type);
+  }
+}
+
+/*
+ * Trace-driven hit ratio of the CS policies, on a Zipf workload alone and
+ * mixed with a sequential download (one request out of two). Only the hits on
+ * the Zipf requests are reported.
+ */
+TEST_F(PacketCacheTest, PerformanceHitRatio) {
+  static constexpr unsigned N_OBJECTS = 10000;
+  static constexpr unsigned BENCH_CS_SIZE = 1000;
+  static constexpr unsigned N_REQUESTS = 200000;
+  static constexpr double ZIPF_ALPHA = 0.9;
+
+  std::vector<double> weights(N_OBJECTS);
+  for (unsigned i = 0; i < N_OBJECTS; i++)
+    weights[i] = 1.0 / std::pow(i + 1, ZIPF_ALPHA);
+  std::discrete_distribution<uint32_t> zipf(weights.begin(), weights.end());
+  std::mt19937 gen(42);
+  std::vector<uint32_t> trace(N_REQUESTS);
+  for (auto &object : trace) object = zipf(gen);
+
+  auto run = [&](cs_type_t type, bool with_scan) {
+    pkt_cache_t *cache = pkt_cache_create(BENCH_CS_SIZE);
+    EXPECT_EQ(pkt_cache_set_cs_type(cache, type), 0);
+    msgbuf_pool_t *pool = msgbuf_pool_create();
+    hicn_name_t tmp_name = get_name_from_prefix("b001::0");
+    msgbuf_t *interest = msgbuf_create(pool, CONN_ID, &tmp_name);
+    off_t interest_id = msgbuf_pool_get_id(pool, interest);
+
+    unsigned n_hits = 0;
+    uint32_t scan_suffix = N_OBJECTS;
+    for (uint32_t object : trace) {
+      if (with_scan) {
+        hicn_name_set_suffix(&tmp_name, scan_suffix++);
+        request_data(cache, pool, interest_id, &tmp_name);
+      }
+      hicn_name_set_suffix(&tmp_name, object);
+      n_hits += request_data(cache, pool, interest_id, &tmp_name);
+    }
+
+    pkt_cache_free(cache);
+    msgbuf_pool_free(pool);
+    return (double)n_hits / N_REQUESTS;
+  };
+
+  double hit_ratios[CS_TYPE_N][2];
+  for (cs_type_t type : {CS_TYPE_LRU, CS_TYPE_TINYLFU, CS_TYPE_S3FIFO}) {
+    for (bool with_scan : {false, true}) {
+      auto start = std::chrono::high_resolution_clock::now();
+      double hit_ratio = run(type, with_scan);
+      std::chrono::duration<double, std::milli> elapsed_time =
+          std::chrono::high_resolution_clock::now() - start;
+
+      hit_ratios[type][with_scan] = hit_ratio;
+      std::cout << "Hit ratio (" << cs_type_str(type)
+                << (with_scan ? ", zipf + scan" : ", zipf") << "): " << hit_ratio
+                << " (" << elapsed_time.count() << " ms)\n";
+    }
+  }
+
+  EXPECT_GT(hit_ratios[CS_TYPE_TINYLFU][true], hit_ratios[CS_TYPE_LRU][true]);
+  EXPECT_GT(hit_ratios[CS_TYPE_S3FIFO][true], hit_ratios[CS_TYPE_LRU][true]);
+}
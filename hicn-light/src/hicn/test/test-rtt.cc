@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/core/msgbuf.h>
+#include <hicn/core/pit.h>
+#include <hicn/core/rtt.h>
+#include <hicn/core/ticks.h>
+}
+
+#define NEXTHOP1 50
+#define NEXTHOP2 51
+
+class RttTest : public ::testing::Test {
+ protected:
+  RttTest() {
+    rtt_ = RTT_STATS_EMPTY;
+
+    memset(&pit_entry_, 0, sizeof(pit_entry_));
+    pit_entry_.ingressIdSet = NEXTHOPS_EMPTY;
+    pit_entry_.egressIdSet = NEXTHOPS_EMPTY;
+    pit_entry_egress_add(&pit_entry_, NEXTHOP1);
+
+    memset(&data_, 0, sizeof(data_));
+    msgbuf_set_connection_id(&data_, NEXTHOP1);
+  }
+
+  virtual ~RttTest() {}
+
+  rtt_stats_t rtt_;
+  pit_entry_t pit_entry_;
+  msgbuf_t data_;
+};
+
+TEST_F(RttTest, FirstSample) {
+  rtt_stats_update(&rtt_, 200);
+
+  EXPECT_EQ(rtt_.srtt, 200u);
+  EXPECT_EQ(rtt_.rttvar, 100u);
+  EXPECT_EQ(rtt_.min, 200u);
+  EXPECT_EQ(rtt_.n_samples, 1u);
+}
+
+TEST_F(RttTest, Convergence) {
+  rtt_stats_update(&rtt_, 1000);
+  for (int i = 0; i < 100; i++) rtt_stats_update(&rtt_, 100);
+
+  // The estimate converges to a stable RTT, with a vanishing variation
+  EXPECT_NEAR(rtt_.srtt, 100, 8);
+  EXPECT_LT(rtt_.rttvar, 8u);
+  EXPECT_EQ(rtt_.min, 100u);
+  EXPECT_EQ(rtt_.n_samples, 101u);
+
+  // ... and follows it upwards
+  for (int i = 0; i < 100; i++) rtt_stats_update(&rtt_, 300);
+  EXPECT_NEAR(rtt_.srtt, 300, 8);
+  EXPECT_EQ(rtt_.min, 100u);
+}
+
+TEST_F(RttTest, SubMillisecondResolution) {
+  Usecs t0 = usecs_now();
+  struct timespec ts = {0, 200000};  // 200 us
+  nanosleep(&ts, NULL);
+  Usecs t1 = usecs_now();
+
+  EXPECT_GE(t1 - t0, 200u);
+  EXPECT_LT(t1 - t0, 100000u);
+}
+
+TEST_F(RttTest, PitSample) {
+  Usecs rtt;
+
+  // Not forwarded yet
+  EXPECT_FALSE(pit_entry_get_rtt(&pit_entry_, &data_, &rtt));
+
+  pit_entry_on_forward(&pit_entry_, 1000);
+  data_.recv_ts = 1250;
+  EXPECT_TRUE(pit_entry_get_rtt(&pit_entry_, &data_, &rtt));
+  EXPECT_EQ(rtt, 250u);
+
+  // Data from a connection the interest was not forwarded to
+  msgbuf_set_connection_id(&data_, NEXTHOP2);
+  EXPECT_FALSE(pit_entry_get_rtt(&pit_entry_, &data_, &rtt));
+}
+
+TEST_F(RttTest, PitRetransmissionIsAmbiguous) {
+  Usecs rtt;
+
+  pit_entry_on_forward(&pit_entry_, 1000);
+  pit_entry_on_forward(&pit_entry_, 2000);
+  data_.recv_ts = 2100;
+
+  EXPECT_EQ(pit_entry_.send_ts, 1000u);
+  EXPECT_FALSE(pit_entry_get_rtt(&pit_entry_, &data_, &rtt));
+}
@@ -0,0 +1,199 @@
+/*
+ * Copyright (c) 2021-2022 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <random>
+#include <vector>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/core/rtt.h>
+#include <hicn/core/strategy.h>
+#include <hicn/strategies/low_latency.h>
+}
+
+#define SIM_SEED 42
+#define SIM_INTERVAL 100        // us between interests
+#define SIM_LIFETIME 100000     // us before an unanswered interest expires
+#define SIM_WARMUP 2000         // interests
+#define SIM_N_INTERESTS 20000
+
+/* A simulated link: fixed RTT and independent losses */
+typedef struct {
+  Usecs rtt;
+  double loss;
+} link_t;
+
+/*
+ * Deterministic simulation of a FIB entry with the low latency strategy over
+ * heterogeneous links. Interests are sent at a constant rate, and their data
+ * (or their expiry) is delivered to the strategy in the same order as the
+ * forwarder would.
+ */
+class StrategyLowLatency : public ::testing::Test {
+ protected:
+  StrategyLowLatency() : rng_(SIM_SEED) {
+    srand(SIM_SEED);
+    entry_ = {
+        .type = STRATEGY_TYPE_LOW_LATENCY,
+        .options = {.low_latency = {}},
+        .state = {.low_latency = {}},
+    };
+    strategy_initialize(&entry_, nullptr);
+    nexthops_ = NEXTHOPS_EMPTY;
+    now_ = 0;
+  }
+  virtual ~StrategyLowLatency() {}
+
+  void add_link(link_t link) {
+    nexthop_t nexthop = NEXTHOP(links_.size());
+    links_.push_back(link);
+    sent_.push_back(0);
+    off_t id = nexthops_add(&nexthops_, nexthop);
+    strategy_add_nexthop(&entry_, &nexthops_, id);
+  }
+
+  /* Deliver events up to the current time */
+  void deliver() {
+    while (!events_.empty() && events_.begin()->first <= now_) {
+      auto event = events_.begin();
+      Usecs send_ts = event->second.first;
+      nexthop_t nexthop = event->second.second;
+      events_.erase(event);
+
+      nexthops_t egress = NEXTHOPS_EMPTY;
+      nexthops_add(&egress, nexthop);
+      if (now_ - send_ts >= SIM_LIFETIME) {
+        strategy_on_timeout(&entry_, &nexthops_, &egress);
+        continue;
+      }
+      off_t i = nexthops_find_any(&nexthops_, nexthop);
+      rtt_stats_update(&nexthops_state(&nexthops_, i).rtt, now_ - send_ts);
+      msgbuf_t msgbuf = {};
+      msgbuf_set_connection_id(&msgbuf, nexthop);
+      strategy_on_data(&entry_, &nexthops_, &egress, &msgbuf, 1, 1);
+    }
+  }
+
+  nexthop_t send() {
+    nexthops_reset(&nexthops_);
+    nexthops_t *nexthops =
+        strategy_lookup_nexthops(&entry_, &nexthops_, nullptr);
+    EXPECT_EQ(nexthops_get_curlen(nexthops), 1u);
+    nexthop_t nexthop = nexthops_get_one(nexthops);
+    sent_[nexthop]++;
+
+    const link_t &link = links_[nexthop];
+    bool lost = std::bernoulli_distribution(link.loss)(rng_);
+    Usecs ts = now_ + (lost ? SIM_LIFETIME : link.rtt);
+    events_.insert({ts, {now_, nexthop}});
+    return nexthop;
+  }
+
+  /* Run the simulation, and return the interests sent per link after warmup */
+  std::vector<unsigned> run(unsigned n_interests) {
+    for (unsigned n = 0; n < n_interests; n++) {
+      if (n == SIM_WARMUP) std::fill(sent_.begin(), sent_.end(), 0);
+      deliver();
+      send();
+      now_ += SIM_INTERVAL;
+    }
+    return sent_;
+  }
+
+  strategy_entry_t entry_;
+  nexthops_t nexthops_;
+  std::vector<link_t> links_;
+  std::vector<unsigned> sent_;
+  /* Events by time: send timestamp and next hop */
+  std::multimap<Usecs, std::pair<Usecs, nexthop_t>> events_;
+  std::mt19937 rng_;
+  Usecs now_;
+};
+
+TEST_F(StrategyLowLatency, SingleNexthop) {
+  add_link({.rtt = 1000, .loss = 0});
+  std::vector<unsigned> sent = run(SIM_WARMUP + 100);
+  EXPECT_EQ(sent[0], 100u);
+}
+
+TEST_F(StrategyLowLatency, LowestLatency) {
+  add_link({.rtt = 20000, .loss = 0});
+  add_link({.rtt = 5000, .loss = 0});
+  add_link({.rtt = 8000, .loss = 0});
+
+  std::vector<unsigned> sent = run(SIM_N_INTERESTS);
+  unsigned total = SIM_N_INTERESTS - SIM_WARMUP;
+  EXPECT_GT(sent[1], total * 9 / 10);
+  // Other links are still explored
+  EXPECT_GT(sent[0], 0u);
+  EXPECT_GT(sent[2], 0u);
+}
+
+TEST_F(StrategyLowLatency, LossyLinkIsAvoided) {
+  // The lossy link has the lowest RTT, but the highest expected latency
+  add_link({.rtt = 1000, .loss = 0.9});
+  add_link({.rtt = 5000, .loss = 0});
+
+  std::vector<unsigned> sent = run(SIM_N_INTERESTS);
+  unsigned total = SIM_N_INTERESTS - SIM_WARMUP;
+  EXPECT_GT(sent[1], total * 9 / 10);
+}
+
+TEST_F(StrategyLowLatency, SimilarLinksInParallel) {
+  add_link({.rtt = 5000, .loss = 0});
+  add_link({.rtt = 5200, .loss = 0});
+  add_link({.rtt = 30000, .loss = 0});
+
+  std::vector<unsigned> sent = run(SIM_N_INTERESTS);
+  unsigned total = SIM_N_INTERESTS - SIM_WARMUP;
+  EXPECT_GT(sent[0], total / 3);
+  EXPECT_GT(sent[1], total / 3);
+  EXPECT_LT(sent[2], total / 10);
+}
+
+TEST_F(StrategyLowLatency, AdaptsToLatencyChange) {
+  add_link({.rtt = 5000, .loss = 0});
+  add_link({.rtt = 10000, .loss = 0});
+  std::vector<unsigned> sent = run(SIM_N_INTERESTS);
+  EXPECT_GT(sent[0], sent[1]);
+
+  // The best link gets congested
+  links_[0].rtt = 40000;
+  std::fill(sent_.begin(), sent_.end(), 0);
+  for (unsigned n = 0; n < SIM_N_INTERESTS; n++) {
+    deliver();
+    send();
+    now_ += SIM_INTERVAL;
+  }
+  EXPECT_GT(sent_[1], sent_[0]);
+}
+
+TEST_F(StrategyLowLatency, PendingCap) {
+  add_link({.rtt = 1000, .loss = 0});
+  add_link({.rtt = 50000, .loss = 0});
+  run(100);
+
+  // Interests are not answered anymore: the fast link gets saturated
+  std::fill(sent_.begin(), sent_.end(), 0);
+  for (unsigned n = 0; n < 3 * LOW_LATENCY_MAX_PENDING / 2; n++) {
+    send();
+    now_ += SIM_INTERVAL;
+  }
+  EXPECT_LE(sent_[0], (unsigned)LOW_LATENCY_MAX_PENDING);
+  EXPECT_GE(sent_[1], (unsigned)LOW_LATENCY_MAX_PENDING / 2);
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <event2/event.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/base/loop.h>
+#include <hicn/config/configuration.h>
+#include <hicn/core/address.h>
+#include <hicn/core/forwarder.h>
+#include <hicn/core/listener.h>
+#include <hicn/core/listener_table.h>
+#include <hicn/io/uring.h>
+}
+
+#define URING_TEST_PORT 19795
+
+class UringTest : public ::testing::Test {
+ protected:
+  UringTest() {
+    conf_ = configuration_create();
+    configuration_set_port(conf_, URING_TEST_PORT);
+    MAIN_LOOP = loop_create();
+    fwd_ = forwarder_create(conf_);
+    forwarder_setup_local_listeners(fwd_, URING_TEST_PORT);
+    uring_ = uring_create(fwd_, false);
+
+    // Connected socket pair on the loopback interface
+    rx_ = socket(AF_INET, SOCK_DGRAM, 0);
+    tx_ = socket(AF_INET, SOCK_DGRAM, 0);
+    struct sockaddr_in addr = {};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addrlen = sizeof(addr);
+    bind(rx_, (struct sockaddr *)&addr, addrlen);
+    getsockname(rx_, (struct sockaddr *)&addr, &addrlen);
+    connect(tx_, (struct sockaddr *)&addr, addrlen);
+
+    struct timeval timeout = {1, 0};
+    setsockopt(rx_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  }
+
+  virtual ~UringTest() {
+    if (uring_) uring_free(uring_);
+    close(rx_);
+    close(tx_);
+    forwarder_free(fwd_);
+    loop_free(MAIN_LOOP);
+    MAIN_LOOP = NULL;
+  }
+
+  /* Process completions until the condition holds (or a timeout) */
+  template <typename F>
+  bool wait_for(F condition) {
+    for (int i = 0; i < 1000; i++) {
+      _loop_dispatch(MAIN_LOOP, EVLOOP_NONBLOCK);
+      if (condition()) return true;
+      usleep(1000);
+    }
+    return false;
+  }
+
+  configuration_t *conf_;
+  forwarder_t *fwd_;
+  uring_t *uring_;
+  int rx_;
+  int tx_;
+};
+
+TEST_F(UringTest, SendRoundTrip) {
+  if (!uring_) GTEST_SKIP() << "io_uring not available";
+
+  for (uint32_t seq = 0; seq < 3; seq++)
+    ASSERT_EQ(uring_send(uring_, tx_, NULL, (uint8_t *)&seq, sizeof(seq)), 0);
+  uring_submit(uring_);
+
+  for (uint32_t seq = 0; seq < 3; seq++) {
+    uint32_t received;
+    ASSERT_EQ(recv(rx_, &received, sizeof(received), 0),
+              (ssize_t)sizeof(received));
+    EXPECT_EQ(received, seq);
+  }
+
+  EXPECT_TRUE(wait_for([&] { return uring_get_stats(uring_).n_tx == 3; }));
+  EXPECT_EQ(uring_get_stats(uring_).n_tx_fallbacks, 0u);
+}
+
+TEST_F(UringTest, ReceiveRoundTrip) {
+  if (!uring_) GTEST_SKIP() << "io_uring not available";
+
+  address_t local = ADDRESS4_LOCALHOST(URING_TEST_PORT);
+  listener_key_t key = listener_key_factory(local, FACE_TYPE_UDP_LISTENER);
+  listener_t *listener =
+      listener_table_get_by_key(forwarder_get_listener_table(fwd_), &key);
+  ASSERT_NE(listener, nullptr);
+  ASSERT_EQ(uring_listen(uring_, rx_, listener, CONNECTION_ID_UNDEFINED), 0);
+
+  // The content is not a valid packet and will be dropped by the forwarder
+  uint8_t packet[64] = {0};
+  for (int i = 0; i < 3; i++)
+    ASSERT_EQ(send(tx_, packet, sizeof(packet), 0), (ssize_t)sizeof(packet));
+
+  EXPECT_TRUE(wait_for([&] { return uring_get_stats(uring_).n_rx == 3; }));
+  EXPECT_EQ(uring_get_stats(uring_).n_errors, 0u);
+
+  uring_unlisten(uring_, rx_);
+}
+
+TEST_F(UringTest, FallbackKeepsOrder) {
+  if (!uring_) GTEST_SKIP() << "io_uring not available";
+
+  // Drain the receive socket concurrently, as a burst might not fit in it
+  struct timeval timeout = {0, 100000};
+  setsockopt(rx_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+  std::vector<uint32_t> received;
+  std::atomic<bool> done(false);
+  std::thread reader([&] {
+    uint32_t seq;
+    for (;;) {
+      ssize_t n = recv(rx_, &seq, sizeof(seq), done ? MSG_DONTWAIT : 0);
+      if (n == sizeof(seq))
+        received.push_back(seq);
+      else if (done)
+        break;
+    }
+  });
+
+  // Queue packets until the ring runs out of transmission slots
+  uint32_t seq = 0;
+  for (; seq < 100000; seq++)
+    if (uring_send(uring_, tx_, NULL, (uint8_t *)&seq, sizeof(seq)) < 0) break;
+  ASSERT_LT(seq, 100000u);
+  EXPECT_EQ(uring_get_stats(uring_).n_tx_fallbacks, 1u);
+
+  // The packet sent directly should not overtake queued ones
+  uring_flush(uring_);
+  ASSERT_EQ(send(tx_, &seq, sizeof(seq), 0), (ssize_t)sizeof(seq));
+
+  EXPECT_TRUE(wait_for([&] { return uring_get_stats(uring_).n_tx == seq; }));
+  usleep(10000);
+  done = true;
+  reader.join();
+
+  // Some packets might have been dropped, but not reordered
+  ASSERT_FALSE(received.empty());
+  for (size_t i = 1; i < received.size(); i++)
+    EXPECT_LT(received[i - 1], received[i]);
+}
+
+TEST_F(UringTest, ReceiveSlotsGrowWithSockets) {
+  if (!uring_) GTEST_SKIP() << "io_uring not available";
+
+  address_t local = ADDRESS4_LOCALHOST(URING_TEST_PORT);
+  listener_key_t key = listener_key_factory(local, FACE_TYPE_UDP_LISTENER);
+  listener_t *listener =
+      listener_table_get_by_key(forwarder_get_listener_table(fwd_), &key);
+  ASSERT_NE(listener, nullptr);
+
+  // Register sockets until the ring runs out of receive slots
+  std::vector<int> fds;
+  for (int i = 0; i < 1000; i++) {
+    int fd = socket(AF_INET, SOCK_DGRAM, 0);
+    ASSERT_GE(fd, 0);
+    fds.push_back(fd);
+    if (uring_listen(uring_, fd, listener, CONNECTION_ID_UNDEFINED) < 0) break;
+  }
+
+  // Well beyond the first block of slots, but not unbounded
+  EXPECT_GT(fds.size(), 128u);
+  EXPECT_LT(fds.size(), 1000u);
+  EXPECT_EQ(uring_get_stats(uring_).n_errors, 0u);
+
+  for (int fd : fds) uring_unlisten(uring_, fd);
+  for (int fd : fds) close(fd);
+}
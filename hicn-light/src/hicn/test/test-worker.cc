@@ -0,0 +1,191 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <unistd.h>
+
+extern "C" {
+#define WITH_TESTS
+#include <hicn/base/loop.h>
+#include <hicn/config/configuration.h>
+#include <hicn/core/address.h>
+#include <hicn/core/address_pair.h>
+#include <hicn/core/connection_table.h>
+#include <hicn/core/forwarder.h>
+#include <hicn/core/listener.h>
+#include <hicn/core/listener_table.h>
+#include <hicn/core/worker.h>
+}
+
+#define N_WORKERS 3
+#define WORKER_TEST_PORT 19695
+
+class WorkerTest : public ::testing::Test {
+ protected:
+  WorkerTest() {
+    conf_ = configuration_create();
+    configuration_set_port(conf_, WORKER_TEST_PORT);
+    MAIN_LOOP = loop_create();
+    fwd_ = forwarder_create(conf_);
+    forwarder_setup_local_listeners(fwd_, WORKER_TEST_PORT);
+  }
+
+  virtual ~WorkerTest() {
+    forwarder_free(fwd_);
+    loop_free(MAIN_LOOP);
+    MAIN_LOOP = NULL;
+  }
+
+  configuration_t *conf_;
+  forwarder_t *fwd_;
+};
+
+TEST_F(WorkerTest, CreateAndFree) {
+  workers_t *workers = workers_create(fwd_, N_WORKERS);
+  ASSERT_NE(workers, nullptr);
+  EXPECT_EQ(workers_get_num(workers), (unsigned)N_WORKERS);
+
+  // Worker 0 reuses the forwarder of the calling thread
+  worker_t *worker0 = workers_get(workers, 0);
+  EXPECT_EQ(worker_get_forwarder(worker0), fwd_);
+  EXPECT_EQ(forwarder_get_worker(fwd_), worker0);
+
+  // Other workers have their own forwarder (and thus packet cache)
+  for (unsigned i = 1; i < N_WORKERS; i++) {
+    worker_t *worker = workers_get(workers, i);
+    EXPECT_EQ(worker_get_id(worker), i);
+    EXPECT_NE(worker_get_forwarder(worker), nullptr);
+    EXPECT_NE(worker_get_forwarder(worker), fwd_);
+  }
+
+  workers_free(workers);
+  EXPECT_EQ(forwarder_get_worker(fwd_), nullptr);
+}
+
+TEST_F(WorkerTest, OwnerIsConsistentAcrossWorkers) {
+  workers_t *workers = workers_create(fwd_, N_WORKERS);
+  ASSERT_NE(workers, nullptr);
+
+  for (uint32_t hash = 0; hash < 1000; hash++) {
+    unsigned owner = worker_get_owner(workers_get(workers, 0), hash);
+    EXPECT_LT(owner, (unsigned)N_WORKERS);
+    for (unsigned i = 1; i < N_WORKERS; i++)
+      EXPECT_EQ(worker_get_owner(workers_get(workers, i), hash), owner);
+  }
+
+  workers_free(workers);
+}
+
+TEST_F(WorkerTest, RedirectReachesOwner) {
+  workers_t *workers = workers_create(fwd_, N_WORKERS);
+  ASSERT_NE(workers, nullptr);
+
+  worker_t *worker0 = workers_get(workers, 0);
+  worker_t *worker1 = workers_get(workers, 1);
+
+  address_t local = ADDRESS4_LOCALHOST(WORKER_TEST_PORT);
+  address_t remote = ADDRESS4_LOCALHOST(WORKER_TEST_PORT + 1);
+  address_pair_t pair = address_pair_factory(local, remote);
+  listener_key_t key = listener_key_factory(local, FACE_TYPE_UDP_LISTENER);
+
+  // The content is not a valid packet and will be dropped by the owner
+  uint8_t packet[64] = {0};
+  EXPECT_EQ(worker_redirect(worker0, 1, packet, sizeof(packet), &pair, &key),
+            0);
+  EXPECT_EQ(worker_get_stats(worker0).n_redirected_out, 1u);
+
+  // Wait for worker 1 to process its inbox
+  for (int i = 0; i < 1000; i++) {
+    if (worker_get_stats(worker1).n_redirected_in > 0) break;
+    usleep(1000);
+  }
+  EXPECT_EQ(worker_get_stats(worker1).n_redirected_in, 1u);
+
+  workers_free(workers);
+}
+
+TEST_F(WorkerTest, ConnectionIdIsSharedAcrossWorkers) {
+  workers_t *workers = workers_create(fwd_, N_WORKERS);
+  ASSERT_NE(workers, nullptr);
+  worker_t *worker0 = workers_get(workers, 0);
+
+  address_t local = ADDRESS4_LOCALHOST(WORKER_TEST_PORT);
+  address_t remote = ADDRESS4_LOCALHOST(WORKER_TEST_PORT + 1);
+  address_pair_t pair = address_pair_factory(local, remote);
+  listener_key_t key = listener_key_factory(local, FACE_TYPE_UDP_LISTENER);
+
+  // Connection created on the fly by worker 0, and published to other workers
+  listener_t *listener =
+      listener_table_get_by_key(forwarder_get_listener_table(fwd_), &key);
+  ASSERT_NE(listener, nullptr);
+  unsigned connection_id = listener_create_connection(listener, "conn0", &pair);
+  ASSERT_NE(connection_id, CONNECTION_ID_UNDEFINED);
+  worker_publish_connection(worker0, "conn0", &pair, &key);
+
+  // Workers do not touch their connection table once the connection has been
+  // created and accounted for in their statistics
+  for (unsigned i = 1; i < N_WORKERS; i++) {
+    worker_t *worker = workers_get(workers, i);
+    for (int j = 0; j < 1000; j++) {
+      if (worker_get_stats(worker).n_connections_replayed > 0) break;
+      usleep(1000);
+    }
+    ASSERT_EQ(worker_get_stats(worker).n_connections_replayed, 1u);
+
+    connection_table_t *table =
+        forwarder_get_connection_table(worker_get_forwarder(worker));
+    connection_t *connection = connection_table_get_by_pair(table, &pair);
+    ASSERT_NE(connection, nullptr);
+    EXPECT_EQ(connection_table_get_connection_id(table, connection),
+              connection_id);
+    EXPECT_STREQ(connection_get_name(connection), "conn0");
+  }
+
+  workers_free(workers);
+}
+
+TEST_F(WorkerTest, ConnectionIsPublishedWhenInboxIsFull) {
+  workers_t *workers = workers_create(fwd_, N_WORKERS);
+  ASSERT_NE(workers, nullptr);
+  worker_t *worker0 = workers_get(workers, 0);
+  worker_t *worker1 = workers_get(workers, 1);
+
+  address_t local = ADDRESS4_LOCALHOST(WORKER_TEST_PORT);
+  address_t remote = ADDRESS4_LOCALHOST(WORKER_TEST_PORT + 1);
+  address_pair_t pair = address_pair_factory(local, remote);
+  listener_key_t key = listener_key_factory(local, FACE_TYPE_UDP_LISTENER);
+
+  // Flood worker 1 with more packets than its inbox can hold
+  uint8_t packet[64] = {0};
+  for (int i = 0; i < 2 * 4096; i++)
+    worker_redirect(worker0, 1, packet, sizeof(packet), &pair, &key);
+
+  listener_t *listener =
+      listener_table_get_by_key(forwarder_get_listener_table(fwd_), &key);
+  ASSERT_NE(listener, nullptr);
+  unsigned connection_id = listener_create_connection(listener, "conn0", &pair);
+  ASSERT_NE(connection_id, CONNECTION_ID_UNDEFINED);
+  worker_publish_connection(worker0, "conn0", &pair, &key);
+
+  // Packets might have been dropped, but not the connection
+  for (int i = 0; i < 1000; i++) {
+    if (worker_get_stats(worker1).n_connections_replayed > 0) break;
+    usleep(1000);
+  }
+  EXPECT_EQ(worker_get_stats(worker1).n_connections_replayed, 1u);
+
+  workers_free(workers);
+}
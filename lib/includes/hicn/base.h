@@ -315,6 +315,21 @@ typedef struct
   uint32_t countDroppedNoReversePath;
   uint32_t countDataExpired;
 
+  // Batch processing, with the CPU cycles spent in each stage
+  uint32_t countBatches;
+  uint32_t countBatchPackets;
+  uint64_t cyclesAnalyze;
+  uint64_t cyclesPrefetch;
+  uint64_t cyclesProcess;
+  uint64_t cyclesFlush;
+
+  // Interest manifests: suffixes processed, sub-manifests sent after the
+  // split, and time spent processing them (suffixes per second)
+  uint32_t countManifests;
+  uint32_t countManifestSuffixes;
+  uint32_t countManifestSplits;
+  uint64_t usecsManifest;
+
   // TODO(eloparco): Currently not used
   // uint32_t countDroppedNoHopLimit;
   // uint32_t countDroppedZeroHopLimitFromRemote;
@@ -326,6 +341,17 @@ typedef struct
   uint32_t n_pit_entries;
   uint32_t n_cs_entries;
   uint32_t n_lru_evictions;
+  /* Expired entries, not reclaimed yet and reclaimed by the expiry sweep */
+  uint32_t n_pit_stale_entries;
+  uint32_t n_cs_stale_entries;
+  uint32_t n_pit_expired;
+  uint32_t n_cs_expired;
+  /* Disk tier of the CS (zero if disabled) */
+  uint32_t n_cs_disk_entries;
+  uint32_t n_cs_disk_hits;
+  uint32_t n_cs_disk_misses;
+  uint32_t n_cs_disk_promotions;
+  uint32_t n_cs_disk_demotions;
 } pkt_cache_stats_t;
 
 typedef struct
@@ -334,6 +360,15 @@ typedef struct
   pkt_cache_stats_t pkt_cache;
 } hicn_light_stats_t;
 
+/* Round-trip time estimate (RFC 6298), in microseconds */
+typedef struct
+{
+  uint32_t srtt;
+  uint32_t rttvar;
+  uint32_t min;
+  uint32_t n_samples;
+} rtt_stats_t;
+
 typedef struct
 {
   uint32_t conn_id;
@@ -351,6 +386,16 @@ typedef struct
     uint32_t tx_pkts;
     uint32_t tx_bytes;
   } data;
+  /* System calls vs. packets, to assess batching and UDP GSO/GRO gains */
+  struct
+  {
+    uint32_t rx_calls;
+    uint32_t rx_segments;
+    uint32_t tx_calls;
+    uint32_t tx_segments;
+  } io;
+  /* Interest to data delay, for interests forwarded on the connection */
+  rtt_stats_t rtt;
 } connection_stats_t;
 
 #endif /* HICN_BASE_H */
@@ -141,9 +141,11 @@ extern const char *_face_state_str[];
   _ (TCP_LISTENER)                                                            \
   _ (UDP)                                                                     \
   _ (UDP_LISTENER)                                                            \
+  _ (MEMIF)                                                                   \
+  _ (MEMIF_LISTENER)                                                          \
   _ (N)
 
-#define MAXSZ_FACE_TYPE_ 13
+#define MAXSZ_FACE_TYPE_ 14
 #define MAXSZ_FACE_TYPE	 MAXSZ_FACE_TYPE_ + 1
 
 typedef enum
@@ -158,6 +160,7 @@ typedef enum
   FACE_PROTOCOL_HICN,
   FACE_PROTOCOL_UDP,
   FACE_PROTOCOL_TCP,
+  FACE_PROTOCOL_MEMIF,
   FACE_PROTOCOL_UNKNOWN,
 } face_protocol_t;
 
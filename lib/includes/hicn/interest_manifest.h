@@ -99,6 +99,44 @@ interest_manifest_serialize (interest_manifest_header_t *int_manifest_header)
   _interest_manifest_serialize (int_manifest_header, hicn_uword_bits);
 }
 
+/*
+ * Serialize the list of suffixes and the fixed-size header separately, when
+ * several manifests share the same list of suffixes (eg. split manifests).
+ * The list has to be serialized first, as its length is read from the header.
+ */
+static inline void
+interest_manifest_serialize_suffixes (
+  interest_manifest_header_t *int_manifest_header)
+{
+  hicn_name_suffix_t *suffix =
+    (hicn_name_suffix_t *) (int_manifest_header + 1);
+  for (unsigned i = 0; i < int_manifest_header->n_suffixes; i++)
+    {
+      *(suffix + i) = hicn_host_to_net_32 (*(suffix + i));
+    }
+}
+
+static inline void
+interest_manifest_serialize_header (
+  interest_manifest_header_t *int_manifest_header)
+{
+  int_manifest_header->n_suffixes =
+    hicn_host_to_net_32 (int_manifest_header->n_suffixes);
+  int_manifest_header->padding =
+    hicn_host_to_net_32 (int_manifest_header->padding);
+
+  for (unsigned i = 0; i < BITMAP_SIZE; i++)
+    {
+#if hicn_uword_bits == 64
+      int_manifest_header->request_bitmap[i] =
+	hicn_host_to_net_64 (int_manifest_header->request_bitmap[i]);
+#else
+      int_manifest_header->request_bitmap[i] =
+	hicn_host_to_net_32 (int_manifest_header->request_bitmap[i]);
+#endif
+    }
+}
+
 static inline void
 interest_manifest_deserialize (interest_manifest_header_t *int_manifest_header)
 {
@@ -208,7 +246,7 @@ interest_manifest_update_bitmap (const hicn_uword *initial_bitmap,
 #define interest_manifest_foreach_suffix(header, suffix, pos)                 \
   for (suffix = _FIRST (header) + bitmap_first_set_no_check (                 \
 				    header->request_bitmap, BITMAP_SIZE),     \
-      pos = 0;                                                                \
+      pos = suffix - _FIRST (header);                                         \
        suffix - _FIRST (header) < header->n_suffixes;                         \
        pos = suffix - _FIRST (header) + 1,                                    \
       suffix = _FIRST (header) +                                              \
@@ -113,6 +113,20 @@ void _pool_resize (void **pool_ptr, size_t elt_size);
  */
 off_t _pool_get (void **pool, void **elt, size_t elt_size);
 
+/**
+ * @brief Get the element at a given index from the pool data structure
+ * (helper).
+ *
+ * @param[in] pool Pointer to the pool data structure to use.
+ * @param[in] id The index of the element to allocate.
+ * @param[in,out] elt Pointer to an empty element that will be used to return
+ * the allocated one from the pool.
+ *
+ * @return off_t The index of the element, or -1 if it is already in use (or
+ * the pool cannot be resized to hold it).
+ */
+off_t _pool_get_at (void **pool, off_t id, void **elt, size_t elt_size);
+
 /**
  * @brief Put an element back into the pool data structure (helper).
  *
@@ -165,6 +179,20 @@ bool _pool_validate_id (void **pool_ptr, off_t id);
 #define pool_get(pool, elt)                                                   \
   _pool_get ((void **) &pool, (void **) &elt, sizeof (*elt))
 
+/**
+ * @brief Get the element at a given index from the pool data structure.
+ *
+ * @param[in] pool The pool data structure to use.
+ * @param[in] id The index of the element to allocate.
+ * @param[in,out] elt An empty element that will be used to return the
+ * allocated one from the pool.
+ *
+ * This is used when indices are attributed externally, eg. to keep several
+ * pools in sync.
+ */
+#define pool_get_at(pool, id, elt)                                            \
+  _pool_get_at ((void **) &pool, (id), (void **) &elt, sizeof (*elt))
+
 /**
  * @brief Put an element back into the pool data structure.
  *
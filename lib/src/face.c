@@ -355,6 +355,7 @@ face_cmp (const face_t *f1, const face_t *f2)
 
     case FACE_TYPE_TCP:
     case FACE_TYPE_UDP:
+    case FACE_TYPE_MEMIF:
       ret = hicn_ip_address_cmp (&f1->local_addr, &f2->local_addr);
       if (ret != 0)
 	return ret;
@@ -407,6 +408,7 @@ face_snprintf (char *s, size_t size, const face_t *face)
     case FACE_TYPE_UNDEFINED:
     case FACE_TYPE_TCP:
     case FACE_TYPE_UDP:
+    case FACE_TYPE_MEMIF:
       {
 	return snprintf (s, size, "%s [%s:%d -> %s:%d] [%s]",
 			 face_type_str (face->type), local, face->local_port,
@@ -447,6 +449,10 @@ get_protocol (face_type_t face_type)
     case FACE_TYPE_UDP_LISTENER:
       return FACE_PROTOCOL_UDP;
 
+    case FACE_TYPE_MEMIF:
+    case FACE_TYPE_MEMIF_LISTENER:
+      return FACE_PROTOCOL_MEMIF;
+
     case FACE_TYPE_UNDEFINED:
     case FACE_TYPE_N:
       break;
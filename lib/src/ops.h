@@ -608,6 +608,7 @@ typedef struct hicn_ops_s
     ATTR_INIT (set_signature_size, protocol##_set_signature_size),            \
     ATTR_INIT (get_signature_padding, protocol##_get_signature_padding),      \
     ATTR_INIT (is_last_data, protocol##_is_last_data),                        \
+    ATTR_INIT (set_last_data, protocol##_set_last_data),                      \
   }
 
 /**
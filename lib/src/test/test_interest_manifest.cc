@@ -167,6 +167,29 @@ TEST_F (InterestManifestTest, SerializeDeserialize)
     }
 }
 
+TEST_F (InterestManifestTest, SerializeHeaderAndSuffixes)
+{
+  auto header = reinterpret_cast<interest_manifest_header_t *> (buffer);
+  interest_manifest_init (header, 0);
+  for (const auto &v : values)
+    {
+      interest_manifest_add_suffix (header, v);
+    }
+  interest_manifest_del_suffix (header, 3);
+
+  size_t size = sizeof (interest_manifest_header_t) +
+		header->n_suffixes * sizeof (hicn_name_suffix_t);
+  uint8_t expected[sizeof (buffer)];
+  memcpy (expected, buffer, size);
+  interest_manifest_serialize (
+    reinterpret_cast<interest_manifest_header_t *> (expected));
+
+  // Suffixes first, as their number is read from the header
+  interest_manifest_serialize_suffixes (header);
+  interest_manifest_serialize_header (header);
+  EXPECT_EQ (memcmp (buffer, expected, size), 0);
+}
+
 TEST_F (InterestManifestTest, ForEach)
 {
   unsigned long pos;
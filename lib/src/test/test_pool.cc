@@ -207,3 +207,35 @@ TEST_F (PoolTest, PoolGetMultipleElementsAfterReleasing)
 
   pool_free (pool);
 }
+
+TEST_F (PoolTest, PoolGetAt)
+{
+  int *elt = NULL, *tmp = NULL;
+  pool_init (pool, DEFAULT_SIZE, 0);
+  size_t pool_size = next_pow2 (DEFAULT_SIZE);
+
+  // Allocating a given free index succeeds...
+  EXPECT_EQ (pool_get_at (pool, 3, elt), 3);
+  EXPECT_EQ (elt, pool + 3);
+  EXPECT_TRUE (pool_validate_id (pool, 3));
+  // ...but not twice
+  EXPECT_EQ (pool_get_at (pool, 3, tmp), -1);
+
+  // Beyond the current size, the pool is resized
+  off_t id = (off_t) pool_size * 2 + 1;
+  EXPECT_EQ (pool_get_at (pool, id, elt), id);
+  EXPECT_GT (pool_get_alloc_size (pool), (size_t) id);
+  EXPECT_EQ (pool_len (pool), 2u);
+
+  // Regular allocations never return indices already in use
+  size_t n = pool_get_alloc_size (pool) - 2;
+  for (size_t i = 0; i < n; i++)
+    {
+      off_t other = pool_get (pool, tmp);
+      EXPECT_NE (other, 3);
+      EXPECT_NE (other, id);
+    }
+  EXPECT_EQ (pool_get_free_indices_size (pool), 0u);
+
+  pool_free (pool);
+}
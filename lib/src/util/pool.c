@@ -122,12 +122,14 @@ _pool_resize (void **pool_ptr, size_t elt_size)
 
   /*
    * After resize, the pool will have new free indices, ranging from
-   * old_size to (new_size - 1)
+   * old_size to (new_size - 1). They are appended to the indices that are
+   * still free (if any, when resizing from _pool_get_at).
    */
-  vector_ensure_pos (ph->free_indices, old_size);
+  size_t l = vector_len (ph->free_indices);
+  vector_ensure_pos (ph->free_indices, l + old_size);
   for (unsigned i = 0; i < old_size; i++)
-    ph->free_indices[i] = new_size - 1 - i;
-  vector_len (ph->free_indices) = old_size;
+    ph->free_indices[l + i] = new_size - 1 - i;
+  vector_len (ph->free_indices) = l + old_size;
 
   /* We also need to update the bitmap */
   bitmap_ensure_pos (&(ph->free_bitmap), new_size - 1);
@@ -162,6 +164,35 @@ _pool_get (void **pool_ptr, void **elt, size_t elt_size)
   return free_id;
 }
 
+off_t
+_pool_get_at (void **pool_ptr, off_t id, void **elt, size_t elt_size)
+{
+  pool_hdr_t *ph = pool_hdr (*pool_ptr);
+  while (id >= ph->alloc_size)
+    {
+      _pool_resize (pool_ptr, elt_size);
+      if (!*pool_ptr)
+	return -1;
+      ph = pool_hdr (*pool_ptr);
+    }
+  if (!bitmap_is_set (ph->free_bitmap, id))
+    return -1;
+
+  /* Remove id from the free indices (swap with the last one) */
+  uint64_t l = vector_len (ph->free_indices);
+  for (uint64_t i = 0; i < l; i++)
+    {
+      if (ph->free_indices[i] != id)
+	continue;
+      ph->free_indices[i] = ph->free_indices[l - 1];
+      vector_len (ph->free_indices)--;
+      break;
+    }
+  bitmap_unset (ph->free_bitmap, id);
+  *elt = *pool_ptr + id * elt_size;
+  return id;
+}
+
 void
 _pool_put (void **pool_ptr, void **elt, size_t elt_size)
 {
@@ -84,11 +84,26 @@ class CryptoHash {
   // Return hash size
   static std::size_t getSize(CryptoHashType hash_type);
 
+  // Compute the hash of a buffer into digest, which must hold at least
+  // getSize(hash_type) bytes. Return the hash size. The hashing context is
+  // reused across calls made by the same thread, so that batches of buffers
+  // are hashed without allocations.
+  static std::size_t computeDigest(CryptoHashType hash_type,
+                                   const uint8_t *buffer, std::size_t len,
+                                   uint8_t *digest);
+  // Same as above, hashing all the buffers of a chain.
+  static std::size_t computeDigest(CryptoHashType hash_type,
+                                   const utils::MemBuf *buffer,
+                                   uint8_t *digest);
+
   // Compare two raw buffers
   static bool compareDigest(const uint8_t *digest1, const uint8_t *digest2,
                             CryptoHashType hash_type);
 
  private:
+  static EVP_MD_CTX *initDigest(CryptoHashType hash_type);
+  static std::size_t finalizeDigest(EVP_MD_CTX *md_ctx, uint8_t *digest);
+
   CryptoHashType digest_type_;
   utils::MemBuf::Ptr digest_;
   std::size_t digest_size_;
@@ -40,7 +40,8 @@ class Signer {
 
   virtual ~Signer();
 
-  // Sign a packet.
+  // Sign a packet. Packets can be signed concurrently by several threads,
+  // as long as the key of the signer is not modified meanwhile.
   virtual void signPacket(PacketPtr packet);
   virtual void signBuffer(const uint8_t *buffer, std::size_t len);
   virtual void signBuffer(const std::vector<uint8_t> &buffer);
@@ -70,6 +71,12 @@ class Signer {
   void display();
 
  protected:
+  // Sign a buffer, writing at most *signature_len bytes of signature.
+  // *signature_len is updated with the size of the signature. This function
+  // does not modify the signer and is thread-safe.
+  void computeSignature(const uint8_t *buffer, std::size_t len,
+                        uint8_t *signature, std::size_t *signature_len) const;
+
   CryptoSuite suite_;
   utils::MemBuf::Ptr signature_;
   std::size_t signature_len_;
@@ -104,6 +104,9 @@ class Verifier {
                                       VerificationPolicy &policy);
 
  protected:
+  // Return a reset EVP context owned by the calling thread.
+  static EVP_MD_CTX *getThreadContext();
+
   VerificationFailedCallback verification_failed_cb_;
   std::vector<VerificationPolicy> failed_policies_;
 };
@@ -44,7 +44,7 @@ class PacketManager : public utils::ThreadLocalSingleton<
   utils::MemBuf::Ptr getMemBuf() {
     utils::MemBuf *memory = nullptr;
 
-    memory = reinterpret_cast<utils::MemBuf *>(memory_pool_.allocateBlock());
+    memory = reinterpret_cast<utils::MemBuf *>(allocateStorage());
 
     utils::STLAllocator<utils::MemBuf, MemoryPool> allocator(memory,
                                                              &memory_pool_);
@@ -57,11 +57,15 @@ class PacketManager : public utils::ThreadLocalSingleton<
     return ret;
   }
 
+  /**
+   * Wrap a buffer returned by getRawBuffer(), possibly on another thread.
+   * The buffer is released to the pool it was allocated from.
+   */
   utils::MemBuf::Ptr getMemBuf(uint8_t *buffer, std::size_t length) {
     auto offset = offsetof(PacketStorage, align);
     auto memory = buffer - offset;
     utils::STLAllocator<utils::MemBuf, MemoryPool> allocator(
-        (utils::MemBuf *)memory, &memory_pool_);
+        (utils::MemBuf *)memory, getPool(buffer));
     auto ret = std::allocate_shared<utils::MemBuf>(
         allocator, utils::MemBuf::WRAP_BUFFER, (uint8_t *)buffer, length,
         chunk_size - offset);
@@ -74,11 +78,11 @@ class PacketManager : public utils::ThreadLocalSingleton<
       typename = std::enable_if_t<std::is_base_of<Packet, PacketType>::value>>
   typename PacketType::Ptr getPacket(Args &&...args) {
     static_assert(sizeof(PacketType) + sizeof(std::shared_ptr<PacketType>) +
-                      sizeof(std::max_align_t) <=
+                      sizeof(std::max_align_t) + sizeof(MemoryPool *) <=
                   sizeof(PacketStorage::packet_and_shared_ptr));
     PacketType *memory = nullptr;
 
-    memory = reinterpret_cast<PacketType *>(memory_pool_.allocateBlock());
+    memory = reinterpret_cast<PacketType *>(allocateStorage());
     utils::STLAllocator<PacketType, MemoryPool> allocator(memory,
                                                           &memory_pool_);
     auto offset = offsetof(PacketStorage, align);
@@ -91,7 +95,7 @@ class PacketManager : public utils::ThreadLocalSingleton<
 
   std::pair<uint8_t *, std::size_t> getRawBuffer() {
     uint8_t *memory = nullptr;
-    memory = reinterpret_cast<uint8_t *>(memory_pool_.allocateBlock());
+    memory = reinterpret_cast<uint8_t *>(allocateStorage());
 
     auto offset = offsetof(PacketStorage, align);
     memory += offset;
@@ -99,14 +103,21 @@ class PacketManager : public utils::ThreadLocalSingleton<
     return std::make_pair(memory, chunk_size - offset);
   }
 
+  /**
+   * Wrap a buffer returned by getRawBuffer(), possibly on another thread.
+   * The buffer is released to the pool it was allocated from.
+   */
   template <typename PacketType, typename... Args>
   typename PacketType::Ptr getPacketFromExistingBuffer(uint8_t *buffer,
                                                        std::size_t length,
                                                        Args &&...args) {
+    static_assert(sizeof(PacketType) + sizeof(std::shared_ptr<PacketType>) +
+                      sizeof(std::max_align_t) + sizeof(MemoryPool *) <=
+                  sizeof(PacketStorage::packet_and_shared_ptr));
     auto offset = offsetof(PacketStorage, align);
     auto memory = reinterpret_cast<PacketType *>(buffer - offset);
-    utils::STLAllocator<PacketType, MemoryPool> allocator(memory,
-                                                          &memory_pool_);
+    utils::STLAllocator<PacketType, MemoryPool> allocator(
+        memory, getPool(buffer));
     auto ret = std::allocate_shared<PacketType>(
         allocator, PacketType::WRAP_BUFFER, (uint8_t *)buffer, length,
         chunk_size - offset, std::forward<Args>(args)...);
@@ -117,6 +128,25 @@ class PacketManager : public utils::ThreadLocalSingleton<
  private:
   PacketManager(std::size_t size = packet_pool_size)
       : memory_pool_(MemoryPool::getInstance()), size_(0) {}
+
+  /**
+   * The pool a block was allocated from is recorded in the last bytes of
+   * the packet area, after the packet and its shared pointer, so that
+   * buffers wrapped on another thread are released to the right pool.
+   */
+  static MemoryPool *&getPool(uint8_t *buffer) {
+    auto memory = buffer - offsetof(PacketStorage, align);
+    return *reinterpret_cast<MemoryPool **>(
+        memory + sizeof(PacketStorage::packet_and_shared_ptr) -
+        sizeof(MemoryPool *));
+  }
+
+  void *allocateStorage() {
+    auto memory = reinterpret_cast<uint8_t *>(memory_pool_.allocateBlock());
+    getPool(memory + offsetof(PacketStorage, align)) = &memory_pool_;
+    return memory;
+  }
+
   MemoryPool &memory_pool_;
   std::atomic<size_t> size_;
 };
@@ -134,6 +134,10 @@ class Packet : public utils::MemBuf,
 
   // Digest
   auth::CryptoHash computeDigest(auth::CryptoHashType algorithm) const;
+  // Compute the packet digest into a buffer of at least
+  // CryptoHash::getSize(algorithm) bytes, without allocating a CryptoHash.
+  std::size_t computeDigest(auth::CryptoHashType algorithm,
+                            uint8_t *digest) const;
 
   bool isInterest();
 
@@ -38,6 +38,8 @@ class HTTPClientConnection : private utils::NonCopyable {
   class ReadBytesCallback {
    public:
     virtual void onBytesReceived(std::unique_ptr<utils::MemBuf> &&buffer) = 0;
+    // Receive the bytes in the packet buffers, as a chain of MemBufs
+    virtual bool isBufferChainable() { return false; }
     virtual void onSuccess(std::size_t bytes) = 0;
     virtual void onError(const std::error_code &ec) = 0;
   };
@@ -77,6 +77,19 @@ class ConsumerSocket : private utils::NonCopyable {
      */
     virtual bool isBufferMovable() noexcept { return true; }
 
+    /**
+     * This API will specify to the transport whether the content can be
+     * delivered in the packet buffers it has been received in, instead of
+     * being copied in a contiguous read buffer. If isBufferChainable returns
+     * true (and isBufferMovable returns true as well), readBufferAvailable
+     * will receive a chain of MemBufs, each one pointing to the payload of a
+     * packet. The packets are released when the application frees the chain,
+     * so that it can write them e.g. with writev() without any copy.
+     *
+     * By default this method returns false.
+     */
+    virtual bool isBufferChainable() noexcept { return false; }
+
     /**
      * This method will be called by the transport when the content is
      * available. The application can then allocate its own buffer and provide
@@ -113,7 +126,8 @@ class ConsumerSocket : private utils::NonCopyable {
     /**
      * This method will be called by the transport iff (isBufferMovable ==
      * true). The unique_ptr underlines the fact that the ownership of the
-     * buffer is being transferred to the application.
+     * buffer is being transferred to the application. If isBufferChainable
+     * returns true the buffer is a chain of MemBufs.
      *
      * @param buffer - The buffer
      */
@@ -147,6 +161,8 @@ class ConsumerSocket : private utils::NonCopyable {
    * forwarding in information-centric networks: Protocol design and
    * experimentation. G Carofiglio, M Gallo, L Muscariello. Computer Networks
    * 110, 104-117
+   *  - BBR: Model-based congestion control, pacing interests at the estimated
+   * bottleneck bandwidth
    *  - RTC: Real time communication
    */
   explicit ConsumerSocket(int protocol);
@@ -166,6 +182,8 @@ class ConsumerSocket : private utils::NonCopyable {
    * forwarding in information-centric networks: Protocol design and
    * experimentation. G Carofiglio, M Gallo, L Muscariello. Computer Networks
    * 110, 104-117
+   *  - BBR: Model-based congestion control, pacing interests at the estimated
+   * bottleneck bandwidth
    *  - RTC: Real time communication
    */
   explicit ConsumerSocket(int protocol, ::utils::EventThread &worker);
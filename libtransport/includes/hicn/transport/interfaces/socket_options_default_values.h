@@ -54,6 +54,9 @@ static constexpr uint32_t max_out_of_order_segments = 3;  // content object
 static constexpr uint32_t manifest_max_capacity = 30;
 static constexpr uint32_t manifest_factor_relevant = 100;
 static constexpr uint32_t manifest_factor_alert = 20;
+static constexpr uint32_t signing_threads = 0;  // Sign inline
+static constexpr double pacing_rate = 0;        // Interests/s, 0: window/RTT
+static constexpr uint32_t pacing_burst = 32;    // Interests, 0: no pacing
 
 // RAAQM
 static const int sample_number = 30;
@@ -35,6 +35,7 @@ typedef enum {
   RAAQM = 10,
   CBR = 11,
   RTC = 12,
+  BBR = 13,
 } TransportProtocolAlgorithms;
 
 typedef enum {
@@ -78,6 +79,9 @@ typedef enum {
   SUFFIX_STRATEGY = 124,
   PACKET_FORMAT = 125,
   FEC_TYPE = 126,
+  SIGNING_THREADS = 127,
+  PACING_RATE = 128,
+  PACING_BURST = 129,
 } GeneralTransportOptions;
 
 typedef enum {
@@ -88,7 +92,8 @@ typedef enum {
   MINIMUM_DROP_PROBABILITY = 205,
   PATH_ID = 206,
   RTT_STATS = 207,
-  PER_SESSION_CWINDOW_RESET = 208
+  PER_SESSION_CWINDOW_RESET = 208,
+  MULTIPATH = 209,
 } RaaqmTransportOptions;
 
 typedef enum {
@@ -19,6 +19,7 @@
 #include <hicn/transport/utils/chrono_typedefs.h>
 
 #include <cstdint>
+#include <map>
 
 namespace transport {
 
@@ -40,6 +41,16 @@ class TransportStatistics {
  public:
   enum class statsAlerts : uint8_t { CONGESTION, LATENCY, LOSSES };
 
+  /**
+   * Congestion state of a path, identified by the path label of the data
+   * received through it (multipath RAAQM).
+   */
+  struct PathStatistics {
+    double window;       // Interests
+    double average_rtt;  // Milliseconds
+    uint64_t bytes_received;
+  };
+
   TransportStatistics(double alpha = default_alpha)
       : retx_count_(0),
         bytes_received_(0),
@@ -142,6 +153,11 @@ class TransportStatistics {
     in_congestion_ = state;
   }
 
+  TRANSPORT_ALWAYS_INLINE void updatePathStatistics(
+      uint32_t path_label, const PathStatistics &path_stats) {
+    path_stats_[path_label] = path_stats;
+  }
+
   TRANSPORT_ALWAYS_INLINE void setAlert(statsAlerts x) {
     alerts_ |= 1UL << (uint32_t)x;
   }
@@ -216,6 +232,11 @@ class TransportStatistics {
 
   TRANSPORT_ALWAYS_INLINE uint32_t getAlerts() const { return alerts_; }
 
+  TRANSPORT_ALWAYS_INLINE const std::map<uint32_t, PathStatistics>
+      &getPathStatistics() const {
+    return path_stats_;
+  }
+
   TRANSPORT_ALWAYS_INLINE void setAlpha(double val) { alpha_ = val; }
 
   TRANSPORT_ALWAYS_INLINE void reset() {
@@ -237,6 +258,7 @@ class TransportStatistics {
     received_fec_ = 0;
     in_congestion_ = false;
     quality_score_ = 5;
+    path_stats_.clear();
   }
 
  private:
@@ -265,6 +287,9 @@ class TransportStatistics {
   // something bad is appening in the network, the encode is done accoding to
   // the enum alerts;
   uint32_t alerts_;
+
+  // Per-path congestion state, by path label
+  std::map<uint32_t, PathStatistics> path_stats_;
 };
 
 }  // namespace interface
@@ -10,12 +10,24 @@
 #include <hicn/transport/utils/spinlock.h>
 #include <stdint.h>
 
+#include <atomic>
 #include <cassert>
 #include <cstdlib>
 #include <list>
 #include <memory>
+#include <thread>
 
 namespace utils {
+
+/**
+ * Pool of fixed size memory blocks, one per thread.
+ *
+ * Blocks are allocated and released without locks by the thread owning the
+ * pool. Blocks released by other threads are pushed to a lock-free return
+ * list (multiple producers, single consumer), which the owner reclaims in a
+ * single batch once its free list is empty. This way blocks always go back
+ * to the pool they come from, whatever the thread releasing them.
+ */
 template <std::size_t SIZE = 512, std::size_t OBJECTS = 4096>
 class FixedBlockAllocator
     : public utils::ThreadLocalSingleton<FixedBlockAllocator<SIZE, OBJECTS>> {
@@ -33,8 +45,12 @@ class FixedBlockAllocator
 
   void* allocateBlock() {
     uint32_t index;
-    SpinLock::Acquire locked(lock_);
     void* p_block = pop();
+    if (TRANSPORT_EXPECT_FALSE(!p_block)) {
+      reclaimRemoteBlocks();
+      p_block = pop();
+    }
+
     if (!p_block) {
       if (TRANSPORT_EXPECT_FALSE(current_pool_index_ >= BLOCKS_PER_POOL)) {
         // Allocate new memory block
@@ -48,16 +64,24 @@ class FixedBlockAllocator
 
       auto& latest = p_pools_.front();
       index = current_pool_index_++;
-      blocks_in_use_++;
-      allocations_++;
       p_block = (void*)&latest[index];
     }
 
+    blocks_in_use_++;
+    allocations_++;
+    if (blocks_in_use_ > high_water_mark_) {
+      high_water_mark_ = blocks_in_use_;
+    }
+
     return p_block;
   }
 
   void deallocateBlock(void* pBlock) {
-    SpinLock::Acquire locked(lock_);
+    if (TRANSPORT_EXPECT_FALSE(std::this_thread::get_id() != owner_)) {
+      pushRemote(pBlock);
+      return;
+    }
+
     push(pBlock);
     blocks_in_use_--;
     deallocations_++;
@@ -68,17 +92,37 @@ class FixedBlockAllocator
 
   uint32_t blockCount() { return block_count_; }
 
-  uint32_t blocksInUse() { return blocks_in_use_; }
+  /**
+   * Blocks released by other threads are not in use anymore, even if the
+   * owner did not reclaim them yet.
+   */
+  uint32_t blocksInUse() { return blocks_in_use_ - remoteBlocksPending(); }
 
   uint32_t allocations() { return allocations_; }
 
-  uint32_t deallocations() { return deallocations_; }
+  uint32_t deallocations() { return deallocations_ + remoteBlocksPending(); }
+
+  /**
+   * Number of blocks released by a thread other than the owner of the pool.
+   */
+  uint32_t remoteDeallocations() {
+    return remote_deallocations_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Maximum number of blocks simultaneously in use since the last reset.
+   */
+  uint32_t highWaterMark() { return high_water_mark_; }
 
   void reset() {
     p_head_ = nullptr;
+    remote_head_.store(nullptr, std::memory_order_relaxed);
     blocks_in_use_ = 0;
+    high_water_mark_ = 0;
     allocations_ = 0;
     deallocations_ = 0;
+    remote_deallocations_.store(0, std::memory_order_relaxed);
+    remote_reclaimed_ = 0;
     current_pool_index_ = 0;
     block_count_ = BLOCKS_PER_POOL;
 
@@ -92,11 +136,16 @@ class FixedBlockAllocator
  private:
   FixedBlockAllocator()
       : p_head_(NULL),
+        remote_head_(nullptr),
         current_pool_index_(0),
         block_count_(BLOCKS_PER_POOL),
         blocks_in_use_(0),
+        high_water_mark_(0),
         allocations_(0),
-        deallocations_(0) {
+        deallocations_(0),
+        remote_deallocations_(0),
+        remote_reclaimed_(0),
+        owner_(std::this_thread::get_id()) {
     static_assert(SIZE >= sizeof(long*), "SIZE must be at least 8 bytes");
     p_pools_.emplace_front(
         new typename std::aligned_storage<SIZE>::type[BLOCKS_PER_POOL]);
@@ -119,19 +168,60 @@ class FixedBlockAllocator
     return (void*)p_block;
   }
 
+  void pushRemote(void* p_memory) {
+    Block* p_block = (Block*)p_memory;
+    p_block->p_next = remote_head_.load(std::memory_order_relaxed);
+    while (!remote_head_.compare_exchange_weak(p_block->p_next, p_block,
+                                               std::memory_order_release,
+                                               std::memory_order_relaxed))
+      ;
+    remote_deallocations_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * Move all the blocks released by other threads to the free list. As the
+   * whole return list is detached at once, there is no ABA problem.
+   */
+  void reclaimRemoteBlocks() {
+    Block* p_block = remote_head_.exchange(nullptr, std::memory_order_acquire);
+    uint32_t count = 0;
+
+    while (p_block) {
+      Block* p_next = p_block->p_next;
+      push(p_block);
+      p_block = p_next;
+      count++;
+    }
+
+    blocks_in_use_ -= count;
+    deallocations_ += count;
+    remote_reclaimed_ += count;
+  }
+
+  uint32_t remoteBlocksPending() {
+    return remote_deallocations_.load(std::memory_order_relaxed) -
+           remote_reclaimed_;
+  }
+
   struct Block {
     Block* p_next;
   };
 
+  // Owner thread only
   Block* p_head_;
+  // Blocks released by other threads
+  std::atomic<Block*> remote_head_;
   uint32_t current_pool_index_;
   std::list<typename std::aligned_storage<SIZE>::type*> p_pools_;
   uint32_t block_count_;
   uint32_t blocks_in_use_;
+  uint32_t high_water_mark_;
   uint32_t allocations_;
   uint32_t deallocations_;
+  std::atomic<uint32_t> remote_deallocations_;
+  uint32_t remote_reclaimed_;
 
-  SpinLock lock_;
+  std::thread::id owner_;
 };
 
 /**
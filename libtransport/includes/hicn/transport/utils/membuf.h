@@ -24,6 +24,9 @@
 #include <hicn/transport/portability/portability.h>
 #include <hicn/transport/utils/branch_prediction.h>
 #include <stdlib.h>
+#ifndef _WIN32
+#include <sys/uio.h>
+#endif
 
 #include <atomic>
 #include <cassert>
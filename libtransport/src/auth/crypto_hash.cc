@@ -63,16 +63,8 @@ bool CryptoHash::operator==(const CryptoHash &other) const {
 }
 
 void CryptoHash::computeDigest(const uint8_t *buffer, size_t len) {
-  const EVP_MD *hash_md = CryptoHash::getMD(digest_type_);
-  if (hash_md == nullptr) {
-    throw errors::RuntimeException("Unknown hash type");
-  }
-
-  if (EVP_Digest(buffer, len, digest_->writableData(),
-                 reinterpret_cast<unsigned int *>(&digest_size_), hash_md,
-                 nullptr) != 1) {
-    throw errors::RuntimeException("Digest computation failed.");
-  };
+  digest_size_ =
+      computeDigest(digest_type_, buffer, len, digest_->writableData());
 }
 
 void CryptoHash::computeDigest(const std::vector<uint8_t> &buffer) {
@@ -80,12 +72,7 @@ void CryptoHash::computeDigest(const std::vector<uint8_t> &buffer) {
 }
 
 void CryptoHash::computeDigest(const utils::MemBuf *buffer) {
-  if (buffer->isChained()) {
-    throw errors::RuntimeException(
-        "Digest of chained membuf is not supported.");
-  }
-
-  computeDigest(buffer->data(), buffer->length());
+  digest_size_ = computeDigest(digest_type_, buffer, digest_->writableData());
 }
 
 const utils::MemBuf::Ptr &CryptoHash::getDigest() const { return digest_; }
@@ -160,6 +147,64 @@ size_t CryptoHash::getSize(CryptoHashType hash_type) {
   return hash_md == nullptr ? 0 : EVP_MD_size(hash_md);
 }
 
+size_t CryptoHash::computeDigest(CryptoHashType hash_type,
+                                 const uint8_t *buffer, size_t len,
+                                 uint8_t *digest) {
+  EVP_MD_CTX *md_ctx = initDigest(hash_type);
+
+  if (EVP_DigestUpdate(md_ctx, buffer, len) != 1) {
+    throw errors::RuntimeException("Digest computation failed.");
+  }
+
+  return finalizeDigest(md_ctx, digest);
+}
+
+size_t CryptoHash::computeDigest(CryptoHashType hash_type,
+                                 const utils::MemBuf *buffer, uint8_t *digest) {
+  EVP_MD_CTX *md_ctx = initDigest(hash_type);
+
+  const utils::MemBuf *current = buffer;
+  do {
+    if (EVP_DigestUpdate(md_ctx, current->data(), current->length()) != 1) {
+      throw errors::RuntimeException("Digest computation failed.");
+    }
+    current = current->next();
+  } while (current != buffer);
+
+  return finalizeDigest(md_ctx, digest);
+}
+
+EVP_MD_CTX *CryptoHash::initDigest(CryptoHashType hash_type) {
+  const EVP_MD *hash_md = CryptoHash::getMD(hash_type);
+  if (hash_md == nullptr) {
+    throw errors::RuntimeException("Unknown hash type");
+  }
+
+  // Unlike EVP_Digest, which allocates a context for each digest, reuse one
+  // context per thread.
+  static thread_local std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>
+      md_ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+
+  if (md_ctx == nullptr) {
+    throw errors::RuntimeException("Digest context allocation failed");
+  }
+
+  if (EVP_DigestInit_ex(md_ctx.get(), hash_md, nullptr) != 1) {
+    throw errors::RuntimeException("Digest initialization failed");
+  }
+
+  return md_ctx.get();
+}
+
+size_t CryptoHash::finalizeDigest(EVP_MD_CTX *md_ctx, uint8_t *digest) {
+  unsigned int digest_size = 0;
+  if (EVP_DigestFinal_ex(md_ctx, digest, &digest_size) != 1) {
+    throw errors::RuntimeException("Digest computation failed.");
+  }
+
+  return digest_size;
+}
+
 bool CryptoHash::compareDigest(const uint8_t *digest1, const uint8_t *digest2,
                                CryptoHashType hash_type) {
   const EVP_MD *hash_md = CryptoHash::getMD(hash_type);
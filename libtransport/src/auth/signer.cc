@@ -40,6 +40,11 @@ void Signer::signPacket(PacketPtr packet) {
     throw errors::MalformedAHPacketException();
   }
 
+  if (packet->isChained()) {
+    throw errors::RuntimeException(
+        "Signature of chained membuf is not supported.");
+  }
+
   // Set signature size
   size_t signature_field_len = getSignatureFieldSize();
   packet->setSignatureFieldSize(signature_field_len);
@@ -71,10 +76,23 @@ void Signer::signPacket(PacketPtr packet) {
   // Reset fields to compute the packet hash
   packet->resetForHash();
 
-  // Compute the signature and put it in the packet
-  signBuffer(packet);
-  packet->setSignature(signature_);
-  packet->setSignatureSize(signature_len_);
+  // Compute the signature and put it in the packet. The signature is
+  // computed in a per-thread buffer, so that several threads can sign
+  // packets with the same signer.
+  static thread_local utils::MemBuf::Ptr signature;
+  if (!signature || signature->capacity() < signature_->capacity()) {
+    signature = std::make_shared<utils::MemBuf>(utils::MemBuf::CREATE,
+                                                signature_->capacity());
+  }
+  signature->clear();
+
+  std::size_t signature_len = signature->tailroom();
+  computeSignature(packet->data(), packet->length(),
+                   signature->writableData(), &signature_len);
+  signature->setLength(signature_len);
+
+  packet->setSignature(signature);
+  packet->setSignatureSize(signature_len);
 
   // Restore header
   packet->loadHeader(header_copy, header_len);
@@ -87,32 +105,10 @@ void Signer::signPacket(PacketPtr packet) {
 }
 
 void Signer::signBuffer(const uint8_t *buffer, std::size_t len) {
-  const EVP_MD *hash_md = getMD(suite_);
-
-  std::shared_ptr<EVP_MD_CTX> md_ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
-  if (md_ctx == nullptr) {
-    throw errors::RuntimeException("Signature context allocation failed");
-  }
-
-  if (EVP_DigestSignInit(md_ctx.get(), nullptr, hash_md, nullptr, key_.get()) !=
-      1) {
-    throw errors::RuntimeException("Signature initialization failed");
-  }
-
-  if (EVP_DigestSign(md_ctx.get(), nullptr, &signature_len_, buffer, len) !=
-      1) {
-    throw errors::RuntimeException("Signature length computation failed");
-  };
-
-  DCHECK(signature_len_ <= signature_->tailroom());
-  signature_->setLength(signature_len_);
+  std::size_t signature_len = signature_->length() + signature_->tailroom();
+  computeSignature(buffer, len, signature_->writableData(), &signature_len);
 
-  if (EVP_DigestSign(md_ctx.get(), signature_->writableData(), &signature_len_,
-                     buffer, len) != 1) {
-    throw errors::RuntimeException("Signature computation failed");
-  };
-
-  DCHECK(signature_len_ <= signature_->tailroom());
+  signature_len_ = signature_len;
   signature_->setLength(signature_len_);
 }
 
@@ -163,6 +159,41 @@ void Signer::display() {
   LOG(INFO) << getStringSuite(suite_) << ": " << getStringSignature();
 }
 
+void Signer::computeSignature(const uint8_t *buffer, std::size_t len,
+                              uint8_t *signature,
+                              std::size_t *signature_len) const {
+  // Contexts are reused across signatures made by the same thread, which
+  // saves an allocation per packet.
+  static thread_local std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>
+      md_ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+
+  if (md_ctx == nullptr) {
+    throw errors::RuntimeException("Signature context allocation failed");
+  }
+
+  EVP_MD_CTX_reset(md_ctx.get());
+
+  if (EVP_DigestSignInit(md_ctx.get(), nullptr, getMD(suite_), nullptr,
+                         key_.get()) != 1) {
+    throw errors::RuntimeException("Signature initialization failed");
+  }
+
+  std::size_t capacity = *signature_len;
+  if (EVP_DigestSign(md_ctx.get(), nullptr, signature_len, buffer, len) != 1) {
+    throw errors::RuntimeException("Signature length computation failed");
+  };
+
+  DCHECK(*signature_len <= capacity);
+  *signature_len = capacity;
+
+  if (EVP_DigestSign(md_ctx.get(), signature, signature_len, buffer, len) !=
+      1) {
+    throw errors::RuntimeException("Signature computation failed");
+  };
+
+  DCHECK(*signature_len <= capacity);
+}
+
 // ---------------------------------------------------------
 // Void Signer
 // ---------------------------------------------------------
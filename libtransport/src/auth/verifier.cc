@@ -88,6 +88,7 @@ bool Verifier::verifyPacket(PacketPtr packet) {
 Verifier::PolicyMap Verifier::verifyPackets(
     const std::vector<PacketPtr> &packets) {
   PolicyMap policies;
+  policies.reserve(packets.size());
 
   for (const auto &packet : packets) {
     Suffix suffix = packet->getName().getSuffix();
@@ -107,6 +108,7 @@ Verifier::PolicyMap Verifier::verifyPackets(
 Verifier::PolicyMap Verifier::verifyHashes(const SuffixMap &packet_map,
                                            const SuffixMap &suffix_map) {
   PolicyMap policies;
+  policies.reserve(packet_map.size());
 
   for (const auto &packet_hash : packet_map) {
     VerificationPolicy policy = VerificationPolicy::UNKNOWN;
@@ -130,6 +132,11 @@ Verifier::PolicyMap Verifier::verifyHashes(const SuffixMap &packet_map,
 Verifier::PolicyMap Verifier::verifyPackets(
     const std::vector<PacketPtr> &packets, const SuffixMap &suffix_map) {
   PolicyMap policies;
+  policies.reserve(packets.size());
+
+  // Packet digests are computed in place and compared to the raw manifest
+  // hashes, so that no CryptoHash is allocated per packet.
+  uint8_t packet_digest[EVP_MAX_MD_SIZE];
 
   for (const auto &packet : packets) {
     Suffix suffix = packet->getName().getSuffix();
@@ -138,10 +145,13 @@ Verifier::PolicyMap Verifier::verifyPackets(
 
     if (manifest_hash != suffix_map.end()) {
       policy = VerificationPolicy::ABORT;
-      CryptoHashType hash_type = manifest_hash->second.getType();
-      CryptoHash packet_hash = packet->computeDigest(hash_type);
+      const CryptoHash &hash = manifest_hash->second;
+      std::size_t digest_size =
+          packet->computeDigest(hash.getType(), packet_digest);
 
-      if (packet_hash == manifest_hash->second) {
+      if (digest_size == hash.getSize() &&
+          CryptoHash::compareDigest(packet_digest, hash.getDigest()->data(),
+                                    hash.getType())) {
         policy = VerificationPolicy::ACCEPT;
       }
     }
@@ -165,6 +175,20 @@ void Verifier::getVerificationFailedCallback(
   *verfication_failed_cb = &verification_failed_cb_;
 }
 
+EVP_MD_CTX *Verifier::getThreadContext() {
+  // Contexts are reused across the verifications made by the same thread, so
+  // that verifying a batch of packets does not allocate one per packet.
+  static thread_local std::unique_ptr<EVP_MD_CTX, decltype(&EVP_MD_CTX_free)>
+      md_ctx(EVP_MD_CTX_new(), &EVP_MD_CTX_free);
+
+  if (md_ctx == nullptr) {
+    throw errors::RuntimeException("Signature context allocation failed");
+  }
+
+  EVP_MD_CTX_reset(md_ctx.get());
+  return md_ctx.get();
+}
+
 void Verifier::callVerificationFailedCallback(Suffix suffix,
                                               VerificationPolicy &policy) {
   if (verification_failed_cb_ == interface::VOID_HANDLER) {
@@ -259,18 +283,14 @@ bool AsymmetricVerifier::verifyBuffer(const uint8_t *buffer, std::size_t len,
                                       const utils::MemBuf::Ptr &signature,
                                       CryptoSuite suite) {
   const EVP_MD *hash_md = getMD(suite);
+  EVP_MD_CTX *md_ctx = getThreadContext();
 
-  std::shared_ptr<EVP_MD_CTX> md_ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
-  if (md_ctx == nullptr) {
-    throw errors::RuntimeException("Signature context allocation failed");
-  }
-
-  if (EVP_DigestVerifyInit(md_ctx.get(), nullptr, hash_md, nullptr,
-                           key_.get()) != 1) {
+  if (EVP_DigestVerifyInit(md_ctx, nullptr, hash_md, nullptr, key_.get()) !=
+      1) {
     throw errors::RuntimeException("Signature initialization failed");
   }
 
-  return EVP_DigestVerify(md_ctx.get(), signature->data(), signature->length(),
+  return EVP_DigestVerify(md_ctx, signature->data(), signature->length(),
                           buffer, len) == 1;
 };
 
@@ -315,38 +335,23 @@ bool SymmetricVerifier::verifyBuffer(const uint8_t *buffer, std::size_t len,
     throw errors::RuntimeException("Unknown hash type");
   }
 
-  const utils::MemBuf::Ptr &signature_bis =
-      core::PacketManager<>::getInstance().getMemBuf();
-  size_t signature_bis_len;
-
-  std::shared_ptr<EVP_MD_CTX> md_ctx(EVP_MD_CTX_new(), EVP_MD_CTX_free);
-  if (md_ctx == nullptr) {
-    throw errors::RuntimeException("Signature context allocation failed");
-  }
+  // HMACs are at most as long as the hash they are based on
+  uint8_t signature_bis[EVP_MAX_MD_SIZE];
+  size_t signature_bis_len = sizeof(signature_bis);
+  EVP_MD_CTX *md_ctx = getThreadContext();
 
-  if (EVP_DigestSignInit(md_ctx.get(), nullptr, hash_md, nullptr, key_.get()) !=
-      1) {
+  if (EVP_DigestSignInit(md_ctx, nullptr, hash_md, nullptr, key_.get()) != 1) {
     throw errors::RuntimeException("Signature initialization failed");
   }
 
-  if (EVP_DigestSign(md_ctx.get(), nullptr, &signature_bis_len, buffer, len) !=
+  if (EVP_DigestSign(md_ctx, signature_bis, &signature_bis_len, buffer, len) !=
       1) {
-    throw errors::RuntimeException("Signature length computation failed");
-  };
-
-  DCHECK(signature_bis_len <= signature_bis->tailroom());
-  signature_bis->append(signature_bis_len);
-
-  if (EVP_DigestSign(md_ctx.get(), signature_bis->writableData(),
-                     &signature_bis_len, buffer, len) != 1) {
     throw errors::RuntimeException("Signature computation failed");
   };
 
-  DCHECK(signature_bis_len <= signature_bis->tailroom());
-  signature_bis->setLength(signature_bis_len);
-
   return signature->length() == signature_bis_len &&
-         *signature == *signature_bis;
+         CRYPTO_memcmp(signature->data(), signature_bis, signature_bis_len) ==
+             0;
 }
 
 bool SymmetricVerifier::verifyBuffer(const std::vector<uint8_t> &buffer,
@@ -215,7 +215,12 @@ std::size_t Packet::payloadSize() const {
 auth::CryptoHash Packet::computeDigest(auth::CryptoHashType algorithm) const {
   auth::CryptoHash hash;
   hash.setType(algorithm);
+  computeDigest(algorithm, hash.getDigest()->writableData());
+  return hash;
+}
 
+std::size_t Packet::computeDigest(auth::CryptoHashType algorithm,
+                                  uint8_t *digest) const {
   // Copy IP+TCP/ICMP header before zeroing them
   u8 header_copy[HICN_HDRLEN_MAX];
   size_t header_len;
@@ -223,10 +228,11 @@ auth::CryptoHash Packet::computeDigest(auth::CryptoHashType algorithm) const {
                           /* copy_ah */ false);
   const_cast<Packet *>(this)->resetForHash();
 
-  hash.computeDigest(this);
+  std::size_t digest_size =
+      auth::CryptoHash::computeDigest(algorithm, this, digest);
   hicn_packet_load_header(&pkbuf_, header_copy, header_len);
 
-  return hash;
+  return digest_size;
 }
 
 void Packet::reset() {
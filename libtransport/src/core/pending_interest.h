@@ -22,7 +22,6 @@
 #include <hicn/transport/core/name.h>
 #include <hicn/transport/interfaces/portal.h>
 #include <hicn/transport/portability/portability.h>
-#include <utils/deadline_timer.h>
 
 namespace transport {
 
@@ -43,32 +42,29 @@ class PendingInterest {
  public:
   using Ptr = utils::ObjectPool<PendingInterest>::Ptr;
 
-  PendingInterest(asio::io_service &io_service, const Interest::Ptr &interest)
-      : interest_(interest), timer_(io_service) {}
+  PendingInterest(const Interest::Ptr &interest)
+      : interest_(interest), timer_id_(0) {}
 
-  PendingInterest(asio::io_service &io_service, const Interest::Ptr &interest,
+  PendingInterest(const Interest::Ptr &interest,
                   OnContentObjectCallback &&on_content_object,
                   OnInterestTimeoutCallback &&on_interest_timeout)
       : interest_(interest),
-        timer_(io_service),
+        timer_id_(0),
         on_content_object_callback_(std::move(on_content_object)),
         on_interest_timeout_callback_(std::move(on_interest_timeout)) {}
 
   ~PendingInterest() = default;
 
-  template <typename Handler>
-  void startCountdown(uint32_t lifetime, Handler &&cb) {
-    timer_.expires_from_now(std::chrono::milliseconds(lifetime));
-    timer_.async_wait(std::forward<Handler>(cb));
-  }
+  /**
+   * Expiry timers live in a timer wheel shared by all the portals of a
+   * worker, which does not support cancellation. Each countdown gets a new
+   * id, and a timer only expires the pending interest if the ids match.
+   */
+  void setTimerId(uint32_t timer_id) { timer_id_ = timer_id; }
 
-  void cancelTimer() {
-    try {
-      timer_.cancel();
-    } catch (asio::system_error &e) {
-      // do nothing
-    }
-  }
+  uint32_t getTimerId() const { return timer_id_; }
+
+  void cancelTimer() { timer_id_ = 0; }
 
   Interest::Ptr &&getInterest() { return std::move(interest_); }
 
@@ -95,7 +91,7 @@ class PendingInterest {
 
  private:
   Interest::Ptr interest_;
-  asio::steady_timer timer_;
+  uint32_t timer_id_;
   OnContentObjectCallback on_content_object_callback_;
   OnInterestTimeoutCallback on_interest_timeout_callback_;
 };
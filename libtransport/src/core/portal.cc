@@ -21,6 +21,7 @@
 #include <hicn/transport/utils/file.h>
 
 #include <libconfig.h++>
+#include <mutex>
 
 using namespace transport::interface::global_config;
 
@@ -148,5 +149,91 @@ void Portal::parseIoModuleConfiguration(const libconfig::Setting& io_config,
   }
 }
 
+namespace portal_details {
+
+constexpr std::chrono::milliseconds PendingInterestTimers::tick;
+
+PendingInterestTimers::Ptr PendingInterestTimers::getInstance(
+    ::utils::EventThread &worker) {
+  static std::mutex instances_mutex;
+  static std::unordered_map<asio::io_service *,
+                            std::weak_ptr<PendingInterestTimers>>
+      instances;
+
+  std::lock_guard<std::mutex> lock(instances_mutex);
+  auto &instance = instances[&worker.getIoService()];
+  auto ret = instance.lock();
+  if (!ret) {
+    ret = std::make_shared<PendingInterestTimers>(worker.getIoService());
+    instance = ret;
+  }
+
+  return ret;
+}
+
+PendingInterestTimers::PendingInterestTimers(asio::io_service &io_service)
+    : timer_(io_service), running_(false) {}
+
+PendingInterestTimers::~PendingInterestTimers() {
+  try {
+    timer_.cancel();
+  } catch (asio::system_error &e) {
+    // do nothing
+  }
+}
+
+void PendingInterestTimers::schedule(uint32_t lifetime, Expiry &&expiry) {
+  auto now = std::chrono::steady_clock::now();
+
+  if (!running_) {
+    // The wheel does not advance while idle: move tick 0 so that the current
+    // tick corresponds to now.
+    origin_ = now - tick * wheel_.now();
+    running_ = true;
+    startTimer();
+  }
+
+  // Round the deadline up to the next tick, so that timers never expire
+  // before their lifetime.
+  auto deadline = now - origin_ + std::chrono::milliseconds(lifetime);
+  uint64_t deadline_tick =
+      (deadline + tick - std::chrono::nanoseconds(1)) / tick;
+  wheel_.schedule(deadline_tick - wheel_.now(), std::move(expiry));
+}
+
+void PendingInterestTimers::startTimer() {
+  timer_.expires_at(origin_ + tick * (wheel_.now() + 1));
+  timer_.async_wait([self = weak_from_this()](const std::error_code &ec) {
+    if (TRANSPORT_EXPECT_FALSE(ec.operator bool())) {
+      return;
+    }
+
+    if (auto ptr = self.lock()) {
+      ptr->onTick();
+    }
+  });
+}
+
+void PendingInterestTimers::onTick() {
+  uint64_t elapsed = (std::chrono::steady_clock::now() - origin_) / tick;
+
+  if (elapsed > wheel_.now()) {
+    wheel_.advance(elapsed - wheel_.now(), [](Expiry &expiry) {
+      if (auto portal = expiry.portal.lock()) {
+        portal->timerHandler(expiry.hash, expiry.seq, expiry.timer_id);
+      }
+    });
+  }
+
+  if (wheel_.empty()) {
+    running_ = false;
+    return;
+  }
+
+  startTimer();
+}
+
+}  // namespace portal_details
+
 }  // namespace core
 }  // namespace transport
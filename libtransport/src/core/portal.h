@@ -31,6 +31,7 @@
 #include <hicn/transport/portability/portability.h>
 #include <hicn/transport/utils/event_thread.h>
 #include <hicn/transport/utils/fixed_block_allocator.h>
+#include <utils/timer_wheel.h>
 
 #include <future>
 #include <memory>
@@ -44,6 +45,8 @@ class Setting;
 namespace transport {
 namespace core {
 
+class Portal;
+
 namespace portal_details {
 
 static constexpr uint32_t pit_size = 1024;
@@ -147,6 +150,54 @@ inline CustomAllocatorHandler<Handler> makeCustomAllocatorHandler(
   return CustomAllocatorHandler<Handler>(m, h);
 }
 
+/**
+ * Expiry timers of the pending interests of all the portals running in the
+ * same worker. Timers are kept in a timing wheel advanced by a single
+ * periodic asio timer, which only runs while timers are pending, so that
+ * the cost of a timer does not depend on the number of interests in flight.
+ *
+ * Must be used from the worker thread only.
+ */
+class PendingInterestTimers
+    : public std::enable_shared_from_this<PendingInterestTimers> {
+ public:
+  using Ptr = std::shared_ptr<PendingInterestTimers>;
+
+  static constexpr std::chrono::milliseconds tick{1};
+
+  struct Expiry {
+    std::weak_ptr<Portal> portal;
+    uint32_t hash;
+    uint32_t seq;
+    uint32_t timer_id;
+  };
+
+  /**
+   * Get the timers of a worker, creating them if needed.
+   */
+  static Ptr getInstance(::utils::EventThread &worker);
+
+  explicit PendingInterestTimers(asio::io_service &io_service);
+
+  ~PendingInterestTimers();
+
+  /**
+   * Schedule a timer calling Portal::timerHandler after lifetime
+   * milliseconds.
+   */
+  void schedule(uint32_t lifetime, Expiry &&expiry);
+
+ private:
+  void startTimer();
+  void onTick();
+
+  asio::steady_timer timer_;
+  ::utils::TimerWheel<Expiry> wheel_;
+  // Time of tick 0 of the wheel
+  std::chrono::steady_clock::time_point origin_;
+  bool running_;
+};
+
 }  // namespace portal_details
 
 class PortalConfiguration;
@@ -161,8 +212,9 @@ using PendingInterestHashTable = std::unordered_map<uint32_t, PendingInterest>;
  * The tasks performed by portal are the following:
  * - Sending/Receiving Interest packets
  * - Sending/Receiving Data packets
- * - Set timers (one per interest), in order to trigger events if an interest is
- *   not satisfied
+ * - Set timers (one per interest, in a timing wheel shared by the portals of
+ *   the same worker), in order to trigger events if an interest is not
+ *   satisfied
  * - Register a producer prefix to the local forwarder
  *
  * The way of working of portal is event-based, which means that data and
@@ -181,6 +233,8 @@ class Portal : public ::utils::NonCopyable,
   Portal(::utils::EventThread &worker)
       : io_module_(nullptr),
         worker_(worker),
+        timers_(portal_details::PendingInterestTimers::getInstance(worker)),
+        next_timer_id_(0),
         app_name_("libtransport_application"),
         transport_callback_(nullptr),
         is_consumer_(false) {}
@@ -327,8 +381,7 @@ class Portal : public ::utils::NonCopyable,
     uint32_t counter = 0;
     // Set timers
     do {
-      auto pend_int = pending_interest_hash_table_.try_emplace(
-          hash, worker_.getIoService(), interest);
+      auto pend_int = pending_interest_hash_table_.try_emplace(hash, interest);
       PendingInterest &pending_interest = pend_int.first->second;
       if (!pend_int.second) {
         // element was already in map
@@ -342,19 +395,14 @@ class Portal : public ::utils::NonCopyable,
           std::move(on_interest_timeout_callback));
 
       if (is_consumer_) {
-        auto self = weak_from_this();
-        pending_interest.startCountdown(
-            lifetime, portal_details::makeCustomAllocatorHandler(
-                          async_callback_memory_,
-                          [self, hash, seq](const std::error_code &ec) {
-                            if (TRANSPORT_EXPECT_FALSE(ec.operator bool())) {
-                              return;
-                            }
-
-                            if (auto ptr = self.lock()) {
-                              ptr->timerHandler(hash, seq);
-                            }
-                          }));
+        // 0 is reserved for pending interests without timer
+        if (TRANSPORT_EXPECT_FALSE(++next_timer_id_ == 0)) {
+          ++next_timer_id_;
+        }
+
+        pending_interest.setTimerId(next_timer_id_);
+        timers_->schedule(lifetime,
+                          {weak_from_this(), hash, seq, next_timer_id_});
       }
 
       if (suffix) {
@@ -429,11 +477,15 @@ class Portal : public ::utils::NonCopyable,
    *
    * @param hash - The index of the interest in the pending interest hash
    * table.
+   *
+   * @param timer_id - The id of the timer, which is stale if the interest has
+   * been satisfied or sent again in the meantime.
    */
-  void timerHandler(uint32_t hash, uint32_t seq) {
+  void timerHandler(uint32_t hash, uint32_t seq, uint32_t timer_id) {
     PendingInterestHashTable::iterator it =
         pending_interest_hash_table_.find(hash);
-    if (it != pending_interest_hash_table_.end()) {
+    if (it != pending_interest_hash_table_.end() &&
+        it->second.getTimerId() == timer_id) {
       PendingInterest &pend_interest = it->second;
       auto _int = pend_interest.getInterest();
       auto callback = pend_interest.getOnTimeoutCallback();
@@ -671,11 +723,13 @@ class Portal : public ::utils::NonCopyable,
   }
 
  private:
-  portal_details::HandlerMemory async_callback_memory_;
   std::unique_ptr<IoModule> io_module_;
 
   ::utils::EventThread &worker_;
 
+  portal_details::PendingInterestTimers::Ptr timers_;
+  uint32_t next_timer_id_;
+
   std::string app_name_;
 
   PendingInterestHashTable pending_interest_hash_table_;
@@ -62,6 +62,13 @@ void UdpTunnelConnector::send(const utils::MemBuf::Ptr &buffer) {
     if (TRANSPORT_EXPECT_TRUE(self->state_ == State::CONNECTED)) {
       if (!write_in_progress) {
         self->doSendPacket(self);
+#ifdef LINUX
+      } else if (self->output_buffer_.size() ==
+                 std::size_t(Connector::max_burst)) {
+        // A whole batch is ready: do not wait for the send timer
+        self->send_timer_.cancel();
+        self->writeHandler();
+#endif
       }
     } else {
       self->data_available_ = true;
@@ -177,6 +177,12 @@ class HTTPClientConnection::Implementation
   // Read callback
   bool isBufferMovable() noexcept override { return true; }
 
+  // The headers of the response are parsed from the first buffer only, so the
+  // internal response always gets contiguous buffers
+  bool isBufferChainable() noexcept override {
+    return read_bytes_callback_ && read_bytes_callback_->isBufferChainable();
+  }
+
   void getReadBuffer(uint8_t **application_buffer,
                      size_t *max_length) override {}
 
@@ -21,6 +21,7 @@
 #include <hicn/transport/interfaces/statistics.h>
 #include <hicn/transport/utils/event_thread.h>
 #include <implementation/socket.h>
+#include <protocols/bbr.h>
 #include <protocols/cbr.h>
 #include <protocols/raaqm.h>
 #include <protocols/rtc/rtc.h>
@@ -46,6 +47,8 @@ class ConsumerSocket : public Socket {
         current_window_size_(-1),
         max_retransmissions_(
             default_values::transport_protocol_max_retransmissions),
+        pacing_rate_(default_values::pacing_rate),
+        pacing_burst_(default_values::pacing_burst),
         /****** RAAQM Parameters ******/
         minimum_drop_probability_(default_values::minimum_drop_probability),
         sample_number_(default_values::sample_number),
@@ -62,6 +65,7 @@ class ConsumerSocket : public Socket {
         verifier_(std::make_shared<auth::VoidVerifier>()),
         verify_signature_(false),
         reset_window_(false),
+        multipath_(false),
         on_interest_output_(VOID_HANDLER),
         on_interest_timeout_(VOID_HANDLER),
         on_interest_satisfied_(VOID_HANDLER),
@@ -81,6 +85,10 @@ class ConsumerSocket : public Socket {
         transport_protocol_ =
             std::make_shared<protocol::CbrTransportProtocol>(this);
         break;
+      case TransportProtocolAlgorithms::BBR:
+        transport_protocol_ =
+            std::make_shared<protocol::BbrTransportProtocol>(this);
+        break;
       case TransportProtocolAlgorithms::RTC:
         transport_protocol_ =
             std::make_shared<protocol::rtc::RTCTransportProtocol>(this);
@@ -200,6 +208,10 @@ class ConsumerSocket : public Socket {
         current_window_size_ = socket_option_value;
         break;
 
+      case PACING_RATE:
+        pacing_rate_ = socket_option_value;
+        break;
+
       case GAMMA_VALUE:
         gamma_ = socket_option_value;
         break;
@@ -241,6 +253,10 @@ class ConsumerSocket : public Socket {
         interest_lifetime_ = socket_option_value;
         break;
 
+      case GeneralTransportOptions::PACING_BURST:
+        pacing_burst_ = socket_option_value;
+        break;
+
       case RateEstimationOptions::RATE_ESTIMATION_BATCH_PARAMETER:
         if (socket_option_value > 0) {
           rate_estimation_batching_parameter_ = socket_option_value;
@@ -340,6 +356,11 @@ class ConsumerSocket : public Socket {
           result = SOCKET_OPTION_SET;
           break;
 
+        case RaaqmTransportOptions::MULTIPATH:
+          multipath_ = socket_option_value;
+          result = SOCKET_OPTION_SET;
+          break;
+
         case RtcTransportOptions::AGGREGATED_DATA:
           aggregated_data_ = socket_option_value;
           result = SOCKET_OPTION_SET;
@@ -538,6 +559,10 @@ class ConsumerSocket : public Socket {
         socket_option_value = current_window_size_;
         break;
 
+      case GeneralTransportOptions::PACING_RATE:
+        socket_option_value = pacing_rate_;
+        break;
+
         // RAAQM parameters
 
       case RaaqmTransportOptions::GAMMA_VALUE:
@@ -578,6 +603,10 @@ class ConsumerSocket : public Socket {
         socket_option_value = interest_lifetime_;
         break;
 
+      case GeneralTransportOptions::PACING_BURST:
+        socket_option_value = pacing_burst_;
+        break;
+
       case RaaqmTransportOptions::SAMPLE_NUMBER:
         socket_option_value = sample_number_;
         break;
@@ -631,6 +660,10 @@ class ConsumerSocket : public Socket {
         socket_option_value = reset_window_;
         break;
 
+      case RaaqmTransportOptions::MULTIPATH:
+        socket_option_value = multipath_;
+        break;
+
       case RtcTransportOptions::AGGREGATED_DATA:
         socket_option_value = aggregated_data_;
         break;
@@ -870,6 +903,10 @@ class ConsumerSocket : public Socket {
   double current_window_size_;
   uint32_t max_retransmissions_;
 
+  // Interest pacing
+  double pacing_rate_;
+  uint32_t pacing_burst_;
+
   // RAAQM Parameters
   double minimum_drop_probability_;
   unsigned int sample_number_;
@@ -890,6 +927,7 @@ class ConsumerSocket : public Socket {
   transport::auth::KeyId *key_id_;
   std::atomic_bool verify_signature_;
   bool reset_window_;
+  bool multipath_;
 
   ConsumerInterestCallback on_interest_retransmission_;
   ConsumerInterestCallback on_interest_output_;
@@ -53,6 +53,7 @@ class ProducerSocket : public Socket {
         max_segment_size_(default_values::content_object_packet_size),
         content_object_expiry_time_(default_values::content_object_expiry_time),
         manifest_max_capacity_(default_values::manifest_max_capacity),
+        signing_threads_(default_values::signing_threads),
         hash_algorithm_(auth::CryptoHashType::SHA256),
         suffix_strategy_(std::make_shared<utils::IncrementalSuffixStrategy>(0)),
         aggregated_data_(false),
@@ -185,6 +186,10 @@ class ProducerSocket : public Socket {
         manifest_max_capacity_ = socket_option_value;
         break;
 
+      case GeneralTransportOptions::SIGNING_THREADS:
+        signing_threads_ = socket_option_value;
+        break;
+
       case GeneralTransportOptions::MAX_SEGMENT_SIZE:
         if (socket_option_value <= default_values::max_content_object_size &&
             socket_option_value > 0) {
@@ -478,6 +483,10 @@ class ProducerSocket : public Socket {
         socket_option_value = (uint32_t)manifest_max_capacity_;
         break;
 
+      case GeneralTransportOptions::SIGNING_THREADS:
+        socket_option_value = signing_threads_;
+        break;
+
       case GeneralTransportOptions::OUTPUT_BUFFER_SIZE:
         socket_option_value =
             (uint32_t)production_protocol_->getOutputBufferSize();
@@ -773,6 +782,7 @@ class ProducerSocket : public Socket {
   std::atomic<uint32_t> content_object_expiry_time_;
 
   std::atomic<uint32_t> manifest_max_capacity_;
+  std::atomic<uint32_t> signing_threads_;
   std::atomic<auth::CryptoHashType> hash_algorithm_;
   std::atomic<auth::CryptoSuite> crypto_suite_;
   utils::SpinLock signer_lock_;
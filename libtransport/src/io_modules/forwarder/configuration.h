@@ -41,7 +41,7 @@ struct RouteConfig {
 
 class Configuration {
  public:
-  Configuration() : n_threads_(1) {}
+  Configuration() : n_threads_(1), content_store_size_(0) {}
 
   bool empty() {
     return listeners_.empty() && connectors_.empty() && routes_.empty();
@@ -54,6 +54,13 @@ class Configuration {
 
   std::size_t getThreadNumber() { return n_threads_; }
 
+  Configuration& setContentStoreSize(std::size_t size) {
+    content_store_size_ = size;
+    return *this;
+  }
+
+  std::size_t getContentStoreSize() { return content_store_size_; }
+
   template <typename... Args>
   Configuration& addListener(Args&&... args) {
     listeners_.emplace_back(std::forward<Args>(args)...);
@@ -83,6 +90,7 @@ class Configuration {
   std::vector<ConnectorConfig> connectors_;
   std::vector<RouteConfig> routes_;
   std::size_t n_threads_;
+  std::size_t content_store_size_;
 };
 
 }  // namespace core
@@ -37,7 +37,10 @@ Forwarder::Forwarder() : config_() {
     initThreads();
     initListeners();
     initConnectors();
+    initRoutes();
   }
+
+  cs_.setCapacity(config_.getContentStoreSize());
 }
 
 Forwarder::~Forwarder() {
@@ -81,11 +84,30 @@ void Forwarder::initConnectors() {
         std::bind(&Forwarder::onConnectorReconnected, this, _1));
     conn->setConnectorId(id);
     remote_connectors_.emplace(id, conn);
+    connector_names_.emplace(c.name, id);
     conn->connect(c.remote_address, c.remote_port, c.local_address,
                   c.local_port);
   }
 }
 
+void Forwarder::initRoutes() {
+  for (auto &r : config_.getRoutes()) {
+    auto it = connector_names_.find(r.connector);
+    if (it == connector_names_.end()) {
+      LOG(ERROR) << "Route " << r.name << " uses unknown connector "
+                 << r.connector << ". Ignoring it.";
+      continue;
+    }
+
+    try {
+      registerRoute(Prefix(r.prefix), it->second, r.weight);
+    } catch (errors::InvalidIpAddressException &e) {
+      LOG(ERROR) << "Route " << r.name << " has invalid prefix " << r.prefix
+                 << ". Ignoring it.";
+    }
+  }
+}
+
 Connector::Id Forwarder::registerLocalConnector(
     asio::io_service &io_service,
     Connector::PacketReceivedCallback &&receive_callback,
@@ -103,14 +125,20 @@ Connector::Id Forwarder::registerLocalConnector(
 }
 
 Forwarder &Forwarder::deleteConnector(Connector::Id id) {
-  utils::SpinLock::Acquire locked(connector_lock_);
-  auto it = local_connectors_.find(id);
-  if (it != local_connectors_.end()) {
-    it->second->close();
-    local_connectors_.erase(it);
-  } else {
+  {
+    utils::SpinLock::Acquire locked(connector_lock_);
+    auto it = local_connectors_.find(id);
+    if (it != local_connectors_.end()) {
+      it->second->close();
+      local_connectors_.erase(it);
+    } else {
+    }
   }
 
+  utils::SpinLock::Acquire locked(tables_lock_);
+  fib_.removeConnector(id);
+  pit_.removeConnector(id);
+
   return *this;
 }
 
@@ -152,33 +180,169 @@ void Forwarder::onPacketReceived(Connector *connector,
     return;
   }
 
-  for (auto &c : local_connectors_) {
-    c.second->receive(packets);
+  for (auto &buffer : packets) {
+    // The buffer is a base class for an interest or a content object
+    processPacket(static_cast<Packet &>(*buffer), connector->getConnectorId());
   }
+}
 
-  // PCS Lookup + FIB lookup. Skip for now
+void Forwarder::send(Packet &packet, Connector::Id connector_id) {
+  processPacket(packet, connector_id);
+}
 
-  // Forward packet to local connectors
+void Forwarder::registerRoute(const Prefix &prefix, Connector::Id id,
+                              uint16_t weight) {
+  DLOG_IF(INFO, VLOG_IS_ON(2))
+      << "Adding route " << prefix.getNetwork() << "/"
+      << prefix.getPrefixLength() << " to connector " << id;
+  utils::SpinLock::Acquire locked(tables_lock_);
+  fib_.addRoute(prefix, id, weight);
 }
 
-void Forwarder::send(Packet &packet, Connector::Id connector_id) {
-  // TODo Here a nice PIT/CS / FIB would be required:)
-  // For now let's just forward the packet on the remote connector we get
-  for (auto &c : remote_connectors_) {
-    auto remote_endpoint = c.second->getRemoteEndpoint();
+void Forwarder::processPacket(Packet &packet, Connector::Id ingress) {
+  switch (packet.getType()) {
+    case HICN_PACKET_TYPE_INTEREST:
+      processInterest(static_cast<Interest &>(packet), ingress);
+      break;
+    case HICN_PACKET_TYPE_DATA:
+      processContentObject(static_cast<ContentObject &>(packet), ingress);
+      break;
+    default:
+      LOG(ERROR) << "Received not supported packet. Ignoring it.";
+      break;
+  }
+}
+
+void Forwarder::processInterest(Interest &interest, Connector::Id ingress) {
+  auto now = utils::SteadyTime::now();
+  ContentObject::Ptr cached;
+  std::vector<Connector::Id> egress;
+
+  {
+    utils::SpinLock::Acquire locked(tables_lock_);
+
+    if (cs_.enabled()) {
+      cached = cs_.lookup(interest.getName(), now);
+    }
+
+    if (!cached) {
+      auto verdict = pit_.onInterest(interest.getName(), ingress,
+                                     interest.getLifetime(), now);
+      if (verdict == Pit::Verdict::AGGREGATE) {
+        DLOG_IF(INFO, VLOG_IS_ON(3))
+            << "Interest " << interest.getName() << " aggregated.";
+        return;
+      }
+
+      // Send the interest to the best next hop other than the ingress
+      auto next_hops = fib_.lookup(interest.getName());
+      if (next_hops) {
+        for (auto &nh : *next_hops) {
+          if (nh.connector != ingress) {
+            egress.push_back(nh.connector);
+            break;
+          }
+        }
+      }
+    }
+  }
+
+  if (cached) {
     DLOG_IF(INFO, VLOG_IS_ON(3))
-        << "Sending packet to: " << remote_endpoint.getAddress() << ":"
-        << remote_endpoint.getPort();
-    c.second->send(packet);
+        << "Interest " << interest.getName() << " satisfied from cache.";
+    forwardPacket(*cached, ingress);
+    return;
+  }
+
+  if (!egress.empty()) {
+    forwardPacket(interest, egress);
+    return;
   }
 
-  for (auto &c : local_connectors_) {
-    if (c.first != connector_id) {
-      DLOG_IF(INFO, VLOG_IS_ON(3))
-          << "Sending packet to local connector " << c.first << std::endl;
-      c.second->receive({packet.shared_from_this()});
+  // Without a matching route, interests from local applications are sent to
+  // all remote connectors, which act as default route.
+  std::vector<Connector::Ptr> remotes;
+  {
+    utils::SpinLock::Acquire locked(connector_lock_);
+    if (remote_connectors_.find(ingress) == remote_connectors_.end()) {
+      for (auto &c : remote_connectors_) {
+        remotes.push_back(c.second);
+      }
+    }
+  }
+
+  if (!remotes.empty()) {
+    for (auto &c : remotes) {
+      c->send(interest);
+    }
+
+    return;
+  }
+
+  DLOG_IF(INFO, VLOG_IS_ON(3))
+      << "No route for interest " << interest.getName() << ". Dropping it.";
+}
+
+void Forwarder::processContentObject(ContentObject &content_object,
+                                     Connector::Id ingress) {
+  auto now = utils::SteadyTime::now();
+  std::vector<Connector::Id> egress;
+
+  {
+    utils::SpinLock::Acquire locked(tables_lock_);
+    egress = pit_.onData(content_object.getName(), now);
+    if (egress.empty()) {
+      DLOG_IF(INFO, VLOG_IS_ON(3)) << "Unsolicited data "
+                                   << content_object.getName() << " dropped.";
+      return;
+    }
+
+    cs_.insert(content_object, now);
+  }
+
+  forwardPacket(content_object, egress);
+}
+
+void Forwarder::forwardPacket(Packet &packet,
+                              const std::vector<Connector::Id> &egress) {
+  for (auto id : egress) {
+    forwardPacket(packet, id);
+  }
+}
+
+void Forwarder::forwardPacket(Packet &packet, Connector::Id egress) {
+  bool local = false;
+  Connector::Ptr connector;
+
+  {
+    utils::SpinLock::Acquire locked(connector_lock_);
+    auto it = local_connectors_.find(egress);
+    if (it != local_connectors_.end()) {
+      connector = it->second;
+      local = true;
+    } else {
+      it = remote_connectors_.find(egress);
+      if (it != remote_connectors_.end()) {
+        connector = it->second;
+      }
     }
   }
+
+  if (!connector) {
+    DLOG_IF(INFO, VLOG_IS_ON(3)) << "Connector " << egress << " not found.";
+    return;
+  }
+
+  if (local) {
+    DLOG_IF(INFO, VLOG_IS_ON(3))
+        << "Sending packet to local connector " << egress;
+    connector->receive({packet.shared_from_this()});
+  } else {
+    DLOG_IF(INFO, VLOG_IS_ON(3))
+        << "Sending packet to: " << connector->getRemoteEndpoint().getAddress()
+        << ":" << connector->getRemoteEndpoint().getPort();
+    connector->send(packet);
+  }
 }
 
 void Forwarder::onPacketSent(Connector *connector, const std::error_code &ec) {}
@@ -200,6 +364,15 @@ void Forwarder::parseForwarderConfiguration(
     config_.setThreadNumber(n_threads);
   }
 
+  // content_store_size
+  if (forwarder_config.exists("content_store_size")) {
+    unsigned content_store_size = 0;
+    forwarder_config.lookupValue("content_store_size", content_store_size);
+    VLOG(1) << "Forwarder content store size from config file: "
+            << content_store_size;
+    config_.setContentStoreSize(content_store_size);
+  }
+
   // listeners
   if (forwarder_config.exists("listeners")) {
     // get path where looking for modules
@@ -16,12 +16,14 @@
 #pragma once
 
 #include <core/udp_listener.h>
+#include <hicn/transport/core/interest.h>
 #include <hicn/transport/core/io_module.h>
 #include <hicn/transport/core/prefix.h>
 #include <hicn/transport/utils/event_thread.h>
 #include <hicn/transport/utils/singleton.h>
 #include <hicn/transport/utils/spinlock.h>
 #include <io_modules/forwarder/configuration.h>
+#include <io_modules/forwarder/forwarding_tables.h>
 
 #include <atomic>
 #include <libconfig.h++>
@@ -42,6 +44,7 @@ class Forwarder {
   void initThreads();
   void initListeners();
   void initConnectors();
+  void initRoutes();
 
   Connector::Id registerLocalConnector(
       asio::io_service &io_service,
@@ -56,6 +59,13 @@ class Forwarder {
 
   void send(Packet &packet, Connector::Id id);
 
+  /**
+   * Route interests matching prefix to the given connector, typically the
+   * local connector of a producer.
+   */
+  void registerRoute(const Prefix &prefix, Connector::Id id,
+                     uint16_t weight = 1);
+
   void stop();
 
  private:
@@ -69,6 +79,13 @@ class Forwarder {
   void onConnectorClosed(Connector *connector);
   void onConnectorReconnected(Connector *connector);
 
+  void processPacket(Packet &packet, Connector::Id ingress);
+  void processInterest(Interest &interest, Connector::Id ingress);
+  void processContentObject(ContentObject &content_object,
+                            Connector::Id ingress);
+  void forwardPacket(Packet &packet, const std::vector<Connector::Id> &egress);
+  void forwardPacket(Packet &packet, Connector::Id egress);
+
   void parseForwarderConfiguration(const libconfig::Setting &io_config,
                                    std::error_code &ec);
 
@@ -83,6 +100,16 @@ class Forwarder {
   std::unordered_map<Connector::Id, Connector::Ptr> remote_connectors_;
   std::unordered_map<Connector::Id, Connector::Ptr> local_connectors_;
   std::vector<UdpTunnelListener::Ptr> listeners_;
+  std::unordered_map<std::string, Connector::Id> connector_names_;
+
+  /**
+   * Forwarding tables, accessed both from the forwarder threads and from the
+   * threads of local applications.
+   */
+  utils::SpinLock tables_lock_;
+  Fib fib_;
+  Pit pit_;
+  ContentStore cs_;
 
   std::vector<utils::EventThread> thread_pool_;
 
@@ -45,9 +45,7 @@ void ForwarderModule::send(const utils::MemBuf::Ptr &buffer) {
 }
 
 void ForwarderModule::registerRoute(const Prefix &prefix) {
-  // For the moment we route packets from one socket to the other.
-  // Next step will be to introduce a FIB
-  return;
+  forwarder_.registerRoute(prefix, connector_id_);
 }
 
 void ForwarderModule::closeConnection() {
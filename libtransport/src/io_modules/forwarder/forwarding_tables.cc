@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <hicn/transport/portability/endianess.h>
+#include <io_modules/forwarder/forwarding_tables.h>
+
+#include <algorithm>
+
+namespace transport {
+
+namespace core {
+
+/* FIB */
+
+namespace {
+
+/**
+ * Mask an address to the given prefix length, returning it as the key of the
+ * FIB table for that length.
+ */
+Name maskAddress(int family, hicn_ip_address_t address, uint16_t length) {
+  if (family == AF_INET) {
+    length += 3 * IPV4_ADDR_LEN_BITS;
+  }
+
+  for (int i = 0; i < 2; i++) {
+    uint16_t bits = std::min<uint16_t>(length, 64);
+    length -= bits;
+
+    if (bits == 0) {
+      address.v6.as_u64[i] = 0;
+    } else if (bits < 64) {
+      address.v6.as_u64[i] &=
+          portability::host_to_net(~uint64_t(0) << (64 - bits));
+    }
+  }
+
+  return Name(family, hicn_ip_address_get_buffer(&address, family), 0);
+}
+
+}  // namespace
+
+void Fib::addRoute(const Prefix &prefix, Connector::Id connector,
+                   uint16_t weight) {
+  auto length = prefix.getPrefixLength();
+  auto key = maskAddress(prefix.getAddressFamily(),
+                         prefix.toIpPrefixStruct().address, length);
+  auto &next_hops = tables(prefix.getAddressFamily())[length][key];
+
+  auto nh = std::find_if(
+      next_hops.begin(), next_hops.end(),
+      [connector](const NextHop &n) { return n.connector == connector; });
+  if (nh != next_hops.end()) {
+    nh->weight = weight;
+  } else {
+    next_hops.push_back({connector, weight});
+  }
+
+  std::stable_sort(next_hops.begin(), next_hops.end(),
+                   [](const NextHop &a, const NextHop &b) {
+                     return a.weight > b.weight;
+                   });
+}
+
+void Fib::removeConnector(Connector::Id connector) {
+  for (auto *family_tables : {&ipv4_tables_, &ipv6_tables_}) {
+    for (auto t = family_tables->begin(); t != family_tables->end();) {
+      auto &table = t->second;
+      for (auto it = table.begin(); it != table.end();) {
+        auto &next_hops = it->second;
+        next_hops.erase(std::remove_if(next_hops.begin(), next_hops.end(),
+                                       [connector](const NextHop &n) {
+                                         return n.connector == connector;
+                                       }),
+                        next_hops.end());
+        it = next_hops.empty() ? table.erase(it) : std::next(it);
+      }
+      t = table.empty() ? family_tables->erase(t) : std::next(t);
+    }
+  }
+}
+
+const std::vector<Fib::NextHop> *Fib::lookup(const Name &name) const {
+  int family = name.getAddressFamily();
+  auto address = name.toIpAddress().address;
+
+  for (auto &[length, table] : tables(family)) {
+    auto it = table.find(maskAddress(family, address, length));
+    if (it != table.end()) {
+      return &it->second;
+    }
+  }
+
+  return nullptr;
+}
+
+/* PIT */
+
+Pit::Verdict Pit::onInterest(const Name &name, Connector::Id ingress,
+                             uint32_t lifetime_ms, const TimePoint &now) {
+  auto expiry = now + std::chrono::milliseconds(lifetime_ms);
+  auto it = entries_.find(name);
+
+  if (it == entries_.end() || it->second.expiry <= now) {
+    if (++insertions_ % purge_interval == 0) {
+      purgeExpired(now);
+    }
+
+    entries_[name] = Entry{{ingress}, expiry};
+    return Verdict::FORWARD;
+  }
+
+  auto &entry = it->second;
+  entry.expiry = std::max(entry.expiry, expiry);
+
+  if (std::find(entry.ingress.begin(), entry.ingress.end(), ingress) !=
+      entry.ingress.end()) {
+    return Verdict::RETRANSMIT;
+  }
+
+  entry.ingress.push_back(ingress);
+  return Verdict::AGGREGATE;
+}
+
+std::vector<Connector::Id> Pit::onData(const Name &name,
+                                       const TimePoint &now) {
+  std::vector<Connector::Id> ret;
+  auto it = entries_.find(name);
+
+  if (it == entries_.end()) {
+    return ret;
+  }
+
+  if (it->second.expiry > now) {
+    ret = std::move(it->second.ingress);
+  }
+
+  entries_.erase(it);
+  return ret;
+}
+
+void Pit::removeConnector(Connector::Id connector) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    auto &ingress = it->second.ingress;
+    ingress.erase(std::remove(ingress.begin(), ingress.end(), connector),
+                  ingress.end());
+    if (ingress.empty()) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+void Pit::purgeExpired(const TimePoint &now) {
+  for (auto it = entries_.begin(); it != entries_.end();) {
+    if (it->second.expiry <= now) {
+      it = entries_.erase(it);
+    } else {
+      ++it;
+    }
+  }
+}
+
+/* Content store */
+
+void ContentStore::setCapacity(std::size_t capacity) {
+  capacity_ = capacity;
+
+  while (entries_.size() > capacity_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+}
+
+void ContentStore::insert(const ContentObject &content_object,
+                          const TimePoint &now) {
+  if (!enabled()) {
+    return;
+  }
+
+  // Data packets without expiry time are not cached
+  uint32_t lifetime = content_object.getLifetime();
+  if (lifetime == 0) {
+    return;
+  }
+
+  auto coalesced = content_object.cloneCoalesced();
+  auto copy = std::make_shared<ContentObject>(
+      Packet::COPY_BUFFER, coalesced->data(), coalesced->length());
+  auto expiry = now + std::chrono::milliseconds(lifetime);
+
+  const Name &name = content_object.getName();
+  auto it = entries_.find(name);
+  if (it != entries_.end()) {
+    lru_.splice(lru_.begin(), lru_, it->second.lru);
+    it->second.content_object = std::move(copy);
+    it->second.expiry = expiry;
+    return;
+  }
+
+  if (entries_.size() >= capacity_) {
+    entries_.erase(lru_.back());
+    lru_.pop_back();
+  }
+
+  lru_.push_front(name);
+  entries_.emplace(name, Entry{std::move(copy), expiry, lru_.begin()});
+}
+
+ContentObject::Ptr ContentStore::lookup(const Name &name,
+                                        const TimePoint &now) {
+  auto it = entries_.find(name);
+  if (it == entries_.end()) {
+    return nullptr;
+  }
+
+  if (it->second.expiry <= now) {
+    lru_.erase(it->second.lru);
+    entries_.erase(it);
+    return nullptr;
+  }
+
+  lru_.splice(lru_.begin(), lru_, it->second.lru);
+
+  // Hand over a copy, as the receiver may modify the packet
+  auto &stored = it->second.content_object;
+  return std::make_shared<ContentObject>(Packet::COPY_BUFFER, stored->data(),
+                                         stored->length());
+}
+
+}  // namespace core
+
+}  // namespace transport
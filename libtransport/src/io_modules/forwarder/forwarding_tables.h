@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/core/connector.h>
+#include <hicn/transport/core/content_object.h>
+#include <hicn/transport/core/name.h>
+#include <hicn/transport/core/prefix.h>
+#include <hicn/transport/utils/chrono_typedefs.h>
+
+#include <functional>
+#include <list>
+#include <map>
+#include <unordered_map>
+#include <vector>
+
+namespace transport {
+
+namespace core {
+
+/**
+ * Forwarding information base: maps prefixes to the connectors able to
+ * satisfy interests for them. Lookups return the next hops of the longest
+ * matching prefix, ordered by decreasing weight.
+ *
+ * Prefixes are indexed by length: a lookup probes one hash table per prefix
+ * length in use, from the longest down, so its cost does not depend on the
+ * number of routes.
+ */
+class Fib {
+ public:
+  struct NextHop {
+    Connector::Id connector;
+    uint16_t weight;
+  };
+
+  void addRoute(const Prefix &prefix, Connector::Id connector,
+                uint16_t weight);
+
+  /**
+   * Remove a connector from all entries, dropping the entries left without
+   * next hops.
+   */
+  void removeConnector(Connector::Id connector);
+
+  const std::vector<NextHop> *lookup(const Name &name) const;
+
+  bool empty() const { return ipv4_tables_.empty() && ipv6_tables_.empty(); }
+
+ private:
+  // Next hops indexed by the prefix address, masked to the prefix length
+  using Table = std::unordered_map<Name, std::vector<NextHop>>;
+  // Tables sorted by decreasing prefix length
+  using Tables = std::map<uint16_t, Table, std::greater<uint16_t>>;
+
+  Tables &tables(int family) {
+    return family == AF_INET ? ipv4_tables_ : ipv6_tables_;
+  }
+
+  const Tables &tables(int family) const {
+    return family == AF_INET ? ipv4_tables_ : ipv6_tables_;
+  }
+
+  Tables ipv4_tables_;
+  Tables ipv6_tables_;
+};
+
+/**
+ * Pending interest table, aggregating interests for the same name until the
+ * corresponding data packet is received or the interest expires.
+ */
+class Pit {
+ public:
+  enum class Verdict {
+    // New entry, the interest has to be forwarded
+    FORWARD,
+    // Interest aggregated on an existing entry
+    AGGREGATE,
+    // Interest retransmitted by a connector already in the entry, which has
+    // to be forwarded again
+    RETRANSMIT,
+  };
+
+  using TimePoint = utils::SteadyTime::TimePoint;
+
+  Verdict onInterest(const Name &name, Connector::Id ingress,
+                     uint32_t lifetime_ms, const TimePoint &now);
+
+  /**
+   * Consume the entry matching a data packet.
+   *
+   * @return The connectors on which the data has to be sent, empty if the
+   * data was not requested.
+   */
+  std::vector<Connector::Id> onData(const Name &name, const TimePoint &now);
+
+  void removeConnector(Connector::Id connector);
+
+  std::size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    std::vector<Connector::Id> ingress;
+    TimePoint expiry;
+  };
+
+  void purgeExpired(const TimePoint &now);
+
+  static constexpr std::size_t purge_interval = 1024;
+
+  std::unordered_map<Name, Entry> entries_;
+  std::size_t insertions_ = 0;
+};
+
+/**
+ * Small LRU content store. Data packets are stored as a single contiguous
+ * copy, as received buffers are handed over to applications.
+ */
+class ContentStore {
+ public:
+  using TimePoint = utils::SteadyTime::TimePoint;
+
+  explicit ContentStore(std::size_t capacity = 0) : capacity_(capacity) {}
+
+  void setCapacity(std::size_t capacity);
+
+  bool enabled() const { return capacity_ > 0; }
+
+  void insert(const ContentObject &content_object, const TimePoint &now);
+
+  /**
+   * @return A copy of the stored data packet, or nullptr on miss or if the
+   * stored packet has expired.
+   */
+  ContentObject::Ptr lookup(const Name &name, const TimePoint &now);
+
+  std::size_t size() const { return entries_.size(); }
+
+ private:
+  struct Entry {
+    ContentObject::Ptr content_object;
+    TimePoint expiry;
+    std::list<Name>::iterator lru;
+  };
+
+  std::size_t capacity_;
+  std::unordered_map<Name, Entry> entries_;
+  // Most recently used first
+  std::list<Name> lru_;
+};
+
+}  // namespace core
+
+}  // namespace transport
@@ -17,6 +17,14 @@
 #include <hicn/transport/utils/uri.h>
 #include <io_modules/hicn-light/hicn_forwarder_module.h>
 
+#ifdef HICNLIGHT_MEMIF
+#include <core/memif_connector.h>
+#include <unistd.h>
+
+#include <atomic>
+#include <random>
+#endif
+
 extern "C" {
 #include <hicn/ctrl/hicn-light.h>
 }
@@ -25,11 +33,25 @@ namespace transport {
 
 namespace core {
 
+/* Name of the connection over which the commands are received */
+static constexpr char self_face_name[] = "SELF";
+
 HicnForwarderModule::ForwarderUrlInitializer
     HicnForwarderModule::forwarder_url_initializer_;
 
 HicnForwarderModule::HicnForwarderModule()
-    : IoModule(), connector_(nullptr), seq_(0) {}
+    : IoModule(),
+      connector_(nullptr),
+#ifdef HICNLIGHT_MEMIF
+      memif_connector_(nullptr),
+      memif_id_(0),
+      memif_state_(MemifState::IDLE),
+      memif_seq_(0),
+      memif_attempts_(0),
+      is_consumer_(false),
+#endif
+      face_name_(self_face_name),
+      seq_(0) {}
 
 HicnForwarderModule::~HicnForwarderModule() {}
 
@@ -56,13 +78,78 @@ void HicnForwarderModule::connect(bool is_consumer) {
     connector_->setRole(is_consumer ? Connector::Role::CONSUMER
                                     : Connector::Role::PRODUCER);
   }
+
+#ifdef HICNLIGHT_MEMIF
+  if (memif_connector_ && memif_state_ == MemifState::IDLE) {
+    // The forwarder is the memif master: ask it to create the interface over
+    // the control connection, and join it as slave once it has accepted it
+    // (see onMemifConnectionReply).
+    is_consumer_ = is_consumer;
+    sendMemifConnection();
+  }
+#endif
+}
+
+#ifdef HICNLIGHT_MEMIF
+void HicnForwarderModule::setMemifId(uint32_t memif_id) {
+  memif_id_ = memif_id & 0xffff;
+  face_name_ = "memif" + std::to_string(memif_id_);
+}
+
+void HicnForwarderModule::sendMemifConnection() {
+  auto command = createCommandMemifConnection();
+  memif_seq_ = reinterpret_cast<msg_header_t *>(command->writableData())
+                   ->header.seq_num;
+  memif_state_ = MemifState::PENDING;
+  memif_attempts_++;
+  sendCommand(command);
+}
+
+void HicnForwarderModule::onMemifConnectionReply(bool ack) {
+  if (!ack) {
+    // The id (or the face name derived from it) is most likely used by
+    // another application: retry with a random one.
+    if (memif_attempts_ >= memif_max_attempts) {
+      throw errors::RuntimeException(
+          "Could not create memif connection on hicn light forwarder.");
+    }
+
+    VLOG(1) << "memif " << memif_id_ << " refused by the forwarder, retrying";
+    std::random_device random;
+    setMemifId(random());
+    sendMemifConnection();
+    return;
+  }
+
+  memif_state_ = MemifState::CREATED;
+
+  VLOG(1) << "Connecting to memif " << memif_id_ << " on "
+          << forwarder_url_initializer_.getMemifSocket();
+
+  memif_connector_->connect(memif_id_, 0 /* is_master = false */,
+                            forwarder_url_initializer_.getMemifSocket(),
+                            memif_buffer_size, memif_log2_ring_size);
+  memif_connector_->setRole(is_consumer_ ? Connector::Role::CONSUMER
+                                         : Connector::Role::PRODUCER);
 }
+#endif
 
-bool HicnForwarderModule::isConnected() { return connector_->isConnected(); }
+bool HicnForwarderModule::isConnected() {
+#ifdef HICNLIGHT_MEMIF
+  if (memif_connector_ && !memif_connector_->isConnected()) return false;
+#endif
+  return connector_->isConnected();
+}
 
 void HicnForwarderModule::send(Packet &packet) {
   IoModule::send(packet);
   packet.setChecksum();
+#ifdef HICNLIGHT_MEMIF
+  if (memif_connector_) {
+    memif_connector_->send(packet);
+    return;
+  }
+#endif
   connector_->send(packet);
 }
 
@@ -71,41 +158,54 @@ void HicnForwarderModule::send(const utils::MemBuf::Ptr &packet) {
   counters_.tx_bytes += packet->length();
 
   // Perfect forwarding
+#ifdef HICNLIGHT_MEMIF
+  if (memif_connector_) {
+    memif_connector_->send(packet);
+    return;
+  }
+#endif
   connector_->send(packet);
 }
 
-void HicnForwarderModule::registerRoute(const Prefix &prefix) {
-  auto command = createCommandRoute(prefix.toSockaddr(),
-                                    (uint8_t)prefix.getPrefixLength());
+void HicnForwarderModule::sendCommand(const utils::MemBuf::Ptr &command) {
   if (!command) {
     // TODO error
     return;
   }
-  send(command);
+  connector_->send(command);
+}
+
+void HicnForwarderModule::registerRoute(const Prefix &prefix) {
+#ifdef HICNLIGHT_MEMIF
+  // Routes point to the memif face, and are registered once it is connected
+  if (memif_connector_ && !memif_connector_->isConnected()) return;
+#endif
+  sendCommand(createCommandRoute(prefix.toSockaddr(),
+                                 (uint8_t)prefix.getPrefixLength()));
 }
 
 void HicnForwarderModule::sendMapme() {
-  auto command = createCommandMapmeSendUpdate();
-  if (!command) {
-    // TODO error
-    return;
-  }
-  send(command);
+  sendCommand(createCommandMapmeSendUpdate());
 }
 
 void HicnForwarderModule::setForwardingStrategy(const Prefix &prefix,
                                                 std::string &strategy) {
-  auto command = createCommandSetForwardingStrategy(
-      prefix.toSockaddr(), (uint8_t)prefix.getPrefixLength(), strategy);
-  if (!command) {
-    // TODO error
-    return;
-  }
-  send(command);
+  sendCommand(createCommandSetForwardingStrategy(
+      prefix.toSockaddr(), (uint8_t)prefix.getPrefixLength(), strategy));
 }
 
 void HicnForwarderModule::closeConnection() {
-  auto command = createCommandDeleteConnection();
+#ifdef HICNLIGHT_MEMIF
+  if (memif_connector_) {
+    // A refused face name might belong to another application
+    if (memif_state_ == MemifState::CREATED) {
+      sendCommand(createCommandDeleteConnection(face_name_.c_str()));
+    }
+    memif_connector_->close();
+  }
+#endif
+
+  auto command = createCommandDeleteConnection(self_face_name);
   if (!command) {
     // TODO error
     return;
@@ -117,7 +217,7 @@ void HicnForwarderModule::closeConnection() {
     }
   });
 
-  send(command);
+  sendCommand(command);
 }
 
 void HicnForwarderModule::init(
@@ -126,6 +226,28 @@ void HicnForwarderModule::init(
     Connector::OnCloseCallback &&close_callback,
     Connector::OnReconnectCallback &&reconnect_callback,
     asio::io_service &io_service, const std::string &app_name) {
+#ifdef HICNLIGHT_MEMIF
+  // Both connectors deliver to the portal: the UDP one only carries the
+  // replies to control messages when memif is used.
+  if (!memif_connector_ &&
+      !forwarder_url_initializer_.getMemifSocket().empty()) {
+    static std::atomic<uint32_t> memif_count(0);
+
+    // The id of the memif interface has to be unique among the applications
+    // connected to the forwarder: the forwarder refuses a duplicated one, in
+    // which case another id is tried.
+    setMemifId(((uint32_t)getpid() << 4) + memif_count++);
+
+    auto receive = receive_callback;
+    auto sent = sent_callback;
+    auto close = close_callback;
+    auto reconnect = reconnect_callback;
+    memif_connector_ = std::make_shared<MemifConnector>(
+        std::move(receive), std::move(sent), std::move(close),
+        std::move(reconnect), io_service, app_name);
+  }
+#endif
+
   if (!connector_) {
     connector_.reset(new UdpTunnelConnector(
         io_service, std::move(receive_callback), std::move(sent_callback),
@@ -135,6 +257,16 @@ void HicnForwarderModule::init(
 
 void HicnForwarderModule::processControlMessageReply(
     utils::MemBuf &packet_buffer) {
+#ifdef HICNLIGHT_MEMIF
+  auto header = reinterpret_cast<const msg_header_t *>(packet_buffer.data());
+  if (memif_state_ == MemifState::PENDING &&
+      packet_buffer.length() >= sizeof(msg_header_t) &&
+      header->header.seq_num == memif_seq_) {
+    onMemifConnectionReply(header->header.message_type == ACK_LIGHT);
+    return;
+  }
+#endif
+
   if (packet_buffer.data()[0] == NACK_LIGHT) {
     throw errors::RuntimeException(
         "Received Nack message from hicn light forwarder.");
@@ -188,12 +320,57 @@ utils::MemBuf::Ptr HicnForwarderModule::createCommandRoute(
       break;
   }
   snprintf(command->payload.symbolic_or_connid, SYMBOLIC_NAME_LEN, "%s",
-           "SELF");
+           face_name_.c_str());
+
+  return ret;
+}
+
+#ifdef HICNLIGHT_MEMIF
+/**
+ * @return A connection add command for the memif face of this module. memif
+ * has no addresses: the forwarder takes the interface id from the remote port,
+ * and the local address identifies its memif listener.
+ */
+utils::MemBuf::Ptr HicnForwarderModule::createCommandMemifConnection() {
+  auto ret = PacketManager<>::getInstance().getMemBuf();
+  auto command = reinterpret_cast<msg_connection_add_t *>(ret->writableData());
+  ret->append(sizeof(msg_connection_add_t));
+  std::memset(command, 0, sizeof(*command));
+
+  utils::Uri uri;
+  uri.parse(forwarder_url_initializer_.getForwarderUrl());
+  uint16_t port = std::stoul(uri.getPort());
+
+  *command = {
+      .header =
+          {
+              .message_type = REQUEST_LIGHT,
+              .command_id = COMMAND_TYPE_CONNECTION_ADD,
+              .length = 1,
+              // Matched against the reply, never 0 as for route commands
+              .seq_num = ++seq_,
+          },
+      .payload =
+          {
+              .remote_port = (uint16_t)memif_id_,
+              .local_port = port,
+              .family = AF_INET,
+              .type = FACE_TYPE_MEMIF,
+              .admin_state = FACE_STATE_UP,
+          },
+  };
+
+  inet_pton(AF_INET, "127.0.0.1", &command->payload.remote_ip.v4.as_inaddr);
+  inet_pton(AF_INET, "127.0.0.1", &command->payload.local_ip.v4.as_inaddr);
+  snprintf(command->payload.symbolic, SYMBOLIC_NAME_LEN, "%s",
+           face_name_.c_str());
 
   return ret;
 }
+#endif
 
-utils::MemBuf::Ptr HicnForwarderModule::createCommandDeleteConnection() {
+utils::MemBuf::Ptr HicnForwarderModule::createCommandDeleteConnection(
+    const char *symbolic) {
   auto ret = PacketManager<>::getInstance().getMemBuf();
   auto command =
       reinterpret_cast<msg_connection_remove_t *>(ret->writableData());
@@ -211,7 +388,7 @@ utils::MemBuf::Ptr HicnForwarderModule::createCommandDeleteConnection() {
   };
 
   snprintf(command->payload.symbolic_or_connid, SYMBOLIC_NAME_LEN, "%s",
-           "SELF");
+           symbolic);
 
   return ret;
 }
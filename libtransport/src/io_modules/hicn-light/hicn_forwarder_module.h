@@ -30,9 +30,15 @@ namespace transport {
 namespace core {
 
 class UdpTunnelConnector;
+#ifdef HICNLIGHT_MEMIF
+class MemifConnector;
+#endif
 
 class HicnForwarderModule : public IoModule {
   static constexpr std::uint16_t interface_mtu = 1500;
+  static constexpr std::size_t memif_buffer_size = 2048;
+  static constexpr std::size_t memif_log2_ring_size = 10;
+  static constexpr unsigned memif_max_attempts = 16;
 
  public:
 #if 0
@@ -92,18 +98,39 @@ class HicnForwarderModule : public IoModule {
  private:
   utils::MemBuf::Ptr createCommandRoute(std::unique_ptr<sockaddr> &&addr,
                                         uint8_t prefix_length);
-  utils::MemBuf::Ptr createCommandDeleteConnection();
   utils::MemBuf::Ptr createCommandMapmeSendUpdate();
   utils::MemBuf::Ptr createCommandSetForwardingStrategy(
       std::unique_ptr<sockaddr> &&addr, uint32_t prefix_len,
       std::string strategy);
+#ifdef HICNLIGHT_MEMIF
+  utils::MemBuf::Ptr createCommandMemifConnection();
+  void setMemifId(uint32_t memif_id);
+  void sendMemifConnection();
+  void onMemifConnectionReply(bool ack);
+#endif
+  utils::MemBuf::Ptr createCommandDeleteConnection(const char *symbolic);
+  void sendCommand(const utils::MemBuf::Ptr &command);
 
   static void parseForwarderConfiguration(const libconfig::Setting &io_config,
                                           std::error_code &ec);
   static std::string initForwarderUrl();
 
  private:
+  /* Control messages, and packets unless a memif face is used */
   std::shared_ptr<UdpTunnelConnector> connector_;
+#ifdef HICNLIGHT_MEMIF
+  /* Packets, when a memif face towards the forwarder is configured */
+  std::shared_ptr<MemifConnector> memif_connector_;
+  uint32_t memif_id_;
+  /* The memif face is only joined once the forwarder has accepted its id */
+  enum class MemifState { IDLE, PENDING, CREATED } memif_state_;
+  /* Sequence number of the pending connection add command */
+  uint32_t memif_seq_;
+  unsigned memif_attempts_;
+  bool is_consumer_;
+#endif
+  /* Name of the forwarder connection towards which routes are added */
+  std::string face_name_;
   /* Sequence number used for sending control messages */
   uint32_t seq_;
 
@@ -113,7 +140,8 @@ class HicnForwarderModule : public IoModule {
 
    public:
     ForwarderUrlInitializer()
-        : forwarder_url_(ForwarderUrlInitializer::default_hicnlight_url) {
+        : forwarder_url_(ForwarderUrlInitializer::default_hicnlight_url),
+          memif_socket_() {
       using namespace std::placeholders;
       GlobalConfiguration::getInstance().registerConfigurationParser(
           ForwarderUrlInitializer::hicnlight_configuration_section,
@@ -122,6 +150,7 @@ class HicnForwarderModule : public IoModule {
     }
 
     std::string getForwarderUrl() { return forwarder_url_; }
+    std::string getMemifSocket() { return memif_socket_; }
 
    private:
     void parseForwarderConfiguration(const libconfig::Setting &forwarder_config,
@@ -134,10 +163,19 @@ class HicnForwarderModule : public IoModule {
         forwarder_config.lookupValue("forwarder_url", forwarder_url_);
         VLOG(1) << "Forwarder URL from config file: " << forwarder_url_;
       }
+
+      // memif socket of the forwarder, e.g. /run/hicn-light/memif.sock
+      if (forwarder_config.exists("memif_socket")) {
+        forwarder_config.lookupValue("memif_socket", memif_socket_);
+        VLOG(1) << "Forwarder memif socket from config file: "
+                << memif_socket_;
+      }
     }
 
     // Url of the forwarder
     std::string forwarder_url_;
+    // If not empty, packets are exchanged with the forwarder over memif
+    std::string memif_socket_;
   };
 
   static ForwarderUrlInitializer forwarder_url_initializer_;
@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <implementation/socket_consumer.h>
+#include <protocols/bbr.h>
+
+namespace transport {
+
+namespace protocol {
+
+using namespace interface;
+
+BbrTransportProtocol::BbrTransportProtocol(
+    implementation::ConsumerSocket *icn_socket)
+    : RaaqmTransportProtocol(icn_socket) {}
+
+BbrTransportProtocol::~BbrTransportProtocol() {}
+
+void BbrTransportProtocol::reset() {
+  RaaqmTransportProtocol::reset();
+
+  model_.reset(utils::SteadyTime::Clock::now());
+
+  increaseWindow();
+}
+
+void BbrTransportProtocol::increaseWindow() {
+  // The window is not increased additively but set from the model
+  double min_window_size = 0., max_window_size = 0.;
+  socket_->getSocketOption(GeneralTransportOptions::MIN_WINDOW_SIZE,
+                           min_window_size);
+  socket_->getSocketOption(GeneralTransportOptions::MAX_WINDOW_SIZE,
+                           max_window_size);
+
+  current_window_size_ = std::max(
+      min_window_size, std::min(max_window_size, model_.getWindow()));
+  socket_->setSocketOption(GeneralTransportOptions::CURRENT_WINDOW_SIZE,
+                           current_window_size_);
+}
+
+void BbrTransportProtocol::decreaseWindow() {
+  // Losses are not a congestion signal for the model
+}
+
+void BbrTransportProtocol::afterDataUnsatisfied(uint64_t segment) {
+  decreaseWindow();
+}
+
+void BbrTransportProtocol::afterContentReception(
+    const Interest &interest, const ContentObject &content_object) {
+  auto segment = content_object.getName().getSuffix();
+  auto now = utils::SteadyTime::Clock::now();
+  auto rtt = utils::SteadyTime::getDurationUs(
+      interest_timepoints_[segment & mask], now);
+
+  // Bytes received are counted for all data, including retransmitted ones
+  model_.onDataReceived(stats_->getBytesRecv(), send_states_[segment & mask],
+                        rtt, content_object.payloadSize(), interests_in_flight_,
+                        now);
+  increaseWindow();
+
+  // Update stats
+  updateStats(segment, rtt, now);
+}
+
+double BbrTransportProtocol::getPacingRate() {
+  // No estimation yet: the window alone limits the interests
+  if (model_.getPacketSize() == 0) {
+    return 0.;
+  }
+
+  return model_.getPacingRate() / model_.getPacketSize();
+}
+
+void BbrTransportProtocol::sendInterest(
+    const Name &interest_name,
+    std::array<uint32_t, MAX_AGGREGATED_INTEREST> *additional_suffixes,
+    uint32_t len) {
+  send_states_[interest_name.getSuffix() & mask] = model_.onInterestSent(
+      interests_in_flight_, utils::SteadyTime::Clock::now());
+  RaaqmTransportProtocol::sendInterest(interest_name, additional_suffixes,
+                                       len);
+}
+
+}  // end namespace protocol
+
+}  // end namespace transport
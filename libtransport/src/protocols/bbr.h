@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <protocols/bbr_model.h>
+#include <protocols/raaqm.h>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Model-based congestion control: the window and the interest rate follow the
+ * bottleneck bandwidth and the propagation delay estimated from the data
+ * received, instead of reacting to losses and delay variations. Interests are
+ * paced at the estimated rate, and retransmissions are handled as in RAAQM.
+ */
+class BbrTransportProtocol : public RaaqmTransportProtocol {
+ public:
+  BbrTransportProtocol(implementation::ConsumerSocket *icn_socket);
+
+  ~BbrTransportProtocol();
+
+  using RaaqmTransportProtocol::start;
+  using RaaqmTransportProtocol::stop;
+
+  void reset() override;
+
+ protected:
+  void increaseWindow() override;
+  void decreaseWindow() override;
+
+  void afterContentReception(const Interest &interest,
+                             const ContentObject &content_object) override;
+  void afterDataUnsatisfied(uint64_t segment) override;
+
+  double getPacingRate() override;
+  void sendInterest(const Name &interest_name,
+                    std::array<uint32_t, MAX_AGGREGATED_INTEREST>
+                        *additional_suffixes = nullptr,
+                    uint32_t len = 0) override;
+
+ private:
+  BbrModel model_;
+  std::array<BbrModel::SendState, buffer_size> send_states_;
+};
+
+}  // end namespace protocol
+
+}  // end namespace transport
@@ -0,0 +1,292 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <protocols/bbr_model.h>
+
+#include <algorithm>
+
+namespace transport {
+
+namespace protocol {
+
+namespace {
+// Probe for more bandwidth, drain the queue it may have created, then cruise
+constexpr double pacing_gain_cycle[BbrModel::gain_cycle_length] = {
+    1.25, 0.75, 1., 1., 1., 1., 1., 1.};
+
+constexpr double packet_size_alpha = 0.125;
+}  // namespace
+
+constexpr utils::SteadyTime::Milliseconds BbrModel::min_rtt_expiry;
+constexpr utils::SteadyTime::Milliseconds BbrModel::probe_rtt_duration;
+
+BbrModel::BbrModel() { reset(utils::SteadyTime::Clock::now()); }
+
+void BbrModel::reset(const utils::SteadyTime::TimePoint &now) {
+  window_ = initial_window;
+  packet_size_ = 0;
+
+  delivered_ = 0;
+  delivered_time_ = now;
+  round_count_ = 0;
+  next_round_delivered_ = 0;
+  round_start_ = false;
+
+  bandwidth_samples_.fill(0.);
+  bandwidth_round_ = 0;
+
+  min_rtt_ = utils::SteadyTime::Microseconds::max();
+  min_rtt_time_ = now;
+  min_rtt_expired_ = false;
+
+  filled_pipe_ = false;
+  full_bandwidth_ = 0;
+  full_bandwidth_count_ = 0;
+
+  cycle_index_ = 0;
+  cycle_time_ = now;
+
+  probe_rtt_done_time_ = utils::SteadyTime::TimePoint();
+  probe_rtt_round_done_ = false;
+  prior_window_ = 0;
+
+  enterStartup();
+}
+
+BbrModel::SendState BbrModel::onInterestSent(
+    uint64_t inflight, const utils::SteadyTime::TimePoint &now) {
+  // Do not count the idle time in the next delivery rate samples
+  if (inflight == 0) {
+    delivered_time_ = now;
+  }
+
+  return {delivered_, delivered_time_};
+}
+
+void BbrModel::onDataReceived(uint64_t delivered, const SendState &sent,
+                              const utils::SteadyTime::Microseconds &rtt,
+                              std::size_t packet_size, uint64_t inflight,
+                              const utils::SteadyTime::TimePoint &now) {
+  if (packet_size_ == 0) {
+    packet_size_ = double(packet_size);
+  } else {
+    packet_size_ = (1 - packet_size_alpha) * packet_size_ +
+                   packet_size_alpha * double(packet_size);
+  }
+
+  delivered_ = delivered;
+  delivered_time_ = now;
+
+  updateRound(sent);
+  updateBandwidth(sent, now);
+  updateGainCycle(inflight, now);
+  checkFullPipe();
+  checkDrain(inflight, now);
+  updateMinRtt(rtt, now);
+  checkProbeRtt(inflight, now);
+  updateWindow();
+}
+
+double BbrModel::getBottleneckBandwidth() const {
+  return *std::max_element(bandwidth_samples_.begin(),
+                           bandwidth_samples_.end());
+}
+
+double BbrModel::getBdp() const {
+  double bandwidth = getBottleneckBandwidth();
+  if (bandwidth == 0 || packet_size_ == 0 ||
+      min_rtt_ == utils::SteadyTime::Microseconds::max()) {
+    return initial_window;
+  }
+
+  return bandwidth * double(min_rtt_.count()) / 1e6 / packet_size_;
+}
+
+void BbrModel::updateRound(const SendState &sent) {
+  // A round ends when the data of an interest sent after its start is received
+  round_start_ = false;
+  if (sent.delivered >= next_round_delivered_) {
+    next_round_delivered_ = delivered_;
+    round_count_++;
+    round_start_ = true;
+  }
+}
+
+void BbrModel::updateBandwidth(const SendState &sent,
+                               const utils::SteadyTime::TimePoint &now) {
+  auto interval = utils::SteadyTime::getDurationUs(sent.delivered_time, now);
+  if (interval.count() == 0 || delivered_ <= sent.delivered) {
+    return;
+  }
+
+  // Move the window of the max filter, forgetting the rounds left behind
+  if (round_count_ != bandwidth_round_) {
+    uint64_t n = std::min<uint64_t>(round_count_ - bandwidth_round_,
+                                    bandwidth_filter_rounds);
+    for (uint64_t i = 1; i <= n; i++) {
+      bandwidth_samples_[(bandwidth_round_ + i) % bandwidth_filter_rounds] = 0;
+    }
+    bandwidth_round_ = round_count_;
+  }
+
+  double rate =
+      double(delivered_ - sent.delivered) * 1e6 / double(interval.count());
+  double &sample = bandwidth_samples_[round_count_ % bandwidth_filter_rounds];
+  sample = std::max(sample, rate);
+}
+
+void BbrModel::updateMinRtt(const utils::SteadyTime::Microseconds &rtt,
+                            const utils::SteadyTime::TimePoint &now) {
+  min_rtt_expired_ = now > min_rtt_time_ + min_rtt_expiry;
+  if (rtt <= min_rtt_ || min_rtt_expired_) {
+    min_rtt_ = rtt;
+    min_rtt_time_ = now;
+  }
+}
+
+void BbrModel::checkFullPipe() {
+  if (filled_pipe_ || !round_start_) {
+    return;
+  }
+
+  // The pipe is full when the bandwidth stops growing for a few rounds
+  double bandwidth = getBottleneckBandwidth();
+  if (bandwidth >= full_bandwidth_ * full_bandwidth_threshold) {
+    full_bandwidth_ = bandwidth;
+    full_bandwidth_count_ = 0;
+    return;
+  }
+
+  if (++full_bandwidth_count_ >= full_bandwidth_rounds) {
+    filled_pipe_ = true;
+  }
+}
+
+void BbrModel::updateGainCycle(uint64_t inflight,
+                               const utils::SteadyTime::TimePoint &now) {
+  if (state_ != State::PROBE_BW) {
+    return;
+  }
+
+  bool full_length =
+      utils::SteadyTime::getDurationUs(cycle_time_, now) > min_rtt_;
+  bool advance;
+  if (pacing_gain_ > 1) {
+    // Stay until the extra interests are in flight, or the window is full
+    advance = full_length && (inflight >= pacing_gain_ * getBdp() ||
+                              inflight >= uint64_t(window_));
+  } else if (pacing_gain_ < 1) {
+    advance = full_length || inflight <= getBdp();
+  } else {
+    advance = full_length;
+  }
+
+  if (advance) {
+    cycle_index_ = (cycle_index_ + 1) % gain_cycle_length;
+    cycle_time_ = now;
+    pacing_gain_ = pacing_gain_cycle[cycle_index_];
+  }
+}
+
+void BbrModel::checkDrain(uint64_t inflight,
+                          const utils::SteadyTime::TimePoint &now) {
+  if (state_ == State::STARTUP && filled_pipe_) {
+    state_ = State::DRAIN;
+    pacing_gain_ = drain_gain;
+    window_gain_ = high_gain;
+  }
+
+  if (state_ == State::DRAIN && inflight <= getBdp()) {
+    enterProbeBw(now);
+  }
+}
+
+void BbrModel::checkProbeRtt(uint64_t inflight,
+                             const utils::SteadyTime::TimePoint &now) {
+  if (state_ != State::PROBE_RTT && min_rtt_expired_) {
+    state_ = State::PROBE_RTT;
+    pacing_gain_ = 1.;
+    window_gain_ = 1.;
+    prior_window_ = window_;
+    probe_rtt_done_time_ = utils::SteadyTime::TimePoint();
+  }
+
+  if (state_ != State::PROBE_RTT) {
+    return;
+  }
+
+  // Hold the window at its minimum for a while, and at least one round
+  if (probe_rtt_done_time_ == utils::SteadyTime::TimePoint()) {
+    if (inflight <= min_window) {
+      probe_rtt_done_time_ = now + probe_rtt_duration;
+      probe_rtt_round_done_ = false;
+      next_round_delivered_ = delivered_;
+    }
+    return;
+  }
+
+  if (round_start_) {
+    probe_rtt_round_done_ = true;
+  }
+
+  if (probe_rtt_round_done_ && now > probe_rtt_done_time_) {
+    min_rtt_time_ = now;
+    window_ = std::max(window_, prior_window_);
+    if (filled_pipe_) {
+      enterProbeBw(now);
+    } else {
+      enterStartup();
+    }
+  }
+}
+
+void BbrModel::updateWindow() {
+  if (state_ == State::PROBE_RTT) {
+    window_ = std::min(window_, double(min_window));
+    return;
+  }
+
+  // Grow by one interest per data received (as in slow start) up to the target
+  double target = window_gain_ * getBdp();
+  if (filled_pipe_) {
+    window_ = std::min(window_ + 1, target);
+  } else if (window_ < target ||
+             delivered_ < initial_window * uint64_t(packet_size_)) {
+    window_ += 1;
+  }
+
+  window_ = std::max(window_, double(min_window));
+}
+
+void BbrModel::enterStartup() {
+  state_ = State::STARTUP;
+  pacing_gain_ = high_gain;
+  window_gain_ = high_gain;
+}
+
+void BbrModel::enterProbeBw(const utils::SteadyTime::TimePoint &now) {
+  state_ = State::PROBE_BW;
+  window_gain_ = cwnd_gain;
+
+  // Start from a pseudo-random phase other than the draining one, so that
+  // flows sharing a bottleneck do not probe at the same time
+  cycle_index_ = 2 + round_count_ % (gain_cycle_length - 2);
+  cycle_time_ = now;
+  pacing_gain_ = pacing_gain_cycle[cycle_index_];
+}
+
+}  // end namespace protocol
+
+}  // end namespace transport
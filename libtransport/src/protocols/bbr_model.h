@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/utils/chrono_typedefs.h>
+
+#include <array>
+#include <cstdint>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Model of the path used by the BBR protocol: bottleneck bandwidth (windowed
+ * max of the delivery rate over the last rounds) and propagation delay
+ * (windowed min of the RTT), and the state machine deciding how fast interests
+ * are paced and how many of them can be in flight.
+ */
+class BbrModel {
+ public:
+  enum class State { STARTUP, DRAIN, PROBE_BW, PROBE_RTT };
+
+  /**
+   * Delivery state when an interest is sent, used for computing the delivery
+   * rate when its data is received.
+   */
+  struct SendState {
+    uint64_t delivered;
+    utils::SteadyTime::TimePoint delivered_time;
+  };
+
+  // Gain used in startup for doubling the sending rate every round
+  static constexpr double high_gain = 2.885;
+  static constexpr double drain_gain = 1 / high_gain;
+  static constexpr double cwnd_gain = 2.;
+  static constexpr unsigned gain_cycle_length = 8;
+  static constexpr unsigned bandwidth_filter_rounds = 10;
+  static constexpr unsigned full_bandwidth_rounds = 3;
+  static constexpr double full_bandwidth_threshold = 1.25;
+  static constexpr uint32_t min_window = 4;       // Interests
+  static constexpr uint32_t initial_window = 10;  // Interests
+  static constexpr utils::SteadyTime::Milliseconds min_rtt_expiry{10000};
+  static constexpr utils::SteadyTime::Milliseconds probe_rtt_duration{200};
+
+  BbrModel();
+
+  void reset(const utils::SteadyTime::TimePoint &now);
+
+  /**
+   * Get the delivery state to save for an interest being sent.
+   *
+   * @param inflight Interests in flight, before this one is sent.
+   */
+  SendState onInterestSent(uint64_t inflight,
+                           const utils::SteadyTime::TimePoint &now);
+
+  /**
+   * Update the model with a data packet.
+   *
+   * @param delivered Bytes delivered since the beginning of the download.
+   * @param sent Delivery state when the interest was sent.
+   * @param rtt RTT of the interest (only for non-retransmitted interests).
+   * @param packet_size Size of the data packet.
+   * @param inflight Interests in flight, once the data has been received.
+   */
+  void onDataReceived(uint64_t delivered, const SendState &sent,
+                      const utils::SteadyTime::Microseconds &rtt,
+                      std::size_t packet_size, uint64_t inflight,
+                      const utils::SteadyTime::TimePoint &now);
+
+  State getState() const { return state_; }
+
+  // Bytes per second, 0 until the first delivery rate sample
+  double getBottleneckBandwidth() const;
+  double getPacingRate() const {
+    return pacing_gain_ * getBottleneckBandwidth();
+  }
+  double getPacingGain() const { return pacing_gain_; }
+
+  const utils::SteadyTime::Microseconds &getMinRtt() const { return min_rtt_; }
+
+  // Bandwidth delay product in interests
+  double getBdp() const;
+
+  double getWindow() const { return window_; }
+
+  double getPacketSize() const { return packet_size_; }
+
+ private:
+  void updateRound(const SendState &sent);
+  void updateBandwidth(const SendState &sent,
+                       const utils::SteadyTime::TimePoint &now);
+  void updateMinRtt(const utils::SteadyTime::Microseconds &rtt,
+                    const utils::SteadyTime::TimePoint &now);
+  void checkFullPipe();
+  void updateGainCycle(uint64_t inflight,
+                       const utils::SteadyTime::TimePoint &now);
+  void checkDrain(uint64_t inflight, const utils::SteadyTime::TimePoint &now);
+  void checkProbeRtt(uint64_t inflight,
+                     const utils::SteadyTime::TimePoint &now);
+  void updateWindow();
+  void enterStartup();
+  void enterProbeBw(const utils::SteadyTime::TimePoint &now);
+
+  State state_;
+  double pacing_gain_;
+  double window_gain_;
+  double window_;
+  double packet_size_;
+
+  // Delivery rate and round counting
+  uint64_t delivered_;
+  utils::SteadyTime::TimePoint delivered_time_;
+  uint64_t round_count_;
+  uint64_t next_round_delivered_;
+  bool round_start_;
+
+  // Max delivery rate of the last rounds, indexed by round
+  std::array<double, bandwidth_filter_rounds> bandwidth_samples_;
+  uint64_t bandwidth_round_;
+
+  // Min RTT and time it was measured
+  utils::SteadyTime::Microseconds min_rtt_;
+  utils::SteadyTime::TimePoint min_rtt_time_;
+  bool min_rtt_expired_;
+
+  // Startup exit
+  bool filled_pipe_;
+  double full_bandwidth_;
+  unsigned full_bandwidth_count_;
+
+  // Gain cycling in PROBE_BW
+  unsigned cycle_index_;
+  utils::SteadyTime::TimePoint cycle_time_;
+
+  // PROBE_RTT
+  utils::SteadyTime::TimePoint probe_rtt_done_time_;
+  bool probe_rtt_round_done_;
+  double prior_window_;
+};
+
+}  // end namespace protocol
+
+}  // end namespace transport
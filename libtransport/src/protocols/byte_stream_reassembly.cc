@@ -29,12 +29,20 @@ namespace protocol {
 using namespace core;
 using ReadCallback = interface::ConsumerSocket::ReadCallback;
 
+namespace {
+void releaseContentObject(void *buffer, void *content_object) {
+  delete static_cast<ContentObject::Ptr *>(content_object);
+}
+}  // namespace
+
 ByteStreamReassembly::ByteStreamReassembly(
     implementation::ConsumerSocket *icn_socket,
     TransportProtocol *transport_protocol)
     : Reassembly(icn_socket, transport_protocol),
       index_(Indexer::invalid_index),
-      download_complete_(false) {}
+      download_complete_(false),
+      chain_content_(false),
+      chain_length_(0) {}
 
 void ByteStreamReassembly::reassemble(ContentObject &content_object) {
   if (TRANSPORT_EXPECT_TRUE(read_buffer_->capacity())) {
@@ -59,14 +67,20 @@ void ByteStreamReassembly::assembleContent() {
 
   auto it = received_packets_.find((const unsigned int)index_);
   while (it != received_packets_.end()) {
+    // The packet is not kept once reassembled, even if it is the last one, so
+    // that a chained payload is released as soon as the application frees it
+    auto content_object = std::move(it->second);
+    received_packets_.erase(it);
+
     // Check if valid packet
-    if (it->second) {
-      if (TRANSPORT_EXPECT_FALSE(copyContent(*it->second))) {
+    if (content_object) {
+      bool done = chain_content_ ? chainContent(*content_object)
+                                 : copyContent(*content_object);
+      if (TRANSPORT_EXPECT_FALSE(done)) {
         return;
       }
     }
 
-    received_packets_.erase(it);
     index_ = indexer_verifier_->getNextReassemblySegment();
     it = received_packets_.find((const unsigned int)index_);
   }
@@ -116,11 +130,75 @@ bool ByteStreamReassembly::copyContent(ContentObject &content_object) {
   return ret;
 }
 
+bool ByteStreamReassembly::chainContent(ContentObject &content_object) {
+  bool ret = false;
+
+  content_object.trimStart(content_object.headerSize());
+
+  utils::MemBuf *current = &content_object;
+
+  do {
+    if (current->length()) {
+      // Each buffer of the chain keeps the packet alive until the application
+      // releases it
+      auto buffer = utils::MemBuf::takeOwnership(
+          current->writableData(), current->length(), current->length(),
+          releaseContentObject,
+          new ContentObject::Ptr(content_object.shared_from_this()));
+      chain_length_ += buffer->length();
+
+      if (chain_) {
+        chain_->prependChain(std::move(buffer));
+      } else {
+        chain_ = std::move(buffer);
+      }
+    }
+
+    current = current->next();
+  } while (current != &content_object);
+
+  download_complete_ = indexer_verifier_->getFinalSuffix() ==
+                       content_object.getName().getSuffix();
+
+  // The capacity of the read buffer is the amount of bytes to deliver at once
+  if (download_complete_ || chain_length_ >= read_buffer_->capacity()) {
+    notifyChain();
+  }
+
+  if (TRANSPORT_EXPECT_FALSE(download_complete_)) {
+    ret = download_complete_;
+    transport_protocol_->onContentReassembled(
+        make_error_code(protocol_error::success));
+  }
+
+  return ret;
+}
+
+void ByteStreamReassembly::notifyChain() {
+  ReadCallback *read_callback = nullptr;
+  reassembly_consumer_socket_->getSocketOption(
+      interface::ConsumerCallbacksOptions::READ_CALLBACK, &read_callback);
+
+  if (TRANSPORT_EXPECT_FALSE(!read_callback)) {
+    LOG(ERROR) << "Read callback not installed!";
+    return;
+  }
+
+  if (!chain_) {
+    chain_ = utils::MemBuf::create(0);
+  }
+
+  read_callback->readBufferAvailable(std::move(chain_));
+  chain_length_ = 0;
+}
+
 void ByteStreamReassembly::reInitialize() {
   index_ = Indexer::invalid_index;
   download_complete_ = false;
 
   received_packets_.clear();
+  chain_.reset();
+  chain_length_ = 0;
 
   // reset read buffer
   ReadCallback *read_callback;
@@ -129,6 +207,8 @@ void ByteStreamReassembly::reInitialize() {
     reassembly_consumer_socket_->getSocketOption(
         interface::ConsumerCallbacksOptions::READ_CALLBACK, &read_callback);
     read_buffer_ = utils::MemBuf::create(read_callback->maxBufferSize());
+    chain_content_ =
+        read_callback->isBufferMovable() && read_callback->isBufferChainable();
   }
 }
 
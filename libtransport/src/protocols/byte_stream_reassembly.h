@@ -33,15 +33,28 @@ class ByteStreamReassembly : public Reassembly {
 
   bool copyContent(core::ContentObject &content_object);
 
+  /**
+   * Append the payload of the content object to the chain delivered to the
+   * application, without copying it.
+   */
+  bool chainContent(core::ContentObject &content_object);
+
   virtual void reInitialize() override;
 
  private:
   void assembleContent();
 
+  void notifyChain();
+
  protected:
   std::unordered_map<std::uint32_t, core::ContentObject::Ptr> received_packets_;
   uint32_t index_;
   bool download_complete_;
+
+  // Payloads not yet delivered, when the application accepts chained buffers
+  bool chain_content_;
+  std::unique_ptr<utils::MemBuf> chain_;
+  std::size_t chain_length_;
 };
 
 }  // namespace protocol
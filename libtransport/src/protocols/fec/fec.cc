@@ -50,6 +50,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if (GF_BITS == 8) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define FEC_X86_SIMD
+#include <immintrin.h>
+#endif
+
 /**
  * XXX This disable a warning raising only in some platforms.
  * TODO Check if this warning is a mistake or it is a real bug:
@@ -155,6 +161,16 @@ static gf gf_mul_table[GF_SIZE + 1][GF_SIZE + 1];
 #define GF_MULC0(c) __gf_mulc_ = gf_mul_table[c]
 #define GF_ADDMULC(dst, x) dst ^= __gf_mulc_[x]
 
+#ifdef FEC_X86_SIMD
+/*
+ * Products of each constant by the low and high nibbles of a byte, used by
+ * the SIMD versions of addmul1(): c * x = c * (x & 0xf) ^ c * (x & 0xf0).
+ * A row fits in a register, and is indexed 16 or more bytes at a time with
+ * PSHUFB.
+ */
+alignas(16) static gf gf_mul_nibbles[GF_SIZE + 1][2][16];
+#endif
+
 static void init_mul_table() {
   int i, j;
   for (i = 0; i < GF_SIZE + 1; i++)
@@ -162,6 +178,14 @@ static void init_mul_table() {
       gf_mul_table[i][j] = gf_exp[modnn(gf_log[i] + gf_log[j])];
 
   for (j = 0; j < GF_SIZE + 1; j++) gf_mul_table[0][j] = gf_mul_table[j][0] = 0;
+
+#ifdef FEC_X86_SIMD
+  for (i = 0; i < GF_SIZE + 1; i++)
+    for (j = 0; j < 16; j++) {
+      gf_mul_nibbles[i][0][j] = gf_mul_table[i][j];
+      gf_mul_nibbles[i][1][j] = gf_mul_table[i][j << 4];
+    }
+#endif
 }
 #else /* GF_BITS > 8 */
 static inline gf gf_mul(x, y) {
@@ -281,7 +305,7 @@ static void generate_gf(void) {
  * Note that gcc on
  */
 #define addmul(dst, src, c, sz) \
-  if (c != 0) addmul1(dst, src, c, sz)
+  if (c != 0) addmul1_impl(dst, src, c, sz)
 
 #define UNROLL 16 /* 1, 4, 8, 16 */
 static void addmul1(gf *dst1, gf *src1, gf c, int sz) {
@@ -320,6 +344,114 @@ static void addmul1(gf *dst1, gf *src1, gf c, int sz) {
     GF_ADDMULC(*dst, *src);
 }
 
+#ifdef FEC_X86_SIMD
+/*
+ * SIMD versions of addmul1(), multiplying 16, 32 or 64 bytes at a time by
+ * looking up the products of their nibbles with PSHUFB. The remaining bytes
+ * are processed by addmul1().
+ */
+__attribute__((target("ssse3"))) static void addmul1_ssse3(gf *dst, gf *src,
+                                                            gf c, int sz) {
+  const __m128i lo = _mm_load_si128((const __m128i *)gf_mul_nibbles[c][0]);
+  const __m128i hi = _mm_load_si128((const __m128i *)gf_mul_nibbles[c][1]);
+  const __m128i mask = _mm_set1_epi8(0x0f);
+  int i = 0;
+
+  for (; i + 16 <= sz; i += 16) {
+    __m128i x = _mm_loadu_si128((const __m128i *)(src + i));
+    __m128i l = _mm_shuffle_epi8(lo, _mm_and_si128(x, mask));
+    __m128i h = _mm_shuffle_epi8(hi, _mm_and_si128(_mm_srli_epi64(x, 4), mask));
+    __m128i d = _mm_loadu_si128((const __m128i *)(dst + i));
+    _mm_storeu_si128((__m128i *)(dst + i),
+                     _mm_xor_si128(d, _mm_xor_si128(l, h)));
+  }
+
+  if (i < sz) addmul1(dst + i, src + i, c, sz - i);
+}
+
+__attribute__((target("avx2"))) static void addmul1_avx2(gf *dst, gf *src,
+                                                          gf c, int sz) {
+  const __m256i lo = _mm256_broadcastsi128_si256(
+      _mm_load_si128((const __m128i *)gf_mul_nibbles[c][0]));
+  const __m256i hi = _mm256_broadcastsi128_si256(
+      _mm_load_si128((const __m128i *)gf_mul_nibbles[c][1]));
+  const __m256i mask = _mm256_set1_epi8(0x0f);
+  int i = 0;
+
+  for (; i + 32 <= sz; i += 32) {
+    __m256i x = _mm256_loadu_si256((const __m256i *)(src + i));
+    __m256i l = _mm256_shuffle_epi8(lo, _mm256_and_si256(x, mask));
+    __m256i h = _mm256_shuffle_epi8(
+        hi, _mm256_and_si256(_mm256_srli_epi64(x, 4), mask));
+    __m256i d = _mm256_loadu_si256((const __m256i *)(dst + i));
+    _mm256_storeu_si256((__m256i *)(dst + i),
+                        _mm256_xor_si256(d, _mm256_xor_si256(l, h)));
+  }
+
+  if (i < sz) {
+    /* Avoid the penalty of switching to non-VEX SSE code */
+    _mm256_zeroupper();
+    addmul1_ssse3(dst + i, src + i, c, sz - i);
+  }
+}
+
+/*
+ * GCC 12 warns about the undefined vectors used internally by AVX-512
+ * intrinsics: https://gcc.gnu.org/bugzilla/show_bug.cgi?id=105593
+ */
+#ifndef __clang__
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+__attribute__((target("avx512f,avx512bw"))) static void addmul1_avx512(
+    gf *dst, gf *src, gf c, int sz) {
+  const __m512i lo = _mm512_broadcast_i32x4(
+      _mm_load_si128((const __m128i *)gf_mul_nibbles[c][0]));
+  const __m512i hi = _mm512_broadcast_i32x4(
+      _mm_load_si128((const __m128i *)gf_mul_nibbles[c][1]));
+  const __m512i mask = _mm512_set1_epi8(0x0f);
+  int i = 0;
+
+  for (; i + 64 <= sz; i += 64) {
+    __m512i x = _mm512_loadu_si512((const void *)(src + i));
+    __m512i l = _mm512_shuffle_epi8(lo, _mm512_and_si512(x, mask));
+    __m512i h = _mm512_shuffle_epi8(
+        hi, _mm512_and_si512(_mm512_srli_epi64(x, 4), mask));
+    __m512i d = _mm512_loadu_si512((const void *)(dst + i));
+    _mm512_storeu_si512((void *)(dst + i),
+                        _mm512_xor_si512(d, _mm512_xor_si512(l, h)));
+  }
+
+  if (i < sz) addmul1_avx2(dst + i, src + i, c, sz - i);
+}
+#ifndef __clang__
+#pragma GCC diagnostic pop
+#endif
+#endif
+
+typedef void (*addmul1_fn)(gf *dst, gf *src, gf c, int sz);
+
+static const struct {
+  const char *name;
+  addmul1_fn fn;
+} fec_impls[FEC_IMPL_N] = {
+    /* Same order as fec_impl_t */
+    {"scalar", addmul1},
+#ifdef FEC_X86_SIMD
+    {"ssse3", addmul1_ssse3},
+    {"avx2", addmul1_avx2},
+    {"avx512", addmul1_avx512},
+#else
+    {"ssse3", NULL},
+    {"avx2", NULL},
+    {"avx512", NULL},
+#endif
+};
+
+static fec_impl_t fec_impl = FEC_IMPL_SCALAR;
+static addmul1_fn addmul1_impl = addmul1;
+
 /*
  * computes C = AB where A is n*k, B is k*m, C is n*m
  */
@@ -532,13 +664,62 @@ int invert_vdm(gf *src, int k) {
   return 0;
 }
 
+int fec_impl_supported(fec_impl_t impl) {
+  if (impl < 0 || impl >= FEC_IMPL_N || fec_impls[impl].fn == NULL) return 0;
+
+#ifdef FEC_X86_SIMD
+  __builtin_cpu_init();
+  switch (impl) {
+    case FEC_IMPL_SSSE3:
+      return __builtin_cpu_supports("ssse3");
+    case FEC_IMPL_AVX2:
+      return __builtin_cpu_supports("avx2");
+    case FEC_IMPL_AVX512:
+      return __builtin_cpu_supports("avx512f") &&
+             __builtin_cpu_supports("avx512bw");
+    default:
+      break;
+  }
+#endif
+
+  return 1;
+}
+
+const char *fec_impl_name(fec_impl_t impl) {
+  if (impl < 0 || impl >= FEC_IMPL_N) return "unknown";
+  return fec_impls[impl].name;
+}
+
 static int fec_initialized = 0;
 static void init_fec() {
+  int impl;
+
   generate_gf();
   init_mul_table();
+
+  /* Select the fastest implementation supported by the CPU */
+  for (impl = FEC_IMPL_N - 1; impl > FEC_IMPL_SCALAR; impl--)
+    if (fec_impl_supported((fec_impl_t)impl)) break;
+  fec_impl = (fec_impl_t)impl;
+  addmul1_impl = fec_impls[impl].fn;
+
   fec_initialized = 1;
 }
 
+int fec_set_impl(fec_impl_t impl) {
+  if (!fec_impl_supported(impl)) return -1;
+  if (fec_initialized == 0) init_fec();
+
+  fec_impl = impl;
+  addmul1_impl = fec_impls[impl].fn;
+  return 0;
+}
+
+fec_impl_t fec_get_impl(void) {
+  if (fec_initialized == 0) init_fec();
+  return fec_impl;
+}
+
 /*
  * This section contains the proper FEC encoding/decoding routines.
  * The encoding matrix is computed starting with a Vandermonde matrix,
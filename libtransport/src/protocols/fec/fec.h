@@ -56,6 +56,24 @@ struct fec_parms {
   gf *enc_matrix;
 };
 
+/*
+ * Implementations of the multiply-accumulate kernel used for encoding and
+ * decoding. By default, the fastest one supported by the CPU is used.
+ */
+typedef enum {
+  FEC_IMPL_SCALAR,
+  FEC_IMPL_SSSE3,
+  FEC_IMPL_AVX2,
+  FEC_IMPL_AVX512,
+  FEC_IMPL_N,
+} fec_impl_t;
+
+int fec_impl_supported(fec_impl_t impl);
+/* Returns -1 if the implementation is not supported by the CPU */
+int fec_set_impl(fec_impl_t impl);
+fec_impl_t fec_get_impl(void);
+const char *fec_impl_name(fec_impl_t impl);
+
 void fec_free(struct fec_parms *p);
 struct fec_parms *fec_new(int k, int n);
 
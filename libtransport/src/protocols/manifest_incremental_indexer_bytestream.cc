@@ -80,12 +80,13 @@ void ManifestIncrementalIndexer::processTrustedManifest(
       suffix_strategy_->setFinalSuffix(
           manifest.getParamsBytestream().final_segment);
 
-      // The packets to verify with the received manifest
-      std::vector<auth::PacketPtr> packets;
-
       // Convert the received manifest to a map of packet suffixes to hashes
       auth::Verifier::SuffixMap suffix_map = manifest.getSuffixMap();
 
+      // The packets to verify with the received manifest
+      std::vector<auth::PacketPtr> packets;
+      packets.reserve(suffix_map.size());
+
       // Update 'suffix_map_' with new hashes from the received manifest and
       // build 'packets'
       for (auto it = suffix_map.begin(); it != suffix_map.end();) {
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <protocols/pacer.h>
+
+#include <algorithm>
+#include <cmath>
+
+namespace transport {
+
+namespace protocol {
+
+Pacer::Pacer() : burst_(0), credit_(0) {}
+
+void Pacer::reset(uint32_t burst, const utils::SteadyTime::TimePoint &now) {
+  // A burst can be sent right away
+  burst_ = burst;
+  credit_ = burst;
+  time_ = now;
+}
+
+bool Pacer::take(double rate, double needed,
+                 const utils::SteadyTime::TimePoint &now,
+                 utils::SteadyTime::TimePoint &deadline) {
+  if (burst_ == 0 || rate <= 0) {
+    return true;
+  }
+
+  // The credit grows with the time elapsed, up to one burst
+  double elapsed = std::chrono::duration<double>(now - time_).count();
+  credit_ = std::min(double(burst_), credit_ + elapsed * rate);
+  time_ = now;
+
+  if (credit_ >= 1) {
+    credit_ -= 1;
+    return true;
+  }
+
+  // Wait for the credit of the interests to send, up to a whole burst, so
+  // that they leave together without delaying a window smaller than a burst
+  double batch = std::min(double(burst_), std::max(1., std::ceil(needed)));
+  deadline = now + std::chrono::duration_cast<utils::SteadyTime::Clock::duration>(
+                       std::chrono::duration<double>((batch - credit_) / rate));
+  return false;
+}
+
+}  // end namespace protocol
+
+}  // end namespace transport
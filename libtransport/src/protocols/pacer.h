@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/utils/chrono_typedefs.h>
+
+#include <cstdint>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Credit based pacing of interests: the credit grows with the time elapsed at
+ * the pacing rate, up to one burst, and each interest takes one credit. When
+ * the credit is exhausted, the interests are sent again once enough credit
+ * has grown for a batch of them.
+ */
+class Pacer {
+ public:
+  Pacer();
+
+  void reset(uint32_t burst, const utils::SteadyTime::TimePoint &now);
+
+  /**
+   * Take the credit of one interest.
+   *
+   * @param rate Pacing rate, in interests per second.
+   * @param needed Interests the caller has to send, including this one.
+   * @param deadline Set when false is returned, to the time at which the
+   * credit for min(burst, needed) interests is available.
+   */
+  bool take(double rate, double needed, const utils::SteadyTime::TimePoint &now,
+            utils::SteadyTime::TimePoint &deadline);
+
+  uint32_t getBurst() const { return burst_; }
+
+  double getCredit() const { return credit_; }
+
+ private:
+  uint32_t burst_;
+  double credit_;
+  utils::SteadyTime::TimePoint time_;
+};
+
+}  // end namespace protocol
+
+}  // end namespace transport
@@ -63,6 +63,11 @@ uint32_t ByteStreamProductionProtocol::produceStream(
     return 0;
   }
 
+  // The signing pipeline only exists while the protocol is started
+  if (TRANSPORT_EXPECT_FALSE(!signing_pipeline_)) {
+    return 0;
+  }
+
   // Total size of the data packet
   uint32_t data_packet_size;
   socket_->getSocketOption(GeneralTransportOptions::DATA_PACKET_SIZE,
@@ -153,7 +158,6 @@ uint32_t ByteStreamProductionProtocol::produceStream(
     manifest->getPacket()->setLifetime(content_object_expiry_time);
   }
 
-  auto self = shared_from_this();
   for (unsigned int packaged_segments = 0; packaged_segments < nb_segments;
        packaged_segments++) {
     if (manifest_max_capacity_) {
@@ -162,24 +166,23 @@ uint32_t ByteStreamProductionProtocol::produceStream(
         auto manifest_co =
             std::dynamic_pointer_cast<ContentObject>(manifest->getPacket());
 
-        signer_->signPacket(manifest_co.get());
-
-        // Send the current manifest
-        passContentObjectToCallbacks(manifest_co, self);
+        // Send the current manifest. Once submitted, the manifest may be
+        // modified by a signing thread.
         DLOG_IF(INFO, VLOG_IS_ON(3))
             << "Send manifest " << manifest_co->getName();
+        signing_pipeline_->submit(manifest_co);
 
         // Send content objects stored in the queue
         while (!content_queue_.empty()) {
-          passContentObjectToCallbacks(content_queue_.front(), self);
+          signing_pipeline_->submit(content_queue_.front(), false);
           DLOG_IF(INFO, VLOG_IS_ON(3))
               << "Send content " << content_queue_.front()->getName();
           content_queue_.pop();
         }
 
         // Create new manifest. The reference to the last manifest has been
-        // acquired in the passContentObjectToCallbacks function, so we can
-        // safely release this reference.
+        // acquired by the signing pipeline, so we can safely release this
+        // reference.
         manifest = ContentObjectManifest::createContentManifest(
             manifest_format,
             name.setSuffix(suffix_strategy->getNextManifestSuffix()),
@@ -229,10 +232,9 @@ uint32_t ByteStreamProductionProtocol::produceStream(
       manifest->addEntry(content_suffix, hash);
       content_queue_.push(content_object);
     } else {
-      signer_->signPacket(content_object.get());
-      passContentObjectToCallbacks(content_object, self);
       DLOG_IF(INFO, VLOG_IS_ON(3))
           << "Send content " << content_object->getName();
+      signing_pipeline_->submit(content_object);
     }
   }
 
@@ -246,19 +248,21 @@ uint32_t ByteStreamProductionProtocol::produceStream(
     auto manifest_co =
         std::dynamic_pointer_cast<ContentObject>(manifest->getPacket());
 
-    signer_->signPacket(manifest_co.get());
-
-    passContentObjectToCallbacks(manifest_co, self);
     DLOG_IF(INFO, VLOG_IS_ON(3)) << "Send manifest " << manifest_co->getName();
+    signing_pipeline_->submit(manifest_co);
 
     while (!content_queue_.empty()) {
-      passContentObjectToCallbacks(content_queue_.front(), self);
+      signing_pipeline_->submit(content_queue_.front(), false);
       DLOG_IF(INFO, VLOG_IS_ON(3))
           << "Send content " << content_queue_.front()->getName();
       content_queue_.pop();
     }
   }
 
+  // Wait for the signatures, so that all the objects are in the queue
+  signing_pipeline_->flush();
+
+  auto self = shared_from_this();
   portal_->getThread().add([this, self]() {
     std::shared_ptr<ContentObject> co;
     while (object_queue_for_callbacks_.pop(co)) {
@@ -292,9 +296,16 @@ uint32_t ByteStreamProductionProtocol::produceStream(
   return suffix_strategy->getTotalCount();
 }
 
-void ByteStreamProductionProtocol::scheduleSendBurst(
-    const std::shared_ptr<ByteStreamProductionProtocol> &self) {
+void ByteStreamProductionProtocol::scheduleSendBurst() {
+  // Called from a signing thread, possibly while the protocol is being
+  // destroyed, when shared_from_this() would throw
+  std::weak_ptr<ProductionProtocol> self = weak_from_this();
   portal_->getThread().add([this, self]() {
+    auto sp = self.lock();
+    if (!sp) {
+      return;
+    }
+
     ContentObject::Ptr co;
 
     for (uint32_t i = 0; i < burst_size; i++) {
@@ -326,13 +337,12 @@ void ByteStreamProductionProtocol::scheduleSendBurst(
   });
 }
 
-void ByteStreamProductionProtocol::passContentObjectToCallbacks(
-    const std::shared_ptr<ContentObject> &content_object,
-    const std::shared_ptr<ByteStreamProductionProtocol> &self) {
-  object_queue_for_callbacks_.push(std::move(content_object));
+void ByteStreamProductionProtocol::onContentObjectSigned(
+    const std::shared_ptr<ContentObject> &content_object) {
+  object_queue_for_callbacks_.push(content_object);
 
   if (object_queue_for_callbacks_.size() >= burst_size) {
-    scheduleSendBurst(self);
+    scheduleSendBurst();
   }
 }
 
@@ -56,13 +56,13 @@ class ByteStreamProductionProtocol : public ProductionProtocol {
   // Consumer Callback
   //   void reset() override;
   void onInterest(core::Interest &i) override;
+  // Objects leaving the signing pipeline are queued for the portal thread,
+  // which sends them in bursts.
+  void onContentObjectSigned(
+      const std::shared_ptr<ContentObject> &content_object) override;
 
  private:
-  void passContentObjectToCallbacks(
-      const std::shared_ptr<ContentObject> &content_object,
-      const std::shared_ptr<ByteStreamProductionProtocol> &self);
-  void scheduleSendBurst(
-      const std::shared_ptr<ByteStreamProductionProtocol> &self);
+  void scheduleSendBurst();
 
  private:
   // While manifests are being built, contents are stored in a queue
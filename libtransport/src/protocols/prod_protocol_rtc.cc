@@ -64,7 +64,7 @@ RTCProductionProtocol::RTCProductionProtocol(
   setOutputBufferSize(10000);
 }
 
-RTCProductionProtocol::~RTCProductionProtocol() {}
+RTCProductionProtocol::~RTCProductionProtocol() { stopSigning(); }
 
 void RTCProductionProtocol::setProducerParam() {
   // Flow name: here we assume there is only one prefix registered in the portal
@@ -481,20 +481,10 @@ void RTCProductionProtocol::producePktInternal(
     fec_encoder_->onPacketProduced(*content_object, offset, metadata);
   }
 
-  output_buffer_.insert(content_object);
-
-  if (*on_content_object_in_output_buffer_) {
-    on_content_object_in_output_buffer_->operator()(*socket_->getInterface(),
-                                                    *content_object);
-  }
-
+  // The packet is put in the output buffer once signed, and is not touched
+  // after being submitted to the signing pipeline.
   // TODO we may want to send FEC only if an interest is pending in the pit in
-  sendContentObject(content_object, false, fec);
-
-  if (*on_content_object_output_) {
-    on_content_object_output_->operator()(*socket_->getInterface(),
-                                          *content_object);
-  }
+  sendContentObject(std::move(content_object), false, fec);
 
   if (!fec) last_produced_data_ts_ = now;
 
@@ -600,10 +590,16 @@ void RTCProductionProtocol::onInterest(Interest &interest) {
                                                 *content_object);
         }
 
+        // The output buffer only holds signed packets, and the path label is
+        // not covered by the signature
         DLOG_IF(INFO, VLOG_IS_ON(3))
             << "Send content %u (onInterest) " << content_object->getName();
         content_object->setPathLabel(cache_label_);
-        sendContentObject(content_object);
+        portal_->sendContentObject(*content_object);
+      } else if (signing_.count(name.getSuffix())) {
+        // The packet is being signed, and will satisfy the interest once sent
+        DLOG_IF(INFO, VLOG_IS_ON(3))
+            << "Content " << name << " is being signed";
       } else {
         if (*on_interest_process_) {
           on_interest_process_->operator()(*socket_->getInterface(), interest);
@@ -654,11 +650,6 @@ void RTCProductionProtocol::sendManifestProbe(uint32_t sequence) {
   manifest_probe_co->setPathLabel(prod_label_);
   manifest_probe->encode();
 
-  if (*on_content_object_output_) {
-    on_content_object_output_->operator()(*socket_->getInterface(),
-                                          *manifest_probe_co);
-  }
-
   DLOG_IF(INFO, VLOG_IS_ON(3)) << "Send init probe " << sequence;
   sendContentObject(manifest_probe_co, true, false);
 }
@@ -682,10 +673,6 @@ void RTCProductionProtocol::sendNack(uint32_t sequence) {
   nack->setLifetime(0);
   nack->setPathLabel(prod_label_);
 
-  if (*on_content_object_output_) {
-    on_content_object_output_->operator()(*socket_->getInterface(), *nack);
-  }
-
   DLOG_IF(INFO, VLOG_IS_ON(3)) << "Send nack " << sequence;
   sendContentObject(nack, true, false);
 }
@@ -694,11 +681,6 @@ void RTCProductionProtocol::sendContentObject(
     std::shared_ptr<ContentObject> content_object, bool nack, bool fec) {
   bool is_ah = HICN_PACKET_FORMAT_IS_AH(content_object->getFormat());
 
-  // Compute signature
-  if (is_ah) {
-    signer_->signPacket(content_object.get());
-  }
-
   // Compute and save data packet digest
   if (manifest_max_capacity_ && !is_ah) {
     auth::CryptoHashType hash_algo;
@@ -708,7 +690,50 @@ void RTCProductionProtocol::sendContentObject(
                             content_object->computeDigest(hash_algo)});
   }
 
+  // Everything but nacks and probes goes to the output buffer once signed
+  if (!nack) {
+    signing_[content_object->getName().getSuffix()] = content_object;
+  }
+
+  // Packets with an AH are signed before being sent
+  signing_pipeline_->submit(std::move(content_object), is_ah);
+}
+
+void RTCProductionProtocol::onContentObjectSigned(
+    const ContentObject::Ptr &content_object) {
+  // Packets signed by a signing thread are sent from the portal thread. This
+  // may happen while the protocol is being destroyed, when shared_from_this()
+  // would throw.
+  std::weak_ptr<ProductionProtocol> self = weak_from_this();
+  portal_->getThread().tryRunHandlerNow([this, self, content_object]() {
+    auto sp = self.lock();
+    if (sp && isRunning()) {
+      onContentObjectReleased(content_object);
+    }
+  });
+}
+
+void RTCProductionProtocol::onContentObjectReleased(
+    const ContentObject::Ptr &content_object) {
+  auto it = signing_.find(content_object->getName().getSuffix());
+  bool cache = it != signing_.end() && it->second == content_object;
+
+  if (cache) {
+    signing_.erase(it);
+    output_buffer_.insert(content_object);
+
+    if (*on_content_object_in_output_buffer_) {
+      on_content_object_in_output_buffer_->operator()(*socket_->getInterface(),
+                                                      *content_object);
+    }
+  }
+
   portal_->sendContentObject(*content_object);
+
+  if (*on_content_object_output_) {
+    on_content_object_output_->operator()(*socket_->getInterface(),
+                                          *content_object);
+  }
 }
 
 void RTCProductionProtocol::onFecPackets(fec::BufferArray &packets) {
@@ -22,6 +22,7 @@
 #include <atomic>
 #include <map>
 #include <mutex>
+#include <unordered_map>
 
 namespace transport {
 namespace protocol {
@@ -65,6 +66,9 @@ class RTCProductionProtocol : public ProductionProtocol {
   void sendNack(uint32_t sequence);
   void sendContentObject(std::shared_ptr<ContentObject> content_object,
                          bool nac = false, bool fec = false);
+  void onContentObjectSigned(const ContentObject::Ptr &content_object) override;
+  // Publish a signed packet, on the portal thread
+  void onContentObjectReleased(const ContentObject::Ptr &content_object);
 
   // manifests
   void sendManifestProbe(uint32_t sequence);
@@ -123,6 +127,10 @@ class RTCProductionProtocol : public ProductionProtocol {
   // of the new rate.
   bool allow_delayed_nacks_;
 
+  // Packets in the signing pipeline, by suffix, to be put in the output buffer
+  // once signed
+  std::unordered_map<uint32_t, ContentObject::Ptr> signing_;
+
   // Save FEC packets here before sending them
   std::queue<ContentObject::Ptr> pending_fec_packets_;
   std::queue<std::pair<uint64_t, ContentObject::Ptr>> paced_fec_packets_;
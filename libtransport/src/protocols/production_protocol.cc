@@ -81,6 +81,15 @@ int ProductionProtocol::start() {
     socket_->getSocketOption(GeneralTransportOptions::MANIFEST_MAX_CAPACITY,
                              manifest_max_capacity_);
 
+    uint32_t signing_threads;
+    socket_->getSocketOption(GeneralTransportOptions::SIGNING_THREADS,
+                             signing_threads);
+    signing_pipeline_ = std::make_unique<SigningPipeline>(
+        signing_threads, signer_,
+        [this](const ContentObject::Ptr &content_object) {
+          onContentObjectSigned(content_object);
+        });
+
     std::string fec_type_str = "";
     socket_->getSocketOption(GeneralTransportOptions::FEC_TYPE, fec_type_str);
     if (fec_type_str != "") {
@@ -96,6 +105,18 @@ int ProductionProtocol::start() {
   return 0;
 }
 
+void ProductionProtocol::stop() {
+  portal_->getThread().addAndWaitForExecution([this]() { stopSigning(); });
+  Protocol::stop();
+}
+
+void ProductionProtocol::stopSigning() {
+  if (signing_pipeline_) {
+    signing_pipeline_->flush();
+    signing_pipeline_.reset();
+  }
+}
+
 void ProductionProtocol::produce(ContentObject &content_object) {
   auto content_object_ptr = content_object.shared_from_this();
   portal_->getThread().add([this, co = std::move(content_object_ptr)]() {
@@ -23,6 +23,7 @@
 #include <protocols/fec_base.h>
 #include <protocols/fec_utils.h>
 #include <protocols/protocol.h>
+#include <protocols/signing_pipeline.h>
 #include <utils/content_store.h>
 
 #include <atomic>
@@ -42,7 +43,7 @@ class ProductionProtocol
   virtual ~ProductionProtocol();
 
   virtual int start();
-  using Protocol::stop;
+  void stop() override;
 
   virtual void setProducerParam(){};
 
@@ -70,6 +71,15 @@ class ProductionProtocol
   virtual void onInterest(core::Interest &i) override = 0;
   virtual void onError(const std::error_code &ec) override;
 
+  // Called, in production order, with the content objects leaving the
+  // signing pipeline. This may happen on a signing thread.
+  virtual void onContentObjectSigned(const ContentObject::Ptr &content_object) {
+  }
+
+  // Wait for the pending signatures and stop the signing threads. Derived
+  // classes call it in their destructor, before their members are destroyed.
+  void stopSigning();
+
   template <typename FECHandler, typename AllocatorHandler>
   void enableFEC(FECHandler &&fec_handler,
                  AllocatorHandler &&allocator_handler) {
@@ -124,6 +134,7 @@ class ProductionProtocol
 
   // Signature and manifest
   std::shared_ptr<auth::Signer> signer_;
+  std::unique_ptr<SigningPipeline> signing_pipeline_;
   uint32_t manifest_max_capacity_;
 
   bool is_async_;
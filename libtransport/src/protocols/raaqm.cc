@@ -36,6 +36,7 @@ RaaqmTransportProtocol::RaaqmTransportProtocol(
       current_window_size_(1),
       interests_in_flight_(0),
       cur_path_(nullptr),
+      multipath_(false),
       t0_(utils::SteadyTime::Clock::now()),
       rate_estimator_(nullptr),
       dis_(0, 1.0),
@@ -119,6 +120,17 @@ void RaaqmTransportProtocol::reset() {
     cur_path_ = cur_path.get();
     path_table_[default_values::path_id] = std::move(cur_path);
   }
+
+  // The paths keep their window across sessions, but not their statistics
+  socket_->getSocketOption(RaaqmTransportOptions::MULTIPATH, multipath_);
+  for (auto &path : path_table_) {
+    path.second->resetStats();
+  }
+
+  // New paths start from the window of the default one
+  if (multipath_) {
+    path_table_.at(default_values::path_id)->setWindow(current_window_size_);
+  }
 }
 
 void RaaqmTransportProtocol::increaseWindow() {
@@ -130,7 +142,14 @@ void RaaqmTransportProtocol::increaseWindow() {
     double gamma = 0.;
     socket_->getSocketOption(RaaqmTransportOptions::GAMMA_VALUE, gamma);
 
-    current_window_size_ += gamma / current_window_size_;
+    if (multipath_) {
+      // Only the path of the data received grows
+      double window = cur_path_->getWindow();
+      cur_path_->setWindow(window + gamma / window);
+      updateMultipathWindow();
+    } else {
+      current_window_size_ += gamma / current_window_size_;
+    }
     socket_->setSocketOption(GeneralTransportOptions::CURRENT_WINDOW_SIZE,
                              current_window_size_);
   }
@@ -142,7 +161,14 @@ void RaaqmTransportProtocol::decreaseWindow() {
   double min_window_size = 0.;
   socket_->getSocketOption(GeneralTransportOptions::MIN_WINDOW_SIZE,
                            min_window_size);
-  if (current_window_size_ > min_window_size) {
+  if (multipath_) {
+    // Only the path whose RTT reveals congestion shrinks
+    if (decreasePathWindow(*cur_path_, min_window_size)) {
+      updateMultipathWindow();
+      socket_->setSocketOption(GeneralTransportOptions::CURRENT_WINDOW_SIZE,
+                               current_window_size_);
+    }
+  } else if (current_window_size_ > min_window_size) {
     double beta = 0.;
     socket_->getSocketOption(RaaqmTransportOptions::BETA_VALUE, beta);
 
@@ -157,9 +183,41 @@ void RaaqmTransportProtocol::decreaseWindow() {
   rate_estimator_->onWindowDecrease(current_window_size_);
 }
 
+bool RaaqmTransportProtocol::decreasePathWindow(RaaqmDataPath &path,
+                                                double min_window_size) {
+  if (path.getWindow() <= min_window_size) {
+    return false;
+  }
+
+  double beta = 0.;
+  socket_->getSocketOption(RaaqmTransportOptions::BETA_VALUE, beta);
+  path.setWindow(std::max(min_window_size, path.getWindow() * beta));
+  return true;
+}
+
 void RaaqmTransportProtocol::afterDataUnsatisfied(uint64_t segment) {
-  // Decrease the window because the timeout happened
-  decreaseWindow();
+  if (!multipath_) {
+    // Decrease the window because the timeout happened
+    decreaseWindow();
+    return;
+  }
+
+  // Interests carry no path label, so the path which lost the interest is
+  // unknown: all the paths shrink, as the window would in single path mode
+  double min_window_size = 0.;
+  socket_->getSocketOption(GeneralTransportOptions::MIN_WINDOW_SIZE,
+                           min_window_size);
+  bool decreased = false;
+  for (auto &path : path_table_) {
+    decreased |= decreasePathWindow(*path.second, min_window_size);
+  }
+
+  if (decreased) {
+    updateMultipathWindow();
+    socket_->setSocketOption(GeneralTransportOptions::CURRENT_WINDOW_SIZE,
+                             current_window_size_);
+  }
+  rate_estimator_->onWindowDecrease(current_window_size_);
 }
 
 void RaaqmTransportProtocol::afterContentReception(
@@ -437,6 +495,21 @@ void RaaqmTransportProtocol::onInterestTimeout(Interest::Ptr &interest,
   }
 }
 
+double RaaqmTransportProtocol::getPacingRate() {
+  double pacing_rate = TransportProtocol::getPacingRate();
+  if (pacing_rate > 0) {
+    return pacing_rate;
+  }
+
+  // Spread the window over the RTT, once it has been measured
+  double rtt = stats_->getAverageRtt();
+  if (rtt <= 0) {
+    return 0.;
+  }
+
+  return pacing_gain * current_window_size_ * 1000. / rtt;
+}
+
 void RaaqmTransportProtocol::scheduleNextInterests() {
   bool cancel = (!isRunning() && !is_first_) || !schedule_interests_;
   if (TRANSPORT_EXPECT_FALSE(cancel)) {
@@ -459,7 +532,8 @@ void RaaqmTransportProtocol::scheduleNextInterests() {
   uint32_t index = IndexManager::invalid_index;
 
   // Send the interest needed for filling the window
-  while (interests_in_flight_ < current_window_size_) {
+  while (interests_in_flight_ < current_window_size_ &&
+         paceInterest(current_window_size_ - interests_in_flight_)) {
     if (interest_to_retransmit_.size() > 0) {
       auto suffix = interest_to_retransmit_.front();
       sendInterest(name->setSuffix(suffix));
@@ -482,6 +556,9 @@ void RaaqmTransportProtocol::scheduleNextInterests() {
 
 void RaaqmTransportProtocol::onContentReassembled(const std::error_code &ec) {
   rate_estimator_->onDownloadFinished();
+  if (multipath_) {
+    exportPathStatistics();
+  }
   TransportProtocol::onContentReassembled(ec);
   schedule_interests_ = false;
 }
@@ -539,6 +616,9 @@ void RaaqmTransportProtocol::updateStats(
     socket_->getSocketOption(GeneralTransportOptions::STATS_INTERVAL,
                              timer_interval_milliseconds);
     if (dt.count() > timer_interval_milliseconds) {
+      if (multipath_) {
+        exportPathStatistics();
+      }
       (*stats_summary_)(*socket_->getInterface(), *stats_);
       t0_ = now;
     }
@@ -562,6 +642,7 @@ void RaaqmTransportProtocol::updatePathTable(
       // Initiate the new path default param
       auto new_path = std::make_unique<RaaqmDataPath>(
           *(path_table_.at(default_values::path_id)));
+      new_path->resetStats();
 
       // Insert the new path into hash table
       path_table_[path_id] = std::move(new_path);
@@ -580,6 +661,33 @@ void RaaqmTransportProtocol::updatePathTable(
   cur_path_->updateReceivedStats(header_size + data_size, data_size);
 }
 
+void RaaqmTransportProtocol::updateMultipathWindow() {
+  double window = 0.;
+  for (auto &path : path_table_) {
+    if (path.second->isActive() && !path.second->isStale()) {
+      window += path.second->getWindow();
+    }
+  }
+
+  if (window == 0.) {
+    window = path_table_.at(default_values::path_id)->getWindow();
+  }
+
+  current_window_size_ = window;
+}
+
+void RaaqmTransportProtocol::exportPathStatistics() {
+  for (auto &path : path_table_) {
+    if (!path.second->isActive()) {
+      continue;
+    }
+
+    stats_->updatePathStatistics(
+        path.first, {path.second->getWindow(), path.second->getAverageRtt(),
+                     path.second->getDataBytesReceived()});
+  }
+}
+
 void RaaqmTransportProtocol::checkDropProbability() {
   if (!raaqm_autotune_) {
     return;
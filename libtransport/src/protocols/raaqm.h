@@ -60,21 +60,31 @@ class RaaqmTransportProtocol : public TransportProtocol,
                            const utils::SteadyTime::Microseconds &rtt,
                            utils::SteadyTime::TimePoint &now);
 
- private:
-  void init();
+  // Headroom of the pacing rate over a window per RTT, for the window to grow
+  static constexpr double pacing_gain = 1.25;
+
+  double getPacingRate() override;
 
-  void onContentObjectReceived(Interest &i, ContentObject &c,
-                               std::error_code &ec) override;
-  void onPacketDropped(Interest &interest, ContentObject &content_object,
-                       const std::error_code &reason) override;
-  void onReassemblyFailed(std::uint32_t missing_segment) override;
-  void onInterestTimeout(Interest::Ptr &i, const Name &n) override;
   virtual void scheduleNextInterests() override;
   void sendInterest(const Name &interest_name,
                     std::array<uint32_t, MAX_AGGREGATED_INTEREST>
                         *additional_suffixes = nullptr,
                     uint32_t len = 0) override;
 
+  void onContentObjectReceived(Interest &i, ContentObject &c,
+                               std::error_code &ec) override;
+  void onInterestTimeout(Interest::Ptr &i, const Name &n) override;
+
+  // Export the state of each path to the transport statistics
+  void exportPathStatistics();
+
+ private:
+  void init();
+
+  void onPacketDropped(Interest &interest, ContentObject &content_object,
+                       const std::error_code &reason) override;
+  void onReassemblyFailed(std::uint32_t missing_segment) override;
+
   void onContentReassembled(const std::error_code &ec) override;
   void updateRtt(uint64_t segment);
   void RAAQM();
@@ -83,6 +93,10 @@ class RaaqmTransportProtocol : public TransportProtocol,
   void checkForStalePaths();
   void printRtt();
 
+  // Multipath
+  bool decreasePathWindow(RaaqmDataPath &path, double min_window_size);
+  void updateMultipathWindow();
+
   auto shared_from_this() { return utils::shared_from(this); }
 
  protected:
@@ -105,6 +119,16 @@ class RaaqmTransportProtocol : public TransportProtocol,
    */
   PathTable path_table_;
 
+  /**
+   * Multipath mode: each path has its own window, and the window of the
+   * protocol is their sum. A path grows with the data received through it,
+   * and shrinks when its own RTT reveals congestion. Interests carry no path
+   * label and the forwarder picks their next hop, so the interest schedule is
+   * not split per path: a timeout cannot be charged to a path, and shrinks
+   * all of them.
+   */
+  bool multipath_;
+
   // TimePoints for statistic
   utils::SteadyTime::TimePoint t0_;
 
@@ -47,7 +47,8 @@ RaaqmDataPath::RaaqmDataPath(double drop_factor,
       rtt_samples_(samples_),
       last_received_pkt_(utils::SteadyTime::Clock::now()),
       average_rtt_(0),
-      alpha_(ALPHA) {}
+      alpha_(ALPHA),
+      window_(1) {}
 
 RaaqmDataPath &RaaqmDataPath::insertNewRtt(
     const utils::SteadyTime::Microseconds &new_rtt,
@@ -55,6 +56,13 @@ RaaqmDataPath &RaaqmDataPath::insertNewRtt(
   rtt_ = new_rtt.count() / 1000;
   rtt_samples_.pushBack(rtt_);
 
+  double rtt_milliseconds = double(new_rtt.count()) / 1000.0;
+  if (average_rtt_ == 0) {
+    average_rtt_ = rtt_milliseconds;
+  } else {
+    average_rtt_ = alpha_ * average_rtt_ + (1. - alpha_) * rtt_milliseconds;
+  }
+
   rtt_max_ = rtt_samples_.rBegin();
   rtt_min_ = rtt_samples_.begin();
 
@@ -154,6 +162,31 @@ bool RaaqmDataPath::isStale() {
   return false;
 }
 
+double RaaqmDataPath::getWindow() { return window_; }
+
+RaaqmDataPath &RaaqmDataPath::setWindow(double window) {
+  window_ = window;
+
+  return *this;
+}
+
+uint64_t RaaqmDataPath::getDataBytesReceived() {
+  return raw_data_bytes_received_;
+}
+
+bool RaaqmDataPath::isActive() { return packets_received_ > 0; }
+
+RaaqmDataPath &RaaqmDataPath::resetStats() {
+  packets_received_ = 0;
+  last_packets_received_ = 0;
+  m_packets_bytes_received_ = 0;
+  last_packets_bytes_received_ = 0;
+  raw_data_bytes_received_ = 0;
+  last_raw_data_bytes_received_ = 0;
+
+  return *this;
+}
+
 }  // end namespace protocol
 
 }  // end namespace transport
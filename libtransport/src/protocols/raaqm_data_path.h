@@ -141,6 +141,29 @@ class RaaqmDataPath {
 
   bool isStale();
 
+  /**
+   * @brief Get the congestion window of the path, in multipath mode
+   */
+  double getWindow();
+
+  RaaqmDataPath &setWindow(double window);
+
+  /**
+   * @brief Get the amount of data received through this path, without the
+   * ICN header
+   */
+  uint64_t getDataBytesReceived();
+
+  /**
+   * @brief Returns true once some data has been received through this path
+   */
+  bool isActive();
+
+  /**
+   * @brief Reset the counters of the data received through the path
+   */
+  RaaqmDataPath &resetStats();
+
  private:
   /**
    * The value of the drop factor
@@ -224,6 +247,11 @@ class RaaqmDataPath {
 
   double average_rtt_;
   double alpha_;
+
+  /**
+   * Congestion window of the path (multipath mode)
+   */
+  double window_;
 };
 
 }  // end namespace protocol
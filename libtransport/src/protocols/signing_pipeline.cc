@@ -0,0 +1,123 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <glog/logging.h>
+#include <protocols/signing_pipeline.h>
+
+namespace transport {
+
+namespace protocol {
+
+SigningPipeline::SigningPipeline(std::size_t n_threads,
+                                 std::shared_ptr<auth::Signer> signer,
+                                 ReleaseCallback &&on_release)
+    : n_threads_(n_threads),
+      signer_(std::move(signer)),
+      on_release_(std::move(on_release)),
+      head_sequence_(0),
+      next_worker_(0),
+      workers_(n_threads ? std::make_unique<utils::ThreadPool>(n_threads)
+                         : nullptr) {}
+
+SigningPipeline::~SigningPipeline() {
+  // Let the workers complete the pending signatures before stopping them
+  flush();
+  workers_.reset();
+}
+
+void SigningPipeline::submit(core::ContentObject::Ptr content_object,
+                             bool sign) {
+  if (!workers_) {
+    if (!sign || this->sign(*content_object)) {
+      on_release_(content_object);
+    }
+
+    return;
+  }
+
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return slots_.size() < max_pending; });
+
+  // Nothing to wait for, release immediately
+  if (!sign && slots_.empty()) {
+    on_release_(content_object);
+    return;
+  }
+
+  uint64_t sequence = head_sequence_ + slots_.size();
+  slots_.push_back({content_object, !sign});
+
+  if (sign) {
+    auto &worker = workers_->getWorker(next_worker_);
+    next_worker_ = (next_worker_ + 1) % workers_->getNThreads();
+
+    worker.add([this, sequence, co = std::move(content_object)]() {
+      onSigned(sequence, this->sign(*co));
+    });
+  }
+}
+
+void SigningPipeline::flush() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  cv_.wait(lock, [this]() { return slots_.empty(); });
+}
+
+bool SigningPipeline::sign(core::ContentObject &content_object) {
+  try {
+    signer_->signPacket(&content_object);
+  } catch (const std::exception &e) {
+    LOG(ERROR) << "Error signing " << content_object.getName() << ": "
+               << e.what();
+    return false;
+  }
+
+  return true;
+}
+
+void SigningPipeline::onSigned(uint64_t sequence, bool success) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  auto &slot = slots_[sequence - head_sequence_];
+  slot.ready = true;
+
+  // Objects that could not be signed are dropped
+  if (!success) {
+    slot.content_object.reset();
+  }
+
+  releaseReadySlots();
+}
+
+void SigningPipeline::releaseReadySlots() {
+  bool released = false;
+
+  while (!slots_.empty() && slots_.front().ready) {
+    if (slots_.front().content_object) {
+      on_release_(slots_.front().content_object);
+    }
+
+    slots_.pop_front();
+    head_sequence_++;
+    released = true;
+  }
+
+  if (released) {
+    cv_.notify_all();
+  }
+}
+
+}  // namespace protocol
+
+}  // namespace transport
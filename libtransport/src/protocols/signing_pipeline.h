@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <hicn/transport/auth/signer.h>
+#include <hicn/transport/core/content_object.h>
+#include <hicn/transport/utils/noncopyable.h>
+#include <hicn/transport/utils/thread_pool.h>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+namespace transport {
+
+namespace protocol {
+
+/**
+ * Signing stage of the producer. Content objects are signed by a pool of
+ * worker threads, and released in the order they were submitted once they
+ * and all the objects before them have been signed.
+ *
+ * With no worker threads, objects are signed and released synchronously by
+ * submit().
+ */
+class SigningPipeline : public utils::NonCopyable {
+ public:
+  using ReleaseCallback =
+      std::function<void(const core::ContentObject::Ptr &content_object)>;
+
+  // Maximum number of objects waiting to be released before submit() blocks
+  static constexpr std::size_t max_pending = 2048;
+
+  /**
+   * @param on_release Called with each object leaving the pipeline, possibly
+   * from a worker thread. Calls are serialized and must not re-enter the
+   * pipeline.
+   */
+  SigningPipeline(std::size_t n_threads, std::shared_ptr<auth::Signer> signer,
+                  ReleaseCallback &&on_release);
+
+  ~SigningPipeline();
+
+  /**
+   * Submit a content object to the pipeline. Objects not to be signed, like
+   * data packets whose digest is in a manifest, are just released in order.
+   */
+  void submit(core::ContentObject::Ptr content_object, bool sign = true);
+
+  /**
+   * Wait until all the submitted objects have been released.
+   */
+  void flush();
+
+  std::size_t getNThreads() const { return n_threads_; }
+
+ private:
+  struct Slot {
+    core::ContentObject::Ptr content_object;
+    bool ready;
+  };
+
+  bool sign(core::ContentObject &content_object);
+  void onSigned(uint64_t sequence, bool success);
+  void releaseReadySlots();
+
+  std::size_t n_threads_;
+  std::shared_ptr<auth::Signer> signer_;
+  ReleaseCallback on_release_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Objects not released yet, in submission order. The sequence number of
+  // the first slot is head_sequence_.
+  std::deque<Slot> slots_;
+  uint64_t head_sequence_;
+  std::size_t next_worker_;
+
+  // Declared last, so that workers are stopped before the state they use is
+  // destroyed.
+  std::unique_ptr<utils::ThreadPool> workers_;
+};
+
+}  // namespace protocol
+
+}  // namespace transport
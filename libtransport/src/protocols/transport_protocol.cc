@@ -40,10 +40,14 @@ TransportProtocol::TransportProtocol(implementation::ConsumerSocket *icn_socket,
       on_fwd_strategy_(VOID_HANDLER),
       on_rec_strategy_(VOID_HANDLER),
       on_payload_(VOID_HANDLER),
-      fec_type_(fec::FECType::UNKNOWN) {
+      fec_type_(fec::FECType::UNKNOWN),
+      burst_timer_on_(false) {
   socket_->getSocketOption(GeneralTransportOptions::PORTAL, portal_);
   socket_->getSocketOption(OtherOptions::STATISTICS, &stats_);
 
+  burst_timer_ = std::make_unique<asio::steady_timer>(
+      portal_->getThread().getIoService());
+
   indexer_verifier_->setReassembly(reassembly_.get());
   reassembly->setIndexer(indexer_verifier_.get());
 }
@@ -116,6 +120,58 @@ void TransportProtocol::reset() {
   if (fec_decoder_) {
     fec_decoder_->reset();
   }
+
+  uint32_t pacing_burst = default_values::pacing_burst;
+  socket_->getSocketOption(GeneralTransportOptions::PACING_BURST,
+                           pacing_burst);
+  pacer_.reset(std::min(pacing_burst, uint32_t(core::Connector::max_burst)),
+               utils::SteadyTime::Clock::now());
+  burst_timer_->cancel();
+  burst_timer_on_ = false;
+}
+
+double TransportProtocol::getPacingRate() {
+  double pacing_rate = 0.;
+  socket_->getSocketOption(GeneralTransportOptions::PACING_RATE, pacing_rate);
+  return pacing_rate;
+}
+
+bool TransportProtocol::paceInterest(double needed) {
+  utils::SteadyTime::TimePoint deadline;
+  if (pacer_.take(getPacingRate(), needed, utils::SteadyTime::Clock::now(),
+                  deadline)) {
+    return true;
+  }
+
+  setBurstTimer(deadline);
+  return false;
+}
+
+void TransportProtocol::setBurstTimer(
+    const utils::SteadyTime::TimePoint &deadline) {
+  if (burst_timer_on_) {
+    return;
+  }
+
+  burst_timer_on_ = true;
+  burst_timer_->expires_at(deadline);
+
+  std::weak_ptr<TransportProtocol> self = shared_from_this();
+  burst_timer_->async_wait([self](const std::error_code &ec) {
+    if (ec) {
+      return;
+    }
+
+    auto ptr = self.lock();
+    if (!ptr) {
+      return;
+    }
+
+    ptr->burst_timer_on_ = false;
+    if (ptr->isRunning()) {
+      ptr->scheduleNextInterests();
+    }
+  });
 }
 
 void TransportProtocol::onContentReassembled(const std::error_code &ec) {
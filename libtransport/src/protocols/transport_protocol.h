@@ -15,13 +15,16 @@
 
 #pragma once
 
+#include <hicn/transport/core/asio_wrapper.h>
 #include <hicn/transport/interfaces/callbacks.h>
 #include <hicn/transport/interfaces/socket_consumer.h>
 #include <hicn/transport/interfaces/statistics.h>
+#include <hicn/transport/utils/chrono_typedefs.h>
 #include <hicn/transport/utils/object_pool.h>
 #include <protocols/data_processing_events.h>
 #include <protocols/fec_base.h>
 #include <protocols/indexer.h>
+#include <protocols/pacer.h>
 #include <protocols/protocol.h>
 #include <protocols/reassembly.h>
 
@@ -111,6 +114,23 @@ class TransportProtocol
 
   virtual void reset();
 
+  /**
+   * Rate at which interests are paced, in interests per second. 0 leaves the
+   * interests limited by the window only.
+   */
+  virtual double getPacingRate();
+
+  /**
+   * Take the sending credit of one interest. When there is none left, the
+   * pacing timer is armed for calling scheduleNextInterests() once the credit
+   * for min(burst, needed) interests is available, so that they leave
+   * together in a single sendmmsg batch of the connector, and false is
+   * returned.
+   *
+   * @param needed Interests the caller has to send, including this one.
+   */
+  bool paceInterest(double needed = 1);
+
  private:
   // Consumer Callback
   void onContentObject(Interest &i, ContentObject &c) override;
@@ -144,6 +164,14 @@ class TransportProtocol
 
   // Signer for aggregated interests
   std::shared_ptr<auth::Signer> signer_;
+
+ private:
+  void setBurstTimer(const utils::SteadyTime::TimePoint &deadline);
+
+  // Interest pacing
+  std::unique_ptr<asio::steady_timer> burst_timer_;
+  bool burst_timer_on_;
+  Pacer pacer_;
 };
 
 }  // end namespace protocol
@@ -321,5 +321,54 @@ TEST_F(AuthTest, HMACVerifier) {
   EXPECT_EQ(verifier->verifyPackets(&packet), VerificationPolicy::ACCEPT);
 }
 
+TEST_F(AuthTest, ManifestHashes) {
+  const CryptoHashType hash_type = CryptoHashType::SHA256;
+  std::vector<std::shared_ptr<core::ContentObject>> packets;
+  std::vector<PacketPtr> packet_ptrs;
+  Verifier::SuffixMap suffix_map;
+
+  for (uint32_t suffix = 0; suffix < 3; ++suffix) {
+    auto packet = std::make_shared<core::ContentObject>(
+        core::Name("b001::abcd", suffix), HICN_PACKET_FORMAT_IPV6_TCP);
+
+    uint8_t buffer[256];
+    memset(buffer, suffix, sizeof(buffer));
+    packet->appendPayload(buffer, sizeof(buffer));
+
+    packets.push_back(packet);
+    packet_ptrs.push_back(packet.get());
+  }
+
+  // Packet 0 matches its manifest entry, packet 1 does not and packet 2 is not
+  // in the manifest
+  suffix_map[0] = packets[0]->computeDigest(hash_type);
+  suffix_map[1] = packets[2]->computeDigest(hash_type);
+
+  std::shared_ptr<Verifier> verifier =
+      std::make_shared<SymmetricVerifier>(PASSPHRASE);
+  Verifier::PolicyMap policies =
+      verifier->verifyPackets(packet_ptrs, suffix_map);
+
+  EXPECT_EQ(policies[0], VerificationPolicy::ACCEPT);
+  EXPECT_EQ(policies[1], VerificationPolicy::ABORT);
+  EXPECT_EQ(policies[2], VerificationPolicy::UNKNOWN);
+}
+
+TEST_F(AuthTest, ChainedDigest) {
+  std::string payload = "bonjour";
+  CryptoHash hash(CryptoHashType::SHA256);
+  hash.computeDigest(reinterpret_cast<const uint8_t *>(payload.data()),
+                     payload.size());
+
+  // The digest of a chain is the digest of its concatenated buffers
+  auto chain = utils::MemBuf::copyBuffer(payload.data(), 3);
+  chain->prependChain(
+      utils::MemBuf::copyBuffer(payload.data() + 3, payload.size() - 3));
+  CryptoHash chain_hash(CryptoHashType::SHA256);
+  chain_hash.computeDigest(chain.get());
+
+  EXPECT_EQ(chain_hash, hash);
+}
+
 }  // namespace auth
 }  // namespace transport
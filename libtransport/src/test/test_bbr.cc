@@ -0,0 +1,429 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/core/content_object.h>
+#include <hicn/transport/core/interest.h>
+#include <hicn/transport/interfaces/global_conf_interface.h>
+#include <hicn/transport/interfaces/socket_consumer.h>
+#include <hicn/transport/interfaces/socket_options_keys.h>
+#include <hicn/transport/interfaces/socket_producer.h>
+#include <protocols/bbr_model.h>
+#include <protocols/pacer.h>
+#include <protocols/raaqm_data_path.h>
+
+#include <future>
+#include <map>
+#include <memory>
+#include <random>
+#include <set>
+
+namespace transport {
+
+namespace protocol {
+
+namespace {
+
+using utils::SteadyTime;
+
+/* A simulated bottleneck: fixed bandwidth and propagation delay, and
+ * independent losses of interests */
+struct Link {
+  double bandwidth;  // Bytes per second
+  SteadyTime::Microseconds delay;
+  double loss;
+};
+
+/*
+ * Deterministic simulation of a consumer driven by the model, with the same
+ * pacing as the protocol, or by the window rules of RAAQM.
+ */
+class BbrModelTest : public ::testing::Test {
+ protected:
+  static inline const std::size_t packet_size = 1200;
+  static inline const SteadyTime::Microseconds step{10};
+  static inline const SteadyTime::Milliseconds lifetime{100};
+  static inline const uint32_t pacing_burst =
+      interface::default_values::pacing_burst;
+
+  struct Event {
+    SteadyTime::TimePoint sent_time;
+    BbrModel::SendState sent;
+    bool lost;
+  };
+
+  BbrModelTest() { reset(); }
+
+  virtual ~BbrModelTest() {}
+
+  /* Restart the simulation from scratch, with the same random losses */
+  void reset() {
+    rng_.seed(42);
+    events_.clear();
+    states_.clear();
+    now_ = SteadyTime::TimePoint() + lifetime;
+    model_.reset(now_);
+    pacer_.reset(pacing_burst, now_);
+    burst_time_ = SteadyTime::TimePoint();
+    pacing_ = true;
+    link_free_time_ = now_;
+    inflight_ = 0;
+    delivered_ = 0;
+    rtt_sum_ = 0;
+    n_rtt_ = 0;
+    raaqm_.reset();
+  }
+
+  /* Drive the window as RAAQM does, with its default parameters */
+  void useRaaqm() {
+    raaqm_ = std::make_unique<RaaqmDataPath>(
+        interface::default_values::drop_factor,
+        interface::default_values::minimum_drop_probability,
+        unsigned(lifetime.count() * 1000),
+        interface::default_values::sample_number);
+    raaqm_window_ = 1;
+    pacing_ = false;
+  }
+
+  double window() { return raaqm_ ? raaqm_window_ : model_.getWindow(); }
+
+  void decreaseRaaqmWindow() {
+    raaqm_window_ =
+        std::max(double(interface::default_values::min_window_size),
+                 raaqm_window_ * interface::default_values::beta_value);
+  }
+
+  void onRaaqmData(const SteadyTime::Microseconds &rtt) {
+    if (raaqm_window_ < interface::default_values::max_window_size) {
+      raaqm_window_ += interface::default_values::gamma_value / raaqm_window_;
+    }
+
+    raaqm_->insertNewRtt(rtt, now_);
+    raaqm_->updateDropProb();
+    if (std::uniform_real_distribution<>(0, 1)(rng_) <=
+        raaqm_->getDropProb()) {
+      decreaseRaaqmWindow();
+    }
+  }
+
+  bool canSend() {
+    double pacing_rate = model_.getPacingRate();
+    if (!pacing_ || pacing_rate == 0) {
+      return true;
+    }
+
+    // Waiting for the burst timer, as in the protocols
+    if (burst_time_ > now_) {
+      return false;
+    }
+
+    return pacer_.take(pacing_rate / model_.getPacketSize(),
+                       window() - inflight_, now_, burst_time_);
+  }
+
+  void send(const Link &link) {
+    Event event = {now_, model_.onInterestSent(inflight_, now_), false};
+    inflight_++;
+
+    if (std::bernoulli_distribution(link.loss)(rng_)) {
+      event.lost = true;
+      events_.insert({now_ + lifetime, event});
+      return;
+    }
+
+    // The data is queued at the bottleneck on its way back
+    auto half_delay = link.delay / 2;
+    auto transmission =
+        std::chrono::duration_cast<SteadyTime::Clock::duration>(
+            std::chrono::duration<double>(packet_size / link.bandwidth));
+    link_free_time_ =
+        std::max<SteadyTime::TimePoint>(link_free_time_, now_ + half_delay) +
+        transmission;
+    events_.insert({link_free_time_ + half_delay, event});
+  }
+
+  void deliver() {
+    while (!events_.empty() && events_.begin()->first <= now_) {
+      Event event = events_.begin()->second;
+      events_.erase(events_.begin());
+      inflight_--;
+
+      // Timeouts are not reported to the model, RAAQM shrinks the window
+      if (event.lost) {
+        if (raaqm_) {
+          decreaseRaaqmWindow();
+        }
+        continue;
+      }
+
+      delivered_ += packet_size;
+      auto rtt = SteadyTime::getDurationUs(event.sent_time, now_);
+      rtt_sum_ += rtt.count();
+      n_rtt_++;
+      if (raaqm_) {
+        onRaaqmData(rtt);
+        continue;
+      }
+
+      model_.onDataReceived(delivered_, event.sent, rtt, packet_size,
+                            inflight_, now_);
+      states_.insert(model_.getState());
+    }
+  }
+
+  void run(const Link &link, SteadyTime::Milliseconds duration) {
+    auto end = now_ + duration;
+    for (; now_ < end; now_ += step) {
+      deliver();
+      while (inflight_ < window() && canSend()) {
+        send(link);
+      }
+    }
+  }
+
+  /* Run the simulation, and return the goodput (bytes per second) */
+  double measure(const Link &link, SteadyTime::Milliseconds duration) {
+    uint64_t delivered = delivered_;
+    rtt_sum_ = 0;
+    n_rtt_ = 0;
+    run(link, duration);
+    return double(delivered_ - delivered) * 1000 / double(duration.count());
+  }
+
+  double averageRtt() const { return double(rtt_sum_) / double(n_rtt_); }
+
+  BbrModel model_;
+  std::mt19937 rng_;
+  std::multimap<SteadyTime::TimePoint, Event> events_;
+  std::set<BbrModel::State> states_;
+  SteadyTime::TimePoint now_;
+  Pacer pacer_;
+  SteadyTime::TimePoint burst_time_;
+  bool pacing_;
+  SteadyTime::TimePoint link_free_time_;
+  uint64_t inflight_;
+  uint64_t delivered_;
+  uint64_t rtt_sum_;
+  uint64_t n_rtt_;
+  std::unique_ptr<RaaqmDataPath> raaqm_;
+  double raaqm_window_;
+};
+
+}  // namespace
+
+TEST_F(BbrModelTest, Startup) {
+  EXPECT_EQ(model_.getState(), BbrModel::State::STARTUP);
+  EXPECT_EQ(model_.getWindow(), double(BbrModel::initial_window));
+  EXPECT_EQ(model_.getPacingRate(), 0.);
+
+  // The window doubles every round until the pipe is full
+  Link link = {10e6, SteadyTime::Milliseconds(20), 0};
+  run(link, SteadyTime::Milliseconds(50));
+  EXPECT_EQ(model_.getState(), BbrModel::State::STARTUP);
+  EXPECT_GE(model_.getWindow(), 2. * BbrModel::initial_window);
+}
+
+TEST_F(BbrModelTest, ConvergesToBottleneck) {
+  Link link = {10e6, SteadyTime::Milliseconds(20), 0};
+  run(link, SteadyTime::Milliseconds(3000));
+
+  EXPECT_EQ(model_.getState(), BbrModel::State::PROBE_BW);
+  EXPECT_TRUE(states_.count(BbrModel::State::DRAIN));
+  EXPECT_NEAR(model_.getBottleneckBandwidth(), link.bandwidth,
+              0.05 * link.bandwidth);
+  EXPECT_GE(model_.getMinRtt(), link.delay);
+  EXPECT_LE(model_.getMinRtt(), link.delay + SteadyTime::Milliseconds(1));
+
+  // The bottleneck is used without building a standing queue
+  double bdp = link.bandwidth * 0.02 / packet_size;
+  EXPECT_NEAR(model_.getBdp(), bdp, 0.1 * bdp);
+  EXPECT_LE(model_.getWindow(), 2.2 * bdp);
+  double goodput = measure(link, SteadyTime::Milliseconds(2000));
+  EXPECT_GE(goodput, 0.9 * link.bandwidth);
+  EXPECT_LE(averageRtt(), 1.25 * double(link.delay.count()));
+}
+
+TEST_F(BbrModelTest, RandomLosses) {
+  // Losses which are not due to congestion do not reduce the rate
+  Link link = {10e6, SteadyTime::Milliseconds(20), 0.05};
+  run(link, SteadyTime::Milliseconds(3000));
+
+  EXPECT_EQ(model_.getState(), BbrModel::State::PROBE_BW);
+  EXPECT_GE(model_.getBottleneckBandwidth(), 0.9 * link.bandwidth);
+  double goodput = measure(link, SteadyTime::Milliseconds(2000));
+  EXPECT_GE(goodput, 0.85 * link.bandwidth);
+}
+
+TEST_F(BbrModelTest, ProbeRtt) {
+  // Paced bursts let the queue drain, which refreshes the min RTT: without
+  // pacing the window keeps a standing queue, and the min RTT expires
+  pacing_ = false;
+  Link link = {10e6, SteadyTime::Milliseconds(20), 0};
+  run(link, BbrModel::min_rtt_expiry + SteadyTime::Milliseconds(1000));
+
+  // The window is drained for refreshing the min RTT, then restored
+  EXPECT_TRUE(states_.count(BbrModel::State::PROBE_RTT));
+  EXPECT_EQ(model_.getState(), BbrModel::State::PROBE_BW);
+  double goodput = measure(link, SteadyTime::Milliseconds(1000));
+  EXPECT_GE(goodput, 0.9 * link.bandwidth);
+}
+
+TEST_F(BbrModelTest, RandomLossesVersusRaaqm) {
+  // Each loss shrinks the window of RAAQM, not the one of BBR: over the same
+  // simulated time and losses, BBR delivers at least as much
+  Link link = {10e6, SteadyTime::Milliseconds(20), 0.05};
+  double bbr = measure(link, SteadyTime::Milliseconds(5000));
+
+  reset();
+  useRaaqm();
+  double raaqm = measure(link, SteadyTime::Milliseconds(5000));
+
+  EXPECT_GT(raaqm, 0);
+  EXPECT_GE(bbr, raaqm);
+}
+
+}  // namespace protocol
+
+namespace interface {
+
+namespace {
+
+/*
+ * Download over the local forwarder, with interests lost at the producer: it
+ * answers only a fraction of the interests it receives.
+ */
+class ConsumerProducerLossTest : public ::testing::Test,
+                                 public ConsumerSocket::ReadCallback {
+ protected:
+  static inline const char prefix[] = "b001::/64";
+  static inline const char name[] = "b001::1";
+  static inline const std::size_t payload_size = 1200;
+  static inline const uint32_t n_segments = 5000;
+  static inline const uint32_t interest_lifetime = 100;  // ms
+  static inline const double loss = 0.05;
+
+  ConsumerProducerLossTest() : rng_(42), received_(0) {
+    global_config::IoModuleConfiguration config;
+    config.name = "forwarder_module";
+    config.set();
+  }
+
+  virtual ~ConsumerProducerLossTest() {}
+
+  /* Download the content and return the time it took */
+  std::chrono::milliseconds download(TransportProtocolAlgorithms protocol,
+                                     double pacing_rate = 0) {
+    ProducerSocket producer(ProductionProtocolAlgorithms::BYTE_STREAM);
+    auto ret = producer.setSocketOption(
+        ProducerCallbacksOptions::CACHE_MISS,
+        (ProducerInterestCallback)[this](ProducerSocket & p,
+                                         core::Interest & interest) {
+          if (std::bernoulli_distribution(loss)(rng_)) {
+            return;
+          }
+
+          auto suffix = interest.getName().getSuffix();
+          auto content_object = std::make_shared<core::ContentObject>(
+              interest.getName(), default_values::packet_format, 0, payload_,
+              payload_size);
+          if (suffix == n_segments - 1) {
+            content_object->setLast();
+          }
+          p.produce(*content_object);
+        });
+    EXPECT_EQ(ret, SOCKET_OPTION_SET);
+    producer.registerPrefix(core::Prefix(prefix));
+    producer.connect();
+    producer.start();
+
+    ConsumerSocket consumer(protocol);
+    ret = consumer.setSocketOption(ConsumerCallbacksOptions::READ_CALLBACK,
+                                   this);
+    EXPECT_EQ(ret, SOCKET_OPTION_SET);
+    ret = consumer.setSocketOption(GeneralTransportOptions::INTEREST_LIFETIME,
+                                   interest_lifetime);
+    EXPECT_EQ(ret, SOCKET_OPTION_SET);
+    ret = consumer.setSocketOption(GeneralTransportOptions::PACING_RATE,
+                                   pacing_rate);
+    EXPECT_EQ(ret, SOCKET_OPTION_SET);
+    consumer.connect();
+
+    received_ = 0;
+    done_ = std::promise<bool>();
+    auto done = done_.get_future();
+    auto start = std::chrono::steady_clock::now();
+    consumer.consume(core::Name(name));
+    EXPECT_EQ(done.wait_for(std::chrono::seconds(60)),
+              std::future_status::ready);
+    auto duration = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - start);
+
+    EXPECT_TRUE(done.get());
+    EXPECT_EQ(received_, n_segments * payload_size);
+
+    consumer.stop();
+    producer.stop();
+    return duration;
+  }
+
+  // Consumer callback
+  bool isBufferMovable() noexcept override { return true; }
+
+  void getReadBuffer(uint8_t **application_buffer,
+                     size_t *max_length) override {}
+
+  void readDataAvailable(std::size_t length) noexcept override {}
+
+  void readBufferAvailable(
+      std::unique_ptr<utils::MemBuf> &&buffer) noexcept override {
+    received_ += buffer->computeChainDataLength();
+  }
+
+  void readError(const std::error_code &ec) noexcept override {
+    done_.set_value(false);
+  }
+
+  void readSuccess(std::size_t total_size) noexcept override {
+    done_.set_value(true);
+  }
+
+  std::mt19937 rng_;
+  uint8_t payload_[payload_size] = {};
+  std::size_t received_;
+  std::promise<bool> done_;
+};
+
+}  // namespace
+
+TEST_F(ConsumerProducerLossTest, DownloadWithLosses) {
+  // Both protocols recover all the losses; their rates are compared on a
+  // simulated link, in BbrModelTest.RandomLossesVersusRaaqm
+  download(TransportProtocolAlgorithms::RAAQM);
+  download(TransportProtocolAlgorithms::BBR);
+}
+
+TEST_F(ConsumerProducerLossTest, FixedPacingRate) {
+  // The interests, and their retransmissions, do not exceed the pacing rate
+  double pacing_rate = 10000;  // Interests per second
+  auto duration = download(TransportProtocolAlgorithms::RAAQM, pacing_rate);
+
+  auto min_duration =
+      (n_segments - default_values::pacing_burst) * 1000 / pacing_rate;
+  EXPECT_GE(duration.count(), min_duration);
+}
+
+}  // namespace interface
+
+}  // namespace transport
@@ -0,0 +1,184 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/core/content_object.h>
+#include <hicn/transport/core/global_object_pool.h>
+#include <hicn/transport/core/interest.h>
+#include <hicn/transport/interfaces/socket_consumer.h>
+#include <hicn/transport/interfaces/socket_options_keys.h>
+#include <implementation/socket_consumer.h>
+#include <protocols/raaqm.h>
+
+#include <string>
+#include <vector>
+
+namespace transport {
+
+namespace protocol {
+
+namespace {
+
+/*
+ * The content is passed to the indexer as the portal does, without a
+ * connection and without running the protocol.
+ */
+class TestProtocol : public RaaqmTransportProtocol {
+ public:
+  TestProtocol(implementation::ConsumerSocket *socket)
+      : RaaqmTransportProtocol(socket) {
+    // Taken from the socket when the protocol starts
+    socket_->getSocketOption(interface::ConsumerCallbacksOptions::READ_CALLBACK,
+                             &on_payload_);
+  }
+
+  void receive(ContentObject &content_object) {
+    Interest interest(content_object.getName(), HICN_PACKET_FORMAT_IPV6_TCP);
+    indexer_verifier_->onContentObject(interest, content_object);
+  }
+};
+
+class ByteStreamReassemblyTest
+    : public ::testing::Test,
+      public interface::ConsumerSocket::ReadCallback {
+ protected:
+  using MemoryPool = core::PacketManager<>::MemoryPool;
+
+  static inline const std::size_t payload_size = 1000;
+  static inline const std::size_t packets_per_chain = 3;
+  static inline const uint32_t n_packets = 10;
+
+  ByteStreamReassemblyTest()
+      : socket_(nullptr, interface::TransportProtocolAlgorithms::RAAQM),
+        success_(false) {
+    socket_.setSocketOption(interface::ConsumerCallbacksOptions::READ_CALLBACK,
+                            this);
+    protocol_ = std::make_shared<TestProtocol>(&socket_);
+    protocol_->reset();
+  }
+
+  virtual ~ByteStreamReassemblyTest() {}
+
+  // Consumer callback: the content is delivered as a chain of payloads
+  bool isBufferMovable() noexcept override { return true; }
+  bool isBufferChainable() noexcept override { return true; }
+  size_t maxBufferSize() const override {
+    return packets_per_chain * payload_size;
+  }
+  void getReadBuffer(uint8_t **application_buffer,
+                     size_t *max_length) override {}
+  void readDataAvailable(std::size_t length) noexcept override {}
+  void readBufferAvailable(
+      std::unique_ptr<utils::MemBuf> &&buffer) noexcept override {
+    chains_.emplace_back(std::move(buffer));
+  }
+  void readError(const std::error_code &ec) noexcept override {}
+  void readSuccess(std::size_t total_size) noexcept override {
+    success_ = true;
+  }
+
+  std::string payload(uint32_t suffix) const {
+    return std::string(payload_size, char('a' + suffix));
+  }
+
+  ContentObject::Ptr makeContentObject(uint32_t suffix) {
+    auto content_object =
+        core::PacketManager<>::getInstance().getPacket<ContentObject>(
+            HICN_PACKET_FORMAT_IPV6_TCP);
+    content_object->setName(Name("b001::", suffix));
+
+    auto data = payload(suffix);
+    content_object->appendPayload((const uint8_t *)data.data(), data.size());
+    if (suffix == n_packets - 1) {
+      content_object->setLast();
+    }
+
+    return content_object;
+  }
+
+  /* Deliver the packets slightly out of order, starting with the first one */
+  void receiveAll() {
+    std::vector<uint32_t> order = {0, 2, 1, 3, 5, 4, 6, 7, 9, 8};
+    ASSERT_EQ(order.size(), n_packets);
+
+    for (auto suffix : order) {
+      auto content_object = makeContentObject(suffix);
+      protocol_->receive(*content_object);
+    }
+  }
+
+  implementation::ConsumerSocket socket_;
+  std::shared_ptr<TestProtocol> protocol_;
+  std::vector<std::unique_ptr<utils::MemBuf>> chains_;
+  bool success_;
+};
+
+}  // namespace
+
+TEST_F(ByteStreamReassemblyTest, ChainHoldsThePayloadsInOrder) {
+  receiveAll();
+  EXPECT_TRUE(success_);
+
+  // Each element of the chains is the payload of one packet, without header
+  std::string expected;
+  std::string received;
+  for (uint32_t suffix = 0; suffix < n_packets; suffix++) {
+    expected += payload(suffix);
+  }
+
+  for (auto &chain : chains_) {
+    for (auto &iov : chain->getIov()) {
+      EXPECT_EQ(iov.iov_len, payload_size);
+      received.append((const char *)iov.iov_base, iov.iov_len);
+    }
+  }
+
+  EXPECT_EQ(received, expected);
+}
+
+TEST_F(ByteStreamReassemblyTest, ChainIsFlushedAtMaxBufferSize) {
+  receiveAll();
+
+  // Full chains, then the remainder at the final suffix
+  ASSERT_EQ(chains_.size(), 4u);
+  for (std::size_t i = 0; i < chains_.size() - 1; i++) {
+    EXPECT_EQ(chains_[i]->countChainElements(), packets_per_chain);
+    EXPECT_EQ(chains_[i]->computeChainDataLength(),
+              packets_per_chain * payload_size);
+  }
+
+  EXPECT_EQ(chains_.back()->countChainElements(), 1u);
+  EXPECT_EQ(chains_.back()->computeChainDataLength(), payload_size);
+}
+
+TEST_F(ByteStreamReassemblyTest, PacketsReturnToThePool) {
+  auto &pool = MemoryPool::getInstance();
+  auto blocks_in_use = pool.blocksInUse();
+
+  // The packets are held by the chains only
+  receiveAll();
+  EXPECT_EQ(pool.blocksInUse(), blocks_in_use + n_packets);
+
+  chains_.erase(chains_.begin());
+  EXPECT_EQ(pool.blocksInUse(),
+            blocks_in_use + n_packets - packets_per_chain);
+
+  chains_.clear();
+  EXPECT_EQ(pool.blocksInUse(), blocks_in_use);
+}
+
+}  // namespace protocol
+
+}  // namespace transport
@@ -18,9 +18,12 @@
 #include <gtest/gtest.h>
 #include <hicn/transport/core/content_object.h>
 #include <hicn/transport/core/global_object_pool.h>
+#include <protocols/fec/fec.h>
 #include <protocols/fec/rs.h>
 
 #include <algorithm>
+#include <chrono>
+#include <iomanip>
 #include <iostream>
 #include <random>
 
@@ -265,5 +268,144 @@ TEST(ReedSolomonMultiBlockTest, RSMB1000) {
   ReedSolomonMultiBlockTest(blocks);
 }
 
+/**
+ * Fill k source packets of the given size with random bytes, and prepare
+ * buffers for the n - k repair packets.
+ */
+static std::vector<std::vector<gf>> makeBlock(int k, int n, int size) {
+  std::mt19937 gen(k * n + size);
+  std::uniform_int_distribution<> dis(0, 255);
+  std::vector<std::vector<gf>> block(n, std::vector<gf>(size));
+
+  for (int i = 0; i < k; i++) {
+    std::generate(block[i].begin(), block[i].end(), [&] { return dis(gen); });
+  }
+
+  return block;
+}
+
+static void encodeBlock(fec_parms *code, std::vector<std::vector<gf>> &block,
+                        int k, int n, int size) {
+  std::vector<gf *> src(k);
+  for (int i = 0; i < k; i++) src[i] = block[i].data();
+  for (int i = k; i < n; i++) {
+    fec_encode(code, src.data(), block[i].data(), i, size);
+  }
+}
+
+/**
+ * Recover the first min(k, n - k) source packets of an encoded block from
+ * the repair packets, and return them.
+ */
+static std::vector<std::vector<gf>> decodeBlock(
+    fec_parms *code, std::vector<std::vector<gf>> &block, int k, int n,
+    int size) {
+  int lost = std::min(k, n - k);
+  std::vector<std::vector<gf>> recovered(lost, std::vector<gf>(size));
+  std::vector<gf *> pkt(k + lost);
+  std::vector<int> index(k);
+
+  for (int i = 0; i < k; i++) {
+    index[i] = i < lost ? k + i : i;
+    pkt[i] = block[index[i]].data();
+  }
+
+  for (int i = 0; i < lost; i++) pkt[k + i] = recovered[i].data();
+
+  EXPECT_EQ(fec_decode(code, pkt.data(), index.data(), size), 0);
+  return recovered;
+}
+
+/**
+ * Check that all the implementations of the GF(2^8) kernels produce the same
+ * repair packets as the scalar one, and recover the source packets.
+ */
+void ReedSolomonImplTest(int k, int n) {
+  fec_parms *code = fec_new(k, n);
+  fec_impl_t default_impl = fec_get_impl();
+
+  // Include sizes not multiple of the vector width
+  for (int size : {1, 15, 31, 63, 100, 1000, 1500}) {
+    auto reference = makeBlock(k, n, size);
+    ASSERT_EQ(fec_set_impl(FEC_IMPL_SCALAR), 0);
+    encodeBlock(code, reference, k, n, size);
+
+    for (int impl = FEC_IMPL_SCALAR; impl < FEC_IMPL_N; impl++) {
+      if (fec_set_impl(fec_impl_t(impl)) < 0) continue;
+
+      auto block = makeBlock(k, n, size);
+      encodeBlock(code, block, k, n, size);
+      for (int i = k; i < n; i++) {
+        EXPECT_EQ(block[i], reference[i])
+            << "Repair packet " << i << " of size " << size << " differs with "
+            << fec_impl_name(fec_impl_t(impl));
+      }
+
+      auto recovered = decodeBlock(code, block, k, n, size);
+      for (std::size_t i = 0; i < recovered.size(); i++) {
+        EXPECT_EQ(recovered[i], reference[i])
+            << "Source packet " << i << " of size " << size
+            << " not recovered with " << fec_impl_name(fec_impl_t(impl));
+      }
+    }
+  }
+
+  fec_set_impl(default_impl);
+  fec_free(code);
+}
+
+/**
+ * Measure the encoding and decoding throughput of each implementation, in
+ * GB/s of source data.
+ */
+void ReedSolomonBenchmark(int k, int n) {
+  using Clock = std::chrono::steady_clock;
+  static constexpr int size = 1500;
+  static constexpr auto min_duration = std::chrono::milliseconds(10);
+
+  fec_parms *code = fec_new(k, n);
+  fec_impl_t default_impl = fec_get_impl();
+  auto block = makeBlock(k, n, size);
+
+  auto measure = [&](auto &&f) {
+    int iterations = 0;
+    auto start = Clock::now();
+    Clock::duration elapsed;
+    do {
+      f();
+      iterations++;
+      elapsed = Clock::now() - start;
+    } while (elapsed < min_duration);
+
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    return double(iterations) * k * size / seconds / 1e9;
+  };
+
+  for (int impl = FEC_IMPL_SCALAR; impl < FEC_IMPL_N; impl++) {
+    if (fec_set_impl(fec_impl_t(impl)) < 0) continue;
+
+    double encode = measure([&] { encodeBlock(code, block, k, n, size); });
+    double decode = measure([&] { decodeBlock(code, block, k, n, size); });
+
+    std::cout << "RS(" << n << ", " << k << ") " << std::setw(6)
+              << fec_impl_name(fec_impl_t(impl)) << ": encode " << std::fixed
+              << std::setprecision(3) << encode << " GB/s, decode " << decode
+              << " GB/s" << std::endl;
+  }
+
+  fec_set_impl(default_impl);
+  fec_free(code);
+}
+
+#define _(name, k, n)                        \
+  TEST(ReedSolomonImplTest, RSK##k##N##n) {  \
+    ReedSolomonImplTest(k, n);               \
+  }                                          \
+  TEST(ReedSolomonBenchmark, RSK##k##N##n) { \
+    ReedSolomonBenchmark(k, n);              \
+  }
+foreach_rs_fec_type
+#undef _
+
 }  // namespace protocol
 }  // namespace transport
@@ -19,6 +19,8 @@
 #include <hicn/transport/utils/event_thread.h>
 #include <hicn/transport/utils/fixed_block_allocator.h>
 
+#include <set>
+
 namespace utils {
 
 class FixedBlockAllocatorTest : public ::testing::Test {
@@ -208,4 +210,40 @@ TEST_F(FixedBlockAllocatorTest, Multithreading) {
   }
 }
 
+TEST_F(FixedBlockAllocatorTest, CrossThreadDeallocation) {
+  static constexpr std::size_t n_blocks = 16;
+  std::array<void *, n_blocks> blocks;
+  for (auto &block : blocks) {
+    block = allocator_.allocateBlock();
+  }
+
+  EXPECT_EQ(allocator_.blocksInUse(), n_blocks);
+  EXPECT_EQ(allocator_.highWaterMark(), n_blocks);
+
+  // Release the blocks from another thread
+  utils::EventThread thread;
+  thread.addAndWaitForExecution([this, &blocks]() {
+    for (auto &block : blocks) {
+      allocator_.deallocateBlock(block);
+    }
+  });
+  thread.stop();
+
+  EXPECT_EQ(allocator_.remoteDeallocations(), n_blocks);
+  EXPECT_EQ(allocator_.deallocations(), n_blocks);
+  EXPECT_EQ(allocator_.blocksInUse(), 0UL);
+
+  // The blocks went back to the pool they came from, and are reused before
+  // taking new memory from the pool.
+  std::set<void *> released(blocks.begin(), blocks.end());
+  for (std::size_t i = 0; i < n_blocks; i++) {
+    auto block = allocator_.allocateBlock();
+    EXPECT_EQ(released.count(block), 1UL);
+  }
+
+  EXPECT_EQ(allocator_.blockCount(), default_n_buffer);
+  EXPECT_EQ(allocator_.blocksInUse(), n_blocks);
+  EXPECT_EQ(allocator_.highWaterMark(), n_blocks);
+}
+
 }  // namespace utils
\ No newline at end of file
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/core/content_object.h>
+#include <hicn/transport/core/name.h>
+#include <hicn/transport/core/prefix.h>
+#include <io_modules/forwarder/forwarding_tables.h>
+
+#include <chrono>
+
+namespace transport {
+namespace core {
+
+namespace {
+
+using TimePoint = utils::SteadyTime::TimePoint;
+
+constexpr uint32_t lifetime_ms = 1000;
+
+class ForwardingTablesTest : public ::testing::Test {
+ protected:
+  ForwardingTablesTest() : now_(utils::SteadyTime::now()) {}
+
+  TimePoint after(uint32_t ms) const {
+    return now_ + std::chrono::milliseconds(ms);
+  }
+
+  ContentObject makeContentObject(const Name &name,
+                                  uint32_t lifetime = lifetime_ms) {
+    ContentObject content_object(name, HICN_PACKET_FORMAT_IPV6_TCP);
+    content_object.setLifetime(lifetime);
+    return content_object;
+  }
+
+  static Connector::Id nextHop(const Fib &fib, const Name &name) {
+    auto next_hops = fib.lookup(name);
+    EXPECT_NE(next_hops, nullptr);
+    EXPECT_FALSE(next_hops == nullptr || next_hops->empty());
+    return next_hops && !next_hops->empty() ? next_hops->front().connector
+                                            : Connector::Id(-1);
+  }
+
+  TimePoint now_;
+};
+
+}  // namespace
+
+TEST_F(ForwardingTablesTest, FibLongestPrefixMatch) {
+  Fib fib;
+  EXPECT_TRUE(fib.empty());
+
+  fib.addRoute(Prefix("b001::/16"), 1, 1);
+  fib.addRoute(Prefix("b001:1::/32"), 2, 1);
+  fib.addRoute(Prefix("b001:1:2::/48"), 3, 1);
+  fib.addRoute(Prefix("10.0.0.0/8"), 4, 1);
+  fib.addRoute(Prefix("10.1.0.0/16"), 5, 1);
+  EXPECT_FALSE(fib.empty());
+
+  EXPECT_EQ(nextHop(fib, Name("b001:1:2:3::1", 0)), 3u);
+  EXPECT_EQ(nextHop(fib, Name("b001:1:3::1", 0)), 2u);
+  EXPECT_EQ(nextHop(fib, Name("b001:2::1", 0)), 1u);
+  EXPECT_EQ(fib.lookup(Name("b002::1", 0)), nullptr);
+
+  EXPECT_EQ(nextHop(fib, Name("10.1.2.3", 0)), 5u);
+  EXPECT_EQ(nextHop(fib, Name("10.2.2.3", 0)), 4u);
+  EXPECT_EQ(fib.lookup(Name("11.1.2.3", 0)), nullptr);
+}
+
+TEST_F(ForwardingTablesTest, FibPrefixLengthNotMultipleOfEight) {
+  Fib fib;
+
+  fib.addRoute(Prefix("b001::/16"), 1, 1);
+  fib.addRoute(Prefix("b001:f000::/20"), 2, 1);
+
+  EXPECT_EQ(nextHop(fib, Name("b001:f0ff::1", 0)), 2u);
+  EXPECT_EQ(nextHop(fib, Name("b001:e0ff::1", 0)), 1u);
+}
+
+TEST_F(ForwardingTablesTest, FibNextHopsByWeightAndRemoval) {
+  Fib fib;
+
+  fib.addRoute(Prefix("b001::/16"), 1, 1);
+  fib.addRoute(Prefix("b001::/16"), 2, 10);
+  fib.addRoute(Prefix("b001:1::/32"), 3, 1);
+
+  Name name("b001:1::1", 0);
+  EXPECT_EQ(nextHop(fib, name), 3u);
+
+  fib.removeConnector(3);
+  auto next_hops = fib.lookup(name);
+  ASSERT_NE(next_hops, nullptr);
+  ASSERT_EQ(next_hops->size(), 2u);
+  EXPECT_EQ((*next_hops)[0].connector, 2u);
+  EXPECT_EQ((*next_hops)[1].connector, 1u);
+
+  fib.removeConnector(1);
+  fib.removeConnector(2);
+  EXPECT_EQ(fib.lookup(name), nullptr);
+  EXPECT_TRUE(fib.empty());
+}
+
+TEST_F(ForwardingTablesTest, PitAggregationAndRetransmission) {
+  Pit pit;
+  Name name("b001::1", 1);
+
+  EXPECT_EQ(pit.onInterest(name, 1, lifetime_ms, now_), Pit::Verdict::FORWARD);
+  EXPECT_EQ(pit.onInterest(name, 2, lifetime_ms, after(10)),
+            Pit::Verdict::AGGREGATE);
+  EXPECT_EQ(pit.onInterest(name, 1, lifetime_ms, after(20)),
+            Pit::Verdict::RETRANSMIT);
+  EXPECT_EQ(pit.size(), 1u);
+
+  auto ingress = pit.onData(name, after(30));
+  ASSERT_EQ(ingress.size(), 2u);
+  EXPECT_EQ(ingress[0], 1u);
+  EXPECT_EQ(ingress[1], 2u);
+  EXPECT_EQ(pit.size(), 0u);
+
+  // Unsolicited data
+  EXPECT_TRUE(pit.onData(name, after(40)).empty());
+}
+
+TEST_F(ForwardingTablesTest, PitExpiry) {
+  Pit pit;
+  Name name("b001::1", 1);
+
+  EXPECT_EQ(pit.onInterest(name, 1, lifetime_ms, now_), Pit::Verdict::FORWARD);
+
+  // Data received after the interest lifetime is not forwarded
+  EXPECT_TRUE(pit.onData(name, after(lifetime_ms)).empty());
+  EXPECT_EQ(pit.size(), 0u);
+
+  // An interest on an expired entry is forwarded again, not aggregated
+  EXPECT_EQ(pit.onInterest(name, 1, lifetime_ms, now_), Pit::Verdict::FORWARD);
+  EXPECT_EQ(pit.onInterest(name, 2, lifetime_ms, after(lifetime_ms)),
+            Pit::Verdict::FORWARD);
+
+  auto ingress = pit.onData(name, after(lifetime_ms + 1));
+  ASSERT_EQ(ingress.size(), 1u);
+  EXPECT_EQ(ingress[0], 2u);
+}
+
+TEST_F(ForwardingTablesTest, PitRemoveConnector) {
+  Pit pit;
+  Name name1("b001::1", 1);
+  Name name2("b001::1", 2);
+
+  pit.onInterest(name1, 1, lifetime_ms, now_);
+  pit.onInterest(name1, 2, lifetime_ms, now_);
+  pit.onInterest(name2, 1, lifetime_ms, now_);
+
+  pit.removeConnector(1);
+  EXPECT_EQ(pit.size(), 1u);
+
+  auto ingress = pit.onData(name1, now_);
+  ASSERT_EQ(ingress.size(), 1u);
+  EXPECT_EQ(ingress[0], 2u);
+}
+
+TEST_F(ForwardingTablesTest, ContentStoreLruEviction) {
+  ContentStore cs(2);
+  ASSERT_TRUE(cs.enabled());
+
+  Name name1("b001::1", 1);
+  Name name2("b001::1", 2);
+  Name name3("b001::1", 3);
+
+  cs.insert(makeContentObject(name1), now_);
+  cs.insert(makeContentObject(name2), now_);
+  EXPECT_EQ(cs.size(), 2u);
+
+  // Refresh name1, so that name2 becomes the least recently used
+  auto hit = cs.lookup(name1, now_);
+  ASSERT_NE(hit, nullptr);
+  EXPECT_EQ(hit->getName(), name1);
+
+  cs.insert(makeContentObject(name3), now_);
+  EXPECT_EQ(cs.size(), 2u);
+  EXPECT_EQ(cs.lookup(name2, now_), nullptr);
+  EXPECT_NE(cs.lookup(name1, now_), nullptr);
+  EXPECT_NE(cs.lookup(name3, now_), nullptr);
+
+  // Shrinking evicts from the tail as well
+  cs.setCapacity(1);
+  EXPECT_EQ(cs.size(), 1u);
+  EXPECT_NE(cs.lookup(name3, now_), nullptr);
+  EXPECT_EQ(cs.lookup(name1, now_), nullptr);
+}
+
+TEST_F(ForwardingTablesTest, ContentStoreExpiryAndLifetime) {
+  ContentStore cs(2);
+  Name name1("b001::1", 1);
+  Name name2("b001::1", 2);
+
+  // Data without lifetime is not cached
+  cs.insert(makeContentObject(name1, 0), now_);
+  EXPECT_EQ(cs.size(), 0u);
+
+  cs.insert(makeContentObject(name2), now_);
+  EXPECT_NE(cs.lookup(name2, after(lifetime_ms - 1)), nullptr);
+  EXPECT_EQ(cs.lookup(name2, after(lifetime_ms)), nullptr);
+  EXPECT_EQ(cs.size(), 0u);
+
+  ContentStore disabled;
+  EXPECT_FALSE(disabled.enabled());
+  disabled.insert(makeContentObject(name2), now_);
+  EXPECT_EQ(disabled.size(), 0u);
+}
+
+}  // namespace core
+}  // namespace transport
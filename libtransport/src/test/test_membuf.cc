@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/utils/membuf.h>
+
+#include <string>
+
+namespace utils {
+
+namespace {
+
+class MemBufIovTest : public ::testing::Test {
+ protected:
+  MemBufIovTest() {
+    // Two payloads, each followed by an empty buffer
+    chain_ = MemBuf::copyBuffer(first_.data(), first_.size());
+    chain_->prependChain(MemBuf::create(0));
+    chain_->prependChain(MemBuf::copyBuffer(second_.data(), second_.size()));
+    chain_->prependChain(MemBuf::create(0));
+  }
+
+  virtual ~MemBufIovTest() {}
+
+  void checkIov(const struct iovec *iov) {
+    EXPECT_EQ(iov[0].iov_base, chain_->data());
+    EXPECT_EQ(iov[0].iov_len, first_.size());
+    EXPECT_EQ(iov[1].iov_base, chain_->next()->next()->data());
+    EXPECT_EQ(iov[1].iov_len, second_.size());
+  }
+
+  const std::string first_ = "first payload";
+  const std::string second_ = "second";
+  std::unique_ptr<MemBuf> chain_;
+};
+
+}  // namespace
+
+TEST_F(MemBufIovTest, GetIovSkipsEmptyBuffers) {
+  ASSERT_EQ(chain_->countChainElements(), 4u);
+
+  auto iov = chain_->getIov();
+  ASSERT_EQ(iov.size(), 2u);
+  checkIov(iov.data());
+}
+
+TEST_F(MemBufIovTest, FillIov) {
+  struct iovec iov[4] = {};
+
+  // The iovec array is too small for the chain
+  EXPECT_EQ(chain_->fillIov(iov, 0), 0u);
+  EXPECT_EQ(chain_->fillIov(iov, 1), 0u);
+
+  // The empty buffers do not take an entry, even at the end of the chain
+  EXPECT_EQ(chain_->fillIov(iov, 2), 2u);
+  checkIov(iov);
+
+  EXPECT_EQ(chain_->fillIov(iov, 4), 2u);
+  checkIov(iov);
+}
+
+}  // namespace utils
@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <protocols/pacer.h>
+
+namespace transport {
+
+namespace protocol {
+
+namespace {
+
+using utils::SteadyTime;
+
+class PacerTest : public ::testing::Test {
+ protected:
+  static inline const uint32_t burst = 8;
+  static inline const double rate = 1000;  // Interests per second
+
+  PacerTest() : now_(SteadyTime::TimePoint() + SteadyTime::Milliseconds(1)) {
+    pacer_.reset(burst, now_);
+  }
+
+  virtual ~PacerTest() {}
+
+  /* Take the credit of as many interests as possible */
+  unsigned takeAll(double needed) {
+    unsigned sent = 0;
+    while (pacer_.take(rate, needed - sent, now_, deadline_)) {
+      sent++;
+    }
+    return sent;
+  }
+
+  /* Time until the deadline, in microseconds */
+  double wait() const {
+    return std::chrono::duration<double, std::micro>(deadline_ - now_).count();
+  }
+
+  Pacer pacer_;
+  SteadyTime::TimePoint now_;
+  SteadyTime::TimePoint deadline_;
+};
+
+}  // namespace
+
+TEST_F(PacerTest, Disabled) {
+  // Without a rate or a burst, interests are only limited by the window
+  for (unsigned i = 0; i < 2 * burst; i++) {
+    EXPECT_TRUE(pacer_.take(0, 1, now_, deadline_));
+  }
+
+  pacer_.reset(0, now_);
+  for (unsigned i = 0; i < 2 * burst; i++) {
+    EXPECT_TRUE(pacer_.take(rate, 1, now_, deadline_));
+  }
+}
+
+TEST_F(PacerTest, InitialBurst) {
+  EXPECT_EQ(pacer_.getBurst(), burst);
+  EXPECT_EQ(pacer_.getCredit(), double(burst));
+
+  EXPECT_EQ(takeAll(100), burst);
+  EXPECT_LT(pacer_.getCredit(), 1.);
+}
+
+TEST_F(PacerTest, CreditGrowsUpToOneBurst) {
+  takeAll(100);
+
+  // One interest per millisecond
+  now_ += SteadyTime::Milliseconds(3);
+  EXPECT_EQ(takeAll(100), 3u);
+
+  // The credit does not exceed a burst, however long the idle time
+  now_ += SteadyTime::Milliseconds(1000);
+  EXPECT_EQ(takeAll(100), burst);
+}
+
+TEST_F(PacerTest, WaitForAWholeBurst) {
+  takeAll(100);
+
+  // With more than a burst to send, the timer waits for a burst
+  EXPECT_FALSE(pacer_.take(rate, 100, now_, deadline_));
+  EXPECT_NEAR(wait(), burst * 1000., 1);
+
+  now_ = deadline_;
+  EXPECT_EQ(takeAll(100), burst);
+}
+
+TEST_F(PacerTest, WaitForTheInterestsNeeded) {
+  takeAll(100);
+
+  // A window with less than a burst of room is not delayed for a whole burst
+  EXPECT_FALSE(pacer_.take(rate, 2, now_, deadline_));
+  EXPECT_NEAR(wait(), 2000, 1);
+
+  // A fraction of an interest still waits for one
+  EXPECT_FALSE(pacer_.take(rate, 0.5, now_, deadline_));
+  EXPECT_NEAR(wait(), 1000, 1);
+
+  now_ += SteadyTime::Milliseconds(2);
+  EXPECT_EQ(takeAll(2), 2u);
+}
+
+TEST_F(PacerTest, PartialCredit) {
+  takeAll(100);
+
+  // Half an interest of credit left: only the remainder is waited for
+  now_ += SteadyTime::Microseconds(500);
+  EXPECT_FALSE(pacer_.take(rate, 1, now_, deadline_));
+  EXPECT_NEAR(wait(), 500, 1);
+}
+
+}  // namespace protocol
+
+}  // namespace transport
@@ -24,6 +24,8 @@
 #include <hicn/transport/utils/chrono_typedefs.h>
 #include <hicn/transport/utils/event_thread.h>
 
+#include <cstring>
+
 namespace transport {
 namespace core {
 
@@ -106,6 +108,41 @@ TEST_F(PacketAllocatorTest, CheckAllocationIsCorrect) {
                   PacketManager<>::PacketStorage::packet_and_shared_ptr)));
 }
 
+TEST_F(PacketAllocatorTest, ExistingBufferReturnsToItsPool) {
+  using MemoryPool = PacketManager<>::MemoryPool;
+  auto &local_pool = MemoryPool::getInstance();
+  MemoryPool *remote_pool = nullptr;
+  PacketManager<>::RawBuffer buffer;
+  PacketManager<>::RawBuffer buffer2;
+
+  // Take raw buffers from the pool of another thread, as a connector does
+  utils::EventThread thread;
+  thread.addAndWaitForExecution([&]() {
+    remote_pool = &MemoryPool::getInstance();
+    buffer = PacketManager<>::getInstance().getRawBuffer();
+    buffer2 = PacketManager<>::getInstance().getRawBuffer();
+  });
+
+  auto local_deallocations = local_pool.deallocations();
+  auto remote_deallocations = remote_pool->remoteDeallocations();
+
+  // Wrap and release them on this thread
+  {
+    core::ContentObject content_object(core::Name("b001::1", 1),
+                                       HICN_PACKET_FORMAT_IPV6_TCP);
+    std::memcpy(buffer.first, content_object.data(), content_object.length());
+    auto packet = allocator_.getPacketFromExistingBuffer<core::ContentObject>(
+        buffer.first, content_object.length());
+    EXPECT_EQ(packet->getName(), content_object.getName());
+    auto membuf = allocator_.getMemBuf(buffer2.first, buffer2.second);
+  }
+
+  EXPECT_EQ(local_pool.deallocations(), local_deallocations);
+  EXPECT_EQ(remote_pool->remoteDeallocations(), remote_deallocations + 2);
+
+  thread.stop();
+}
+
 TEST_F(PacketAllocatorTest, CheckAllocationSpeed) {
   // Check time needed to allocate 1 million packeauto &packet_manager =
   auto &packet_manager = core::PacketManager<>::getInstance();
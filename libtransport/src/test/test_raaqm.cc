@@ -0,0 +1,282 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/core/content_object.h>
+#include <hicn/transport/core/interest.h>
+#include <hicn/transport/interfaces/socket_consumer.h>
+#include <hicn/transport/interfaces/socket_options_keys.h>
+#include <implementation/socket_consumer.h>
+#include <protocols/raaqm.h>
+
+#include <map>
+#include <memory>
+#include <vector>
+
+namespace transport {
+
+namespace protocol {
+
+namespace {
+
+using utils::SteadyTime;
+
+/*
+ * RAAQM driven as the portal does, without a connection: the protocol is not
+ * running, so sendInterest() accounts for the interests without sending them.
+ */
+class TestRaaqm : public RaaqmTransportProtocol {
+ public:
+  static inline const core::Packet::Format format =
+      HICN_PACKET_FORMAT_IPV6_TCP;
+  static inline const std::size_t payload_size = 1200;
+
+  TestRaaqm(implementation::ConsumerSocket *socket)
+      : RaaqmTransportProtocol(socket), name_("b001::", 0) {
+    // Taken from the socket when the protocol starts
+    using interface::ConsumerCallbacksOptions;
+    socket_->getSocketOption(ConsumerCallbacksOptions::INTEREST_RETRANSMISSION,
+                             &on_interest_retransmission_);
+    socket_->getSocketOption(ConsumerCallbacksOptions::INTEREST_OUTPUT,
+                             &on_interest_output_);
+    socket_->getSocketOption(ConsumerCallbacksOptions::INTEREST_EXPIRED,
+                             &on_interest_timeout_);
+    socket_->getSocketOption(ConsumerCallbacksOptions::INTEREST_SATISFIED,
+                             &on_interest_satisfied_);
+    socket_->getSocketOption(ConsumerCallbacksOptions::CONTENT_OBJECT_INPUT,
+                             &on_content_object_input_);
+    socket_->getSocketOption(ConsumerCallbacksOptions::STATS_SUMMARY,
+                             &stats_summary_);
+  }
+
+  void send(uint32_t suffix) {
+    interest_retransmissions_[suffix & mask] = ~0;
+    sendInterest(name_.setSuffix(suffix));
+  }
+
+  void receive(uint32_t suffix, uint32_t path_label,
+               const SteadyTime::Milliseconds &rtt) {
+    interest_timepoints_[suffix & mask] = SteadyTime::Clock::now() - rtt;
+
+    Name name = name_.setSuffix(suffix);
+    Interest interest(name, format);
+    ContentObject content_object(name, format, 0, payload_, payload_size);
+    content_object.setPathLabel(hicn_path_label_t(path_label));
+
+    std::error_code ec;
+    onContentObjectReceived(interest, content_object, ec);
+  }
+
+  void timeout(uint32_t suffix) {
+    Name name = name_.setSuffix(suffix);
+    auto interest = std::make_shared<Interest>(name, format);
+    onInterestTimeout(interest, name);
+  }
+
+  double getWindow() const { return current_window_size_; }
+
+  uint64_t getInterestsInFlight() const { return interests_in_flight_; }
+
+  const std::map<uint32_t, interface::TransportStatistics::PathStatistics>
+      &getPathStatistics() {
+    exportPathStatistics();
+    return stats_->getPathStatistics();
+  }
+
+ private:
+  Name name_;
+  uint8_t payload_[payload_size] = {};
+};
+
+class RaaqmMultipathTest : public ::testing::Test,
+                           public interface::ConsumerSocket::ReadCallback {
+ protected:
+  static inline const uint32_t fast_path = 1;
+  static inline const uint32_t slow_path = 2;
+
+  RaaqmMultipathTest()
+      : socket_(nullptr, interface::TransportProtocolAlgorithms::RAAQM),
+        next_suffix_(0),
+        slow_rtt_(40) {
+    socket_.setSocketOption(interface::ConsumerCallbacksOptions::READ_CALLBACK,
+                            this);
+    socket_.setSocketOption(interface::RaaqmTransportOptions::MULTIPATH, true);
+
+    // A window shrinks for sure when the RTT of its path reaches a new
+    // maximum, and never while it is stable
+    socket_.setSocketOption(interface::RaaqmTransportOptions::DROP_FACTOR, 1.);
+    socket_.setSocketOption(
+        interface::RaaqmTransportOptions::MINIMUM_DROP_PROBABILITY, 0.);
+
+    raaqm_ = std::make_shared<TestRaaqm>(&socket_);
+    raaqm_->reset();
+  }
+
+  virtual ~RaaqmMultipathTest() {}
+
+  // Consumer callback: the content is not reassembled
+  bool isBufferMovable() noexcept override { return true; }
+  void getReadBuffer(uint8_t **application_buffer,
+                     size_t *max_length) override {}
+  void readDataAvailable(std::size_t length) noexcept override {}
+  void readBufferAvailable(
+      std::unique_ptr<utils::MemBuf> &&buffer) noexcept override {}
+  void readError(const std::error_code &ec) noexcept override {}
+  void readSuccess(std::size_t total_size) noexcept override {}
+
+  SteadyTime::Milliseconds rtt(uint32_t path_label) const {
+    return SteadyTime::Milliseconds(path_label == fast_path ? 10 : slow_rtt_);
+  }
+
+  void receive(uint32_t suffix, uint32_t path_label) {
+    raaqm_->receive(suffix, path_label, rtt(path_label));
+    n_received_[path_label]++;
+  }
+
+  /* The paths are known once data has been received through them */
+  void discoverPaths() {
+    uint32_t suffix = next_suffix_;
+    raaqm_->send(next_suffix_++);
+    raaqm_->send(next_suffix_++);
+    receive(suffix, fast_path);
+    receive(suffix + 1, slow_path);
+    checkWindow();
+  }
+
+  /*
+   * Send a window of interests, then answer them through the paths in turn,
+   * as the forwarder would balance them. The slow path builds up a queue if
+   * congested, its RTT growing with each data packet.
+   */
+  void round(std::vector<uint32_t> paths = {fast_path, slow_path},
+             bool congested = false) {
+    std::vector<uint32_t> sent;
+    while (raaqm_->getInterestsInFlight() < raaqm_->getWindow()) {
+      sent.push_back(next_suffix_);
+      raaqm_->send(next_suffix_++);
+    }
+
+    for (std::size_t i = 0; i < sent.size(); i++) {
+      uint32_t path_label = paths[i % paths.size()];
+      if (path_label == slow_path && congested) {
+        slow_rtt_++;
+      }
+
+      receive(sent[i], path_label);
+      checkWindow();
+    }
+  }
+
+  /* The window of the protocol is the sum of the windows of the paths */
+  void checkWindow() {
+    double window = 0;
+    for (auto &path : raaqm_->getPathStatistics()) {
+      window += path.second.window;
+    }
+    EXPECT_DOUBLE_EQ(raaqm_->getWindow(), window);
+  }
+
+  double window(uint32_t path_label) {
+    return raaqm_->getPathStatistics().at(path_label).window;
+  }
+
+  implementation::ConsumerSocket socket_;
+  std::shared_ptr<TestRaaqm> raaqm_;
+  uint32_t next_suffix_;
+  unsigned slow_rtt_;
+  std::map<uint32_t, uint64_t> n_received_;
+};
+
+}  // namespace
+
+TEST_F(RaaqmMultipathTest, OnlyThePathOfTheDataGrows) {
+  discoverPaths();
+  double slow_window = window(slow_path);
+
+  for (int i = 0; i < 10; i++) {
+    round({fast_path});
+  }
+
+  EXPECT_GT(window(fast_path), 1.);
+  EXPECT_DOUBLE_EQ(window(slow_path), slow_window);
+}
+
+TEST_F(RaaqmMultipathTest, OnlyTheCongestedPathShrinks) {
+  discoverPaths();
+  for (int i = 0; i < 20; i++) {
+    round();
+  }
+
+  double fast_window = window(fast_path);
+  double slow_window = window(slow_path);
+  EXPECT_GT(fast_window, 1.);
+  EXPECT_GT(slow_window, 1.);
+
+  // The RTT of the slow path grows, and so does its drop probability
+  for (int i = 0; i < 20; i++) {
+    round({fast_path, slow_path}, true);
+  }
+
+  EXPECT_GT(window(fast_path), fast_window);
+  EXPECT_LT(window(slow_path), slow_window);
+}
+
+TEST_F(RaaqmMultipathTest, TimeoutShrinksAllPaths) {
+  discoverPaths();
+  for (int i = 0; i < 20; i++) {
+    round();
+  }
+
+  double beta = 0.;
+  socket_.getSocketOption(interface::RaaqmTransportOptions::BETA_VALUE, beta);
+  double fast_window = window(fast_path);
+  double slow_window = window(slow_path);
+  ASSERT_GT(fast_window * beta, 1.);
+  ASSERT_GT(slow_window * beta, 1.);
+
+  // The interest carries no path label, so the path which lost it is unknown
+  uint32_t suffix = next_suffix_++;
+  raaqm_->send(suffix);
+  raaqm_->timeout(suffix);
+  checkWindow();
+
+  EXPECT_DOUBLE_EQ(window(fast_path), fast_window * beta);
+  EXPECT_DOUBLE_EQ(window(slow_path), slow_window * beta);
+}
+
+TEST_F(RaaqmMultipathTest, ExportPathStatistics) {
+  EXPECT_TRUE(raaqm_->getPathStatistics().empty());
+
+  discoverPaths();
+  for (int i = 0; i < 5; i++) {
+    round();
+  }
+
+  // One entry per path label, with the state of the path
+  auto &path_stats = raaqm_->getPathStatistics();
+  ASSERT_EQ(path_stats.size(), 2u);
+  ASSERT_TRUE(path_stats.count(fast_path));
+  ASSERT_TRUE(path_stats.count(slow_path));
+
+  for (auto &path : path_stats) {
+    EXPECT_EQ(path.second.bytes_received,
+              n_received_[path.first] * TestRaaqm::payload_size);
+    EXPECT_NEAR(path.second.average_rtt, double(rtt(path.first).count()), 1.);
+  }
+}
+
+}  // namespace protocol
+
+}  // namespace transport
@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <hicn/transport/auth/signer.h>
+#include <hicn/transport/auth/verifier.h>
+#include <protocols/signing_pipeline.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace transport {
+namespace protocol {
+
+namespace {
+class SigningPipelineTest : public ::testing::Test {
+ protected:
+  const std::string PASSPHRASE = "hunter2";
+  static inline const uint32_t n_objects = 1000;
+
+  SigningPipelineTest()
+      : signer_(std::make_shared<auth::SymmetricSigner>(
+            auth::CryptoSuite::HMAC_SHA256, PASSPHRASE)),
+        verifier_(std::make_shared<auth::SymmetricVerifier>(PASSPHRASE)) {}
+
+  ~SigningPipelineTest() {}
+
+  // Every third object is not signed, as data packets covered by a manifest
+  core::ContentObject::Ptr makeContentObject(uint32_t suffix) {
+    bool sign = suffix % 3 != 0;
+    auto content_object = std::make_shared<core::ContentObject>(
+        core::Name("b001::abcd", suffix),
+        sign ? HICN_PACKET_FORMAT_IPV6_TCP_AH : HICN_PACKET_FORMAT_IPV6_TCP,
+        sign ? signer_->getSignatureSize() : 0);
+
+    uint8_t payload[256];
+    std::fill(payload, payload + sizeof(payload), uint8_t(suffix));
+    content_object->appendPayload(payload, sizeof(payload));
+
+    return content_object;
+  }
+
+  void run(std::size_t n_threads) {
+    SigningPipeline pipeline(
+        n_threads, signer_,
+        [this](const core::ContentObject::Ptr &content_object) {
+          released_.push_back(content_object);
+        });
+
+    for (uint32_t i = 0; i < n_objects; i++) {
+      pipeline.submit(makeContentObject(i), i % 3 != 0);
+    }
+
+    pipeline.flush();
+  }
+
+  void checkReleased() {
+    ASSERT_EQ(released_.size(), n_objects);
+
+    for (uint32_t i = 0; i < n_objects; i++) {
+      auto &content_object = released_[i];
+      EXPECT_EQ(content_object->getName().getSuffix(), i);
+
+      if (i % 3 != 0) {
+        EXPECT_EQ(verifier_->verifyPackets(content_object.get()),
+                  auth::VerificationPolicy::ACCEPT);
+      }
+    }
+  }
+
+  std::shared_ptr<auth::Signer> signer_;
+  std::shared_ptr<auth::Verifier> verifier_;
+  std::vector<core::ContentObject::Ptr> released_;
+};
+}  // namespace
+
+TEST_F(SigningPipelineTest, InlineSigning) {
+  run(0);
+  checkReleased();
+}
+
+TEST_F(SigningPipelineTest, ParallelSigningKeepsOrder) {
+  run(4);
+  checkReleased();
+}
+
+TEST_F(SigningPipelineTest, DestructionWaitsForPendingSignatures) {
+  {
+    SigningPipeline pipeline(
+        2, signer_, [this](const core::ContentObject::Ptr &content_object) {
+          released_.push_back(content_object);
+        });
+
+    for (uint32_t i = 0; i < n_objects; i++) {
+      pipeline.submit(makeContentObject(i), i % 3 != 0);
+    }
+  }
+
+  checkReleased();
+}
+
+}  // namespace protocol
+}  // namespace transport
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <gtest/gtest.h>
+#include <utils/timer_wheel.h>
+
+#include <vector>
+
+namespace utils {
+
+class TimerWheelTest : public ::testing::Test {
+ protected:
+  static inline const std::size_t n_slots = 16;
+
+  TimerWheelTest() : wheel_(n_slots) {}
+
+  virtual ~TimerWheelTest() {}
+
+  void advance(uint64_t ticks) {
+    wheel_.advance(ticks, [this](int &value) { expired_.push_back(value); });
+  }
+
+  TimerWheel<int> wheel_;
+  std::vector<int> expired_;
+};
+
+TEST_F(TimerWheelTest, ExpireInOrder) {
+  wheel_.schedule(3, 3);
+  wheel_.schedule(1, 1);
+  wheel_.schedule(2, 2);
+  EXPECT_EQ(wheel_.size(), 3u);
+
+  advance(1);
+  EXPECT_EQ(expired_, std::vector<int>({1}));
+
+  advance(2);
+  EXPECT_EQ(expired_, std::vector<int>({1, 2, 3}));
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, ZeroDelayExpiresOnNextTick) {
+  wheel_.schedule(0, 0);
+
+  advance(0);
+  EXPECT_TRUE(expired_.empty());
+
+  advance(1);
+  EXPECT_EQ(expired_, std::vector<int>({0}));
+}
+
+TEST_F(TimerWheelTest, DelayLongerThanOneRevolution) {
+  // Same slot, different revolutions
+  wheel_.schedule(5, 5);
+  wheel_.schedule(5 + n_slots, 21);
+  wheel_.schedule(5 + 3 * n_slots, 53);
+
+  advance(5);
+  EXPECT_EQ(expired_, std::vector<int>({5}));
+
+  advance(n_slots - 1);
+  EXPECT_EQ(expired_, std::vector<int>({5}));
+
+  advance(1);
+  EXPECT_EQ(expired_, std::vector<int>({5, 21}));
+
+  advance(2 * n_slots);
+  EXPECT_EQ(expired_, std::vector<int>({5, 21, 53}));
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, ScheduleFromHandler) {
+  wheel_.schedule(1, 0);
+
+  // Reschedule each timer one revolution later, which lands in the slot
+  // being processed.
+  int rounds = 0;
+  auto handler = [&](int &value) {
+    expired_.push_back(value);
+    if (++rounds < 3) {
+      wheel_.schedule(n_slots, value + 1);
+    }
+  };
+
+  wheel_.advance(1, handler);
+  EXPECT_EQ(expired_, std::vector<int>({0}));
+
+  wheel_.advance(n_slots, handler);
+  EXPECT_EQ(expired_, std::vector<int>({0, 1}));
+
+  wheel_.advance(10 * n_slots, handler);
+  EXPECT_EQ(expired_, std::vector<int>({0, 1, 2}));
+  EXPECT_TRUE(wheel_.empty());
+}
+
+TEST_F(TimerWheelTest, IdleWheelSkipsTime) {
+  advance(1000000);
+  EXPECT_EQ(wheel_.now(), 1000000u);
+
+  wheel_.schedule(2, 2);
+  advance(1);
+  EXPECT_TRUE(expired_.empty());
+  advance(1);
+  EXPECT_EQ(expired_, std::vector<int>({2}));
+}
+
+}  // namespace utils
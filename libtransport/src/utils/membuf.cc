@@ -464,6 +464,44 @@ std::size_t MemBuf::computeChainDataLength() const {
   return fullLength;
 }
 
+#ifndef _WIN32
+std::vector<struct iovec> MemBuf::getIov() const {
+  std::vector<struct iovec> iov;
+  iov.reserve(countChainElements());
+  appendToIov(&iov);
+  return iov;
+}
+
+void MemBuf::appendToIov(std::vector<struct iovec>* iov) const {
+  MemBuf const* p = this;
+  do {
+    // some code can get confused by empty iovs, so skip them
+    if (p->length() > 0) {
+      iov->push_back({(void*)p->data(), std::size_t(p->length())});
+    }
+    p = p->next();
+  } while (p != this);
+}
+
+size_t MemBuf::fillIov(struct iovec* iov, size_t len) const {
+  MemBuf const* p = this;
+  size_t i = 0;
+  do {
+    // some code can get confused by empty iovs, so skip them
+    if (p->length() > 0) {
+      if (i == len) {
+        return 0;
+      }
+      iov[i].iov_base = const_cast<uint8_t*>(p->data());
+      iov[i].iov_len = p->length();
+      i++;
+    }
+    p = p->next();
+  } while (p != this);
+  return i;
+}
+#endif
+
 void MemBuf::prependChain(unique_ptr<MemBuf>&& iobuf) {
   // Take ownership of the specified MemBuf
   MemBuf* other = iobuf.release();
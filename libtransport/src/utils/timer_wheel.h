@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021 Cisco and/or its affiliates.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at:
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#pragma once
+
+#include <glog/logging.h>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace utils {
+
+/**
+ * Hashed timing wheel. Timers are stored in the slot corresponding to their
+ * deadline modulo the number of slots, so that scheduling a timer and
+ * expiring it are both O(1). Timers further away than one revolution stay in
+ * their slot until their deadline is reached.
+ *
+ * Time is expressed in ticks, and only advances when advance() is called. The
+ * wheel does not support cancellation: users should invalidate the value
+ * associated to a timer instead, and ignore it upon expiry.
+ */
+template <typename T>
+class TimerWheel {
+ public:
+  static constexpr std::size_t default_slots = 1024;
+
+  explicit TimerWheel(std::size_t n_slots = default_slots)
+      : slots_(n_slots), mask_(n_slots - 1), current_tick_(0), size_(0) {
+    DCHECK(n_slots > 0 && (n_slots & mask_) == 0)
+        << "The number of slots must be a power of 2";
+  }
+
+  /**
+   * Schedule a timer expiring after at least one tick.
+   */
+  void schedule(uint64_t delay, T &&value) {
+    uint64_t deadline = current_tick_ + (delay > 0 ? delay : 1);
+    slots_[deadline & mask_].push_back({deadline, std::move(value)});
+    size_++;
+  }
+
+  /**
+   * Move time forward, calling handler on the value of each expired timer.
+   * The handler is allowed to schedule new timers.
+   */
+  template <typename Handler>
+  void advance(uint64_t ticks, Handler &&handler) {
+    while (ticks > 0) {
+      if (size_ == 0) {
+        current_tick_ += ticks;
+        return;
+      }
+
+      current_tick_++;
+      ticks--;
+
+      auto &slot = slots_[current_tick_ & mask_];
+      if (slot.empty()) {
+        continue;
+      }
+
+      // Timers scheduled by the handler are at least one tick away, and are
+      // added to the slot after it has been emptied.
+      expired_.swap(slot);
+      for (auto &entry : expired_) {
+        if (entry.deadline > current_tick_) {
+          slot.push_back(std::move(entry));
+          continue;
+        }
+
+        size_--;
+        handler(entry.value);
+      }
+
+      expired_.clear();
+    }
+  }
+
+  uint64_t now() const { return current_tick_; }
+
+  std::size_t size() const { return size_; }
+
+  bool empty() const { return size_ == 0; }
+
+ private:
+  struct Entry {
+    uint64_t deadline;
+    T value;
+  };
+
+  std::vector<std::vector<Entry>> slots_;
+  // Reused across calls to advance(), to avoid allocations
+  std::vector<Entry> expired_;
+  std::size_t mask_;
+  uint64_t current_tick_;
+  std::size_t size_;
+};
+
+}  // namespace utils
@@ -21,6 +21,10 @@ data_source_t data_dsrc[1] = {
     {"data", DS_TYPE_GAUGE, 0, NAN},
 };
 
+data_source_t routes_dsrc[1] = {
+    {"routes", DS_TYPE_GAUGE, 0, NAN},
+};
+
 data_source_t combined_dsrc[2] = {
     {"packets", DS_TYPE_DERIVE, 0, NAN},
     {"bytes", DS_TYPE_DERIVE, 0, NAN},
@@ -117,6 +121,12 @@ data_set_t cs_entries_ntw_count_ds = {
     data_dsrc,
 };
 
+data_set_t routes_count_ds = {
+    "routes_count",
+    STATIC_ARRAY_SIZE(routes_dsrc),
+    routes_dsrc,
+};
+
 /************** DATA SETS FACE ****************************/
 data_set_t irx_ds = {
     "irx",
@@ -114,6 +114,23 @@ static int read_forwarder_per_face_stats(hc_data_t **pdata, meta_data_t *meta) {
   return 0;
 }
 
+static int read_forwarder_routes(meta_data_t *meta) {
+  // Routes are retrieved by pages, without stalling the forwarder
+  hc_data_t *data = NULL;
+  int rc = hc_route_list(s, &data);
+  if (rc < 0 || !data) {
+    plugin_log(LOG_ERR, "Could not read routes from forwarder");
+    return -1;
+  }
+
+  value_t values[1];
+  values[0] = (value_t){.gauge = hc_data_get_size(data)};
+  submit(routes_count_ds.type, values, 1, meta);
+
+  hc_data_free(data);
+  return 0;
+}
+
 static int read_forwarder_stats() {
   // Create metadata
   meta_data_t *meta = meta_data_create();
@@ -124,6 +141,8 @@ static int read_forwarder_stats() {
   rc = read_forwarder_global_stats(&data, meta);
   if (rc < 0) goto READ_ERROR;
   rc = read_forwarder_per_face_stats(&data, meta);
+  if (rc < 0) goto READ_ERROR;
+  rc = read_forwarder_routes(meta);
 
 READ_ERROR:
   meta_data_destroy(meta);
@@ -188,6 +207,7 @@ void module_register() {
   plugin_register_data_set(&pit_entries_count_ds);
   plugin_register_data_set(&cs_entries_count_ds);
   plugin_register_data_set(&cs_entries_ntw_count_ds);
+  plugin_register_data_set(&routes_count_ds);
   plugin_register_data_set(&irx_ds);
   plugin_register_data_set(&itx_ds);
   plugin_register_data_set(&drx_ds);